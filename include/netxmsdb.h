@@ -25,7 +25,7 @@
 
 #define DB_LEGACY_SCHEMA_VERSION       700
 #define DB_SCHEMA_VERSION_MAJOR        41
-#define DB_SCHEMA_VERSION_MINOR        10
+#define DB_SCHEMA_VERSION_MINOR        21
 
 #define DB_SCHEMA_VERSION_V41_MINOR    DB_SCHEMA_VERSION_MINOR
 
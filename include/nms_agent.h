@@ -135,6 +135,22 @@
 #define BULK_DATA_REC_SUCCESS    1
 #define BULK_DATA_REC_FAILURE    2
 
+/**
+ * Maximum number of metrics from single bulk metric request evaluated by agent in parallel
+ */
+#define BULK_METRIC_REQUEST_CONCURRENCY   8
+
+/**
+ * Maximum timeout for bulk metric request (in command timeouts)
+ */
+#define MAX_BULK_METRIC_TIMEOUT_MULTIPLIER   4u
+
+/**
+ * Maximum number of metrics in single bulk metric request. Larger requests could not be evaluated
+ * within maximum request timeout if each metric takes close to command timeout to evaluate.
+ */
+#define MAX_BULK_METRIC_REQUEST_SIZE   (BULK_METRIC_REQUEST_CONCURRENCY * MAX_BULK_METRIC_TIMEOUT_MULTIPLIER)
+
 /**
  * Max bulk data block size
  */
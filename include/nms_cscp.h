@@ -691,6 +691,7 @@ typedef struct
 #define CMD_READ_MAINTENANCE_JOURNAL      0x01C4
 #define CMD_CREATE_MAINTENANCE_JOURNAL    0x01C5
 #define CMD_EDIT_MAINTENANCE_JOURNAL      0x01C6
+#define CMD_GET_PARAMETERS                0x01C7
 
 #define CMD_RS_LIST_REPORTS               0x1100
 #define CMD_RS_GET_REPORT_DEFINITION      0x1101
@@ -1494,6 +1495,8 @@ typedef struct
 #define VID_HAS_DETAIL_FIELDS       ((uint32_t)789)
 #define VID_IF_ALIAS                ((uint32_t)790)
 #define VID_RESPONSIBLE_USER_TAGS   ((uint32_t)791)
+#define VID_BULK_DATA_PIPELINING    ((uint32_t)792)
+#define VID_DATA_AGGREGATION        ((uint32_t)793)
 
 // Base variabe for single threshold in message
 #define VID_THRESHOLD_BASE          ((UINT32)0x00800000)
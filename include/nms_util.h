@@ -4278,6 +4278,7 @@ void LIBNETXMS_EXPORTABLE QSort(void *base, size_t nmemb, size_t size, int (*com
 #endif
 
 int64_t LIBNETXMS_EXPORTABLE GetCurrentTimeMs();
+int64_t LIBNETXMS_EXPORTABLE GetCurrentTimeUs();
 
 UINT64 LIBNETXMS_EXPORTABLE FileSizeW(const WCHAR *pszFileName);
 UINT64 LIBNETXMS_EXPORTABLE FileSizeA(const char *pszFileName);
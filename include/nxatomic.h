@@ -73,6 +73,16 @@ FORCEINLINE LONGLONG InterlockedDecrement64(LONGLONG volatile *v)
    return old - 1;
 }
 
+FORCEINLINE LONGLONG InterlockedAdd64(LONGLONG volatile *v, LONGLONG value)
+{
+   LONGLONG old;
+   do 
+   {
+      old = *v;
+   } while(_InterlockedCompareExchange64(v, old + value, old) != old);
+   return old + value;
+}
+
 #endif
 
 #else
@@ -130,6 +140,14 @@ static inline int64_t InterlockedDecrement64(VolatileCounter64 *v)
    return (int64_t)atomic_dec_64_nv((volatile uint64_t *)v);
 }
 
+/**
+ * Atomically add given value to 64-bit value
+ */
+static inline int64_t InterlockedAdd64(VolatileCounter64 *v, int64_t value)
+{
+   return (int64_t)atomic_add_64_nv((volatile uint64_t *)v, value);
+}
+
 /**
  * Atomically set pointer
  */
@@ -138,6 +156,14 @@ static inline void *InterlockedExchangePointer(void *volatile *target, void *val
    return atomic_swap_ptr(target, value);
 }
 
+/**
+ * Atomically compare and exchange pointer
+ */
+static inline void *InterlockedCompareExchangePointer(void *volatile *target, void *exchange, void *comparand)
+{
+   return atomic_cas_ptr(target, comparand, exchange);
+}
+
 /**
  * Atomic bitwise OR
  */
@@ -255,6 +281,19 @@ static inline int64_t InterlockedDecrement64(VolatileCounter64 *v)
 #endif
 }
 
+/**
+ * Atomically add given value to 64-bit value
+ */
+static inline int64_t InterlockedAdd64(VolatileCounter64 *v, int64_t value)
+{
+   int64_t c;
+   do
+   {
+      c = *v;
+   } while(InterlockedCompareExchange64(v, c + value, c) != c);
+   return c + value;
+}
+
 /**
  * Atomically set pointer
  */
@@ -277,6 +316,18 @@ static inline void *InterlockedExchangePointer(void *volatile *target, void *val
 #endif
 }
 
+/**
+ * Atomically compare and exchange pointer
+ */
+static inline void *InterlockedCompareExchangePointer(void *volatile *target, void *exchange, void *comparand)
+{
+#ifdef __64BIT__
+   return (void*)InterlockedCompareExchange64((VolatileCounter64*)target, (int64_t)exchange, (int64_t)comparand);
+#else
+   return (void*)InterlockedCompareExchange((VolatileCounter*)target, (int32_t)exchange, (int32_t)comparand);
+#endif
+}
+
 /**
  * Atomic bitwise OR
  */
@@ -409,6 +460,22 @@ static inline int64_t InterlockedDecrement64(VolatileCounter64 *v)
 #endif
 }
 
+/**
+ * Atomically add given value to 64-bit value
+ */
+static inline int64_t InterlockedAdd64(VolatileCounter64 *v, int64_t value)
+{
+#if defined(__GNUC__) && ((__GNUC__ < 4) || (__GNUC_MINOR__ < 1)) && (defined(__i386__) || defined(__x86_64__))
+   VolatileCounter64 temp = value;
+   __asm__ __volatile__("lock; xaddq %0,%1" : "+r" (temp), "+m" (*v) : : "memory");
+   return temp + value;
+#elif HAVE_ATOMIC_BUILTINS && !defined(__minix)
+   return __atomic_add_fetch(v, value, __ATOMIC_SEQ_CST);
+#else
+   return __sync_add_and_fetch(v, value);
+#endif
+}
+
 /**
  * Atomically set pointer
  */
@@ -430,6 +497,27 @@ static inline void *InterlockedExchangePointer(void* volatile *target, void *val
 #endif
 }
 
+/**
+ * Atomically compare and exchange pointer
+ */
+static inline void *InterlockedCompareExchangePointer(void* volatile *target, void *exchange, void *comparand)
+{
+#if defined(__GNUC__) && ((__GNUC__ < 4) || (__GNUC_MINOR__ < 1)) && (defined(__i386__) || defined(__x86_64__))
+   void *prev;
+#ifdef __64BIT__
+   __asm__ __volatile__("lock; cmpxchgq %2, %1" : "=a" (prev), "+m" (*target) : "r" (exchange), "0" (comparand) : "memory");
+#else
+   __asm__ __volatile__("lock; cmpxchgl %2, %1" : "=a" (prev), "+m" (*target) : "r" (exchange), "0" (comparand) : "memory");
+#endif
+   return prev;
+#elif HAVE_ATOMIC_BUILTINS
+   void *expected = comparand;
+   return __atomic_compare_exchange_n(target, &expected, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? comparand : expected;
+#else
+   return __sync_val_compare_and_swap(target, comparand, exchange);
+#endif
+}
+
 /**
  * Atomic bitwise OR
  */
@@ -514,6 +602,14 @@ template<typename T> static inline T *InterlockedExchangeObjectPointer(T* volati
    return static_cast<T*>(InterlockedExchangePointer(reinterpret_cast<void* volatile *>(target), value));
 }
 
+/**
+ * Atomically compare and exchange pointer - helper template
+ */
+template<typename T> static inline T *InterlockedCompareExchangeObjectPointer(T* volatile *target, T *exchange, T *comparand)
+{
+   return static_cast<T*>(InterlockedCompareExchangePointer(reinterpret_cast<void* volatile *>(target), exchange, comparand));
+}
+
 #endif   /* __cplusplus */
 
 #endif
@@ -915,6 +915,19 @@ enum HistoricalDataType
    HDT_FULL_TABLE = 3
 };
 
+/**
+ * Server-side aggregation mode for historical data requests
+ */
+enum DataAggregationMode
+{
+   DAM_NONE = 0,
+   DAM_AVERAGE = 1,
+   DAM_MIN = 2,
+   DAM_MAX = 3,
+   DAM_MIN_MAX = 4,
+   DAM_LTTB = 5
+};
+
 /**
  * DCI flags
  */
@@ -246,6 +246,8 @@ class LIBNXLP_EXPORTABLE LogParserRule
    int getMatchCount(uint32_t objectId = 0) const;
 
    void restoreCounters(const LogParserRule *rule);
+   void addCounters(const LogParserRule *rule);
+   void resetCounters();
 };
 
 #ifdef _WIN32
@@ -388,6 +390,8 @@ class LIBNXLP_EXPORTABLE LogParser
    int getRuleMatchCount(const TCHAR *ruleName, UINT32 objectId = 0) const { const LogParserRule *r = findRuleByName(ruleName); return (r != NULL) ? r->getMatchCount(objectId) : -1; }
 
    void restoreCounters(const LogParser *parser);
+   void addCounters(const LogParser *parser);
+   void resetCounters();
 
    void stop();
    void suspend();
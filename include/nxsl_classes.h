@@ -34,6 +34,7 @@
 
 #define MAX_CLASS_NAME     64
 #define INVALID_ADDRESS    ((uint32_t)0xFFFFFFFF)
+#define INVALID_VARIABLE_SLOT ((uint32_t)0xFFFFFFFF)
 
 /**
  * NXSL data types
@@ -262,6 +263,21 @@ struct NXSL_ExtMethod
       m_methods->set(#name, m); \
    }
 
+/**
+ * External attribute structure
+ */
+struct NXSL_ExtAttribute
+{
+   NXSL_Value *(*handler)(NXSL_Object *object, NXSL_VM *vm);
+};
+
+#define NXSL_ATTRIBUTE_DEFINITION(clazz, name) \
+   static NXSL_Value *A_##clazz##_##name (NXSL_Object *object, NXSL_VM *vm)
+
+#define NXSL_REGISTER_ATTRIBUTE(clazz, name) registerAttribute(#name, A_##clazz##_##name)
+
+#define NXSL_REGISTER_ATTRIBUTE_ALIAS(clazz, name, alias) registerAttribute(#alias, A_##clazz##_##name)
+
 /**
  * Handle class attribute request. It is supposed to be used within getAttr methhod with standard parameter naming.
  */
@@ -283,8 +299,10 @@ class LIBNXSL_EXPORTABLE NXSL_Class
 
 protected:
    HashMap<NXSL_Identifier, NXSL_ExtMethod> *m_methods;
+   HashMap<NXSL_Identifier, NXSL_ExtAttribute> *m_attributeHandlers;
 
    void setName(const TCHAR *name);
+   void registerAttribute(const char *name, NXSL_Value *(*handler)(NXSL_Object*, NXSL_VM*));
    const StringList& getClassHierarchy() const { return m_classHierarchy; }
    const StringSet& getAttributes() const { return m_attributes; }
 
@@ -959,6 +977,11 @@ struct NXSL_VariablePtr;
  */
 struct NXSL_Instruction;
 
+/**
+ * Mapping between variable names and variable slots
+ */
+class NXSL_VariableSlotMap;
+
 /**
  * Variable pointer restore point
  */
@@ -993,21 +1016,32 @@ class LIBNXSL_EXPORTABLE NXSL_VariableSystem : public NXSL_RuntimeObject
 protected:
    MemoryPool m_pool;
    NXSL_VariablePtr *m_variables;
+   NXSL_Variable **m_slots;   // Variables indexed by slot number
+   uint32_t m_slotCount;
    NXSL_VariableSystemType m_type;
    int m_restorePointCount;
    VREF_RESTORE_POINT m_restorePoints[MAX_VREF_RESTORE_POINTS];
 
+   void setSlot(uint32_t slot, NXSL_Variable *variable);
+
 public:
    NXSL_VariableSystem(NXSL_VM *vm, NXSL_VariableSystemType type);
    NXSL_VariableSystem(NXSL_VM *vm, const NXSL_VariableSystem *src);
    ~NXSL_VariableSystem();
 
    NXSL_Variable *find(const NXSL_Identifier& name);
-   NXSL_Variable *create(const NXSL_Identifier& name, NXSL_Value *value = nullptr);
+   NXSL_Variable *find(const NXSL_Identifier& name, uint32_t slot)
+   {
+      if (slot == INVALID_VARIABLE_SLOT)
+         return find(name);
+      return (slot < m_slotCount) ? m_slots[slot] : nullptr;
+   }
+   NXSL_Variable *create(const NXSL_Identifier& name, NXSL_Value *value = nullptr, uint32_t slot = INVALID_VARIABLE_SLOT);
    void merge(NXSL_VariableSystem *src, bool overwrite = false);
    void addAll(const NXSL_ValueHashMap<NXSL_Identifier>& src);
    void remove(const NXSL_Identifier& name);
    void clear();
+   void reindexSlots();
    bool isConstant() const { return m_type == NXSL_VariableSystemType::CONSTANT; }
 
    bool createVariableReferenceRestorePoint(uint32_t addr, NXSL_Identifier *identifier);
@@ -1065,18 +1099,24 @@ class LIBNXSL_EXPORTABLE NXSL_Program : public NXSL_ValueManager
    friend class NXSL_VM;
 
 private:
+   uint64_t m_id;
    StructArray<NXSL_Instruction> m_instructionSet;
    StructArray<NXSL_ModuleImport> m_requiredModules;
    NXSL_ValueHashMap<NXSL_Identifier> m_constants;
    StructArray<NXSL_Function> m_functions;
    StringMap m_metadata;
+   NXSL_VariableSlotMap *m_variableSlots;
+
+   void resolveVariableSlots();
 
 public:
    NXSL_Program(size_t valueRegionSize = 0, size_t identifierRegionSize = 0);
    NXSL_Program(NXSL_ProgramBuilder *builder);
    ~NXSL_Program();
 
+   uint64_t getId() const { return m_id; }
    uint32_t getCodeSize() const { return m_instructionSet.size(); }
+   uint32_t getVariableSlotCount() const;
    bool isEmpty() const;
    StringList *getRequiredModules() const;
    const TCHAR *getMetadataEntry(const TCHAR *key) const { return m_metadata.get(key); }
@@ -1132,6 +1172,7 @@ class LIBNXSL_EXPORTABLE NXSL_Library
 private:
    ObjectArray<NXSL_LibraryScript> *m_scriptList;
    Mutex m_mutex;
+   VolatileCounter m_changeCounter;
 
    void deleteInternal(int nIndex);
 
@@ -1142,6 +1183,8 @@ class LIBNXSL_EXPORTABLE NXSL_Library
    void lock() { m_mutex.lock(); }
    void unlock() { m_mutex.unlock(); }
 
+   uint32_t getChangeCounter() const { return static_cast<uint32_t>(m_changeCounter); }
+
    bool addScript(NXSL_LibraryScript *script);
    void deleteScript(const TCHAR *name);
    void deleteScript(uint32_t id);
@@ -1244,6 +1287,7 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
    NXSL_VariableSystem **m_exportedExpressionVariables;
    NXSL_VariableSystem *m_contextVariables;
    NXSL_Value *m_context;
+   NXSL_VariableSlotMap *m_variableSlots;
 
    NXSL_Storage *m_storage;
    NXSL_Storage *m_localStorage;
@@ -1259,6 +1303,11 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
    TCHAR *m_errorText;
    TCHAR *m_assertMessage;
 
+   bool m_constantsModified;
+   size_t m_loadedValues;
+   size_t m_loadedIdentifiers;
+   size_t m_loadedObjects;
+
    void execute();
    bool unwind();
    void callFunction(int nArgCount);
@@ -1278,9 +1327,9 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
    void error(int errorCode, int sourceLine = -1);
    NXSL_Value *matchRegexp(NXSL_Value *value, NXSL_Value *regexp, bool ignoreCase);
 
-   NXSL_Variable *findVariable(const NXSL_Identifier& name, NXSL_VariableSystem **vs = nullptr);
-   NXSL_Variable *findOrCreateVariable(const NXSL_Identifier& name, NXSL_VariableSystem **vs = nullptr);
-	NXSL_Variable *createVariable(const NXSL_Identifier& name);
+   NXSL_Variable *findVariable(const NXSL_Identifier& name, NXSL_VariableSystem **vs = nullptr, uint32_t slot = INVALID_VARIABLE_SLOT);
+   NXSL_Variable *findOrCreateVariable(const NXSL_Identifier& name, NXSL_VariableSystem **vs = nullptr, uint32_t slot = INVALID_VARIABLE_SLOT);
+	NXSL_Variable *createVariable(const NXSL_Identifier& name, uint32_t slot = INVALID_VARIABLE_SLOT);
 	bool isDefinedConstant(const NXSL_Identifier& name);
 
    void relocateCode(uint32_t startOffset, uint32_t len, uint32_t shift);
@@ -1336,6 +1385,7 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
 	void setContextObject(NXSL_Value *value);
 
    bool load(const NXSL_Program *program);
+   bool reset();
    bool run(const ObjectRefArray<NXSL_Value>& args, NXSL_VariableSystem **globals = nullptr,
             NXSL_VariableSystem **expressionVariables = nullptr,
             NXSL_VariableSystem *constants = nullptr, const char *entryPoint = nullptr);
@@ -1346,6 +1396,8 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
    void stop() { m_stopFlag = true; }
 
    uint32_t getCodeSize() const { return m_instructionSet.size(); }
+   uint32_t getVariableSlot(const NXSL_Identifier& name) const;
+   uint32_t getVariableSlotCount() const;
 
    void print(const TCHAR *text) { m_env->print(text); }
 	void trace(int level, const TCHAR *text);
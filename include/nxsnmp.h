@@ -608,7 +608,7 @@ class LIBNXSNMP_EXPORTABLE SNMP_SecurityContext
    void setContextName(const char *name);
 
    void setAuthoritativeEngine(const SNMP_Engine &engine);
-   const SNMP_Engine& getAuthoritativeEngine() { return m_authoritativeEngine; }
+   const SNMP_Engine& getAuthoritativeEngine() const { return m_authoritativeEngine; }
 
    size_t getSignatureSize() const;
 };
@@ -711,6 +711,8 @@ class LIBNXSNMP_EXPORTABLE SNMP_PDU
    }
    SNMP_Version getVersion() const { return m_version; }
    SNMP_ErrorCode getErrorCode() const { return static_cast<SNMP_ErrorCode>(m_errorCode); }
+   uint32_t getErrorIndex() const { return m_errorIndex; }
+   void setBulkParameters(uint32_t nonRepeaters, uint32_t maxRepetitions) { m_errorCode = nonRepeaters; m_errorIndex = maxRepetitions; }
 
    void setTrapId(const SNMP_ObjectId& id) { setTrapId(id.value(), id.length()); }
    void setTrapId(const uint32_t *value, size_t length);
@@ -838,6 +840,97 @@ class LIBNXSNMP_EXPORTABLE SNMP_UDPTransport : public SNMP_Transport
    bool isConnected() const { return m_connected; }
 };
 
+struct SNMP_AsyncRequest;
+
+/**
+ * Asynchronous SNMP request engine. Requests to any number of devices are sent via small
+ * set of shared UDP sockets and matched to responses by request (or message) ID. Single worker thread
+ * handles incoming responses and retransmissions. Completion callback is called exactly once for each
+ * successfully submitted request, always from engine's worker thread, so it should not block.
+ * SNMPv3 requests can be sent only if authoritative engine is already known in security context.
+ */
+class LIBNXSNMP_EXPORTABLE SNMP_AsyncEngine
+{
+   DISABLE_COPY_CTOR(SNMP_AsyncEngine)
+
+private:
+   int m_numSockets;
+   SOCKET *m_sockets;
+#ifdef WITH_IPV6
+   SOCKET *m_sockets6;
+#endif
+   SOCKET m_controlSockets[2];
+   THREAD m_workerThread;
+   Mutex m_mutex;
+   HashMap<uint32_t, SNMP_AsyncRequest> *m_requests;
+   ObjectArray<SNMP_AsyncRequest> *m_timers;
+   int64_t m_wakeupTime;
+   bool m_shutdown;
+   BYTE *m_receiveBuffer;
+
+   void workerThread();
+   void notifyWorkerThread();
+   void receiveMessages(SOCKET s);
+   void processMessage(const BYTE *data, size_t size, const InetAddress& sender);
+   void processTimeouts();
+   void complete(SNMP_AsyncRequest *request, uint32_t rc, SNMP_PDU *response);
+   void addTimer(SNMP_AsyncRequest *request);
+   void removeTimer(SNMP_AsyncRequest *request);
+   void updateTimer(int index);
+
+public:
+   SNMP_AsyncEngine(int numSockets = 1);
+   ~SNMP_AsyncEngine();
+
+   uint32_t start();
+   void shutdown();
+
+   uint32_t sendRequest(const InetAddress& addr, uint16_t port, SNMP_PDU *request, const SNMP_SecurityContext *securityContext,
+            void (*callback)(uint32_t, SNMP_PDU*, void*), void *context, uint32_t timeout = 0, int numRetries = 3);
+   template<typename C> uint32_t sendRequest(const InetAddress& addr, uint16_t port, SNMP_PDU *request, const SNMP_SecurityContext *securityContext,
+            void (*callback)(uint32_t, SNMP_PDU*, C*), C *context, uint32_t timeout = 0, int numRetries = 3)
+   {
+      return sendRequest(addr, port, request, securityContext, reinterpret_cast<void (*)(uint32_t, SNMP_PDU*, void*)>(callback), context, timeout, numRetries);
+   }
+   uint32_t doRequest(const InetAddress& addr, uint16_t port, SNMP_PDU *request, SNMP_PDU **response,
+            const SNMP_SecurityContext *securityContext, uint32_t timeout = 0, int numRetries = 3);
+
+   int getPendingRequestCount();
+};
+
+/**
+ * SNMP transport adapter for asynchronous engine. Allows existing blocking code that works with SNMP_Transport
+ * to send requests via shared sockets of asynchronous engine. Only request/response exchange is supported - SNMPv3
+ * engine ID discovery and time window synchronization require regular UDP transport, so for SNMPv3 authoritative
+ * engine should be set in security context before use.
+ */
+class LIBNXSNMP_EXPORTABLE SNMP_AsyncTransport : public SNMP_Transport
+{
+   DISABLE_COPY_CTOR(SNMP_AsyncTransport)
+
+private:
+   SNMP_AsyncEngine *m_engine;
+   InetAddress m_peerAddr;
+   uint16_t m_port;
+   Mutex m_mutex;
+   Condition m_completed;
+   uint32_t m_rc;
+   SNMP_PDU *m_response;
+
+   static void requestCompletionCallback(uint32_t rc, SNMP_PDU *response, SNMP_AsyncTransport *transport);
+
+public:
+   SNMP_AsyncTransport(SNMP_AsyncEngine *engine, const InetAddress& addr, uint16_t port = SNMP_DEFAULT_PORT);
+   virtual ~SNMP_AsyncTransport();
+
+   virtual int readMessage(SNMP_PDU **pdu, uint32_t timeout = INFINITE, struct sockaddr *sender = nullptr,
+            socklen_t *addrSize = nullptr, SNMP_SecurityContext* (*contextFinder)(struct sockaddr *, socklen_t) = nullptr) override;
+   virtual int sendMessage(SNMP_PDU *pdu, uint32_t timeout) override;
+   virtual InetAddress getPeerIpAddress() override;
+   virtual uint16_t getPort() override;
+   virtual bool isProxyTransport() override;
+};
+
 struct SNMP_SnapshotIndexEntry;
 
 /**
@@ -909,6 +1002,8 @@ const TCHAR LIBNXSNMP_EXPORTABLE *SNMPGetProtocolErrorText(SNMP_ErrorCode errorC
 uint32_t LIBNXSNMP_EXPORTABLE SnmpNewRequestId();
 void LIBNXSNMP_EXPORTABLE SnmpSetDefaultTimeout(uint32_t timeout);
 uint32_t LIBNXSNMP_EXPORTABLE SnmpGetDefaultTimeout();
+void LIBNXSNMP_EXPORTABLE SnmpSetWalkMaxRepetitions(uint32_t maxRepetitions);
+uint32_t LIBNXSNMP_EXPORTABLE SnmpGetWalkMaxRepetitions();
 uint32_t LIBNXSNMP_EXPORTABLE SnmpGet(SNMP_Version version, SNMP_Transport *transport, const TCHAR *oidStr,
       const uint32_t *oidBinary, size_t oidLen, void *value, size_t bufferSize, uint32_t dwFlags);
 uint32_t LIBNXSNMP_EXPORTABLE SnmpGetEx(SNMP_Transport *pTransport, const TCHAR *oidStr, const uint32_t *oidBinary, size_t oidLen,
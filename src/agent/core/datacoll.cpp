@@ -48,6 +48,7 @@ extern Mutex g_proxyListMutex;
 
 extern uint32_t g_dcReconciliationBlockSize;
 extern uint32_t g_dcReconciliationTimeout;
+extern uint32_t g_dcUploadWindowSize;
 extern uint32_t g_dcWriterFlushInterval;
 extern uint32_t g_dcWriterMaxTransactionSize;
 extern uint32_t g_dcMinCollectorPoolSize;
@@ -884,6 +885,124 @@ void DataElement::fillReconciliationMessage(NXCPMessage *msg, uint32_t baseId) c
    msg->setField(baseId + 6, m_statusCode);
 }
 
+/**
+ * Timeout for bulk data acknowledgement when sending live data (milliseconds)
+ */
+#define LIVE_DATA_SEND_TIMEOUT   2000
+
+/**
+ * Bulk data message sent to server and waiting for acknowledgement
+ */
+struct PendingBulkMessage
+{
+   uint32_t requestId;
+   int start;
+   int count;
+};
+
+/**
+ * Send data elements (only items are supported) to server in bulk mode. Elements are sent in blocks of
+ * g_dcReconciliationBlockSize elements. If server supports pipelining, up to g_dcUploadWindowSize blocks are
+ * sent before waiting for acknowledgement. Server processes blocks from same connection in order, so
+ * acknowledgements are awaited in order as well. Status array is filled with BULK_DATA_REC_xxx code
+ * for each element, BULK_DATA_REC_RETRY indicates that element was not accepted and should be sent again.
+ * Only elements from acknowledged blocks are marked as delivered - elements from blocks not acknowledged
+ * within timeout are left with BULK_DATA_REC_RETRY status, even if server may still process them later.
+ * Delivery is therefore "at least once": element from block processed by server after timeout will be
+ * sent again during reconciliation and server will store it twice (with same timestamp).
+ */
+static void SendBulkData(CommSession *session, const ObjectArray<DataElement>& elements, BYTE *status, uint32_t timeout)
+{
+   memset(status, BULK_DATA_REC_RETRY, elements.size());
+
+   int window = session->isBulkDataPipeliningSupported() ? static_cast<int>(g_dcUploadWindowSize) : 1;
+   PendingBulkMessage *pending = MemAllocArrayNoInit<PendingBulkMessage>(window);
+   int head = 0, inFlight = 0;
+   int nextElement = 0;
+   int retryCount = 0;
+   bool sendMore = true;
+   bool timedOut = false;
+   while((sendMore && (nextElement < elements.size())) || (inFlight > 0))
+   {
+      while(sendMore && (inFlight < window) && (nextElement < elements.size()))
+      {
+         int count = std::min(elements.size() - nextElement, static_cast<int>(g_dcReconciliationBlockSize));
+
+         NXCPMessage msg(CMD_DCI_DATA, session->generateRequestId(), session->getProtocolVersion());
+         msg.setField(VID_BULK_RECONCILIATION, (INT16)1);
+         msg.setField(VID_NUM_ELEMENTS, (INT16)count);
+         msg.setField(VID_TIMEOUT, timeout);
+         uint32_t fieldId = VID_ELEMENT_LIST_BASE;
+         for(int i = 0; i < count; i++, fieldId += 10)
+            elements.get(nextElement + i)->fillReconciliationMessage(&msg, fieldId);
+
+         if (!session->sendMessage(&msg))
+         {
+            nxlog_debug_tag(DEBUG_TAG, 4, _T("SendBulkData: communication error"));
+            sendMore = false;
+            break;
+         }
+
+         PendingBulkMessage *m = &pending[(head + inFlight) % window];
+         m->requestId = msg.getId();
+         m->start = nextElement;
+         m->count = count;
+         inFlight++;
+         nextElement += count;
+      }
+
+      if (inFlight == 0)
+         break;
+
+      PendingBulkMessage *m = &pending[head];
+      uint32_t rcc;
+      do
+      {
+         // After timeout only collect acknowledgements already received for remaining blocks
+         NXCPMessage *response = session->waitForMessage(CMD_REQUEST_COMPLETED, m->requestId, timedOut ? 0 : timeout);
+         if (response != nullptr)
+         {
+            rcc = response->getFieldAsUInt32(VID_RCC);
+            if (rcc == ERR_SUCCESS)
+            {
+               response->getFieldAsBinary(VID_STATUS, &status[m->start], m->count);
+            }
+            else if (rcc == ERR_PROCESSING)
+            {
+               nxlog_debug_tag(DEBUG_TAG, 4, _T("SendBulkData: server is processing data (%d%% completed)"), response->getFieldAsInt32(VID_PROGRESS));
+            }
+            else
+            {
+               nxlog_debug_tag(DEBUG_TAG, 4, _T("SendBulkData: bulk send failed (%d)"), rcc);
+               sendMore = false;
+            }
+            delete response;
+         }
+         else
+         {
+            if (!timedOut)
+               nxlog_debug_tag(DEBUG_TAG, 3, _T("SendBulkData: timeout on bulk send"));
+            rcc = ERR_REQUEST_TIMEOUT;
+         }
+      } while((rcc == ERR_PROCESSING) && !timedOut);
+
+      if ((rcc == ERR_REQUEST_TIMEOUT) || (rcc == ERR_PROCESSING))
+      {
+         // Elements from this block will be sent again
+         timedOut = true;
+         sendMore = false;
+         retryCount += m->count;
+      }
+
+      head = (head + 1) % window;
+      inFlight--;
+   }
+   MemFree(pending);
+
+   if (retryCount > 0)
+      nxlog_debug_tag(DEBUG_TAG, 3, _T("SendBulkData: %d elements not acknowledged by server and will be sent again"), retryCount);
+}
+
 /**
  * Server data sync status object
  */
@@ -1026,8 +1145,12 @@ static void ReconciliationThread()
          continue;
       }
 
+      // Read enough records to fill upload window if server can accept pipelined bulk messages
+      uint32_t limit = (session->isBulkReconciliationSupported() && session->isBulkDataPipeliningSupported()) ?
+               g_dcReconciliationBlockSize * g_dcUploadWindowSize : g_dcReconciliationBlockSize;
+
       TCHAR query[1024];
-      _sntprintf(query, 1024, _T("SELECT server_id,dci_id,dci_type,dci_origin,status_code,snmp_target_guid,timestamp,value FROM dc_queue INDEXED BY idx_dc_queue_timestamp WHERE server_id=") UINT64_FMT _T(" ORDER BY timestamp LIMIT %d"), session->getServerId(), g_dcReconciliationBlockSize);
+      _sntprintf(query, 1024, _T("SELECT server_id,dci_id,dci_type,dci_origin,status_code,snmp_target_guid,timestamp,value FROM dc_queue INDEXED BY idx_dc_queue_timestamp WHERE server_id=") UINT64_FMT _T(" ORDER BY timestamp LIMIT %u"), session->getServerId(), limit);
 
       TCHAR sqlError[DBDRV_MAX_ERROR_TEXT];
       DB_RESULT hResult = DBSelectEx(hdb, query, sqlError);
@@ -1080,75 +1203,32 @@ static void ReconciliationThread()
          {
             nxlog_debug_tag(DEBUG_TAG, 6, _T("ReconciliationThread: %d records to be sent in bulk mode"), bulkSendList.size());
 
-            NXCPMessage msg(CMD_DCI_DATA, session->generateRequestId(), session->getProtocolVersion());
-            msg.setField(VID_BULK_RECONCILIATION, (INT16)1);
-            msg.setField(VID_NUM_ELEMENTS, (INT16)bulkSendList.size());
-            msg.setField(VID_TIMEOUT, g_dcReconciliationTimeout);
+            BYTE *status = MemAllocArrayNoInit<BYTE>(bulkSendList.size());
+            SendBulkData(session.get(), bulkSendList, status, g_dcReconciliationTimeout);
 
-            UINT32 fieldId = VID_ELEMENT_LIST_BASE;
+            s_serverSyncStatusLock.lock();
+            ServerSyncStatus *serverSyncStatus = s_serverSyncStatus.get(session->getServerId());
+            bulkSendList.setOwner(Ownership::False);
+            bool accepted = false;
             for(int i = 0; i < bulkSendList.size(); i++)
             {
-               bulkSendList.get(i)->fillReconciliationMessage(&msg, fieldId);
-               fieldId += 10;
-            }
-
-            if (session->sendMessage(&msg))
-            {
-               UINT32 rcc;
-               do
+               DataElement *e = bulkSendList.get(i);
+               if (status[i] != BULK_DATA_REC_RETRY)
                {
-                  NXCPMessage *response = session->waitForMessage(CMD_REQUEST_COMPLETED, msg.getId(), g_dcReconciliationTimeout);
-                  if (response != nullptr)
-                  {
-                     rcc = response->getFieldAsUInt32(VID_RCC);
-                     if (rcc == ERR_SUCCESS)
-                     {
-                        s_serverSyncStatusLock.lock();
-                        ServerSyncStatus *serverSyncStatus = s_serverSyncStatus.get(session->getServerId());
-
-                        // Check status for each data element
-                        BYTE status[MAX_BULK_DATA_BLOCK_SIZE];
-                        memset(status, 0, MAX_BULK_DATA_BLOCK_SIZE);
-                        response->getFieldAsBinary(VID_STATUS, status, MAX_BULK_DATA_BLOCK_SIZE);
-                        bulkSendList.setOwner(Ownership::False);
-                        for(int i = 0; i < bulkSendList.size(); i++)
-                        {
-                           DataElement *e = bulkSendList.get(i);
-                           if (status[i] != BULK_DATA_REC_RETRY)
-                           {
-                              deleteList.add(e);
-                              serverSyncStatus->queueSize--;
-                           }
-                           else
-                           {
-                              delete e;
-                           }
-                        }
-                        serverSyncStatus->lastSync = time(nullptr);
-
-                        s_serverSyncStatusLock.unlock();
-                     }
-                     else if (rcc == ERR_PROCESSING)
-                     {
-                        nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: server is processing data (%d%% completed)"), response->getFieldAsInt32(VID_PROGRESS));
-                     }
-                     else
-                     {
-                        nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: bulk send failed (%d)"), rcc);
-                     }
-                     delete response;
-                  }
-                  else
-                  {
-                     nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: timeout on bulk send"));
-                     rcc = ERR_REQUEST_TIMEOUT;
-                  }
-               } while(rcc == ERR_PROCESSING);
-            }
-            else
-            {
-               nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: communication error"));
+                  deleteList.add(e);
+                  serverSyncStatus->queueSize--;
+                  accepted = true;
+               }
+               else
+               {
+                  delete e;
+               }
             }
+            if (accepted)
+               serverSyncStatus->lastSync = time(nullptr);
+            s_serverSyncStatusLock.unlock();
+
+            MemFree(status);
          }
 
          if (deleteList.size() > 0)
@@ -1180,50 +1260,135 @@ static void ReconciliationThread()
    nxlog_debug_tag(DEBUG_TAG, 1, _T("Data reconciliation thread stopped"));
 }
 
+/**
+ * Send elements for same server directly (if there is no backlog) or pass them to database writer.
+ * Elements not accepted by server are passed to database writer for later reconciliation.
+ */
+static void SendDataElements(uint64_t serverId, ObjectArray<DataElement> *elements)
+{
+   s_serverSyncStatusLock.lock();
+   ServerSyncStatus *status = s_serverSyncStatus.get(serverId);
+   if (status == nullptr)
+   {
+      status = new ServerSyncStatus(serverId);
+      s_serverSyncStatus.set(serverId, status);
+   }
+   bool sendDirectly = (status->queueSize == 0);
+   s_serverSyncStatusLock.unlock();
+
+   // Only this thread can change queue size from 0 to positive value, so
+   // it is safe to send data without holding the lock
+   BYTE *sendStatus = MemAllocArrayNoInit<BYTE>(elements->size());
+   memset(sendStatus, BULK_DATA_REC_RETRY, elements->size());
+   if (sendDirectly)
+   {
+      shared_ptr<CommSession> session = static_pointer_cast<CommSession>(FindServerSession(SessionComparator_Sender, &serverId));
+      if ((session != nullptr) && session->isBulkReconciliationSupported() && (elements->size() > 1))
+      {
+         ObjectArray<DataElement> items(elements->size(), 64, Ownership::False);
+         IntegerArray<int> itemIndexes(elements->size(), 64);
+         for(int i = 0; i < elements->size(); i++)
+         {
+            DataElement *e = elements->get(i);
+            if (e->getType() == DCO_TYPE_ITEM)
+            {
+               items.add(e);
+               itemIndexes.add(i);
+            }
+            else if (e->sendToServer(false))
+            {
+               sendStatus[i] = BULK_DATA_REC_SUCCESS;
+            }
+         }
+         if (items.size() > 0)
+         {
+            BYTE *itemStatus = MemAllocArrayNoInit<BYTE>(items.size());
+            SendBulkData(session.get(), items, itemStatus, LIVE_DATA_SEND_TIMEOUT);
+            for(int i = 0; i < items.size(); i++)
+               sendStatus[itemIndexes.get(i)] = itemStatus[i];
+            MemFree(itemStatus);
+         }
+      }
+      else
+      {
+         for(int i = 0; i < elements->size(); i++)
+         {
+            if (!elements->get(i)->sendToServer(false))
+               break;   // Do not attempt to send remaining elements, they will be reconciled later
+            sendStatus[i] = BULK_DATA_REC_SUCCESS;
+         }
+      }
+   }
+
+   s_serverSyncStatusLock.lock();
+   for(int i = 0; i < elements->size(); i++)
+   {
+      if (sendStatus[i] == BULK_DATA_REC_RETRY)
+      {
+         status->queueSize++;
+         s_databaseWriterQueue.put(elements->get(i));
+      }
+      else
+      {
+         delete elements->get(i);
+      }
+   }
+   s_serverSyncStatusLock.unlock();
+
+   MemFree(sendStatus);
+   elements->clear();
+}
+
 /**
  * Data sender queue
  */
 static Queue s_dataSenderQueue;
 
 /**
- * Data sender
+ * Data sender. All elements available in the queue are taken at once and sent to server in bulk mode if possible.
  */
 static void DataSender()
 {
    nxlog_debug_tag(DEBUG_TAG, 1, _T("Data sender thread started"));
-   while(true)
+
+   ObjectArray<DataElement> elements(256, 256, Ownership::False);
+   HashMap<uint64_t, ObjectArray<DataElement>> serverElements(Ownership::True);
+   IntegerArray<uint64_t> serverIds;
+   bool shutdown = false;
+   while(!shutdown)
    {
       DataElement *e = static_cast<DataElement*>(s_dataSenderQueue.getOrBlock());
-      if (e == INVALID_POINTER_VALUE)
-         break;
-
-      s_serverSyncStatusLock.lock();
-      ServerSyncStatus *status = s_serverSyncStatus.get(e->getServerId());
-      if (status == nullptr)
+      uint32_t maxElements = g_dcReconciliationBlockSize * g_dcUploadWindowSize;
+      while((e != nullptr) && (e != INVALID_POINTER_VALUE))
       {
-         status = new ServerSyncStatus(e->getServerId());
-         s_serverSyncStatus.set(e->getServerId(), status);
+         elements.add(e);
+         if (static_cast<uint32_t>(elements.size()) >= maxElements)
+            break;
+         e = static_cast<DataElement*>(s_dataSenderQueue.get());
       }
+      if (e == INVALID_POINTER_VALUE)
+         shutdown = true;
 
-      if (status->queueSize == 0)
+      // Send elements grouped by server, preserving order within each group
+      for(int i = 0; i < elements.size(); i++)
       {
-         if (!e->sendToServer(false))
+         DataElement *element = elements.get(i);
+         ObjectArray<DataElement> *group = serverElements.get(element->getServerId());
+         if (group == nullptr)
          {
-            status->queueSize++;
-            s_databaseWriterQueue.put(e);
-            e = nullptr;
+            group = new ObjectArray<DataElement>(256, 256, Ownership::False);
+            serverElements.set(element->getServerId(), group);
+            serverIds.add(element->getServerId());
          }
+         group->add(element);
       }
-      else
-      {
-         status->queueSize++;
-         s_databaseWriterQueue.put(e);
-         e = nullptr;
-      }
-      s_serverSyncStatusLock.unlock();
-
-      delete e;
+      elements.clear();
+      for(int i = 0; i < serverIds.size(); i++)
+         SendDataElements(serverIds.get(i), serverElements.get(serverIds.get(i)));
+      serverElements.clear();
+      serverIds.clear();
    }
+
    nxlog_debug_tag(DEBUG_TAG, 1, _T("Data sender thread stopped"));
 }
 
@@ -1727,6 +1892,17 @@ void StartLocalDataCollector()
       g_dcReconciliationTimeout = 900000;
    }
 
+   if (g_dcUploadWindowSize < 1)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data upload window size %d, resetting to 1"), g_dcUploadWindowSize);
+      g_dcUploadWindowSize = 1;
+   }
+   else if (g_dcUploadWindowSize > 64)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data upload window size %d, resetting to 64"), g_dcUploadWindowSize);
+      g_dcUploadWindowSize = 64;
+   }
+
    LoadState();
 
    g_dataCollectorPool = ThreadPoolCreate(_T("DATACOLL"), g_dcMinCollectorPoolSize, g_dcMaxCollectorPoolSize);
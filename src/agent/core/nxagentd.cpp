@@ -224,6 +224,7 @@ uint32_t g_maxCommSessions = 0;
 uint32_t g_longRunningQueryThreshold = 250;
 uint32_t g_dcReconciliationBlockSize = 1024;
 uint32_t g_dcReconciliationTimeout = 60000;
+uint32_t g_dcUploadWindowSize = 8;
 uint32_t g_dcWriterFlushInterval = 5000;
 uint32_t g_dcWriterMaxTransactionSize = 10000;
 uint32_t g_dcMinCollectorPoolSize = 4;
@@ -287,6 +288,7 @@ static int s_debugLevel = NXCONFIG_UNINITIALIZED_VALUE;
 static int s_debugLevelOverride = NXCONFIG_UNINITIALIZED_VALUE; // Debug level set from command line
 static TCHAR *s_debugTags = nullptr;
 static uint32_t s_maxWebSvcPoolSize = 64;
+static uint32_t s_maxMetricPoolSize = 32;
 static uint32_t s_defaultExecutionTimeout = 0;  // Default execution timeout for external processes (0 = unset)
 
 #ifdef _WIN32
@@ -316,6 +318,7 @@ static NX_CFG_TEMPLATE m_cfgTemplate[] =
    { _T("DataCollectionThreadPoolSize"), CT_LONG, 0, 0, 0, 0, &g_dcMaxCollectorPoolSize, nullptr }, // For compatibility, preferred is DataCollectionMaxThreadPoolSize
    { _T("DataReconciliationBlockSize"), CT_LONG, 0, 0, 0, 0, &g_dcReconciliationBlockSize, nullptr },
    { _T("DataReconciliationTimeout"), CT_LONG, 0, 0, 0, 0, &g_dcReconciliationTimeout, nullptr },
+   { _T("DataUploadWindowSize"), CT_LONG, 0, 0, 0, 0, &g_dcUploadWindowSize, nullptr },
    { _T("DataWriterFlushInterval"), CT_LONG, 0, 0, 0, 0, &g_dcWriterFlushInterval, nullptr },
    { _T("DataWriterMaxTransactionSize"), CT_LONG, 0, 0, 0, 0, &g_dcWriterMaxTransactionSize, nullptr },
    { _T("DailyLogFileSuffix"), CT_STRING, 0, 0, 64, 0, s_dailyLogFileSuffix, nullptr },
@@ -365,6 +368,7 @@ static NX_CFG_TEMPLATE m_cfgTemplate[] =
    { _T("MasterServers"), CT_STRING_CONCAT, ',', 0, 0, 0, &m_pszMasterServerList, nullptr },
    { _T("MaxLogSize"), CT_SIZE_BYTES, 0, 0, 0, 0, &s_maxLogSize, nullptr },
    { _T("MaxSessions"), CT_LONG, 0, 0, 0, 0, &g_maxCommSessions, nullptr },
+   { _T("MetricThreadPoolSize"), CT_LONG, 0, 0, 0, 0, &s_maxMetricPoolSize, nullptr },
    { _T("OfflineDataExpirationTime"), CT_LONG, 0, 0, 0, 0, &g_dcOfflineExpirationTime, nullptr },
    { _T("PlatformSuffix"), CT_STRING, 0, 0, MAX_PSUFFIX_LENGTH, 0, g_szPlatformSuffix, nullptr },
    { _T("RequireAuthentication"), CT_BOOLEAN_FLAG_32, 0, 0, AF_REQUIRE_AUTH, 0, &g_dwFlags, nullptr },
@@ -1127,6 +1131,7 @@ BOOL Initialize()
       InitSessionList();
 	   g_commThreadPool = ThreadPoolCreate(_T("COMM"), 4, MAX(MIN(g_maxCommSessions * 2, 8), 256));
 	   g_webSvcThreadPool = ThreadPoolCreate(_T("WEBSVC"), 4, s_maxWebSvcPoolSize);
+	   g_metricThreadPool = ThreadPoolCreate(_T("METRIC"), 1, std::max(s_maxMetricPoolSize, 1u));
 
 		// Load local CRLs
 		auto it = s_crlList.begin();
@@ -1566,6 +1571,7 @@ void Shutdown()
    {
       ThreadPoolDestroy(g_commThreadPool);
       ThreadPoolDestroy(g_webSvcThreadPool);
+      ThreadPoolDestroy(g_metricThreadPool);
    }
    ThreadPoolDestroy(g_executorThreadPool);
 
@@ -320,6 +320,7 @@ class CommSession : public AbstractCommSession
    bool m_acceptFileUpdates;
    bool m_ipv6Aware;
    bool m_bulkReconciliationSupported;
+   bool m_bulkDataPipeliningSupported;
    bool m_allowCompression;   // allow compression for structured messages
    bool m_acceptKeepalive;    // true if server will respond to keepalive messages
    HashMap<uint32_t, DownloadFileInfo> m_downloadFileMap;
@@ -338,6 +339,7 @@ class CommSession : public AbstractCommSession
    void getConfig(NXCPMessage *pMsg);
    void updateConfig(NXCPMessage *pRequest, NXCPMessage *pMsg);
    void getParameter(NXCPMessage *request, NXCPMessage *response);
+   void getParameters(NXCPMessage *request, NXCPMessage *response);
    void getList(NXCPMessage *request, NXCPMessage *response);
    void getTable(NXCPMessage *request, NXCPMessage *response);
    void action(NXCPMessage *pRequest, NXCPMessage *pMsg);
@@ -394,6 +396,7 @@ class CommSession : public AbstractCommSession
    virtual bool canAcceptTraps() override { return m_acceptTraps; }
    virtual bool canAcceptFileUpdates() override { return m_acceptFileUpdates; }
    virtual bool isBulkReconciliationSupported() override { return m_bulkReconciliationSupported; }
+   bool isBulkDataPipeliningSupported() const { return m_bulkDataPipeliningSupported; }
    virtual bool isIPv6Aware() override { return m_ipv6Aware; }
 
    virtual uint32_t openFile(TCHAR *nameOfFile, uint32_t requestId, time_t fileModTime = 0) override;
@@ -924,6 +927,7 @@ extern Mutex g_sessionLock;
 extern ThreadPool *g_commThreadPool;
 extern ThreadPool *g_executorThreadPool;
 extern ThreadPool *g_webSvcThreadPool;
+extern ThreadPool *g_metricThreadPool;
 extern ObjectQueue<NXCPMessage> g_notificationProcessorQueue;
 
 #ifdef _WIN32
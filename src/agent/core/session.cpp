@@ -53,6 +53,11 @@ ThreadPool *g_executorThreadPool = nullptr;
  */
 ThreadPool *g_webSvcThreadPool = nullptr;
 
+/**
+ * Thread pool for parallel metric evaluation in bulk metric requests
+ */
+ThreadPool *g_metricThreadPool = nullptr;
+
 /**
  * Next free session ID
  */
@@ -114,6 +119,7 @@ CommSession::CommSession(const shared_ptr<AbstractCommChannel>& channel, const I
    m_acceptFileUpdates = false;
    m_ipv6Aware = false;
    m_bulkReconciliationSupported = false;
+   m_bulkDataPipeliningSupported = false;
    m_disconnected = false;
    m_allowCompression = false;
    m_acceptKeepalive = false;
@@ -592,6 +598,9 @@ void CommSession::processingThread()
             case CMD_GET_PARAMETER:
                getParameter(request, &response);
                break;
+            case CMD_GET_PARAMETERS:
+               getParameters(request, &response);
+               break;
             case CMD_GET_LIST:
                getList(request, &response);
                break;
@@ -711,14 +720,16 @@ void CommSession::processingThread()
                // Servers before 2.0 use VID_ENABLED
                m_ipv6Aware = request->isFieldExist(VID_IPV6_SUPPORT) ? request->getFieldAsBoolean(VID_IPV6_SUPPORT) : request->getFieldAsBoolean(VID_ENABLED);
                m_bulkReconciliationSupported = request->getFieldAsBoolean(VID_BULK_RECONCILIATION);
+               m_bulkDataPipeliningSupported = request->getFieldAsBoolean(VID_BULK_DATA_PIPELINING);
                m_allowCompression = request->getFieldAsBoolean(VID_ENABLE_COMPRESSION);
                m_acceptKeepalive = request->getFieldAsBoolean(VID_ACCEPT_KEEPALIVE);
                response.setField(VID_RCC, ERR_SUCCESS);
                response.setField(VID_FLAGS, static_cast<uint16_t>((m_controlServer ? 0x01 : 0x00) | (m_masterServer ? 0x02 : 0x00)));
                response.setField(VID_ENABLE_FILE_UPLOAD_RESUMING, 1);
-               debugPrintf(4, _T("Server capabilities: IPv6: %s; bulk reconciliation: %s; compression: %s"),
+               debugPrintf(4, _T("Server capabilities: IPv6: %s; bulk reconciliation: %s; bulk data pipelining: %s; compression: %s"),
                            m_ipv6Aware ? _T("yes") : _T("no"),
                            m_bulkReconciliationSupported ? _T("yes") : _T("no"),
+                           m_bulkDataPipeliningSupported ? _T("yes") : _T("no"),
                            m_allowCompression ? _T("yes") : _T("no"));
                break;
             case CMD_SET_SERVER_ID:
@@ -928,6 +939,115 @@ void CommSession::getParameter(NXCPMessage *request, NXCPMessage *response)
       response->setField(VID_VALUE, value);
 }
 
+/**
+ * Bulk metric request. Object is shared between requesting thread and helper workers
+ * and destroyed when last reference is released.
+ */
+struct BulkMetricRequest
+{
+   StringList names;
+   TCHAR (*values)[MAX_RESULT_LENGTH];
+   uint32_t *errors;
+   VolatileCounter nextIndex;
+   VolatileCounter pendingMetrics;  // Metrics not evaluated yet (including ones being evaluated)
+   VolatileCounter refCount;
+   Condition completed;
+   AbstractCommSession *session;
+
+   BulkMetricRequest(NXCPMessage *request, AbstractCommSession *_session) : names(*request, VID_PARAM_LIST_BASE, VID_NUM_PARAMETERS), completed(true)
+   {
+      values = MemAllocArrayNoInit<TCHAR[MAX_RESULT_LENGTH]>(names.size());
+      errors = MemAllocArrayNoInit<uint32_t>(names.size());
+      nextIndex = 0;
+      pendingMetrics = names.size();
+      refCount = 1;
+      session = _session;
+   }
+
+   ~BulkMetricRequest()
+   {
+      MemFree(values);
+      MemFree(errors);
+   }
+
+   void incRefCount()
+   {
+      InterlockedIncrement(&refCount);
+   }
+
+   void decRefCount()
+   {
+      if (InterlockedDecrement(&refCount) == 0)
+         delete this;
+   }
+};
+
+/**
+ * Process metrics from bulk metric request until all metrics are claimed by workers
+ */
+static void ProcessBulkMetricRequest(BulkMetricRequest *request)
+{
+   int count = request->names.size();
+   int index;
+   while((index = InterlockedIncrement(&request->nextIndex) - 1) < count)
+   {
+      TCHAR name[MAX_RUNTIME_PARAM_NAME];
+      _tcslcpy(name, request->names.get(index), MAX_RUNTIME_PARAM_NAME);
+      request->errors[index] = GetMetricValue(name, request->values[index], request->session);
+      if (InterlockedDecrement(&request->pendingMetrics) == 0)
+         request->completed.set();
+   }
+}
+
+/**
+ * Helper worker for bulk metric request. Worker started after all metrics were
+ * claimed by other workers just releases its reference to request.
+ */
+static void BulkMetricRequestWorker(BulkMetricRequest *request)
+{
+   ProcessBulkMetricRequest(request);
+   request->decRefCount();
+}
+
+/**
+ * Get multiple metric values. Metrics are evaluated in parallel, so slow handlers
+ * (external providers, external subagents, etc.) do not delay each other. Helper workers
+ * run in separate thread pool, so blocked metric handlers cannot starve communication pool.
+ * Response is sent as soon as all metrics are evaluated, without waiting for helper
+ * workers still queued in busy thread pool.
+ */
+void CommSession::getParameters(NXCPMessage *request, NXCPMessage *response)
+{
+   BulkMetricRequest *bulkRequest = new BulkMetricRequest(request, this);
+   int count = bulkRequest->names.size();
+   debugPrintf(6, _T("Bulk metric request for %d metrics"), count);
+
+   // Current thread also processes metrics, so pool threads are only used when there is more than one metric
+   int workers = std::min(count, BULK_METRIC_REQUEST_CONCURRENCY);
+   for(int i = 1; i < workers; i++)
+   {
+      bulkRequest->incRefCount();
+      ThreadPoolExecute(g_metricThreadPool, BulkMetricRequestWorker, bulkRequest);
+   }
+   if (workers > 0)
+   {
+      ProcessBulkMetricRequest(bulkRequest);
+      bulkRequest->completed.wait(INFINITE);
+   }
+
+   response->setField(VID_RCC, ERR_SUCCESS);
+   response->setField(VID_NUM_PARAMETERS, static_cast<uint32_t>(count));
+   uint32_t fieldId = VID_ELEMENT_LIST_BASE;
+   for(int i = 0; i < count; i++, fieldId += 2)
+   {
+      response->setField(fieldId, bulkRequest->errors[i]);
+      if (bulkRequest->errors[i] == ERR_SUCCESS)
+         response->setField(fieldId + 1, bulkRequest->values[i]);
+   }
+
+   bulkRequest->decRefCount();
+}
+
 /**
  * Get list of values
  */
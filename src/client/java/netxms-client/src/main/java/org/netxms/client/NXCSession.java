@@ -73,6 +73,7 @@
 import org.netxms.client.businessservices.BusinessServiceTicket;
 import org.netxms.client.constants.AggregationFunction;
 import org.netxms.client.constants.AuthenticationType;
+import org.netxms.client.constants.DataAggregationMode;
 import org.netxms.client.constants.DataOrigin;
 import org.netxms.client.constants.DataType;
 import org.netxms.client.constants.HistoricalDataType;
@@ -5328,12 +5329,13 @@ public int parseDataRows(final byte[] input, DciData data)
     * @param to         End of time range or null for no limit
     * @param maxRows    Maximum number of rows to retrieve or 0 for no limit
     * @param valueType  TODO
+    * @param aggregationMode server-side aggregation mode
     * @return DCI data set
     * @throws IOException  if socket I/O error occurs
     * @throws NXCException if NetXMS server returns an error or operation was timed out
     */
    private DciData getCollectedDataInternal(long nodeId, long dciId, String instance, String dataColumn, Date from, Date to,
-         int maxRows, HistoricalDataType valueType) throws IOException, NXCException
+         int maxRows, HistoricalDataType valueType, DataAggregationMode aggregationMode) throws IOException, NXCException
    {
       NXCPMessage msg;
       if (instance != null) // table DCI
@@ -5349,6 +5351,8 @@ private DciData getCollectedDataInternal(long nodeId, long dciId, String instanc
       msg.setFieldInt32(NXCPCodes.VID_OBJECT_ID, (int)nodeId);
       msg.setFieldInt32(NXCPCodes.VID_DCI_ID, (int)dciId);
       msg.setFieldInt16(NXCPCodes.VID_HISTORICAL_DATA_TYPE, valueType.getValue());
+      if (aggregationMode != DataAggregationMode.NONE)
+         msg.setFieldInt16(NXCPCodes.VID_DATA_AGGREGATION, aggregationMode.getValue());
 
       DciData data = new DciData(nodeId, dciId);
 
@@ -5412,7 +5416,7 @@ private DciData getCollectedDataInternal(long nodeId, long dciId, String instanc
                   }
                }
             }
-         } while(rowsReceived == MAX_DCI_DATA_ROWS);
+         } while((rowsReceived == MAX_DCI_DATA_ROWS) && (aggregationMode == DataAggregationMode.NONE)); // aggregated data always sent in single block
       }
       return data;
    }
@@ -5434,7 +5438,29 @@ private DciData getCollectedDataInternal(long nodeId, long dciId, String instanc
    public DciData getCollectedData(long nodeId, long dciId, Date from, Date to, int maxRows, HistoricalDataType valueType)
          throws IOException, NXCException
    {
-      return getCollectedDataInternal(nodeId, dciId, null, null, from, to, maxRows, valueType);
+      return getCollectedDataInternal(nodeId, dciId, null, null, from, to, maxRows, valueType, DataAggregationMode.NONE);
+   }
+
+   /**
+    * Get collected DCI data from server aggregated on server side. Time range start must be specified. Data is returned
+    * as floating point values with at most given number of points (two points per time interval for MIN_MAX mode).
+    *
+    * @param nodeId          Node ID
+    * @param dciId           DCI ID
+    * @param from            Start of time range
+    * @param to              End of time range or null for current time
+    * @param maxPoints       Maximum number of points to retrieve or 0 for server default
+    * @param aggregationMode aggregation mode
+    * @return DCI data set
+    * @throws IOException  if socket I/O error occurs
+    * @throws NXCException if NetXMS server returns an error or operation was timed out
+    */
+   public DciData getCollectedData(long nodeId, long dciId, Date from, Date to, int maxPoints, DataAggregationMode aggregationMode)
+         throws IOException, NXCException
+   {
+      if (from == null)
+         throw new NXCException(RCC.INVALID_ARGUMENT);
+      return getCollectedDataInternal(nodeId, dciId, null, null, from, to, maxPoints, HistoricalDataType.PROCESSED, aggregationMode);
    }
 
    /**
@@ -5457,7 +5483,7 @@ public DciData getCollectedTableData(long nodeId, long dciId, String instance, S
    {
       if (instance == null || dataColumn == null)
          throw new NXCException(RCC.INVALID_ARGUMENT);
-      return getCollectedDataInternal(nodeId, dciId, instance, dataColumn, from, to, maxRows, HistoricalDataType.PROCESSED);
+      return getCollectedDataInternal(nodeId, dciId, instance, dataColumn, from, to, maxRows, HistoricalDataType.PROCESSED, DataAggregationMode.NONE);
    }
 
    /**
@@ -37,10 +37,27 @@ static void *s_libpq = nullptr;
 static int (*s_PQsetSingleRowMode)(PGconn *) = nullptr;
 #endif
 
+/**
+ * Pipeline mode functions (available in libpq 14+)
+ */
+static int (*s_PQenterPipelineMode)(PGconn *) = nullptr;
+static int (*s_PQexitPipelineMode)(PGconn *) = nullptr;
+static int (*s_PQpipelineSync)(PGconn *) = nullptr;
+
 #if !HAVE_DECL_PGRES_SINGLE_TUPLE
 #define PGRES_SINGLE_TUPLE    9
 #endif
 
+#ifndef LIBPQ_HAS_PIPELINING
+#define PGRES_PIPELINE_SYNC      10
+#define PGRES_PIPELINE_ABORTED   11
+#endif
+
+/**
+ * Number of batch rows sent in pipeline mode before synchronization point
+ */
+#define PIPELINE_SYNC_INTERVAL   256
+
 #define DEBUG_TAG _T("db.drv.pgsql")
 
 /**
@@ -208,8 +225,16 @@ static bool Initialize(const char *options)
 #ifndef _WIN32
    s_libpq = dlopen("libpq.so.5", RTLD_NOW);
    if (s_libpq != nullptr)
+   {
       s_PQsetSingleRowMode = (int (*)(PGconn *))dlsym(s_libpq, "PQsetSingleRowMode");
+      s_PQenterPipelineMode = (int (*)(PGconn *))dlsym(s_libpq, "PQenterPipelineMode");
+      s_PQexitPipelineMode = (int (*)(PGconn *))dlsym(s_libpq, "PQexitPipelineMode");
+      s_PQpipelineSync = (int (*)(PGconn *))dlsym(s_libpq, "PQpipelineSync");
+      if ((s_PQenterPipelineMode == nullptr) || (s_PQexitPipelineMode == nullptr) || (s_PQpipelineSync == nullptr))
+         s_PQenterPipelineMode = nullptr;
+   }
    nxlog_debug_tag(DEBUG_TAG, 2, _T("PostgreSQL driver: single row mode %s"), (s_PQsetSingleRowMode != NULL) ? _T("enabled") : _T("disabled"));
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("PostgreSQL driver: pipeline mode %s"), (s_PQenterPipelineMode != nullptr) ? _T("enabled") : _T("disabled"));
 #endif
 	return true;
 }
@@ -490,6 +515,188 @@ static void Bind(DBDRV_STATEMENT hStmt, int pos, int sqlType, int cType, void *b
 		MemFree(buffer);
 }
 
+/**
+ * Copy current parameter values into new batch row
+ */
+static void SaveBatchRow(PG_STATEMENT *stmt)
+{
+   PG_BATCH_ROW *row = stmt->batchRows->addPlaceholder();
+   row->pcount = stmt->pcount;
+   row->values = MemAllocArrayNoInit<char*>(stmt->pcount);
+   for(int i = 0; i < stmt->pcount; i++)
+      row->values[i] = MemCopyStringA(stmt->buffers[i]);
+}
+
+/**
+ * Clear saved batch rows
+ */
+static void ClearBatchRows(PG_STATEMENT *stmt)
+{
+   for(int i = 0; i < stmt->batchRows->size(); i++)
+   {
+      PG_BATCH_ROW *row = stmt->batchRows->get(i);
+      for(int j = 0; j < row->pcount; j++)
+         MemFree(row->values[j]);
+      MemFree(row->values);
+   }
+   stmt->batchRows->clear();
+}
+
+/**
+ * Open batch
+ */
+static bool OpenBatch(DBDRV_STATEMENT hStmt)
+{
+   auto stmt = static_cast<PG_STATEMENT*>(hStmt);
+   if (stmt->batchRows != nullptr)
+      ClearBatchRows(stmt);
+   else
+      stmt->batchRows = new StructArray<PG_BATCH_ROW>(64, 64);
+   stmt->batchMode = true;
+   stmt->batchSize = 0;
+   return true;
+}
+
+/**
+ * Start next batch row. Parameter values of current row are saved and used as initial values for new row.
+ */
+static void NextBatchRow(DBDRV_STATEMENT hStmt)
+{
+   auto stmt = static_cast<PG_STATEMENT*>(hStmt);
+   if (!stmt->batchMode)
+      return;
+
+   if (stmt->batchSize > 0)
+      SaveBatchRow(stmt);
+   stmt->batchSize++;
+}
+
+/**
+ * Get error text from failed query result
+ */
+static void GetErrorText(PGconn *handle, PGresult *result, WCHAR *errorText)
+{
+   if (errorText == nullptr)
+      return;
+
+   utf8_to_wchar(CHECK_NULL_EX_A(PQresultErrorField(result, PG_DIAG_SQLSTATE)), -1, errorText, DBDRV_MAX_ERROR_TEXT);
+   int len = (int)wcslen(errorText);
+   if (len > 0)
+   {
+      errorText[len] = L' ';
+      len++;
+   }
+   utf8_to_wchar(PQerrorMessage(handle), -1, &errorText[len], DBDRV_MAX_ERROR_TEXT - len);
+   errorText[DBDRV_MAX_ERROR_TEXT - 1] = 0;
+   RemoveTrailingCRLFW(errorText);
+}
+
+/**
+ * Send batch rows in pipeline mode. Connection should be already in pipeline mode.
+ */
+static uint32_t ExecuteBatchPipeline(PGconn *handle, PG_STATEMENT *stmt, WCHAR *errorText)
+{
+   uint32_t rc = DBERR_SUCCESS;
+   for(int start = 0; (start < stmt->batchRows->size()) && (rc == DBERR_SUCCESS); start += PIPELINE_SYNC_INTERVAL)
+   {
+      int end = std::min(start + PIPELINE_SYNC_INTERVAL, stmt->batchRows->size());
+      for(int i = start; i < end; i++)
+      {
+         PG_BATCH_ROW *row = stmt->batchRows->get(i);
+         int success = (stmt->name[0] != 0) ?
+                  PQsendQueryPrepared(handle, stmt->name, row->pcount, row->values, nullptr, nullptr, 0) :
+                  PQsendQueryParams(handle, stmt->query, row->pcount, nullptr, row->values, nullptr, nullptr, 0);
+         if (!success)
+         {
+            rc = (PQstatus(handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+            if (errorText != nullptr)
+            {
+               utf8_to_wchar(PQerrorMessage(handle), -1, errorText, DBDRV_MAX_ERROR_TEXT);
+               errorText[DBDRV_MAX_ERROR_TEXT - 1] = 0;
+               RemoveTrailingCRLFW(errorText);
+            }
+            break;
+         }
+      }
+      if (!s_PQpipelineSync(handle))
+      {
+         if (rc == DBERR_SUCCESS)
+            rc = (PQstatus(handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+         break;
+      }
+
+      // Read all results up to synchronization point
+      bool nullResult = false;
+      while(true)
+      {
+         PGresult *result = PQgetResult(handle);
+         if (result == nullptr)
+         {
+            if (nullResult)
+               break;   // Two NULL results in a row - no more results available
+            nullResult = true;
+            continue;
+         }
+         nullResult = false;
+
+         int status = static_cast<int>(PQresultStatus(result));
+         if (status == PGRES_PIPELINE_SYNC)
+         {
+            PQclear(result);
+            break;
+         }
+         if ((status != PGRES_COMMAND_OK) && (status != PGRES_TUPLES_OK) && (rc == DBERR_SUCCESS))
+         {
+            GetErrorText(handle, result, errorText);
+            rc = (PQstatus(handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+         }
+         PQclear(result);
+      }
+   }
+   return rc;
+}
+
+/**
+ * Execute batch
+ */
+static uint32_t ExecuteBatch(PG_CONN *connection, PG_STATEMENT *stmt, WCHAR *errorText)
+{
+   SaveBatchRow(stmt);
+
+   uint32_t rc = DBERR_SUCCESS;
+   connection->mutexQueryLock.lock();
+   if ((s_PQenterPipelineMode != nullptr) && s_PQenterPipelineMode(connection->handle))
+   {
+      rc = ExecuteBatchPipeline(connection->handle, stmt, errorText);
+      s_PQexitPipelineMode(connection->handle);
+   }
+   else
+   {
+      for(int i = 0; (i < stmt->batchRows->size()) && (rc == DBERR_SUCCESS); i++)
+      {
+         PG_BATCH_ROW *row = stmt->batchRows->get(i);
+         PGresult *result = (stmt->name[0] != 0) ?
+            PQexecPrepared(connection->handle, stmt->name, row->pcount, row->values, nullptr, nullptr, 0) :
+            PQexecParams(connection->handle, stmt->query, row->pcount, nullptr, row->values, nullptr, nullptr, 0);
+         if (PQresultStatus(result) != PGRES_COMMAND_OK)
+         {
+            GetErrorText(connection->handle, result, errorText);
+            rc = (PQstatus(connection->handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+         }
+         PQclear(result);
+      }
+   }
+   connection->mutexQueryLock.unlock();
+
+   if ((rc == DBERR_SUCCESS) && (errorText != nullptr))
+      *errorText = 0;
+
+   ClearBatchRows(stmt);
+   stmt->batchMode = false;
+   stmt->batchSize = 0;
+   return rc;
+}
+
 /**
  * Execute prepared statement
  */
@@ -498,6 +705,16 @@ static uint32_t Execute(DBDRV_CONNECTION connection, DBDRV_STATEMENT hStmt, WCHA
 	uint32_t rc;
    auto stmt = static_cast<PG_STATEMENT*>(hStmt);
 
+   if (stmt->batchMode)
+   {
+      if (stmt->batchSize == 0)
+      {
+         stmt->batchMode = false;
+         return DBERR_SUCCESS;   // empty batch
+      }
+      return ExecuteBatch(static_cast<PG_CONN*>(connection), stmt, errorText);
+   }
+
 	static_cast<PG_CONN*>(connection)->mutexQueryLock.lock();
    bool retry;
    int retryCount = 60;
@@ -525,19 +742,7 @@ static uint32_t Execute(DBDRV_CONNECTION connection, DBDRV_STATEMENT hStmt, WCHA
          }
          else
          {
-            if (errorText != nullptr)
-            {
-               utf8_to_wchar(CHECK_NULL_EX_A(sqlState), -1, errorText, DBDRV_MAX_ERROR_TEXT);
-               int len = (int)wcslen(errorText);
-               if (len > 0)
-               {
-                  errorText[len] = L' ';
-                  len++;
-               }
-               utf8_to_wchar(PQerrorMessage(static_cast<PG_CONN*>(connection)->handle), -1, &errorText[len], DBDRV_MAX_ERROR_TEXT - len);
-               errorText[DBDRV_MAX_ERROR_TEXT - 1] = 0;
-               RemoveTrailingCRLFW(errorText);
-            }
+            GetErrorText(static_cast<PG_CONN*>(connection)->handle, pResult, errorText);
             rc = (PQstatus(static_cast<PG_CONN*>(connection)->handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
          }
       }
@@ -574,6 +779,12 @@ static void FreeStatement(DBDRV_STATEMENT hStmt)
 	   MemFree(stmt->buffers[i]);
 	MemFree(stmt->buffers);
 
+   if (stmt->batchRows != nullptr)
+   {
+      ClearBatchRows(stmt);
+      delete stmt->batchRows;
+   }
+
 	MemFree(stmt);
 }
 
@@ -1290,8 +1501,8 @@ static DBDriverCallTable s_callTable =
    nullptr, // SetPrefetchLimit
    Prepare,
    FreeStatement,
-   nullptr, // OpenBatch
-   nullptr, // NextBatchRow
+   OpenBatch,
+   NextBatchRow,
    Bind,
    Execute,
    Query,
@@ -59,6 +59,15 @@ struct PG_CONN
 	}
 };
 
+/**
+ * Parameter set for one row in batch
+ */
+struct PG_BATCH_ROW
+{
+   int pcount;
+   char **values;
+};
+
 /**
  * Prepared statement
  */
@@ -70,6 +79,9 @@ struct PG_STATEMENT
 	int pcount;		// Number of parameters
 	int allocated;	// Allocated buffers
 	char **buffers;	
+   bool batchMode;
+   int batchSize;
+   StructArray<PG_BATCH_ROW> *batchRows;
 };
 
 /**
@@ -53,6 +53,17 @@ struct db_driver_t
 	void *m_context;
 };
 
+/**
+ * Parameter binding saved for emulated batch execution
+ */
+struct BatchBinding
+{
+   int pos;
+   int sqlType;
+   int cType;
+   void *buffer;
+};
+
 /**
  * Prepared statement
  */
@@ -62,6 +73,7 @@ struct db_statement_t
 	DB_HANDLE m_connection;
 	DBDRV_STATEMENT m_statement;
 	TCHAR *m_query;
+   ObjectArray<StructArray<BatchBinding>> *m_batch;   // Emulated batch (for drivers without native batch support)
 };
 
 /**
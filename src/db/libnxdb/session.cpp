@@ -1253,6 +1253,23 @@ DB_STATEMENT LIBNXDB_EXPORTABLE DBPrepare(DB_HANDLE hConn, const TCHAR *query, b
 	return DBPrepareEx(hConn, query, optimizeForReuse, errorText);
 }
 
+/**
+ * Destroy emulated batch and all saved bindings
+ */
+static void DestroyEmulatedBatch(DB_STATEMENT hStmt)
+{
+   if (hStmt->m_batch == nullptr)
+      return;
+
+   for(int i = 0; i < hStmt->m_batch->size(); i++)
+   {
+      StructArray<BatchBinding> *row = hStmt->m_batch->get(i);
+      for(int j = 0; j < row->size(); j++)
+         MemFree(row->get(j)->buffer);
+   }
+   delete_and_null(hStmt->m_batch);
+}
+
 /**
  * Destroy prepared statement
  */
@@ -1268,6 +1285,7 @@ void LIBNXDB_EXPORTABLE DBFreeStatement(DB_STATEMENT hStmt)
       hStmt->m_connection->m_preparedStatementsLock->unlock();
    }
    hStmt->m_driver->m_callTable.FreeStatement(hStmt->m_statement);
+   DestroyEmulatedBatch(hStmt);
    MemFree(hStmt->m_query);
    MemFree(hStmt);
 }
@@ -1281,13 +1299,20 @@ const TCHAR LIBNXDB_EXPORTABLE *DBGetStatementSource(DB_STATEMENT hStmt)
 }
 
 /**
- * Open batch
+ * Open batch. If driver does not support batch execution natively, batch will be emulated by
+ * saving bindings for each row and executing statement for each row separately in DBExecute.
  */
 bool LIBNXDB_EXPORTABLE DBOpenBatch(DB_STATEMENT hStmt)
 {
-   if (!IS_VALID_STATEMENT_HANDLE(hStmt) || (hStmt->m_driver->m_callTable.OpenBatch == nullptr))
+   if (!IS_VALID_STATEMENT_HANDLE(hStmt))
       return false;
-   return hStmt->m_driver->m_callTable.OpenBatch(hStmt->m_statement);
+
+   if (hStmt->m_driver->m_callTable.OpenBatch != nullptr)
+      return hStmt->m_driver->m_callTable.OpenBatch(hStmt->m_statement);
+
+   DestroyEmulatedBatch(hStmt);
+   hStmt->m_batch = new ObjectArray<StructArray<BatchBinding>>(64, 64, Ownership::True);
+   return true;
 }
 
 /**
@@ -1295,10 +1320,59 @@ bool LIBNXDB_EXPORTABLE DBOpenBatch(DB_STATEMENT hStmt)
  */
 void LIBNXDB_EXPORTABLE DBNextBatchRow(DB_STATEMENT hStmt)
 {
-   if (IS_VALID_STATEMENT_HANDLE(hStmt) && (hStmt->m_driver->m_callTable.NextBatchRow != nullptr))
+   if (!IS_VALID_STATEMENT_HANDLE(hStmt))
+      return;
+
+   if (hStmt->m_batch != nullptr)
+      hStmt->m_batch->add(new StructArray<BatchBinding>(16, 16));
+   else if (hStmt->m_driver->m_callTable.NextBatchRow != nullptr)
       hStmt->m_driver->m_callTable.NextBatchRow(hStmt->m_statement);
 }
 
+/**
+ * Save binding for emulated batch
+ */
+static void SaveBatchBinding(DB_STATEMENT hStmt, int pos, int sqlType, int cType, void *buffer, int allocType)
+{
+   if (hStmt->m_batch->isEmpty())
+      hStmt->m_batch->add(new StructArray<BatchBinding>(16, 16));
+
+   BatchBinding *b = hStmt->m_batch->last()->addPlaceholder();
+   b->pos = pos;
+   b->sqlType = sqlType;
+   b->cType = cType;
+   if (allocType == DB_BIND_DYNAMIC)
+   {
+      b->buffer = buffer;
+   }
+   else
+   {
+      switch(cType)
+      {
+         case DB_CTYPE_STRING:
+            b->buffer = MemCopyStringW(static_cast<WCHAR*>(buffer));
+            break;
+         case DB_CTYPE_UTF8_STRING:
+            b->buffer = MemCopyStringA(static_cast<char*>(buffer));
+            break;
+         case DB_CTYPE_INT32:
+         case DB_CTYPE_UINT32:
+            b->buffer = MemCopyBlock(buffer, sizeof(int32_t));
+            break;
+         case DB_CTYPE_INT64:
+         case DB_CTYPE_UINT64:
+            b->buffer = MemCopyBlock(buffer, sizeof(int64_t));
+            break;
+         case DB_CTYPE_DOUBLE:
+            b->buffer = MemCopyBlock(buffer, sizeof(double));
+            break;
+         default:
+            b->buffer = nullptr;
+            break;
+      }
+   }
+}
+
 /**
  * Bind parameter (generic)
  */
@@ -1360,7 +1434,10 @@ void LIBNXDB_EXPORTABLE DBBind(DB_STATEMENT hStmt, int pos, int sqlType, int cTy
 		wBuffer = const_cast<void*>(buffer);
 	}
 #endif
-	hStmt->m_driver->m_callTable.Bind(hStmt->m_statement, pos, sqlType, cType, wBuffer, realAllocType);
+   if (hStmt->m_batch != nullptr)
+      SaveBatchBinding(hStmt, pos, sqlType, cType, wBuffer, realAllocType);
+   else
+      hStmt->m_driver->m_callTable.Bind(hStmt->m_statement, pos, sqlType, cType, wBuffer, realAllocType);
 #undef wBuffer
 #undef realAllocType
 }
@@ -1497,6 +1574,42 @@ void LIBNXDB_EXPORTABLE DBBind(DB_STATEMENT hStmt, int pos, int sqlType, json_t
    }
 }
 
+/**
+ * Execute emulated batch - bind and execute each saved row separately. Bindings not changed
+ * in a row are inherited from previous row, as driver keeps last bound values.
+ */
+static bool ExecuteEmulatedBatch(DB_STATEMENT hStmt, TCHAR *errorText)
+{
+   ObjectArray<StructArray<BatchBinding>> *batch = hStmt->m_batch;
+   hStmt->m_batch = nullptr;
+
+   bool success = true;
+   for(int i = 0; i < batch->size(); i++)
+   {
+      StructArray<BatchBinding> *row = batch->get(i);
+      if (success)
+      {
+         for(int j = 0; j < row->size(); j++)
+         {
+            BatchBinding *b = row->get(j);
+            hStmt->m_driver->m_callTable.Bind(hStmt->m_statement, b->pos, b->sqlType, b->cType, b->buffer, DB_BIND_DYNAMIC);
+            b->buffer = nullptr;
+         }
+         success = DBExecuteEx(hStmt, errorText);
+      }
+      else
+      {
+         for(int j = 0; j < row->size(); j++)
+            MemFree(row->get(j)->buffer);
+      }
+   }
+   delete batch;
+
+   if (success)
+      *errorText = 0;
+   return success;
+}
+
 /**
  * Execute prepared statement (non-SELECT)
  */
@@ -1508,6 +1621,9 @@ bool LIBNXDB_EXPORTABLE DBExecuteEx(DB_STATEMENT hStmt, TCHAR *errorText)
       return false;
    }
 
+   if (hStmt->m_batch != nullptr)
+      return ExecuteEmulatedBatch(hStmt, errorText);
+
 #ifdef UNICODE
 #define wcErrorText errorText
 #else
@@ -2031,6 +2031,20 @@ int ipfix_get_template_ident(ipfix_template_t *t, char *identbuf, size_t buflen)
    return 0;
 }
 
+/*
+ * name:        ipfix_free_sources()
+ * parameters:  <> sources - list of sources created by ipfix_parse_msg()
+ * return:      void
+ * remarks:     frees all sources in given list together with their templates
+ */
+void ipfix_free_sources(ipfixs_node_t **sources)
+{
+   while (*sources)
+   {
+      _delete_ipfix_source(sources, *sources);
+   }
+}
+
 /*
  * name:        ipfix_col_cleanup()
  * parameters:  none
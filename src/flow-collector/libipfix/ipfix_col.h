@@ -102,8 +102,9 @@ void LIBIPFIX_EXPORTABLE ipfix_col_cleanup( void );
 int  ipfix_parse_hdr( const uint8_t *buf, size_t buflen, ipfix_hdr_t *hdr );
 int  ipfix_parse_raw_msg( ipfixs_node_t *source, ipfixe_node_t  *g_exporter,
                       const uint8_t *msg, size_t nbytes );
-int  ipfix_parse_msg( ipfix_input_t *input, ipfixs_node_t **sources, 
+int  LIBIPFIX_EXPORTABLE ipfix_parse_msg( ipfix_input_t *input, ipfixs_node_t **sources, 
                       const uint8_t *msg, size_t nbytes );
+void LIBIPFIX_EXPORTABLE ipfix_free_sources( ipfixs_node_t **sources );
 int  ipfix_get_template_ident( ipfix_template_t *t, char *buf, size_t buflen );
 int  ipfix_col_listen_ssl( ipfix_col_t **handle, ipfix_proto_t protocol, 
                            int port, int family, int maxcon,
@@ -4,6 +4,7 @@
 */
 
 #include "nxflowd.h"
+#include <nxqueue.h>
 
 
 //
@@ -11,6 +12,7 @@
 //
 
 static THREAD s_collectorThread = INVALID_THREAD_HANDLE;
+static THREAD s_writerThread = INVALID_THREAD_HANDLE;
 static ipfix_col_info_t *s_collectorInfo = NULL;
 static int s_numTcpSockets = 0;
 static SOCKET *s_tcpSockets = NULL;
@@ -18,12 +20,408 @@ static int s_numUdpSockets = 0;
 static SOCKET *s_udpSockets = NULL;
 static INT64 s_flowId = 1;
 
+/**
+ * Flow fields stored in database (bit position in field mask is index in s_dbFields)
+ */
+#define FLOW_FIELD_EXPORTER_IP_ADDR    0x0001
+#define FLOW_FIELD_SOURCE_MAC_ADDR     0x0002
+#define FLOW_FIELD_DEST_MAC_ADDR       0x0004
+#define FLOW_FIELD_SOURCE_IP_ADDR      0x0008
+#define FLOW_FIELD_DEST_IP_ADDR        0x0010
+#define FLOW_FIELD_IP_PROTO            0x0020
+#define FLOW_FIELD_SOURCE_IP_PORT      0x0040
+#define FLOW_FIELD_DEST_IP_PORT        0x0080
+#define FLOW_FIELD_OCTET_COUNT         0x0100
+#define FLOW_FIELD_PACKET_COUNT        0x0200
+#define FLOW_FIELD_INGRESS_INTERFACE   0x0400
+#define FLOW_FIELD_EGRESS_INTERFACE    0x0800
+
+#define FLOW_FIELD_COUNT               12
+
+static const TCHAR *s_dbFields[FLOW_FIELD_COUNT] =
+{
+   _T("exporter_ip_addr"),
+   _T("source_mac_addr"),
+   _T("dest_mac_addr"),
+   _T("source_ip_addr"),
+   _T("dest_ip_addr"),
+   _T("ip_proto"),
+   _T("source_ip_port"),
+   _T("dest_ip_port"),
+   _T("octet_count"),
+   _T("packet_count"),
+   _T("ingress_interface"),
+   _T("egress_interface")
+};
+
+/**
+ * Flow key (exporter and 5-tuple). Used for pre-aggregation, so it should not contain any padding.
+ * Exporter is identified by address packets were received from and observation domain, because
+ * exporter IP address field is optional in flow records.
+ */
+struct FlowKey
+{
+   BYTE exporterAddr[4];
+   BYTE exporterSourceAddr[16];
+   BYTE sourceAddr[16];
+   BYTE destAddr[16];
+   uint32_t observationDomain;
+   uint16_t sourcePort;
+   uint16_t destPort;
+   uint8_t sourceAddrLen;
+   uint8_t destAddrLen;
+   uint8_t protocol;
+   uint8_t exporterSourceAddrLen;
+};
+
+/**
+ * Decoded flow record
+ */
+struct FlowRecord
+{
+   FlowKey key;
+   uint32_t fields;
+   BYTE sourceMacAddr[6];
+   BYTE destMacAddr[6];
+   uint32_t ingressInterface;
+   uint32_t egressInterface;
+   uint64_t octetCount;
+   uint64_t packetCount;
+   int64_t startTime;
+   int64_t endTime;
+};
+
+/**
+ * Field decoder operations
+ */
+enum FieldDecoderOp
+{
+   FD_START_SYSUPTIME,
+   FD_END_SYSUPTIME,
+   FD_START_SECONDS,
+   FD_END_SECONDS,
+   FD_START_MILLISECONDS,
+   FD_END_MILLISECONDS,
+   FD_START_MICROSECONDS,
+   FD_END_MICROSECONDS,
+   FD_START_NANOSECONDS,
+   FD_END_NANOSECONDS,
+   FD_START_DELTA_MICROSECONDS,
+   FD_END_DELTA_MICROSECONDS,
+   FD_EXPORTER_IP_ADDR,
+   FD_SOURCE_MAC_ADDR,
+   FD_DEST_MAC_ADDR,
+   FD_SOURCE_IP_ADDR,
+   FD_DEST_IP_ADDR,
+   FD_IP_PROTO,
+   FD_SOURCE_IP_PORT,
+   FD_DEST_IP_PORT,
+   FD_OCTET_COUNT,
+   FD_PACKET_COUNT,
+   FD_INGRESS_INTERFACE,
+   FD_EGRESS_INTERFACE
+};
+
+/**
+ * Mapping between IPFIX field types and decoder operations
+ */
+static struct
+{
+   int ipfixField;
+   FieldDecoderOp op;
+} s_fieldMapping[] =
+{
+   { IPFIX_FT_FLOWSTARTSYSUPTIME, FD_START_SYSUPTIME },
+   { IPFIX_FT_FLOWENDSYSUPTIME, FD_END_SYSUPTIME },
+   { IPFIX_FT_FLOWSTARTSECONDS, FD_START_SECONDS },
+   { IPFIX_FT_FLOWENDSECONDS, FD_END_SECONDS },
+   { IPFIX_FT_FLOWSTARTMILLISECONDS, FD_START_MILLISECONDS },
+   { IPFIX_FT_FLOWENDMILLISECONDS, FD_END_MILLISECONDS },
+   { IPFIX_FT_FLOWSTARTMICROSECONDS, FD_START_MICROSECONDS },
+   { IPFIX_FT_FLOWENDMICROSECONDS, FD_END_MICROSECONDS },
+   { IPFIX_FT_FLOWSTARTNANOSECONDS, FD_START_NANOSECONDS },
+   { IPFIX_FT_FLOWENDNANOSECONDS, FD_END_NANOSECONDS },
+   { IPFIX_FT_FLOWSTARTDELTAMICROSECONDS, FD_START_DELTA_MICROSECONDS },
+   { IPFIX_FT_FLOWENDDELTAMICROSECONDS, FD_END_DELTA_MICROSECONDS },
+   { IPFIX_FT_EXPORTERIPV4ADDRESS, FD_EXPORTER_IP_ADDR },
+   { IPFIX_FT_SOURCEMACADDRESS, FD_SOURCE_MAC_ADDR },
+   { IPFIX_FT_DESTINATIONMACADDRESS, FD_DEST_MAC_ADDR },
+   { IPFIX_FT_SOURCEIPV4ADDRESS, FD_SOURCE_IP_ADDR },
+   { IPFIX_FT_SOURCEIPV6ADDRESS, FD_SOURCE_IP_ADDR },
+   { IPFIX_FT_DESTINATIONIPV4ADDRESS, FD_DEST_IP_ADDR },
+   { IPFIX_FT_DESTINATIONIPV6ADDRESS, FD_DEST_IP_ADDR },
+   { IPFIX_FT_PROTOCOLIDENTIFIER, FD_IP_PROTO },
+   { IPFIX_FT_SOURCETRANSPORTPORT, FD_SOURCE_IP_PORT },
+   { IPFIX_FT_DESTINATIONTRANSPORTPORT, FD_DEST_IP_PORT },
+   { IPFIX_FT_OCTETDELTACOUNT, FD_OCTET_COUNT },
+   { IPFIX_FT_PACKETDELTACOUNT, FD_PACKET_COUNT },
+   { IPFIX_FT_INGRESSINTERFACE, FD_INGRESS_INTERFACE },
+   { IPFIX_FT_EGRESSINTERFACE, FD_EGRESS_INTERFACE },
+   { 0, FD_START_SYSUPTIME }
+};
+
+/**
+ * Single field decoder
+ */
+struct FieldDecoder
+{
+   int index;
+   FieldDecoderOp op;
+};
+
+/**
+ * Template compiled into list of field decoders. Only fields used by collector are included.
+ */
+class CompiledTemplate
+{
+private:
+   const ipfix_template_t *m_template;
+   int m_numFields;
+   StructArray<FieldDecoder> m_decoders;
+
+public:
+   CompiledTemplate(const ipfix_template_t *t);
+
+   bool isValidFor(const ipfix_template_t *t) const { return (t == m_template) && (t->nfields == m_numFields); }
+   bool decode(const ipfixs_node_t *node, const ipfix_datarecord_t *data, FlowRecord *flow) const;
+};
+
+/**
+ * Key for compiled template cache (exporter and template ID)
+ */
+struct CompiledTemplateKey
+{
+   const ipfixs_node_t *source;
+   uint32_t tid;
+   uint32_t reserved;
+};
+
+/**
+ * Compiled template cache. Accessed only from collector thread.
+ */
+static HashMap<CompiledTemplateKey, CompiledTemplate> s_compiledTemplates(Ownership::True);
+
+/**
+ * Batch of decoded flows being filled by collector thread
+ */
+static StructArray<FlowRecord> *s_decodedFlows = NULL;
+
+/**
+ * Queue of decoded flow batches waiting for writer
+ */
+static ObjectQueue<StructArray<FlowRecord>> s_writerQueue(64, Ownership::True);
+
+/**
+ * Collector statistics
+ */
+static uint64_t s_flowsReceived = 0;  // Updated only by collector thread
+static uint64_t s_flowsWritten = 0;   // Updated only by writer thread
+static uint64_t s_flowsDropped = 0;   // Updated only by collector thread
+
+/**
+ * Get unsigned integer value from data field
+ */
+static inline uint64_t UInt64FromData(const void *data, int len)
+{
+   switch(len)
+   {
+      case 1:
+         return *static_cast<const uint8_t*>(data);
+      case 2:
+         {
+            uint16_t v;
+            memcpy(&v, data, 2);
+            return v;
+         }
+      case 4:
+         {
+            uint32_t v;
+            memcpy(&v, data, 4);
+            return v;
+         }
+      case 8:
+         {
+            uint64_t v;
+            memcpy(&v, data, 8);
+            return v;
+         }
+      default:
+         return 0;
+   }
+}
+
+/**
+ * Compile template
+ */
+CompiledTemplate::CompiledTemplate(const ipfix_template_t *t) : m_decoders(t->nfields, 16)
+{
+   m_template = t;
+   m_numFields = t->nfields;
+   for(int i = 0; i < t->nfields; i++)
+   {
+      if (t->fields[i].elem->ft->eno != IPFIX_FT_NOENO)
+         continue;
+
+      int ftype = t->fields[i].elem->ft->ftype;
+      for(int j = 0; s_fieldMapping[j].ipfixField != 0; j++)
+      {
+         if (ftype == s_fieldMapping[j].ipfixField)
+         {
+            FieldDecoder *d = m_decoders.addPlaceholder();
+            d->index = i;
+            d->op = s_fieldMapping[j].op;
+            break;
+         }
+      }
+   }
+}
+
+/**
+ * Decode data record using compiled template. Returns false if record should be ignored.
+ */
+bool CompiledTemplate::decode(const ipfixs_node_t *node, const ipfix_datarecord_t *data, FlowRecord *flow) const
+{
+   memset(flow, 0, sizeof(FlowRecord));
+
+   flow->key.observationDomain = node->odid;
+   if ((node->input != nullptr) && (node->input->type == IPFIX_INPUT_IPCON) && (node->input->u.ipcon.addr != nullptr))
+   {
+      const struct sockaddr *addr = node->input->u.ipcon.addr;
+      if (addr->sa_family == AF_INET)
+      {
+         memcpy(flow->key.exporterSourceAddr, &reinterpret_cast<const struct sockaddr_in*>(addr)->sin_addr, 4);
+         flow->key.exporterSourceAddrLen = 4;
+      }
+#ifdef WITH_IPV6
+      else if (addr->sa_family == AF_INET6)
+      {
+         memcpy(flow->key.exporterSourceAddr, &reinterpret_cast<const struct sockaddr_in6*>(addr)->sin6_addr, 16);
+         flow->key.exporterSourceAddrLen = 16;
+      }
+#endif
+   }
+   for(int i = 0; i < m_decoders.size(); i++)
+   {
+      const FieldDecoder *d = m_decoders.get(i);
+      const void *value = data->addrs[d->index];
+      int len = data->lens[d->index];
+      switch(d->op)
+      {
+         case FD_START_SYSUPTIME:
+            if (node->boot_time != 0)
+               flow->startTime = static_cast<int64_t>(node->boot_time) * 1000 + UInt64FromData(value, len);
+            break;
+         case FD_END_SYSUPTIME:
+            if (node->boot_time != 0)
+               flow->endTime = static_cast<int64_t>(node->boot_time) * 1000 + UInt64FromData(value, len);
+            break;
+         case FD_START_SECONDS:
+            flow->startTime = UInt64FromData(value, len) * 1000;
+            break;
+         case FD_END_SECONDS:
+            flow->endTime = UInt64FromData(value, len) * 1000;
+            break;
+         case FD_START_MILLISECONDS:
+            flow->startTime = UInt64FromData(value, len);
+            break;
+         case FD_END_MILLISECONDS:
+            flow->endTime = UInt64FromData(value, len);
+            break;
+         case FD_START_MICROSECONDS:
+            flow->startTime = UInt64FromData(value, len) / 1000;
+            break;
+         case FD_END_MICROSECONDS:
+            flow->endTime = UInt64FromData(value, len) / 1000;
+            break;
+         case FD_START_NANOSECONDS:
+            flow->startTime = UInt64FromData(value, len) / 1000000;
+            break;
+         case FD_END_NANOSECONDS:
+            flow->endTime = UInt64FromData(value, len) / 1000000;
+            break;
+         case FD_START_DELTA_MICROSECONDS:
+            if (node->export_time != 0)
+               flow->startTime = static_cast<int64_t>(node->export_time) * 1000 + UInt64FromData(value, len);
+            break;
+         case FD_END_DELTA_MICROSECONDS:
+            if (node->export_time != 0)
+               flow->endTime = static_cast<int64_t>(node->export_time) * 1000 + UInt64FromData(value, len);
+            break;
+         case FD_EXPORTER_IP_ADDR:
+            if (len == 4)
+            {
+               memcpy(flow->key.exporterAddr, value, 4);
+               flow->fields |= FLOW_FIELD_EXPORTER_IP_ADDR;
+            }
+            break;
+         case FD_SOURCE_MAC_ADDR:
+            if (len == 6)
+            {
+               memcpy(flow->sourceMacAddr, value, 6);
+               flow->fields |= FLOW_FIELD_SOURCE_MAC_ADDR;
+            }
+            break;
+         case FD_DEST_MAC_ADDR:
+            if (len == 6)
+            {
+               memcpy(flow->destMacAddr, value, 6);
+               flow->fields |= FLOW_FIELD_DEST_MAC_ADDR;
+            }
+            break;
+         case FD_SOURCE_IP_ADDR:
+            if ((len == 4) || (len == 16))
+            {
+               memcpy(flow->key.sourceAddr, value, len);
+               flow->key.sourceAddrLen = static_cast<uint8_t>(len);
+               flow->fields |= FLOW_FIELD_SOURCE_IP_ADDR;
+            }
+            break;
+         case FD_DEST_IP_ADDR:
+            if ((len == 4) || (len == 16))
+            {
+               memcpy(flow->key.destAddr, value, len);
+               flow->key.destAddrLen = static_cast<uint8_t>(len);
+               flow->fields |= FLOW_FIELD_DEST_IP_ADDR;
+            }
+            break;
+         case FD_IP_PROTO:
+            flow->key.protocol = static_cast<uint8_t>(UInt64FromData(value, len));
+            flow->fields |= FLOW_FIELD_IP_PROTO;
+            break;
+         case FD_SOURCE_IP_PORT:
+            flow->key.sourcePort = static_cast<uint16_t>(UInt64FromData(value, len));
+            flow->fields |= FLOW_FIELD_SOURCE_IP_PORT;
+            break;
+         case FD_DEST_IP_PORT:
+            flow->key.destPort = static_cast<uint16_t>(UInt64FromData(value, len));
+            flow->fields |= FLOW_FIELD_DEST_IP_PORT;
+            break;
+         case FD_OCTET_COUNT:
+            flow->octetCount = UInt64FromData(value, len);
+            flow->fields |= FLOW_FIELD_OCTET_COUNT;
+            break;
+         case FD_PACKET_COUNT:
+            flow->packetCount = UInt64FromData(value, len);
+            flow->fields |= FLOW_FIELD_PACKET_COUNT;
+            break;
+         case FD_INGRESS_INTERFACE:
+            flow->ingressInterface = static_cast<uint32_t>(UInt64FromData(value, len));
+            flow->fields |= FLOW_FIELD_INGRESS_INTERFACE;
+            break;
+         case FD_EGRESS_INTERFACE:
+            flow->egressInterface = static_cast<uint32_t>(UInt64FromData(value, len));
+            flow->fields |= FLOW_FIELD_EGRESS_INTERFACE;
+            break;
+      }
+   }
+   return (flow->fields != 0) && (flow->startTime != 0) && (flow->endTime != 0);
+}
 
 //
 // Handler for new message
 //
 
-static int H_NewMessage(ipfixs_node_t *node, ipfix_hdr_t *header, void *arg) 
+static int H_NewMessage(ipfixs_node_t *node, ipfix_hdr_t *header, void *arg)
 {
 	if (header->version == IPFIX_VERSION_NF9)
 	{
@@ -38,140 +436,370 @@ static int H_NewMessage(ipfixs_node_t *node, ipfix_hdr_t *header, void *arg)
 	return 0;
 }
 
+/**
+ * Handler for template record - drop compiled version of previous template with same ID
+ */
+static int H_TemplateRecord(ipfixs_node_t *node, ipfixt_node_t *trec, void *arg)
+{
+   CompiledTemplateKey key;
+   memset(&key, 0, sizeof(key));
+   key.source = node;
+   key.tid = trec->ipfixt->tid;
+   s_compiledTemplates.remove(key);
+   return 0;
+}
 
-//
-// Get 64bit integer value from data field
-//
+/**
+ * Pass current batch of decoded flows to writer. If writer queue is full, either wait for writer
+ * (when replaying capture file) or drop new batch, so memory usage is bounded when database
+ * is slower than incoming flows.
+ */
+void FlushDecodedFlows()
+{
+   if ((s_decodedFlows == NULL) || (s_decodedFlows->size() == 0))
+      return;
+
+   if (g_flags & AF_BLOCK_ON_QUEUE_FULL)
+   {
+      while(s_writerQueue.size() >= g_maxWriterQueueSize)
+         ThreadSleepMs(10);
+   }
+   else if (s_writerQueue.size() >= g_maxWriterQueueSize)
+   {
+      s_flowsDropped += s_decodedFlows->size();
+      nxlog_debug(5, _T("Writer queue is full, %d flows dropped (") UINT64_FMT _T(" total)"), s_decodedFlows->size(), s_flowsDropped);
+      s_decodedFlows->clear();
+      return;
+   }
+
+   s_writerQueue.put(s_decodedFlows);
+   s_decodedFlows = NULL;
+}
 
-static INT64 Int64FromData(void *data, int len)
+/**
+ * Handler for data record
+ */
+static int H_DataRecord(ipfixs_node_t *node, ipfixt_node_t *trec, ipfix_datarecord_t *data, void *arg)
 {
-	INT64 value;
+   CompiledTemplateKey key;
+   memset(&key, 0, sizeof(key));
+   key.source = node;
+   key.tid = trec->ipfixt->tid;
+   CompiledTemplate *t = s_compiledTemplates.get(key);
+   if ((t == NULL) || !t->isValidFor(trec->ipfixt))
+   {
+      t = new CompiledTemplate(trec->ipfixt);
+      s_compiledTemplates.set(key, t);
+   }
+
+   if (s_decodedFlows == NULL)
+      s_decodedFlows = new StructArray<FlowRecord>(g_batchSize, g_batchSize);
+
+   FlowRecord *flow = s_decodedFlows->addPlaceholder();
+   if (t->decode(node, data, flow))
+   {
+      s_flowsReceived++;
+      if (s_decodedFlows->size() >= static_cast<int>(g_batchSize))
+         FlushDecodedFlows();
+   }
+   else
+   {
+      s_decodedFlows->remove(s_decodedFlows->size() - 1);
+   }
+   return 0;
+}
 
-	switch(len)
-	{
-		case 1:
-			value = *((char *)data);
-			break;
-		case 2:
-			value = *((short *)data);
-			break;
-		case 4:
-			value = *((LONG *)data);
-			break;
-		case 8:
-			value = *((INT64 *)data);
-			break;
-		default:
-			value = 0;
-			break;
-	}
-	return value;
+/**
+ * Prepared insert statement for specific set of fields
+ */
+struct InsertStatement
+{
+   uint32_t fields;
+   DB_STATEMENT hStmt;
+};
+
+/**
+ * Get prepared insert statement for given set of fields
+ */
+static DB_STATEMENT GetInsertStatement(StructArray<InsertStatement> *cache, uint32_t fields)
+{
+   for(int i = 0; i < cache->size(); i++)
+   {
+      InsertStatement *s = cache->get(i);
+      if (s->fields == fields)
+         return s->hStmt;
+   }
+
+   StringBuffer query(_T("INSERT INTO flows (flow_id,start_time,end_time"));
+   int count = 3;
+   for(int i = 0; i < FLOW_FIELD_COUNT; i++)
+   {
+      if (fields & (1 << i))
+      {
+         query.append(_T(','));
+         query.append(s_dbFields[i]);
+         count++;
+      }
+   }
+   query.append(_T(") VALUES (?"));
+   for(int i = 1; i < count; i++)
+      query.append(_T(",?"));
+   query.append(_T(')'));
+
+   DB_STATEMENT hStmt = DBPrepare(g_dbConnection, query, true);
+   if (hStmt != NULL)
+   {
+      InsertStatement *s = cache->addPlaceholder();
+      s->fields = fields;
+      s->hStmt = hStmt;
+   }
+   return hStmt;
 }
 
+/**
+ * Format MAC address the same way as IPFIX library does for octet arrays
+ */
+static TCHAR *FormatMacAddress(const BYTE *addr, TCHAR *buffer)
+{
+   _sntprintf(buffer, 16, _T("0x%02x%02x%02x%02x%02x%02x"), addr[0], addr[1], addr[2], addr[3], addr[4], addr[5]);
+   return buffer;
+}
 
-//
-// Handler for data record
-//
+/**
+ * Format IP address
+ */
+static TCHAR *FormatIpAddress(const BYTE *addr, int len, TCHAR *buffer)
+{
+   if (len == 4)
+      return InetAddress(ntohl(*reinterpret_cast<const uint32_t*>(addr))).toString(buffer);
+   return InetAddress(addr).toString(buffer);
+}
 
-static struct
+/**
+ * Bind flow record to insert statement
+ */
+static void BindFlowRecord(DB_STATEMENT hStmt, const FlowRecord *flow)
 {
-	int ipfixField;
-	const TCHAR *dbField;
-} s_fieldMapping[] =
+   DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, static_cast<int64_t>(s_flowId++));
+   DBBind(hStmt, 2, DB_SQLTYPE_BIGINT, flow->startTime);
+   DBBind(hStmt, 3, DB_SQLTYPE_BIGINT, flow->endTime);
+
+   int pos = 4;
+   TCHAR buffer[64];
+   if (flow->fields & FLOW_FIELD_EXPORTER_IP_ADDR)
+      DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, FormatIpAddress(flow->key.exporterAddr, 4, buffer), DB_BIND_TRANSIENT);
+   if (flow->fields & FLOW_FIELD_SOURCE_MAC_ADDR)
+      DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, FormatMacAddress(flow->sourceMacAddr, buffer), DB_BIND_TRANSIENT);
+   if (flow->fields & FLOW_FIELD_DEST_MAC_ADDR)
+      DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, FormatMacAddress(flow->destMacAddr, buffer), DB_BIND_TRANSIENT);
+   if (flow->fields & FLOW_FIELD_SOURCE_IP_ADDR)
+      DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, FormatIpAddress(flow->key.sourceAddr, flow->key.sourceAddrLen, buffer), DB_BIND_TRANSIENT);
+   if (flow->fields & FLOW_FIELD_DEST_IP_ADDR)
+      DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, FormatIpAddress(flow->key.destAddr, flow->key.destAddrLen, buffer), DB_BIND_TRANSIENT);
+   if (flow->fields & FLOW_FIELD_IP_PROTO)
+      DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(flow->key.protocol));
+   if (flow->fields & FLOW_FIELD_SOURCE_IP_PORT)
+      DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(flow->key.sourcePort));
+   if (flow->fields & FLOW_FIELD_DEST_IP_PORT)
+      DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(flow->key.destPort));
+   if (flow->fields & FLOW_FIELD_OCTET_COUNT)
+      DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, flow->octetCount);
+   if (flow->fields & FLOW_FIELD_PACKET_COUNT)
+      DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, flow->packetCount);
+   if (flow->fields & FLOW_FIELD_INGRESS_INTERFACE)
+      DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, flow->ingressInterface);
+   if (flow->fields & FLOW_FIELD_EGRESS_INTERFACE)
+      DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, flow->egressInterface);
+}
+
+/**
+ * Write flow records to database. Records with same set of fields are written as single batch.
+ */
+static void WriteFlowRecords(const FlowRecord * const *flows, int count, StructArray<InsertStatement> *statementCache)
 {
-	{ IPFIX_FT_EXPORTERIPV4ADDRESS, _T("exporter_ip_addr") },
-	{ IPFIX_FT_SOURCEMACADDRESS, _T("source_mac_addr") },
-	{ IPFIX_FT_DESTINATIONMACADDRESS, _T("dest_mac_addr") },
-	{ IPFIX_FT_SOURCEIPV4ADDRESS, _T("source_ip_addr") },
-	{ IPFIX_FT_DESTINATIONIPV4ADDRESS, _T("dest_ip_addr") },
-	{ IPFIX_FT_PROTOCOLIDENTIFIER, _T("ip_proto") },
-	{ IPFIX_FT_SOURCETRANSPORTPORT, _T("source_ip_port") },
-	{ IPFIX_FT_DESTINATIONTRANSPORTPORT, _T("dest_ip_port") },
-	{ IPFIX_FT_OCTETDELTACOUNT, _T("octet_count") },
-	{ IPFIX_FT_PACKETDELTACOUNT, _T("packet_count") },
-	{ IPFIX_FT_INGRESSINTERFACE, _T("ingress_interface") },
-	{ IPFIX_FT_EGRESSINTERFACE, _T("egress_interface") },
-	{ 0, NULL }
-};
+   if (count == 0)
+      return;
+
+   if (g_flags & AF_NO_DATABASE)
+   {
+      s_flowsWritten += count;
+      return;
+   }
+
+   if (!DBBegin(g_dbConnection))
+   {
+      nxlog_write(NXLOG_ERROR, _T("Cannot start database transaction, %d flow records lost"), count);
+      return;
+   }
+
+   bool success = true;
+   int start = 0;
+   while(start < count)
+   {
+      uint32_t fields = flows[start]->fields;
+      int end = start + 1;
+      while((end < count) && (flows[end]->fields == fields))
+         end++;
+
+      DB_STATEMENT hStmt = GetInsertStatement(statementCache, fields);
+      if (hStmt == NULL)
+      {
+         success = false;
+         break;
+      }
+
+      DBOpenBatch(hStmt);
+      for(int i = start; i < end; i++)
+      {
+         DBNextBatchRow(hStmt);
+         BindFlowRecord(hStmt, flows[i]);
+      }
+      if (!DBExecute(hStmt))
+      {
+         success = false;
+         break;
+      }
+      start = end;
+   }
+
+   if (success)
+      success = DBCommit(g_dbConnection);
+   else
+      DBRollback(g_dbConnection);
+
+   if (success)
+      s_flowsWritten += count;
+   else
+      nxlog_write(NXLOG_ERROR, _T("Cannot write flow records to database, %d flow records lost"), count);
+}
 
-static int H_DataRecord(ipfixs_node_t *node, ipfixt_node_t *trec, ipfix_datarecord_t *data, void *arg) 
+/**
+ * Merge flow record into aggregated record. MAC addresses and interface indexes are not part of flow key,
+ * so aggregated record keeps values from first received record - they are normally the same for all records
+ * with same key from same exporter, and changing them within aggregation window is not tracked.
+ */
+static inline void MergeFlowRecord(FlowRecord *aggregated, const FlowRecord *flow)
 {
-	StringBuffer fields, values;
-	char buffer[256];
-	INT64 flowStartTime = 0, flowEndTime = 0;
+   if (flow->startTime < aggregated->startTime)
+      aggregated->startTime = flow->startTime;
+   if (flow->endTime > aggregated->endTime)
+      aggregated->endTime = flow->endTime;
+   aggregated->octetCount += flow->octetCount;
+   aggregated->packetCount += flow->packetCount;
+   aggregated->fields |= flow->fields & (FLOW_FIELD_OCTET_COUNT | FLOW_FIELD_PACKET_COUNT);
+}
 
-	for(int i = 0; i < trec->ipfixt->nfields; i++)
-	{
-		int ftype = trec->ipfixt->fields[i].elem->ft->ftype;
-		switch(ftype)
-		{
-			case IPFIX_FT_FLOWSTARTSYSUPTIME:
-				if (node->boot_time != 0)
-					flowStartTime = node->boot_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
-				break;
-			case IPFIX_FT_FLOWENDSYSUPTIME:
-				if (node->boot_time != 0)
-					flowEndTime = node->boot_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
-				break;
-			case IPFIX_FT_FLOWSTARTSECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]) * 1000;
-				break;
-			case IPFIX_FT_FLOWENDSECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]) * 1000;
-				break;
-			case IPFIX_FT_FLOWSTARTMILLISECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]);
-				break;
-			case IPFIX_FT_FLOWENDMILLISECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]);
-				break;
-			case IPFIX_FT_FLOWSTARTMICROSECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000;
-				break;
-			case IPFIX_FT_FLOWENDMICROSECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000;
-				break;
-			case IPFIX_FT_FLOWSTARTNANOSECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000000;
-				break;
-			case IPFIX_FT_FLOWENDNANOSECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000000;
-				break;
-			case IPFIX_FT_FLOWSTARTDELTAMICROSECONDS:
-				if (node->export_time != 0)
-					flowStartTime = node->export_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
-				break;
-			case IPFIX_FT_FLOWENDDELTAMICROSECONDS:
-				if (node->export_time != 0)
-					flowEndTime = node->export_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
-				break;
-			default:
-				for(int j = 0; s_fieldMapping[j].dbField != NULL; j++)
-				{
-					if (ftype == s_fieldMapping[j].ipfixField)
-					{
-						fields += _T(",");
-						fields += s_fieldMapping[j].dbField;
-						trec->ipfixt->fields[i].elem->snprint(buffer, sizeof(buffer), data->addrs[i], data->lens[i]);
-						values.appendFormattedString(_T(",'%hs'"), buffer);
-						break;
-					}
-				}
-				break;
-		}
-	}
+/**
+ * Callback for collecting aggregated records
+ */
+static EnumerationCallbackResult CollectAggregatedFlows(const FlowKey& key, FlowRecord *flow, ObjectArray<FlowRecord> *list)
+{
+   list->add(flow);
+   return _CONTINUE;
+}
 
-	if (!fields.isEmpty() && (flowStartTime != 0) && (flowEndTime != 0))
-	{
-		StringBuffer query = _T("INSERT INTO flows (flow_id,start_time,end_time");
-		query += (const TCHAR *)fields;
-		query.appendFormattedString(_T(") VALUES (") INT64_FMT _T(",") INT64_FMT _T(",") INT64_FMT, s_flowId++, flowStartTime, flowEndTime);
-		query += (const TCHAR *)values;
-		query += _T(")");
+/**
+ * Write all aggregated flows to database
+ */
+static void FlushAggregatedFlows(HashMap<FlowKey, FlowRecord> *aggregatedFlows, StructArray<InsertStatement> *statementCache)
+{
+   ObjectArray<FlowRecord> list(aggregatedFlows->size(), 1024, Ownership::False);
+   aggregatedFlows->forEach(CollectAggregatedFlows, &list);
+   if (list.size() > 0)
+   {
+      nxlog_debug(6, _T("Writing %d aggregated flows"), list.size());
+      for(int i = 0; i < list.size(); i += g_batchSize)
+         WriteFlowRecords(list.getBuffer() + i, std::min(list.size() - i, static_cast<int>(g_batchSize)), statementCache);
+   }
+   aggregatedFlows->clear();
+}
 
-		DBQuery(g_dbConnection, query);
-	}
-	return 0;
+/**
+ * Flow writer thread. Writes decoded flows in batches and optionally aggregates flows with same key
+ * over configured time window before writing.
+ */
+static void FlowWriterThread()
+{
+   nxlog_write(NXLOG_INFO, _T("Flow writer thread started"));
+
+   StructArray<InsertStatement> statementCache;
+   HashMap<FlowKey, FlowRecord> aggregatedFlows(Ownership::True);
+   const FlowRecord **buffer = MemAllocArrayNoInit<const FlowRecord*>(g_batchSize);
+   int64_t windowStart = GetCurrentTimeMs();
+
+   while(true)
+   {
+      StructArray<FlowRecord> *batch = s_writerQueue.getOrBlock(1000);
+      if (batch == INVALID_POINTER_VALUE)
+         break;
+
+      if (batch != NULL)
+      {
+         if (g_aggregationWindow > 0)
+         {
+            for(int i = 0; i < batch->size(); i++)
+            {
+               FlowRecord *flow = batch->get(i);
+               FlowRecord *aggregated = aggregatedFlows.get(flow->key);
+               if (aggregated != NULL)
+               {
+                  MergeFlowRecord(aggregated, flow);
+               }
+               else
+               {
+                  // Limit memory used by aggregation by closing window early
+                  if (aggregatedFlows.size() >= static_cast<int>(g_maxAggregatedFlows))
+                  {
+                     nxlog_debug(5, _T("Number of aggregated flows reached limit, closing aggregation window early"));
+                     FlushAggregatedFlows(&aggregatedFlows, &statementCache);
+                     windowStart = GetCurrentTimeMs();
+                  }
+                  aggregatedFlows.set(flow->key, new FlowRecord(*flow));
+               }
+            }
+         }
+         else
+         {
+            for(int i = 0; i < batch->size(); i += g_batchSize)
+            {
+               int count = std::min(batch->size() - i, static_cast<int>(g_batchSize));
+               for(int j = 0; j < count; j++)
+                  buffer[j] = batch->get(i + j);
+               WriteFlowRecords(buffer, count, &statementCache);
+            }
+         }
+         delete batch;
+      }
+
+      if (g_aggregationWindow > 0)
+      {
+         int64_t now = GetCurrentTimeMs();
+         if (now - windowStart >= static_cast<int64_t>(g_aggregationWindow) * 1000)
+         {
+            FlushAggregatedFlows(&aggregatedFlows, &statementCache);
+            windowStart = now;
+         }
+      }
+   }
+
+   FlushAggregatedFlows(&aggregatedFlows, &statementCache);
+
+   for(int i = 0; i < statementCache.size(); i++)
+      DBFreeStatement(statementCache.get(i)->hStmt);
+   MemFree(buffer);
+
+   nxlog_write(NXLOG_INFO, _T("Flow writer thread stopped (") UINT64_FMT _T(" flows received, ") UINT64_FMT _T(" flows written, ") UINT64_FMT _T(" flows dropped)"),
+            s_flowsReceived, s_flowsWritten, s_flowsDropped);
+}
+
+/**
+ * Get collector statistics
+ */
+void GetFlowCollectorStatistics(uint64_t *received, uint64_t *written, uint64_t *dropped)
+{
+   *received = s_flowsReceived;
+   *written = s_flowsWritten;
+   *dropped = s_flowsDropped;
 }
 
 
@@ -204,6 +832,7 @@ static THREAD_RESULT THREAD_CALL CollectorThread(void *arg)
 		   nxlog_write(NXLOG_ERROR, _T("IPFIX polling error"));
 			break;
 		}
+		FlushDecodedFlows();
 	}
 
    nxlog_write(NXLOG_INFO, _T("Collector thread stopped"));
@@ -211,33 +840,70 @@ static THREAD_RESULT THREAD_CALL CollectorThread(void *arg)
 }
 
 /**
- * Start collector
+ * Register flow processing handlers in IPFIX library and start writer thread
  */
-bool StartCollector()
+bool StartFlowProcessing()
 {
 	// Initialize flow ID
-	DB_RESULT hResult = DBSelect(g_dbConnection, _T("SELECT max(flow_id) FROM flows"));
-	if (hResult != NULL)
+	if (!(g_flags & AF_NO_DATABASE))
 	{
-		s_flowId = DBGetFieldInt64(hResult, 0, 0) + 1;
-		DBFreeResult(hResult);
+	   DB_RESULT hResult = DBSelect(g_dbConnection, _T("SELECT max(flow_id) FROM flows"));
+	   if (hResult != NULL)
+	   {
+		   s_flowId = DBGetFieldInt64(hResult, 0, 0) + 1;
+		   DBFreeResult(hResult);
+	   }
 	}
 
+	if (g_batchSize < 1)
+	   g_batchSize = 1;
+	if (g_maxWriterQueueSize < 1)
+	   g_maxWriterQueueSize = 1;
+	if (g_maxAggregatedFlows < 1)
+	   g_maxAggregatedFlows = 1;
+
 	s_collectorInfo = (ipfix_col_info_t *)malloc(sizeof(ipfix_col_info_t));
 	s_collectorInfo->export_newsource = NULL;
 	s_collectorInfo->export_newmsg = H_NewMessage;
-	s_collectorInfo->export_trecord = NULL;
+	s_collectorInfo->export_trecord = H_TemplateRecord;
 	s_collectorInfo->export_drecord = H_DataRecord;
 	s_collectorInfo->export_dset = NULL;
+	s_collectorInfo->export_rawmsg = NULL;
 	s_collectorInfo->export_cleanup = NULL;
 	s_collectorInfo->data = NULL;
 
 	if (ipfix_col_register_export(s_collectorInfo) < 0)
 	{
       nxlog_write(NXLOG_ERROR, _T("IPFIX collector registration failed"));
-		goto failure;
+      free(s_collectorInfo);
+      return false;
 	}
 
+	s_writerThread = ThreadCreateEx(FlowWriterThread);
+	nxlog_debug(1, _T("Flow processing started (batch size %u, writer queue size %u, aggregation window %u seconds, max aggregated flows %u)"),
+	         g_batchSize, g_maxWriterQueueSize, g_aggregationWindow, g_maxAggregatedFlows);
+	return true;
+}
+
+/**
+ * Stop writer thread after all pending flows are written
+ */
+void StopFlowProcessing()
+{
+   FlushDecodedFlows();
+   s_writerQueue.put(INVALID_POINTER_VALUE);
+   ThreadJoin(s_writerThread);
+   s_writerThread = INVALID_THREAD_HANDLE;
+}
+
+/**
+ * Start collector
+ */
+bool StartCollector()
+{
+	if (!StartFlowProcessing())
+	   return false;
+
 	if (ipfix_col_listen(&s_numTcpSockets, &s_tcpSockets, IPFIX_PROTO_TCP, (int)g_tcpPort, AF_INET, 5) < 0)
 	{
       nxlog_write(NXLOG_ERROR, _T("Unable to start IPFIX listener for TCP protocol"));
@@ -255,7 +921,7 @@ bool StartCollector()
 
 failure:
 	CloseCollectors();
-	free(s_collectorInfo);
+	StopFlowProcessing();
 	return false;
 }
 
@@ -267,4 +933,5 @@ bool StartCollector()
 void WaitForCollectorThread()
 {
 	ThreadJoin(s_collectorThread);
+	StopFlowProcessing();
 }
@@ -34,6 +34,10 @@ DWORD g_flags = AF_LOG_SQL_ERRORS;
 TCHAR g_listenAddress[MAX_PATH] = _T("0.0.0.0");
 DWORD g_tcpPort = IPFIX_DEFAULT_PORT;
 DWORD g_udpPort = IPFIX_DEFAULT_PORT;
+DWORD g_batchSize = 1000;
+DWORD g_aggregationWindow = 0;
+DWORD g_maxAggregatedFlows = 100000;
+DWORD g_maxWriterQueueSize = 256;
 DB_DRIVER g_dbDriverHandle = NULL;
 DB_HANDLE g_dbConnection = NULL;
 #ifdef _WIN32
@@ -61,8 +65,11 @@ static TCHAR s_dbName[MAX_DB_NAME] = _T("netxms_db");
 static TCHAR s_dbSchema[MAX_DB_NAME] = _T("");
 static TCHAR s_dbLogin[MAX_DB_LOGIN] = _T("netxms");
 static TCHAR s_dbPassword[MAX_PASSWORD] = _T("");
+static TCHAR s_replayFile[MAX_PATH] = _T("");
 static NX_CFG_TEMPLATE m_cfgTemplate[] =
 {
+   { _T("AggregationWindow"), CT_LONG, 0, 0, 0, 0, &g_aggregationWindow },
+   { _T("BatchSize"), CT_LONG, 0, 0, 0, 0, &g_batchSize },
    { _T("DBDriver"), CT_STRING, 0, 0, MAX_PATH, 0, s_dbDriver },
    { _T("DBDrvParams"), CT_STRING, 0, 0, MAX_PATH, 0, s_dbDrvParams },
    { _T("DBLogin"), CT_STRING, 0, 0, MAX_DB_LOGIN, 0, s_dbLogin },
@@ -75,6 +82,8 @@ static NX_CFG_TEMPLATE m_cfgTemplate[] =
    { _T("ListenPortTCP"), CT_LONG, 0, 0, 0, 0, &g_tcpPort },
    { _T("ListenPortUDP"), CT_LONG, 0, 0, 0, 0, &g_udpPort },
    { _T("LogFile"), CT_STRING, 0, 0, MAX_PATH, 0, g_logFile },
+   { _T("MaxAggregatedFlows"), CT_LONG, 0, 0, 0, 0, &g_maxAggregatedFlows },
+   { _T("MaxWriterQueueSize"), CT_LONG, 0, 0, 0, 0, &g_maxWriterQueueSize },
    { _T("LogFailedSQLQueries"), CT_BOOLEAN_FLAG_32, 0, 0, AF_LOG_SQL_ERRORS, 0, &g_flags },
    { _T("LogFile"), CT_STRING, 0, 0, MAX_PATH, 0, g_logFile },
    { _T(""), CT_END_OF_LIST, 0, 0, 0, 0, NULL }
@@ -138,6 +147,9 @@ bool Initialize()
 		return false;
 	}
 
+	if (g_flags & AF_NO_DATABASE)
+	   return (s_replayFile[0] != 0) || StartCollector();
+
 	// Initialize database driver and connect to database
 	if (!DBInit())
 		return false;
@@ -161,7 +173,7 @@ bool Initialize()
 	}
 	nxlog_debug(1, _T("Successfully connected to database %s@%s"), s_dbName, s_dbServer);
 
-	if (!StartCollector())
+	if ((s_replayFile[0] == 0) && !StartCollector())
 		return false;
 
 	return true;
@@ -236,6 +248,8 @@ static TCHAR s_helpText[] =
    _T("   -d         : Start as daemon (service)\n")
 	_T("   -D <level> : Set debug level (0..9)\n")
    _T("   -h         : Show this help\n")
+   _T("   -N         : Do not write flows to database\n")
+   _T("   -r <file>  : Replay export packets from pcap file and report throughput\n")
 #ifdef _WIN32
    _T("   -I         : Install service\n")
    _T("   -R         : Remove service\n")
@@ -252,9 +266,9 @@ static TCHAR s_helpText[] =
 //
 
 #ifdef _WIN32
-#define VALID_OPTIONS    "c:dD:hIRsS"
+#define VALID_OPTIONS    "c:dD:hINr:RsS"
 #else
-#define VALID_OPTIONS    "c:dD:hp:"
+#define VALID_OPTIONS    "c:dD:hNp:r:"
 #endif
 
 
@@ -292,6 +306,17 @@ int main(int argc, char *argv[])
 				g_configFile[MAX_PATH - 1] = 0;
 #else
 				strlcpy(g_configFile, optarg, MAX_PATH);
+#endif
+				break;
+			case 'N':
+				g_flags |= AF_NO_DATABASE;
+				break;
+			case 'r':
+#ifdef UNICODE
+				MultiByteToWideChar(CP_ACP, MB_PRECOMPOSED, optarg, -1, s_replayFile, MAX_PATH);
+				s_replayFile[MAX_PATH - 1] = 0;
+#else
+				strlcpy(s_replayFile, optarg, MAX_PATH);
 #endif
 				break;
 #ifdef _WIN32
@@ -337,6 +362,23 @@ int main(int argc, char *argv[])
 	}
 #endif
 
+	if (s_replayFile[0] != 0)
+	{
+	   // Configuration file is optional when replaying without database
+	   if (!LoadConfig() && !(g_flags & AF_NO_DATABASE))
+	   {
+         fprintf(stderr, "Error loading configuration file\n");
+         return 2;
+	   }
+	   g_flags &= ~AF_DAEMON;
+	   if (!Initialize())
+	      return 3;
+	   int rc = ReplayCaptureFile(s_replayFile);
+	   ipfix_cleanup();
+	   nxlog_close();
+	   return rc;
+	}
+
 	switch(action)
 	{
 		case 0:  // Start server
@@ -37,6 +37,8 @@
 #define AF_DEBUG           0x00000002
 #define AF_USE_SYSLOG      0x00000004
 #define AF_LOG_SQL_ERRORS  0x00000008
+#define AF_NO_DATABASE     0x00000010
+#define AF_BLOCK_ON_QUEUE_FULL 0x00000020
 #define AF_SHUTDOWN        0x01000000
 
 
@@ -50,6 +52,11 @@ void Main();
 
 bool StartCollector();
 void WaitForCollectorThread();
+bool StartFlowProcessing();
+void StopFlowProcessing();
+void FlushDecodedFlows();
+void GetFlowCollectorStatistics(uint64_t *received, uint64_t *written, uint64_t *dropped);
+int ReplayCaptureFile(const TCHAR *fileName);
 
 #ifdef _WIN32
 void InitService();
@@ -74,6 +81,10 @@ extern DWORD g_udpPort;
 extern TCHAR g_configFile[];
 extern TCHAR g_logFile[];
 extern int g_debugLevel;
+extern DWORD g_batchSize;
+extern DWORD g_aggregationWindow;
+extern DWORD g_maxAggregatedFlows;
+extern DWORD g_maxWriterQueueSize;
 extern DB_HANDLE g_dbConnection;
 
 #endif
@@ -0,0 +1,242 @@
+/*
+** nxflowd - NetXMS Flow Collector Daemon
+** Copyright (c) 2009-2023 Raden Solutions
+*/
+
+#include "nxflowd.h"
+
+/**
+ * Link types supported in capture files
+ */
+#define LINKTYPE_NULL         0
+#define LINKTYPE_ETHERNET     1
+#define LINKTYPE_RAW          101
+#define LINKTYPE_LINUX_SLL    113
+
+/**
+ * Max captured packet size
+ */
+#define MAX_PACKET_SIZE       262144
+
+/**
+ * pcap file header
+ */
+struct PcapFileHeader
+{
+   uint32_t magic;
+   uint16_t versionMajor;
+   uint16_t versionMinor;
+   int32_t thisZone;
+   uint32_t sigFigs;
+   uint32_t snapLen;
+   uint32_t linkType;
+};
+
+/**
+ * pcap record header
+ */
+struct PcapRecordHeader
+{
+   uint32_t tsSec;
+   uint32_t tsFraction;
+   uint32_t capturedLength;
+   uint32_t originalLength;
+};
+
+/**
+ * Extract UDP payload and source address from IP packet
+ */
+static const BYTE *ExtractUdpPayload(const BYTE *packet, size_t length, SockAddrBuffer *source, socklen_t *sourceLen, size_t *payloadLength)
+{
+   if (length < 1)
+      return nullptr;
+
+   size_t offset;
+   if ((packet[0] >> 4) == 4)
+   {
+      size_t headerLength = (packet[0] & 0x0F) * 4;
+      if ((length < headerLength + 8) || (headerLength < 20) || (packet[9] != 17))
+         return nullptr;
+      if ((packet[6] & 0x1F) || packet[7])
+         return nullptr;   // fragment
+      memset(source, 0, sizeof(SockAddrBuffer));
+      struct sockaddr_in *sa = reinterpret_cast<struct sockaddr_in*>(source);
+      sa->sin_family = AF_INET;
+      memcpy(&sa->sin_addr, &packet[12], 4);
+      memcpy(&sa->sin_port, &packet[headerLength], 2);
+      *sourceLen = sizeof(struct sockaddr_in);
+      offset = headerLength;
+   }
+#ifdef WITH_IPV6
+   else if ((packet[0] >> 4) == 6)
+   {
+      if ((length < 48) || (packet[6] != 17))
+         return nullptr;   // extension headers are not supported
+      memset(source, 0, sizeof(SockAddrBuffer));
+      struct sockaddr_in6 *sa = reinterpret_cast<struct sockaddr_in6*>(source);
+      sa->sin6_family = AF_INET6;
+      memcpy(&sa->sin6_addr, &packet[8], 16);
+      memcpy(&sa->sin6_port, &packet[40], 2);
+      *sourceLen = sizeof(struct sockaddr_in6);
+      offset = 40;
+   }
+#endif
+   else
+   {
+      return nullptr;
+   }
+
+   size_t udpLength = (static_cast<size_t>(packet[offset + 4]) << 8) | packet[offset + 5];
+   if ((udpLength < 8) || (offset + udpLength > length))
+      return nullptr;
+   *payloadLength = udpLength - 8;
+   return packet + offset + 8;
+}
+
+/**
+ * Get IP packet from link layer frame
+ */
+static const BYTE *ExtractIpPacket(uint32_t linkType, const BYTE *frame, size_t length, size_t *packetLength)
+{
+   size_t offset;
+   switch(linkType)
+   {
+      case LINKTYPE_NULL:
+         offset = 4;
+         break;
+      case LINKTYPE_ETHERNET:
+         {
+            offset = 12;
+            while((offset + 2 <= length) && (((frame[offset] << 8) | frame[offset + 1]) == 0x8100))  // skip VLAN tags
+               offset += 4;
+            if (offset + 2 > length)
+               return nullptr;
+            uint16_t etherType = (frame[offset] << 8) | frame[offset + 1];
+            if ((etherType != 0x0800) && (etherType != 0x86DD))
+               return nullptr;
+            offset += 2;
+         }
+         break;
+      case LINKTYPE_RAW:
+         offset = 0;
+         break;
+      case LINKTYPE_LINUX_SLL:
+         offset = 16;
+         break;
+      default:
+         return nullptr;
+   }
+   if (offset >= length)
+      return nullptr;
+   *packetLength = length - offset;
+   return frame + offset;
+}
+
+/**
+ * Replay export packets from capture file in pcap format through flow processing
+ * pipeline and report achieved throughput. Used for collector benchmarking.
+ */
+int ReplayCaptureFile(const TCHAR *fileName)
+{
+   FILE *f = _tfopen(fileName, _T("rb"));
+   if (f == nullptr)
+   {
+      _tprintf(_T("Cannot open capture file %s (%s)\n"), fileName, _tcserror(errno));
+      return 1;
+   }
+
+   PcapFileHeader fh;
+   if (fread(&fh, sizeof(fh), 1, f) != 1)
+   {
+      _tprintf(_T("Cannot read capture file header\n"));
+      fclose(f);
+      return 1;
+   }
+
+   bool swap;
+   if ((fh.magic == 0xA1B2C3D4) || (fh.magic == 0xA1B23C4D))
+   {
+      swap = false;
+   }
+   else if ((fh.magic == 0xD4C3B2A1) || (fh.magic == 0x4D3CB2A1))
+   {
+      swap = true;
+      fh.linkType = bswap_32(fh.linkType);
+   }
+   else
+   {
+      _tprintf(_T("Unsupported capture file format\n"));
+      fclose(f);
+      return 1;
+   }
+
+   // All flows from capture file should be written, so decoding is paused while writer is busy
+   g_flags |= AF_BLOCK_ON_QUEUE_FULL;
+   if (!StartFlowProcessing())
+   {
+      fclose(f);
+      return 2;
+   }
+
+   ipfixs_node_t *sources = nullptr;
+   BYTE *frame = MemAllocArrayNoInit<BYTE>(MAX_PACKET_SIZE);
+   uint64_t packets = 0, exportPackets = 0, bytes = 0;
+
+   int64_t startTime = GetCurrentTimeMs();
+   PcapRecordHeader rh;
+   while(fread(&rh, sizeof(rh), 1, f) == 1)
+   {
+      uint32_t capturedLength = swap ? bswap_32(rh.capturedLength) : rh.capturedLength;
+      if (capturedLength > MAX_PACKET_SIZE)
+      {
+         _tprintf(_T("Invalid packet length %u in capture file\n"), capturedLength);
+         break;
+      }
+      if (fread(frame, 1, capturedLength, f) != capturedLength)
+         break;
+      packets++;
+
+      size_t packetLength, payloadLength;
+      const BYTE *packet = ExtractIpPacket(fh.linkType, frame, capturedLength, &packetLength);
+      if (packet == nullptr)
+         continue;
+
+      SockAddrBuffer addr;
+      socklen_t addrLen;
+      const BYTE *payload = ExtractUdpPayload(packet, packetLength, &addr, &addrLen, &payloadLength);
+      if (payload == nullptr)
+         continue;
+
+      ipfix_input_t input;
+      input.type = IPFIX_INPUT_IPCON;
+      input.u.ipcon.addr = reinterpret_cast<struct sockaddr*>(&addr);
+      input.u.ipcon.addrlen = addrLen;
+      if (ipfix_parse_msg(&input, &sources, payload, payloadLength) >= 0)
+      {
+         exportPackets++;
+         bytes += payloadLength;
+      }
+   }
+   FlushDecodedFlows();
+   int64_t decodeTime = GetCurrentTimeMs() - startTime;
+
+   StopFlowProcessing();
+   int64_t totalTime = GetCurrentTimeMs() - startTime;
+
+   ipfix_free_sources(&sources);
+   MemFree(frame);
+   fclose(f);
+
+   uint64_t received, written, dropped;
+   GetFlowCollectorStatistics(&received, &written, &dropped);
+   _tprintf(_T("Packets read ........... ") UINT64_FMT _T("\n"), packets);
+   _tprintf(_T("Export packets parsed .. ") UINT64_FMT _T(" (") UINT64_FMT _T(" bytes)\n"), exportPackets, bytes);
+   _tprintf(_T("Flows decoded .......... ") UINT64_FMT _T("\n"), received);
+   _tprintf(_T("Flows written .......... ") UINT64_FMT _T("\n"), written);
+   _tprintf(_T("Flows dropped .......... ") UINT64_FMT _T("\n"), dropped);
+   _tprintf(_T("Decoding time .......... ") INT64_FMT _T(" ms (%.0f flows/sec)\n"), decodeTime,
+            (decodeTime > 0) ? static_cast<double>(received) * 1000.0 / decodeTime : 0.0);
+   _tprintf(_T("Total time ............. ") INT64_FMT _T(" ms (%.0f flows/sec)\n"), totalTime,
+            (totalTime > 0) ? static_cast<double>(received) * 1000.0 / totalTime : 0.0);
+   return 0;
+}
@@ -469,6 +469,7 @@
 	public static final int CMD_READ_MAINTENANCE_JOURNAL = 0x01C4;
 	public static final int CMD_CREATE_MAINTENANCE_JOURNAL = 0x01C5;
 	public static final int CMD_EDIT_MAINTENANCE_JOURNAL = 0x01C6;
+   public static final int CMD_GET_PARAMETERS = 0x01C7;
 
 	// CMD_RS_ - Reporting Server related codes
 	public static final int CMD_RS_LIST_REPORTS = 0x1100;
@@ -1268,6 +1269,8 @@
    public static final long VID_HAS_DETAIL_FIELDS = 789;
    public static final long VID_IF_ALIAS = 790;
    public static final long VID_RESPONSIBLE_USER_TAGS = 791;
+   public static final long VID_BULK_DATA_PIPELINING = 792;
+   public static final long VID_DATA_AGGREGATION = 793;
 
 	public static final long VID_ACL_USER_BASE = 0x00001000L;
 	public static final long VID_ACL_USER_LAST = 0x00001FFFL;
@@ -61,6 +61,7 @@ public boolean isWordStart(char c)
       "DataDirectory",  //$NON-NLS-1$
       "DataReconciliationBlockSize",  //$NON-NLS-1$
       "DataReconciliationTimeout",  //$NON-NLS-1$
+      "DataUploadWindowSize",  //$NON-NLS-1$
       "DailyLogFileSuffix",  //$NON-NLS-1$
       "DebugLevel",  //$NON-NLS-1$
       "DisableIPv4",  //$NON-NLS-1$
@@ -90,6 +91,7 @@ public boolean isWordStart(char c)
 		"MasterServers", //$NON-NLS-1$
 		"MaxLogSize", //$NON-NLS-1$
 		"MaxSessions", //$NON-NLS-1$
+      "MetricThreadPoolSize", //$NON-NLS-1$
 		"PlatformSuffix", //$NON-NLS-1$
 		"RequireAuthentication", //$NON-NLS-1$
 		"RequireEncryption", //$NON-NLS-1$
@@ -497,7 +497,8 @@ TCHAR LIBNETXMS_EXPORTABLE *NXCPMessageCodeName(uint16_t code, TCHAR *buffer)
       _T("CMD_GET_EVENT_REFERENCES"),
       _T("CMD_READ_MAINTENANCE_JOURNAL"),
       _T("CMD_CREATE_MAINTENANCE_JOURNAL"),
-      _T("CMD_EDIT_MAINTENANCE_JOURNAL")
+      _T("CMD_EDIT_MAINTENANCE_JOURNAL"),
+      _T("CMD_GET_PARAMETERS")
    };
    static const TCHAR *reportingMessageNames[] =
    {
@@ -510,7 +511,7 @@ TCHAR LIBNETXMS_EXPORTABLE *NXCPMessageCodeName(uint16_t code, TCHAR *buffer)
       _T("CMD_RS_NOTIFY")
    };
 
-   if ((code >= CMD_LOGIN) && (code <= CMD_EDIT_MAINTENANCE_JOURNAL))
+   if ((code >= CMD_LOGIN) && (code <= CMD_GET_PARAMETERS))
    {
       _tcscpy(buffer, messageNames[code - CMD_LOGIN]);
    }
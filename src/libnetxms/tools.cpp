@@ -1016,6 +1016,30 @@ int64_t LIBNETXMS_EXPORTABLE GetCurrentTimeMs()
    return t;
 }
 
+/**
+ * Get current time in microseconds
+ */
+int64_t LIBNETXMS_EXPORTABLE GetCurrentTimeUs()
+{
+#ifdef _WIN32
+   FILETIME ft;
+   GetSystemTimeAsFileTime(&ft);
+
+   LARGE_INTEGER li;
+   li.LowPart  = ft.dwLowDateTime;
+   li.HighPart = ft.dwHighDateTime;
+   int64_t t = li.QuadPart;       // In 100-nanosecond intervals
+   t -= EPOCHFILETIME;    // Offset to the Epoch time
+   t /= 10;               // Convert to microseconds
+#else
+   struct timeval tv;
+   gettimeofday(&tv, nullptr);
+   int64_t t = (int64_t)tv.tv_sec * 1000000 + (int64_t)tv.tv_usec;
+#endif
+
+   return t;
+}
+
 /**
  * Format timestamp as dd.mm.yy HH:MM:SS.
  * Provided buffer should be at least 21 characters long.
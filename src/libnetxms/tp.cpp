@@ -44,13 +44,24 @@ static int s_maintThreadResponsiveness = 12;
 #define MAX_WORKER_IDLE_TIMEOUT  600000
 
 /**
- * Worker thread data
+ * Number of shards in serialization queue map
  */
-struct WorkerThreadInfo
-{
-   ThreadPool *pool;
-   THREAD handle;
-};
+#define SERIALIZATION_SHARDS     16
+
+/**
+ * Maximum number of work request blocks cached by single worker
+ */
+#define WORKER_REQUEST_CACHE_SIZE   256
+
+/**
+ * Maximum number of requests taken from another worker's queue at once
+ */
+#define MAX_STEAL_BATCH_SIZE     32
+
+/**
+ * Worker will check pool's injection queue before own queue on every Nth iteration
+ */
+#define INJECTION_QUEUE_CHECK_INTERVAL 61
 
 /**
  * Thread work request
@@ -61,6 +72,114 @@ struct WorkRequest
    void *arg;
    int64_t queueTime;
    int64_t runTime;
+   WorkRequest *next;
+};
+
+/**
+ * Double-ended queue of work requests (not thread safe)
+ */
+class WorkRequestDeque
+{
+private:
+   WorkRequest **m_elements;
+   int m_capacity;   // always power of 2
+   int m_head;
+   int m_size;
+
+   void grow()
+   {
+      WorkRequest **elements = MemAllocArrayNoInit<WorkRequest*>(m_capacity * 2);
+      for(int i = 0; i < m_size; i++)
+         elements[i] = m_elements[(m_head + i) & (m_capacity - 1)];
+      MemFree(m_elements);
+      m_elements = elements;
+      m_capacity *= 2;
+      m_head = 0;
+   }
+
+public:
+   WorkRequestDeque()
+   {
+      m_capacity = 64;
+      m_elements = MemAllocArrayNoInit<WorkRequest*>(m_capacity);
+      m_head = 0;
+      m_size = 0;
+   }
+
+   ~WorkRequestDeque()
+   {
+      MemFree(m_elements);
+   }
+
+   int size() const { return m_size; }
+
+   void pushBack(WorkRequest *rq)
+   {
+      if (m_size == m_capacity)
+         grow();
+      m_elements[(m_head + m_size) & (m_capacity - 1)] = rq;
+      m_size++;
+   }
+
+   WorkRequest *popFront()
+   {
+      if (m_size == 0)
+         return nullptr;
+      WorkRequest *rq = m_elements[m_head];
+      m_head = (m_head + 1) & (m_capacity - 1);
+      m_size--;
+      return rq;
+   }
+};
+
+/**
+ * Worker slot for work stealing mode. Slots are allocated on pool creation and reused
+ * by worker threads, so other workers can steal from any slot without additional synchronization.
+ */
+struct WorkerSlot
+{
+   Mutex lock;
+   WorkRequestDeque queue;
+   volatile int queueSize;       // Queue size readable without lock (only owning thread can increase it)
+   Condition wakeup;
+   bool inUse;                   // Protected by pool mutex
+   bool idle;                    // Protected by pool idle lock
+   uint32_t random;              // State of random generator for victim selection
+   uint32_t iteration;
+   int64_t averageWaitTime;
+   WorkRequest *requestCache;    // Cached work request blocks (only accessed by owning thread)
+   int requestCacheSize;
+
+   WorkerSlot() : lock(MutexType::FAST), wakeup(false)
+   {
+      queueSize = 0;
+      inUse = false;
+      idle = false;
+      random = 0;
+      iteration = 0;
+      averageWaitTime = 0;
+      requestCache = nullptr;
+      requestCacheSize = 0;
+   }
+
+   uint32_t nextRandom()
+   {
+      // xorshift32
+      random ^= random << 13;
+      random ^= random >> 17;
+      random ^= random << 5;
+      return random;
+   }
+};
+
+/**
+ * Worker thread data
+ */
+struct WorkerThreadInfo
+{
+   ThreadPool *pool;
+   THREAD handle;
+   WorkerSlot *slot;
 };
 
 /**
@@ -79,6 +198,20 @@ class SerializationQueue: public Queue
    void updateMaxWaitTime(uint32_t waitTime) { m_maxWaitTime = std::max(waitTime, m_maxWaitTime); }
 };
 
+/**
+ * Shard of serialization queue map
+ */
+struct SerializationShard
+{
+   Mutex lock;
+   StringObjectMap<SerializationQueue> queues;
+
+   SerializationShard() : lock(MutexType::FAST), queues(Ownership::True)
+   {
+      queues.setIgnoreCase(false);
+   }
+};
+
 /**
  * Thread pool
  */
@@ -94,8 +227,7 @@ struct ThreadPool
    Condition maintThreadWakeup;
    HashMap<uint64_t, WorkerThreadInfo> threads;
    ObjectQueue<WorkRequest> queue;
-   StringObjectMap<SerializationQueue> serializationQueues;
-   Mutex serializationLock;
+   SerializationShard serializationShards[SERIALIZATION_SHARDS];
    ObjectArray<WorkRequest> schedulerQueue;
    Mutex schedulerLock;
    TCHAR *name;
@@ -106,10 +238,17 @@ struct ThreadPool
    uint64_t threadStopCount;
    VolatileCounter64 taskExecutionCount;
    SynchronizedObjectMemoryPool<WorkRequest> workRequestMemoryPool;
-
-   ThreadPool(const TCHAR *name, int minThreads, int maxThreads, int stackSize) :
-         queue(64, Ownership::False), serializationQueues(Ownership::True), schedulerQueue(16, 16, Ownership::False),
-         mutex(MutexType::FAST), serializationLock(MutexType::FAST), schedulerLock(MutexType::FAST), maintThreadWakeup(false)
+   bool workStealing;
+   WorkerSlot *slots;                     // Worker slots (work stealing mode only)
+   WorkRequest *volatile injectionQueue;  // Requests submitted from outside of the pool (work stealing mode only)
+   VolatileCounter idleCount;
+   WorkerSlot **idleSlots;
+   int idleSlotCount;
+   Mutex idleLock;
+
+   ThreadPool(const TCHAR *name, int minThreads, int maxThreads, int stackSize, bool workStealing) :
+         queue(64, Ownership::False), schedulerQueue(16, 16, Ownership::False),
+         mutex(MutexType::FAST), schedulerLock(MutexType::FAST), maintThreadWakeup(false), idleLock(MutexType::FAST)
    {
       this->name = (name != nullptr) ? MemCopyString(name) : MemCopyString(_T("NONAME"));
       this->minThreads = std::max(minThreads, 1);
@@ -118,18 +257,35 @@ struct ThreadPool
       workerIdleTimeout = MIN_WORKER_IDLE_TIMEOUT;
       activeRequests = 0;
       maintThread = INVALID_THREAD_HANDLE;
-      serializationQueues.setIgnoreCase(false);
       shutdownMode = false;
       memset(loadAverage, 0, sizeof(loadAverage));
       averageWaitTime = 0;
       threadStartCount = 0;
       threadStopCount = 0;
       taskExecutionCount = 0;
+      this->workStealing = workStealing;
+      if (workStealing)
+      {
+         slots = new WorkerSlot[this->maxThreads];
+         for(int i = 0; i < this->maxThreads; i++)
+            slots[i].random = static_cast<uint32_t>(i + 1) * 2654435761U;
+         idleSlots = MemAllocArrayNoInit<WorkerSlot*>(this->maxThreads);
+      }
+      else
+      {
+         slots = nullptr;
+         idleSlots = nullptr;
+      }
+      injectionQueue = nullptr;
+      idleCount = 0;
+      idleSlotCount = 0;
    }
 
    ~ThreadPool()
    {
       threads.setOwner(Ownership::True);
+      delete[] slots;
+      MemFree(idleSlots);
       MemFree(name);
    }
 };
@@ -140,6 +296,285 @@ struct ThreadPool
 static StringObjectMap<ThreadPool> s_registry(Ownership::False);
 static Mutex s_registryLock;
 
+#if HAVE_THREAD_LOCAL_STORAGE
+
+/**
+ * Worker thread information for current thread (only set for work stealing pools)
+ */
+static thread_local WorkerThreadInfo *s_currentWorker = nullptr;
+
+#endif
+
+/**
+ * Get worker slot of current thread if it is a worker thread of given pool
+ */
+static inline WorkerSlot *GetCurrentWorkerSlot(ThreadPool *p)
+{
+#if HAVE_THREAD_LOCAL_STORAGE
+   WorkerThreadInfo *w = s_currentWorker;
+   return ((w != nullptr) && (w->pool == p)) ? w->slot : nullptr;
+#else
+   return nullptr;
+#endif
+}
+
+/**
+ * Create work request block. Uses worker's local cache if possible.
+ */
+static inline WorkRequest *CreateWorkRequest(ThreadPool *p, WorkerSlot *slot)
+{
+   if ((slot != nullptr) && (slot->requestCache != nullptr))
+   {
+      WorkRequest *rq = slot->requestCache;
+      slot->requestCache = rq->next;
+      slot->requestCacheSize--;
+      return rq;
+   }
+   return p->workRequestMemoryPool.allocate();
+}
+
+/**
+ * Destroy work request block. Uses worker's local cache if possible.
+ */
+static inline void DestroyWorkRequest(ThreadPool *p, WorkerSlot *slot, WorkRequest *rq)
+{
+   if ((slot != nullptr) && (slot->requestCacheSize < WORKER_REQUEST_CACHE_SIZE))
+   {
+      rq->next = slot->requestCache;
+      slot->requestCache = rq;
+      slot->requestCacheSize++;
+   }
+   else
+   {
+      p->workRequestMemoryPool.free(rq);
+   }
+}
+
+/**
+ * Read counter value with full memory barrier
+ */
+static inline int32_t ReadCounter(VolatileCounter *v)
+{
+   return InterlockedCompareExchange(v, 0, 0);
+}
+
+/**
+ * Register worker as idle. Must be called before final check for available work.
+ */
+static void AddIdleWorker(ThreadPool *p, WorkerSlot *slot)
+{
+   p->idleLock.lock();
+   p->idleSlots[p->idleSlotCount++] = slot;
+   slot->idle = true;
+   InterlockedIncrement(&p->idleCount);
+   p->idleLock.unlock();
+}
+
+/**
+ * Remove worker from idle list. Returns false if worker was already removed by waking thread.
+ */
+static bool RemoveIdleWorker(ThreadPool *p, WorkerSlot *slot)
+{
+   bool removed = false;
+   p->idleLock.lock();
+   if (slot->idle)
+   {
+      for(int i = 0; i < p->idleSlotCount; i++)
+      {
+         if (p->idleSlots[i] == slot)
+         {
+            p->idleSlotCount--;
+            memmove(&p->idleSlots[i], &p->idleSlots[i + 1], sizeof(WorkerSlot*) * (p->idleSlotCount - i));
+            break;
+         }
+      }
+      slot->idle = false;
+      InterlockedDecrement(&p->idleCount);
+      removed = true;
+   }
+   p->idleLock.unlock();
+   return removed;
+}
+
+/**
+ * Wake up most recently idled worker
+ */
+static void WakeIdleWorker(ThreadPool *p)
+{
+   p->idleLock.lock();
+   WorkerSlot *slot = (p->idleSlotCount > 0) ? p->idleSlots[--p->idleSlotCount] : nullptr;
+   if (slot != nullptr)
+   {
+      slot->idle = false;
+      InterlockedDecrement(&p->idleCount);
+   }
+   p->idleLock.unlock();
+
+   if (slot != nullptr)
+      slot->wakeup.set();
+}
+
+/**
+ * Put work request into pool's queue. If called from worker thread of work stealing pool, request
+ * is placed into worker's own queue, otherwise into lock-free injection queue.
+ */
+static void EnqueueRequest(ThreadPool *p, WorkRequest *rq, WorkerSlot *slot)
+{
+   if (!p->workStealing)
+   {
+      p->queue.put(rq);
+      return;
+   }
+
+   if (slot != nullptr)
+   {
+      slot->lock.lock();
+      slot->queue.pushBack(rq);
+      slot->queueSize = slot->queue.size();
+      slot->lock.unlock();
+   }
+   else
+   {
+      WorkRequest *head;
+      do
+      {
+         head = p->injectionQueue;
+         rq->next = head;
+      } while(InterlockedCompareExchangeObjectPointer(&p->injectionQueue, rq, head) != head);
+   }
+
+   if (ReadCounter(&p->idleCount) > 0)
+      WakeIdleWorker(p);
+}
+
+/**
+ * Take all requests from injection queue. First request is returned to the caller and the rest
+ * are placed into worker's own queue (where they are available for stealing by other workers).
+ */
+static WorkRequest *TakeInjectedRequests(ThreadPool *p, WorkerSlot *slot)
+{
+   WorkRequest *list = InterlockedExchangeObjectPointer(&p->injectionQueue, static_cast<WorkRequest*>(nullptr));
+   if (list == nullptr)
+      return nullptr;
+
+   // Injection queue is a stack, reverse it to restore submission order
+   WorkRequest *head = nullptr;
+   while(list != nullptr)
+   {
+      WorkRequest *next = list->next;
+      list->next = head;
+      head = list;
+      list = next;
+   }
+
+   if (head->next != nullptr)
+   {
+      slot->lock.lock();
+      for(WorkRequest *rq = head->next; rq != nullptr; rq = rq->next)
+         slot->queue.pushBack(rq);
+      slot->queueSize = slot->queue.size();
+      slot->lock.unlock();
+
+      if (ReadCounter(&p->idleCount) > 0)
+         WakeIdleWorker(p);
+   }
+   return head;
+}
+
+/**
+ * Steal work from randomly selected worker. First stolen request is returned to the caller and the rest
+ * are placed into worker's own queue.
+ */
+static WorkRequest *StealWork(ThreadPool *p, WorkerSlot *thief)
+{
+   WorkRequest *batch[MAX_STEAL_BATCH_SIZE];
+   int start = static_cast<int>(thief->nextRandom() % static_cast<uint32_t>(p->maxThreads));
+   for(int i = 0; i < p->maxThreads; i++)
+   {
+      WorkerSlot *victim = &p->slots[(start + i) % p->maxThreads];
+      if ((victim == thief) || (victim->queueSize == 0))
+         continue;
+
+      victim->lock.lock();
+      int count = std::min((victim->queue.size() + 1) / 2, MAX_STEAL_BATCH_SIZE);
+      for(int j = 0; j < count; j++)
+         batch[j] = victim->queue.popFront();
+      victim->queueSize = victim->queue.size();
+      victim->lock.unlock();
+
+      if (count == 0)
+         continue;
+
+      if (count > 1)
+      {
+         thief->lock.lock();
+         for(int j = 1; j < count; j++)
+            thief->queue.pushBack(batch[j]);
+         thief->queueSize = thief->queue.size();
+         thief->lock.unlock();
+      }
+      return batch[0];
+   }
+   return nullptr;
+}
+
+/**
+ * Find work for worker in work stealing pool
+ */
+static WorkRequest *FindWork(ThreadPool *p, WorkerSlot *slot)
+{
+   WorkRequest *rq = nullptr;
+
+   // Check injection queue first from time to time to avoid starvation
+   // of externally submitted requests by requests submitted by workers
+   if ((++slot->iteration % INJECTION_QUEUE_CHECK_INTERVAL == 0) && (p->injectionQueue != nullptr))
+   {
+      rq = TakeInjectedRequests(p, slot);
+      if (rq != nullptr)
+         return rq;
+   }
+
+   if (slot->queueSize > 0)
+   {
+      slot->lock.lock();
+      rq = slot->queue.popFront();
+      slot->queueSize = slot->queue.size();
+      slot->lock.unlock();
+      if (rq != nullptr)
+         return rq;
+   }
+
+   if (p->injectionQueue != nullptr)
+   {
+      rq = TakeInjectedRequests(p, slot);
+      if (rq != nullptr)
+         return rq;
+   }
+
+   return StealWork(p, slot);
+}
+
+/**
+ * Get average request wait time in milliseconds. Pool mutex must be locked by caller.
+ */
+static int64_t GetAverageWaitTime(ThreadPool *p)
+{
+   if (!p->workStealing)
+      return p->averageWaitTime / EMA_FP_1;
+
+   int64_t total = 0;
+   int count = 0;
+   for(int i = 0; i < p->maxThreads; i++)
+   {
+      if (p->slots[i].inUse)
+      {
+         total += p->slots[i].averageWaitTime;
+         count++;
+      }
+   }
+   return (count > 0) ? total / count / EMA_FP_1 : 0;
+}
+
 /**
  * Worker function to join stopped thread
  */
@@ -150,22 +585,11 @@ static void JoinWorkerThread(void *arg)
 }
 
 /**
- * Worker thread function
+ * Worker thread loop for pool with shared queue
  */
-static void WorkerThread(WorkerThreadInfo *threadInfo)
+static void SharedQueueWorkerLoop(WorkerThreadInfo *threadInfo)
 {
    ThreadPool *p = threadInfo->pool;
-
-   char threadName[16];
-   threadName[0] = '$';
-#ifdef UNICODE
-   wchar_to_ASCII(p->name, -1, &threadName[1], 11);
-#else
-   strlcpy(&threadName[1], p->name, 11);
-#endif
-   strlcat(threadName, "/WRK", 16);
-   ThreadSetName(threadName);
-
    while(true)
    {
       WorkRequest *rq = p->queue.getOrBlock(p->workerIdleTimeout);
@@ -212,10 +636,141 @@ static void WorkerThread(WorkerThreadInfo *threadInfo)
       p->workRequestMemoryPool.destroy(rq);
       InterlockedDecrement(&p->activeRequests);
    }
+}
+
+/**
+ * Worker thread loop for pool in work stealing mode
+ */
+static void WorkStealingWorkerLoop(WorkerThreadInfo *threadInfo)
+{
+   ThreadPool *p = threadInfo->pool;
+   WorkerSlot *slot = threadInfo->slot;
+#if HAVE_THREAD_LOCAL_STORAGE
+   s_currentWorker = threadInfo;
+#endif
+
+   while(true)
+   {
+      WorkRequest *rq = FindWork(p, slot);
+      if (rq == nullptr)
+      {
+         // Register as idle before final check, so request submitted concurrently
+         // will either be found by that check or will wake up this worker
+         AddIdleWorker(p, slot);
+         rq = FindWork(p, slot);
+         if (rq != nullptr)
+         {
+            RemoveIdleWorker(p, slot);
+         }
+         else if (p->shutdownMode)
+         {
+            // All queues are empty, worker can stop
+            RemoveIdleWorker(p, slot);
+            break;
+         }
+         else
+         {
+            if (slot->wakeup.wait(p->workerIdleTimeout) || !RemoveIdleWorker(p, slot) || p->shutdownMode)
+               continue;
+
+            p->mutex.lock();
+            if ((p->threads.size() <= p->minThreads) || (GetAverageWaitTime(p) > s_waitTimeLowWatermark))
+            {
+               p->mutex.unlock();
+               continue;
+            }
+            p->threads.remove(CAST_FROM_POINTER(threadInfo, uint64_t));
+            p->threadStopCount++;
+            slot->inUse = false;
+            p->mutex.unlock();
+
+            nxlog_debug_tag(DEBUG_TAG, 5, _T("Stopping worker thread in thread pool %s due to inactivity"), p->name);
+
+#if HAVE_THREAD_LOCAL_STORAGE
+            s_currentWorker = nullptr;
+#endif
+            rq = CreateWorkRequest(p, nullptr);
+            rq->func = JoinWorkerThread;
+            rq->arg = threadInfo;
+            rq->queueTime = GetCurrentTimeMs();
+            InterlockedIncrement(&p->activeRequests);
+            EnqueueRequest(p, rq, nullptr);
+            break;
+         }
+      }
+
+      UpdateExpMovingAverage(slot->averageWaitTime, EMA_EXP_180, GetCurrentTimeMs() - rq->queueTime);
+
+      rq->func(rq->arg);
+      DestroyWorkRequest(p, slot, rq);
+      InterlockedDecrement(&p->activeRequests);
+   }
+
+#if HAVE_THREAD_LOCAL_STORAGE
+   s_currentWorker = nullptr;
+#endif
+}
+
+/**
+ * Worker thread function
+ */
+static void WorkerThread(WorkerThreadInfo *threadInfo)
+{
+   ThreadPool *p = threadInfo->pool;
+
+   char threadName[16];
+   threadName[0] = '$';
+#ifdef UNICODE
+   wchar_to_ASCII(p->name, -1, &threadName[1], 11);
+#else
+   strlcpy(&threadName[1], p->name, 11);
+#endif
+   strlcat(threadName, "/WRK", 16);
+   ThreadSetName(threadName);
+
+   if (p->workStealing)
+      WorkStealingWorkerLoop(threadInfo);
+   else
+      SharedQueueWorkerLoop(threadInfo);
 
    nxlog_debug_tag(DEBUG_TAG, 8, _T("Worker thread in thread pool %s stopped"), p->name);
 }
 
+/**
+ * Start new worker thread. Pool mutex must be locked by caller.
+ */
+static WorkerThreadInfo *StartWorkerThread(ThreadPool *p)
+{
+   WorkerThreadInfo *wt = new WorkerThreadInfo;
+   wt->pool = p;
+   wt->slot = nullptr;
+   if (p->workStealing)
+   {
+      for(int i = 0; i < p->maxThreads; i++)
+      {
+         if (!p->slots[i].inUse)
+         {
+            wt->slot = &p->slots[i];
+            wt->slot->inUse = true;
+            break;
+         }
+      }
+   }
+
+   wt->handle = ThreadCreateEx(WorkerThread, wt, p->stackSize);
+   if (wt->handle == INVALID_THREAD_HANDLE)
+   {
+      if (wt->slot != nullptr)
+         wt->slot->inUse = false;
+      delete wt;
+      return nullptr;
+   }
+
+   p->threads.set(CAST_FROM_POINTER(wt, uint64_t), wt);
+   return wt;
+}
+
+
 /**
  * Thread pool maintenance thread
  */
@@ -259,25 +814,20 @@ static void MaintenanceThread(ThreadPool *p)
 
             p->mutex.lock();
             int threadCount = p->threads.size();
-            int64_t averageWaitTime = p->averageWaitTime / EMA_FP_1;
+            int64_t averageWaitTime = GetAverageWaitTime(p);
             if (((averageWaitTime > s_waitTimeHighWatermark) && (threadCount < p->maxThreads)) ||
                 ((threadCount == 0) && (p->activeRequests > 0)))
             {
                int delta = std::min(p->maxThreads - threadCount, std::max((static_cast<int>(p->activeRequests) - threadCount) / 2, 1));
                for(int i = 0; i < delta; i++)
                {
-                  WorkerThreadInfo *wt = new WorkerThreadInfo;
-                  wt->pool = p;
-                  wt->handle = ThreadCreateEx(WorkerThread, wt, p->stackSize);
-                  if (wt->handle != INVALID_THREAD_HANDLE)
+                  if (StartWorkerThread(p) != nullptr)
                   {
-                     p->threads.set(CAST_FROM_POINTER(wt, uint64_t), wt);
                      p->threadStartCount++;
                      started++;
                   }
                   else
                   {
-                     delete wt;
                      failure = true;
                      break;
                   }
@@ -328,7 +878,7 @@ static void MaintenanceThread(ThreadPool *p)
             InterlockedIncrement(&p->activeRequests);
             InterlockedIncrement64(&p->taskExecutionCount);
             rq->queueTime = now;
-            p->queue.put(rq);
+            EnqueueRequest(p, rq, nullptr);
          }
       }
       p->schedulerLock.unlock();
@@ -339,26 +889,16 @@ static void MaintenanceThread(ThreadPool *p)
 /**
  * Create thread pool
  */
-ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThreads, int maxThreads, int stackSize)
+ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThreads, int maxThreads, int stackSize, bool workStealing)
 {
-   auto p = new ThreadPool(name, minThreads, maxThreads, stackSize);
+   auto p = new ThreadPool(name, minThreads, maxThreads, stackSize, workStealing);
    p->maintThread = ThreadCreateEx(MaintenanceThread, p, 256 * 1024);
 
    p->mutex.lock();
    for(int i = 0; i < p->minThreads; i++)
    {
-      WorkerThreadInfo *wt = new WorkerThreadInfo;
-      wt->pool = p;
-      wt->handle = ThreadCreateEx(WorkerThread, wt, stackSize);
-      if (wt->handle != INVALID_THREAD_HANDLE)
-      {
-         p->threads.set(CAST_FROM_POINTER(wt, uint64_t), wt);
-      }
-      else
-      {
+      if (StartWorkerThread(p) == nullptr)
          nxlog_debug_tag(DEBUG_TAG, 1, _T("Cannot create worker thread in pool %s"), p->name);
-         delete wt;
-      }
    }
    p->mutex.unlock();
 
@@ -366,7 +906,7 @@ ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThre
    s_registry.set(p->name, p);
    s_registryLock.unlock();
 
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("Thread pool %s initialized (min=%d, max=%d)"), p->name, p->minThreads, p->maxThreads);
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Thread pool %s initialized (min=%d, max=%d%s)"), p->name, p->minThreads, p->maxThreads, p->workStealing ? _T(", work stealing") : _T(""));
    return p;
 }
 
@@ -402,13 +942,29 @@ void LIBNETXMS_EXPORTABLE ThreadPoolDestroy(ThreadPool *p)
    ThreadJoin(p->maintThread);
 
    WorkRequest rq;
-   rq.func = nullptr;
-   rq.queueTime = GetCurrentTimeMs();
-   p->mutex.lock();
-   int count = p->threads.size();
-   for(int i = 0; i < count; i++)
-      p->queue.put(&rq);
-   p->mutex.unlock();
+   if (p->workStealing)
+   {
+      // Workers will stop after all queues are drained
+      p->idleLock.lock();
+      while(p->idleSlotCount > 0)
+      {
+         WorkerSlot *slot = p->idleSlots[--p->idleSlotCount];
+         slot->idle = false;
+         InterlockedDecrement(&p->idleCount);
+         slot->wakeup.set();
+      }
+      p->idleLock.unlock();
+   }
+   else
+   {
+      rq.func = nullptr;
+      rq.queueTime = GetCurrentTimeMs();
+      p->mutex.lock();
+      int count = p->threads.size();
+      for(int i = 0; i < count; i++)
+         p->queue.put(&rq);
+      p->mutex.unlock();
+   }
 
    p->threads.forEach(ThreadPoolDestroyCallback);
 
@@ -426,11 +982,12 @@ void LIBNETXMS_EXPORTABLE ThreadPoolExecute(ThreadPool *p, ThreadPoolWorkerFunct
 
    InterlockedIncrement(&p->activeRequests);
    InterlockedIncrement64(&p->taskExecutionCount);
-   WorkRequest *rq = p->workRequestMemoryPool.create();
+   WorkerSlot *slot = GetCurrentWorkerSlot(p);
+   WorkRequest *rq = CreateWorkRequest(p, slot);
    rq->func = f;
    rq->arg = arg;
    rq->queueTime = GetCurrentTimeMs();
-   p->queue.put(rq);
+   EnqueueRequest(p, rq, slot);
 }
 
 /**
@@ -439,6 +996,7 @@ void LIBNETXMS_EXPORTABLE ThreadPoolExecute(ThreadPool *p, ThreadPoolWorkerFunct
 struct RequestSerializationData
 {
    ThreadPool *pool;
+   SerializationShard *shard;
    SerializationQueue *queue;
    TCHAR key[1];  // Actual length is determined at runtime
 };
@@ -457,24 +1015,38 @@ static void ProcessSerializedRequests(RequestSerializationData *data)
          // new serialized task may have been placed into queue between
          // get and lock calls. To avoid loosing it re-check queue again
          // with serialization lock being held.
-         data->pool->serializationLock.lock();
+         data->shard->lock.lock();
          rq = static_cast<WorkRequest*>(data->queue->get());
          if (rq == nullptr)
          {
-            data->pool->serializationQueues.remove(data->key);
-            data->pool->serializationLock.unlock();
+            data->shard->queues.remove(data->key);
+            data->shard->lock.unlock();
             break;
          }
-         data->pool->serializationLock.unlock();
+         data->shard->lock.unlock();
       }
       data->queue->updateMaxWaitTime(static_cast<uint32_t>(GetCurrentTimeMs() - rq->queueTime));
 
       rq->func(rq->arg);
-      data->pool->workRequestMemoryPool.destroy(rq);
+      DestroyWorkRequest(data->pool, GetCurrentWorkerSlot(data->pool), rq);
    }
    MemFree(data);
 }
 
+/**
+ * Get serialization map shard for given key
+ */
+static inline SerializationShard *GetSerializationShard(ThreadPool *p, const TCHAR *key)
+{
+   uint32_t hash = 2166136261U;  // FNV-1a
+   for(const TCHAR *c = key; *c != 0; c++)
+   {
+      hash ^= static_cast<uint32_t>(*c);
+      hash *= 16777619U;
+   }
+   return &p->serializationShards[hash % SERIALIZATION_SHARDS];
+}
+
 /**
  * Execute task serialized (not before previous task with same key ends)
  */
@@ -483,22 +1055,24 @@ void LIBNETXMS_EXPORTABLE ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR
    if (p->shutdownMode)
       return;
 
-   WorkRequest *rq = p->workRequestMemoryPool.create();
+   WorkRequest *rq = CreateWorkRequest(p, GetCurrentWorkerSlot(p));
    rq->func = f;
    rq->arg = arg;
    rq->queueTime = GetCurrentTimeMs();
 
-   p->serializationLock.lock();
-   SerializationQueue *q = p->serializationQueues.get(key);
+   SerializationShard *shard = GetSerializationShard(p, key);
+   shard->lock.lock();
+   SerializationQueue *q = shard->queues.get(key);
    if (q == nullptr)
    {
       q = new SerializationQueue(64);
-      p->serializationQueues.set(key, q);
+      shard->queues.set(key, q);
       q->put(rq);
 
       size_t keyLen = _tcslen(key);
       auto data = static_cast<RequestSerializationData*>(MemAlloc(keyLen * sizeof(TCHAR) + sizeof(RequestSerializationData)));
       data->pool = p;
+      data->shard = shard;
       data->queue = q;
       memcpy(data->key, key, (keyLen + 1) * sizeof(TCHAR));
       ThreadPoolExecute(p, ProcessSerializedRequests, data);
@@ -508,7 +1082,7 @@ void LIBNETXMS_EXPORTABLE ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR
       q->put(rq);
       InterlockedIncrement64(&p->taskExecutionCount);
    }
-   p->serializationLock.unlock();
+   shard->lock.unlock();
 }
 
 /**
@@ -529,7 +1103,7 @@ void LIBNETXMS_EXPORTABLE ThreadPoolScheduleAbsoluteMs(ThreadPool *p, int64_t ru
    if (p->shutdownMode)
       return;
 
-   WorkRequest *rq = p->workRequestMemoryPool.create();
+   WorkRequest *rq = CreateWorkRequest(p, GetCurrentWorkerSlot(p));
    rq->func = f;
    rq->arg = arg;
    rq->runTime = runTime;
@@ -580,7 +1154,7 @@ void LIBNETXMS_EXPORTABLE ThreadPoolGetInfo(ThreadPool *p, ThreadPoolInfo *info)
    info->loadAvg[0] = GetExpMovingAverageValue(p->loadAverage[0]);
    info->loadAvg[1] = GetExpMovingAverageValue(p->loadAverage[1]);
    info->loadAvg[2] = GetExpMovingAverageValue(p->loadAverage[2]);
-   info->averageWaitTime = static_cast<uint32_t>(p->averageWaitTime / EMA_FP_1);
+   info->averageWaitTime = static_cast<uint32_t>(GetAverageWaitTime(p));
    p->mutex.unlock();
 
    p->schedulerLock.lock();
@@ -588,11 +1162,15 @@ void LIBNETXMS_EXPORTABLE ThreadPoolGetInfo(ThreadPool *p, ThreadPoolInfo *info)
    p->schedulerLock.unlock();
 
    info->serializedRequests = 0;
-   p->serializationLock.lock();
-   auto it = p->serializationQueues.begin();
-   while(it.hasNext())
-      info->serializedRequests += static_cast<int>(it.next()->value->size());
-   p->serializationLock.unlock();
+   for(int i = 0; i < SERIALIZATION_SHARDS; i++)
+   {
+      SerializationShard *shard = &p->serializationShards[i];
+      shard->lock.lock();
+      auto it = shard->queues.begin();
+      while(it.hasNext())
+         info->serializedRequests += static_cast<int>(it.next()->value->size());
+      shard->lock.unlock();
+   }
 }
 
 /**
@@ -624,10 +1202,11 @@ StringList LIBNETXMS_EXPORTABLE *ThreadPoolGetAllPools()
  */
 int LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestCount(ThreadPool *p, const TCHAR *key)
 {
-   p->serializationLock.lock();
-   SerializationQueue *q = p->serializationQueues.get(key);
+   SerializationShard *shard = GetSerializationShard(p, key);
+   shard->lock.lock();
+   SerializationQueue *q = shard->queues.get(key);
    int count = (q != nullptr) ? static_cast<int>(q->size()) : 0;
-   p->serializationLock.unlock();
+   shard->lock.unlock();
    return count;
 }
 
@@ -636,10 +1215,11 @@ int LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestCount(ThreadPool *p, cons
  */
 uint32_t LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestMaxWaitTime(ThreadPool *p, const TCHAR *key)
 {
-   p->serializationLock.lock();
-   SerializationQueue *q = p->serializationQueues.get(key);
+   SerializationShard *shard = GetSerializationShard(p, key);
+   shard->lock.lock();
+   SerializationQueue *q = shard->queues.get(key);
    uint32_t waitTime = (q != nullptr) ? q->getMaxWaitTime() : 0;
-   p->serializationLock.unlock();
+   shard->lock.unlock();
    return waitTime;
 }
 
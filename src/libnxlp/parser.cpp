@@ -979,6 +979,30 @@ void LogParser::restoreCounters(const LogParser *parser)
    }
 }
 
+/**
+ * Add counters from another copy of same parser
+ */
+void LogParser::addCounters(const LogParser *parser)
+{
+   for(int i = 0; i < m_rules.size(); i++)
+   {
+      const LogParserRule *rule = parser->findRuleByName(m_rules.get(i)->getName());
+      if (rule != nullptr)
+      {
+         m_rules.get(i)->addCounters(rule);
+      }
+   }
+}
+
+/**
+ * Reset counters for all rules
+ */
+void LogParser::resetCounters()
+{
+   for(int i = 0; i < m_rules.size(); i++)
+      m_rules.get(i)->resetCounters();
+}
+
 /**
  * Get character size in bytes for parser's encoding
  */
@@ -402,3 +402,44 @@ void LogParserRule::restoreCounters(const LogParserRule *rule)
    m_matchCount = rule->m_matchCount;
    rule->m_objectCounters->forEach(RestoreCountersCallback, m_objectCounters);
 }
+
+/**
+ * Callback for adding object counters
+ */
+static EnumerationCallbackResult AddCountersCallback(const uint32_t& key, ObjectRuleStats *src, HashMap<uint32_t, ObjectRuleStats> *counters)
+{
+   ObjectRuleStats *dst = counters->get(key);
+   if (dst != nullptr)
+   {
+      dst->checkCount += src->checkCount;
+      dst->matchCount += src->matchCount;
+   }
+   else
+   {
+      dst = new ObjectRuleStats;
+      dst->checkCount = src->checkCount;
+      dst->matchCount = src->matchCount;
+      counters->set(key, dst);
+   }
+   return _CONTINUE;
+}
+
+/**
+ * Add counters from another copy of same rule
+ */
+void LogParserRule::addCounters(const LogParserRule *rule)
+{
+   m_checkCount += rule->m_checkCount;
+   m_matchCount += rule->m_matchCount;
+   rule->m_objectCounters->forEach(AddCountersCallback, m_objectCounters);
+}
+
+/**
+ * Reset all counters
+ */
+void LogParserRule::resetCounters()
+{
+   m_checkCount = 0;
+   m_matchCount = 0;
+   m_objectCounters->clear();
+}
@@ -73,6 +73,7 @@ NXSL_Class::NXSL_Class() : m_metadataLock(MutexType::FAST)
 {
    setName(_T("Object"));
    m_methods = new HashMap<NXSL_Identifier, NXSL_ExtMethod>(Ownership::True);
+   m_attributeHandlers = new HashMap<NXSL_Identifier, NXSL_ExtAttribute>(Ownership::True);
 
    NXSL_REGISTER_METHOD(Object, __get, 1);
    NXSL_REGISTER_METHOD(Object, __invoke, -1);
@@ -91,6 +92,7 @@ NXSL_Class::NXSL_Class() : m_metadataLock(MutexType::FAST)
 NXSL_Class::~NXSL_Class()
 {
    delete m_methods;
+   delete m_attributeHandlers;
 }
 
 /**
@@ -102,12 +104,28 @@ void NXSL_Class::setName(const TCHAR *name)
    m_classHierarchy.add(name);
 }
 
+/**
+ * Register attribute handler. Should be called only from constructor. Because constructors of derived
+ * classes run after base class constructors, each class ends up with single table containing attributes
+ * from whole class hierarchy, and attribute registered by derived class replaces one with same name
+ * registered by base class.
+ */
+void NXSL_Class::registerAttribute(const char *name, NXSL_Value *(*handler)(NXSL_Object*, NXSL_VM*))
+{
+   NXSL_ExtAttribute *a = new NXSL_ExtAttribute;
+   a->handler = handler;
+   m_attributeHandlers->set(name, a);
+}
+
 /**
  * Get attribute
- * Default implementation always returns error
+ * Default implementation calls attributes registered with NXSL_REGISTER_ATTRIBUTE macro.
  */
 NXSL_Value *NXSL_Class::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
 {
+   NXSL_ExtAttribute *a = m_attributeHandlers->get(attr);
+   if (a != nullptr)
+      return a->handler(object, object->vm());
    if (NXSL_COMPARE_ATTRIBUTE_NAME("__class"))
       return object->vm()->createValue(object->vm()->createObject(&g_nxslMetaClass, object->getClass()));
    return nullptr;
@@ -122,6 +140,19 @@ bool NXSL_Class::setAttr(NXSL_Object *object, const NXSL_Identifier& attr, NXSL_
    return false;
 }
 
+/**
+ * Callback to fill attribute list from registered attribute handlers
+ */
+static EnumerationCallbackResult FillAttributeList(const NXSL_Identifier& name, NXSL_ExtAttribute *attribute, StringSet *attributes)
+{
+#ifdef UNICODE
+   attributes->addPreallocated(WideStringFromUTF8String(name.value));
+#else
+   attributes->add(name.value);
+#endif
+   return _CONTINUE;
+}
+
 /**
  * Scan class attributes
  */
@@ -130,6 +161,8 @@ void NXSL_Class::scanAttributes()
    m_metadataLock.lock();
    if (m_attributes.isEmpty())
    {
+      m_attributeHandlers->forEach(FillAttributeList, &m_attributes);
+
       NXSL_VM vm(new NXSL_Environment());
       NXSL_Object *object = vm.createObject(&g_nxslBaseClass, nullptr);
       NXSL_Value *v = getAttr(object, "?"); // will populate m_attributes
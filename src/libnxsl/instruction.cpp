@@ -56,6 +56,7 @@ void NXSL_Instruction::copyFrom(const NXSL_Instruction *src, NXSL_ValueManager *
          break;
    }
    m_addr2 = src->m_addr2;
+   m_slot = src->m_slot;
 }
 
 /**
@@ -144,6 +145,33 @@ OperandType NXSL_Instruction::getOperandType() const
    }
 }
 
+/**
+ * Check if this instruction accesses variable by name (and so can use variable slot)
+ */
+bool NXSL_Instruction::isVariableAccess() const
+{
+   switch(m_opCode)
+   {
+      case OPCODE_ARRAY:
+      case OPCODE_BIND:
+      case OPCODE_DEC:
+      case OPCODE_DECP:
+      case OPCODE_GLOBAL:
+      case OPCODE_GLOBAL_ARRAY:
+      case OPCODE_INC:
+      case OPCODE_INCP:
+      case OPCODE_PUSH_CONSTREF:
+      case OPCODE_PUSH_EXPRVAR:
+      case OPCODE_PUSH_VARIABLE:
+      case OPCODE_SET:
+      case OPCODE_SET_EXPRVAR:
+      case OPCODE_UPDATE_EXPRVAR:
+         return true;
+      default:
+         return false;
+   }
+}
+
 /**
  * Restore variable reference
  */
@@ -200,13 +200,40 @@ struct NXSL_Instruction
       uint64_t m_valueUInt64;
    } m_operand;
    int32_t m_sourceLine;
+   uint32_t m_slot;    // Variable slot for variable access instructions
 
    OperandType getOperandType() const;
+   bool isVariableAccess() const;
    void copyFrom(const NXSL_Instruction *src, NXSL_ValueManager *vm);
    void dispose(NXSL_ValueManager *vm);
    void restoreVariableReference(NXSL_Identifier *identifier);
 };
 
+/**
+ * Variable slot map element
+ */
+struct NXSL_VariableSlot;
+
+/**
+ * Mapping between variable names and variable slots. Slots are assigned sequentially starting from 0.
+ */
+class NXSL_VariableSlotMap
+{
+private:
+   MemoryPool m_pool;
+   NXSL_VariableSlot *m_slots;
+   uint32_t m_size;
+
+public:
+   NXSL_VariableSlotMap();
+   NXSL_VariableSlotMap(const NXSL_VariableSlotMap *src);
+   ~NXSL_VariableSlotMap();
+
+   uint32_t find(const NXSL_Identifier& name) const;
+   uint32_t add(const NXSL_Identifier& name);
+   uint32_t size() const { return m_size; }
+};
+
 /**
  * NXSL program builder
  */
@@ -234,6 +261,7 @@ class NXSL_ProgramBuilder : public NXSL_ValueManager
       i->m_sourceLine = line;
       i->m_opCode = opCode;
       i->m_addr2 = INVALID_ADDRESS;
+      i->m_slot = INVALID_VARIABLE_SLOT;
       return i;
    }
 
@@ -29,6 +29,7 @@
 NXSL_Library::NXSL_Library() : m_mutex(MutexType::FAST)
 {
    m_scriptList = new ObjectArray<NXSL_LibraryScript>(16, 16, Ownership::True);
+   m_changeCounter = 0;
 }
 
 /**
@@ -45,6 +46,7 @@ NXSL_Library::~NXSL_Library()
 bool NXSL_Library::addScript(NXSL_LibraryScript *script)
 {
    m_scriptList->add(script);
+   InterlockedIncrement(&m_changeCounter);
    return true;
 }
 
@@ -57,6 +59,7 @@ void NXSL_Library::deleteScript(const TCHAR *pszName)
       if (!_tcsicmp(m_scriptList->get(i)->getName(), pszName))
       {
          m_scriptList->remove(i);
+         InterlockedIncrement(&m_changeCounter);
          break;
       }
 }
@@ -70,6 +73,7 @@ void NXSL_Library::deleteScript(uint32_t id)
       if (m_scriptList->get(i)->getId() == id)
       {
          m_scriptList->remove(i);
+         InterlockedIncrement(&m_changeCounter);
          break;
       }
 }
@@ -640,12 +640,19 @@ uint64_t NXSL_ProgramBuilder::getMemoryUsage() const
    return mem;
 }
 
+/**
+ * Last assigned program ID
+ */
+static VolatileCounter64 s_lastProgramId = 0;
+
 /**
  * Create empty compiled script
  */
 NXSL_Program::NXSL_Program(size_t valueRegionSize, size_t identifierRegionSize) : NXSL_ValueManager(valueRegionSize, identifierRegionSize),
          m_instructionSet(0, 256), m_constants(this, Ownership::True), m_functions(0, 64), m_requiredModules(0, 16)
 {
+   m_id = InterlockedIncrement64(&s_lastProgramId);
+   m_variableSlots = nullptr;
 }
 
 /**
@@ -669,9 +676,12 @@ NXSL_Program::NXSL_Program(NXSL_ProgramBuilder *builder) :
          m_requiredModules(builder->m_requiredModules.getBuffer(), builder->m_requiredModules.size()),
          m_metadata(builder->m_metadata)
 {
+   m_id = InterlockedIncrement64(&s_lastProgramId);
    for(int i = 0; i < builder->m_instructionSet.size(); i++)
       m_instructionSet.addPlaceholder()->copyFrom(builder->m_instructionSet.get(i), this);
    builder->m_constants.forEach(CopyConstantsCallback, &m_constants);
+   m_variableSlots = nullptr;
+   resolveVariableSlots();
 }
 
 /**
@@ -681,6 +691,33 @@ NXSL_Program::~NXSL_Program()
 {
    for(int i = 0; i < m_instructionSet.size(); i++)
       m_instructionSet.get(i)->dispose(this);
+   delete m_variableSlots;
+}
+
+/**
+ * Assign numeric slot to each variable name referenced by program code, so VM can
+ * access variables by index instead of name lookup.
+ */
+void NXSL_Program::resolveVariableSlots()
+{
+   delete m_variableSlots;
+   m_variableSlots = new NXSL_VariableSlotMap();
+   for(int i = 0; i < m_instructionSet.size(); i++)
+   {
+      NXSL_Instruction *instr = m_instructionSet.get(i);
+      if (instr->isVariableAccess() && (instr->getOperandType() == OP_TYPE_IDENTIFIER))
+         instr->m_slot = m_variableSlots->add(*instr->m_operand.m_identifier);
+      else
+         instr->m_slot = INVALID_VARIABLE_SLOT;
+   }
+}
+
+/**
+ * Get number of variable slots used by this program
+ */
+uint32_t NXSL_Program::getVariableSlotCount() const
+{
+   return (m_variableSlots != nullptr) ? m_variableSlots->size() : 0;
 }
 
 /**
@@ -956,6 +993,7 @@ NXSL_Program *NXSL_Program::load(ByteStream& s, TCHAR *errMsg, size_t errMsgSize
    for(int i = 0; i < constants.size(); i++)
       p->destroyValue(constants.get(i));
 
+   p->resolveVariableSlots();
    return p;
 
 failure:
@@ -73,6 +73,7 @@ NXSL_Variable::~NXSL_Variable()
 struct NXSL_VariablePtr
 {
    UT_hash_handle hh;
+   uint32_t slot;
    NXSL_Variable v;
 
    // Implicitly delete destructor because NXSL_Variable contained inside
@@ -86,6 +87,8 @@ struct NXSL_VariablePtr
 NXSL_VariableSystem::NXSL_VariableSystem(NXSL_VM *vm, NXSL_VariableSystemType type) : NXSL_RuntimeObject(vm), m_pool(4096)
 {
    m_variables = nullptr;
+   m_slots = nullptr;
+   m_slotCount = 0;
 	m_type = type;
 	m_restorePointCount = 0;
 }
@@ -96,13 +99,15 @@ NXSL_VariableSystem::NXSL_VariableSystem(NXSL_VM *vm, NXSL_VariableSystemType ty
 NXSL_VariableSystem::NXSL_VariableSystem(NXSL_VM *vm, const NXSL_VariableSystem *src) : NXSL_RuntimeObject(vm), m_pool(4096)
 {
    m_variables = nullptr;
+   m_slots = nullptr;
+   m_slotCount = 0;
    m_type = src->m_type;
    m_restorePointCount = 0;
 
    NXSL_VariablePtr *var, *tmp;
    HASH_ITER(hh, src->m_variables, var, tmp)
    {
-      create(var->v.getName(), vm->createValue(var->v.getValue()));
+      create(var->v.getName(), vm->createValue(var->v.getValue()), var->slot);
    }
 }
 
@@ -127,6 +132,8 @@ void NXSL_VariableSystem::clear()
       HASH_DEL(m_variables, var);
       var->v.~NXSL_Variable();
    }
+   if (m_slots != nullptr)
+      memset(m_slots, 0, m_slotCount * sizeof(NXSL_Variable*));
 }
 
 /**
@@ -183,14 +190,53 @@ NXSL_Variable *NXSL_VariableSystem::find(const NXSL_Identifier& name)
 /**
  * Create variable
  */
-NXSL_Variable *NXSL_VariableSystem::create(const NXSL_Identifier& name, NXSL_Value *value)
+NXSL_Variable *NXSL_VariableSystem::create(const NXSL_Identifier& name, NXSL_Value *value, uint32_t slot)
 {
    NXSL_VariablePtr *var = static_cast<NXSL_VariablePtr*>(m_pool.allocate(sizeof(NXSL_VariablePtr)));
    NXSL_Variable *v = new (&var->v) NXSL_Variable(m_vm, name, (value != nullptr) ? value : m_vm->createValue(), isConstant());
    HASH_ADD_KEYPTR(hh, m_variables, v->m_name.value, v->m_name.length, var);
+   var->slot = (slot != INVALID_VARIABLE_SLOT) ? slot : m_vm->getVariableSlot(name);
+   if (var->slot != INVALID_VARIABLE_SLOT)
+      setSlot(var->slot, v);
    return v;
 }
 
+/**
+ * Set variable for given slot, extending slot table if needed
+ */
+void NXSL_VariableSystem::setSlot(uint32_t slot, NXSL_Variable *variable)
+{
+   if (slot >= m_slotCount)
+   {
+      // Old table is left in the pool and will be released with it
+      uint32_t count = std::max(slot + 1, m_vm->getVariableSlotCount());
+      NXSL_Variable **slots = m_pool.allocateArray<NXSL_Variable*>(count);
+      if (m_slotCount > 0)
+         memcpy(slots, m_slots, m_slotCount * sizeof(NXSL_Variable*));
+      memset(&slots[m_slotCount], 0, (count - m_slotCount) * sizeof(NXSL_Variable*));
+      m_slots = slots;
+      m_slotCount = count;
+   }
+   m_slots[slot] = variable;
+}
+
+/**
+ * Re-read slot numbers for all variables from owning VM. Should be called when VM's slot map is changed.
+ */
+void NXSL_VariableSystem::reindexSlots()
+{
+   if (m_slots != nullptr)
+      memset(m_slots, 0, m_slotCount * sizeof(NXSL_Variable*));
+
+   NXSL_VariablePtr *var, *tmp;
+   HASH_ITER(hh, m_variables, var, tmp)
+   {
+      var->slot = m_vm->getVariableSlot(var->v.getName());
+      if (var->slot != INVALID_VARIABLE_SLOT)
+         setSlot(var->slot, &var->v);
+   }
+}
+
 /**
  * Remove variable
  */
@@ -201,6 +247,8 @@ void NXSL_VariableSystem::remove(const NXSL_Identifier& name)
    if (var != nullptr)
    {
       HASH_DEL(m_variables, var);
+      if ((var->slot != INVALID_VARIABLE_SLOT) && (var->slot < m_slotCount) && (m_slots[var->slot] == &var->v))
+         m_slots[var->slot] = nullptr;
       var->v.~NXSL_Variable();
    }
 }
@@ -252,3 +300,76 @@ void NXSL_VariableSystem::dump(FILE *fp) const
       _ftprintf(fp, _T("   %-16hs = \"%s\"\n"), var->v.getName().value, var->v.getValue()->getValueAsCString());
    }
 }
+
+/**
+ * Variable slot map element
+ */
+struct NXSL_VariableSlot
+{
+   UT_hash_handle hh;
+   uint32_t slot;
+   NXSL_Identifier name;
+};
+
+/**
+ * Create empty slot map
+ */
+NXSL_VariableSlotMap::NXSL_VariableSlotMap() : m_pool(4096)
+{
+   m_slots = nullptr;
+   m_size = 0;
+}
+
+/**
+ * Create copy of existing slot map (slot numbers are preserved)
+ */
+NXSL_VariableSlotMap::NXSL_VariableSlotMap(const NXSL_VariableSlotMap *src) : m_pool(4096)
+{
+   m_slots = nullptr;
+   m_size = 0;
+
+   NXSL_VariableSlot *e, *tmp;
+   HASH_ITER(hh, src->m_slots, e, tmp)
+   {
+      NXSL_VariableSlot *n = static_cast<NXSL_VariableSlot*>(m_pool.allocate(sizeof(NXSL_VariableSlot)));
+      n->slot = e->slot;
+      n->name = e->name;
+      HASH_ADD_KEYPTR(hh, m_slots, n->name.value, n->name.length, n);
+   }
+   m_size = src->m_size;
+}
+
+/**
+ * Slot map destructor
+ */
+NXSL_VariableSlotMap::~NXSL_VariableSlotMap()
+{
+   HASH_CLEAR(hh, m_slots);
+}
+
+/**
+ * Find slot for given variable name. Returns INVALID_VARIABLE_SLOT if there are no slot for given name.
+ */
+uint32_t NXSL_VariableSlotMap::find(const NXSL_Identifier& name) const
+{
+   NXSL_VariableSlot *e;
+   HASH_FIND(hh, m_slots, name.value, name.length, e);
+   return (e != nullptr) ? e->slot : INVALID_VARIABLE_SLOT;
+}
+
+/**
+ * Get slot for given variable name, assigning new one if needed
+ */
+uint32_t NXSL_VariableSlotMap::add(const NXSL_Identifier& name)
+{
+   NXSL_VariableSlot *e;
+   HASH_FIND(hh, m_slots, name.value, name.length, e);
+   if (e != nullptr)
+      return e->slot;
+
+   e = static_cast<NXSL_VariableSlot*>(m_pool.allocate(sizeof(NXSL_VariableSlot)));
+   e->slot = m_size++;
+   e->name = name;
+   HASH_ADD_KEYPTR(hh, m_slots, e->name.value, e->name.length, e);
+   return e->slot;
+}
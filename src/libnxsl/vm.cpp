@@ -188,6 +188,11 @@ NXSL_VM::NXSL_VM(NXSL_Environment *env, NXSL_Storage *storage) : NXSL_ValueManag
    m_errorText = nullptr;
    m_assertMessage = nullptr;
    m_constants = nullptr;
+   m_constantsModified = false;
+   m_loadedValues = 0;
+   m_loadedIdentifiers = 0;
+   m_loadedObjects = 0;
+   m_variableSlots = new NXSL_VariableSlotMap();
    m_globalVariables = new NXSL_VariableSystem(this, NXSL_VariableSystemType::GLOBAL);
    m_localVariables = nullptr;
    m_expressionVariables = nullptr;
@@ -235,6 +240,8 @@ NXSL_VM::~NXSL_VM()
 
    MemFree(m_errorText);
    MemFree(m_assertMessage);
+
+   delete m_variableSlots;
 }
 
 /**
@@ -265,6 +272,10 @@ bool NXSL_VM::load(const NXSL_Program *program)
    for(int i = 0; i < program->m_instructionSet.size(); i++)
       m_instructionSet.addPlaceholder()->copyFrom(program->m_instructionSet.get(i), this);
 
+   // Copy variable slot map (instructions already refer to program's slot numbers)
+   delete m_variableSlots;
+   m_variableSlots = (program->m_variableSlots != nullptr) ? new NXSL_VariableSlotMap(program->m_variableSlots) : new NXSL_VariableSlotMap();
+
    // Copy function information
    m_functions.clear();
    for(int i = 0; i < program->m_functions.size(); i++)
@@ -283,6 +294,7 @@ bool NXSL_VM::load(const NXSL_Program *program)
    {
       delete_and_null(m_constants);
    }
+   m_constantsModified = false;
 
    // Load modules
    m_modules.clear();
@@ -297,9 +309,76 @@ bool NXSL_VM::load(const NXSL_Program *program)
       }
    }
 
+   // Variables created before load (or before modules were added) may have names that got slots only now
+   if (m_constants != nullptr)
+      m_constants->reindexSlots();
+   m_globalVariables->reindexSlots();
+   if (m_localVariables != nullptr)
+      m_localVariables->reindexSlots();
+   if (m_contextVariables != nullptr)
+      m_contextVariables->reindexSlots();
+
+   // Remember value manager state right after load so reset() can check that nothing was left behind
+   m_loadedValues = m_values.getElementCount();
+   m_loadedIdentifiers = m_identifiers.getElementCount();
+   m_loadedObjects = m_objects.getElementCount();
+
    return success;
 }
 
+/**
+ * Reset VM to the state it had right after loading program, so it can be used to run same program again
+ * without copying code and constants. Global variables, context object, security context, local storage,
+ * user data and error information are discarded. Returns false if VM cannot be reset (for example, if
+ * additional constants were defined after program load, or if previous run left values or objects in
+ * value manager that are not referenced by program code - like reference cycles between arrays). In that
+ * case VM should be destroyed and new one created instead.
+ */
+bool NXSL_VM::reset()
+{
+   if (m_constantsModified)
+      return false;
+
+   m_cp = INVALID_ADDRESS;
+   m_stopFlag = false;
+   m_nBindPos = 0;
+   m_subLevel = 0;
+
+   NXSL_Value *v;
+   while((v = m_dataStack.pop()) != nullptr)
+      destroyValue(v);
+   m_dataStack.reset();
+   m_codeStack.reset();
+   NXSL_CatchPoint *p;
+   while((p = m_catchStack.pop()) != nullptr)
+      delete p;
+   m_catchStack.reset();
+
+   m_globalVariables->clear();
+   delete_and_null(m_localVariables);
+   delete_and_null(m_expressionVariables);
+   m_exportedExpressionVariables = nullptr;
+   setContextObject(nullptr);
+   delete_and_null(m_securityContext);
+
+   destroyValue(m_pRetValue);
+   m_pRetValue = nullptr;
+
+   delete m_localStorage;
+   m_localStorage = new NXSL_LocalStorage(this);
+   m_storage = m_localStorage;
+
+   m_userData = nullptr;
+   m_errorCode = 0;
+   m_errorLine = 0;
+   MemFreeAndNull(m_errorText);
+   MemFreeAndNull(m_assertMessage);
+
+   // Value manager cannot be cleared selectively, so VM with leaked values is not reusable
+   return (m_values.getElementCount() <= m_loadedValues) && (m_identifiers.getElementCount() <= m_loadedIdentifiers) &&
+          (m_objects.getElementCount() <= m_loadedObjects);
+}
+
 /**
  * Run program
  * Returns true on success and false on error
@@ -516,6 +595,7 @@ bool NXSL_VM::addConstant(const NXSL_Identifier& name, NXSL_Value *value)
    if (m_constants == nullptr)
       m_constants = new NXSL_VariableSystem(this, NXSL_VariableSystemType::CONSTANT);
    m_constants->create(name, value);
+   m_constantsModified = true;
    return true;
 }
 
@@ -534,9 +614,9 @@ void NXSL_VM::setGlobalVariable(const NXSL_Identifier& name, NXSL_Value *value)
 /**
  * Find variable
  */
-NXSL_Variable *NXSL_VM::findVariable(const NXSL_Identifier& name, NXSL_VariableSystem **vs)
+NXSL_Variable *NXSL_VM::findVariable(const NXSL_Identifier& name, NXSL_VariableSystem **vs, uint32_t slot)
 {
-   NXSL_Variable *var = (m_constants != nullptr) ? m_constants->find(name) : nullptr;
+   NXSL_Variable *var = (m_constants != nullptr) ? m_constants->find(name, slot) : nullptr;
    if (var != nullptr)
    {
       if (vs != nullptr)
@@ -544,7 +624,7 @@ NXSL_Variable *NXSL_VM::findVariable(const NXSL_Identifier& name, NXSL_VariableS
       return var;
    }
 
-   var = m_globalVariables->find(name);
+   var = m_globalVariables->find(name, slot);
    if (var != nullptr)
    {
       if (vs != nullptr)
@@ -558,18 +638,18 @@ NXSL_Variable *NXSL_VM::findVariable(const NXSL_Identifier& name, NXSL_VariableS
       NXSL_Value *value = object->getClass()->getAttr(object, name);
       if (value != nullptr)
       {
-         var = m_contextVariables->find(name);
+         var = m_contextVariables->find(name, slot);
          if (var != nullptr)
             var->setValue(value);
          else
-            var = m_contextVariables->create(name, value);
+            var = m_contextVariables->create(name, value, slot);
          if (vs != nullptr)
             *vs = m_contextVariables;
          return var;
       }
    }
 
-   var = m_localVariables->find(name);
+   var = m_localVariables->find(name, slot);
    if (var != nullptr)
    {
       if (vs != nullptr)
@@ -579,7 +659,7 @@ NXSL_Variable *NXSL_VM::findVariable(const NXSL_Identifier& name, NXSL_VariableS
 
    if (m_expressionVariables != nullptr)
    {
-      var = m_expressionVariables->find(name);
+      var = m_expressionVariables->find(name, slot);
       if (var != nullptr)
       {
          if (vs != nullptr)
@@ -594,12 +674,12 @@ NXSL_Variable *NXSL_VM::findVariable(const NXSL_Identifier& name, NXSL_VariableS
 /**
  * Find variable or create if does not exist
  */
-NXSL_Variable *NXSL_VM::findOrCreateVariable(const NXSL_Identifier& name, NXSL_VariableSystem **vs)
+NXSL_Variable *NXSL_VM::findOrCreateVariable(const NXSL_Identifier& name, NXSL_VariableSystem **vs, uint32_t slot)
 {
-   NXSL_Variable *var = findVariable(name, vs);
+   NXSL_Variable *var = findVariable(name, vs, slot);
    if (var == nullptr)
    {
-      var = m_localVariables->create(name);
+      var = m_localVariables->create(name, nullptr, slot);
       if (vs != nullptr)
          *vs = m_localVariables;
    }
@@ -609,18 +689,35 @@ NXSL_Variable *NXSL_VM::findOrCreateVariable(const NXSL_Identifier& name, NXSL_V
 /**
  * Create variable if it does not exist, otherwise return nullptr
  */
-NXSL_Variable *NXSL_VM::createVariable(const NXSL_Identifier& name)
+NXSL_Variable *NXSL_VM::createVariable(const NXSL_Identifier& name, uint32_t slot)
 {
    NXSL_Variable *var = nullptr;
    if (!isDefinedConstant(name) &&
-       (m_globalVariables->find(name) == nullptr) &&
-       (m_localVariables->find(name) == nullptr))
+       (m_globalVariables->find(name, slot) == nullptr) &&
+       (m_localVariables->find(name, slot) == nullptr))
    {
-      var = m_localVariables->create(name);
+      var = m_localVariables->create(name, nullptr, slot);
    }
    return var;
 }
 
+/**
+ * Get slot number for given variable name. Returns INVALID_VARIABLE_SLOT if variable with given name
+ * is not referenced by loaded code.
+ */
+uint32_t NXSL_VM::getVariableSlot(const NXSL_Identifier& name) const
+{
+   return m_variableSlots->find(name);
+}
+
+/**
+ * Get number of variable slots used by loaded code
+ */
+uint32_t NXSL_VM::getVariableSlotCount() const
+{
+   return m_variableSlots->size();
+}
+
 /**
  * Check if given name points to defined constant (either by environment or in constant list)
  */
@@ -687,7 +784,7 @@ void NXSL_VM::execute()
          }
          else
          {
-            pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs);
+            pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs, cp->m_slot);
             m_dataStack.push(createValueRef(pVar->getValue()));
             // convert to direct variable access without name lookup
             if (vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
@@ -704,7 +801,7 @@ void NXSL_VM::execute()
          if (m_expressionVariables == nullptr)
             m_expressionVariables = new NXSL_VariableSystem(this, NXSL_VariableSystemType::EXPRESSION);
 
-         pVar = m_expressionVariables->find(*cp->m_operand.m_identifier);
+         pVar = m_expressionVariables->find(*cp->m_operand.m_identifier, cp->m_slot);
          if (pVar != nullptr)
          {
             m_dataStack.push(createValueRef(pVar->getValue()));
@@ -744,7 +841,7 @@ void NXSL_VM::execute()
          if (m_expressionVariables == nullptr)
             m_expressionVariables = new NXSL_VariableSystem(this, NXSL_VariableSystemType::EXPRESSION);
 
-         pVar = m_expressionVariables->find(*cp->m_operand.m_identifier);
+         pVar = m_expressionVariables->find(*cp->m_operand.m_identifier, cp->m_slot);
          if (pVar != nullptr)
          {
             dwNext++;   // Skip next instruction
@@ -775,7 +872,7 @@ void NXSL_VM::execute()
          }
          else if (m_constants != nullptr)
          {
-            pVar = m_constants->find(*cp->m_operand.m_identifier);
+            pVar = m_constants->find(*cp->m_operand.m_identifier, cp->m_slot);
             if (pVar != nullptr)
             {
                m_dataStack.push(createValue(pVar->getValue()));
@@ -820,7 +917,7 @@ void NXSL_VM::execute()
          m_dataStack.push(createValue(new NXSL_HashMap(this)));
          break;
       case OPCODE_SET:
-         pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs);
+         pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs, cp->m_slot);
 			if (!pVar->isConstant())
 			{
 	         pValue = (cp->m_stackItems == 0) ? m_dataStack.peek() : m_dataStack.pop();
@@ -862,14 +959,14 @@ void NXSL_VM::execute()
             if (m_expressionVariables == nullptr)
                m_expressionVariables = new NXSL_VariableSystem(this, NXSL_VariableSystemType::EXPRESSION);
 
-            pVar = m_expressionVariables->find(*cp->m_operand.m_identifier);
+            pVar = m_expressionVariables->find(*cp->m_operand.m_identifier, cp->m_slot);
             if (pVar != nullptr)
             {
                pVar->setValue((cp->m_stackItems == 0) ? createValueRef(pValue) : pValue);
             }
             else
             {
-               m_expressionVariables->create(*cp->m_operand.m_identifier, (cp->m_stackItems == 0) ? createValueRef(pValue) : pValue);
+               m_expressionVariables->create(*cp->m_operand.m_identifier, (cp->m_stackItems == 0) ? createValueRef(pValue) : pValue, cp->m_slot);
             }
          }
          else
@@ -879,7 +976,7 @@ void NXSL_VM::execute()
          break;
 		case OPCODE_ARRAY:
 			// Check if variable already exist
-			pVar = findVariable(*cp->m_operand.m_identifier);
+			pVar = findVariable(*cp->m_operand.m_identifier, nullptr, cp->m_slot);
 			if (pVar != nullptr)
 			{
 				// only raise error if variable with given name already exist
@@ -891,7 +988,7 @@ void NXSL_VM::execute()
 			}
 			else
 			{
-				pVar = createVariable(*cp->m_operand.m_identifier);
+				pVar = createVariable(*cp->m_operand.m_identifier, cp->m_slot);
 				if (pVar != nullptr)
 				{
 					pVar->setValue(createValue(new NXSL_Array(this)));
@@ -904,17 +1001,17 @@ void NXSL_VM::execute()
 			break;
 		case OPCODE_GLOBAL_ARRAY:
 			// Check if variable already exist
-			pVar = m_globalVariables->find(*cp->m_operand.m_identifier);
+			pVar = m_globalVariables->find(*cp->m_operand.m_identifier, cp->m_slot);
 			if (pVar == nullptr)
 			{
 				// raise error if variable with given name already exist and is not global
-				if (findVariable(*cp->m_operand.m_identifier) != nullptr)
+				if (findVariable(*cp->m_operand.m_identifier, nullptr, cp->m_slot) != nullptr)
 				{
 					error(NXSL_ERR_VARIABLE_ALREADY_EXIST);
 				}
 				else
 				{
-					m_globalVariables->create(*cp->m_operand.m_identifier, createValue(new NXSL_Array(this)));
+					m_globalVariables->create(*cp->m_operand.m_identifier, createValue(new NXSL_Array(this)), cp->m_slot);
 				}
 			}
 			else
@@ -927,11 +1024,11 @@ void NXSL_VM::execute()
 			break;
 		case OPCODE_GLOBAL:
 			// Check if variable already exist
-			pVar = m_globalVariables->find(*cp->m_operand.m_identifier);
+			pVar = m_globalVariables->find(*cp->m_operand.m_identifier, cp->m_slot);
 			if (pVar == nullptr)
 			{
 				// raise error if variable with given name already exist and is not global
-				if (findVariable(*cp->m_operand.m_identifier) != nullptr)
+				if (findVariable(*cp->m_operand.m_identifier, nullptr, cp->m_slot) != nullptr)
 				{
 					error(NXSL_ERR_VARIABLE_ALREADY_EXIST);
 				}
@@ -942,7 +1039,7 @@ void NXSL_VM::execute()
 						pValue = m_dataStack.pop();
 						if (pValue != nullptr)
 						{
-							m_globalVariables->create(*cp->m_operand.m_identifier, pValue);
+							m_globalVariables->create(*cp->m_operand.m_identifier, pValue, cp->m_slot);
 						}
 						else
 						{
@@ -951,7 +1048,7 @@ void NXSL_VM::execute()
 					}
 					else
 					{
-						m_globalVariables->create(*cp->m_operand.m_identifier, createValue());
+						m_globalVariables->create(*cp->m_operand.m_identifier, createValue(), cp->m_slot);
 					}
 				}
 			}
@@ -1454,9 +1551,9 @@ void NXSL_VM::execute()
          PositionToVarName(m_nBindPos++, varName);
          pVar = m_localVariables->find(varName);
          pValue = (pVar != nullptr) ? createValueRef(pVar->getValue()) : createValue();
-         pVar = m_localVariables->find(*cp->m_operand.m_identifier);
+         pVar = m_localVariables->find(*cp->m_operand.m_identifier, cp->m_slot);
          if (pVar == nullptr)
-            m_localVariables->create(*cp->m_operand.m_identifier, pValue);
+            m_localVariables->create(*cp->m_operand.m_identifier, pValue, cp->m_slot);
          else
             pVar->setValue(pValue);
          break;
@@ -1533,7 +1630,7 @@ void NXSL_VM::execute()
          break;
       case OPCODE_INC:  // Post increment/decrement
       case OPCODE_DEC:
-         pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs);
+         pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs, cp->m_slot);
          if (!pVar->isConstant())
          {
             pValue = pVar->getValue();
@@ -1583,7 +1680,7 @@ void NXSL_VM::execute()
          break;
       case OPCODE_INCP: // Pre increment/decrement
       case OPCODE_DECP:
-         pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs);
+         pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs, cp->m_slot);
          if (!pVar->isConstant())
          {
             pValue = pVar->getValue();
@@ -2557,7 +2654,13 @@ void NXSL_VM::loadModule(NXSL_Program *module, const NXSL_ModuleImport *importIn
    // Add code from module
    int start = m_instructionSet.size();
    for(int i = 0; i < module->m_instructionSet.size(); i++)
-      m_instructionSet.addPlaceholder()->copyFrom(module->m_instructionSet.get(i), this);
+   {
+      NXSL_Instruction *instr = m_instructionSet.addPlaceholder();
+      instr->copyFrom(module->m_instructionSet.get(i), this);
+      // Module slot numbers are local to module, map them into this VM's slot space
+      if (instr->m_slot != INVALID_VARIABLE_SLOT)
+         instr->m_slot = m_variableSlots->add(*instr->m_operand.m_identifier);
+   }
    relocateCode(start, module->m_instructionSet.size(), start);
 
    // Add function names from module
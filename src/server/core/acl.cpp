@@ -170,3 +170,144 @@ void AccessList::deleteAll()
    m_allocated = 0;
    MemFreeAndNull(m_elements);
 }
+
+/**
+ * Number of stripes in effective access rights cache
+ */
+#define ACCESS_RIGHTS_CACHE_STRIPES       64
+
+/**
+ * Number of entries in one stripe of effective access rights cache
+ */
+#define ACCESS_RIGHTS_CACHE_STRIPE_SIZE   4096
+
+/**
+ * Effective access rights cache entry
+ */
+struct AccessRightsCacheEntry
+{
+   uint32_t userId;
+   uint32_t objectId;
+   uint32_t rights;
+   uint32_t version;
+};
+
+/**
+ * Effective access rights cache stripe. Cache is direct-mapped - colliding entries simply replace each other.
+ */
+struct AccessRightsCacheStripe
+{
+   Mutex lock;
+   uint64_t hits;
+   uint64_t misses;
+   AccessRightsCacheEntry entries[ACCESS_RIGHTS_CACHE_STRIPE_SIZE];
+
+   AccessRightsCacheStripe() : lock(MutexType::FAST)
+   {
+      hits = 0;
+      misses = 0;
+      memset(entries, 0, sizeof(entries));
+   }
+};
+
+/**
+ * Effective access rights cache. Entries are invalidated all at once by incrementing cache version.
+ */
+static AccessRightsCacheStripe s_accessRightsCache[ACCESS_RIGHTS_CACHE_STRIPES];
+static VolatileCounter s_accessRightsCacheVersion = 1;
+static VolatileCounter64 s_accessRightsCacheInvalidations = 0;
+
+/**
+ * Calculate hash for access rights cache key
+ */
+static inline uint32_t HashAccessRightsCacheKey(uint32_t userId, uint32_t objectId)
+{
+   uint32_t h = (userId * 0x9E3779B1) ^ (objectId * 0x85EBCA6B);
+   h ^= h >> 15;
+   h *= 0x2C1B3C6D;
+   h ^= h >> 13;
+   return h;
+}
+
+/**
+ * Get effective access rights from cache. Returns false if there is no valid cache entry for given user and object.
+ * In both cases current cache version is returned in "version" - it should be passed to UpdateAccessRightsCache
+ * together with calculated rights.
+ */
+bool GetCachedAccessRights(uint32_t userId, uint32_t objectId, uint32_t *rights, uint32_t *version)
+{
+   uint32_t currentVersion = static_cast<uint32_t>(s_accessRightsCacheVersion);
+   uint32_t h = HashAccessRightsCacheKey(userId, objectId);
+   AccessRightsCacheStripe *stripe = &s_accessRightsCache[h % ACCESS_RIGHTS_CACHE_STRIPES];
+   AccessRightsCacheEntry *e = &stripe->entries[(h / ACCESS_RIGHTS_CACHE_STRIPES) % ACCESS_RIGHTS_CACHE_STRIPE_SIZE];
+
+   stripe->lock.lock();
+   bool found = (e->version == currentVersion) && (e->userId == userId) && (e->objectId == objectId);
+   if (found)
+   {
+      *rights = e->rights;
+      stripe->hits++;
+   }
+   else
+   {
+      stripe->misses++;
+   }
+   stripe->lock.unlock();
+
+   *version = currentVersion;
+   return found;
+}
+
+/**
+ * Store effective access rights calculated at given cache version
+ */
+void UpdateAccessRightsCache(uint32_t userId, uint32_t objectId, uint32_t rights, uint32_t version)
+{
+   uint32_t h = HashAccessRightsCacheKey(userId, objectId);
+   AccessRightsCacheStripe *stripe = &s_accessRightsCache[h % ACCESS_RIGHTS_CACHE_STRIPES];
+   AccessRightsCacheEntry *e = &stripe->entries[(h / ACCESS_RIGHTS_CACHE_STRIPES) % ACCESS_RIGHTS_CACHE_STRIPE_SIZE];
+
+   stripe->lock.lock();
+   e->userId = userId;
+   e->objectId = objectId;
+   e->rights = rights;
+   e->version = version;
+   stripe->lock.unlock();
+}
+
+/**
+ * Invalidate all entries in effective access rights cache. Should be called on any change
+ * in object ACL, object relations, or group membership.
+ */
+void NXCORE_EXPORTABLE InvalidateAccessRightsCache()
+{
+   InterlockedIncrement(&s_accessRightsCacheVersion);
+   InterlockedIncrement64(&s_accessRightsCacheInvalidations);
+}
+
+/**
+ * Get current version of effective access rights cache. Version is changed on every cache invalidation,
+ * so it can be used by other caches depending on object access rights.
+ */
+uint32_t GetAccessRightsCacheVersion()
+{
+   return static_cast<uint32_t>(s_accessRightsCacheVersion);
+}
+
+/**
+ * Get effective access rights cache statistics
+ */
+void GetAccessRightsCacheStatistics(AccessRightsCacheStatistics *stats)
+{
+   stats->hits = 0;
+   stats->misses = 0;
+   for(int i = 0; i < ACCESS_RIGHTS_CACHE_STRIPES; i++)
+   {
+      AccessRightsCacheStripe *stripe = &s_accessRightsCache[i];
+      stripe->lock.lock();
+      stats->hits += stripe->hits;
+      stats->misses += stripe->misses;
+      stripe->lock.unlock();
+   }
+   stats->invalidations = static_cast<uint64_t>(s_accessRightsCacheInvalidations);
+}
@@ -799,7 +799,8 @@ UINT32 AgentConnectionEx::processCollectedData(NXCPMessage *msg)
 }
 
 /**
- * Process collected data information in bulk mode (for DCI with agent-side cache)
+ * Process collected data information in bulk mode (for DCI with agent-side cache). Agent re-sends
+ * blocks not acknowledged within timeout, so same value can be received (and stored) more than once.
  */
 UINT32 AgentConnectionEx::processBulkCollectedData(NXCPMessage *request, NXCPMessage *response)
 {
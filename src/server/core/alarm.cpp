@@ -21,9 +21,15 @@
 **/
 
 #include "nxcore.h"
+#include <netxms-regex.h>
 
 #define DEBUG_TAG _T("alarm")
 
+/**
+ * Number of alarms processed by bulk operation before alarm list lock is released
+ */
+#define ALARM_BULK_OPERATION_CHUNK_SIZE   64
+
 /**
  * Column list for loading alarms from database
  */
@@ -44,85 +50,10 @@ AlarmComment::AlarmComment(uint32_t id, time_t changeTime, uint32_t userId, TCHA
    m_text = text;
 }
 
-/**
- * Alarm list
- */
-class AlarmList
-{
-private:
-   Mutex m_lock;
-   ObjectArray<Alarm> m_list;
-   StringObjectMap<Alarm> m_keyIndex;
-
-public:
-   AlarmList() : m_list(256, 256, Ownership::True), m_keyIndex(Ownership::False) { }
-   ~AlarmList() { }
-
-   void lock() { m_lock.lock(); }
-   void unlock() { m_lock.unlock(); }
-
-   int size() { return m_list.size(); }
-
-   uint64_t memoryUsage()
-   {
-      uint64_t memUsage = sizeof(AlarmList);
-      lock();
-      for(int i = 0; i < m_list.size(); i++)
-         memUsage += m_list.get(i)->getMemoryUsage();
-      unlock();
-      return memUsage;
-   }
-
-   Alarm *get(int index) { return m_list.get(index); }
-
-   Alarm *find(const TCHAR *key) { return m_keyIndex.get(key); }
-   Alarm *find(uint32_t id)
-   {
-      for(int i = 0; i < m_list.size(); i++)
-         if (m_list.get(i)->getAlarmId() == id)
-            return m_list.get(i);
-      return nullptr;
-   }
-
-   void add(Alarm *alarm)
-   {
-      m_list.add(alarm);
-      if (*alarm->getKey() != 0)
-         m_keyIndex.set(alarm->getKey(), alarm);
-   }
-
-   void remove(int index)
-   {
-      Alarm *alarm = m_list.get(index);
-      if (alarm->getParentAlarmId() != 0)
-      {
-         Alarm *parent = find(alarm->getParentAlarmId());
-         if (parent != nullptr)
-            parent->removeSubordinateAlarm(alarm->getAlarmId());
-      }
-      if (*alarm->getKey() != 0)
-         m_keyIndex.remove(alarm->getKey());
-      m_list.remove(index);
-   }
-
-   void remove(Alarm *alarm)
-   {
-      if (alarm->getParentAlarmId() != 0)
-      {
-         Alarm *parent = find(alarm->getParentAlarmId());
-         if (parent != nullptr)
-            parent->removeSubordinateAlarm(alarm->getAlarmId());
-      }
-      if (*alarm->getKey() != 0)
-         m_keyIndex.remove(alarm->getKey());
-      m_list.remove(alarm);
-   }
-};
-
 /**
  * Global instance of alarm manager
  */
-static AlarmList s_alarmList;
+static AlarmList<Alarm> s_alarmList;
 static Condition s_shutdown(true);
 static THREAD s_watchdogThread = INVALID_THREAD_HANDLE;
 static THREAD s_rootCauseUpdateThread = INVALID_THREAD_HANDLE;
@@ -923,7 +854,10 @@ uint32_t NXCORE_EXPORTABLE CreateNewAlarm(const uuid& ruleGuid, const TCHAR *rul
             if (parent != nullptr)
                parent->addSubordinateAlarm(alarm->getAlarmId());
          }
+         uint32_t oldObjectId = alarm->getSourceObject();
+         uint32_t oldDciId = alarm->getDciId();
          alarm->updateFromEvent(event, parentAlarmId, rcaScriptName, ruleGuid, ruleDescription, ALARM_STATE_OUTSTANDING, severity, timeout, timeoutEvent, ackTimeout, message, impact, alarmCategoryList);
+         s_alarmList.updateIndexes(alarm, oldObjectId, oldDciId);
          if (!alarm->isEventRelated(event->getId()))
          {
             alarmId = alarm->getAlarmId();      // needed for correct update of related events
@@ -1056,15 +990,11 @@ uint32_t NXCORE_EXPORTABLE AckAlarmById(uint32_t alarmId, ClientSession *session
    uint32_t objectId, rcc = RCC_INVALID_ALARM_ID;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         rcc = alarm->acknowledge(session, sticky, acknowledgmentActionTime, includeSubordinates);
-         objectId = alarm->getSourceObject();
-         break;
-      }
+      rcc = alarm->acknowledge(session, sticky, acknowledgmentActionTime, includeSubordinates);
+      objectId = alarm->getSourceObject();
    }
    s_alarmList.unlock();
 
@@ -1081,15 +1011,11 @@ uint32_t NXCORE_EXPORTABLE AckAlarmByHDRef(const TCHAR *hdref, ClientSession *se
    uint32_t objectId, rcc = RCC_INVALID_ALARM_ID;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   Alarm *alarm = s_alarmList.findFirst([hdref] (Alarm *a) -> bool { return !_tcscmp(a->getHelpDeskRef(), hdref); });
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (!_tcscmp(alarm->getHelpDeskRef(), hdref))
-      {
-         rcc = alarm->acknowledge(session, sticky, acknowledgmentActionTime, false);
-         objectId = alarm->getSourceObject();
-         break;
-      }
+      rcc = alarm->acknowledge(session, sticky, acknowledgmentActionTime, false);
+      objectId = alarm->getSourceObject();
    }
    s_alarmList.unlock();
 
@@ -1171,67 +1097,64 @@ void NXCORE_EXPORTABLE ResolveAlarmsById(IntegerArray<UINT32> *alarmIds, Integer
          IntegerArray<UINT32> *failCodes, ClientSession *session, bool terminate, bool includeSubordinates)
 {
    IntegerArray<uint32_t> processedAlarms, updatedObjects;
+   bool ignoreHelpdeskState = ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false);
 
+   // Alarm list is unlocked periodically so large bulk requests do not block event processing
    s_alarmList.lock();
    time_t changeTime = time(nullptr);
    for(int i = 0; i < alarmIds->size(); i++)
    {
-      int n;
-      for(n = 0; n < s_alarmList.size(); n++)
+      if ((i > 0) && (i % ALARM_BULK_OPERATION_CHUNK_SIZE == 0))
       {
-         Alarm *alarm = s_alarmList.get(n);
-         if (alarm->getAlarmId() == alarmIds->get(i))
-         {
-            // If alarm is open in helpdesk, it cannot be terminated
-            if ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false))
-            {
-               if (terminate || (alarm->getState() != ALARM_STATE_RESOLVED))
-               {
-                  shared_ptr<NetObj> object = GetAlarmSourceObject(alarmIds->get(i), true);
-                  if (session != nullptr)
-                  {
-                     // If user does not have the required object access rights, the alarm cannot be terminated
-                     if (!object->checkAccessRights(session->getUserId(), terminate ? OBJECT_ACCESS_TERM_ALARMS : OBJECT_ACCESS_UPDATE_ALARMS))
-                     {
-                        failIds->add(alarmIds->get(i));
-                        failCodes->add(RCC_ACCESS_DENIED);
-                        break;
-                     }
-
-                     WriteAuditLog(AUDIT_OBJECTS, TRUE, session->getUserId(), session->getWorkstation(), session->getId(), object->getId(),
-                        _T("%s alarm %d (%s) on object %s"), terminate ? _T("Terminated") : _T("Resolved"),
-                        alarm->getAlarmId(), alarm->getMessage(), object->getName());
-                  }
-
-                  alarm->resolve((session != nullptr) ? session->getUserId() : 0, nullptr, terminate, false, includeSubordinates);
-                  processedAlarms.add(alarm->getAlarmId());
-                  if (!updatedObjects.contains(object->getId()))
-                     updatedObjects.add(object->getId());
-                  if (terminate)
-                  {
-                     s_alarmList.remove(n);
-                     n--;
-                  }
-               }
-               else
-               {
-                  // Alarm is already resolved, just mark it as processed
-                  processedAlarms.add(alarm->getAlarmId());
-               }
-            }
-            else
-            {
-               failIds->add(alarmIds->get(i));
-               failCodes->add(RCC_ALARM_OPEN_IN_HELPDESK);
-            }
-            break;
-         }
+         s_alarmList.unlock();
+         s_alarmList.lock();
       }
-      if (n == s_alarmList.size())
+
+      Alarm *alarm = s_alarmList.find(alarmIds->get(i));
+      if (alarm == nullptr)
       {
          failIds->add(alarmIds->get(i));
          failCodes->add(RCC_INVALID_ALARM_ID);
+         continue;
+      }
+
+      // If alarm is open in helpdesk, it cannot be terminated
+      if ((alarm->getHelpDeskState() == ALARM_HELPDESK_OPEN) && !ignoreHelpdeskState)
+      {
+         failIds->add(alarmIds->get(i));
+         failCodes->add(RCC_ALARM_OPEN_IN_HELPDESK);
+         continue;
+      }
+
+      if (!terminate && (alarm->getState() == ALARM_STATE_RESOLVED))
+      {
+         // Alarm is already resolved, just mark it as processed
+         processedAlarms.add(alarm->getAlarmId());
+         continue;
+      }
+
+      shared_ptr<NetObj> object = GetAlarmSourceObject(alarmIds->get(i), true);
+      if (session != nullptr)
+      {
+         // If user does not have the required object access rights, the alarm cannot be terminated
+         if (!object->checkAccessRights(session->getUserId(), terminate ? OBJECT_ACCESS_TERM_ALARMS : OBJECT_ACCESS_UPDATE_ALARMS))
+         {
+            failIds->add(alarmIds->get(i));
+            failCodes->add(RCC_ACCESS_DENIED);
+            continue;
+         }
+
+         WriteAuditLog(AUDIT_OBJECTS, TRUE, session->getUserId(), session->getWorkstation(), session->getId(), object->getId(),
+            _T("%s alarm %d (%s) on object %s"), terminate ? _T("Terminated") : _T("Resolved"),
+            alarm->getAlarmId(), alarm->getMessage(), object->getName());
       }
+
+      alarm->resolve((session != nullptr) ? session->getUserId() : 0, nullptr, terminate, false, includeSubordinates);
+      processedAlarms.add(alarm->getAlarmId());
+      if (!updatedObjects.contains(object->getId()))
+         updatedObjects.add(object->getId());
+      if (terminate)
+         s_alarmList.remove(alarm);
    }
    s_alarmList.unlock();
 
@@ -1252,15 +1175,44 @@ void NXCORE_EXPORTABLE ResolveAlarmsById(IntegerArray<UINT32> *alarmIds, Integer
  */
 void NXCORE_EXPORTABLE ResolveAlarmByKey(const TCHAR *pszKey, bool useRegexp, bool terminate, Event *event)
 {
+   bool ignoreHelpdeskState = ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false);
    if (useRegexp)
    {
-      IntegerArray<uint32_t> objectList;
-      s_alarmList.lock();
+      const char *eptr;
+      int eoffset;
+      PCRE *preg = _pcre_compile_t(reinterpret_cast<const PCRE_TCHAR*>(pszKey), PCRE_COMMON_FLAGS, &eptr, &eoffset, nullptr);
+      if (preg == nullptr)
+      {
+         nxlog_debug_tag(DEBUG_TAG, 4, _T("ResolveAlarmByKey: invalid regular expression \"%s\""), pszKey);
+         return;
+      }
+
+      // Match keys under shared lock and only lock list exclusively for matching alarms
+      IntegerArray<uint32_t> alarmList;
+      int ovector[30];
+      s_alarmList.readLock();
       for(int i = 0; i < s_alarmList.size(); i++)
       {
          Alarm *alarm = s_alarmList.get(i);
-         if (RegexpMatch(alarm->getKey(), pszKey, true) &&
-             ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false)) &&
+         if (_pcre_exec_t(preg, nullptr, reinterpret_cast<const PCRE_TCHAR*>(alarm->getKey()), static_cast<int>(_tcslen(alarm->getKey())), 0, 0, ovector, 30) >= 0)
+            alarmList.add(alarm->getAlarmId());
+      }
+      s_alarmList.unlock();
+      _pcre_free_t(preg);
+
+      IntegerArray<uint32_t> objectList;
+      s_alarmList.lock();
+      for(int i = 0; i < alarmList.size(); i++)
+      {
+         if ((i > 0) && (i % ALARM_BULK_OPERATION_CHUNK_SIZE == 0))
+         {
+            s_alarmList.unlock();
+            s_alarmList.lock();
+         }
+
+         Alarm *alarm = s_alarmList.find(alarmList.get(i));
+         if ((alarm != nullptr) &&
+             ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ignoreHelpdeskState) &&
              (terminate || (alarm->getState() != ALARM_STATE_RESOLVED)))
          {
             // Add alarm's source object to update list
@@ -1270,10 +1222,7 @@ void NXCORE_EXPORTABLE ResolveAlarmByKey(const TCHAR *pszKey, bool useRegexp, bo
             // Resolve or terminate alarm
             alarm->resolve(0, event, terminate, true, false);
             if (terminate)
-            {
-               s_alarmList.remove(i);
-               i--;
-            }
+               s_alarmList.remove(alarm);
          }
       }
       s_alarmList.unlock();
@@ -1288,7 +1237,7 @@ void NXCORE_EXPORTABLE ResolveAlarmByKey(const TCHAR *pszKey, bool useRegexp, bo
       s_alarmList.lock();
       Alarm *alarm = s_alarmList.find(pszKey);
       if ((alarm != nullptr) &&
-          ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false)) &&
+          ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ignoreHelpdeskState) &&
           (terminate || (alarm->getState() != ALARM_STATE_RESOLVED)))
       {
          // Add alarm's source object to update list
@@ -1314,13 +1263,15 @@ void NXCORE_EXPORTABLE ResolveAlarmByKey(const TCHAR *pszKey, bool useRegexp, bo
 void NXCORE_EXPORTABLE ResolveAlarmByDCObjectId(uint32_t dciId, bool terminate)
 {
    IntegerArray<uint32_t> objectList;
+   bool ignoreHelpdeskState = ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false);
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   ObjectArray<Alarm> alarms(16, 16, Ownership::False);
+   s_alarmList.getDCIAlarms(dciId, &alarms);
+   for(int i = 0; i < alarms.size(); i++)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if ((alarm->getDciId() == dciId) &&
-          ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false)) &&
+      Alarm *alarm = alarms.get(i);
+      if (((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ignoreHelpdeskState) &&
           (terminate || (alarm->getState() != ALARM_STATE_RESOLVED)))
       {
          // Add alarm's source object to update list
@@ -1330,10 +1281,7 @@ void NXCORE_EXPORTABLE ResolveAlarmByDCObjectId(uint32_t dciId, bool terminate)
          // Resolve or terminate alarm
          alarm->resolve(0, nullptr, terminate, true, false);
          if (terminate)
-         {
-            s_alarmList.remove(i);
-            i--;
-         }
+            s_alarmList.remove(alarm);
       }
    }
    s_alarmList.unlock();
@@ -1353,35 +1301,31 @@ uint32_t NXCORE_EXPORTABLE ResolveAlarmByHDRef(const TCHAR *hdref, ClientSession
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   Alarm *alarm = s_alarmList.findFirst([hdref] (Alarm *a) -> bool { return !_tcscmp(a->getHelpDeskRef(), hdref); });
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (!_tcscmp(alarm->getHelpDeskRef(), hdref))
+      if (terminate || (alarm->getState() != ALARM_STATE_RESOLVED))
       {
-         if (terminate || (alarm->getState() != ALARM_STATE_RESOLVED))
+         objectId = alarm->getSourceObject();
+         if (session != nullptr)
          {
-            objectId = alarm->getSourceObject();
-            if (session != nullptr)
-            {
-               WriteAuditLog(AUDIT_OBJECTS, TRUE, session->getUserId(), session->getWorkstation(), session->getId(), objectId,
-                  _T("%s alarm %d (%s) on object %s"), terminate ? _T("Terminated") : _T("Resolved"),
-                  alarm->getAlarmId(), alarm->getMessage(), GetObjectName(objectId, _T("")));
-            }
-
-            alarm->resolve((session != nullptr) ? session->getUserId() : 0, nullptr, terminate, true, false);
-            if (terminate)
-            {
-               s_alarmList.remove(i);
-            }
-            nxlog_debug_tag(DEBUG_TAG, 5, _T("Alarm with helpdesk reference \"%s\" %s"), hdref, terminate ? _T("terminated") : _T("resolved"));
+            WriteAuditLog(AUDIT_OBJECTS, TRUE, session->getUserId(), session->getWorkstation(), session->getId(), objectId,
+               _T("%s alarm %d (%s) on object %s"), terminate ? _T("Terminated") : _T("Resolved"),
+               alarm->getAlarmId(), alarm->getMessage(), GetObjectName(objectId, _T("")));
          }
-         else
+
+         alarm->resolve((session != nullptr) ? session->getUserId() : 0, nullptr, terminate, true, false);
+         if (terminate)
          {
-            nxlog_debug_tag(DEBUG_TAG, 5, _T("Alarm with helpdesk reference \"%s\" already resolved"), hdref);
+            s_alarmList.remove(alarm);
          }
-         rcc = RCC_SUCCESS;
-         break;
+         nxlog_debug_tag(DEBUG_TAG, 5, _T("Alarm with helpdesk reference \"%s\" %s"), hdref, terminate ? _T("terminated") : _T("resolved"));
+      }
+      else
+      {
+         nxlog_debug_tag(DEBUG_TAG, 5, _T("Alarm with helpdesk reference \"%s\" already resolved"), hdref);
       }
+      rcc = RCC_SUCCESS;
    }
    s_alarmList.unlock();
 
@@ -1447,17 +1391,13 @@ uint32_t OpenHelpdeskIssue(uint32_t alarmId, ClientSession *session, TCHAR *hdre
    *hdref = 0;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         if (alarm->checkCategoryAccess(session))
-            rcc = alarm->openHelpdeskIssue(hdref);
-         else
-            rcc = RCC_ACCESS_DENIED;
-         break;
-      }
+      if (alarm->checkCategoryAccess(session))
+         rcc = alarm->openHelpdeskIssue(hdref);
+      else
+         rcc = RCC_ACCESS_DENIED;
    }
    s_alarmList.unlock();
    return rcc;
@@ -1470,27 +1410,24 @@ uint32_t GetHelpdeskIssueUrlFromAlarm(uint32_t alarmId, uint32_t userId, TCHAR *
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.readLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      if (s_alarmList.get(i)->getAlarmId() == alarmId)
+      if (alarm->checkCategoryAccess(session))
       {
-         if (s_alarmList.get(i)->checkCategoryAccess(session))
+         if ((alarm->getHelpDeskState() != ALARM_HELPDESK_IGNORED) && (alarm->getHelpDeskRef()[0] != 0))
          {
-            if ((s_alarmList.get(i)->getHelpDeskState() != ALARM_HELPDESK_IGNORED) && (s_alarmList.get(i)->getHelpDeskRef()[0] != 0))
-            {
-               rcc = GetHelpdeskIssueUrl(s_alarmList.get(i)->getHelpDeskRef(), url, size);
-            }
-            else
-            {
-               rcc = RCC_OUT_OF_STATE_REQUEST;
-            }
+            rcc = GetHelpdeskIssueUrl(alarm->getHelpDeskRef(), url, size);
          }
          else
          {
-            rcc = RCC_ACCESS_DENIED;
+            rcc = RCC_OUT_OF_STATE_REQUEST;
          }
-         break;
+      }
+      else
+      {
+         rcc = RCC_ACCESS_DENIED;
       }
    }
    s_alarmList.unlock();
@@ -1505,24 +1442,20 @@ uint32_t UnlinkHelpdeskIssueById(uint32_t alarmId, ClientSession *session)
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
+      if (session != nullptr)
       {
-         if (session != nullptr)
-         {
-            WriteAuditLog(AUDIT_OBJECTS, TRUE, session->getUserId(), session->getWorkstation(), session->getId(),
-               alarm->getSourceObject(), _T("Helpdesk issue %s unlinked from alarm %d (%s) on object %s"),
-               alarm->getHelpDeskRef(), alarm->getAlarmId(), alarm->getMessage(),
-               GetObjectName(alarm->getSourceObject(), _T("")));
-         }
-         alarm->unlinkFromHelpdesk();
-			NotifyClients(NX_NOTIFY_ALARM_CHANGED, alarm);
-			alarm->updateInDatabase();
-         rcc = RCC_SUCCESS;
-         break;
+         WriteAuditLog(AUDIT_OBJECTS, TRUE, session->getUserId(), session->getWorkstation(), session->getId(),
+            alarm->getSourceObject(), _T("Helpdesk issue %s unlinked from alarm %d (%s) on object %s"),
+            alarm->getHelpDeskRef(), alarm->getAlarmId(), alarm->getMessage(),
+            GetObjectName(alarm->getSourceObject(), _T("")));
       }
+      alarm->unlinkFromHelpdesk();
+      NotifyClients(NX_NOTIFY_ALARM_CHANGED, alarm);
+      alarm->updateInDatabase();
+      rcc = RCC_SUCCESS;
    }
    s_alarmList.unlock();
 
@@ -1537,24 +1470,20 @@ uint32_t UnlinkHelpdeskIssueByHDRef(const TCHAR *hdref, ClientSession *session)
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   Alarm *alarm = s_alarmList.findFirst([hdref] (Alarm *a) -> bool { return !_tcscmp(a->getHelpDeskRef(), hdref); });
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (!_tcscmp(alarm->getHelpDeskRef(), hdref))
+      if (session != nullptr)
       {
-         if (session != nullptr)
-         {
-            WriteAuditLog(AUDIT_OBJECTS, TRUE, session->getUserId(), session->getWorkstation(), session->getId(),
-               alarm->getSourceObject(), _T("Helpdesk issue %s unlinked from alarm %d (%s) on object %s"),
-               alarm->getHelpDeskRef(), alarm->getAlarmId(), alarm->getMessage(),
-               GetObjectName(alarm->getSourceObject(), _T("")));
-         }
-         alarm->unlinkFromHelpdesk();
-			NotifyClients(NX_NOTIFY_ALARM_CHANGED, alarm);
-			alarm->updateInDatabase();
-         rcc = RCC_SUCCESS;
-         break;
+         WriteAuditLog(AUDIT_OBJECTS, TRUE, session->getUserId(), session->getWorkstation(), session->getId(),
+            alarm->getSourceObject(), _T("Helpdesk issue %s unlinked from alarm %d (%s) on object %s"),
+            alarm->getHelpDeskRef(), alarm->getAlarmId(), alarm->getMessage(),
+            GetObjectName(alarm->getSourceObject(), _T("")));
       }
+      alarm->unlinkFromHelpdesk();
+      NotifyClients(NX_NOTIFY_ALARM_CHANGED, alarm);
+      alarm->updateInDatabase();
+      rcc = RCC_SUCCESS;
    }
    s_alarmList.unlock();
 
@@ -1572,17 +1501,13 @@ void NXCORE_EXPORTABLE DeleteAlarm(uint32_t alarmId, bool objectCleanup)
    // Delete alarm from in-memory list
    if (!objectCleanup)  // otherwise already locked
       s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         objectId = alarm->getSourceObject();
-         NotifyClients(NX_NOTIFY_ALARM_DELETED, alarm);
-         s_alarmList.remove(i);
-         found = true;
-         break;
-      }
+      objectId = alarm->getSourceObject();
+      NotifyClients(NX_NOTIFY_ALARM_DELETED, alarm);
+      s_alarmList.remove(alarm);
+      found = true;
    }
    if (!objectCleanup)
       s_alarmList.unlock();
@@ -1613,15 +1538,10 @@ bool DeleteObjectAlarms(uint32_t objectId, DB_HANDLE hdb)
 {
 	s_alarmList.lock();
 
-	// go through from end because s_alarmList.size() is decremented by DeleteAlarm()
-	for(int i = s_alarmList.size() - 1; i >= 0; i--)
-   {
-      Alarm *alarm = s_alarmList.get(i);
-		if (alarm->getSourceObject() == objectId)
-      {
-			DeleteAlarm(alarm->getAlarmId(), true);
-      }
-	}
+   ObjectArray<Alarm> alarms(16, 16, Ownership::False);
+   s_alarmList.getObjectAlarms(objectId, &alarms);
+   for(int i = 0; i < alarms.size(); i++)
+      DeleteAlarm(alarms.get(i)->getAlarmId(), true);
 
 	s_alarmList.unlock();
 
@@ -1700,22 +1620,18 @@ uint32_t NXCORE_EXPORTABLE GetAlarm(uint32_t alarmId, uint32_t userId, NXCPMessa
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.readLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
+      if (alarm->checkCategoryAccess(session))
       {
-         if (alarm->checkCategoryAccess(session))
-         {
-            alarm->fillMessage(msg);
-            rcc = RCC_SUCCESS;
-         }
-         else
-         {
-            rcc = RCC_ACCESS_DENIED;
-         }
-         break;
+         alarm->fillMessage(msg);
+         rcc = RCC_SUCCESS;
+      }
+      else
+      {
+         rcc = RCC_ACCESS_DENIED;
       }
    }
    s_alarmList.unlock();
@@ -1731,23 +1647,19 @@ uint32_t NXCORE_EXPORTABLE GetAlarmEvents(uint32_t alarmId, uint32_t userId, NXC
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.readLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      if (s_alarmList.get(i)->getAlarmId() == alarmId)
+      if (alarm->checkCategoryAccess(session))
       {
-         if (s_alarmList.get(i)->checkCategoryAccess(session))
-         {
-            rcc = RCC_SUCCESS;
-         }
-         else
-         {
-            rcc = RCC_ACCESS_DENIED;
-         }
-         break;
+         rcc = RCC_SUCCESS;
+      }
+      else
+      {
+         rcc = RCC_ACCESS_DENIED;
       }
    }
-
    s_alarmList.unlock();
 
 	// we don't call FillAlarmEventsMessage from within loop
@@ -1766,16 +1678,10 @@ shared_ptr<NetObj> NXCORE_EXPORTABLE GetAlarmSourceObject(uint32_t alarmId, bool
    uint32_t objectId = 0;
 
    if (!alreadyLocked)
-      s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
-   {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         objectId = alarm->getSourceObject();
-         break;
-      }
-   }
+      s_alarmList.readLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
+      objectId = alarm->getSourceObject();
 
    if (!alreadyLocked)
       s_alarmList.unlock();
@@ -1789,16 +1695,10 @@ shared_ptr<NetObj> NXCORE_EXPORTABLE GetAlarmSourceObject(const TCHAR *hdref)
 {
    UINT32 objectId = 0;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
-   {
-      Alarm *alarm = s_alarmList.get(i);
-      if (!_tcscmp(alarm->getHelpDeskRef(), hdref))
-      {
-         objectId = alarm->getSourceObject();
-         break;
-      }
-   }
+   s_alarmList.readLock();
+   Alarm *alarm = s_alarmList.findFirst([hdref] (Alarm *a) -> bool { return !_tcscmp(a->getHelpDeskRef(), hdref); });
+   if (alarm != nullptr)
+      objectId = alarm->getSourceObject();
    s_alarmList.unlock();
    return (objectId != 0) ? FindObjectById(objectId) : shared_ptr<NetObj>();
 }
@@ -1809,19 +1709,8 @@ shared_ptr<NetObj> NXCORE_EXPORTABLE GetAlarmSourceObject(const TCHAR *hdref)
  */
 int GetMostCriticalStatusForObject(uint32_t objectId)
 {
-   int status = STATUS_UNKNOWN;
-
-   s_alarmList.lock();
-   for(int i = 0; (i < s_alarmList.size()) && (status != STATUS_CRITICAL); i++)
-   {
-      Alarm *alarm = s_alarmList.get(i);
-      if ((alarm->getSourceObject() == objectId) &&
-			 ((alarm->getState() & ALARM_STATE_MASK) < ALARM_STATE_RESOLVED) &&
-          ((alarm->getCurrentSeverity() > status) || (status == STATUS_UNKNOWN)))
-      {
-         status = (int)alarm->getCurrentSeverity();
-      }
-   }
+   s_alarmList.readLock();
+   int status = s_alarmList.getMostCriticalStatus(objectId);
    s_alarmList.unlock();
    return status;
 }
@@ -1833,7 +1722,7 @@ void GetAlarmStats(NXCPMessage *pMsg)
 {
    UINT32 dwCount[5];
 
-   s_alarmList.lock();
+   s_alarmList.readLock();
    pMsg->setField(VID_NUM_ALARMS, s_alarmList.size());
    memset(dwCount, 0, sizeof(UINT32) * 5);
    for(int i = 0; i < s_alarmList.size(); i++)
@@ -1847,7 +1736,7 @@ void GetAlarmStats(NXCPMessage *pMsg)
  */
 int GetAlarmCount()
 {
-   s_alarmList.lock();
+   s_alarmList.readLock();
    int count = s_alarmList.size();
    s_alarmList.unlock();
    return count;
@@ -2054,15 +1943,9 @@ uint32_t UpdateAlarmComment(uint32_t alarmId, uint32_t *noteId, const TCHAR *tex
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
-   {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         rcc = alarm->updateAlarmComment(noteId, text, userId, syncWithHelpdesk);
-         break;
-      }
-   }
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
+      rcc = alarm->updateAlarmComment(noteId, text, userId, syncWithHelpdesk);
    s_alarmList.unlock();
 
    return rcc;
@@ -2110,15 +1993,9 @@ uint32_t DeleteAlarmCommentByID(uint32_t alarmId, uint32_t noteId)
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
    s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
-   {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         rcc = alarm->deleteComment(noteId);
-         break;
-      }
-   }
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
+      rcc = alarm->deleteComment(noteId);
    s_alarmList.unlock();
 
    return rcc;
@@ -2220,15 +2097,27 @@ uint32_t GetAlarmComments(uint32_t alarmId, NXCPMessage *msg)
  */
 ObjectArray<Alarm> NXCORE_EXPORTABLE *GetAlarms(uint32_t objectId, bool recursive)
 {
-   s_alarmList.lock();
-   ObjectArray<Alarm> *result = new ObjectArray<Alarm>(s_alarmList.size(), 16, Ownership::True);
-   for(int i = 0; i < s_alarmList.size(); i++)
+   ObjectArray<Alarm> *result;
+   s_alarmList.readLock();
+   if ((objectId != 0) && !recursive)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if ((objectId == 0) || (alarm->getSourceObject() == objectId) ||
-          (recursive && IsParentObject(objectId, alarm->getSourceObject())))
+      ObjectArray<Alarm> alarms(16, 16, Ownership::False);
+      s_alarmList.getObjectAlarms(objectId, &alarms);
+      result = new ObjectArray<Alarm>(alarms.size(), 16, Ownership::True);
+      for(int i = 0; i < alarms.size(); i++)
+         result->add(new Alarm(alarms.get(i), true));
+   }
+   else
+   {
+      result = new ObjectArray<Alarm>(s_alarmList.size(), 16, Ownership::True);
+      for(int i = 0; i < s_alarmList.size(); i++)
       {
-         result->add(new Alarm(alarm, true));
+         Alarm *alarm = s_alarmList.get(i);
+         if ((objectId == 0) || (alarm->getSourceObject() == objectId) ||
+             (recursive && IsParentObject(objectId, alarm->getSourceObject())))
+         {
+            result->add(new Alarm(alarm, true));
+         }
       }
    }
    s_alarmList.unlock();
@@ -2259,7 +2148,7 @@ int F_FindAlarmByKey(int argc, NXSL_Value **argv, NXSL_Value **result, NXSL_VM *
 
    const TCHAR *key = argv[0]->getValueAsCString();
 
-   s_alarmList.lock();
+   s_alarmList.readLock();
    Alarm *alarm = s_alarmList.find(key);
    if (alarm != nullptr)
       alarm = new Alarm(alarm, false);
@@ -2280,17 +2169,23 @@ int F_FindAlarmByKeyRegex(int argc, NXSL_Value **argv, NXSL_Value **result, NXSL
    const TCHAR *key = argv[0]->getValueAsCString();
    Alarm *alarm = nullptr;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   const char *eptr;
+   int eoffset;
+   PCRE *preg = _pcre_compile_t(reinterpret_cast<const PCRE_TCHAR*>(key), PCRE_COMMON_FLAGS, &eptr, &eoffset, nullptr);
+   if (preg != nullptr)
    {
-      Alarm *a = s_alarmList.get(i);
-      if (RegexpMatch(a->getKey(), key, TRUE))
-      {
+      int ovector[30];
+      s_alarmList.readLock();
+      Alarm *a = s_alarmList.findFirst(
+         [preg, &ovector] (Alarm *curr) -> bool
+         {
+            return _pcre_exec_t(preg, nullptr, reinterpret_cast<const PCRE_TCHAR*>(curr->getKey()), static_cast<int>(_tcslen(curr->getKey())), 0, 0, ovector, 30) >= 0;
+         });
+      if (a != nullptr)
          alarm = new Alarm(a, false);
-         break;
-      }
+      s_alarmList.unlock();
+      _pcre_free_t(preg);
    }
-   s_alarmList.unlock();
 
    *result = (alarm != nullptr) ? vm->createValue(vm->createObject(&g_nxslAlarmClass, alarm)) : vm->createValue();
    return 0;
@@ -2304,7 +2199,7 @@ Alarm NXCORE_EXPORTABLE *FindAlarmById(UINT32 alarmId)
    if (alarmId == 0)
       return nullptr;
 
-   s_alarmList.lock();
+   s_alarmList.readLock();
    Alarm *alarm = s_alarmList.find(alarmId);
    if (alarm != nullptr)
       alarm = new Alarm(alarm, false);
@@ -2368,7 +2263,7 @@ static THREAD_RESULT THREAD_CALL RootCauseUpdateThread(void *arg)
       s_rootCauseUpdateNeeded = false;
 
       ObjectArray<Alarm> updateList(0, 32, Ownership::True);
-      s_alarmList.lock();
+      s_alarmList.readLock();
       for(int i = 0; i < s_alarmList.size(); i++)
       {
          Alarm *a = s_alarmList.get(i);
@@ -309,6 +309,8 @@ void Chassis::linkObjects()
  */
 void Chassis::onDataCollectionChange()
 {
+   scheduleItemsForPolling(false);
+
    shared_ptr<Node> controller = static_pointer_cast<Node>(FindObjectById(m_controllerId, OBJECT_NODE));
    if (controller == nullptr)
    {
@@ -580,6 +580,7 @@ void Cluster::statusPoll(PollerInfo *poller, ClientSession *pSession, UINT32 dwR
 	{
       BYTE *resourceFound = reinterpret_cast<BYTE*>(MemAllocLocal(m_dwNumResources));
       memset(resourceFound, 0, m_dwNumResources);
+      IntegerArray<uint32_t> affectedNodes;  // Nodes gaining or losing resources
 
       poller->setStatus(_T("resource poll"));
 	   sendPollerMsg(_T("Polling resources\r\n"));
@@ -624,6 +625,9 @@ void Cluster::statusPoll(PollerInfo *poller, ClientSession *pSession, UINT32 dwR
 												 (pObject != NULL) ? pObject->getName() : _T("<unknown>"),
 												 node->getId(), node->getName());
 								}
+								if (m_pResourceList[k].dwCurrOwner != 0)
+								   affectedNodes.add(m_pResourceList[k].dwCurrOwner);
+								affectedNodes.add(node->getId());
 								m_pResourceList[k].dwCurrOwner = node->getId();
 								modified |= MODIFY_CLUSTER_RESOURCES;
 							}
@@ -653,12 +657,22 @@ void Cluster::statusPoll(PollerInfo *poller, ClientSession *pSession, UINT32 dwR
 							 m_pResourceList[i].dwId, m_pResourceList[i].szName,
 							 m_pResourceList[i].dwCurrOwner,
 							 (pObject != nullptr) ? pObject->getName() : _T("<unknown>"));
+				affectedNodes.add(m_pResourceList[i].dwCurrOwner);
 				m_pResourceList[i].dwCurrOwner = 0;
             modified |= MODIFY_CLUSTER_RESOURCES;
 			}
 		}
 		unlockProperties();
 		MemFreeLocal(resourceFound);
+
+		// DCIs bound to cluster resources are rechecked with long interval when resource is not on node,
+		// so they should be rescheduled immediately on resource owner change
+		for(i = 0; i < affectedNodes.size(); i++)
+		{
+		   shared_ptr<NetObj> node = FindObjectById(affectedNodes.get(i), OBJECT_NODE);
+		   if (node != nullptr)
+		      static_cast<Node*>(node.get())->scheduleItemsForPolling(false);
+		}
 	}
 
    // Execute hook script
@@ -842,6 +856,7 @@ void Cluster::onTemplateRemove(const shared_ptr<DataCollectionOwner>& templateOb
  */
 void Cluster::onDataCollectionChange()
 {
+   scheduleItemsForPolling(false);
    queueUpdate();
 }
 
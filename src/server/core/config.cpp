@@ -609,6 +609,10 @@ static void OnConfigVariableChange(bool isCLOB, const TCHAR *name, const TCHAR *
       else
          InterlockedAnd64(reinterpret_cast<VolatileCounter64*>(&g_flags), ~AF_ENABLE_NXSL_CONTAINER_FUNCTIONS);
    }
+   else if (!_tcscmp(name, _T("NXSL.VMPoolSize")))
+   {
+      SetScriptVMPoolSize(ConvertToUint32(value, 4));
+   }
    else if (!_tcscmp(name, _T("Objects.AutobindPollingInterval")))
    {
       g_autobindPollingInterval = ConvertToUint32(value, 3600);
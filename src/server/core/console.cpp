@@ -27,7 +27,6 @@
 /**
  * Externals
  */
-extern ObjectQueue<SyslogMessage> g_syslogProcessingQueue;
 extern ObjectQueue<SyslogMessage> g_syslogWriteQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventProcessingQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventWriterQueue;
@@ -41,6 +40,7 @@ uint32_t BindAgentTunnel(uint32_t tunnelId, uint32_t nodeId, uint32_t userId);
 uint32_t UnbindAgentTunnel(uint32_t nodeId, uint32_t userId);
 int64_t GetEventLogWriterQueueSize();
 int64_t GetEventProcessorQueueSize();
+int64_t GetSyslogProcessorQueueSize();
 void RangeScanCallback(const InetAddress& addr, int32_t zoneUIN, const Node *proxy, uint32_t rtt, const TCHAR *proto, ServerConsole *console, void *context);
 void CheckRange(const InetAddressListElement& range, void(*callback)(const InetAddress&, int32_t, const Node*, uint32_t, const TCHAR*, ServerConsole*, void*), ServerConsole *console, void *context);
 void ShowSyncerStats(ServerConsole *console);
@@ -76,10 +76,29 @@ static void ShowMemoryUsage(ServerConsole *console)
 {
    console->printf(_T("Alarms ...................: %.02f MB\n"), static_cast<double>(GetAlarmMemoryUsage()) / 1048576);
    console->printf(_T("Data collection cache ....: %.02f MB\n"), static_cast<double>(GetDCICacheMemoryUsage()) / 1048576);
+   ObjectAncestorIndexStats ancestorIndexStats;
+   GetObjectAncestorIndexStats(&ancestorIndexStats);
+   console->printf(_T("Object ancestor index ....: %.02f MB\n"), static_cast<double>(ancestorIndexStats.memoryUsage) / 1048576);
    console->printf(_T("Raw DCI data write cache .: %.02f MB\n"), static_cast<double>(GetRawDataWriterMemoryUsage()) / 1048576);
    console->print(_T("\n"));
 }
 
+/**
+ * Show object ancestor index statistics
+ */
+static void ShowObjectAncestorIndexStats(ServerConsole *console)
+{
+   ObjectAncestorIndexStats stats;
+   GetObjectAncestorIndexStats(&stats);
+   console->printf(_T("Indexed objects ..........: %u\n"), stats.objects);
+   console->printf(_T("Ancestor references ......: ") UINT64_FMT _T("\n"), stats.ancestors);
+   console->printf(_T("Memory usage .............: %.02f MB\n"), static_cast<double>(stats.memoryUsage) / 1048576);
+   console->printf(_T("Updates ..................: ") UINT64_FMT _T("\n"), stats.updates);
+   console->printf(_T("Ancestor set rebuilds ....: ") UINT64_FMT _T("\n"), stats.rebuilds);
+   console->printf(_T("Average update time ......: %.02f ms\n"), (stats.updates > 0) ? static_cast<double>(stats.totalUpdateTime) / stats.updates : 0.0);
+   console->printf(_T("Max update time ..........: %u ms\n\n"), stats.maxUpdateTime);
+}
+
 /**
  * Print ARP cache
  */
@@ -826,6 +845,12 @@ int ProcessConsoleCommand(const TCHAR *pszCmdLine, CONSOLE_CTX pCtx)
          ConsolePrintf(pCtx, _T("   DCI data ....... ") INT64_FMT _T("\n"), g_idataWriteRequests);
          ConsolePrintf(pCtx, _T("   DCI raw data ... ") INT64_FMT _T("\n"), g_rawDataWriteRequests);
          ConsolePrintf(pCtx, _T("   Others ......... ") INT64_FMT _T("\n"), g_otherWriteRequests);
+
+         uint64_t statements, records;
+         GetIDataWriterPerfCounters(&statements, &records);
+         ConsolePrintf(pCtx, _T("DCI data writer:\n"));
+         ConsolePrintf(pCtx, _T("   Statements ..... ") UINT64_FMT _T("\n"), statements);
+         ConsolePrintf(pCtx, _T("   Records ........ ") UINT64_FMT _T("\n"), records);
       }
       else if (IsCommand(_T("DISCOVERY"), szBuffer, 2))
       {
@@ -839,6 +864,10 @@ int ProcessConsoleCommand(const TCHAR *pszCmdLine, CONSOLE_CTX pCtx)
             ConsoleWrite(pCtx, _T("Invalid subcommand\n"));
          }
       }
+      else if (IsCommand(_T("EPP"), szBuffer, 3))
+      {
+         g_pEventPolicy->showStatistics(pCtx);
+      }
       else if (IsCommand(_T("EP"), szBuffer, 2))
       {
          StructArray<EventProcessingThreadStats> *stats = GetEventProcessingThreadStats();
@@ -993,7 +1022,11 @@ int ProcessConsoleCommand(const TCHAR *pszCmdLine, CONSOLE_CTX pCtx)
          // Get argument
          pArg = ExtractWord(pArg, szBuffer);
 
-         if (IsCommand(_T("CONDITION"), szBuffer, 1))
+         if (IsCommand(_T("ANCESTORS"), szBuffer, 1))
+         {
+            ShowObjectAncestorIndexStats(pCtx);
+         }
+         else if (IsCommand(_T("CONDITION"), szBuffer, 1))
          {
             DumpIndex(pCtx, &g_idxConditionById);
          }
@@ -1101,7 +1134,7 @@ int ProcessConsoleCommand(const TCHAR *pszCmdLine, CONSOLE_CTX pCtx)
             if (szBuffer[0] == 0)
                ConsoleWrite(pCtx, _T("ERROR: Missing parameters\n")
                                   _T("Syntax:\n   SHOW INDEX name [ZONE uin]\n")
-                                  _T("Valid names are: CONDITION, ID, INTERFACE, NODEADDR, NODEID, SUBNET, ZONE\n\n"));
+                                  _T("Valid names are: ANCESTORS, CONDITION, ID, INTERFACE, NODEADDR, NODEID, SUBNET, ZONE\n\n"));
             else
                ConsoleWrite(pCtx, _T("ERROR: Invalid index name\n\n"));
          }
@@ -1189,7 +1222,7 @@ int ProcessConsoleCommand(const TCHAR *pszCmdLine, CONSOLE_CTX pCtx)
          ShowQueueStats(pCtx, GetEventLogWriterQueueSize(), _T("Event log writer"));
          ShowThreadPoolPendingQueue(pCtx, g_pollerThreadPool, _T("Poller"));
          ShowQueueStats(pCtx, GetDiscoveryPollerQueueSize(), _T("Node discovery poller"));
-         ShowQueueStats(pCtx, &g_syslogProcessingQueue, _T("Syslog processor"));
+         ShowQueueStats(pCtx, GetSyslogProcessorQueueSize(), _T("Syslog processor"));
          ShowQueueStats(pCtx, &g_syslogWriteQueue, _T("Syslog writer"));
          ShowThreadPoolPendingQueue(pCtx, g_schedulerThreadPool, _T("Scheduler"));
          ShowQueueStats(pCtx, &g_windowsEventProcessingQueue, _T("Windows event processor"));
@@ -1240,6 +1273,10 @@ int ProcessConsoleCommand(const TCHAR *pszCmdLine, CONSOLE_CTX pCtx)
             ConsoleWrite(pCtx, _T("ERROR: Invalid or missing node ID\n\n"));
          }
       }
+      else if (IsCommand(_T("SCRIPTS"), szBuffer, 2))
+      {
+         ShowScriptVMPoolStatistics(pCtx);
+      }
       else if (IsCommand(_T("SESSIONS"), szBuffer, 2))
       {
          ConsoleWrite(pCtx, _T("\x1b[1mCLIENT SESSIONS\x1b[0m\n============================================================\n"));
@@ -1671,6 +1708,7 @@ int ProcessConsoleCommand(const TCHAR *pszCmdLine, CONSOLE_CTX pCtx)
             _T("   show dbstats                      - Show DB library statistics\n")
             _T("   show discovery queue              - Show content of network discovery queue\n")
             _T("   show ep                           - Show event processing threads statistics\n")
+            _T("   show epp                          - Show event processing policy dispatch index and rule statistics\n")
             _T("   show fdb <node>                   - Show forwarding database for node\n")
             _T("   show flags                        - Show internal server flags\n")
             _T("   show heap details                 - Show detailed heap information\n")
@@ -1684,6 +1722,7 @@ int ProcessConsoleCommand(const TCHAR *pszCmdLine, CONSOLE_CTX pCtx)
             _T("   show pollers                      - Show poller threads state information\n")
             _T("   show queues                       - Show internal queues statistics\n")
             _T("   show routing-table <node>         - Show cached routing table for node\n")
+            _T("   show scripts                      - Show script VM pool and execution statistics\n")
             _T("   show sessions                     - Show active client sessions\n")
             _T("   show stats                        - Show global server statistics\n")
             _T("   show syncer                       - Show syncer statistics\n")
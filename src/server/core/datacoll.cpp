@@ -29,6 +29,18 @@
  */
 #define ITEM_POLLING_INTERVAL             1
 
+/**
+ * Interval between readiness checks for DCIs on targets with inactive data collection (unmanaged, etc.).
+ * DCIs are re-scheduled immediately when DCI is activated, target becomes managed, or data collection
+ * on target is enabled, so this recheck is only a fallback.
+ */
+#define INACTIVE_TARGET_RECHECK_INTERVAL  300
+
+/**
+ * Interval between poll schedule reconciliation runs
+ */
+#define POLL_SCHEDULE_RECONCILIATION_INTERVAL   300
+
 /**
  * Thread pool for data collectors
  */
@@ -210,6 +222,65 @@ static shared_ptr<Table> GetTableData(DataCollectionTarget *dcTarget, DCTable *t
 	return result;
 }
 
+/**
+ * Transform and store received value into database or handle data collection error
+ */
+static void ProcessCollectedData(const shared_ptr<DCObject>& dcObject, uint32_t error, const TCHAR *value, const shared_ptr<Table>& table, time_t currTime)
+{
+   switch(error)
+   {
+      case DCE_SUCCESS:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         if (!static_cast<DataCollectionTarget*>(dcObject->getOwner().get())->processNewDCValue(dcObject, currTime, value, table))
+         {
+            // value processing failed, convert to data collection error
+            dcObject->processNewError(false);
+         }
+         break;
+      case DCE_COLLECTION_ERROR:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         dcObject->processNewError(false);
+         break;
+      case DCE_NO_SUCH_INSTANCE:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         dcObject->processNewError(true);
+         break;
+      case DCE_COMM_ERROR:
+         dcObject->processNewError(false);
+         break;
+      case DCE_NOT_SUPPORTED:
+         // Change item's status
+         dcObject->setStatus(ITEM_STATUS_NOT_SUPPORTED, true);
+         break;
+   }
+
+   // Send session notification when force poll is performed
+   if (dcObject->isForcePollRequested())
+   {
+      ClientSession *session = dcObject->processForcePoll();
+      if (session != nullptr)
+      {
+         session->notify(NX_NOTIFY_FORCE_DCI_POLL, dcObject->getOwnerId());
+         session->decRefCount();
+      }
+   }
+}
+
+/**
+ * Complete poll of data collection object: update last poll time, clear busy flag, and reschedule
+ * object based on new last poll time. Object could be scheduled while it was busy with later time
+ * counted from the moment of that readiness check, so without rescheduling it would skip a poll.
+ */
+static void CompleteDCObjectPoll(const shared_ptr<DCObject>& dcObject, time_t pollTime)
+{
+   dcObject->setLastPollTime(pollTime);
+   dcObject->clearBusyFlag();
+   ScheduleDCObjectPoll(dcObject, dcObject->getNextPollTime(time(nullptr)));
+}
+
 /**
  * Data collector
  */
@@ -232,8 +303,7 @@ void DataCollector(const shared_ptr<DCObject>& dcObject)
                   dcObject->getId(), dcObjectName.cstr());
 
       // Update item's last poll time and clear busy flag so item can be polled again
-      dcObject->setLastPollTime(time(nullptr));
-      dcObject->clearBusyFlag();
+      CompleteDCObjectPoll(dcObject, time(nullptr));
       return;
    }
 
@@ -290,47 +360,7 @@ void DataCollector(const shared_ptr<DCObject>& dcObject)
                break;
          }
 
-         // Transform and store received value into database or handle error
-         switch(error)
-         {
-            case DCE_SUCCESS:
-               if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-                  dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-               if (!static_cast<DataCollectionTarget*>(dcObject->getOwner().get())->processNewDCValue(dcObject, currTime, buffer, table))
-               {
-                  // value processing failed, convert to data collection error
-                  dcObject->processNewError(false);
-               }
-               break;
-            case DCE_COLLECTION_ERROR:
-               if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-                  dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-               dcObject->processNewError(false);
-               break;
-            case DCE_NO_SUCH_INSTANCE:
-               if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-                  dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-               dcObject->processNewError(true);
-               break;
-            case DCE_COMM_ERROR:
-               dcObject->processNewError(false);
-               break;
-            case DCE_NOT_SUPPORTED:
-               // Change item's status
-               dcObject->setStatus(ITEM_STATUS_NOT_SUPPORTED, true);
-               break;
-         }
-
-         // Send session notification when force poll is performed
-         if (dcObject->isForcePollRequested())
-         {
-            ClientSession *session = dcObject->processForcePoll();
-            if (session != nullptr)
-            {
-               session->notify(NX_NOTIFY_FORCE_DCI_POLL, dcObject->getOwnerId());
-               session->decRefCount();
-            }
-         }
+         ProcessCollectedData(dcObject, error, buffer, table, currTime);
       }
    }
    else     /* target == nullptr */
@@ -341,27 +371,317 @@ void DataCollector(const shared_ptr<DCObject>& dcObject)
    }
 
    // Update item's last poll time and clear busy flag so item can be polled again
-   dcObject->setLastPollTime(currTime);
-   dcObject->clearBusyFlag();
+   CompleteDCObjectPoll(dcObject, currTime);
+}
+
+/**
+ * Data collector for batch of SNMP DCIs from same node
+ */
+static void SNMPBatchCollector(SNMPDataCollectionBatch *batch)
+{
+   shared_ptr<Node> node = static_pointer_cast<Node>(FindObjectById(batch->nodeId, OBJECT_NODE));
+
+   int count = 0;
+   SNMPMetricRequest *requests = MemAllocArrayNoInit<SNMPMetricRequest>(batch->objects.size());
+   int *indexes = MemAllocArrayNoInit<int>(batch->objects.size());  // Index of DCI in batch for each request
+   for(int i = 0; i < batch->objects.size(); i++)
+   {
+      DCObject *dcObject = batch->objects.get(i);
+      if ((node == nullptr) || IsShutdownInProgress() || dcObject->isScheduledForDeletion() ||
+          (dcObject->getOwnerId() != node->getId()) || (node->getEffectiveSourceNode(dcObject) != 0))
+      {
+         // Use standard data collector for handling all special cases
+         DataCollector(batch->objects.getShared(i));
+         continue;
+      }
+
+      SNMPMetricRequest *r = &requests[count];
+      r->oidLength = SNMPParseOID(dcObject->getName(), r->oid, MAX_OID_LEN);
+      if (r->oidLength == 0)
+      {
+         time_t currTime = time(nullptr);
+         ProcessCollectedData(batch->objects.getShared(i), DCE_NOT_SUPPORTED, nullptr, shared_ptr<Table>(), currTime);
+         CompleteDCObjectPoll(batch->objects.getShared(i), currTime);
+         continue;
+      }
+      r->interpretRawValue = static_cast<DCItem*>(dcObject)->isInterpretSnmpRawValue() ? static_cast<DCItem*>(dcObject)->getSnmpRawValueType() : SNMP_RAWTYPE_NONE;
+      indexes[count++] = i;
+   }
+
+   if (count > 0)
+   {
+      nxlog_debug_tag(_T("obj.dc.snmp"), 7, _T("SNMPBatchCollector: collecting %d DCIs from node %s [%u]"), count, node->getName(), node->getId());
+
+      time_t currTime = time(nullptr);
+      node->getMetricsFromSNMP(batch->port, batch->version, requests, count,
+               static_cast<int>(node->getCustomAttributeAsUInt32(_T("SysConfig:DataCollection.SNMP.MaxVarbindsPerRequest"), batch->maxVarbinds)));
+
+      for(int i = 0; i < count; i++)
+      {
+         shared_ptr<DCObject> dcObject = batch->objects.getShared(indexes[i]);
+         ProcessCollectedData(dcObject, requests[i].error, requests[i].value, shared_ptr<Table>(), currTime);
+         MemFree(requests[i].value);
+         CompleteDCObjectPoll(dcObject, currTime);
+      }
+   }
+
+   MemFree(indexes);
+   MemFree(requests);
+   delete batch;
+}
+
+/**
+ * Data collector for batch of agent DCIs from same node
+ */
+static void AgentBatchCollector(AgentDataCollectionBatch *batch)
+{
+   shared_ptr<Node> node = static_pointer_cast<Node>(FindObjectById(batch->nodeId, OBJECT_NODE));
+
+   StringList names;
+   IntegerArray<int> indexes(batch->objects.size());  // Index of DCI in batch for each request
+   for(int i = 0; i < batch->objects.size(); i++)
+   {
+      DCObject *dcObject = batch->objects.get(i);
+      if ((node == nullptr) || IsShutdownInProgress() || dcObject->isScheduledForDeletion() ||
+          (dcObject->getOwnerId() != node->getId()) || (node->getEffectiveSourceNode(dcObject) != 0))
+      {
+         // Use standard data collector for handling all special cases
+         DataCollector(batch->objects.getShared(i));
+         continue;
+      }
+      names.add(dcObject->getName());
+      indexes.add(i);
+   }
+
+   int count = names.size();
+   if (count > 0)
+   {
+      nxlog_debug_tag(_T("obj.dc.agent"), 7, _T("AgentBatchCollector: collecting %d DCIs from node %s [%u]"), count, node->getName(), node->getId());
+
+      AgentMetricRequest *requests = MemAllocArrayNoInit<AgentMetricRequest>(count);
+      for(int i = 0; i < count; i++)
+         requests[i].name = names.get(i);
+
+      time_t currTime = time(nullptr);
+      node->getMetricsFromAgent(requests, count,
+               static_cast<int>(node->getCustomAttributeAsUInt32(_T("SysConfig:DataCollection.Agent.MaxParametersPerRequest"), batch->maxParameters)));
+
+      for(int i = 0; i < count; i++)
+      {
+         shared_ptr<DCObject> dcObject = batch->objects.getShared(indexes.get(i));
+         ProcessCollectedData(dcObject, requests[i].error, requests[i].value, shared_ptr<Table>(), currTime);
+         MemFree(requests[i].value);
+         CompleteDCObjectPoll(dcObject, currTime);
+      }
+      MemFree(requests);
+   }
+
+   delete batch;
+}
+
+/**
+ * Add DCI to batch for given node. Returns false if DCI cannot be collected as part of batch.
+ */
+bool DataCollectionBatchSet::add(uint32_t nodeId, const shared_ptr<DCObject>& object)
+{
+   if ((object->getDataSource() == DS_SNMP_AGENT) && (m_maxVarbinds > 1))
+   {
+      const DCItem *item = static_cast<const DCItem*>(object.get());
+      uint64_t key = (static_cast<uint64_t>(nodeId) << 32) | (static_cast<uint64_t>(item->getSnmpPort()) << 8) | static_cast<uint64_t>(item->getSnmpVersion());
+      SNMPDataCollectionBatch *batch = m_snmpBatches.get(key);
+      if (batch == nullptr)
+      {
+         batch = new SNMPDataCollectionBatch(nodeId, item->getSnmpPort(), item->getSnmpVersion(), m_maxVarbinds);
+         m_snmpBatches.set(key, batch);
+      }
+      batch->objects.add(object);
+      return true;
+   }
+
+   if ((object->getDataSource() == DS_NATIVE_AGENT) && (m_maxAgentParameters > 1))
+   {
+      AgentDataCollectionBatch *batch = m_agentBatches.get(nodeId);
+      if (batch == nullptr)
+      {
+         batch = new AgentDataCollectionBatch(nodeId, m_maxAgentParameters);
+         m_agentBatches.set(nodeId, batch);
+      }
+      batch->objects.add(object);
+      return true;
+   }
+
+   return false;
+}
+
+/**
+ * Callback for dispatching SNMP data collection batch
+ */
+static EnumerationCallbackResult DispatchSNMPBatch(const uint64_t& key, SNMPDataCollectionBatch *batch)
+{
+   TCHAR queueKey[32];
+   _sntprintf(queueKey, 32, _T("%08X/%s"), batch->nodeId, DCObject::getDataProviderName(DS_SNMP_AGENT));
+   if (batch->objects.size() == 1)
+   {
+      ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, queueKey, DataCollector, batch->objects.getShared(0));
+      delete batch;
+   }
+   else
+   {
+      ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, queueKey, SNMPBatchCollector, batch);
+   }
+   return _CONTINUE;
+}
+
+/**
+ * Callback for dispatching agent data collection batch
+ */
+static EnumerationCallbackResult DispatchAgentBatch(const uint32_t& key, AgentDataCollectionBatch *batch)
+{
+   TCHAR queueKey[32];
+   _sntprintf(queueKey, 32, _T("%08X/%s"), batch->nodeId, DCObject::getDataProviderName(DS_NATIVE_AGENT));
+   if (batch->objects.size() == 1)
+   {
+      ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, queueKey, DataCollector, batch->objects.getShared(0));
+      delete batch;
+   }
+   else
+   {
+      ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, queueKey, AgentBatchCollector, batch);
+   }
+   return _CONTINUE;
+}
+
+/**
+ * Send all batches to data collector queue. Batch set is empty after this call.
+ */
+void DataCollectionBatchSet::dispatch()
+{
+   m_snmpBatches.forEach(DispatchSNMPBatch);
+   m_snmpBatches.clear();
+   m_agentBatches.forEach(DispatchAgentBatch);
+   m_agentBatches.clear();
+}
+
+/**
+ * Poll schedule entry
+ */
+struct PollScheduleEntry
+{
+   time_t pollTime;
+   weak_ptr<DCObject> object;
+
+   PollScheduleEntry(time_t t, const shared_ptr<DCObject>& o) : object(o)
+   {
+      pollTime = t;
+   }
+};
+
+/**
+ * Poll schedule - binary min-heap ordered by poll time. Schedule may contain stale entries
+ * for data collection object, only entry with poll time equal to object's scheduled poll time is valid.
+ */
+static ObjectArray<PollScheduleEntry> s_pollSchedule(0, 65536, Ownership::False);
+static Mutex s_pollScheduleLock(MutexType::FAST);
+
+/**
+ * Add entry to poll schedule (schedule lock must be held)
+ */
+static void PushPollScheduleEntry(PollScheduleEntry *entry)
+{
+   int index = s_pollSchedule.size();
+   s_pollSchedule.add(entry);
+   while(index > 0)
+   {
+      int parent = (index - 1) / 2;
+      PollScheduleEntry *p = s_pollSchedule.get(parent);
+      if (p->pollTime <= entry->pollTime)
+         break;
+      s_pollSchedule.set(index, p);
+      index = parent;
+   }
+   s_pollSchedule.set(index, entry);
+}
+
+/**
+ * Remove first entry from poll schedule (schedule lock must be held)
+ */
+static PollScheduleEntry *PopPollScheduleEntry()
+{
+   PollScheduleEntry *first = s_pollSchedule.get(0);
+   int size = s_pollSchedule.size() - 1;
+   PollScheduleEntry *last = s_pollSchedule.get(size);
+   s_pollSchedule.shrinkTo(size);
+   if (size > 0)
+   {
+      int index = 0;
+      while(true)
+      {
+         int child = index * 2 + 1;
+         if (child >= size)
+            break;
+         if ((child + 1 < size) && (s_pollSchedule.get(child + 1)->pollTime < s_pollSchedule.get(child)->pollTime))
+            child++;
+         PollScheduleEntry *c = s_pollSchedule.get(child);
+         if (last->pollTime <= c->pollTime)
+            break;
+         s_pollSchedule.set(index, c);
+         index = child;
+      }
+      s_pollSchedule.set(index, last);
+   }
+   return first;
+}
+
+/**
+ * Schedule readiness check for data collection object at given time. Object already present in
+ * schedule will be moved only if new time is earlier, or will not be changed at all if
+ * unscheduledOnly is set to true.
+ */
+void ScheduleDCObjectPoll(const shared_ptr<DCObject>& object, time_t pollTime, bool unscheduledOnly)
+{
+   s_pollScheduleLock.lock();
+   time_t scheduledTime = object->getScheduledPollTime();
+   if ((scheduledTime == 0) || (!unscheduledOnly && (pollTime < scheduledTime)))
+   {
+      object->setScheduledPollTime(pollTime);
+      PushPollScheduleEntry(new PollScheduleEntry(pollTime, object));
+   }
+   s_pollScheduleLock.unlock();
 }
 
 /**
- * Callback for queueing DCIs
+ * Callback for adding missing DCIs to poll schedule
  */
-static void QueueItems(NetObj *object, uint32_t *watchdogId)
+static void ScheduleItems(NetObj *object, uint32_t *watchdogId)
 {
    if (IsShutdownInProgress())
       return;
 
    WatchdogNotify(*watchdogId);
-	nxlog_debug(8, _T("ItemPoller: calling DataCollectionTarget::queueItemsForPolling for object %s [%d]"),
-				   object->getName(), object->getId());
-	static_cast<DataCollectionTarget*>(object)->queueItemsForPolling();
+   static_cast<DataCollectionTarget*>(object)->scheduleItemsForPolling(true);
 }
 
 /**
- * Item poller thread: check nodes' items and put into the
- * data collector queue when data polling required
+ * Add all DCIs missing in poll schedule. Normally DCIs are added to schedule by
+ * data collection change hooks, this is used on startup and as safety net.
+ */
+static void ReconcilePollSchedule(uint32_t *watchdogId)
+{
+   g_idxNodeById.forEach(ScheduleItems, watchdogId);
+   g_idxClusterById.forEach(ScheduleItems, watchdogId);
+   g_idxMobileDeviceById.forEach(ScheduleItems, watchdogId);
+   g_idxChassisById.forEach(ScheduleItems, watchdogId);
+   g_idxSensorById.forEach(ScheduleItems, watchdogId);
+
+   s_pollScheduleLock.lock();
+   int size = s_pollSchedule.size();
+   s_pollScheduleLock.unlock();
+   nxlog_debug_tag(_T("obj.dc.poller"), 5, _T("ItemPoller: poll schedule reconciled (%d entries)"), size);
+}
+
+/**
+ * Item poller thread: take DCIs which are due for readiness check from poll schedule and
+ * put into the data collector queue when data polling required
  */
 static void ItemPoller()
 {
@@ -370,6 +690,10 @@ static void ItemPoller()
    uint32_t watchdogId = WatchdogAddThread(_T("Item Poller"), 10);
    GaugeData<uint32_t> queuingTime(ITEM_POLLING_INTERVAL, 300);
 
+   ReconcilePollSchedule(&watchdogId);
+   time_t lastReconciliation = time(nullptr);
+
+   ObjectArray<PollScheduleEntry> dueEntries(4096, 4096, Ownership::True);
    while(!IsShutdownInProgress())
    {
       if (SleepAndCheckForShutdown(ITEM_POLLING_INTERVAL))
@@ -377,16 +701,62 @@ static void ItemPoller()
       WatchdogNotify(watchdogId);
       nxlog_debug_tag(_T("obj.dc.poller"), 8, _T("ItemPoller: wakeup"));
 
-      INT64 startTime = GetCurrentTimeMs();
-		g_idxNodeById.forEach(QueueItems, &watchdogId);
-		g_idxClusterById.forEach(QueueItems, &watchdogId);
-		g_idxMobileDeviceById.forEach(QueueItems, &watchdogId);
-      g_idxChassisById.forEach(QueueItems, &watchdogId);
-		g_idxSensorById.forEach(QueueItems, &watchdogId);
+      int64_t startTime = GetCurrentTimeMs();
+      time_t now = time(nullptr);
+
+      s_pollScheduleLock.lock();
+      while((s_pollSchedule.size() > 0) && (s_pollSchedule.get(0)->pollTime <= now))
+      {
+         PollScheduleEntry *entry = PopPollScheduleEntry();
+         shared_ptr<DCObject> object = entry->object.lock();
+         if ((object != nullptr) && (object->getScheduledPollTime() == entry->pollTime))
+         {
+            object->setScheduledPollTime(0);
+            dueEntries.add(entry);
+         }
+         else
+         {
+            delete entry;  // Stale entry
+         }
+      }
+      s_pollScheduleLock.unlock();
+
+      DataCollectionBatchSet batches(ConfigReadInt(_T("DataCollection.SNMP.MaxVarbindsPerRequest"), 32),
+               ConfigReadInt(_T("DataCollection.Agent.MaxParametersPerRequest"), MAX_BULK_METRIC_REQUEST_SIZE));
+      for(int i = 0; i < dueEntries.size(); i++)
+      {
+         shared_ptr<DCObject> object = dueEntries.get(i)->object.lock();
+         if ((object == nullptr) || object->isScheduledForDeletion())
+            continue;
+
+         shared_ptr<DataCollectionOwner> owner = object->getOwner();
+         if ((owner == nullptr) || !owner->isDataCollectionTarget())
+            continue;   // Objects on templates are not polled
+
+         time_t nextPollTime = static_cast<DataCollectionTarget&>(*owner).queueItemForPolling(object, now, &batches) ?
+                  object->getNextPollTime(now) : now + INACTIVE_TARGET_RECHECK_INTERVAL;
+         ScheduleDCObjectPoll(object, nextPollTime);
+      }
+      batches.dispatch();
+      nxlog_debug_tag(_T("obj.dc.poller"), 7, _T("ItemPoller: %d data collection objects checked"), dueEntries.size());
+      dueEntries.clear();
 
 		queuingTime.update(static_cast<uint32_t>(GetCurrentTimeMs() - startTime));
 		g_averageDCIQueuingTime = static_cast<uint32_t>(queuingTime.getAverage());
+
+      if (now - lastReconciliation >= POLL_SCHEDULE_RECONCILIATION_INTERVAL)
+      {
+         ReconcilePollSchedule(&watchdogId);
+         lastReconciliation = now;
+      }
    }
+
+   s_pollScheduleLock.lock();
+   for(int i = 0; i < s_pollSchedule.size(); i++)
+      delete s_pollSchedule.get(i);
+   s_pollSchedule.clear();
+   s_pollScheduleLock.unlock();
+
    nxlog_debug_tag(_T("obj.dc.poller"), 1, _T("Item poller thread terminated"));
 }
 
@@ -432,7 +802,7 @@ void InitDataCollector()
    g_dataCollectorThreadPool = ThreadPoolCreate(_T("DATACOLL"),
             ConfigReadInt(_T("ThreadPool.DataCollector.BaseSize"), 10),
             ConfigReadInt(_T("ThreadPool.DataCollector.MaxSize"), 250),
-            256 * 1024);
+            256 * 1024, ConfigReadBoolean(_T("ThreadPool.DataCollector.WorkStealing"), false));
 
    s_itemPollerThread = ThreadCreateEx(ItemPoller);
    s_cacheLoaderThread = ThreadCreateEx(CacheLoader);
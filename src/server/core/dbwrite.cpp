@@ -70,6 +70,8 @@ struct IDataWriter
    THREAD thread;
    ObjectQueue<DELAYED_IDATA_INSERT> *queue;
    const TCHAR *storageClass;
+   VolatileCounter64 statements;   // Number of executed INSERT statements
+   VolatileCounter64 records;      // Number of successfully written records
 };
 
 /**
@@ -330,6 +332,168 @@ static void DBWriteThread()
    }
 }
 
+/**
+ * Check if multi-row VALUES clause in INSERT statement is supported by current database
+ */
+static inline bool IsMultiRowInsertSupported()
+{
+   return (g_dbSyntax == DB_SYNTAX_PGSQL) || (g_dbSyntax == DB_SYNTAX_TSDB) || (g_dbSyntax == DB_SYNTAX_MYSQL) ||
+          (g_dbSyntax == DB_SYNTAX_MSSQL) || (g_dbSyntax == DB_SYNTAX_SQLITE) || (g_dbSyntax == DB_SYNTAX_DB2);
+}
+
+/**
+ * Get maximum number of records per one INSERT statement for idata writers
+ */
+static int GetIDataMaxRecordsPerStatement()
+{
+   if (!IsMultiRowInsertSupported())
+      return 1;
+
+   int maxRecordsPerStmt = ConfigReadInt(_T("DBWriter.MaxRecordsPerStatement"), 100);
+   if (maxRecordsPerStmt < 1)
+      return 1;
+
+   // MS SQL allows up to 1000 rows in VALUES clause, and SQLite may be compiled with limit of 500 terms in compound statement
+   if ((g_dbSyntax == DB_SYNTAX_MSSQL) && (maxRecordsPerStmt > 1000))
+      return 1000;
+   if ((g_dbSyntax == DB_SYNTAX_SQLITE) && (maxRecordsPerStmt > 500))
+      return 500;
+   return maxRecordsPerStmt;
+}
+
+/**
+ * Read batch of delayed idata inserts from writer queue. Will wait indefinitely for first record, and then
+ * collect more records until either batch is full or flush interval (in milliseconds) expires.
+ * Returns false if end-of-job indicator was received (batch still may contain records that should be written).
+ */
+static bool ReadIDataBatch(IDataWriter *writer, ObjectArray<DELAYED_IDATA_INSERT> *batch, int maxRecords, uint32_t flushInterval)
+{
+   DELAYED_IDATA_INSERT *rq = writer->queue->getOrBlock();
+   if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
+      return false;
+   batch->add(rq);
+
+   int64_t deadline = GetCurrentTimeMs() + flushInterval;
+   while(batch->size() < maxRecords)
+   {
+      int64_t now = GetCurrentTimeMs();
+      rq = writer->queue->getOrBlock((now < deadline) ? static_cast<uint32_t>(deadline - now) : 0);
+      if (rq == nullptr)
+         break;
+      if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
+         return false;
+      batch->add(rq);
+   }
+   return true;
+}
+
+/**
+ * Write given set of records into idata table using multi-row INSERT statements where possible.
+ * Table name is either "idata" or "idata_<node_id>". Returns true on success.
+ */
+static bool WriteIDataRecords(IDataWriter *writer, DB_HANDLE hdb, const TCHAR *table, const DELAYED_IDATA_INSERT * const *records, int count, int maxRecordsPerStmt, StringBuffer *query)
+{
+   TCHAR queryBase[256];
+   _sntprintf(queryBase, 256, _T("INSERT INTO %s (item_id,idata_timestamp,idata_value,raw_value) VALUES"), table);
+
+   TCHAR data[1024];
+   for(int i = 0; i < count; i += maxRecordsPerStmt)
+   {
+      *query = queryBase;
+      int stmtRecords = std::min(count - i, maxRecordsPerStmt);
+      for(int j = 0; j < stmtRecords; j++)
+      {
+         const DELAYED_IDATA_INSERT *rq = records[i + j];
+         _sntprintf(data, 1024, _T("%c(%u,%u,%s,%s)"), (j > 0) ? _T(',') : _T(' '),
+                    rq->dciId, static_cast<uint32_t>(rq->timestamp),
+                    (const TCHAR *)DBPrepareString(hdb, rq->transformedValue),
+                    (const TCHAR *)DBPrepareString(hdb, rq->rawValue));
+         query->append(data);
+      }
+      InterlockedIncrement64(&writer->statements);
+      if (!DBQuery(hdb, *query))
+         return false;
+      InterlockedAdd64(&writer->records, stmtRecords);
+   }
+   return true;
+}
+
+/**
+ * Write given set of records into idata table using prepared statement (Oracle version)
+ */
+static bool WriteIDataRecordsPrepared(IDataWriter *writer, DB_HANDLE hdb, const TCHAR *table, const DELAYED_IDATA_INSERT * const *records, int count)
+{
+   TCHAR query[256];
+   _sntprintf(query, 256, _T("INSERT INTO %s (item_id,idata_timestamp,idata_value,raw_value) VALUES (?,?,?,?)"), table);
+   DB_STATEMENT hStmt = DBPrepare(hdb, query, count > 1);
+   if (hStmt == nullptr)
+      return false;
+
+   bool success = true;
+   for(int i = 0; (i < count) && success; i++)
+   {
+      const DELAYED_IDATA_INSERT *rq = records[i];
+      DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, rq->dciId);
+      DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, static_cast<int64_t>(rq->timestamp));
+      DBBind(hStmt, 3, DB_SQLTYPE_VARCHAR, rq->transformedValue, DB_BIND_STATIC);
+      DBBind(hStmt, 4, DB_SQLTYPE_VARCHAR, rq->rawValue, DB_BIND_STATIC);
+      InterlockedIncrement64(&writer->statements);
+      success = DBExecute(hStmt);
+      if (success)
+         InterlockedIncrement64(&writer->records);
+   }
+   DBFreeStatement(hStmt);
+   return success;
+}
+
+/**
+ * Write given set of records into idata table one by one, outside of transaction. Used after failure of
+ * batch write, so one bad record will not cause loss of entire batch. Returns number of records that were not written.
+ */
+static int WriteIDataRecordsOneByOne(IDataWriter *writer, DB_HANDLE hdb, const TCHAR *table, const DELAYED_IDATA_INSERT * const *records, int count, StringBuffer *query)
+{
+   int failed = 0;
+   for(int i = 0; i < count; i++)
+   {
+      bool success = (g_dbSyntax == DB_SYNTAX_ORACLE) ?
+               WriteIDataRecordsPrepared(writer, hdb, table, &records[i], 1) :
+               WriteIDataRecords(writer, hdb, table, &records[i], 1, 1, query);
+      if (!success)
+         failed++;
+   }
+   return failed;
+}
+
+/**
+ * Report records dropped by idata writer
+ */
+static void ReportDroppedIDataRecords(int dropped, int total)
+{
+   if (dropped > 0)
+      nxlog_write_tag(NXLOG_WARNING, DEBUG_TAG, _T("Background database writer dropped %d of %d DCI data records because of database errors"), dropped, total);
+}
+
+/**
+ * Compare delayed idata inserts by node ID
+ */
+static int CompareIDataInsertByNode(const DELAYED_IDATA_INSERT **r1, const DELAYED_IDATA_INSERT **r2)
+{
+   return ((*r1)->nodeId < (*r2)->nodeId) ? -1 : (((*r1)->nodeId > (*r2)->nodeId) ? 1 : 0);
+}
+
+/**
+ * Lock idata writes from writer thread if required
+ */
+static inline bool LockIDataWriter()
+{
+   if (g_flags & AF_DBWRITER_HK_INTERLOCK)
+   {
+      s_idataWriteLock.readLock();
+      return true;
+   }
+   return false;
+}
+
 /**
  * Database "lazy" write thread for idata_xxx INSERTs
  */
@@ -337,87 +501,87 @@ static THREAD_RESULT THREAD_CALL IDataWriteThread(void *arg)
 {
    ThreadSetName("DBWriter/IData");
    IDataWriter *writer = static_cast<IDataWriter*>(arg);
-   int maxRecords = ConfigReadInt(_T("DBWriter.MaxRecordsPerTransaction"), 1000);
-   while(true)
+   int maxRecordsPerTxn = ConfigReadInt(_T("DBWriter.MaxRecordsPerTransaction"), 1000);
+   int maxRecordsPerStmt = GetIDataMaxRecordsPerStatement();
+   uint32_t flushInterval = ConfigReadULong(_T("DBWriter.IDataFlushInterval"), 500);
+
+   ObjectArray<DELAYED_IDATA_INSERT> batch(maxRecordsPerTxn, 1024, Ownership::False);
+   StringBuffer query;
+   query.setAllocationStep(65536);
+
+   bool running = true;
+   while(running)
    {
-		DELAYED_IDATA_INSERT *rq = writer->queue->getOrBlock();
-      if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
+      running = ReadIDataBatch(writer, &batch, maxRecordsPerTxn, flushInterval);
+      if (batch.isEmpty())
          break;
 
-      bool idataLock;
-      if (g_flags & AF_DBWRITER_HK_INTERLOCK)
-      {
-         s_idataWriteLock.readLock();
-         idataLock = true;
-      }
-      else
-      {
-         idataLock = false;
-      }
+      // Records for same node should go into same statement
+      batch.sort(CompareIDataInsertByNode);
 
+      bool idataLock = LockIDataWriter();
       DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
-		if (DBBegin(hdb))
-		{
-			int count = 0;
-			while(true)
-			{
-				bool success;
+      const DELAYED_IDATA_INSERT * const *records = batch.getBuffer();
+      int64_t writtenRecords = writer->records;   // Only this thread updates counter
+      bool success = DBBegin(hdb);
+      if (success)
+      {
+         int start = 0;
+         while(start < batch.size())
+         {
+            int end = start + 1;
+            while((end < batch.size()) && (records[end]->nodeId == records[start]->nodeId))
+               end++;
+
+            TCHAR table[32];
+            _sntprintf(table, 32, _T("idata_%u"), records[start]->nodeId);
+
+            // For Oracle preparing statement even for one time execution is preferred
+            // For other databases it will actually slow down inserts
+            success = (g_dbSyntax == DB_SYNTAX_ORACLE) ?
+                     WriteIDataRecordsPrepared(writer, hdb, table, &records[start], end - start) :
+                     WriteIDataRecords(writer, hdb, table, &records[start], end - start, maxRecordsPerStmt, &query);
+            if (!success)
+               break;
 
-				// For Oracle preparing statement even for one time execution is preferred
-				// For other databases it will actually slow down inserts
-				if (g_dbSyntax == DB_SYNTAX_ORACLE)
-				{
-	            TCHAR query[256];
-               _sntprintf(query, 256, _T("INSERT INTO idata_%d (item_id,idata_timestamp,idata_value,raw_value) VALUES (?,?,?,?)"), (int)rq->nodeId);
-               DB_STATEMENT hStmt = DBPrepare(hdb, query);
-               if (hStmt != NULL)
-               {
-                  DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, rq->dciId);
-                  DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, (INT64)rq->timestamp);
-                  DBBind(hStmt, 3, DB_SQLTYPE_VARCHAR, rq->transformedValue, DB_BIND_STATIC);
-                  DBBind(hStmt, 4, DB_SQLTYPE_VARCHAR, rq->rawValue, DB_BIND_STATIC);
-                  success = DBExecute(hStmt);
-                  DBFreeStatement(hStmt);
-               }
-               else
-               {
-                  success = false;
-               }
-				}
-				else
-				{
-               TCHAR query[1024];
-               _sntprintf(query, 1024, _T("INSERT INTO idata_%d (item_id,idata_timestamp,idata_value,raw_value) VALUES (%d,%d,%s,%s)"),
-                          (int)rq->nodeId, (int)rq->dciId, (int)rq->timestamp,
-                          (const TCHAR *)DBPrepareString(hdb, rq->transformedValue),
-                          (const TCHAR *)DBPrepareString(hdb, rq->rawValue));
-               success = DBQuery(hdb, query);
-				}
+            start = end;
+         }
+         if (success)
+            success = DBCommit(hdb);
+         else
+            DBRollback(hdb);
+      }
 
-				MemFree(rq);
+      if (!success)
+      {
+         // Transaction was rolled back, retry all records one by one to drop only invalid ones
+         nxlog_debug_tag(DEBUG_TAG, 4, _T("IDataWriteThread: batch write failed, retrying %d records one by one"), batch.size());
+         InterlockedAdd64(&writer->records, writtenRecords - writer->records);   // Records from rolled back transaction were not written
+         int dropped = 0;
+         int start = 0;
+         while(start < batch.size())
+         {
+            int end = start + 1;
+            while((end < batch.size()) && (records[end]->nodeId == records[start]->nodeId))
+               end++;
 
-				count++;
-				if (!success || (count > maxRecords))
-					break;
+            TCHAR table[32];
+            _sntprintf(table, 32, _T("idata_%u"), records[start]->nodeId);
+            dropped += WriteIDataRecordsOneByOne(writer, hdb, table, &records[start], end - start, &query);
 
-				rq = writer->queue->getOrBlock(500);
-				if ((rq == nullptr) || (rq == INVALID_POINTER_VALUE))
-					break;
-			}
-			DBCommit(hdb);
-		}
-		else
-		{
-			MemFree(rq);
-		}
-		DBConnectionPoolReleaseConnection(hdb);
+            start = end;
+         }
+         ReportDroppedIDataRecords(dropped, batch.size());
+      }
+      DBConnectionPoolReleaseConnection(hdb);
 
-		if (idataLock)
-		   s_idataWriteLock.unlock();
+      if (idataLock)
+         s_idataWriteLock.unlock();
 
-      if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
-         break;
-	}
+      for(int i = 0; i < batch.size(); i++)
+         MemFree(batch.get(i));
+      batch.clear();
+   }
 
    return THREAD_OK;
 }
@@ -429,61 +593,50 @@ static THREAD_RESULT THREAD_CALL IDataWriteThreadSingleTable_Generic(void *arg)
 {
    ThreadSetName("DBWriter/IData");
    IDataWriter *writer = static_cast<IDataWriter*>(arg);
-   int maxRecords = ConfigReadInt(_T("DBWriter.MaxRecordsPerTransaction"), 1000);
+   int maxRecordsPerTxn = ConfigReadInt(_T("DBWriter.MaxRecordsPerTransaction"), 1000);
+   int maxRecordsPerStmt = GetIDataMaxRecordsPerStatement();
+   uint32_t flushInterval = ConfigReadULong(_T("DBWriter.IDataFlushInterval"), 500);
 
-   TCHAR query[1024];
-   while(true)
+   ObjectArray<DELAYED_IDATA_INSERT> batch(maxRecordsPerTxn, 1024, Ownership::False);
+   StringBuffer query;
+   query.setAllocationStep(65536);
+
+   bool running = true;
+   while(running)
    {
-      DELAYED_IDATA_INSERT *rq = writer->queue->getOrBlock();
-      if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
+      running = ReadIDataBatch(writer, &batch, maxRecordsPerTxn, flushInterval);
+      if (batch.isEmpty())
          break;
 
-      bool idataLock;
-      if (g_flags & AF_DBWRITER_HK_INTERLOCK)
-      {
-         s_idataWriteLock.readLock();
-         idataLock = true;
-      }
-      else
-      {
-         idataLock = false;
-      }
-
+      bool idataLock = LockIDataWriter();
       DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
-      if (DBBegin(hdb))
+      int64_t writtenRecords = writer->records;   // Only this thread updates counter
+      bool success = DBBegin(hdb);
+      if (success)
       {
-         int count = 0;
-         while(true)
-         {
-            _sntprintf(query, 1024, _T("INSERT INTO idata (item_id,idata_timestamp,idata_value,raw_value) VALUES (%d,%d,%s,%s)"),
-                       (int)rq->dciId, (int)rq->timestamp,
-                       (const TCHAR *)DBPrepareString(hdb, rq->transformedValue),
-                       (const TCHAR *)DBPrepareString(hdb, rq->rawValue));
-            bool success = DBQuery(hdb, query);
-
-            MemFree(rq);
-
-            count++;
-            if (!success || (count > maxRecords))
-               break;
-
-            rq = writer->queue->getOrBlock(500);
-            if ((rq == NULL) || (rq == INVALID_POINTER_VALUE))
-               break;
-         }
-         DBCommit(hdb);
+         success = WriteIDataRecords(writer, hdb, _T("idata"), batch.getBuffer(), batch.size(), maxRecordsPerStmt, &query);
+         if (success)
+            success = DBCommit(hdb);
+         else
+            DBRollback(hdb);
       }
-      else
+
+      if (!success)
       {
-         MemFree(rq);
+         // Transaction was rolled back, retry all records one by one to drop only invalid ones
+         nxlog_debug_tag(DEBUG_TAG, 4, _T("IDataWriteThreadSingleTable: batch write failed, retrying %d records one by one"), batch.size());
+         InterlockedAdd64(&writer->records, writtenRecords - writer->records);   // Records from rolled back transaction were not written
+         int dropped = WriteIDataRecordsOneByOne(writer, hdb, _T("idata"), batch.getBuffer(), batch.size(), &query);
+         ReportDroppedIDataRecords(dropped, batch.size());
       }
       DBConnectionPoolReleaseConnection(hdb);
 
       if (idataLock)
          s_idataWriteLock.unlock();
 
-      if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
-         break;
+      for(int i = 0; i < batch.size(); i++)
+         MemFree(batch.get(i));
+      batch.clear();
    }
 
    return THREAD_OK;
@@ -512,6 +665,7 @@ static THREAD_RESULT THREAD_CALL IDataWriteThreadSingleTable_PostgreSQL(void *ar
 
    int maxRecordsPerTxn = ConfigReadInt(_T("DBWriter.MaxRecordsPerTransaction"), 1000);
    int maxRecordsPerStmt = ConfigReadInt(_T("DBWriter.MaxRecordsPerStatement"), 100);
+   uint32_t flushInterval = ConfigReadULong(_T("DBWriter.IDataFlushInterval"), 500);
    if (maxRecordsPerTxn < maxRecordsPerStmt)
       maxRecordsPerTxn = maxRecordsPerStmt;
    else if (maxRecordsPerTxn % maxRecordsPerStmt != 0)
@@ -568,22 +722,26 @@ static THREAD_RESULT THREAD_CALL IDataWriteThreadSingleTable_PostgreSQL(void *ar
             {
                countStmt = 0;
                query.append(_T(" ON CONFLICT DO NOTHING"));
+               InterlockedIncrement64(&writer->statements);
                if (!DBQuery(hdb, query))
                   break;
+               InterlockedAdd64(&writer->records, maxRecordsPerStmt);
                query = queryBase;
             }
 
             if (countTxn >= maxRecordsPerTxn)
                break;
 
-            rq = writer->queue->getOrBlock(500);
+            rq = writer->queue->getOrBlock(flushInterval);
             if ((rq == nullptr) || (rq == INVALID_POINTER_VALUE))
                break;
          }
          if (countStmt > 0)
          {
             query.append(_T(" ON CONFLICT DO NOTHING"));
-            DBQuery(hdb, query);
+            InterlockedIncrement64(&writer->statements);
+            if (DBQuery(hdb, query))
+               InterlockedAdd64(&writer->records, countStmt);
          }
          DBCommit(hdb);
       }
@@ -611,6 +769,7 @@ static THREAD_RESULT THREAD_CALL IDataWriteThreadSingleTable_Oracle(void *arg)
    ThreadSetName("DBWriter/IData");
    IDataWriter *writer = static_cast<IDataWriter*>(arg);
    int maxRecords = ConfigReadInt(_T("DBWriter.MaxRecordsPerTransaction"), 1000);
+   uint32_t flushInterval = ConfigReadULong(_T("DBWriter.IDataFlushInterval"), 500);
    while(true)
    {
       DELAYED_IDATA_INSERT *rq = writer->queue->getOrBlock();
@@ -641,7 +800,10 @@ static THREAD_RESULT THREAD_CALL IDataWriteThreadSingleTable_Oracle(void *arg)
                DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, (INT64)rq->timestamp);
                DBBind(hStmt, 3, DB_SQLTYPE_VARCHAR, rq->transformedValue, DB_BIND_STATIC);
                DBBind(hStmt, 4, DB_SQLTYPE_VARCHAR, rq->rawValue, DB_BIND_STATIC);
+               InterlockedIncrement64(&writer->statements);
                bool success = DBExecute(hStmt);
+               if (success)
+                  InterlockedIncrement64(&writer->records);
 
                MemFree(rq);
 
@@ -649,7 +811,7 @@ static THREAD_RESULT THREAD_CALL IDataWriteThreadSingleTable_Oracle(void *arg)
                if (!success || (count > maxRecords))
                   break;
 
-               rq = writer->queue->getOrBlock(500);
+               rq = writer->queue->getOrBlock(flushInterval);
                if ((rq == NULL) || (rq == INVALID_POINTER_VALUE))
                   break;
             }
@@ -699,55 +861,47 @@ static void SaveRawData(int maxRecords)
    if (DBBegin(hdb))
    {
       DB_STATEMENT hStmt = DBPrepare(hdb, _T("UPDATE raw_dci_values SET raw_value=?,transformed_value=?,last_poll_time=?,cache_timestamp=? WHERE item_id=?"), true);
-      if (hStmt != nullptr)
+      DB_STATEMENT hDeleteStmt = DBPrepare(hdb, _T("DELETE FROM raw_dci_values WHERE item_id=?"), true);
+      if ((hStmt != nullptr) && (hDeleteStmt != nullptr) && DBOpenBatch(hStmt) && DBOpenBatch(hDeleteStmt))
       {
-         DB_STATEMENT hDeleteStmt = nullptr;
          int count = 0;
-
          DELAYED_RAW_DATA_UPDATE *rq, *tmp;
          HASH_ITER(hh, batch, rq, tmp)
          {
-            bool success = false;
             if (rq->deleteFlag)
             {
-               if (hDeleteStmt == nullptr)
-                  hDeleteStmt = DBPrepare(hdb, _T("DELETE FROM raw_dci_values WHERE item_id=?"), true);
-               if (hDeleteStmt != nullptr)
-               {
-                  DBBind(hDeleteStmt, 1, DB_SQLTYPE_INTEGER, rq->dciId);
-                  success = DBExecute(hDeleteStmt);
-               }
+               DBNextBatchRow(hDeleteStmt);
+               DBBind(hDeleteStmt, 1, DB_SQLTYPE_INTEGER, rq->dciId);
             }
             else
             {
+               DBNextBatchRow(hStmt);
                DBBind(hStmt, 1, DB_SQLTYPE_VARCHAR, rq->rawValue, DB_BIND_STATIC);
                DBBind(hStmt, 2, DB_SQLTYPE_VARCHAR, rq->transformedValue, DB_BIND_STATIC);
                DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<int64_t>(rq->timestamp));
                DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<int64_t>(rq->cacheTimestamp));
                DBBind(hStmt, 5, DB_SQLTYPE_INTEGER, rq->dciId);
-               success = DBExecute(hStmt);
             }
 
-            if (!success)
-               break;
-
-            HASH_DEL(batch, rq);
-            MemFree(rq);
-            s_batchSize--;
-
             count++;
-            if (count >= maxRecords)
+            if ((count >= maxRecords) || (rq->hh.next == nullptr))
             {
-               DBCommit(hdb);
-               if (!DBBegin(hdb))
+               if (!DBExecute(hStmt) || !DBExecute(hDeleteStmt))
                   break;
+               s_batchSize -= count;
                count = 0;
+               if (rq->hh.next == nullptr)
+                  break;
+               DBCommit(hdb);
+               if (!DBBegin(hdb) || !DBOpenBatch(hStmt) || !DBOpenBatch(hDeleteStmt))
+                  break;
             }
          }
-         DBFreeStatement(hStmt);
-         if (hDeleteStmt != nullptr)
-            DBFreeStatement(hDeleteStmt);
       }
+      if (hStmt != nullptr)
+         DBFreeStatement(hStmt);
+      if (hDeleteStmt != nullptr)
+         DBFreeStatement(hDeleteStmt);
       DBCommit(hdb);
    }
    DBConnectionPoolReleaseConnection(hdb);
@@ -943,6 +1097,20 @@ int64_t GetIDataWriterQueueSize()
    return size;
 }
 
+/**
+ * Get IData writer performance counters (number of executed statements and number of written records)
+ */
+void GetIDataWriterPerfCounters(uint64_t *statements, uint64_t *records)
+{
+   *statements = 0;
+   *records = 0;
+   for(int i = 0; i < s_idataWriterCount; i++)
+   {
+      *statements += static_cast<uint64_t>(s_idataWriters[i].statements);
+      *records += static_cast<uint64_t>(s_idataWriters[i].records);
+   }
+}
+
 /**
  * Get size of raw data writer queue
  */
@@ -973,6 +1141,11 @@ void ClearDBWriterData(ServerConsole *console, const TCHAR *component)
    if (!_tcsicmp(component, _T("Counters")))
    {
       g_idataWriteRequests = 0;
+      for(int i = 0; i < s_idataWriterCount; i++)
+      {
+         s_idataWriters[i].statements = 0;
+         s_idataWriters[i].records = 0;
+      }
       g_rawDataWriteRequests = 0;
       g_otherWriteRequests = 0;
       console->print(_T("Database writer counters cleared\n"));
@@ -0,0 +1,666 @@
+/*
+** NetXMS - Network Management System
+** Copyright (C) 2003-2022 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: dci_rollup.cpp
+**
+**/
+
+#include "nxcore.h"
+
+#define DEBUG_TAG _T("dc.rollup")
+
+bool ThrottleHousekeeper();
+
+/**
+ * Rollup levels
+ */
+static struct
+{
+   const TCHAR *table;
+   time_t period;
+   const TCHAR *retentionParameter;
+   uint32_t defaultRetentionTime;   // Days
+} s_rollupLevels[] =
+{
+   { _T("dci_data_rollup_5m"), 300, _T("DataCollection.Rollup.FiveMinuteRetentionTime"), 90 },
+   { _T("dci_data_rollup_1h"), 3600, _T("DataCollection.Rollup.HourlyRetentionTime"), 730 }
+};
+
+/**
+ * Get oldest timestamp still covered by given rollup level (older records are removed by housekeeper)
+ */
+static time_t GetRollupRetentionStart(int level, time_t now)
+{
+   return now - static_cast<time_t>(ConfigReadULong(s_rollupLevels[level].retentionParameter, s_rollupLevels[level].defaultRetentionTime)) * 86400;
+}
+
+/**
+ * Maximum time range processed in single transaction when rolling up DCI data
+ */
+#define ROLLUP_CHUNK_SIZE  86400
+
+/**
+ * End of last rolled up period for each DCI. Rollups for both levels are always
+ * calculated together for whole hours, so single watermark is sufficient.
+ * Watermarks are persisted in table dci_rollup_watermarks.
+ */
+static HashMap<uint32_t, time_t> s_watermarks(Ownership::True);
+static Mutex s_watermarkLock(MutexType::FAST);
+static bool s_watermarksLoaded = false;
+
+/**
+ * Load rollup watermarks from database
+ */
+static void LoadWatermarks(DB_HANDLE hdb)
+{
+   DB_RESULT hResult = DBSelect(hdb, _T("SELECT item_id,watermark FROM dci_rollup_watermarks"));
+   if (hResult == nullptr)
+      return;
+
+   int count = DBGetNumRows(hResult);
+   for(int i = 0; i < count; i++)
+      s_watermarks.set(DBGetFieldULong(hResult, i, 0), new time_t(static_cast<time_t>(DBGetFieldInt64(hResult, i, 1))));
+   DBFreeResult(hResult);
+   s_watermarksLoaded = true;
+   nxlog_debug_tag(DEBUG_TAG, 4, _T("Rollup watermarks loaded for %d DCIs"), count);
+}
+
+/**
+ * Get rollup watermark for given DCI (0 if rollups for this DCI were never calculated)
+ */
+static time_t GetWatermark(DB_HANDLE hdb, uint32_t dciId)
+{
+   s_watermarkLock.lock();
+   if (!s_watermarksLoaded)
+      LoadWatermarks(hdb);
+   time_t *wm = s_watermarks.get(dciId);
+   time_t result = (wm != nullptr) ? *wm : 0;
+   s_watermarkLock.unlock();
+   return result;
+}
+
+/**
+ * Set rollup watermark for given DCI
+ */
+static void SetWatermark(uint32_t dciId, time_t watermark)
+{
+   s_watermarkLock.lock();
+   s_watermarks.set(dciId, new time_t(watermark));
+   s_watermarkLock.unlock();
+}
+
+/**
+ * Prepare statement for reading raw DCI values in given time range (start inclusive, end exclusive)
+ */
+static DB_STATEMENT PrepareRawDataSelect(DB_HANDLE hdb, uint32_t ownerId, DCObjectStorageClass storageClass)
+{
+   TCHAR query[256];
+   if (g_flags & AF_SINGLE_TABLE_PERF_DATA)
+   {
+      if (g_dbSyntax == DB_SYNTAX_TSDB)
+         _sntprintf(query, 256, _T("SELECT date_part('epoch',idata_timestamp)::int,idata_value FROM idata_sc_%s WHERE item_id=? AND idata_timestamp>=to_timestamp(?) AND idata_timestamp<to_timestamp(?) ORDER BY idata_timestamp"),
+                  DCObject::getStorageClassName(storageClass));
+      else
+         _tcscpy(query, _T("SELECT idata_timestamp,idata_value FROM idata WHERE item_id=? AND idata_timestamp>=? AND idata_timestamp<? ORDER BY idata_timestamp"));
+   }
+   else
+   {
+      _sntprintf(query, 256, _T("SELECT idata_timestamp,idata_value FROM idata_%u WHERE item_id=? AND idata_timestamp>=? AND idata_timestamp<? ORDER BY idata_timestamp"), ownerId);
+   }
+   return DBPrepare(hdb, query);
+}
+
+/**
+ * Read raw DCI values in given time range (start inclusive, end exclusive)
+ */
+static bool ReadRawSamples(DB_HANDLE hdb, uint32_t ownerId, const DCItem& dci, time_t start, time_t end, SampleConsumer *consumer)
+{
+   if (start >= end)
+      return true;
+
+   DB_STATEMENT hStmt = PrepareRawDataSelect(hdb, ownerId, dci.getStorageClass());
+   if (hStmt == nullptr)
+      return false;
+
+   DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, dci.getId());
+   DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, static_cast<int64_t>(start));
+   DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<int64_t>(end));
+   DB_UNBUFFERED_RESULT hResult = DBSelectPreparedUnbuffered(hStmt);
+   if (hResult != nullptr)
+   {
+      while(DBFetch(hResult))
+      {
+         double value = DBGetFieldDouble(hResult, 1);
+         consumer->addSample(static_cast<time_t>(DBGetFieldInt64(hResult, 0)), value, value, value, 1);
+      }
+      DBFreeResult(hResult);
+   }
+   DBFreeStatement(hStmt);
+   return hResult != nullptr;
+}
+
+/**
+ * Read rollup records with period start within given time range (start inclusive, end exclusive)
+ */
+static bool ReadRollupSamples(DB_HANDLE hdb, int level, uint32_t dciId, time_t start, time_t end, SampleConsumer *consumer)
+{
+   if (start >= end)
+      return true;
+
+   TCHAR query[256];
+   _sntprintf(query, 256, _T("SELECT period_start,value_min,value_max,value_avg,sample_count FROM %s WHERE item_id=? AND period_start>=? AND period_start<? ORDER BY period_start"),
+            s_rollupLevels[level].table);
+   DB_STATEMENT hStmt = DBPrepare(hdb, query);
+   if (hStmt == nullptr)
+      return false;
+
+   DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, dciId);
+   DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, static_cast<int64_t>(start));
+   DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<int64_t>(end));
+   DB_UNBUFFERED_RESULT hResult = DBSelectPreparedUnbuffered(hStmt);
+   if (hResult != nullptr)
+   {
+      time_t halfPeriod = s_rollupLevels[level].period / 2;
+      while(DBFetch(hResult))
+      {
+         uint32_t count = DBGetFieldULong(hResult, 4);
+         consumer->addSample(static_cast<time_t>(DBGetFieldInt64(hResult, 0)) + halfPeriod,
+                  DBGetFieldDouble(hResult, 1), DBGetFieldDouble(hResult, 2), DBGetFieldDouble(hResult, 3) * count, count);
+      }
+      DBFreeResult(hResult);
+   }
+   DBFreeStatement(hStmt);
+   return hResult != nullptr;
+}
+
+/**
+ * Bucket aggregator constructor
+ */
+BucketAggregator::BucketAggregator(time_t start, time_t end, time_t bucketSize)
+{
+   m_start = start;
+   m_bucketSize = bucketSize;
+   m_bucketCount = static_cast<int>((end - start) / bucketSize) + 1;
+   m_buckets = MemAllocArray<AggregationBucket>(m_bucketCount);
+}
+
+/**
+ * Bucket aggregator destructor
+ */
+BucketAggregator::~BucketAggregator()
+{
+   MemFree(m_buckets);
+}
+
+/**
+ * Add sample to bucket aggregator
+ */
+void BucketAggregator::addSample(time_t timestamp, double minValue, double maxValue, double sum, uint32_t count)
+{
+   if (timestamp < m_start)
+      return;
+   int index = static_cast<int>((timestamp - m_start) / m_bucketSize);
+   if (index < m_bucketCount)
+      m_buckets[index].add(minValue, maxValue, sum, count);
+}
+
+/**
+ * Get aggregated points (one point per non-empty bucket, two points for DAM_MIN_MAX)
+ */
+void BucketAggregator::getResults(DataAggregationMode mode, StructArray<AggregatedDataPoint> *points)
+{
+   for(int i = 0; i < m_bucketCount; i++)
+   {
+      AggregationBucket *b = &m_buckets[i];
+      if (b->count == 0)
+         continue;
+
+      AggregatedDataPoint *p = points->addPlaceholder();
+      p->timestamp = m_start + m_bucketSize * i + m_bucketSize / 2;
+      switch(mode)
+      {
+         case DAM_MIN:
+            p->value = b->minValue;
+            break;
+         case DAM_MAX:
+            p->value = b->maxValue;
+            break;
+         case DAM_MIN_MAX:
+            // Two points per bucket so that graph shows full value envelope
+            p->value = b->minValue;
+            p = points->addPlaceholder();
+            p->timestamp = m_start + m_bucketSize * i + m_bucketSize / 2;
+            p->value = b->maxValue;
+            break;
+         default:
+            p->value = b->sum / b->count;
+            break;
+      }
+   }
+}
+
+/**
+ * Add sample to LTTB point collector
+ */
+void PointCollector::addSample(time_t timestamp, double minValue, double maxValue, double sum, uint32_t count)
+{
+   if (m_points.size() == m_maxPoints)
+   {
+      // Halve number of points by merging adjacent ones to keep memory usage bounded
+      int j = 0;
+      for(int i = 0; i < m_points.size() - 1; i += 2, j++)
+      {
+         AggregatedDataPoint *p1 = m_points.get(i);
+         AggregatedDataPoint *p2 = m_points.get(i + 1);
+         AggregatedDataPoint *d = m_points.get(j);
+         d->timestamp = p1->timestamp;
+         d->value = (p1->value + p2->value) / 2;
+      }
+      while(m_points.size() > j)
+         m_points.remove(m_points.size() - 1);
+   }
+
+   AggregatedDataPoint *p = m_points.addPlaceholder();
+   p->timestamp = timestamp;
+   p->value = sum / count;
+}
+
+/**
+ * Downsample collected points using Largest-Triangle-Three-Buckets algorithm
+ */
+void PointCollector::getResults(uint32_t threshold, StructArray<AggregatedDataPoint> *points)
+{
+   int size = m_points.size();
+   if (static_cast<uint32_t>(size) <= threshold)
+   {
+      points->addAll(m_points);
+      return;
+   }
+
+   // LTTB always keeps first and last points, so it cannot be used for less than 3 points
+   if (threshold < 3)
+   {
+      if (threshold > 0)
+         points->add(m_points.get(0));
+      if (threshold > 1)
+         points->add(m_points.get(size - 1));
+      return;
+   }
+
+   const AggregatedDataPoint *data = m_points.getBuffer();
+   double every = static_cast<double>(size - 2) / (threshold - 2);
+   int a = 0;
+   points->add(data[0]);
+   for(uint32_t i = 0; i < threshold - 2; i++)
+   {
+      // Average point of next bucket
+      int avgRangeStart = static_cast<int>((i + 1) * every) + 1;
+      int avgRangeEnd = std::min(static_cast<int>((i + 2) * every) + 1, size);
+      double avgX = 0, avgY = 0;
+      for(int j = avgRangeStart; j < avgRangeEnd; j++)
+      {
+         avgX += static_cast<double>(data[j].timestamp);
+         avgY += data[j].value;
+      }
+      int avgRangeLength = avgRangeEnd - avgRangeStart;
+      if (avgRangeLength > 0)
+      {
+         avgX /= avgRangeLength;
+         avgY /= avgRangeLength;
+      }
+
+      // Point in current bucket forming largest triangle with previously selected point and next bucket average
+      int rangeStart = static_cast<int>(i * every) + 1;
+      int rangeEnd = static_cast<int>((i + 1) * every) + 1;
+      double ax = static_cast<double>(data[a].timestamp);
+      double ay = data[a].value;
+      double maxArea = -1;
+      int next = rangeStart;
+      for(int j = rangeStart; j < rangeEnd; j++)
+      {
+         double area = fabs((ax - avgX) * (data[j].value - ay) - (ax - static_cast<double>(data[j].timestamp)) * (avgY - ay));
+         if (area > maxArea)
+         {
+            maxArea = area;
+            next = j;
+         }
+      }
+      points->add(data[next]);
+      a = next;
+   }
+   points->add(data[size - 1]);
+}
+
+/**
+ * Read aggregated DCI data for given time range (both ends inclusive). Resulting points are ordered by timestamp in
+ * ascending order. Pre-calculated rollups are used instead of raw data when requested resolution allows it.
+ */
+bool ReadAggregatedDCIData(const DataCollectionTarget& owner, const DCItem& dci, time_t timeFrom, time_t timeTo, uint32_t maxPoints,
+         DataAggregationMode mode, StructArray<AggregatedDataPoint> *points)
+{
+   if ((timeTo < timeFrom) || (maxPoints == 0))
+      return true;
+
+   time_t end = timeTo + 1;
+   time_t bucketSize = std::max(static_cast<time_t>(1), (end - timeFrom + maxPoints - 1) / static_cast<time_t>(maxPoints));
+   if (mode == DAM_MIN_MAX)
+      bucketSize *= 2;  // two points per bucket
+
+   SampleConsumer *consumer;
+   if (mode == DAM_LTTB)
+      consumer = new PointCollector();
+   else
+      consumer = new BucketAggregator(timeFrom, end, bucketSize);
+
+   DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+
+   // Select most coarse rollup level still providing enough points. Levels with retention time not covering
+   // range start are skipped because their records for start of the range are already deleted.
+   int level = -1;
+   if (ConfigReadBoolean(_T("DataCollection.Rollup.Enable"), false))
+   {
+      time_t now = time(nullptr);
+      int levelCount = static_cast<int>(sizeof(s_rollupLevels) / sizeof(s_rollupLevels[0]));
+      time_t resolution = (mode == DAM_LTTB) ? (end - timeFrom) / (static_cast<time_t>(maxPoints) * 4) : bucketSize;
+      for(int i = levelCount - 1; i >= 0; i--)
+      {
+         if ((s_rollupLevels[i].period <= resolution) && (timeFrom >= GetRollupRetentionStart(i, now)))
+         {
+            level = i;
+            break;
+         }
+      }
+
+      // If raw data for range start is already deleted as well, use most detailed rollup level still
+      // available even if it provides less points than requested
+      if ((level == -1) && (timeFrom < now - static_cast<time_t>(dci.getEffectiveRetentionTime()) * 86400))
+      {
+         for(int i = 0; i < levelCount; i++)
+         {
+            if (timeFrom >= GetRollupRetentionStart(i, now))
+            {
+               level = i;
+               break;
+            }
+         }
+      }
+   }
+
+   bool success;
+   time_t watermark = (level != -1) ? GetWatermark(hdb, dci.getId()) : 0;
+   time_t period = (level != -1) ? s_rollupLevels[level].period : 0;
+   time_t rollupStart = (level != -1) ? ((timeFrom + period - 1) / period) * period : 0;
+   if ((level != -1) && (watermark > rollupStart))
+   {
+      // Raw data for partial period at range start, then rollups up to watermark, then raw data after watermark
+      time_t rollupEnd = std::min(watermark, end);
+      nxlog_debug_tag(DEBUG_TAG, 6, _T("ReadAggregatedDCIData(%s [%u]): using rollup table %s for range ") INT64_FMT _T(" - ") INT64_FMT,
+               dci.getName().cstr(), dci.getId(), s_rollupLevels[level].table, static_cast<int64_t>(rollupStart), static_cast<int64_t>(rollupEnd));
+      success = ReadRawSamples(hdb, owner.getId(), dci, timeFrom, rollupStart, consumer) &&
+               ReadRollupSamples(hdb, level, dci.getId(), rollupStart, rollupEnd, consumer) &&
+               ReadRawSamples(hdb, owner.getId(), dci, rollupEnd, end, consumer);
+   }
+   else
+   {
+      success = ReadRawSamples(hdb, owner.getId(), dci, timeFrom, end, consumer);
+   }
+
+   DBConnectionPoolReleaseConnection(hdb);
+
+   if (success)
+   {
+      if (mode == DAM_LTTB)
+         static_cast<PointCollector*>(consumer)->getResults(maxPoints, points);
+      else
+         static_cast<BucketAggregator*>(consumer)->getResults(mode, points);
+   }
+   delete consumer;
+   return success;
+}
+
+/**
+ * Builder for rollup records. Expects samples ordered by timestamp.
+ */
+class RollupBuilder : public SampleConsumer
+{
+private:
+   uint32_t m_dciId;
+   DB_STATEMENT m_statements[2];
+   time_t m_periodStart[2];
+   AggregationBucket m_buckets[2];
+   int m_records;
+   bool m_success;
+
+   void flush(int level)
+   {
+      if (m_buckets[level].count == 0)
+         return;
+
+      DB_STATEMENT hStmt = m_statements[level];
+      DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, m_dciId);
+      DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, static_cast<int64_t>(m_periodStart[level]));
+      DBBind(hStmt, 3, DB_SQLTYPE_DOUBLE, m_buckets[level].minValue);
+      DBBind(hStmt, 4, DB_SQLTYPE_DOUBLE, m_buckets[level].maxValue);
+      DBBind(hStmt, 5, DB_SQLTYPE_DOUBLE, m_buckets[level].sum / m_buckets[level].count);
+      DBBind(hStmt, 6, DB_SQLTYPE_INTEGER, m_buckets[level].count);
+      if (!DBExecute(hStmt))
+         m_success = false;
+      m_buckets[level].reset();
+      m_records++;
+   }
+
+public:
+   RollupBuilder(uint32_t dciId, DB_STATEMENT hStmt5m, DB_STATEMENT hStmt1h)
+   {
+      m_dciId = dciId;
+      m_statements[0] = hStmt5m;
+      m_statements[1] = hStmt1h;
+      for(int i = 0; i < 2; i++)
+      {
+         m_periodStart[i] = 0;
+         m_buckets[i].reset();
+      }
+      m_records = 0;
+      m_success = true;
+   }
+
+   virtual void addSample(time_t timestamp, double minValue, double maxValue, double sum, uint32_t count) override
+   {
+      if (!m_success)
+         return;
+
+      for(int i = 0; i < 2; i++)
+      {
+         time_t periodStart = timestamp - timestamp % s_rollupLevels[i].period;
+         if (periodStart != m_periodStart[i])
+         {
+            flush(i);
+            m_periodStart[i] = periodStart;
+         }
+         m_buckets[i].add(minValue, maxValue, sum, count);
+      }
+   }
+
+   bool finish()
+   {
+      if (m_success)
+      {
+         flush(0);
+         flush(1);
+      }
+      return m_success;
+   }
+
+   int getRecordCount() const { return m_records; }
+};
+
+/**
+ * Update rollups for single DCI for given time range (start inclusive, end exclusive) and
+ * store new watermark in same transaction
+ */
+static bool UpdateDCIRollup(DB_HANDLE hdb, uint32_t ownerId, const DCItem& dci, time_t start, time_t end, time_t watermark)
+{
+   if (!DBBegin(hdb))
+      return false;
+
+   // Remove rollup records possibly left from interrupted run so that range can be safely recalculated
+   bool success = true;
+   for(int i = 0; (i < 2) && success; i++)
+   {
+      TCHAR query[256];
+      _sntprintf(query, 256, _T("DELETE FROM %s WHERE item_id=%u AND period_start>=") INT64_FMT _T(" AND period_start<") INT64_FMT,
+               s_rollupLevels[i].table, dci.getId(), static_cast<int64_t>(start), static_cast<int64_t>(end));
+      success = DBQuery(hdb, query);
+   }
+
+   if (success)
+   {
+      DB_STATEMENT hStmt5m = DBPrepare(hdb, _T("INSERT INTO dci_data_rollup_5m (item_id,period_start,value_min,value_max,value_avg,sample_count) VALUES (?,?,?,?,?,?)"), true);
+      DB_STATEMENT hStmt1h = DBPrepare(hdb, _T("INSERT INTO dci_data_rollup_1h (item_id,period_start,value_min,value_max,value_avg,sample_count) VALUES (?,?,?,?,?,?)"), true);
+      if ((hStmt5m != nullptr) && (hStmt1h != nullptr))
+      {
+         RollupBuilder builder(dci.getId(), hStmt5m, hStmt1h);
+         success = ReadRawSamples(hdb, ownerId, dci, start, end, &builder) && builder.finish();
+         if (success)
+            nxlog_debug_tag(DEBUG_TAG, 7, _T("%d rollup records created for DCI %s [%u]"), builder.getRecordCount(), dci.getName().cstr(), dci.getId());
+      }
+      else
+      {
+         success = false;
+      }
+      if (hStmt5m != nullptr)
+         DBFreeStatement(hStmt5m);
+      if (hStmt1h != nullptr)
+         DBFreeStatement(hStmt1h);
+   }
+
+   if (success)
+   {
+      static const TCHAR *columns[] = { _T("watermark"), nullptr };
+      DB_STATEMENT hStmt = DBPrepareMerge(hdb, _T("dci_rollup_watermarks"), _T("item_id"), dci.getId(), columns);
+      if (hStmt != nullptr)
+      {
+         DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, static_cast<int64_t>(watermark));
+         DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, dci.getId());
+         success = DBExecute(hStmt);
+         DBFreeStatement(hStmt);
+      }
+      else
+      {
+         success = false;
+      }
+   }
+
+   if (success)
+      success = DBCommit(hdb);
+   else
+      DBRollback(hdb);
+   return success;
+}
+
+/**
+ * Update rollups for all DCIs on given data collection target. Rollups for DCIs without watermark are calculated
+ * starting from raw data retention boundary. Rollups for last lateDataWindow seconds before watermark are recalculated
+ * to include data received with delay (like data from agent cache). Range is processed in chunks, each in separate
+ * transaction, so long backlog does not result in huge transactions. Returns false if housekeeper should be stopped.
+ */
+static bool UpdateRollupsForTarget(DB_HANDLE hdb, DataCollectionTarget *target, time_t now, time_t end, time_t lateDataWindow)
+{
+   unique_ptr<SharedObjectArray<DCObject>> dcObjects = target->getAllDCObjects();
+   for(int i = 0; i < dcObjects->size(); i++)
+   {
+      DCObject *dco = dcObjects->get(i);
+      if ((dco->getType() != DCO_TYPE_ITEM) || !dco->isDataStorageEnabled() || (static_cast<DCItem*>(dco)->getDataType() == DCI_DT_STRING))
+         continue;
+
+      time_t retentionBoundary = now - static_cast<time_t>(dco->getEffectiveRetentionTime()) * 86400;
+      retentionBoundary -= retentionBoundary % 3600;
+
+      time_t start = GetWatermark(hdb, dco->getId());
+      if (start != 0)
+         start -= lateDataWindow;
+      if (start < retentionBoundary)
+         start = retentionBoundary;
+
+      while(start < end)
+      {
+         time_t chunkEnd = std::min(start + ROLLUP_CHUNK_SIZE, end);
+         time_t watermark = std::max(chunkEnd, GetWatermark(hdb, dco->getId()));
+         if (!UpdateDCIRollup(hdb, target->getId(), *static_cast<DCItem*>(dco), start, chunkEnd, watermark))
+         {
+            nxlog_debug_tag(DEBUG_TAG, 4, _T("Cannot update rollups for DCI %s [%u] on %s [%u]"), dco->getName().cstr(), dco->getId(), target->getName(), target->getId());
+            break;
+         }
+         SetWatermark(dco->getId(), watermark);
+         start = chunkEnd;
+
+         if (!ThrottleHousekeeper())
+            return false;
+      }
+   }
+   return true;
+}
+
+/**
+ * Update DCI data rollups and remove expired rollup records. Called by housekeeper.
+ */
+void UpdateDCIDataRollups(DB_HANDLE hdb)
+{
+   time_t now = time(nullptr);
+   time_t end = now - now % 3600;   // Only complete hours are rolled up
+   time_t lateDataWindow = static_cast<time_t>(ConfigReadULong(_T("DataCollection.Rollup.LateDataWindow"), 24)) * 3600;
+
+   SharedObjectArray<NetObj> objects(1024, 1024);
+   g_idxAccessPointById.getObjects(&objects);
+   g_idxChassisById.getObjects(&objects);
+   g_idxClusterById.getObjects(&objects);
+   g_idxMobileDeviceById.getObjects(&objects);
+   g_idxNodeById.getObjects(&objects);
+   g_idxSensorById.getObjects(&objects);
+   for(int i = 0; i < objects.size(); i++)
+   {
+      if (!UpdateRollupsForTarget(hdb, static_cast<DataCollectionTarget*>(objects.get(i)), now, end, lateDataWindow))
+         return;
+   }
+
+   for(int i = 0; i < 2; i++)
+   {
+      TCHAR query[256];
+      _sntprintf(query, 256, _T("DELETE FROM %s WHERE period_start<") INT64_FMT, s_rollupLevels[i].table, static_cast<int64_t>(GetRollupRetentionStart(i, now)));
+      DBQuery(hdb, query);
+   }
+}
+
+/**
+ * Delete all rollup records for given DCI
+ */
+void DeleteDCIDataRollups(uint32_t dciId)
+{
+   TCHAR query[256];
+   for(int i = 0; i < 2; i++)
+   {
+      _sntprintf(query, 256, _T("DELETE FROM %s WHERE item_id=%u"), s_rollupLevels[i].table, dciId);
+      QueueSQLRequest(query);
+   }
+   _sntprintf(query, 256, _T("DELETE FROM dci_rollup_watermarks WHERE item_id=%u"), dciId);
+   QueueSQLRequest(query);
+
+   s_watermarkLock.lock();
+   s_watermarks.remove(dciId);
+   s_watermarkLock.unlock();
+}
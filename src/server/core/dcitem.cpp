@@ -32,23 +32,12 @@ static const TCHAR *s_paramNamesRearm[] = { _T("dciName"), _T("dciDescription"),
 /**
  * Create DCItem from another DCItem
  */
-DCItem::DCItem(const DCItem *src, bool shadowCopy) : DCObject(src, shadowCopy)
+DCItem::DCItem(const DCItem *src, bool shadowCopy) : DCObject(src, shadowCopy), m_cache(shadowCopy ? src->m_cache : ItemValueCache(src->m_dataType))
 {
    m_dataType = src->m_dataType;
    m_deltaCalculation = src->m_deltaCalculation;
 	m_sampleCount = src->m_sampleCount;
-   m_cacheSize = shadowCopy ? src->m_cacheSize : 0;
    m_requiredCacheSize = shadowCopy ? src->m_requiredCacheSize : 0;
-   if (m_cacheSize > 0)
-   {
-      m_ppValueCache = MemAllocArray<ItemValue*>(m_cacheSize);
-      for(uint32_t i = 0; i < m_cacheSize; i++)
-         m_ppValueCache[i] = new ItemValue(src->m_ppValueCache[i]);
-   }
-   else
-   {
-      m_ppValueCache = nullptr;
-   }
    m_tPrevValueTimeStamp = shadowCopy ? src->m_tPrevValueTimeStamp : 0;
    m_bCacheLoaded = shadowCopy ? src->m_bCacheLoaded : false;
 	m_nBaseUnits = src->m_nBaseUnits;
@@ -84,7 +73,7 @@ DCItem::DCItem(const DCItem *src, bool shadowCopy) : DCObject(src, shadowCopy)
  *    instance_retention_time,grace_period_start,related_object,polling_schedule_type,
  *    retention_type,polling_interval_src,retention_time_src,snmp_version,state_flags
  */
-DCItem::DCItem(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataCollectionOwner>& owner, bool useStartupDelay) : DCObject(owner)
+DCItem::DCItem(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataCollectionOwner>& owner, bool useStartupDelay) : DCObject(owner), m_cache(DCI_DT_NULL)
 {
    m_id = DBGetFieldULong(hResult, row, 0);
    m_name = DBGetFieldAsSharedString(hResult, row, 1);
@@ -100,9 +89,8 @@ DCItem::DCItem(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataC
    m_instanceName = DBGetFieldAsSharedString(hResult, row, 11);
    m_dwTemplateItemId = DBGetFieldULong(hResult, row, 12);
    m_thresholds = nullptr;
-   m_cacheSize = 0;
+   m_cache.setDataType(m_dataType);
    m_requiredCacheSize = 0;
-   m_ppValueCache = nullptr;
    m_tPrevValueTimeStamp = 0;
    m_bCacheLoaded = false;
    m_flags = DBGetFieldLong(hResult, row, 13);
@@ -168,15 +156,14 @@ DCItem::DCItem(UINT32 id, const TCHAR *name, int source, int dataType, BYTE sche
       const TCHAR *pollingInterval, BYTE retentionType, const TCHAR *retentionTime,
       const shared_ptr<DataCollectionOwner>& owner, const TCHAR *description, const TCHAR *systemTag)
 	: DCObject(id, name, source, scheduleType, pollingInterval, retentionType, retentionTime, owner,
-	      description, systemTag)
+	      description, systemTag), m_cache(dataType)
 {
    m_dataType = dataType;
    m_deltaCalculation = DCM_ORIGINAL_VALUE;
 	m_sampleCount = 0;
    m_thresholds = nullptr;
-   m_cacheSize = 0;
+   m_cache.setDataType(m_dataType);
    m_requiredCacheSize = 0;
-   m_ppValueCache = nullptr;
    m_tPrevValueTimeStamp = 0;
    m_bCacheLoaded = false;
 	m_nBaseUnits = DCI_BASEUNITS_OTHER;
@@ -191,14 +178,13 @@ DCItem::DCItem(UINT32 id, const TCHAR *name, int source, int dataType, BYTE sche
 /**
  * Create DCItem from import file
  */
-DCItem::DCItem(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& owner) : DCObject(config, owner)
+DCItem::DCItem(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& owner) : DCObject(config, owner), m_cache(DCI_DT_NULL)
 {
    m_dataType = (BYTE)config->getSubEntryValueAsInt(_T("dataType"));
    m_deltaCalculation = (BYTE)config->getSubEntryValueAsInt(_T("delta"));
    m_sampleCount = (BYTE)config->getSubEntryValueAsInt(_T("samples"));
-   m_cacheSize = 0;
+   m_cache.setDataType(m_dataType);
    m_requiredCacheSize = 0;
-   m_ppValueCache = nullptr;
    m_tPrevValueTimeStamp = 0;
    m_bCacheLoaded = false;
 	m_nBaseUnits = DCI_BASEUNITS_OTHER;
@@ -241,6 +227,19 @@ DCItem::~DCItem()
    clearCache();
 }
 
+/**
+ * Set data type. Cached values and thresholds are converted to new type.
+ */
+void DCItem::setDataType(int dataType)
+{
+   lock();
+   m_dataType = dataType;
+   m_cache.setDataType(m_dataType);
+   for(int i = 0; i < getThresholdCount(); i++)
+      m_thresholds->get(i)->setDataType(m_dataType);
+   unlock();
+}
+
 /**
  * Delete all thresholds
  */
@@ -256,11 +255,7 @@ void DCItem::deleteAllThresholds()
  */
 void DCItem::clearCache()
 {
-   for(uint32_t i = 0; i < m_cacheSize; i++)
-      delete m_ppValueCache[i];
-   MemFree(m_ppValueCache);
-   m_ppValueCache = nullptr;
-   m_cacheSize = 0;
+   m_cache.clear();
 }
 
 /**
@@ -410,7 +405,7 @@ bool DCItem::saveToDatabase(DB_HANDLE hdb)
       DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, m_id);
       DBBind(hStmt, 2, DB_SQLTYPE_TEXT, m_prevRawValue.getString(), DB_BIND_STATIC, 255);
       DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<int64_t>(m_tPrevValueTimeStamp));
-      DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<int64_t>((m_bCacheLoaded  && (m_cacheSize > 0)) ? m_ppValueCache[m_cacheSize - 1]->getTimeStamp() : 0));
+      DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<int64_t>((m_bCacheLoaded && (m_cache.size() > 0)) ? m_cache.getTimeStamp(m_cache.size() - 1) : 0));
       bResult = DBExecute(hStmt);
       DBFreeStatement(hStmt);
    }
@@ -434,7 +429,7 @@ void DCItem::checkThresholds(ItemValue &value)
    {
 		Threshold *t = m_thresholds->get(i);
       ItemValue checkValue, thresholdValue;
-      ThresholdCheckResult result = t->check(value, m_ppValueCache, checkValue, thresholdValue, owner, this);
+      ThresholdCheckResult result = t->check(value, m_cache, checkValue, thresholdValue, owner, this);
       t->setLastCheckedValue(checkValue);
       switch(result)
       {
@@ -537,6 +532,7 @@ void DCItem::deleteFromDatabase()
    _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("DELETE FROM thresholds WHERE item_id=%u"), m_id);
    QueueSQLRequest(query);
    QueueRawDciDataDelete(m_id);
+   DeleteDCIDataRollups(m_id);
 
    auto owner = m_owner.lock();
    if ((owner != nullptr) && owner->isDataCollectionTarget() && g_dbSyntax != DB_SYNTAX_TSDB)
@@ -553,6 +549,7 @@ void DCItem::updateFromMessage(const NXCPMessage& msg, uint32_t *numMaps, uint32
    lock();
 
    m_dataType = (BYTE)msg.getFieldAsUInt16(VID_DCI_DATA_TYPE);
+   m_cache.setDataType(m_dataType);
    m_deltaCalculation = (BYTE)msg.getFieldAsUInt16(VID_DCI_DELTA_CALCULATION);
 	m_sampleCount = msg.getFieldAsInt16(VID_SAMPLE_COUNT);
 	m_nBaseUnits = msg.getFieldAsUInt16(VID_BASE_UNITS);
@@ -689,7 +686,7 @@ bool DCItem::processNewValue(time_t tmTimeStamp, const TCHAR *originalValue, boo
 
    m_errorCount = 0;
 
-   if (isStatusDCO() && (tmTimeStamp > m_tPrevValueTimeStamp) && ((m_cacheSize == 0) || !m_bCacheLoaded || (pValue->getUInt32() != m_ppValueCache[0]->getUInt32())))
+   if (isStatusDCO() && (tmTimeStamp > m_tPrevValueTimeStamp) && ((m_cache.size() == 0) || !m_bCacheLoaded || (pValue->getUInt32() != m_cache.getLastUInt32())))
    {
       *updateStatus = true;
    }
@@ -700,14 +697,12 @@ bool DCItem::processNewValue(time_t tmTimeStamp, const TCHAR *originalValue, boo
       m_tPrevValueTimeStamp = tmTimeStamp;
 
       // Save raw value into database
-      QueueRawDciDataUpdate(tmTimeStamp, m_id, originalValue, pValue->getString(), (m_bCacheLoaded  && (m_cacheSize > 0)) ? m_ppValueCache[m_cacheSize - 1]->getTimeStamp() : 0);
+      QueueRawDciDataUpdate(tmTimeStamp, m_id, originalValue, pValue->getString(), (m_bCacheLoaded && (m_cache.size() > 0)) ? m_cache.getTimeStamp(m_cache.size() - 1) : 0);
    }
 
 	// Save transformed value to database
    if (m_retentionType != DC_RETENTION_NONE)
 	   QueueIDataInsert(tmTimeStamp, owner->getId(), m_id, originalValue, pValue->getString(), getStorageClass());
-   if (g_flags & AF_PERFDATA_STORAGE_DRIVER_LOADED)
-      PerfDataStorageRequest(this, tmTimeStamp, pValue->getString());
 
    // Update prediction engine
    if (m_predictionEngine[0] != 0)
@@ -749,37 +744,29 @@ bool DCItem::processNewValue(time_t tmTimeStamp, const TCHAR *originalValue, boo
       }
    }
 
-   if ((m_cacheSize > 0) && (tmTimeStamp >= m_tPrevValueTimeStamp))
+   if ((m_cache.size() > 0) && (tmTimeStamp >= m_tPrevValueTimeStamp))
    {
-      delete m_ppValueCache[m_cacheSize - 1];
-      memmove(&m_ppValueCache[1], m_ppValueCache, sizeof(ItemValue *) * (m_cacheSize - 1));
-      m_ppValueCache[0] = pValue;
+      m_cache.push(*pValue);
       m_lastValueTimestamp = tmTimeStamp;
    }
    else if (!m_bCacheLoaded && (m_requiredCacheSize == 1))
    {
       // If required cache size is 1 and we got value before cache loader
       // loads DCI cache then update it directly
-      for(uint32_t i = 0; i < m_cacheSize; i++)
-         delete m_ppValueCache[i];
-
-      if (m_cacheSize != m_requiredCacheSize)
-      {
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_requiredCacheSize);
-         m_cacheSize = m_requiredCacheSize;
-      }
-
-      m_ppValueCache[0] = pValue;
+      m_cache.reset(m_requiredCacheSize);
+      m_cache.set(0, *pValue);
       m_bCacheLoaded = true;
       m_lastValueTimestamp = tmTimeStamp;
    }
-   else
-   {
-      delete pValue;
-   }
 
    unlock();
 
+   // Request to performance data storage drivers is made with DCI unlocked
+   // because it may block until driver's request queue has free space
+   if (g_flags & AF_PERFDATA_STORAGE_DRIVER_LOADED)
+      PerfDataStorageRequest(this, tmTimeStamp, pValue->getString());
+
+   delete pValue;
    return true;
 }
 
@@ -880,14 +867,14 @@ void DCItem::generateEventsBasedOnThrDiff()
             PostDciEventWithNames(t->getEventCode(), ownerId, m_id, "ssssisds",
                               s_paramNamesReach, m_name.cstr(), m_description.cstr(), t->getStringValue(),
                               t->getLastCheckValue().getString(), m_id, m_instanceName.cstr(), 0,
-                              (m_bCacheLoaded && (m_cacheSize > 0)) ? m_ppValueCache[0]->getString() : _T(""));
+                              (m_bCacheLoaded && (m_cache.size() > 0)) ? m_cache.getLastString() : _T(""));
          }
          else
          {
             PostDciEventWithNames(t->getRearmEventCode(), ownerId, m_id, "ssissss",
                               s_paramNamesRearm, m_name.cstr(), m_description.cstr(), m_id, m_instanceName.cstr(), t->getStringValue(),
                               t->getLastCheckValue().getString(),
-                              (m_bCacheLoaded && (m_cacheSize > 0)) ? m_ppValueCache[0]->getString() : _T(""));
+                              (m_bCacheLoaded && (m_cache.size() > 0)) ? m_cache.getLastString() : _T(""));
          }
       }
    }
@@ -1137,37 +1124,22 @@ void DCItem::updateCacheSizeInternal(bool allowLoad, uint32_t conditionId)
    }
 
    nxlog_debug_tag(_T("obj.dc.cache"), 8, _T("DCItem::updateCacheSizeInternal(dci=\"%s\", node=%s [%d]): requiredSize=%d cacheSize=%d"),
-            m_name.cstr(), owner->getName(), owner->getId(), m_requiredCacheSize, m_cacheSize);
+            m_name.cstr(), owner->getName(), owner->getId(), m_requiredCacheSize, m_cache.size());
 
    // Update cache if needed
-   if (m_requiredCacheSize < m_cacheSize)
+   if (m_requiredCacheSize < m_cache.size())
    {
       // Destroy unneeded values
-      if (m_cacheSize > 0)
-		{
-         for(uint32_t i = m_requiredCacheSize; i < m_cacheSize; i++)
-            delete m_ppValueCache[i];
-		}
-
-      m_cacheSize = m_requiredCacheSize;
-      if (m_cacheSize > 0)
-      {
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_cacheSize);
-      }
-      else
-      {
-         MemFree(m_ppValueCache);
-         m_ppValueCache = nullptr;
-      }
+      m_cache.resize(m_requiredCacheSize);
    }
-   else if (m_requiredCacheSize > m_cacheSize)
+   else if (m_requiredCacheSize > m_cache.size())
    {
       // Load missing values from database
       // Skip caching for DCIs where estimated time to fill the cache is less then 5 minutes
       // to reduce load on database at server startup
       if (allowLoad &&
           (m_ownerId != 0) &&
-          (((m_requiredCacheSize - m_cacheSize) * getEffectivePollingInterval() > 300) ||
+          (((m_requiredCacheSize - m_cache.size()) * getEffectivePollingInterval() > 300) ||
            (m_source == DS_PUSH_AGENT) ||
            (m_pollingScheduleType == DC_POLLING_SCHEDULE_ADVANCED)))
       {
@@ -1177,11 +1149,8 @@ void DCItem::updateCacheSizeInternal(bool allowLoad, uint32_t conditionId)
       else
       {
          // will not read data from database, fill cache with empty values
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_requiredCacheSize);
-         for(uint32_t i = m_cacheSize; i < m_requiredCacheSize; i++)
-            m_ppValueCache[i] = new ItemValue(_T(""), 1);
+         m_cache.resize(m_requiredCacheSize);
          DbgPrintf(7, _T("Cache load skipped for parameter %s [%u]"), m_name.cstr(), m_id);
-         m_cacheSize = m_requiredCacheSize;
          m_bCacheLoaded = true;
       }
    }
@@ -1201,7 +1170,7 @@ void DCItem::loadCache()
 void DCItem::reloadCache(bool forceReload)
 {
    lock();
-   if (!forceReload && m_bCacheLoaded && (m_cacheSize == m_requiredCacheSize))
+   if (!forceReload && m_bCacheLoaded && (m_cache.size() == m_requiredCacheSize))
    {
       unlock();
       return;  // Cache already fully populated
@@ -1302,55 +1271,31 @@ void DCItem::reloadCache(bool forceReload)
 
    // While reload request was in queue DCI cache may have been already filled
    lock();
-   if (forceReload || !m_bCacheLoaded || (m_cacheSize != m_requiredCacheSize))
+   if (forceReload || !m_bCacheLoaded || (m_cache.size() != m_requiredCacheSize))
    {
-      for(uint32_t i = 0; i < m_cacheSize; i++)
-         delete m_ppValueCache[i];
-
-      if (m_cacheSize != m_requiredCacheSize)
-      {
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_requiredCacheSize);
-      }
-
       nxlog_debug_tag(_T("obj.dc.cache"), 8, _T("DCItem::reloadCache(dci=\"%s\", node=%s [%d]): requiredSize=%d cacheSize=%d"),
-               m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize, m_cacheSize);
+               m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize, m_cache.size());
+
+      // Start with cache filled with empty values
+      m_cache.reset(m_requiredCacheSize);
       if (hResult != nullptr)
       {
          // Create cache entries
-         bool moreData = true;
          uint32_t i;
-         for(i = 0; (i < m_requiredCacheSize) && moreData; i++)
+         for(i = 0; (i < m_requiredCacheSize) && DBFetch(hResult); i++)
          {
-            moreData = DBFetch(hResult);
-            if (moreData)
-            {
-               DBGetField(hResult, 0, szBuffer, MAX_DB_STRING);
-               m_ppValueCache[i] = new ItemValue(szBuffer, DBGetFieldULong(hResult, 1));
-            }
-            else
-            {
-               m_ppValueCache[i] = new ItemValue(_T(""), 1);   // Empty value
-            }
+            DBGetField(hResult, 0, szBuffer, MAX_DB_STRING);
+            m_cache.set(i, ItemValue(szBuffer, DBGetFieldULong(hResult, 1)));
          }
 
-         // Fill up cache with empty values if we don't have enough values in database
          if (i < m_requiredCacheSize)
          {
             nxlog_debug_tag(_T("obj.dc.cache"), 8, _T("DCItem::reloadCache(dci=\"%s\", node=%s [%d]): %d values missing in DB"),
                      m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize - i);
-            for(; i < m_requiredCacheSize; i++)
-               m_ppValueCache[i] = new ItemValue(_T(""), 1);
          }
          DBFreeResult(hResult);
       }
-      else
-      {
-         // Error reading data from database, fill cache with empty values
-         for(uint32_t i = 0; i < m_requiredCacheSize; i++)
-            m_ppValueCache[i] = new ItemValue(_T(""), 1);
-      }
 
-      m_cacheSize = m_requiredCacheSize;
       m_bCacheLoaded = true;
    }
    else if (hResult != nullptr)
@@ -1368,7 +1313,7 @@ void DCItem::reloadCache(bool forceReload)
 uint64_t DCItem::getCacheMemoryUsage() const
 {
    lock();
-   uint64_t size = m_cacheSize * (sizeof(ItemValue) + sizeof(ItemValue*));
+   uint64_t size = m_cache.getMemoryUsage();
    unlock();
    return size;
 }
@@ -1380,12 +1325,12 @@ void DCItem::fillLastValueMessage(NXCPMessage *msg)
 {
    lock();
    msg->setField(VID_DCI_SOURCE_TYPE, m_source);
-   if (m_cacheSize > 0)
+   if (m_cache.size() > 0)
    {
       msg->setField(VID_DCI_DATA_TYPE, static_cast<uint16_t>(m_dataType));
-      msg->setField(VID_VALUE, m_ppValueCache[0]->getString());
+      msg->setField(VID_VALUE, m_cache.getLastString());
       msg->setField(VID_RAW_VALUE, m_prevRawValue.getString());
-      msg->setFieldFromTime(VID_TIMESTAMP, m_ppValueCache[0]->getTimeStamp());
+      msg->setFieldFromTime(VID_TIMESTAMP, m_cache.getTimeStamp(0));
    }
    else
    {
@@ -1409,11 +1354,11 @@ void DCItem::fillLastValueSummaryMessage(NXCPMessage *msg, uint32_t baseId, cons
    msg->setField(baseId++, m_flags);
    msg->setField(baseId++, m_description);
    msg->setField(baseId++, static_cast<uint16_t>(m_source));
-   if (m_cacheSize > 0)
+   if (m_cache.size() > 0)
    {
       msg->setField(baseId++, static_cast<uint16_t>(m_dataType));
-      msg->setField(baseId++, m_ppValueCache[0]->getString());
-      msg->setFieldFromTime(baseId++, m_ppValueCache[0]->getTimeStamp());
+      msg->setField(baseId++, m_cache.getLastString());
+      msg->setFieldFromTime(baseId++, m_cache.getTimeStamp(0));
    }
    else
    {
@@ -1494,13 +1439,13 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
    {
       case F_LAST:
          // cache placeholders will have timestamp 1
-         pValue = (m_bCacheLoaded && (m_cacheSize > 0) && (m_ppValueCache[0]->getTimeStamp() != 1)) ? vm->createValue(m_ppValueCache[0]->getString()) : vm->createValue();
+         pValue = (m_bCacheLoaded && (m_cache.size() > 0) && !m_cache.isPlaceholder(0)) ? vm->createValue(m_cache.getLastString()) : vm->createValue();
          break;
       case F_DIFF:
-         if (m_bCacheLoaded && (m_cacheSize >= 2))
+         if (m_bCacheLoaded && (m_cache.size() >= 2))
          {
             ItemValue result;
-            CalculateItemValueDiff(&result, m_dataType, *m_ppValueCache[0], *m_ppValueCache[1]);
+            CalculateItemValueDiff(&result, m_dataType, m_cache.get(0), m_cache.get(1));
             pValue = vm->createValue(result.getString());
          }
          else
@@ -1509,10 +1454,10 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
          }
          break;
       case F_AVERAGE:
-         if (m_bCacheLoaded && (m_cacheSize > 0))
+         if (m_bCacheLoaded && (m_cache.size() > 0))
          {
             ItemValue result;
-            CalculateItemValueAverage(&result, m_dataType, m_ppValueCache, std::min(m_cacheSize, static_cast<uint32_t>(sampleCount)));
+            CalculateItemValueAverage(&result, m_dataType, m_cache, static_cast<uint32_t>(sampleCount));
             pValue = vm->createValue(result.getString());
          }
          else
@@ -1521,10 +1466,10 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
          }
          break;
       case F_MEAN_DEVIATION:
-         if (m_bCacheLoaded && (m_cacheSize > 0))
+         if (m_bCacheLoaded && (m_cache.size() > 0))
          {
             ItemValue result;
-            CalculateItemValueMeanDeviation(&result, m_dataType, m_ppValueCache, std::min(m_cacheSize, static_cast<uint32_t>(sampleCount)));
+            CalculateItemValueMeanDeviation(&result, m_dataType, m_cache, static_cast<uint32_t>(sampleCount));
             pValue = vm->createValue(result.getString());
          }
          else
@@ -1544,12 +1489,12 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
 }
 
 /**
- * Get last value
+ * Get copy of last value (empty string if there are no collected values)
  */
-const TCHAR *DCItem::getLastValue()
+String DCItem::getLastValue()
 {
    lock();
-   const TCHAR *v = (m_cacheSize > 0) ? (const TCHAR *)m_ppValueCache[0]->getString() : nullptr;
+   String v(m_cache.getLastString());
    unlock();
    return v;
 }
@@ -1560,7 +1505,7 @@ const TCHAR *DCItem::getLastValue()
 ItemValue *DCItem::getInternalLastValue()
 {
    lock();
-   ItemValue *v = (m_cacheSize > 0) ? new ItemValue(m_ppValueCache[0]) : nullptr;
+   ItemValue *v = (m_cache.size() > 0) ? new ItemValue(m_cache.get(0)) : nullptr;
    unlock();
    return v;
 }
@@ -1704,6 +1649,9 @@ bool DCItem::deleteAllData()
    unlock();
 
    DBConnectionPoolReleaseConnection(hdb);
+
+   if (success)
+      DeleteDCIDataRollups(m_id);
 	return success;
 }
 
@@ -1742,17 +1690,8 @@ bool DCItem::deleteEntry(time_t timestamp)
       return false;
 
    lock();
-   for(UINT32 i = 0; i < m_cacheSize; i++)
-   {
-      if (m_ppValueCache[i]->getTimeStamp() == timestamp)
-      {
-         delete m_ppValueCache[i];
-         memmove(&m_ppValueCache[i], &m_ppValueCache[i + 1], sizeof(ItemValue *) * (m_cacheSize - (i + 1)));
-         m_cacheSize--;
-         updateCacheSizeInternal(true);
-         break;
-      }
-   }
+   if (m_cache.remove(timestamp))
+      updateCacheSizeInternal(true);
    unlock();
 
    return success;
@@ -1775,6 +1714,7 @@ void DCItem::updateFromTemplate(DCObject *src)
 	DCItem *item = (DCItem *)src;
 
    m_dataType = item->m_dataType;
+   m_cache.setDataType(m_dataType);
    m_deltaCalculation = item->m_deltaCalculation;
    m_sampleCount = item->m_sampleCount;
    m_snmpRawValueType = item->m_snmpRawValueType;
@@ -2099,6 +2039,7 @@ void DCItem::updateFromImport(ConfigEntry *config)
 
    lock();
    m_dataType = (BYTE)config->getSubEntryValueAsInt(_T("dataType"));
+   m_cache.setDataType(m_dataType);
    m_deltaCalculation = (BYTE)config->getSubEntryValueAsInt(_T("delta"));
    m_sampleCount = (BYTE)config->getSubEntryValueAsInt(_T("samples"));
    m_snmpRawValueType = (WORD)config->getSubEntryValueAsInt(_T("snmpRawValueType"));
@@ -2191,12 +2132,8 @@ void DCItem::recalculateValue(ItemValue &value)
       m_tPrevValueTimeStamp = value.getTimeStamp();
    }
 
-   if ((m_cacheSize > 0) && (value.getTimeStamp() >= m_tPrevValueTimeStamp))
-   {
-      delete m_ppValueCache[m_cacheSize - 1];
-      memmove(&m_ppValueCache[1], m_ppValueCache, sizeof(ItemValue *) * (m_cacheSize - 1));
-      m_ppValueCache[0] = new ItemValue(&value);
-   }
+   if ((m_cache.size() > 0) && (value.getTimeStamp() >= m_tPrevValueTimeStamp))
+      m_cache.push(value);
 
    m_lastPoll = value.getTimeStamp();
 }
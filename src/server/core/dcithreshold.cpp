@@ -247,20 +247,20 @@ BOOL Threshold::saveToDB(DB_HANDLE hdb, UINT32 dwIndex)
  *    THRESHOLD_REARMED - when item's value doesn't match the threshold condition while previous check do
  *    NO_ACTION - when there are no changes in item's value match to threshold's condition
  */
-ThresholdCheckResult Threshold::check(ItemValue &value, ItemValue **ppPrevValues, ItemValue &fvalue, ItemValue &tvalue, shared_ptr<NetObj> target, DCItem *dci)
+ThresholdCheckResult Threshold::check(ItemValue &value, const ItemValueCache& prevValues, ItemValue &fvalue, ItemValue &tvalue, shared_ptr<NetObj> target, DCItem *dci)
 {
    // check if there is enough cached data
    switch(m_function)
    {
       case F_DIFF:
-         if (ppPrevValues[0]->getTimeStamp() == 1) // Timestamp 1 means placeholder value inserted by cache loader
+         if (prevValues.isPlaceholder(0))
             return m_isReached ? ThresholdCheckResult::ALREADY_ACTIVE : ThresholdCheckResult::ALREADY_INACTIVE;
          break;
       case F_AVERAGE:
       case F_SUM:
       case F_MEAN_DEVIATION:
          for(int i = 0; i < m_sampleCount - 1; i++)
-            if (ppPrevValues[i]->getTimeStamp() == 1) // Timestamp 1 means placeholder value inserted by cache loader
+            if (prevValues.isPlaceholder(i))
                return m_isReached ? ThresholdCheckResult::ALREADY_ACTIVE : ThresholdCheckResult::ALREADY_INACTIVE;
          break;
       default:
@@ -278,19 +278,19 @@ ThresholdCheckResult Threshold::check(ItemValue &value, ItemValue **ppPrevValues
          fvalue = value;
          break;
       case F_AVERAGE:      // Check average value for last n polls
-         calculateAverage(&fvalue, value, ppPrevValues);
+         calculateAverage(&fvalue, value, prevValues);
          break;
 		case F_SUM:
-         calculateTotal(&fvalue, value, ppPrevValues);
+         calculateTotal(&fvalue, value, prevValues);
 			break;
       case F_MEAN_DEVIATION:    // Check mean absolute deviation
-         calculateMeanDeviation(&fvalue, value, ppPrevValues);
+         calculateMeanDeviation(&fvalue, value, prevValues);
          break;
       case F_ABS_DEVIATION:    // Check absolute deviation for last point
-         calculateAbsoluteDeviation(&fvalue, value, ppPrevValues);
+         calculateAbsoluteDeviation(&fvalue, value, prevValues);
          break;
       case F_DIFF:
-         CalculateItemValueDiff(&fvalue, m_dataType, value, *ppPrevValues[0]);
+         CalculateItemValueDiff(&fvalue, m_dataType, value, prevValues.get(0));
          switch(m_dataType)
          {
             case DCI_DT_STRING:
@@ -638,18 +638,17 @@ void Threshold::updateFromMessage(const NXCPMessage& msg, uint32_t baseId)
 /**
  * Calculate average value for values of given type
  */
-template<typename T> static T CalculateAverage(const ItemValue &lastValue, ItemValue **prevValues, int sampleCount)
+template<typename T> static T CalculateAverage(const ItemValue &lastValue, const ItemValueCache& prevValues, int sampleCount)
 {
    T sum = static_cast<T>(lastValue);
-   for(int i = 1; i < sampleCount; i++)
-      sum += static_cast<T>(*prevValues[i - 1]);
+   prevValues.forEach<T>(sampleCount - 1, false, [&sum] (T v) { sum += v; });
    return sum / static_cast<T>(sampleCount);
 }
 
 /**
  * Calculate average value for metric
  */
-void Threshold::calculateAverage(ItemValue *result, const ItemValue &lastValue, ItemValue **prevValues)
+void Threshold::calculateAverage(ItemValue *result, const ItemValue &lastValue, const ItemValueCache& prevValues)
 {
    switch(m_dataType)
    {
@@ -681,18 +680,17 @@ void Threshold::calculateAverage(ItemValue *result, const ItemValue &lastValue,
 /**
  * Calculate sum value for values of given type
  */
-template<typename T> static T CalculateSum(const ItemValue &lastValue, ItemValue **prevValues, int sampleCount)
+template<typename T> static T CalculateSum(const ItemValue &lastValue, const ItemValueCache& prevValues, int sampleCount)
 {
    T sum = static_cast<T>(lastValue);
-   for(int i = 1; i < sampleCount; i++)
-      sum += static_cast<T>(*prevValues[i - 1]);
+   prevValues.forEach<T>(sampleCount - 1, false, [&sum] (T v) { sum += v; });
    return sum;
 }
 
 /**
  * Calculate sum value for metric
  */
-void Threshold::calculateTotal(ItemValue *result, const ItemValue &lastValue, ItemValue **prevValues)
+void Threshold::calculateTotal(ItemValue *result, const ItemValue &lastValue, const ItemValueCache& prevValues)
 {
    switch(m_dataType)
    {
@@ -724,19 +722,13 @@ void Threshold::calculateTotal(ItemValue *result, const ItemValue &lastValue, It
 /**
  * Calculate mean absolute deviation for values of given type
  */
-template<typename T, T (*ABS)(T)> static T CalculateMeanDeviation(const ItemValue& lastValue, ItemValue **prevValues, int sampleCount)
+template<typename T, T (*ABS)(T)> static T CalculateMeanDeviation(const ItemValue& lastValue, const ItemValueCache& prevValues, int sampleCount)
 {
    T mean = static_cast<T>(lastValue);
-   for(int i = 1; i < sampleCount; i++)
-   {
-      mean += static_cast<T>(*prevValues[i - 1]);
-   }
+   prevValues.forEach<T>(sampleCount - 1, false, [&mean] (T v) { mean += v; });
    mean /= static_cast<T>(sampleCount);
    T dev = ABS(static_cast<T>(lastValue) - mean);
-   for(int i = 1; i < sampleCount; i++)
-   {
-      dev += ABS(static_cast<T>(*prevValues[i - 1]) - mean);
-   }
+   prevValues.forEach<T>(sampleCount - 1, false, [&dev, mean] (T v) { dev += ABS(v - mean); });
    return dev / static_cast<T>(sampleCount);
 }
 
@@ -775,7 +767,7 @@ static uint64_t noop64(uint64_t v)
 /**
  * Calculate mean absolute deviation for metric
  */
-void Threshold::calculateMeanDeviation(ItemValue *result, const ItemValue &lastValue, ItemValue **prevValues)
+void Threshold::calculateMeanDeviation(ItemValue *result, const ItemValue &lastValue, const ItemValueCache& prevValues)
 {
    switch(m_dataType)
    {
@@ -807,13 +799,10 @@ void Threshold::calculateMeanDeviation(ItemValue *result, const ItemValue &lastV
 /**
  * Calculate mean absolute deviation for values of given type
  */
-template<typename T, T (*ABS)(T)> static T CalculateAbsoluteDeviation(const ItemValue& lastValue, ItemValue **prevValues, int sampleCount)
+template<typename T, T (*ABS)(T)> static T CalculateAbsoluteDeviation(const ItemValue& lastValue, const ItemValueCache& prevValues, int sampleCount)
 {
    T mean = static_cast<T>(lastValue);
-   for(int i = 1; i < sampleCount; i++)
-   {
-      mean += static_cast<T>(*prevValues[i - 1]);
-   }
+   prevValues.forEach<T>(sampleCount - 1, false, [&mean] (T v) { mean += v; });
    mean /= static_cast<T>(sampleCount);
    return ABS(static_cast<T>(lastValue) - mean);
 }
@@ -821,7 +810,7 @@ template<typename T, T (*ABS)(T)> static T CalculateAbsoluteDeviation(const Item
 /**
  * Calculate absolute deviation for metric
  */
-void Threshold::calculateAbsoluteDeviation(ItemValue *result, const ItemValue &lastValue, ItemValue **prevValues)
+void Threshold::calculateAbsoluteDeviation(ItemValue *result, const ItemValue &lastValue, const ItemValueCache& prevValues)
 {
    switch(m_dataType)
    {
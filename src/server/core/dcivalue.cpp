@@ -359,6 +359,97 @@ void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const Item
    }
 }
 
+/**
+ * Calculate average value for cached values of given type
+ */
+template<typename T> static T CalculateAverage(const ItemValueCache& cache, uint32_t sampleCount)
+{
+   T sum = 0;
+   int count = 0;
+   cache.forEach<T>(sampleCount, true, [&sum, &count] (T v) { sum += v; count++; });
+   return (count > 0) ? sum / static_cast<T>(count) : 0;
+}
+
+/**
+ * Calculate average value for cached values
+ */
+void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValueCache& cache, uint32_t sampleCount)
+{
+   switch(dataType)
+   {
+      case DCI_DT_INT:
+         *result = CalculateAverage<int32_t>(cache, sampleCount);
+         break;
+      case DCI_DT_UINT:
+      case DCI_DT_COUNTER32:
+         *result = CalculateAverage<uint32_t>(cache, sampleCount);
+         break;
+      case DCI_DT_INT64:
+         *result = CalculateAverage<int64_t>(cache, sampleCount);
+         break;
+      case DCI_DT_UINT64:
+      case DCI_DT_COUNTER64:
+         *result = CalculateAverage<uint64_t>(cache, sampleCount);
+         break;
+      case DCI_DT_FLOAT:
+         *result = CalculateAverage<double>(cache, sampleCount);
+         break;
+      case DCI_DT_STRING:
+         *result = _T("");   // Average value for string is meaningless
+         break;
+      default:
+         break;
+   }
+}
+
+/**
+ * Calculate mean absolute deviation for cached values of given type
+ */
+template<typename T, T (*ABS)(T)> static T CalculateMeanDeviation(const ItemValueCache& cache, uint32_t sampleCount)
+{
+   T mean = 0;
+   int count = 0;
+   cache.forEach<T>(sampleCount, true, [&mean, &count] (T v) { mean += v; count++; });
+   if (count == 0)
+      return 0;
+   mean /= static_cast<T>(count);
+   T dev = 0;
+   cache.forEach<T>(sampleCount, true, [&dev, mean] (T v) { dev += ABS(v - mean); });
+   return dev / static_cast<T>(count);
+}
+
+/**
+ * Calculate mean absolute deviation for cached values
+ */
+void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const ItemValueCache& cache, uint32_t sampleCount)
+{
+   switch(dataType)
+   {
+      case DCI_DT_INT:
+         *result = CalculateMeanDeviation<int32_t, abs32>(cache, sampleCount);
+         break;
+      case DCI_DT_UINT:
+      case DCI_DT_COUNTER32:
+         *result = CalculateMeanDeviation<uint32_t, noop32>(cache, sampleCount);
+         break;
+      case DCI_DT_INT64:
+         *result = CalculateMeanDeviation<int64_t, abs64>(cache, sampleCount);
+         break;
+      case DCI_DT_UINT64:
+      case DCI_DT_COUNTER64:
+         *result = CalculateMeanDeviation<uint64_t, noop64>(cache, sampleCount);
+         break;
+      case DCI_DT_FLOAT:
+         *result = CalculateMeanDeviation<double, fabs>(cache, sampleCount);
+         break;
+      case DCI_DT_STRING:
+         *result = _T("");   // Mean deviation for string is meaningless
+         break;
+      default:
+         break;
+   }
+}
+
 /**
  * Calculate min value for values of given type
  */
@@ -466,3 +557,346 @@ void CalculateItemValueMax(ItemValue *result, int nDataType, const ItemValue * c
          break;
    }
 }
+
+/**
+ * Create empty value cache for given data type
+ */
+ItemValueCache::ItemValueCache(int dataType)
+{
+   m_values.ptr = nullptr;
+   m_timestamps = nullptr;
+   m_baseTimestamp = 0;
+   m_lastValue = nullptr;
+   m_size = 0;
+   m_head = 0;
+   m_dataType = dataType;
+}
+
+/**
+ * Copy constructor
+ */
+ItemValueCache::ItemValueCache(const ItemValueCache& src)
+{
+   m_size = src.m_size;
+   m_head = src.m_head;
+   m_dataType = src.m_dataType;
+   m_baseTimestamp = src.m_baseTimestamp;
+   m_lastValue = MemCopyString(src.m_lastValue);
+   if (m_size > 0)
+   {
+      m_timestamps = MemCopyBlock(src.m_timestamps, m_size * sizeof(int32_t));
+      if (isNumeric())
+      {
+         m_values.ptr = MemCopyBlock(src.m_values.ptr, elementSize() * m_size);
+      }
+      else
+      {
+         m_values.s = MemAllocArrayNoInit<TCHAR*>(m_size);
+         for(uint32_t i = 0; i < m_size; i++)
+            m_values.s[i] = MemCopyString(src.m_values.s[i]);
+      }
+   }
+   else
+   {
+      m_values.ptr = nullptr;
+      m_timestamps = nullptr;
+   }
+}
+
+/**
+ * Destructor
+ */
+ItemValueCache::~ItemValueCache()
+{
+   clear();
+}
+
+/**
+ * Get size of single value element
+ */
+size_t ItemValueCache::elementSize() const
+{
+   switch(m_dataType)
+   {
+      case DCI_DT_INT:
+      case DCI_DT_UINT:
+      case DCI_DT_COUNTER32:
+         return sizeof(int32_t);
+      case DCI_DT_INT64:
+      case DCI_DT_UINT64:
+      case DCI_DT_COUNTER64:
+         return sizeof(int64_t);
+      case DCI_DT_FLOAT:
+         return sizeof(double);
+      default:
+         return sizeof(TCHAR*);
+   }
+}
+
+/**
+ * Reallocate storage for new size, preserving existing values in order (optionally skipping one
+ * element). Missing elements are filled with placeholders.
+ */
+void ItemValueCache::reallocate(uint32_t size, uint32_t skipIndex)
+{
+   size_t esize = elementSize();
+   void *values = (size > 0) ? MemAllocZeroed(esize * size) : nullptr;
+   int32_t *timestamps = (size > 0) ? MemAllocArrayNoInit<int32_t>(size) : nullptr;
+
+   uint32_t count = 0;
+   for(uint32_t i = 0; i < m_size; i++)
+   {
+      uint32_t p = position(i);
+      if ((i != skipIndex) && (count < size))
+      {
+         memcpy(static_cast<BYTE*>(values) + count * esize, static_cast<BYTE*>(m_values.ptr) + p * esize, esize);
+         timestamps[count++] = m_timestamps[p];
+      }
+      else if (!isNumeric())
+      {
+         MemFree(m_values.s[p]);
+      }
+   }
+   for(uint32_t i = count; i < size; i++)
+      timestamps[i] = PLACEHOLDER;
+
+   MemFree(m_values.ptr);
+   MemFree(m_timestamps);
+   m_values.ptr = values;
+   m_timestamps = timestamps;
+   m_size = size;
+   m_head = 0;
+
+   if ((skipIndex == 0) || (size == 0))
+      updateLastValue();
+}
+
+/**
+ * Re-create string representation of most recent value (only used for numeric types)
+ */
+void ItemValueCache::updateLastValue()
+{
+   MemFreeAndNull(m_lastValue);
+   if (isNumeric() && (m_size > 0) && (m_timestamps[m_head] != PLACEHOLDER))
+      m_lastValue = MemCopyString(get(0).getString());
+}
+
+/**
+ * Encode timestamp as offset from base timestamp
+ */
+int32_t ItemValueCache::encodeTimeStamp(time_t timestamp)
+{
+   if (timestamp == 1)
+      return PLACEHOLDER;
+
+   if (m_baseTimestamp == 0)
+      m_baseTimestamp = timestamp;
+
+   int64_t offset = static_cast<int64_t>(timestamp) - static_cast<int64_t>(m_baseTimestamp);
+   if ((offset > INT32_MAX) || (offset <= INT32_MIN))
+   {
+      // Move base timestamp and re-encode existing entries (clamping ones that are too far)
+      for(uint32_t i = 0; i < m_size; i++)
+      {
+         if (m_timestamps[i] == PLACEHOLDER)
+            continue;
+         int64_t t = static_cast<int64_t>(m_baseTimestamp) + m_timestamps[i] - static_cast<int64_t>(timestamp);
+         m_timestamps[i] = static_cast<int32_t>(std::max(std::min(t, static_cast<int64_t>(INT32_MAX)), static_cast<int64_t>(INT32_MIN) + 1));
+      }
+      m_baseTimestamp = timestamp;
+      offset = 0;
+   }
+   return static_cast<int32_t>(offset);
+}
+
+/**
+ * Store value at given position in ring buffer
+ */
+void ItemValueCache::store(uint32_t pos, const ItemValue& value)
+{
+   m_timestamps[pos] = encodeTimeStamp(value.getTimeStamp());
+   bool placeholder = (m_timestamps[pos] == PLACEHOLDER);
+   switch(m_dataType)
+   {
+      case DCI_DT_INT:
+         m_values.i32[pos] = placeholder ? 0 : value.getInt32();
+         break;
+      case DCI_DT_UINT:
+      case DCI_DT_COUNTER32:
+         m_values.u32[pos] = placeholder ? 0 : value.getUInt32();
+         break;
+      case DCI_DT_INT64:
+         m_values.i64[pos] = placeholder ? 0 : value.getInt64();
+         break;
+      case DCI_DT_UINT64:
+      case DCI_DT_COUNTER64:
+         m_values.u64[pos] = placeholder ? 0 : value.getUInt64();
+         break;
+      case DCI_DT_FLOAT:
+         m_values.d[pos] = placeholder ? 0 : value.getDouble();
+         break;
+      default:
+         MemFree(m_values.s[pos]);
+         m_values.s[pos] = placeholder ? nullptr : MemCopyString(value.getString());
+         break;
+   }
+   if ((pos == m_head) && isNumeric())
+   {
+      MemFree(m_lastValue);
+      m_lastValue = placeholder ? nullptr : MemCopyString(value.getString());
+   }
+}
+
+/**
+ * Set new data type. Existing values are converted to new type.
+ */
+void ItemValueCache::setDataType(int dataType)
+{
+   if (dataType == m_dataType)
+      return;
+
+   ItemValueCache converted(dataType);
+   converted.reset(m_size);
+   for(uint32_t i = 0; i < m_size; i++)
+   {
+      if (!isPlaceholder(i))
+         converted.set(i, get(i));
+   }
+
+   clear();
+   m_dataType = dataType;
+   m_values = converted.m_values;
+   m_timestamps = converted.m_timestamps;
+   m_baseTimestamp = converted.m_baseTimestamp;
+   m_lastValue = converted.m_lastValue;
+   m_size = converted.m_size;
+   m_head = converted.m_head;
+
+   converted.m_values.ptr = nullptr;
+   converted.m_timestamps = nullptr;
+   converted.m_lastValue = nullptr;
+   converted.m_size = 0;
+}
+
+/**
+ * Reset cache to given size filled with placeholders
+ */
+void ItemValueCache::reset(uint32_t size)
+{
+   reallocate(0, UINT32_MAX);
+   reallocate(size, UINT32_MAX);
+}
+
+/**
+ * Add new value as most recent one, dropping oldest value
+ */
+void ItemValueCache::push(const ItemValue& value)
+{
+   if (m_size == 0)
+      return;
+   m_head = (m_head == 0) ? m_size - 1 : m_head - 1;
+   store(m_head, value);
+}
+
+/**
+ * Set value at given index
+ */
+void ItemValueCache::set(uint32_t index, const ItemValue& value)
+{
+   if (index < m_size)
+      store(position(index), value);
+}
+
+/**
+ * Remove value with given timestamp. Cache size is reduced by one.
+ */
+bool ItemValueCache::remove(time_t timestamp)
+{
+   for(uint32_t i = 0; i < m_size; i++)
+   {
+      if (getTimeStamp(i) == timestamp)
+      {
+         reallocate(m_size - 1, i);
+         return true;
+      }
+   }
+   return false;
+}
+
+/**
+ * Get value at given index
+ */
+ItemValue ItemValueCache::get(uint32_t index) const
+{
+   uint32_t pos = position(index);
+   if (m_timestamps[pos] == PLACEHOLDER)
+      return ItemValue(_T(""), 1);
+
+   time_t timestamp = m_baseTimestamp + m_timestamps[pos];
+   if ((pos == m_head) && (m_lastValue != nullptr))
+      return ItemValue(m_lastValue, timestamp);
+
+   ItemValue value;
+   switch(m_dataType)
+   {
+      case DCI_DT_INT:
+         value = m_values.i32[pos];
+         break;
+      case DCI_DT_UINT:
+      case DCI_DT_COUNTER32:
+         value = m_values.u32[pos];
+         break;
+      case DCI_DT_INT64:
+         value = m_values.i64[pos];
+         break;
+      case DCI_DT_UINT64:
+      case DCI_DT_COUNTER64:
+         value = m_values.u64[pos];
+         break;
+      case DCI_DT_FLOAT:
+         value = m_values.d[pos];
+         break;
+      default:
+         value = m_values.s[pos];
+         break;
+   }
+   value.setTimeStamp(timestamp);
+   return value;
+}
+
+/**
+ * Get string representation of most recent value. Returned pointer is valid only while owning DCI
+ * is locked, because any cache modification (including push of new value) may free it.
+ */
+const TCHAR *ItemValueCache::getLastString() const
+{
+   if (m_size == 0)
+      return _T("");
+   const TCHAR *s = isNumeric() ? m_lastValue : m_values.s[m_head];
+   return CHECK_NULL_EX(s);
+}
+
+/**
+ * Get most recent value as unsigned 32 bit integer
+ */
+uint32_t ItemValueCache::getLastUInt32() const
+{
+   return CachedStringToNumeric<uint32_t>(getLastString());
+}
+
+/**
+ * Get memory used by cache
+ */
+uint64_t ItemValueCache::getMemoryUsage() const
+{
+   uint64_t size = m_size * (elementSize() + sizeof(int32_t));
+   if (m_lastValue != nullptr)
+      size += (_tcslen(m_lastValue) + 1) * sizeof(TCHAR);
+   if (!isNumeric())
+   {
+      for(uint32_t i = 0; i < m_size; i++)
+         if (m_values.s[i] != nullptr)
+            size += (_tcslen(m_values.s[i]) + 1) * sizeof(TCHAR);
+   }
+   return size;
+}
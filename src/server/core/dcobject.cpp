@@ -25,6 +25,12 @@
 #define DEBUG_TAG_DC_CONFIG      _T("dc.config")
 #define DEBUG_TAG_DC_SCHEDULER   _T("dc.scheduler")
 
+/**
+ * Interval between readiness checks for data collection objects that cannot be polled at the moment
+ * (disabled, collected by agent, etc.)
+ */
+#define INACTIVE_RECHECK_INTERVAL   60
+
 /**
  * Default retention time for collected data
  */
@@ -106,6 +112,7 @@ DCObject::DCObject(const shared_ptr<DataCollectionOwner>& owner) : m_owner(owner
    m_instanceRetentionTime = -1;
    m_instanceGracePeriodStart = 0;
    m_startTime = 0;
+   m_scheduledPollTime = 0;
    m_relatedObject = 0;
 }
 
@@ -161,6 +168,7 @@ DCObject::DCObject(const DCObject *src, bool shadowCopy) :
    m_instanceRetentionTime = src->m_instanceRetentionTime;
    m_instanceGracePeriodStart = src->m_instanceGracePeriodStart;
    m_startTime = src->m_startTime;
+   m_scheduledPollTime = 0;
    m_relatedObject = src->m_relatedObject;
 }
 
@@ -211,6 +219,7 @@ DCObject::DCObject(UINT32 id, const TCHAR *name, int source, BYTE scheduleType,
    m_instanceRetentionTime = -1;
    m_instanceGracePeriodStart = 0;
    m_startTime = 0;
+   m_scheduledPollTime = 0;
    m_relatedObject = 0;
 
    updateTimeIntervalsInternal();
@@ -307,6 +316,7 @@ DCObject::DCObject(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& o
    m_instanceRetentionTime = config->getSubEntryValueAsInt(_T("instanceRetentionTime"), 0, -1);
    m_instanceGracePeriodStart = 0;
    m_startTime = 0;
+   m_scheduledPollTime = 0;
    m_relatedObject = 0;
 
    updateTimeIntervalsInternal();
@@ -772,6 +782,61 @@ bool DCObject::isReadyForPolling(time_t currTime)
    return result;
 }
 
+/**
+ * Get time when data collection object should be checked for polling readiness next time
+ */
+time_t DCObject::getNextPollTime(time_t currTime)
+{
+   // Same as in isReadyForPolling - do not block item poller on locked objects
+   if (!tryLock())
+      return currTime + 1;
+
+   time_t nextPollTime;
+   if (m_doForcePoll)
+   {
+      nextPollTime = currTime + 1;  // Pending forced poll (object was busy)
+   }
+   else if ((m_status == ITEM_STATUS_DISABLED) || (m_source == DS_PUSH_AGENT) ||
+            !matchClusterResource() || !hasValue() || (getAgentCacheMode() != AGENT_CACHE_OFF))
+   {
+      nextPollTime = currTime + INACTIVE_RECHECK_INTERVAL;
+   }
+   else if (!isCacheLoaded())
+   {
+      nextPollTime = currTime + 1;
+   }
+   else if (m_pollingScheduleType == DC_POLLING_SCHEDULE_ADVANCED)
+   {
+      // Schedules without seconds field have to be checked once per minute
+      bool withSeconds = false;
+      if (m_schedules != nullptr)
+      {
+         for(int i = 0; (i < m_schedules->size()) && !withSeconds; i++)
+         {
+            String schedule = expandSchedule(m_schedules->get(i));
+            int fields = 0;
+            for(const TCHAR *p = schedule.cstr(); *p != 0; p++)
+               if (!_istspace(*p) && ((p == schedule.cstr()) || _istspace(*(p - 1))))
+                  fields++;
+            withSeconds = (fields > 5);
+         }
+      }
+      nextPollTime = withSeconds ? currTime + 1 : currTime - currTime % 60 + 60;
+   }
+   else
+   {
+      // Busy object is being polled right now, so count interval from current time
+      // (object will be rescheduled based on actual poll time when poll completes)
+      nextPollTime = (m_busy ? currTime : m_lastPoll) + getEffectivePollingInterval() * ((m_status == ITEM_STATUS_NOT_SUPPORTED) ? 10 : 1);
+      if (nextPollTime < m_startTime)
+         nextPollTime = m_startTime;
+      if (nextPollTime <= currTime)
+         nextPollTime = currTime + 1;
+   }
+   unlock();
+   return nextPollTime;
+}
+
 /**
  * Returns true if internal cache is loaded. If data collection object
  * does not have cache should return true
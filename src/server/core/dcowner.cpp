@@ -545,6 +545,8 @@ bool DataCollectionOwner::setItemStatus(UINT32 dwNumItems, UINT32 *pdwItemList,
          if (m_dcObjects.get(j)->getId() == pdwItemList[i])
          {
             m_dcObjects.get(j)->setStatus(iStatus, true, userChange);
+            if ((iStatus == ITEM_STATUS_ACTIVE) && isDataCollectionTarget())
+               ScheduleDCObjectPoll(m_dcObjects.getShared(j), time(nullptr));  // Do not wait for next readiness recheck
             break;
          }
       }
@@ -428,7 +428,7 @@ bool DCTable::processNewValue(time_t timestamp, const shared_ptr<Table>& value,
       checkThresholds(value.get());
 
    if (g_flags & AF_PERFDATA_STORAGE_DRIVER_LOADED)
-      PerfDataStorageRequest(this, timestamp, value.get());
+      PerfDataStorageRequest(this, timestamp, value);
 
    return true;
 }
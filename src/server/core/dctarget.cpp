@@ -156,6 +156,30 @@ void DataCollectionTarget::fillMessageInternalStage2(NXCPMessage *msg, UINT32 us
    msg->setField(VID_TOOLTIP_DCI_COUNT, countTooltip);
 }
 
+/**
+ * Check if object's message depends on user - it does if any DCI sent in overview or tooltip lists has access restrictions
+ */
+bool DataCollectionTarget::isMessageUserSpecific()
+{
+   bool userSpecific = false;
+   readLockDciAccess();
+   for(int i = 0; i < m_dcObjects.size(); i++)
+   {
+      DCObject *dci = m_dcObjects.get(i);
+      if ((dci->getType() == DCO_TYPE_ITEM) &&
+          (dci->getStatus() == ITEM_STATUS_ACTIVE) &&
+          (dci->getInstanceDiscoveryMethod() == IDM_NONE) &&
+          (dci->isShowInObjectOverview() || dci->isShowOnObjectTooltip()) &&
+          dci->hasAccessList())
+      {
+         userSpecific = true;
+         break;
+      }
+   }
+   unlockDciAccess();
+   return userSpecific;
+}
+
 /**
  * Modify object from message
  */
@@ -887,41 +911,55 @@ bool DataCollectionTarget::isDataCollectionDisabled()
 }
 
 /**
- * Put items which requires polling into the queue
+ * Queue data collection object for polling if it is ready. SNMP and agent DCIs will be added to batch set
+ * instead of data collector queue if batch set is provided. Returns false if data collection
+ * is not active for this target.
  */
-void DataCollectionTarget::queueItemsForPolling()
+bool DataCollectionTarget::queueItemForPolling(const shared_ptr<DCObject>& object, time_t currTime, DataCollectionBatchSet *batches)
 {
    if ((m_status == STATUS_UNMANAGED) || isDataCollectionDisabled() || m_isDeleted)
-      return;  // Do not collect data for unmanaged objects or if data collection is disabled
-
-   time_t currTime = time(nullptr);
+      return false;  // Do not collect data for unmanaged objects or if data collection is disabled
 
-   readLockDciAccess();
-   for(int i = 0; i < m_dcObjects.size(); i++)
+   if (object->isReadyForPolling(currTime))
    {
-		DCObject *object = m_dcObjects.get(i);
-      if (m_dcObjects.get(i)->isReadyForPolling(currTime))
-      {
-         object->setBusyFlag();
+      object->setBusyFlag();
 
-         if ((object->getDataSource() == DS_NATIVE_AGENT) ||
-             (object->getDataSource() == DS_WINPERF) ||
-             (object->getDataSource() == DS_SNMP_AGENT) ||
-             (object->getDataSource() == DS_SSH) ||
-             (object->getDataSource() == DS_SMCLP))
+      if ((object->getDataSource() == DS_NATIVE_AGENT) ||
+          (object->getDataSource() == DS_WINPERF) ||
+          (object->getDataSource() == DS_SNMP_AGENT) ||
+          (object->getDataSource() == DS_SSH) ||
+          (object->getDataSource() == DS_SMCLP))
+      {
+         uint32_t sourceNodeId = getEffectiveSourceNode(object.get());
+         if ((batches == nullptr) || (object->getType() != DCO_TYPE_ITEM) || (sourceNodeId != 0) ||
+             (getObjectClass() != OBJECT_NODE) || !batches->add(m_id, object))
          {
-            uint32_t sourceNodeId = getEffectiveSourceNode(object);
             TCHAR key[32];
             _sntprintf(key, 32, _T("%08X/%s"), (sourceNodeId != 0) ? sourceNodeId : m_id, object->getDataProviderName());
-            ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, DataCollector, m_dcObjects.getShared(i));
-         }
-         else
-         {
-            ThreadPoolExecute(g_dataCollectorThreadPool, DataCollector, m_dcObjects.getShared(i));
+            ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, DataCollector, object);
          }
-			nxlog_debug_tag(_T("obj.dc.queue"), 8, _T("DataCollectionTarget(%s)->QueueItemsForPolling(): item %d \"%s\" added to queue"),
-			         m_name, object->getId(), object->getName().cstr());
       }
+      else
+      {
+         ThreadPoolExecute(g_dataCollectorThreadPool, DataCollector, object);
+      }
+      nxlog_debug_tag(_T("obj.dc.queue"), 8, _T("DataCollectionTarget(%s)->queueItemForPolling(): item %d \"%s\" added to queue"),
+               m_name, object->getId(), object->getName().cstr());
+   }
+   return true;
+}
+
+/**
+ * Add data collection objects to poll schedule for immediate readiness check. If unscheduledOnly
+ * is true, only objects currently missing from schedule will be added.
+ */
+void DataCollectionTarget::scheduleItemsForPolling(bool unscheduledOnly)
+{
+   time_t now = time(nullptr);
+   readLockDciAccess();
+   for(int i = 0; i < m_dcObjects.size(); i++)
+   {
+      ScheduleDCObjectPoll(m_dcObjects.getShared(i), now, unscheduledOnly);
    }
    unlockDciAccess();
 }
@@ -937,6 +975,7 @@ void DataCollectionTarget::updateDataCollectionTimeIntervals()
       m_dcObjects.get(i)->updateTimeIntervals();
    }
    unlockDciAccess();
+   scheduleItemsForPolling(false);
 }
 
 /**
@@ -1600,7 +1639,7 @@ void DataCollectionTarget::getItemDciValuesSummary(SummaryTable *tableDefinition
             {
                if (tc->m_flags & COLUMN_DEFINITION_MULTIVALUED)
                {
-                  StringList *values = String(((DCItem *)object)->getLastValue()).split(tc->m_separator);
+                  StringList *values = ((DCItem *)object)->getLastValue().split(tc->m_separator);
                   tableData->setAt(row, i + offset, values->get(0));
                   for(int r = 1; r < values->size(); r++)
                   {
@@ -2337,6 +2376,7 @@ void DataCollectionTarget::onDataCollectionChange()
 {
    super::onDataCollectionChange();
    calculateProxyLoad();
+   scheduleItemsForPolling(false);
 }
 
 /**
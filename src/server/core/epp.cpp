@@ -30,6 +30,10 @@
  */
 EPRule::EPRule(uint32_t id) : m_actions(0, 16, Ownership::True)
 {
+   m_evaluations = 0;
+   m_matches = 0;
+   m_totalTime = 0;
+   m_maxTime = 0;
    m_id = id;
    m_guid = uuid::generate();
    m_flags = 0;
@@ -50,6 +54,10 @@ EPRule::EPRule(uint32_t id) : m_actions(0, 16, Ownership::True)
  */
 EPRule::EPRule(const ConfigEntry& config) : m_actions(0, 16, Ownership::True)
 {
+   m_evaluations = 0;
+   m_matches = 0;
+   m_totalTime = 0;
+   m_maxTime = 0;
    m_id = 0;
    m_guid = config.getSubEntryValueAsUUID(_T("guid"));
    if (m_guid.isNull())
@@ -188,6 +196,10 @@ EPRule::EPRule(const ConfigEntry& config) : m_actions(0, 16, Ownership::True)
  */
 EPRule::EPRule(DB_RESULT hResult, int row) : m_actions(0, 16, Ownership::True)
 {
+   m_evaluations = 0;
+   m_matches = 0;
+   m_totalTime = 0;
+   m_maxTime = 0;
    m_id = DBGetFieldULong(hResult, row, 0);
    m_guid = DBGetFieldGUID(hResult, row, 1);
    m_flags = DBGetFieldULong(hResult, row, 2);
@@ -221,6 +233,10 @@ EPRule::EPRule(DB_RESULT hResult, int row) : m_actions(0, 16, Ownership::True)
  */
 EPRule::EPRule(const NXCPMessage& msg) : m_actions(0, 16, Ownership::True)
 {
+   m_evaluations = 0;
+   m_matches = 0;
+   m_totalTime = 0;
+   m_maxTime = 0;
    m_flags = msg.getFieldAsUInt32(VID_FLAGS);
    m_id = msg.getFieldAsUInt32(VID_RULE_ID);
    m_guid = msg.getFieldAsGUID(VID_GUID);
@@ -578,7 +594,7 @@ static EnumerationCallbackResult ExecutePstorageSetAction(const TCHAR *key, cons
  * Check if event match to rule and perform required actions if yes
  * Method will return TRUE if event matched and RF_STOP_PROCESSING flag is set
  */
-bool EPRule::processEvent(Event *event) const
+bool EPRule::processEvent(Event *event)
 {
    if (m_flags & RF_DISABLED)
       return false;
@@ -586,10 +602,15 @@ bool EPRule::processEvent(Event *event) const
    if ((event->getRootId() != 0) && !(m_flags & RF_ACCEPT_CORRELATED))
       return false;
 
+   int64_t startTime = GetCurrentTimeUs();
+
    // Check if event match
    if (!matchSource(event->getSourceId()) || !matchEvent(event->getCode()) ||
        !matchSeverity(event->getSeverity()) || !matchScript(event))
+   {
+      updateStatistics(startTime, false);
       return false;
+   }
 
    nxlog_debug_tag(DEBUG_TAG, 6, _T("Event ") UINT64_FMT _T(" match EPP rule %d"), event->getId(), (int)m_id + 1);
 
@@ -677,9 +698,46 @@ bool EPRule::processEvent(Event *event) const
          DeletePersistentStorageValue(key);
    }
 
+   updateStatistics(startTime, true);
    return (m_flags & RF_STOP_PROCESSING) ? true : false;
 }
 
+/**
+ * Update rule execution statistics
+ */
+void EPRule::updateStatistics(int64_t startTime, bool matched)
+{
+   int64_t elapsed = GetCurrentTimeUs() - startTime;
+   if (elapsed < 0)
+      elapsed = 0;   // System time was changed
+
+   InterlockedIncrement64(&m_evaluations);
+   if (matched)
+      InterlockedIncrement64(&m_matches);
+   InterlockedAdd64(&m_totalTime, elapsed);
+
+   // Update maximum time without lock, retry if another thread changed it concurrently
+   int32_t t = static_cast<int32_t>(std::min(elapsed, static_cast<int64_t>(INT32_MAX)));
+   int32_t curr;
+   do
+   {
+      curr = m_maxTime;
+      if (t <= curr)
+         break;
+   } while(InterlockedCompareExchange(&m_maxTime, t, curr) != curr);
+}
+
+/**
+ * Get rule execution statistics
+ */
+void EPRule::getStatistics(EPRuleStatistics *statistics) const
+{
+   statistics->evaluations = m_evaluations;
+   statistics->matches = m_matches;
+   statistics->totalTime = m_totalTime;
+   statistics->maxTime = m_maxTime;
+}
+
 /**
  * Generate alarm from event
  */
@@ -1141,6 +1199,11 @@ bool EventPolicy::loadFromDB()
    }
 
    DBConnectionPoolReleaseConnection(hdb);
+
+   writeLock();
+   rebuildDispatchIndex();
+   unlock();
+
    return success;
 }
 
@@ -1179,18 +1242,110 @@ bool EventPolicy::saveToDB() const
 }
 
 /**
- * Pass event through policy
+ * Add rule position to index list. Rules are added in policy order, so duplicate
+ * event codes within same rule can only produce adjacent duplicates.
+ */
+static inline void AddRuleToIndexList(IntegerArray<int> *list, int position)
+{
+   if (list->isEmpty() || (list->get(list->size() - 1) != position))
+      list->add(position);
+}
+
+/**
+ * Rebuild rule dispatch index. Policy lock should be held in write mode by caller.
+ */
+void EventPolicy::rebuildDispatchIndex()
+{
+   static uint32_t severityFlag[] = { RF_SEVERITY_INFO, RF_SEVERITY_WARNING, RF_SEVERITY_MINOR, RF_SEVERITY_MAJOR, RF_SEVERITY_CRITICAL };
+
+   for(int s = 0; s < 5; s++)
+   {
+      m_dispatchIndex[s].byEventCode.clear();
+      m_dispatchIndex[s].wildcard.clear();
+      m_dispatchIndex[s].boundEntries = 0;
+   }
+
+   int indexedRules = 0;
+   for(int i = 0; i < m_rules.size(); i++)
+   {
+      EPRule *rule = m_rules.get(i);
+      uint32_t flags = rule->getFlags();
+      if (flags & RF_DISABLED)
+         continue;
+
+      indexedRules++;
+      for(int s = 0; s < 5; s++)
+      {
+         if (!(flags & severityFlag[s]))
+            continue;
+
+         EPDispatchIndex *index = &m_dispatchIndex[s];
+         if (rule->isBoundToEventCodes())
+         {
+            const IntegerArray<uint32_t>& events = rule->getEvents();
+            for(int j = 0; j < events.size(); j++)
+            {
+               uint32_t code = events.get(j);
+               IntegerArray<int> *list = index->byEventCode.get(code);
+               if (list == nullptr)
+               {
+                  list = new IntegerArray<int>(0, 16);
+                  index->byEventCode.set(code, list);
+               }
+               int count = list->size();
+               AddRuleToIndexList(list, i);
+               index->boundEntries += list->size() - count;
+            }
+         }
+         else
+         {
+            AddRuleToIndexList(&index->wildcard, i);
+         }
+      }
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 4, _T("Event processing policy dispatch index rebuilt (%d rules, %d enabled)"), m_rules.size(), indexedRules);
+}
+
+/**
+ * Pass event through policy. Only rules listed in dispatch index for event's severity
+ * and code, and wildcard rules for event's severity, are evaluated. Both lists are
+ * sorted by rule position, so merging them preserves policy order.
  */
 void EventPolicy::processEvent(Event *pEvent)
 {
 	nxlog_debug_tag(DEBUG_TAG, 7, _T("EPP: processing event ") UINT64_FMT, pEvent->getId());
+
+   uint32_t severity = pEvent->getSeverity();
+   if (severity > EVENT_SEVERITY_CRITICAL)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 5, _T("EPP: event ") UINT64_FMT _T(" has invalid severity %u"), pEvent->getId(), severity);
+      return;
+   }
+
    readLock();
-   for(int i = 0; i < m_rules.size(); i++)
-      if (m_rules.get(i)->processEvent(pEvent))
+   const EPDispatchIndex& index = m_dispatchIndex[severity];
+   const IntegerArray<int> *bound = index.byEventCode.get(pEvent->getCode());
+   const int *boundRules = (bound != nullptr) ? bound->getBuffer() : nullptr;
+   int boundCount = (bound != nullptr) ? bound->size() : 0;
+   const int *wildcardRules = index.wildcard.getBuffer();
+   int wildcardCount = index.wildcard.size();
+
+   int i = 0, j = 0;
+   while((i < boundCount) || (j < wildcardCount))
+   {
+      int position;
+      if ((j >= wildcardCount) || ((i < boundCount) && (boundRules[i] < wildcardRules[j])))
+         position = boundRules[i++];
+      else
+         position = wildcardRules[j++];
+
+      if (m_rules.get(position)->processEvent(pEvent))
 		{
-			nxlog_debug_tag(DEBUG_TAG, 7, _T("EPP: got \"stop processing\" flag for event ") UINT64_FMT _T(" at rule %d"), pEvent->getId(), i + 1);
+			nxlog_debug_tag(DEBUG_TAG, 7, _T("EPP: got \"stop processing\" flag for event ") UINT64_FMT _T(" at rule %d"), pEvent->getId(), position + 1);
          break;   // EPRule::ProcessEvent() return TRUE if we should stop processing this event
 		}
+   }
    unlock();
 }
 
@@ -1227,6 +1382,7 @@ void EventPolicy::replacePolicy(uint32_t numRules, EPRule **ruleList)
          m_rules.add(r);
       }
    }
+   rebuildDispatchIndex();
    unlock();
 }
 
@@ -1386,6 +1542,7 @@ void EventPolicy::importRule(EPRule *rule, bool overwrite, ObjectArray<uuid> *ru
       }
    }
 
+   rebuildDispatchIndex();
    unlock();
 }
 
@@ -1422,3 +1579,37 @@ void EventPolicy::getEventReferences(uint32_t eventCode, ObjectArray<EventRefere
    }
    unlock();
 }
+
+/**
+ * Show dispatch index and rule execution statistics on server console
+ */
+void EventPolicy::showStatistics(ServerConsole *console) const
+{
+   static const TCHAR *severityNames[] = { _T("Normal"), _T("Warning"), _T("Minor"), _T("Major"), _T("Critical") };
+
+   readLock();
+
+   console->print(_T("\x1b[1mSeverity\x1b[0m | \x1b[1mEvent codes\x1b[0m | \x1b[1mBound rules\x1b[0m | \x1b[1mWildcard rules\x1b[0m\n"));
+   console->print(_T("---------+-------------+-------------+----------------\n"));
+   for(int s = 0; s < 5; s++)
+   {
+      const EPDispatchIndex& index = m_dispatchIndex[s];
+      console->printf(_T("%-8s | %11d | %11d | %14d\n"), severityNames[s], index.byEventCode.size(), index.boundEntries, index.wildcard.size());
+   }
+
+   console->print(_T("\n \x1b[1mRule\x1b[0m | \x1b[1mEvaluations\x1b[0m | \x1b[1mMatches\x1b[0m  | \x1b[1mTotal time\x1b[0m | \x1b[1mAvg time\x1b[0m | \x1b[1mMax time\x1b[0m\n"));
+   console->print(_T("------+-------------+----------+------------+----------+----------\n"));
+   for(int i = 0; i < m_rules.size(); i++)
+   {
+      const EPRule *rule = m_rules.get(i);
+      EPRuleStatistics stats;
+      rule->getStatistics(&stats);
+      console->printf(_T(" %4d | ") UINT64_FMT_ARGS(_T("11")) _T(" | ") UINT64_FMT_ARGS(_T("8")) _T(" | ") UINT64_FMT_ARGS(_T("8")) _T("ms | %6.1fus | %6uus%s\n"),
+            i + 1, stats.evaluations, stats.matches, stats.totalTime / 1000,
+            (stats.evaluations > 0) ? static_cast<double>(stats.totalTime) / stats.evaluations : 0.0, stats.maxTime,
+            (rule->getFlags() & RF_DISABLED) ? _T(" (disabled)") : _T(""));
+   }
+   console->print(_T("\n"));
+
+   unlock();
+}
@@ -125,10 +125,11 @@ static bool IsEventWriteAllowed(Event *event)
 }
 
 /**
- * Write event
+ * Add event to statement's batch
  */
 static inline void WriteEvent(DB_STATEMENT hStmt, Event *event)
 {
+   DBNextBatchRow(hStmt);
    DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, event->getId());
    DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, event->getCode());
    DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<UINT32>(event->getTimestamp()));
@@ -142,8 +143,42 @@ static inline void WriteEvent(DB_STATEMENT hStmt, Event *event)
    DBBind(hStmt, 11, DB_SQLTYPE_BIGINT, event->getRootId());
    DBBind(hStmt, 12, DB_SQLTYPE_VARCHAR, event->getTagsAsList(), DB_BIND_TRANSIENT, 2000);
    DBBind(hStmt, 13, DB_SQLTYPE_TEXT, event->toJson(), DB_BIND_DYNAMIC);
-   DBExecute(hStmt);
-   nxlog_debug_tag(DEBUG_TAG, 8, _T("EventLogger: DBExecute: id=%d,code=%d"), (int)event->getId(), (int)event->getCode());
+   nxlog_debug_tag(DEBUG_TAG, 8, _T("EventLogger: added to batch: id=%d,code=%d"), (int)event->getId(), (int)event->getCode());
+}
+
+/**
+ * Execute accumulated batch of events within transaction. If batch cannot be written, transaction
+ * is rolled back and events are written one by one, so one bad record will not cause loss of entire batch.
+ */
+static void ExecuteEventBatch(DB_HANDLE hdb, DB_STATEMENT hStmt, ObjectArray<Event> *batch)
+{
+   if (batch->isEmpty())
+      return;
+
+   bool transaction = DBBegin(hdb);
+   bool success = DBExecute(hStmt);
+   if (transaction)
+   {
+      if (success)
+         success = DBCommit(hdb);
+      else
+         DBRollback(hdb);
+   }
+
+   if (!success)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("EventLogger: batch write failed, retrying %d events one by one"), batch->size());
+      int failed = 0;
+      for(int i = 0; i < batch->size(); i++)
+      {
+         WriteEvent(hStmt, batch->get(i));
+         if (!DBExecute(hStmt))
+            failed++;
+      }
+      if (failed > 0)
+         nxlog_write_tag(NXLOG_WARNING, DEBUG_TAG, _T("Event logger dropped %d of %d events because of database errors"), failed, batch->size());
+   }
+   batch->clear();
 }
 
 /**
@@ -152,6 +187,7 @@ static inline void WriteEvent(DB_STATEMENT hStmt, Event *event)
 static void EventLogger()
 {
    ThreadSetName("EventLogger");
+   int maxRecords = ConfigReadInt(_T("DBWriter.MaxRecordsPerTransaction"), 1000);
 
    while(true)
    {
@@ -218,18 +254,36 @@ static void EventLogger()
                         _T("VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?)"), true);
 			if (hStmt != nullptr)
 			{
+			   // Events should be kept until batch is executed because message text is bound as static
+			   ObjectArray<Event> batch(maxRecords, 64, Ownership::True);
+			   DBOpenBatch(hStmt);
 			   WriteEvent(hStmt, event);
-			   delete event;
-            event = s_loggerQueue.getOrBlock(500);
-			   while((event != nullptr) && (event != INVALID_POINTER_VALUE))
+			   batch.add(event);
+			   while(true)
 				{
+			      event = s_loggerQueue.get();
+			      if ((event == nullptr) || (batch.size() >= maxRecords))
+			      {
+			         // Write accumulated events when queue is empty or batch is full
+			         ExecuteEventBatch(hdb, hStmt, &batch);
+			         DBOpenBatch(hStmt);
+			         if (event == nullptr)
+			            event = s_loggerQueue.getOrBlock(500);
+			      }
+			      if ((event == nullptr) || (event == INVALID_POINTER_VALUE))
+			         break;
+
 				   if (IsEventWriteAllowed(event))
 				   {
 		            WriteEvent(hStmt, event);
+		            batch.add(event);
+				   }
+				   else
+				   {
+				      delete event;
 				   }
-					delete event;
-					event = s_loggerQueue.getOrBlock(500);
 				}
+				ExecuteEventBatch(hdb, hStmt, &batch);
 				DBFreeStatement(hStmt);
 			}
 			else
@@ -412,6 +412,14 @@ static void HouseKeeper()
          nxlog_debug_tag(DEBUG_TAG, 7, _T("Empty subnet check completed"));
 		}
 
+      // Update DCI data rollups before raw data is removed
+      if (ConfigReadBoolean(_T("DataCollection.Rollup.Enable"), false))
+      {
+         nxlog_debug_tag(DEBUG_TAG, 2, _T("Updating DCI data rollups"));
+         UpdateDCIDataRollups(hdb);
+         nxlog_debug_tag(DEBUG_TAG, 7, _T("DCI data rollup update completed"));
+      }
+
 		// Remove expired DCI data
       if (!ConfigReadBoolean(_T("Housekeeper.DisableCollectedDataCleanup"), false))
       {
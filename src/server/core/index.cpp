@@ -23,25 +23,69 @@
 #include "nxcore.h"
 
 /**
- * Object index element
+ * Maximum number of entries in index tree node
  */
-struct INDEX_ELEMENT
+#define INDEX_NODE_SIZE    64
+
+/**
+ * Minimum number of entries in non-root node before merge with neighbor is attempted
+ */
+#define INDEX_NODE_MIN_FILL   (INDEX_NODE_SIZE / 4)
+
+/**
+ * Number of index versions that can be accessed by readers at the same time
+ */
+#define INDEX_VERSION_COUNT   8
+
+/**
+ * Index tree node. For leaf nodes slots contain objects, for internal nodes
+ * slots contain child nodes and keys contain lower bound of keys in each child.
+ */
+struct INDEX_NODE
 {
-   uint64_t key;
-   void *object;
+   uint64_t stamp;   // Write transaction that created this node
+   int count;
+   bool leaf;
+   uint64_t keys[INDEX_NODE_SIZE];
+   void *slots[INDEX_NODE_SIZE];
 };
 
 /**
- * Index head
+ * Index version head
  */
 struct INDEX_HEAD
 {
-   INDEX_ELEMENT *elements;
+   INDEX_NODE *root;
    size_t size;
-   size_t allocated;
-   uint64_t maxKey;
    VolatileCounter readers;
-   VolatileCounter writers;
+};
+
+/**
+ * Retired memory block (node or object)
+ */
+struct INDEX_RETIRED_BLOCK
+{
+   void *pointer;
+   bool node;
+};
+
+/**
+ * Index writer state
+ */
+struct INDEX_WRITER_STATE
+{
+   INDEX_HEAD versions[INDEX_VERSION_COUNT];
+   uint64_t stamp;
+   StructArray<INDEX_RETIRED_BLOCK> retired;
+   VolatileCounter waitingWriters;  // Non-zero if writer is waiting for free version slot
+   Condition versionReleased;       // Signalled by last reader leaving old version while writer is waiting
+
+   INDEX_WRITER_STATE() : retired(0, 256), versionReleased(false)
+   {
+      memset(versions, 0, sizeof(versions));
+      stamp = 1;
+      waitingWriters = 0;
+   }
 };
 
 /**
@@ -57,111 +101,440 @@ static void DefaultObjectDestructor(void *object, AbstractIndexBase *index)
  */
 AbstractIndexBase::AbstractIndexBase(Ownership owner) : m_writerLock(MutexType::FAST)
 {
-	m_primary = MemAllocStruct<INDEX_HEAD>();
-   m_secondary = MemAllocStruct<INDEX_HEAD>();
+   m_writerState = new INDEX_WRITER_STATE();
+   m_current = &m_writerState->versions[0];
 	m_owner = static_cast<bool>(owner);
 	m_startupMode = false;
-	m_dirty = false;
 	m_objectDestructor = DefaultObjectDestructor;
 }
 
+/**
+ * Destroy index tree
+ */
+static void DestroyTree(INDEX_NODE *node, AbstractIndexBase *index, void (*objectDestructor)(void*, AbstractIndexBase*))
+{
+   if (node->leaf)
+   {
+      if (objectDestructor != nullptr)
+      {
+         for(int i = 0; i < node->count; i++)
+            objectDestructor(node->slots[i], index);
+      }
+   }
+   else
+   {
+      for(int i = 0; i < node->count; i++)
+         DestroyTree(static_cast<INDEX_NODE*>(node->slots[i]), index, objectDestructor);
+   }
+   MemFree(node);
+}
+
 /**
  * Destructor
  */
 AbstractIndexBase::~AbstractIndexBase()
 {
-   if (m_owner)
+   reclaimRetiredMemory(false);
+   if (m_current->root != nullptr)
+      DestroyTree(m_current->root, this, m_owner ? m_objectDestructor : nullptr);
+   delete m_writerState;
+}
+
+/**
+ * Find position of first key that is greater or equal to given key
+ */
+static inline int LowerBound(const INDEX_NODE *node, uint64_t key)
+{
+   int first = 0, last = node->count;
+   while(first < last)
    {
-      for(size_t i = 0; i < m_primary->size; i++)
-         destroyObject(m_primary->elements[i].object);
+      int mid = (first + last) / 2;
+      if (node->keys[mid] < key)
+         first = mid + 1;
+      else
+         last = mid;
    }
-	MemFree(m_primary->elements);
-   MemFree(m_primary);
-   MemFree(m_secondary->elements);
-   MemFree(m_secondary);
+   return first;
 }
 
 /**
- * Compare index elements - qsort callback
+ * Find child node that may contain given key
  */
-static int IndexCompare(const void *pArg1, const void *pArg2)
+static inline int FindChild(const INDEX_NODE *node, uint64_t key)
 {
-   return (((INDEX_ELEMENT *)pArg1)->key < ((INDEX_ELEMENT *)pArg2)->key) ? -1 :
-            ((((INDEX_ELEMENT *)pArg1)->key > ((INDEX_ELEMENT *)pArg2)->key) ? 1 : 0);
+   int first = 1, last = node->count;
+   while(first < last)
+   {
+      int mid = (first + last) / 2;
+      if (node->keys[mid] <= key)
+         first = mid + 1;
+      else
+         last = mid;
+   }
+   return first - 1;
 }
 
 /**
- * Set/clear startup mode
+ * Find object in tree
  */
-void AbstractIndexBase::setStartupMode(bool startupMode)
+static void *FindInTree(const INDEX_NODE *node, uint64_t key)
 {
-   if (m_startupMode == startupMode)
-      return;
+   if (node == nullptr)
+      return nullptr;
+   while(!node->leaf)
+      node = static_cast<const INDEX_NODE*>(node->slots[FindChild(node, key)]);
+   int pos = LowerBound(node, key);
+   return ((pos < node->count) && (node->keys[pos] == key)) ? node->slots[pos] : nullptr;
+}
 
-   m_startupMode = startupMode;
-   if (!startupMode)
+/**
+ * Walk tree in key order. Callback should return false to stop walk.
+ */
+template<typename F> static bool WalkTree(const INDEX_NODE *node, F callback)
+{
+   if (node->leaf)
    {
-      if (m_primary->size > 0)
-      {
-         qsort(m_primary->elements, m_primary->size, sizeof(INDEX_ELEMENT), IndexCompare);
-         m_primary->maxKey = m_primary->elements[m_primary->size - 1].key;
-      }
-      else
+      for(int i = 0; i < node->count; i++)
+         if (!callback(node->keys[i], node->slots[i]))
+            return false;
+   }
+   else
+   {
+      for(int i = 0; i < node->count; i++)
+         if (!WalkTree(static_cast<const INDEX_NODE*>(node->slots[i]), callback))
+            return false;
+   }
+   return true;
+}
+
+/**
+ * Insert entry into node at given position. Node should have free space.
+ */
+static inline void InsertEntry(INDEX_NODE *node, int pos, uint64_t key, void *slot)
+{
+   memmove(&node->keys[pos + 1], &node->keys[pos], sizeof(uint64_t) * (node->count - pos));
+   memmove(&node->slots[pos + 1], &node->slots[pos], sizeof(void*) * (node->count - pos));
+   node->keys[pos] = key;
+   node->slots[pos] = slot;
+   node->count++;
+}
+
+/**
+ * Remove entry from node at given position
+ */
+static inline void RemoveEntry(INDEX_NODE *node, int pos)
+{
+   node->count--;
+   memmove(&node->keys[pos], &node->keys[pos + 1], sizeof(uint64_t) * (node->count - pos));
+   memmove(&node->slots[pos], &node->slots[pos + 1], sizeof(void*) * (node->count - pos));
+}
+
+/**
+ * Create new empty node
+ */
+static inline INDEX_NODE *CreateNode(uint64_t stamp, bool leaf)
+{
+   INDEX_NODE *node = MemAllocStruct<INDEX_NODE>();
+   node->stamp = stamp;
+   node->leaf = leaf;
+   return node;
+}
+
+/**
+ * Move upper half of full node into new node
+ */
+static INDEX_NODE *SplitNode(INDEX_NODE *node)
+{
+   INDEX_NODE *right = CreateNode(node->stamp, node->leaf);
+   int half = node->count / 2;
+   right->count = node->count - half;
+   memcpy(right->keys, &node->keys[half], sizeof(uint64_t) * right->count);
+   memcpy(right->slots, &node->slots[half], sizeof(void*) * right->count);
+   node->count = half;
+   return right;
+}
+
+/**
+ * Get writable version of given node. Nodes created within current write
+ * transaction are modified in place, all other nodes are copied.
+ */
+INDEX_NODE *AbstractIndexBase::getWritableNode(INDEX_NODE *node)
+{
+   if (node->stamp == m_writerState->stamp)
+      return node;
+   INDEX_NODE *copy = MemCopyBlock(node, sizeof(INDEX_NODE));
+   copy->stamp = m_writerState->stamp;
+   retireNode(node);
+   return copy;
+}
+
+/**
+ * Insert object into subtree. Node should be writable. Returns new right sibling if node was split.
+ */
+INDEX_NODE *AbstractIndexBase::insertIntoNode(INDEX_NODE *node, uint64_t key, void *object, void **oldObject)
+{
+   if (node->leaf)
+   {
+      int pos = LowerBound(node, key);
+      if ((pos < node->count) && (node->keys[pos] == key))
       {
-         m_primary->maxKey = 0;
+         *oldObject = node->slots[pos];
+         node->slots[pos] = object;
+         return nullptr;
       }
 
-      m_secondary->maxKey = m_primary->maxKey;
-      m_secondary->allocated = m_primary->allocated;
-      m_secondary->size = m_primary->size;
-      MemFree(m_secondary->elements);
-      if (m_secondary->allocated > 0)
+      if (node->count < INDEX_NODE_SIZE)
       {
-         m_secondary->elements = MemAllocArray<INDEX_ELEMENT>(m_secondary->allocated);
-         memcpy(m_secondary->elements, m_primary->elements, m_secondary->size * sizeof(INDEX_ELEMENT));
+         InsertEntry(node, pos, key, object);
+         return nullptr;
       }
+
+      INDEX_NODE *right = SplitNode(node);
+      if (pos > node->count)
+         InsertEntry(right, pos - node->count, key, object);
       else
+         InsertEntry(node, pos, key, object);
+      return right;
+   }
+
+   int pos = FindChild(node, key);
+   INDEX_NODE *child = getWritableNode(static_cast<INDEX_NODE*>(node->slots[pos]));
+   node->slots[pos] = child;
+   if (key < node->keys[pos])
+      node->keys[pos] = key;   // Only possible for first child
+
+   INDEX_NODE *newChild = insertIntoNode(child, key, object, oldObject);
+   if (newChild == nullptr)
+      return nullptr;
+
+   pos++;
+   if (node->count < INDEX_NODE_SIZE)
+   {
+      InsertEntry(node, pos, newChild->keys[0], newChild);
+      return nullptr;
+   }
+
+   INDEX_NODE *right = SplitNode(node);
+   if (pos > node->count)
+      InsertEntry(right, pos - node->count, newChild->keys[0], newChild);
+   else
+      InsertEntry(node, pos, newChild->keys[0], newChild);
+   return right;
+}
+
+/**
+ * Merge child node with given index with its right neighbor if they fit into one node
+ */
+void AbstractIndexBase::mergeChildNodes(INDEX_NODE *parent, int index)
+{
+   INDEX_NODE *left = static_cast<INDEX_NODE*>(parent->slots[index]);
+   INDEX_NODE *right = static_cast<INDEX_NODE*>(parent->slots[index + 1]);
+   if (left->count + right->count > INDEX_NODE_SIZE * 3 / 4)
+      return;
+
+   left = getWritableNode(left);
+   parent->slots[index] = left;
+   memcpy(&left->keys[left->count], right->keys, sizeof(uint64_t) * right->count);
+   memcpy(&left->slots[left->count], right->slots, sizeof(void*) * right->count);
+   left->count += right->count;
+   retireNode(right);
+   RemoveEntry(parent, index + 1);
+}
+
+/**
+ * Remove object from subtree. Node should be writable and key should exist in subtree.
+ */
+void AbstractIndexBase::removeFromNode(INDEX_NODE *node, uint64_t key, void **oldObject)
+{
+   if (node->leaf)
+   {
+      int pos = LowerBound(node, key);
+      *oldObject = node->slots[pos];
+      RemoveEntry(node, pos);
+      return;
+   }
+
+   int pos = FindChild(node, key);
+   INDEX_NODE *child = getWritableNode(static_cast<INDEX_NODE*>(node->slots[pos]));
+   node->slots[pos] = child;
+   removeFromNode(child, key, oldObject);
+
+   if (child->count == 0)
+   {
+      retireNode(child);
+      RemoveEntry(node, pos);
+   }
+   else if ((child->count < INDEX_NODE_MIN_FILL) && (node->count > 1))
+   {
+      mergeChildNodes(node, (pos < node->count - 1) ? pos : pos - 1);
+   }
+}
+
+/**
+ * Retire node. Nodes created by current write transaction are not visible
+ * to readers and destroyed immediately (unless index is in startup mode).
+ */
+void AbstractIndexBase::retireNode(INDEX_NODE *node)
+{
+   if ((node->stamp == m_writerState->stamp) && !m_startupMode)
+   {
+      MemFree(node);
+      return;
+   }
+   INDEX_RETIRED_BLOCK *block = m_writerState->retired.addPlaceholder();
+   block->pointer = node;
+   block->node = true;
+}
+
+/**
+ * Retire all nodes and (if index is an owner) all objects in given subtree
+ */
+void AbstractIndexBase::retireTree(INDEX_NODE *node)
+{
+   if (node->leaf)
+   {
+      if (m_owner)
       {
-         m_secondary->elements = nullptr;
+         for(int i = 0; i < node->count; i++)
+            retireObject(node->slots[i]);
       }
    }
-   m_dirty = false;
+   else
+   {
+      for(int i = 0; i < node->count; i++)
+         retireTree(static_cast<INDEX_NODE*>(node->slots[i]));
+   }
+   retireNode(node);
 }
 
 /**
- * Swap indexes and wait for new secondary copy to became writable
+ * Retire object removed from index
  */
-void AbstractIndexBase::swapAndWait()
+void AbstractIndexBase::retireObject(void *object)
 {
-   m_secondary = InterlockedExchangeObjectPointer(&m_primary, m_secondary);
-   InterlockedIncrement(&m_secondary->writers);
-   while(m_secondary->readers > 0)
+   if (object == nullptr)
+      return;
+   INDEX_RETIRED_BLOCK *block = m_writerState->retired.addPlaceholder();
+   block->pointer = object;
+   block->node = false;
+}
+
+/**
+ * Find version slot not used by readers. Caller should hold writer lock.
+ */
+INDEX_HEAD *AbstractIndexBase::findFreeVersion()
+{
+   for(int i = 0; i < INDEX_VERSION_COUNT; i++)
+   {
+      INDEX_HEAD *v = &m_writerState->versions[i];
+      if ((v != m_current) && (v->readers == 0))
+         return v;
+   }
+   return nullptr;
+}
+
+/**
+ * Publish new index version. Caller should hold writer lock.
+ */
+void AbstractIndexBase::publishVersion(INDEX_NODE *root, size_t size)
+{
+   // Find version slot not used by readers. If all slots are pinned by readers,
+   // block until one of them is released instead of polling.
+   INDEX_HEAD *version = findFreeVersion();
+   if (version == nullptr)
+   {
+      InterlockedIncrement(&m_writerState->waitingWriters);
+      while((version = findFreeVersion()) == nullptr)   // Check again after setting wait flag to avoid missed wakeup
+         m_writerState->versionReleased.wait(INFINITE);
+      InterlockedDecrement(&m_writerState->waitingWriters);
+   }
+
+   version->root = root;
+   version->size = size;
+   InterlockedExchangeObjectPointer(&m_current, version);
+}
+
+/**
+ * Destroy retired nodes and objects if no reader is accessing old index versions.
+ * If wait is true, wait for readers to leave old versions.
+ */
+void AbstractIndexBase::reclaimRetiredMemory(bool wait)
+{
+   if (m_writerState->retired.isEmpty())
+      return;
+
+   while(true)
+   {
+      bool oldVersionsInUse = false;
+      for(int i = 0; i < INDEX_VERSION_COUNT; i++)
+      {
+         INDEX_HEAD *v = &m_writerState->versions[i];
+         if ((v != m_current) && (v->readers > 0))
+         {
+            oldVersionsInUse = true;
+            break;
+         }
+      }
+      if (!oldVersionsInUse)
+         break;
+      if (!wait)
+         return;
       ThreadSleepMs(10);
+   }
+
+   for(int i = 0; i < m_writerState->retired.size(); i++)
+   {
+      INDEX_RETIRED_BLOCK *block = m_writerState->retired.get(i);
+      if (block->node)
+         MemFree(block->pointer);
+      else
+         destroyObject(block->pointer);
+   }
+   m_writerState->retired.clear();
 }
 
 /**
- * Acquire index
+ * Set/clear startup mode. In startup mode all updates are done within single
+ * write transaction, so tree nodes are modified in place without copying.
+ * Index should not be accessed concurrently while in startup mode.
+ */
+void AbstractIndexBase::setStartupMode(bool startupMode)
+{
+   m_writerLock.lock();
+   if (m_startupMode != startupMode)
+   {
+      m_startupMode = startupMode;
+      m_writerState->stamp++;
+      if (!startupMode)
+         reclaimRetiredMemory(false);
+   }
+   m_writerLock.unlock();
+}
+
+/**
+ * Acquire current index version
  */
 INDEX_HEAD *AbstractIndexBase::acquireIndex() const
 {
    INDEX_HEAD *h;
    while(true)
    {
-      h = m_primary;
+      h = m_current;
       InterlockedIncrement(&h->readers);
-      if (h->writers == 0)
+      if (h == m_current)
          break;
-      InterlockedDecrement(&h->readers);
+      releaseIndex(h);   // New version was published since pointer was read
    }
    return h;
 }
 
 /**
- * Release index
+ * Release index. Wakes up waiting writer if this was the last reader of the version.
  */
-static inline void ReleaseIndex(INDEX_HEAD *h)
+void AbstractIndexBase::releaseIndex(INDEX_HEAD *h) const
 {
-   InterlockedDecrement(&h->readers);
+   if ((InterlockedDecrement(&h->readers) == 0) && (m_writerState->waitingWriters > 0))
+      m_writerState->versionReleased.set();
 }
 
 /**
@@ -173,84 +546,47 @@ static inline void ReleaseIndex(INDEX_HEAD *h)
  */
 bool AbstractIndexBase::put(uint64_t key, void *object)
 {
-   if (m_startupMode)
+   m_writerLock.lock();
+
+   if (!m_startupMode)
+      m_writerState->stamp++;
+
+   INDEX_NODE *root = m_current->root;
+   size_t size = m_current->size;
+   void *oldObject = nullptr;
+   if (root != nullptr)
    {
-      if (m_primary->size == m_primary->allocated)
+      root = getWritableNode(root);
+      INDEX_NODE *right = insertIntoNode(root, key, object, &oldObject);
+      if (right != nullptr)
       {
-         m_primary->allocated += 1024;
-         m_primary->elements = MemReallocArray<INDEX_ELEMENT>(m_primary->elements, m_primary->allocated);
+         INDEX_NODE *newRoot = CreateNode(m_writerState->stamp, false);
+         newRoot->keys[0] = root->keys[0];
+         newRoot->slots[0] = root;
+         newRoot->keys[1] = right->keys[0];
+         newRoot->slots[1] = right;
+         newRoot->count = 2;
+         root = newRoot;
       }
-
-      m_primary->elements[m_primary->size].key = key;
-      m_primary->elements[m_primary->size].object = object;
-      m_primary->size++;
-      m_dirty = true;
-      return false;
+   }
+   else
+   {
+      root = CreateNode(m_writerState->stamp, true);
+      root->keys[0] = key;
+      root->slots[0] = object;
+      root->count = 1;
    }
 
-   bool replace = false;
-	void *oldObject = nullptr;
+   // Replacing object with itself should not destroy it
+   bool replace = (oldObject != nullptr);
+   if (!replace)
+      size++;
 
-   m_writerLock.lock();
+   publishVersion(root, size);
 
-	ssize_t pos = findElement(m_secondary, key);
-	if (pos != -1)
-	{
-		// Element already exist
-      oldObject = m_secondary->elements[pos].object;
-      m_secondary->elements[pos].object = object;
-		replace = true;
-	}
-	else
-	{
-		if (m_secondary->size == m_secondary->allocated)
-		{
-		   m_secondary->allocated += 1024;
-		   m_secondary->elements = MemReallocArray<INDEX_ELEMENT>(m_secondary->elements, m_secondary->allocated);
-		}
-
-		m_secondary->elements[m_secondary->size].key = key;
-		m_secondary->elements[m_secondary->size].object = object;
-		m_secondary->size++;
-		if (key < m_secondary->maxKey)
-		{
-		   qsort(m_secondary->elements, m_secondary->size, sizeof(INDEX_ELEMENT), IndexCompare);
-		}
-		else
-		{
-		   m_secondary->maxKey = key;
-		}
-	}
-
-	swapAndWait();
-
-	if (replace)
-	{
-      m_secondary->elements[pos].object = object;
-	   if (m_owner)
-	      destroyObject(oldObject);
-	}
-	else
-	{
-	   if (m_primary->allocated > m_secondary->allocated)
-	   {
-	      m_secondary->allocated = m_primary->allocated;
-         m_secondary->elements = MemReallocArray<INDEX_ELEMENT>(m_secondary->elements, m_secondary->allocated);
-	   }
-	   m_secondary->size = m_primary->size;
-      if (key < m_secondary->maxKey)
-      {
-         memcpy(m_secondary->elements, m_primary->elements, m_secondary->size * sizeof(INDEX_ELEMENT));
-      }
-      else
-      {
-         m_secondary->maxKey = key;
-         m_secondary->elements[m_secondary->size - 1].key = key;
-         m_secondary->elements[m_secondary->size - 1].object = object;
-      }
-	}
-
-   InterlockedDecrement(&m_secondary->writers);
+   if (replace && m_owner && (oldObject != object))
+      retireObject(oldObject);
+   reclaimRetiredMemory(false);
 
    m_writerLock.unlock();
 	return replace;
@@ -263,46 +599,38 @@ bool AbstractIndexBase::put(uint64_t key, void *object)
  */
 void AbstractIndexBase::remove(uint64_t key)
 {
-   if (m_startupMode)
+   m_writerLock.lock();
+
+   INDEX_NODE *root = m_current->root;
+   if (FindInTree(root, key) == nullptr)
    {
-      if (m_dirty)
-      {
-         qsort(m_primary->elements, m_primary->size, sizeof(INDEX_ELEMENT), IndexCompare);
-         m_primary->maxKey = (m_primary->size > 0) ? m_primary->elements[m_primary->size - 1].key : 0;
-         m_dirty = false;
-      }
-      ssize_t pos = findElement(m_primary, key);
-      if (pos != -1)
-      {
-         if (m_owner)
-            destroyObject(m_primary->elements[pos].object);
-         m_primary->size--;
-         memmove(&m_primary->elements[pos], &m_primary->elements[pos + 1], sizeof(INDEX_ELEMENT) * (m_primary->size - pos));
-      }
+      m_writerLock.unlock();
       return;
    }
 
-   m_writerLock.lock();
-
-	ssize_t pos = findElement(m_secondary, key);
-	if (pos != -1)
-	{
-      m_secondary->size--;
-      memmove(&m_secondary->elements[pos], &m_secondary->elements[pos + 1], sizeof(INDEX_ELEMENT) * (m_secondary->size - pos));
-      if (m_secondary->maxKey == key)
-         m_secondary->maxKey = (m_secondary->size > 0) ? m_secondary->elements[m_secondary->size - 1].key : 0;
+   if (!m_startupMode)
+      m_writerState->stamp++;
 
-      swapAndWait();
+   void *oldObject = nullptr;
+   root = getWritableNode(root);
+   removeFromNode(root, key, &oldObject);
+   if (root->count == 0)
+   {
+      retireNode(root);
+      root = nullptr;
+   }
+   else if (!root->leaf && (root->count == 1))
+   {
+      INDEX_NODE *child = static_cast<INDEX_NODE*>(root->slots[0]);
+      retireNode(root);
+      root = child;
+   }
 
-      if (m_owner)
-         destroyObject(m_secondary->elements[pos].object);
-      m_secondary->size--;
-      memmove(&m_secondary->elements[pos], &m_secondary->elements[pos + 1], sizeof(INDEX_ELEMENT) * (m_secondary->size - pos));
-      if (m_secondary->maxKey == key)
-         m_secondary->maxKey = (m_secondary->size > 0) ? m_secondary->elements[m_secondary->size - 1].key : 0;
+   publishVersion(root, m_current->size - 1);
 
-      InterlockedDecrement(&m_secondary->writers);
-   }
+   if (m_owner)
+      retireObject(oldObject);
+   reclaimRetiredMemory(false);
 
    m_writerLock.unlock();
 }
@@ -314,65 +642,18 @@ void AbstractIndexBase::clear()
 {
    m_writerLock.lock();
 
-   m_secondary->size = 0;
-   m_secondary->allocated = 0;
-   m_secondary->maxKey = 0;
-   MemFreeAndNull(m_secondary->elements);
-
-   swapAndWait();
-
-   if (m_owner)
+   INDEX_NODE *root = m_current->root;
+   if (root != nullptr)
    {
-      for(size_t i = 0; i < m_secondary->size; i++)
-         destroyObject(m_secondary->elements[i].object);
+      publishVersion(nullptr, 0);
+      m_writerState->stamp++;
+      retireTree(root);
    }
-
-   m_secondary->size = 0;
-   m_secondary->allocated = 0;
-   m_secondary->maxKey = 0;
-   MemFreeAndNull(m_secondary->elements);
-
-   InterlockedDecrement(&m_secondary->writers);
+   reclaimRetiredMemory(true);
 
    m_writerLock.unlock();
 }
 
-/**
- * Find element in index
- *
- * @param key object's key
- * @return element index or -1 if not found
- */
-ssize_t AbstractIndexBase::findElement(INDEX_HEAD *index, uint64_t key)
-{
-   size_t first, last, mid;
-
-	if (index->size == 0)
-      return -1;
-
-   first = 0;
-   last = index->size - 1;
-
-   if ((key < index->elements[0].key) || (key > index->elements[last].key))
-      return -1;
-
-   while(first < last)
-   {
-      mid = (first + last) / 2;
-      if (key == index->elements[mid].key)
-         return mid;
-      if (key < index->elements[mid].key)
-         last = mid - 1;
-      else
-         first = mid + 1;
-   }
-
-   if (key == index->elements[last].key)
-      return last;
-
-   return -1;
-}
-
 /**
  * Get object by key
  *
@@ -381,16 +662,9 @@ ssize_t AbstractIndexBase::findElement(INDEX_HEAD *index, uint64_t key)
  */
 void *AbstractIndexBase::get(uint64_t key) const
 {
-   if (m_startupMode && m_dirty)
-   {
-      qsort(m_primary->elements, m_primary->size, sizeof(INDEX_ELEMENT), IndexCompare);
-      m_primary->maxKey = (m_primary->size > 0) ? m_primary->elements[m_primary->size - 1].key : 0;
-      const_cast<AbstractIndexBase*>(this)->m_dirty = false;   // This is internal marker, changing it does not break const contract
-   }
    INDEX_HEAD *index = acquireIndex();
-	ssize_t pos = findElement(index, key);
-	void *object = (pos == -1) ? nullptr : index->elements[pos].object;
-   ReleaseIndex(index);
+   void *object = FindInTree(index->root, key);
+   releaseIndex(index);
 	return object;
 }
 
@@ -400,10 +674,17 @@ void *AbstractIndexBase::get(uint64_t key) const
 IntegerArray<uint64_t> AbstractIndexBase::keys() const
 {
    INDEX_HEAD *index = acquireIndex();
-   IntegerArray<uint64_t> result(index->size);
-   for(size_t i = 0; i < index->size; i++)
-      result.add(index->elements[i].key);
-   ReleaseIndex(index);
+   IntegerArray<uint64_t> result(static_cast<int>(index->size));
+   if (index->root != nullptr)
+   {
+      WalkTree(index->root,
+         [&result] (uint64_t key, void *object) -> bool
+         {
+            result.add(key);
+            return true;
+         });
+   }
+   releaseIndex(index);
    return result;
 }
 
@@ -414,7 +695,7 @@ size_t AbstractIndexBase::size() const
 {
    INDEX_HEAD *index = acquireIndex();
 	size_t s = index->size;
-   ReleaseIndex(index);
+   releaseIndex(index);
 	return s;
 }
 
@@ -429,13 +710,18 @@ void *AbstractIndexBase::find(bool (*comparator)(void *, void *), void *data) co
 	void *result = nullptr;
 
    INDEX_HEAD *index = acquireIndex();
-	for(size_t i = 0; i < index->size; i++)
-		if (comparator(index->elements[i].object, data))
-		{
-			result = index->elements[i].object;
-			break;
-		}
-   ReleaseIndex(index);
+   if (index->root != nullptr)
+   {
+      WalkTree(index->root,
+         [comparator, data, &result] (uint64_t key, void *object) -> bool
+         {
+            if (!comparator(object, data))
+               return true;
+            result = object;
+            return false;
+         });
+   }
+   releaseIndex(index);
 
 	return result;
 }
@@ -449,12 +735,17 @@ void *AbstractIndexBase::find(bool (*comparator)(void *, void *), void *data) co
 void AbstractIndexBase::findAll(Array *resultSet, bool (*comparator)(void *, void *), void *data) const
 {
    INDEX_HEAD *index = acquireIndex();
-   for(size_t i = 0; i < index->size; i++)
+   if (index->root != nullptr)
    {
-      if (comparator(index->elements[i].object, data))
-         resultSet->add(index->elements[i].object);
+      WalkTree(index->root,
+         [resultSet, comparator, data] (uint64_t key, void *object) -> bool
+         {
+            if (comparator(object, data))
+               resultSet->add(object);
+            return true;
+         });
    }
-   ReleaseIndex(index);
+   releaseIndex(index);
 }
 
 /**
@@ -466,9 +757,16 @@ void AbstractIndexBase::findAll(Array *resultSet, bool (*comparator)(void *, voi
 void AbstractIndexBase::forEach(void (*callback)(void *, void *), void *data) const
 {
    INDEX_HEAD *index = acquireIndex();
-	for(size_t i = 0; i < index->size; i++)
-		callback(index->elements[i].object, data);
-   ReleaseIndex(index);
+   if (index->root != nullptr)
+   {
+      WalkTree(index->root,
+         [callback, data] (uint64_t key, void *object) -> bool
+         {
+            callback(object, data);
+            return true;
+         });
+   }
+   releaseIndex(index);
 }
 
 /**
@@ -479,15 +777,19 @@ void AbstractIndexBase::forEach(void (*callback)(void *, void *), void *data) co
 unique_ptr<SharedObjectArray<NetObj>> ObjectIndex::getObjects(bool (*filter)(NetObj *, void *), void *context)
 {
    INDEX_HEAD *index = acquireIndex();
-   auto result = make_unique<SharedObjectArray<NetObj>>(index->size);
-   for(size_t i = 0; i < index->size; i++)
+   auto result = make_unique<SharedObjectArray<NetObj>>(static_cast<int>(index->size));
+   if (index->root != nullptr)
    {
-      if ((filter == nullptr) || filter(static_cast<shared_ptr<NetObj>*>(index->elements[i].object)->get(), context))
-      {
-         result->add(*static_cast<shared_ptr<NetObj>*>(index->elements[i].object));
-      }
+      SharedObjectArray<NetObj> *resultSet = result.get();
+      WalkTree(index->root,
+         [resultSet, filter, context] (uint64_t key, void *object) -> bool
+         {
+            if ((filter == nullptr) || filter(static_cast<shared_ptr<NetObj>*>(object)->get(), context))
+               resultSet->add(*static_cast<shared_ptr<NetObj>*>(object));
+            return true;
+         });
    }
-   ReleaseIndex(index);
+   releaseIndex(index);
    return result;
 }
 
@@ -497,12 +799,15 @@ unique_ptr<SharedObjectArray<NetObj>> ObjectIndex::getObjects(bool (*filter)(Net
 void ObjectIndex::getObjects(SharedObjectArray<NetObj> *destination, bool (*filter)(NetObj *, void *), void *context)
 {
    INDEX_HEAD *index = acquireIndex();
-   for(size_t i = 0; i < index->size; i++)
+   if (index->root != nullptr)
    {
-      if ((filter == nullptr) || filter(static_cast<shared_ptr<NetObj>*>(index->elements[i].object)->get(), context))
-      {
-         destination->add(*static_cast<shared_ptr<NetObj>*>(index->elements[i].object));
-      }
+      WalkTree(index->root,
+         [destination, filter, context] (uint64_t key, void *object) -> bool
+         {
+            if ((filter == nullptr) || filter(static_cast<shared_ptr<NetObj>*>(object)->get(), context))
+               destination->add(*static_cast<shared_ptr<NetObj>*>(object));
+            return true;
+         });
    }
-   ReleaseIndex(index);
+   releaseIndex(index);
 }
@@ -178,77 +178,345 @@ bool LogHandle::query(LogFilter *filter, int64_t *rowCount, uint32_t userId)
 }
 
 /**
- * Creates a SQL WHERE clause for restricting log to only objects accessible by given user.
+ * Object access constraint types
  */
-StringBuffer LogHandle::buildObjectAccessConstraint(uint32_t userId)
+enum class ObjectAccessConstraintType
 {
-   StringBuffer constraint;
-	unique_ptr<SharedObjectArray<NetObj>> objects = g_idxObjectById.getObjects();
+   NONE = 0,            // User has access to all objects
+   DENY_ALL = 1,        // User has no access to any object
+   ALLOWED_LIST = 2,    // Table log_access_objects contains objects accessible by user
+   RESTRICTED_LIST = 3  // Table log_access_objects contains objects not accessible by user
+};
+
+/**
+ * Check if given constraint type uses object list stored in database
+ */
+static inline bool IsListConstraint(ObjectAccessConstraintType type)
+{
+   return (type == ObjectAccessConstraintType::ALLOWED_LIST) || (type == ObjectAccessConstraintType::RESTRICTED_LIST);
+}
+
+/**
+ * Object access constraint cached for user. Constraint is valid while access rights cache version is unchanged.
+ * Size and hash of object list currently stored in database are kept to avoid rewriting identical list
+ * when access rights cache is invalidated by changes not affecting this user.
+ */
+struct ObjectAccessConstraint
+{
+   bool valid;
+   uint32_t version;
+   ObjectAccessConstraintType type;
+   ObjectAccessConstraintType listType;   // Type of list stored in database (NONE if there is no stored list)
+   int listSize;                          // Stored list size (-1 if stored list is unknown)
+   uint64_t listHash;
+};
+
+/**
+ * Delay before removing object list of type no longer used by user (milliseconds). Queries built from previous
+ * constraint may still be running, so list is not removed immediately.
+ */
+#define STALE_OBJECT_ACCESS_LIST_REMOVAL_DELAY  60000
+
+/**
+ * Number of locks used to serialize constraint rebuilds for same user
+ */
+#define OBJECT_ACCESS_REBUILD_LOCKS  16
+
+/**
+ * Object access constraints cache
+ */
+static HashMap<uint32_t, ObjectAccessConstraint> s_objectAccessConstraints(Ownership::True);
+static Mutex s_objectAccessConstraintsLock(MutexType::FAST);
+static Mutex s_objectAccessRebuildLocks[OBJECT_ACCESS_REBUILD_LOCKS];
+static Mutex s_objectAccessTableLock;
+static bool s_objectAccessTableCleared = false;
+
+/**
+ * Get cached constraint for given user. Returns true if cached constraint is still valid.
+ */
+static bool GetCachedObjectAccessConstraint(uint32_t userId, uint32_t version, ObjectAccessConstraintType *type)
+{
+   bool valid = false;
+   s_objectAccessConstraintsLock.lock();
+   ObjectAccessConstraint *cachedConstraint = s_objectAccessConstraints.get(userId);
+   if ((cachedConstraint != nullptr) && cachedConstraint->valid && (cachedConstraint->version == version))
+   {
+      *type = cachedConstraint->type;
+      valid = true;
+   }
+   s_objectAccessConstraintsLock.unlock();
+   return valid;
+}
+
+/**
+ * Calculate hash of object list. Hash does not depend on element order.
+ */
+static uint64_t HashObjectList(const IntegerArray<uint32_t>& list)
+{
+   uint64_t hash = 0;
+   for(int i = 0; i < list.size(); i++)
+   {
+      uint64_t h = static_cast<uint64_t>(list.get(i)) * UINT64_C(0x9E3779B97F4A7C15);
+      h ^= h >> 31;
+      h *= UINT64_C(0xBF58476D1CE4E5B9);
+      hash += h ^ (h >> 29);
+   }
+   return hash;
+}
+
+/**
+ * Store list of objects used in access constraint for given user. Only rows with same list type are replaced,
+ * so queries built from previous constraint of different type still see consistent object list.
+ */
+static bool SaveObjectAccessList(uint32_t userId, ObjectAccessConstraintType type, const IntegerArray<uint32_t>& list)
+{
+   DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+
+   // Table content left from previous server run is not valid
+   s_objectAccessTableLock.lock();
+   bool success = s_objectAccessTableCleared || DBQuery(hdb, _T("DELETE FROM log_access_objects"));
+   if (success)
+      s_objectAccessTableCleared = true;
+   s_objectAccessTableLock.unlock();
+
+   if (success)
+      success = DBBegin(hdb);
+   if (success)
+   {
+      TCHAR query[256];
+      _sntprintf(query, 256, _T("DELETE FROM log_access_objects WHERE user_id=%u AND list_type=%d"), userId, static_cast<int>(type));
+      success = DBQuery(hdb, query);
+
+      if (success && !list.isEmpty())
+      {
+         DB_STATEMENT hStmt = DBPrepare(hdb, _T("INSERT INTO log_access_objects (user_id,list_type,object_id) VALUES (?,?,?)"), true);
+         if ((hStmt != nullptr) && DBOpenBatch(hStmt))
+         {
+            for(int i = 0; (i < list.size()) && success; i++)
+            {
+               DBNextBatchRow(hStmt);
+               DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, userId);
+               DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, static_cast<int32_t>(type));
+               DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, list.get(i));
+               if (((i + 1) % 1000 == 0) || (i == list.size() - 1))
+               {
+                  success = DBExecute(hStmt);
+                  if (success && (i < list.size() - 1))
+                     DBOpenBatch(hStmt);
+               }
+            }
+         }
+         else
+         {
+            success = false;
+         }
+         if (hStmt != nullptr)
+            DBFreeStatement(hStmt);
+      }
+
+      if (success)
+         success = DBCommit(hdb);
+      else
+         DBRollback(hdb);
+   }
+   DBConnectionPoolReleaseConnection(hdb);
+   return success;
+}
+
+/**
+ * Stale object access list removal request
+ */
+struct StaleObjectAccessList
+{
+   uint32_t userId;
+   ObjectAccessConstraintType type;
+};
+
+/**
+ * Remove object list of given type if it is still not used by user's current constraint
+ */
+static void RemoveStaleObjectAccessList(StaleObjectAccessList *request)
+{
+   Mutex *rebuildLock = &s_objectAccessRebuildLocks[request->userId % OBJECT_ACCESS_REBUILD_LOCKS];
+   rebuildLock->lock();
+
+   s_objectAccessConstraintsLock.lock();
+   ObjectAccessConstraint *cachedConstraint = s_objectAccessConstraints.get(request->userId);
+   bool stale = (cachedConstraint == nullptr) || (cachedConstraint->listType != request->type);
+   s_objectAccessConstraintsLock.unlock();
+
+   if (stale)
+   {
+      TCHAR query[256];
+      _sntprintf(query, 256, _T("DELETE FROM log_access_objects WHERE user_id=%u AND list_type=%d"), request->userId, static_cast<int>(request->type));
+      DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+      DBQuery(hdb, query);
+      DBConnectionPoolReleaseConnection(hdb);
+      DbgPrintf(6, _T("LogHandle::buildObjectAccessConstraint(): removed stale object list (type %d) for user [%u]"), static_cast<int>(request->type), request->userId);
+   }
+
+   rebuildLock->unlock();
+   delete request;
+}
+
+/**
+ * Rebuild object access constraint for given user. Should be called with rebuild lock for that user held.
+ */
+static ObjectAccessConstraintType RebuildObjectAccessConstraint(uint32_t userId, uint32_t version)
+{
+   unique_ptr<SharedObjectArray<NetObj>> objects = g_idxObjectById.getObjects();
    IntegerArray<uint32_t> allowed(objects->size());
    IntegerArray<uint32_t> restricted(objects->size());
-	for(int i = 0; i < objects->size(); i++)
-	{
-		NetObj *object = objects->get(i);
+   for(int i = 0; i < objects->size(); i++)
+   {
+      NetObj *object = objects->get(i);
       if (object->isEventSource())
       {
-		   if (object->checkAccessRights(userId, OBJECT_ACCESS_READ))
-		   {
+         if (object->checkAccessRights(userId, OBJECT_ACCESS_READ))
+         {
             allowed.add(object->getId());
-		   }
+         }
          else
          {
             restricted.add(object->getId());
          }
       }
-	}
+   }
 
+   ObjectAccessConstraintType type;
    if (restricted.isEmpty())
-   {
-      // no restriction
-   }
+      type = ObjectAccessConstraintType::NONE;
    else if (allowed.isEmpty())
+      type = ObjectAccessConstraintType::DENY_ALL;
+   else if (allowed.size() < restricted.size())
+      type = ObjectAccessConstraintType::ALLOWED_LIST;
+   else
+      type = ObjectAccessConstraintType::RESTRICTED_LIST;
+
+   s_objectAccessConstraintsLock.lock();
+   ObjectAccessConstraint *cachedConstraint = s_objectAccessConstraints.get(userId);
+   if (cachedConstraint == nullptr)
    {
-      constraint.append(_T("1=0"));   // always false
+      cachedConstraint = new ObjectAccessConstraint();
+      cachedConstraint->valid = false;
+      cachedConstraint->listType = ObjectAccessConstraintType::NONE;
+      cachedConstraint->listSize = -1;
+      cachedConstraint->listHash = 0;
+      s_objectAccessConstraints.set(userId, cachedConstraint);
    }
-   else
+   ObjectAccessConstraintType storedListType = cachedConstraint->listType;
+   int storedListSize = cachedConstraint->listSize;
+   uint64_t storedListHash = cachedConstraint->listHash;
+   s_objectAccessConstraintsLock.unlock();
+
+   // Rewrite stored list only if it was actually changed
+   bool success = true;
+   int listSize = -1;
+   uint64_t listHash = 0;
+   if (IsListConstraint(type))
    {
-      IntegerArray<uint32_t> *list;
-      if (allowed.size() < restricted.size())
-      {
-         list = &allowed;
-      }
+      const IntegerArray<uint32_t>& list = (type == ObjectAccessConstraintType::ALLOWED_LIST) ? allowed : restricted;
+      listSize = list.size();
+      listHash = HashObjectList(list);
+      if ((storedListType != type) || (storedListSize != listSize) || (storedListHash != listHash))
+         success = SaveObjectAccessList(userId, type, list);
       else
-      {
-         list = &restricted;
-         constraint += _T("NOT (");
-      }
+         DbgPrintf(6, _T("LogHandle::buildObjectAccessConstraint(): object list for user [%u] not changed"), userId);
+   }
 
-      if (list->size() < 1000)
+   s_objectAccessConstraintsLock.lock();
+   cachedConstraint = s_objectAccessConstraints.get(userId);
+   if (success)
+   {
+      DbgPrintf(5, _T("LogHandle::buildObjectAccessConstraint(): constraint for user [%u] rebuilt (%d allowed, %d restricted objects)"), userId, allowed.size(), restricted.size());
+      cachedConstraint->valid = true;
+      cachedConstraint->version = version;
+      cachedConstraint->type = type;
+      if (IsListConstraint(type))
       {
-         constraint.appendFormattedString(_T("%s IN ("), m_log->relatedObjectIdColumn);
-         for(int i = 0; i < list->size(); i++)
-         {
-            TCHAR buffer[32];
-            _sntprintf(buffer, 32, _T("%d,"), list->get(i));
-            constraint += buffer;
-         }
-         constraint.shrink();
-         constraint += _T(")");
+         cachedConstraint->listType = type;
+         cachedConstraint->listSize = listSize;
+         cachedConstraint->listHash = listHash;
       }
       else
       {
-         for(int i = 0; i < list->size(); i++)
-         {
-            TCHAR buffer[32];
-   			constraint.appendFormattedString(_T("(%s=%d)OR"), m_log->relatedObjectIdColumn, list->get(i));
-            constraint += buffer;
-         }
-         constraint.shrink(2);
-      }
-      if (allowed.size() >= restricted.size())
-      {
-         constraint += _T(")");
+         cachedConstraint->listType = ObjectAccessConstraintType::NONE;
+         cachedConstraint->listSize = -1;
       }
+   }
+   else
+   {
+      // Deny access to all objects until object list is successfully stored in database
+      DbgPrintf(4, _T("LogHandle::buildObjectAccessConstraint(): cannot store object access list for user [%u]"), userId);
+      cachedConstraint->valid = false;
+      cachedConstraint->listSize = -1;
+      type = ObjectAccessConstraintType::DENY_ALL;
+   }
+   s_objectAccessConstraintsLock.unlock();
+
+   // List of previously used type is not needed anymore
+   if (success && IsListConstraint(storedListType) && (storedListType != type))
+   {
+      StaleObjectAccessList *request = new StaleObjectAccessList();
+      request->userId = userId;
+      request->type = storedListType;
+      ThreadPoolScheduleRelative(g_mainThreadPool, STALE_OBJECT_ACCESS_LIST_REMOVAL_DELAY, RemoveStaleObjectAccessList, request);
+   }
+   return type;
+}
+
+/**
+ * Remove cached object access constraint for deleted user. Stored object lists are removed
+ * from database together with user record.
+ */
+void DeleteObjectAccessConstraint(uint32_t userId)
+{
+   Mutex *rebuildLock = &s_objectAccessRebuildLocks[userId % OBJECT_ACCESS_REBUILD_LOCKS];
+   rebuildLock->lock();
+   s_objectAccessConstraintsLock.lock();
+   s_objectAccessConstraints.remove(userId);
+   s_objectAccessConstraintsLock.unlock();
+   rebuildLock->unlock();
+}
+
+/**
+ * Creates a SQL WHERE clause for restricting log to only objects accessible by given user.
+ * Set of accessible (or inaccessible, whichever is smaller) objects is stored in table
+ * log_access_objects and reused until access rights are changed.
+ */
+StringBuffer LogHandle::buildObjectAccessConstraint(uint32_t userId)
+{
+   uint32_t version = GetAccessRightsCacheVersion();
+   ObjectAccessConstraintType type;
+   if (!GetCachedObjectAccessConstraint(userId, version, &type))
+   {
+      Mutex *rebuildLock = &s_objectAccessRebuildLocks[userId % OBJECT_ACCESS_REBUILD_LOCKS];
+      rebuildLock->lock();
+
+      // Constraint could be rebuilt by another thread while waiting
+      version = GetAccessRightsCacheVersion();
+      if (!GetCachedObjectAccessConstraint(userId, version, &type))
+         type = RebuildObjectAccessConstraint(userId, version);
+
+      rebuildLock->unlock();
+   }
+
+   StringBuffer constraint;
+   switch(type)
+   {
+      case ObjectAccessConstraintType::DENY_ALL:
+         constraint.append(_T("1=0"));   // always false
+         break;
+      case ObjectAccessConstraintType::ALLOWED_LIST:
+         constraint.appendFormattedString(_T("%s IN (SELECT object_id FROM log_access_objects WHERE user_id=%u AND list_type=%d)"),
+                  m_log->relatedObjectIdColumn, userId, static_cast<int>(type));
+         break;
+      case ObjectAccessConstraintType::RESTRICTED_LIST:
+         constraint.appendFormattedString(_T("%s NOT IN (SELECT object_id FROM log_access_objects WHERE user_id=%u AND list_type=%d)"),
+                  m_log->relatedObjectIdColumn, userId, static_cast<int>(type));
+         break;
+      default:
+         break;
    }
 	return constraint;
 }
@@ -532,6 +532,7 @@ static void LoadGlobalConfig()
    g_pollsBetweenPrimaryIpUpdate = ConfigReadULong(_T("Objects.Nodes.ResolveDNSToIPOnStatusPoll.Interval"), 1);
 
    SnmpSetDefaultTimeout(ConfigReadInt(_T("SNMP.RequestTimeout"), 1500));
+   SnmpSetWalkMaxRepetitions(ConfigReadULong(_T("SNMP.Walk.MaxRepetitions"), 32));
 }
 
 /**
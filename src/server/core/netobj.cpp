@@ -70,6 +70,7 @@ NetObj::NetObj() : NObject(), m_dashboards(0, 8), m_urls(0, 8, Ownership::True),
    m_comments = nullptr;
    m_commentsSource = nullptr;
    m_modified = 0;
+   m_messageVersion = 0;
    m_isDeleted = false;
    m_isDeleteInitiated = false;
    m_isHidden = false;
@@ -1350,6 +1351,161 @@ void NetObj::fillMessage(NXCPMessage *msg, UINT32 userId)
    unlockResponsibleUsersList();
 }
 
+/**
+ * Check if object's message depends on user it is created for (except ACL-based filtering done by caller)
+ */
+bool NetObj::isMessageUserSpecific()
+{
+   return false;
+}
+
+/**
+ * Time to live for cached object message (in seconds). Some parts of object's message (like
+ * last values of DCIs shown in tooltips) are changed without marking object as modified,
+ * so cached message is discarded after this period even if object version is unchanged.
+ */
+#define OBJECT_MESSAGE_CACHE_TTL    5
+
+/**
+ * Serialized object message shared between client sessions. Message is built once per object
+ * version and all variants (with masked passwords, with comments, compressed) are created
+ * from it on demand.
+ */
+class ObjectMessageCache
+{
+private:
+   uint32_t m_version;
+   time_t m_timestamp;
+   NXCPMessage m_baseMessage;
+   NXCP_MESSAGE *m_variants[8];
+   Mutex m_mutex;
+
+public:
+   ObjectMessageCache(NetObj *object, uint32_t version, time_t timestamp) : m_mutex(MutexType::FAST)
+   {
+      m_version = version;
+      m_timestamp = timestamp;
+      object->fillMessage(&m_baseMessage, 0);
+      memset(m_variants, 0, sizeof(m_variants));
+   }
+
+   ~ObjectMessageCache()
+   {
+      for(int i = 0; i < 8; i++)
+         MemFree(m_variants[i]);
+   }
+
+   bool isValid(uint32_t version, time_t now) const { return (m_version == version) && !isExpired(now); }
+   bool isExpired(time_t now) const { return (now - m_timestamp >= OBJECT_MESSAGE_CACHE_TTL) || (now < m_timestamp); }
+   time_t getTimestamp() const { return m_timestamp; }
+
+   NXCP_MESSAGE *createMessage(NetObj *object, uint16_t code, uint32_t requestId, uint32_t options);
+};
+
+/**
+ * Add optional parts to object message
+ */
+static void ApplyClientMessageOptions(NetObj *object, NXCPMessage *msg, uint32_t options)
+{
+   if (options & OBJECT_MESSAGE_INCLUDE_COMMENTS)
+      object->commentsToMessage(msg);
+   if (options & OBJECT_MESSAGE_MASK_PASSWORDS)
+   {
+      msg->setField(VID_SHARED_SECRET, _T("********"));
+      msg->setField(VID_SNMP_AUTH_PASSWORD, _T("********"));
+      msg->setField(VID_SNMP_PRIV_PASSWORD, _T("********"));
+   }
+}
+
+/**
+ * Create copy of requested message variant with given code and request ID
+ */
+NXCP_MESSAGE *ObjectMessageCache::createMessage(NetObj *object, uint16_t code, uint32_t requestId, uint32_t options)
+{
+   options &= 0x07;
+   m_mutex.lock();
+   NXCP_MESSAGE *variant = m_variants[options];
+   if (variant == nullptr)
+   {
+      NXCPMessage msg(m_baseMessage);
+      ApplyClientMessageOptions(object, &msg, options);
+      variant = msg.serialize((options & OBJECT_MESSAGE_COMPRESSED) != 0);
+      m_variants[options] = variant;
+   }
+   m_mutex.unlock();
+
+   // Variant is immutable once created so it can be copied outside lock
+   NXCP_MESSAGE *result = static_cast<NXCP_MESSAGE*>(MemCopyBlock(variant, ntohl(variant->size)));
+   result->code = htons(code);
+   result->id = htonl(requestId);
+   return result;
+}
+
+/**
+ * Create serialized message with object's data for sending to client. Message is created from
+ * cache shared by all client sessions when possible. Caller is responsible for destroying
+ * returned message with MemFree.
+ */
+NXCP_MESSAGE *NetObj::createClientMessage(uint16_t code, uint32_t requestId, uint32_t userId, uint32_t options)
+{
+   if ((userId != 0) && isMessageUserSpecific())
+   {
+      NXCPMessage msg(code, requestId);
+      fillMessage(&msg, userId);
+      ApplyClientMessageOptions(this, &msg, options);
+      return msg.serialize((options & OBJECT_MESSAGE_COMPRESSED) != 0);
+   }
+
+   lockProperties();
+   shared_ptr<ObjectMessageCache> cache = m_messageCache;
+   unlockProperties();
+
+   uint32_t version = static_cast<uint32_t>(m_messageVersion);
+   time_t now = time(nullptr);
+   if ((cache == nullptr) || !cache->isValid(version, now))
+   {
+      cache = make_shared<ObjectMessageCache>(this, version, now);
+      bool scheduleRelease = false;
+      lockProperties();
+      if (m_messageCache == nullptr)
+      {
+         // Release task is pending while cache is set
+         m_messageCache = cache;
+         scheduleRelease = true;
+      }
+      else if (!m_messageCache->isValid(version, now))
+      {
+         m_messageCache = cache;
+      }
+      unlockProperties();
+      if (scheduleRelease)
+         ThreadPoolScheduleRelative(g_mainThreadPool, OBJECT_MESSAGE_CACHE_TTL * 1000, NetObj::releaseExpiredMessageCache, self());
+   }
+   return cache->createMessage(this, code, requestId, options);
+}
+
+/**
+ * Release cached object message if it is expired, so memory is held only for objects
+ * actively sent to clients. Re-scheduled while cache is still in use.
+ */
+void NetObj::releaseExpiredMessageCache(const shared_ptr<NetObj>& object)
+{
+   time_t now = time(nullptr);
+   time_t expirationTime = 0;
+   object->lockProperties();
+   if (object->m_messageCache != nullptr)
+   {
+      if (object->m_messageCache->isExpired(now))
+         object->m_messageCache.reset();
+      else
+         expirationTime = object->m_messageCache->getTimestamp() + OBJECT_MESSAGE_CACHE_TTL;
+   }
+   object->unlockProperties();
+
+   if (expirationTime != 0)
+      ThreadPoolScheduleRelative(g_mainThreadPool, static_cast<uint32_t>(std::max(expirationTime - now, static_cast<time_t>(1))) * 1000, NetObj::releaseExpiredMessageCache, object);
+}
+
 /**
  * Handler for EnumerateSessions()
  */
@@ -1363,6 +1519,10 @@ static void BroadcastObjectChange(ClientSession *session, NetObj *object)
  */
 void NetObj::setModified(uint32_t flags, bool notify)
 {
+   InterlockedIncrement(&m_messageVersion);
+   if (flags & (MODIFY_ACCESS_LIST | MODIFY_RELATIONS))
+      InvalidateAccessRightsCache();
+
    if (g_modificationsLocked)
       return;
 
@@ -1383,11 +1543,16 @@ void NetObj::setModified(uint32_t flags, bool notify)
 uint32_t NetObj::modifyFromMessage(const NXCPMessage& msg)
 {
    lockProperties();
+   bool dataCollectionWasDisabled = isDataCollectionTarget() && static_cast<DataCollectionTarget*>(this)->isDataCollectionDisabled();
    uint32_t rcc = modifyFromMessageInternal(msg);
    unlockProperties();
    if (rcc == RCC_SUCCESS)
       rcc = modifyFromMessageInternalStage2(msg);
    markAsModified(MODIFY_ALL);
+
+   // Start data collection immediately instead of waiting for next readiness recheck
+   if (dataCollectionWasDisabled && !static_cast<DataCollectionTarget*>(this)->isDataCollectionDisabled())
+      static_cast<DataCollectionTarget*>(this)->scheduleItemsForPolling(false);
    return rcc;
 }
 
@@ -1618,6 +1783,10 @@ uint32_t NetObj::getUserRights(uint32_t userId) const
 	if (m_isSystem)
 		return 0;
 
+   uint32_t cacheVersion;
+   if (GetCachedAccessRights(userId, m_id, &rights, &cacheVersion))
+      return rights;
+
    // Check if have direct right assignment
    lockACL();
    bool hasDirectRights = m_accessList.getUserRights(userId, &rights);
@@ -1636,6 +1805,7 @@ uint32_t NetObj::getUserRights(uint32_t userId) const
       }
    }
 
+   UpdateAccessRightsCache(userId, m_id, rights, cacheVersion);
    return rights;
 }
 
@@ -1694,6 +1864,10 @@ bool NetObj::setMgmtStatus(bool isManaged)
    if (getObjectClass() == OBJECT_NODE)
       PostSystemEvent(isManaged ? EVENT_NODE_UNKNOWN : EVENT_NODE_UNMANAGED, m_id, "d", oldStatus);
 
+   // Start data collection immediately instead of waiting for next readiness recheck
+   if (isManaged && isDataCollectionTarget())
+      static_cast<DataCollectionTarget*>(this)->scheduleItemsForPolling(false);
+
    // Change status for child objects also
    readLockChildList();
    for(int i = 0; i < getChildList().size(); i++)
@@ -24,6 +24,7 @@
 #include <agent_tunnel.h>
 #include <entity_mib.h>
 #include <ethernet_ip.h>
+#include <nxcore_syslog.h>
 
 #define DEBUG_TAG_DC_AGENT_CACHE    _T("dc.agent.cache")
 #define DEBUG_TAG_ICMP_POLL         _T("poll.icmp")
@@ -71,6 +72,7 @@ int64_t GetSyncerRunTime(StatisticType statType);
  * Get internal metric from performance data storage driver
  */
 DataCollectionError GetPerfDataStorageDriverMetric(const TCHAR *driver, const TCHAR *metric, TCHAR *value);
+DataCollectionError GetPerfDataStorageQueueMetric(const TCHAR *driver, const TCHAR *metric, TCHAR *value);
 
 /**
  * Poll cancellation checkpoint
@@ -143,6 +145,7 @@ Node::Node() : super(Pollable::STATUS | Pollable::CONFIGURATION | Pollable::DISC
    m_lastAgentCommTime = TIMESTAMP_NEVER;
    m_lastAgentConnectAttempt = TIMESTAMP_NEVER;
    m_agentRestartTime = TIMESTAMP_NEVER;
+   m_agentBulkMetricsUnsupported = false;
    m_vrrpInfo = nullptr;
    m_topologyRebuildTimestamp = TIMESTAMP_NEVER;
    m_pendingState = -1;
@@ -262,6 +265,7 @@ Node::Node(const NewNodeData *newNodeData, UINT32 flags) : super(Pollable::STATU
    m_lastAgentCommTime = TIMESTAMP_NEVER;
    m_lastAgentConnectAttempt = TIMESTAMP_NEVER;
    m_agentRestartTime = TIMESTAMP_NEVER;
+   m_agentBulkMetricsUnsupported = false;
    m_vrrpInfo = nullptr;
    m_topologyRebuildTimestamp = TIMESTAMP_NEVER;
    m_pendingState = -1;
@@ -6006,6 +6010,7 @@ bool Node::connectToAgent(UINT32 *error, UINT32 *socketError, bool *newConnectio
          }
       }
       m_agentConnection->enableTraps();
+      m_agentBulkMetricsUnsupported = false;  // Agent could be upgraded since last connection
       clearFileUpdateConnection();
       setLastAgentCommTime();
       CALL_ALL_MODULES(pfOnConnectToAgent, (self(), m_agentConnection));
@@ -6038,6 +6043,40 @@ inline DataCollectionError DCErrorFromSNMPError(UINT32 snmpError)
    }
 }
 
+/**
+ * Format raw SNMP value according to given interpretation mode
+ */
+static void FormatRawSNMPValue(const BYTE *rawValue, int interpretRawValue, TCHAR *buffer, size_t size)
+{
+   switch(interpretRawValue)
+   {
+      case SNMP_RAWTYPE_INT32:
+         _sntprintf(buffer, size, _T("%d"), ntohl(*((LONG *)rawValue)));
+         break;
+      case SNMP_RAWTYPE_UINT32:
+         _sntprintf(buffer, size, _T("%u"), ntohl(*((UINT32 *)rawValue)));
+         break;
+      case SNMP_RAWTYPE_INT64:
+         _sntprintf(buffer, size, INT64_FMT, (INT64)ntohq(*((INT64 *)rawValue)));
+         break;
+      case SNMP_RAWTYPE_UINT64:
+         _sntprintf(buffer, size, UINT64_FMT, ntohq(*((QWORD *)rawValue)));
+         break;
+      case SNMP_RAWTYPE_DOUBLE:
+         _sntprintf(buffer, size, _T("%f"), ntohd(*((double *)rawValue)));
+         break;
+      case SNMP_RAWTYPE_IP_ADDR:
+         IpToStr(ntohl(*reinterpret_cast<const uint32_t*>(rawValue)), buffer);
+         break;
+      case SNMP_RAWTYPE_MAC_ADDR:
+         MACToStr(rawValue, buffer);
+         break;
+      default:
+         buffer[0] = 0;
+         break;
+   }
+}
+
 /**
  * Get DCI value via SNMP
  */
@@ -6065,35 +6104,7 @@ DataCollectionError Node::getMetricFromSNMP(UINT16 port, SNMP_Version version, c
          memset(rawValue, 0, 1024);
          snmpResult = SnmpGetEx(snmp, name, nullptr, 0, rawValue, 1024, SG_RAW_RESULT, nullptr);
          if (snmpResult == SNMP_ERR_SUCCESS)
-         {
-            switch(interpretRawValue)
-            {
-               case SNMP_RAWTYPE_INT32:
-                  _sntprintf(buffer, size, _T("%d"), ntohl(*((LONG *)rawValue)));
-                  break;
-               case SNMP_RAWTYPE_UINT32:
-                  _sntprintf(buffer, size, _T("%u"), ntohl(*((UINT32 *)rawValue)));
-                  break;
-               case SNMP_RAWTYPE_INT64:
-                  _sntprintf(buffer, size, INT64_FMT, (INT64)ntohq(*((INT64 *)rawValue)));
-                  break;
-               case SNMP_RAWTYPE_UINT64:
-                  _sntprintf(buffer, size, UINT64_FMT, ntohq(*((QWORD *)rawValue)));
-                  break;
-               case SNMP_RAWTYPE_DOUBLE:
-                  _sntprintf(buffer, size, _T("%f"), ntohd(*((double *)rawValue)));
-                  break;
-               case SNMP_RAWTYPE_IP_ADDR:
-                  IpToStr(ntohl(*reinterpret_cast<uint32_t*>(rawValue)), buffer);
-                  break;
-               case SNMP_RAWTYPE_MAC_ADDR:
-                  MACToStr(rawValue, buffer);
-                  break;
-               default:
-                  buffer[0] = 0;
-                  break;
-            }
-         }
+            FormatRawSNMPValue(rawValue, interpretRawValue, buffer, size);
       }
       delete snmp;
    }
@@ -6105,6 +6116,155 @@ DataCollectionError Node::getMetricFromSNMP(UINT16 port, SNMP_Version version, c
    return DCErrorFromSNMPError(snmpResult);
 }
 
+/**
+ * Store value of single variable from multi-varbind response
+ */
+static void StoreSNMPMetricValue(SNMPMetricRequest *request, SNMP_Variable *v)
+{
+   if ((v->getType() == ASN_NO_SUCH_OBJECT) || (v->getType() == ASN_NO_SUCH_INSTANCE) || (v->getType() == ASN_END_OF_MIBVIEW))
+   {
+      request->error = DCErrorFromSNMPError(SNMP_ERR_NO_OBJECT);
+      return;
+   }
+
+   TCHAR buffer[MAX_LINE_SIZE];
+   if (request->interpretRawValue == SNMP_RAWTYPE_NONE)
+   {
+      bool convert = true;
+      v->getValueAsPrintableString(buffer, MAX_LINE_SIZE, &convert);
+   }
+   else
+   {
+      BYTE rawValue[1024];
+      memset(rawValue, 0, 1024);
+      v->getRawValue(rawValue, 1024);
+      FormatRawSNMPValue(rawValue, request->interpretRawValue, buffer, MAX_LINE_SIZE);
+   }
+   request->value = MemCopyString(buffer);
+   request->error = DCE_SUCCESS;
+}
+
+/**
+ * Read values for given metrics using single multi-varbind GET request. Request is split
+ * if device responds with tooBig error, and variables rejected by device (SNMPv1 behavior)
+ * are excluded and request is repeated for remaining variables. Returns transport level error code.
+ */
+static uint32_t ReadSNMPMetrics(SNMP_Transport *snmp, SNMPMetricRequest *requests, int count)
+{
+   if (count == 0)
+      return SNMP_ERR_SUCCESS;
+
+   SNMP_PDU request(SNMP_GET_REQUEST, SnmpNewRequestId(), snmp->getSnmpVersion());
+   for(int i = 0; i < count; i++)
+      request.bindVariable(new SNMP_Variable(requests[i].oid, requests[i].oidLength));
+
+   SNMP_PDU *response;
+   uint32_t rc = snmp->doRequest(&request, &response, SnmpGetDefaultTimeout(), 3);
+   if (rc != SNMP_ERR_SUCCESS)
+   {
+      for(int i = 0; i < count; i++)
+         requests[i].error = DCErrorFromSNMPError(rc);
+      return rc;
+   }
+
+   uint32_t errorIndex = response->getErrorIndex();
+   if (response->getErrorCode() == SNMP_PDU_ERR_SUCCESS)
+   {
+      if (response->getNumVariables() == count)
+      {
+         for(int i = 0; i < count; i++)
+            StoreSNMPMetricValue(&requests[i], response->getVariable(i));
+      }
+      else
+      {
+         for(int i = 0; i < count; i++)
+            requests[i].error = DCErrorFromSNMPError(SNMP_ERR_AGENT);
+      }
+   }
+   else if ((response->getErrorCode() == SNMP_PDU_ERR_TOO_BIG) && (count > 1))
+   {
+      delete_and_null(response);
+      int half = count / 2;
+      rc = ReadSNMPMetrics(snmp, requests, half);
+      if (rc == SNMP_ERR_SUCCESS)
+      {
+         rc = ReadSNMPMetrics(snmp, &requests[half], count - half);
+      }
+      else
+      {
+         for(int i = half; i < count; i++)
+            requests[i].error = DCErrorFromSNMPError(rc);
+      }
+   }
+   else if ((count > 1) && (errorIndex > 0) && (errorIndex <= static_cast<uint32_t>(count)))
+   {
+      int index = static_cast<int>(errorIndex) - 1;
+      requests[index].error = DCErrorFromSNMPError((response->getErrorCode() == SNMP_PDU_ERR_NO_SUCH_NAME) ? SNMP_ERR_NO_OBJECT : SNMP_ERR_AGENT);
+      delete_and_null(response);
+      rc = ReadSNMPMetrics(snmp, requests, index);
+      if (rc == SNMP_ERR_SUCCESS)
+      {
+         rc = ReadSNMPMetrics(snmp, &requests[index + 1], count - index - 1);
+      }
+      else
+      {
+         for(int i = index + 1; i < count; i++)
+            requests[i].error = DCErrorFromSNMPError(rc);
+      }
+   }
+   else
+   {
+      for(int i = 0; i < count; i++)
+         requests[i].error = DCErrorFromSNMPError((response->getErrorCode() == SNMP_PDU_ERR_NO_SUCH_NAME) ? SNMP_ERR_NO_OBJECT : SNMP_ERR_AGENT);
+   }
+   delete response;
+   return rc;
+}
+
+/**
+ * Get multiple DCI values via SNMP using multi-varbind GET requests. Error code
+ * and collected value (if successful) will be set in each request element.
+ */
+void Node::getMetricsFromSNMP(uint16_t port, SNMP_Version version, SNMPMetricRequest *requests, int count, int maxVarbinds)
+{
+   for(int i = 0; i < count; i++)
+      requests[i].value = nullptr;
+
+   if ((((m_state & NSF_SNMP_UNREACHABLE) || !(m_capabilities & NC_IS_SNMP)) && (port == 0)) ||
+       (m_state & DCSF_UNREACHABLE) ||
+       (m_flags & NF_DISABLE_SNMP))
+   {
+      for(int i = 0; i < count; i++)
+         requests[i].error = DCErrorFromSNMPError(SNMP_ERR_COMM);
+      nxlog_debug_tag(_T("obj.dc.snmp"), 7, _T("Node(%s)->getMetricsFromSNMP(): SNMP is not available"), m_name);
+      return;
+   }
+
+   uint32_t snmpResult;
+   SNMP_Transport *snmp = createSnmpTransport(port, version);
+   if (snmp != nullptr)
+   {
+      if (maxVarbinds < 1)
+         maxVarbinds = 1;
+      snmpResult = SNMP_ERR_SUCCESS;
+      int start;
+      for(start = 0; (start < count) && (snmpResult == SNMP_ERR_SUCCESS); start += maxVarbinds)
+         snmpResult = ReadSNMPMetrics(snmp, &requests[start], std::min(maxVarbinds, count - start));
+
+      // Remaining requests are not sent if device is not responding
+      for(int i = start; i < count; i++)
+         requests[i].error = DCErrorFromSNMPError(snmpResult);
+      delete snmp;
+   }
+   else
+   {
+      snmpResult = SNMP_ERR_COMM;
+      for(int i = 0; i < count; i++)
+         requests[i].error = DCErrorFromSNMPError(snmpResult);
+   }
+   nxlog_debug_tag(_T("obj.dc.snmp"), 7, _T("Node(%s)->getMetricsFromSNMP(): %d metrics, %d per request, snmpResult=%u"), m_name, count, maxVarbinds, snmpResult);
+}
+
 /**
  * Read one row for SNMP table
  */
@@ -6366,6 +6526,132 @@ DataCollectionError Node::getMetricFromAgent(const TCHAR *name, TCHAR *buffer, s
    return rc;
 }
 
+/**
+ * Convert agent error code for single metric to data collection error
+ */
+static DataCollectionError DCErrorFromAgentError(uint32_t agentError)
+{
+   switch(agentError)
+   {
+      case ERR_SUCCESS:
+         return DCE_SUCCESS;
+      case ERR_UNKNOWN_METRIC:
+      case ERR_UNSUPPORTED_METRIC:
+         return DCE_NOT_SUPPORTED;
+      case ERR_NO_SUCH_INSTANCE:
+         return DCE_NO_SUCH_INSTANCE;
+      case ERR_INTERNAL_ERROR:
+         return DCE_COLLECTION_ERROR;
+      default:
+         return DCE_COMM_ERROR;
+   }
+}
+
+/**
+ * Get multiple metrics from agent. Metrics are requested in chunks of up to maxBatchSize metrics
+ * (but not more than MAX_BULK_METRIC_REQUEST_SIZE) using bulk requests. Falls back to individual requests if agent does not support bulk requests.
+ * Error code and value (dynamically allocated, nullptr on error) are stored in each request element.
+ */
+void Node::getMetricsFromAgent(AgentMetricRequest *requests, int count, int maxBatchSize)
+{
+   for(int i = 0; i < count; i++)
+   {
+      requests[i].error = DCE_COMM_ERROR;
+      requests[i].value = nullptr;
+   }
+
+   if ((m_state & NSF_AGENT_UNREACHABLE) ||
+       (m_state & DCSF_UNREACHABLE) ||
+       (m_flags & NF_DISABLE_NXCP) ||
+       !(m_capabilities & NC_IS_NATIVE_AGENT))
+      return;
+
+   shared_ptr<AgentConnectionEx> conn = getAgentConnection();
+   if (conn == nullptr)
+      return;
+
+   if (m_agentBulkMetricsUnsupported)
+   {
+      // Older agent, read metrics one by one
+      for(int i = 0; i < count; i++)
+      {
+         AgentMetricRequest *r = &requests[i];
+         r->value = MemAllocArrayNoInit<TCHAR>(MAX_RESULT_LENGTH);
+         r->error = getMetricFromAgent(r->name, r->value, MAX_RESULT_LENGTH);
+         if (r->error != DCE_SUCCESS)
+            MemFreeAndNull(r->value);
+      }
+      return;
+   }
+
+   if (maxBatchSize < 1)
+      maxBatchSize = 1;
+   else if (maxBatchSize > MAX_BULK_METRIC_REQUEST_SIZE)
+      maxBatchSize = MAX_BULK_METRIC_REQUEST_SIZE;
+   TCHAR **values = MemAllocArrayNoInit<TCHAR*>(std::min(count, maxBatchSize));
+   uint32_t *errors = MemAllocArrayNoInit<uint32_t>(std::min(count, maxBatchSize));
+   for(int start = 0; start < count; start += maxBatchSize)
+   {
+      int chunkSize = std::min(count - start, maxBatchSize);
+      StringList names;
+      for(int i = 0; i < chunkSize; i++)
+         names.add(requests[start + i].name);
+
+      uint32_t rcc = ERR_NOT_CONNECTED;
+      int retry = 3;
+      while(retry-- > 0)
+      {
+         // Do not retry on timeout - request timeout is already scaled by number of metrics
+         rcc = conn->getParameters(names, values, errors);
+         if ((rcc != ERR_NOT_CONNECTED) && (rcc != ERR_CONNECTION_BROKEN))
+            break;
+         conn = getAgentConnection();
+         if (conn == nullptr)
+            break;
+      }
+
+      nxlog_debug_tag(_T("obj.dc.agent"), 7, _T("Node(%s)->getMetricsFromAgent(): bulk request for %d metrics completed (rcc=%u)"), m_name, chunkSize, rcc);
+      if (rcc == ERR_SUCCESS)
+      {
+         setLastAgentCommTime();
+         for(int i = 0; i < chunkSize; i++)
+         {
+            AgentMetricRequest *r = &requests[start + i];
+            r->error = DCErrorFromAgentError(errors[i]);
+            r->value = values[i];
+            if ((r->error == DCE_SUCCESS) && (r->value == nullptr))
+               r->error = DCE_COLLECTION_ERROR;
+         }
+      }
+      else if (rcc == ERR_UNKNOWN_COMMAND)
+      {
+         // Older agent, read remaining metrics one by one and do not try bulk requests until reconnect
+         nxlog_debug_tag(_T("obj.dc.agent"), 5, _T("Node(%s)->getMetricsFromAgent(): agent does not support bulk metric requests"), m_name);
+         m_agentBulkMetricsUnsupported = true;
+         for(int i = start; i < count; i++)
+         {
+            AgentMetricRequest *r = &requests[i];
+            r->value = MemAllocArrayNoInit<TCHAR>(MAX_RESULT_LENGTH);
+            r->error = getMetricFromAgent(r->name, r->value, MAX_RESULT_LENGTH);
+            if (r->error != DCE_SUCCESS)
+               MemFreeAndNull(r->value);
+         }
+         break;
+      }
+      else if (rcc == ERR_REQUEST_TIMEOUT)
+      {
+         // Few slow metrics can cause timeout for whole chunk, so only metrics from this chunk will get DCE_COMM_ERROR
+         nxlog_debug_tag(_T("obj.dc.agent"), 5, _T("Node(%s)->getMetricsFromAgent(): bulk request for %d metrics timed out"), m_name, chunkSize);
+      }
+      else
+      {
+         break;   // Communication error, remaining metrics will get DCE_COMM_ERROR
+      }
+   }
+   MemFree(values);
+   MemFree(errors);
+}
+
 /**
  * Helper function to get metric from agent as double
  */
@@ -6824,6 +7110,52 @@ static DataCollectionError GetEventProcessorStatistic(const TCHAR *param, int ty
    return DCE_SUCCESS;
 }
 
+/**
+ * Get statistic for specific syslog processor
+ */
+static DataCollectionError GetSyslogProcessorStatistic(const TCHAR *param, int type, TCHAR *value)
+{
+   TCHAR pidText[64];
+   if (!AgentGetParameterArg(param, 1, pidText, 64))
+      return DCE_NOT_SUPPORTED;
+   int pid = _tcstol(pidText, nullptr, 0);
+   if (pid < 1)
+      return DCE_NOT_SUPPORTED;
+
+   StructArray<SyslogProcessingThreadStats> *stats = GetSyslogProcessingThreadStats();
+   if (pid > stats->size())
+   {
+      delete stats;
+      return DCE_NOT_SUPPORTED;
+   }
+
+   auto s = stats->get(pid - 1);
+   switch(type)
+   {
+      case 'M':
+         ret_uint(value, s->averageMatchTime);
+         break;
+      case 'P':
+         ret_uint64(value, s->processedMessages);
+         break;
+      case 'Q':
+         ret_uint(value, s->queueSize);
+         break;
+      case 'S':
+         ret_uint(value, s->averageParseTime);
+         break;
+      case 'W':
+         ret_uint(value, s->averageWaitTime);
+         break;
+      case 'X':
+         ret_uint(value, s->maxWaitTime);
+         break;
+   }
+
+   delete stats;
+   return DCE_SUCCESS;
+}
+
 /**
  * Get value for server's internal parameter
  */
@@ -7018,6 +7350,24 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
       {
          ret_int(buffer, GetAlarmCount());
       }
+      else if (!_tcsicmp(name, _T("Server.AccessRightsCache.Hits")))
+      {
+         AccessRightsCacheStatistics stats;
+         GetAccessRightsCacheStatistics(&stats);
+         ret_uint64(buffer, stats.hits);
+      }
+      else if (!_tcsicmp(name, _T("Server.AccessRightsCache.Invalidations")))
+      {
+         AccessRightsCacheStatistics stats;
+         GetAccessRightsCacheStatistics(&stats);
+         ret_uint64(buffer, stats.invalidations);
+      }
+      else if (!_tcsicmp(name, _T("Server.AccessRightsCache.Misses")))
+      {
+         AccessRightsCacheStatistics stats;
+         GetAccessRightsCacheStatistics(&stats);
+         ret_uint64(buffer, stats.misses);
+      }
       else if (!_tcsicmp(name, _T("Server.AgentTunnels.Bound.AgentProxy")))
       {
          ret_int(buffer, GetTunnelCount(TunnelCapabilityFilter::AGENT_PROXY, true));
@@ -7142,6 +7492,18 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
       {
          _sntprintf(buffer, size, UINT64_FMT, g_rawDataWriteRequests);
       }
+      else if (!_tcsicmp(name, _T("Server.DBWriter.Records.IData")))
+      {
+         uint64_t statements, records;
+         GetIDataWriterPerfCounters(&statements, &records);
+         _sntprintf(buffer, size, UINT64_FMT, records);
+      }
+      else if (!_tcsicmp(name, _T("Server.DBWriter.Statements.IData")))
+      {
+         uint64_t statements, records;
+         GetIDataWriterPerfCounters(&statements, &records);
+         _sntprintf(buffer, size, UINT64_FMT, statements);
+      }
       else if (MatchString(_T("Server.EventProcessor.AverageWaitTime(*)"), name, false))
       {
          rc = GetEventProcessorStatistic(name, 'W', buffer);
@@ -7190,6 +7552,12 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
       {
          ret_uint64(buffer, GetDCICacheMemoryUsage());
       }
+      else if (!_tcsicmp(name, _T("Server.MemoryUsage.ObjectAncestorIndex")))
+      {
+         ObjectAncestorIndexStats stats;
+         GetObjectAncestorIndexStats(&stats);
+         ret_uint64(buffer, stats.memoryUsage);
+      }
       else if (!_tcsicmp(name, _T("Server.MemoryUsage.RawDataWriter")))
       {
          ret_uint64(buffer, GetRawDataWriterMemoryUsage());
@@ -7210,6 +7578,12 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
       {
          ret_uint(buffer, static_cast<uint32_t>(g_idxObjectById.size()));
       }
+      else if (MatchString(_T("Server.PDS.AverageLatency(*)"), name, false))
+      {
+         TCHAR driver[64];
+         AgentGetParameterArg(name, 1, driver, 64);
+         rc = GetPerfDataStorageQueueMetric(driver, _T("AverageLatency"), buffer);
+      }
       else if (MatchString(_T("Server.PDS.DriverStat(*)"), name, false))
       {
          TCHAR driver[64], metric[64];
@@ -7217,6 +7591,24 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
          AgentGetParameterArg(name, 2, metric, 64);
          rc = GetPerfDataStorageDriverMetric(driver, metric, buffer);
       }
+      else if (MatchString(_T("Server.PDS.DroppedValues(*)"), name, false))
+      {
+         TCHAR driver[64];
+         AgentGetParameterArg(name, 1, driver, 64);
+         rc = GetPerfDataStorageQueueMetric(driver, _T("DroppedValues"), buffer);
+      }
+      else if (MatchString(_T("Server.PDS.QueueSize(*)"), name, false))
+      {
+         TCHAR driver[64];
+         AgentGetParameterArg(name, 1, driver, 64);
+         rc = GetPerfDataStorageQueueMetric(driver, _T("QueueSize"), buffer);
+      }
+      else if (MatchString(_T("Server.PDS.SpilledValues(*)"), name, false))
+      {
+         TCHAR driver[64];
+         AgentGetParameterArg(name, 1, driver, 64);
+         rc = GetPerfDataStorageQueueMetric(driver, _T("SpilledValues"), buffer);
+      }
       else if (MatchString(_T("Server.QueueSize.Average(*)"), name, false))
       {
          rc = GetQueueStatistic(name, StatisticType::AVERAGE, buffer);
@@ -7245,6 +7637,40 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
       {
          _sntprintf(buffer, size, UINT64_FMT, g_windowsEventsReceived);
       }
+      else if (MatchString(_T("Server.Scripts.AverageExecutionTime(*)"), name, false))
+      {
+         TCHAR scriptName[256];
+         AgentGetParameterArg(name, 1, scriptName, 256);
+         uint64_t runs, averageTime;
+         if (GetScriptExecutionStatistics(scriptName, &runs, &averageTime))
+            ret_uint64(buffer, averageTime);
+         else
+            rc = DCE_NO_SUCH_INSTANCE;
+      }
+      else if (MatchString(_T("Server.Scripts.Executions(*)"), name, false))
+      {
+         TCHAR scriptName[256];
+         AgentGetParameterArg(name, 1, scriptName, 256);
+         uint64_t runs, averageTime;
+         if (GetScriptExecutionStatistics(scriptName, &runs, &averageTime))
+            ret_uint64(buffer, runs);
+         else
+            rc = DCE_NO_SUCH_INSTANCE;
+      }
+      else if (!_tcsicmp(name, _T("Server.ScriptVMPool.HitRatio")))
+      {
+         uint64_t hits, misses;
+         uint32_t idleVMs;
+         GetScriptVMPoolStatistics(&hits, &misses, &idleVMs);
+         ret_uint(buffer, (hits + misses > 0) ? static_cast<uint32_t>(hits * 100 / (hits + misses)) : 0);
+      }
+      else if (!_tcsicmp(name, _T("Server.ScriptVMPool.IdleVMs")))
+      {
+         uint64_t hits, misses;
+         uint32_t idleVMs;
+         GetScriptVMPoolStatistics(&hits, &misses, &idleVMs);
+         ret_uint(buffer, idleVMs);
+      }
       else if (!_tcsicmp(_T("Server.SyncerRunTime.Average"), name))
       {
          ret_int64(buffer, GetSyncerRunTime(StatisticType::AVERAGE));
@@ -7261,6 +7687,30 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
       {
          ret_int64(buffer, GetSyncerRunTime(StatisticType::MIN));
       }
+      else if (MatchString(_T("Server.SyslogProcessor.AverageMatchTime(*)"), name, false))
+      {
+         rc = GetSyslogProcessorStatistic(name, 'M', buffer);
+      }
+      else if (MatchString(_T("Server.SyslogProcessor.AverageParseTime(*)"), name, false))
+      {
+         rc = GetSyslogProcessorStatistic(name, 'S', buffer);
+      }
+      else if (MatchString(_T("Server.SyslogProcessor.AverageWaitTime(*)"), name, false))
+      {
+         rc = GetSyslogProcessorStatistic(name, 'W', buffer);
+      }
+      else if (MatchString(_T("Server.SyslogProcessor.MaxWaitTime(*)"), name, false))
+      {
+         rc = GetSyslogProcessorStatistic(name, 'X', buffer);
+      }
+      else if (MatchString(_T("Server.SyslogProcessor.ProcessedMessages(*)"), name, false))
+      {
+         rc = GetSyslogProcessorStatistic(name, 'P', buffer);
+      }
+      else if (MatchString(_T("Server.SyslogProcessor.QueueSize(*)"), name, false))
+      {
+         rc = GetSyslogProcessorStatistic(name, 'Q', buffer);
+      }
       else if (MatchString(_T("Server.ThreadPool.ActiveRequests(*)"), name, false))
       {
          rc = GetThreadPoolStat(THREAD_POOL_ACTIVE_REQUESTS, name, buffer);
@@ -628,1556 +628,2344 @@ NXSL_METHOD_DEFINITION(NetObj, unmanage)
 }
 
 /**
- * NXSL class NetObj: constructor
+ * NetObj::alarms attribute
  */
-NXSL_NetObjClass::NXSL_NetObjClass() : NXSL_Class()
+NXSL_ATTRIBUTE_DEFINITION(NetObj, alarms)
 {
-   setName(_T("NetObj"));
-
-   NXSL_REGISTER_METHOD(NetObj, bind, 1);
-   NXSL_REGISTER_METHOD(NetObj, bindTo, 1);
-   NXSL_REGISTER_METHOD(NetObj, clearGeoLocation, 0);
-   NXSL_REGISTER_METHOD(NetObj, delete, 0);
-   NXSL_REGISTER_METHOD(NetObj, deleteCustomAttribute, 1);
-   NXSL_REGISTER_METHOD(NetObj, isDirectChild, 1);
-   NXSL_REGISTER_METHOD(NetObj, isDirectParent, 1);
-   NXSL_REGISTER_METHOD(NetObj, enterMaintenance, -1);
-   NXSL_REGISTER_METHOD(NetObj, expandString, 1);
-   NXSL_REGISTER_METHOD(NetObj, getCustomAttribute, 1);
-   NXSL_REGISTER_METHOD(NetObj, getResponsibleUsers, 1);
-   NXSL_REGISTER_METHOD(NetObj, isChild, 1);
-   NXSL_REGISTER_METHOD(NetObj, isParent, 1);
-   NXSL_REGISTER_METHOD(NetObj, leaveMaintenance, 0);
-   NXSL_REGISTER_METHOD(NetObj, manage, 0);
-   NXSL_REGISTER_METHOD(NetObj, rename, 1);
-   NXSL_REGISTER_METHOD(NetObj, setAlias, 1);
-   NXSL_REGISTER_METHOD(NetObj, setCategory, 1);
-   NXSL_REGISTER_METHOD(NetObj, setComments, 1);
-   NXSL_REGISTER_METHOD(NetObj, setCustomAttribute, -1);
-   NXSL_REGISTER_METHOD(NetObj, setGeoLocation, 1);
-   NXSL_REGISTER_METHOD(NetObj, setMapImage, 1);
-   NXSL_REGISTER_METHOD(NetObj, setNameOnMap, 1);
-   NXSL_REGISTER_METHOD(NetObj, setStatusCalculation, -1);
-   NXSL_REGISTER_METHOD(NetObj, setStatusPropagation, -1);
-   NXSL_REGISTER_METHOD(NetObj, unbind, 1);
-   NXSL_REGISTER_METHOD(NetObj, unbindFrom, 1);
-   NXSL_REGISTER_METHOD(NetObj, unmanage, 0);
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   ObjectArray<Alarm> *alarms = GetAlarms(netobj->getId(), true);
+   alarms->setOwner(Ownership::False);
+   NXSL_Array *array = new NXSL_Array(vm);
+   for(int i = 0; i < alarms->size(); i++)
+      array->append(vm->createValue(vm->createObject(&g_nxslAlarmClass, alarms->get(i))));
+   value = vm->createValue(array);
+   delete alarms;
+   return value;
 }
 
 /**
- * Object destruction handler
+ * NetObj::alias attribute
  */
-void NXSL_NetObjClass::onObjectDelete(NXSL_Object *object)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, alias)
 {
-   delete static_cast<shared_ptr<NetObj>*>(object->getData());
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getAlias());
 }
 
 /**
- * NXSL class NetObj: get attribute
+ * NetObj::backupZoneProxy attribute
  */
-NXSL_Value *NXSL_NetObjClass::getAttr(NXSL_Object *_object, const NXSL_Identifier& attr)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, backupZoneProxy)
 {
-   NXSL_Value *value = NXSL_Class::getAttr(_object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = _object->vm();
-   auto object = SharedObjectFromData<NetObj>(_object);
-   if (NXSL_COMPARE_ATTRIBUTE_NAME("alarms"))
-   {
-      ObjectArray<Alarm> *alarms = GetAlarms(object->getId(), true);
-      alarms->setOwner(Ownership::False);
-      NXSL_Array *array = new NXSL_Array(vm);
-      for(int i = 0; i < alarms->size(); i++)
-         array->append(vm->createValue(vm->createObject(&g_nxslAlarmClass, alarms->get(i))));
-      value = vm->createValue(array);
-      delete alarms;
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("alias"))
-   {
-      value = vm->createValue(object->getAlias());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("backupZoneProxy"))
-   {
-      uint32_t id = object->getAssignedZoneProxyId(true);
-      if (id != 0)
-      {
-         shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
-         value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("backupZoneProxyId"))
-   {
-      value = vm->createValue(object->getAssignedZoneProxyId(true));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("category"))
-   {
-      if (object->getCategoryId() != 0)
-      {
-         shared_ptr<ObjectCategory> category = GetObjectCategory(object->getCategoryId());
-         value = (category != nullptr) ? vm->createValue(category->getName()) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("categoryId"))
-   {
-      value = vm->createValue(object->getCategoryId());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("children"))
-   {
-      value = object->getChildrenForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("city"))
-   {
-      value = vm->createValue(object->getPostalAddress().getCity());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("comments"))
-   {
-      value = vm->createValue(object->getComments());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("country"))
-   {
-      value = vm->createValue(object->getPostalAddress().getCountry());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("creationTime"))
-   {
-      value = vm->createValue(static_cast<INT64>(object->getCreationTime()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("customAttributes"))
-   {
-      value = object->getCustomAttributesForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("district"))
-   {
-      value = vm->createValue(object->getPostalAddress().getDistrict());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("geolocation"))
-   {
-      value = NXSL_GeoLocationClass::createObject(vm, object->getGeoLocation());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("guid"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(object->getGuid().toString(buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("id"))
-   {
-      value = vm->createValue(object->getId());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ipAddr"))
-   {
-      TCHAR buffer[64];
-      object->getPrimaryIpAddress().toString(buffer);
-      value = vm->createValue(buffer);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isInMaintenanceMode"))
-   {
-      value = vm->createValue(object->isInMaintenanceMode());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("maintenanceInitiator"))
-   {
-      value = vm->createValue(object->getMaintenanceInitiator());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("mapImage"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(object->getMapImage().toString(buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("name"))
-   {
-      value = vm->createValue(object->getName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("nameOnMap"))
-   {
-      value = vm->createValue(object->getNameOnMap());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("parents"))
-   {
-      value = object->getParentsForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("postcode"))
-   {
-      value = vm->createValue(object->getPostalAddress().getPostCode());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("primaryZoneProxy"))
-   {
-      UINT32 id = object->getAssignedZoneProxyId(false);
-      if (id != 0)
-      {
-         shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
-         value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("primaryZoneProxyId"))
-   {
-      value = vm->createValue(object->getAssignedZoneProxyId(false));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("region"))
-   {
-      value = vm->createValue(object->getPostalAddress().getRegion());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("responsibleUsers"))
-   {
-      NXSL_Array *array = new NXSL_Array(vm);
-      unique_ptr<StructArray<ResponsibleUser>> responsibleUsers = object->getAllResponsibleUsers();
-      unique_ptr<ObjectArray<UserDatabaseObject>> userDB = FindUserDBObjects(*responsibleUsers);
-      userDB->setOwner(Ownership::False);
-      for(int i = 0; i < userDB->size(); i++)
-      {
-         array->append(userDB->get(i)->createNXSLObject(vm));
-      }
-      value = vm->createValue(array);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("state"))
-   {
-      value = vm->createValue(object->getState());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("status"))
-   {
-      value = vm->createValue((LONG)object->getStatus());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("streetAddress"))
-   {
-      value = vm->createValue(object->getPostalAddress().getStreetAddress());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("type"))
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   uint32_t id = netobj->getAssignedZoneProxyId(true);
+   if (id != 0)
    {
-      value = vm->createValue((LONG)object->getObjectClass());
+      shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
+      value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
    }
-   else if (object != nullptr)   // Object can be null if attribute scan is running
+   else
    {
-#ifdef UNICODE
-      WCHAR wattr[MAX_IDENTIFIER_LENGTH];
-      utf8_to_wchar(attr.value, -1, wattr, MAX_IDENTIFIER_LENGTH);
-      wattr[MAX_IDENTIFIER_LENGTH - 1] = 0;
-      value = object->getCustomAttributeForNXSL(vm, wattr);
-#else
-      value = object->getCustomAttributeForNXSL(vm, attr.value);
-#endif
+      value = vm->createValue();
    }
    return value;
 }
 
 /**
- * NXSL class Zone: constructor
+ * NetObj::backupZoneProxyId attribute
  */
-NXSL_SubnetClass::NXSL_SubnetClass() : NXSL_NetObjClass()
+NXSL_ATTRIBUTE_DEFINITION(NetObj, backupZoneProxyId)
 {
-   setName(_T("Subnet"));
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getAssignedZoneProxyId(true));
 }
 
 /**
- * NXSL class Zone: get attribute
+ * NetObj::category attribute
  */
-NXSL_Value *NXSL_SubnetClass::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, category)
 {
-   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = object->vm();
-   auto subnet = SharedObjectFromData<Subnet>(object);
-   if (NXSL_COMPARE_ATTRIBUTE_NAME("ipNetMask"))
-   {
-      value = vm->createValue(subnet->getIpAddress().getMaskBits());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSyntheticMask"))
-   {
-      value = vm->createValue(subnet->isSyntheticMask());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zone"))
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   if (netobj->getCategoryId() != 0)
    {
-      if (g_flags & AF_ENABLE_ZONING)
-      {
-         shared_ptr<Zone> zone = FindZoneByUIN(subnet->getZoneUIN());
-         if (zone != nullptr)
-         {
-            value = zone->createNXSLObject(vm);
-         }
-         else
-         {
-            value = vm->createValue();
-         }
-      }
-      else
-      {
-         value = vm->createValue();
-      }
+      shared_ptr<ObjectCategory> category = GetObjectCategory(netobj->getCategoryId());
+      value = (category != nullptr) ? vm->createValue(category->getName()) : vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zoneUIN"))
+   else
    {
-      value = vm->createValue(subnet->getZoneUIN());
+      value = vm->createValue();
    }
    return value;
 }
 
 /**
- * DataCollectionTarget::applyTemplate(object)
+ * NetObj::categoryId attribute
  */
-NXSL_METHOD_DEFINITION(DataCollectionTarget, applyTemplate)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, categoryId)
 {
-   shared_ptr<DataCollectionTarget> thisObject = *static_cast<shared_ptr<DataCollectionTarget>*>(object->getData());
-
-   if (!argv[0]->isObject())
-      return NXSL_ERR_NOT_OBJECT;
-
-   NXSL_Object *nxslTemplate = argv[0]->getValueAsObject();
-   if (!nxslTemplate->getClass()->instanceOf(g_nxslTemplateClass.getName()))
-      return NXSL_ERR_BAD_CLASS;
-
-   static_cast<shared_ptr<Template>*>(nxslTemplate->getData())->get()->applyToTarget(thisObject);
-
-   *result = vm->createValue();
-   return 0;
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getCategoryId());
 }
 
 /**
- * enableConfigurationPolling(enabled) method
+ * NetObj::children attribute
  */
-NXSL_METHOD_DEFINITION(DataCollectionTarget, enableConfigurationPolling)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, children)
 {
-   return ChangeFlagMethod(object, argv[0], result, DCF_DISABLE_CONF_POLL, true);
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return netobj->getChildrenForNXSL(vm);
 }
 
 /**
- * enableDataCollection(enabled) method
+ * NetObj::city attribute
  */
-NXSL_METHOD_DEFINITION(DataCollectionTarget, enableDataCollection)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, city)
 {
-   return ChangeFlagMethod(object, argv[0], result, DCF_DISABLE_DATA_COLLECT, true);
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress().getCity());
 }
 
 /**
- * enableStatusPolling(enabled) method
+ * NetObj::comments attribute
  */
-NXSL_METHOD_DEFINITION(DataCollectionTarget, enableStatusPolling)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, comments)
 {
-   return ChangeFlagMethod(object, argv[0], result, DCF_DISABLE_STATUS_POLL, true);
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getComments());
 }
 
 /**
- * readInternalParameter(name) method
+ * NetObj::country attribute
  */
-NXSL_METHOD_DEFINITION(DataCollectionTarget, readInternalParameter)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, country)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   DataCollectionTarget *dct = static_cast<shared_ptr<DataCollectionTarget>*>(object->getData())->get();
-
-   TCHAR value[MAX_RESULT_LENGTH];
-   DataCollectionError rc = dct->getInternalMetric(argv[0]->getValueAsCString(), value, MAX_RESULT_LENGTH);
-   *result = (rc == DCE_SUCCESS) ? object->vm()->createValue(value) : object->vm()->createValue();
-   return 0;
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress().getCountry());
 }
 
 /**
- * DataCollectionTarget::removeTemplate(object)
+ * NetObj::creationTime attribute
  */
-NXSL_METHOD_DEFINITION(DataCollectionTarget, removeTemplate)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, creationTime)
 {
-   shared_ptr<DataCollectionTarget> thisObject = *static_cast<shared_ptr<DataCollectionTarget>*>(object->getData());
-
-   if (!argv[0]->isObject())
-      return NXSL_ERR_NOT_OBJECT;
-
-   NXSL_Object *nxslTemplate = argv[0]->getValueAsObject();
-   if (!nxslTemplate->getClass()->instanceOf(g_nxslTemplateClass.getName()))
-      return NXSL_ERR_BAD_CLASS;
-
-   auto tmpl = *static_cast<shared_ptr<Template>*>(nxslTemplate->getData());
-   tmpl->deleteChild(*thisObject);
-   thisObject->deleteParent(*tmpl);
-   tmpl->queueRemoveFromTarget(thisObject->getId(), true);
-
-   *result = vm->createValue();
-   return 0;
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(static_cast<INT64>(netobj->getCreationTime()));
 }
 
 /**
- * NXSL class DataCollectionTarget: constructor
+ * NetObj::customAttributes attribute
  */
-NXSL_DCTargetClass::NXSL_DCTargetClass() : NXSL_NetObjClass()
+NXSL_ATTRIBUTE_DEFINITION(NetObj, customAttributes)
 {
-   setName(_T("DataCollectionTarget"));
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return netobj->getCustomAttributesForNXSL(vm);
+}
 
-   NXSL_REGISTER_METHOD(DataCollectionTarget, applyTemplate, 1);
-   NXSL_REGISTER_METHOD(DataCollectionTarget, enableConfigurationPolling, 1);
-   NXSL_REGISTER_METHOD(DataCollectionTarget, enableDataCollection, 1);
-   NXSL_REGISTER_METHOD(DataCollectionTarget, enableStatusPolling, 1);
-   NXSL_REGISTER_METHOD(DataCollectionTarget, readInternalParameter, 1);
-   NXSL_REGISTER_METHOD(DataCollectionTarget, removeTemplate, 1);
+/**
+ * NetObj::district attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, district)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress().getDistrict());
 }
 
 /**
- * NXSL class Zone: get attribute
+ * NetObj::geolocation attribute
  */
-NXSL_Value *NXSL_DCTargetClass::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, geolocation)
 {
-   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return NXSL_GeoLocationClass::createObject(vm, netobj->getGeoLocation());
+}
 
-   NXSL_VM *vm = object->vm();
-   auto dcTarget = SharedObjectFromData<DataCollectionTarget>(object);
-   if (NXSL_COMPARE_ATTRIBUTE_NAME("templates"))
-   {
-      value = vm->createValue(dcTarget->getTemplatesForNXSL(vm));
-   }
+/**
+ * NetObj::guid attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, guid)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   TCHAR buffer[64];
+   value = vm->createValue(netobj->getGuid().toString(buffer));
    return value;
 }
 
 /**
- * NXSL class Zone: constructor
+ * NetObj::id attribute
  */
-NXSL_ZoneClass::NXSL_ZoneClass() : NXSL_NetObjClass()
+NXSL_ATTRIBUTE_DEFINITION(NetObj, id)
 {
-   setName(_T("Zone"));
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getId());
 }
 
 /**
- * NXSL class Zone: get attribute
+ * NetObj::ipAddr attribute
  */
-NXSL_Value *NXSL_ZoneClass::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, ipAddr)
 {
-   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = object->vm();
-   auto zone = SharedObjectFromData<Zone>(object);
-   if (NXSL_COMPARE_ATTRIBUTE_NAME("proxyNodes"))
-   {
-      NXSL_Array *array = new NXSL_Array(vm);
-      IntegerArray<uint32_t> proxies = zone->getAllProxyNodes();
-      for(int i = 0; i < proxies.size(); i++)
-      {
-         shared_ptr<NetObj> node = FindObjectById(proxies.get(i), OBJECT_NODE);
-         if (node != nullptr)
-            array->append(node->createNXSLObject(vm));
-      }
-      value = vm->createValue(array);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("proxyNodeIds"))
-   {
-      NXSL_Array *array = new NXSL_Array(vm);
-      IntegerArray<uint32_t> proxies = zone->getAllProxyNodes();
-      for(int i = 0; i < proxies.size(); i++)
-         array->append(vm->createValue(proxies.get(i)));
-      value = vm->createValue(array);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("uin"))
-   {
-      value = vm->createValue(zone->getUIN());
-   }
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   TCHAR buffer[64];
+   netobj->getPrimaryIpAddress().toString(buffer);
+   value = vm->createValue(buffer);
    return value;
 }
 
 /**
- * Node::createSNMPTransport(port, community, context) method
+ * NetObj::isInMaintenanceMode attribute
  */
-NXSL_METHOD_DEFINITION(Node, createSNMPTransport)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, isInMaintenanceMode)
 {
-   if (argc > 3)
-      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
-
-   if ((argc > 0) && !argv[0]->isNull() && !argv[0]->isInteger())
-      return NXSL_ERR_NOT_INTEGER;
-
-   if ((argc > 1) && !argv[1]->isNull() && !argv[1]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   if ((argc > 2) && !argv[2]->isNull() && !argv[2]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   uint16_t port = ((argc > 0) && argv[0]->isInteger()) ? static_cast<uint16_t>(argv[0]->getValueAsInt32()) : 0;
-   const char *community = ((argc > 1) && argv[1]->isString()) ? argv[1]->getValueAsMBString() : nullptr;
-   const char *context = ((argc > 2) && argv[2]->isString()) ? argv[2]->getValueAsMBString() : nullptr;
-   SNMP_Transport *t = static_cast<shared_ptr<Node> *>(object->getData())->get()->createSnmpTransport(port, SNMP_VERSION_DEFAULT, context, community);
-   *result = (t != nullptr) ? vm->createValue(vm->createObject(&g_nxslSnmpTransportClass, t)) : vm->createValue();
-   return 0;
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->isInMaintenanceMode());
 }
 
 /**
- * Web service custom request with data
+ * NetObj::maintenanceInitiator attribute
  */
-static int BaseWebServiceRequestWithData(WEB_SERVICE *websvc, int argc, NXSL_Value **argv,
-      NXSL_Value **result, NXSL_VM *vm, const HttpRequestMethod requestMethod)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, maintenanceInitiator)
 {
-   if (argc < 1)
-      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
-
-   const TCHAR *contentType = _T("application/json");
-   if (argc > 1)
-   {
-      if (!argv[1]->isString())
-      {
-         return NXSL_ERR_NOT_STRING;
-      }
-      else
-      {
-         contentType = argv[1]->getValueAsCString();
-      }
-   }
-
-   TCHAR *data = nullptr;
-   if (argv[0]->isObject(_T("JsonObject")) || argv[0]->isObject(_T("JsonArray")))
-   {
-      json_t *json = static_cast<json_t*>(argv[0]->getValueAsObject()->getData());
-      char *tmp = json_dumps(json, JSON_INDENT(3));
-#ifdef UNICODE
-      data = WideStringFromUTF8String(tmp);
-      MemFree(tmp);
-#else
-      data = tmp;
-#endif
-   }
-   else if (argv[0]->isString())
-   {
-      data = MemCopyString(argv[0]->getValueAsCString());
-   }
-   else
-   {
-      return NXSL_ERR_NOT_STRING;
-   }
-
-   StringList parameters;
-   for (int i = 2; i < argc; i++)
-      parameters.add(argv[i]->getValueAsCString());
-
-   WebServiceCallResult *response = websvc->first->makeCustomRequest(websvc->second, requestMethod, parameters, data, contentType);
-   *result = vm->createValue(vm->createObject(&g_nxslWebServiceCallResult, response));
-   MemFree(data);
-
-   return 0;
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getMaintenanceInitiator());
 }
 
 /**
- * Web service custom request with data
+ * NetObj::mapImage attribute
  */
-static int BaseWebServiceRequestWithoutData(WEB_SERVICE *websvc, int argc, NXSL_Value **argv,
-      NXSL_Value **result, NXSL_VM *vm, const HttpRequestMethod requestMethod)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, mapImage)
 {
-   StringList parameters;
-   for (int i = 0 ; i < argc; i++)
-      parameters.add(argv[i]->getValueAsCString());
-
-   WebServiceCallResult *response = websvc->first->makeCustomRequest(websvc->second, requestMethod, parameters, nullptr, nullptr);
-   *result = vm->createValue(vm->createObject(&g_nxslWebServiceCallResult, response));
-
-   return 0;
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   TCHAR buffer[64];
+   value = vm->createValue(netobj->getMapImage().toString(buffer));
+   return value;
 }
 
 /**
- * Node::callWebService(webSwcName, requestMethod, [postData], parameters...) method
+ * NetObj::name attribute
  */
-NXSL_METHOD_DEFINITION(Node, callWebService)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, name)
 {
-   if (argc < 2)
-      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
-
-   if ((argc > 0) && !argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   if ((argc > 1) && !argv[1]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   shared_ptr<WebServiceDefinition> d = FindWebServiceDefinition(argv[0]->getValueAsCString());
-   shared_ptr<Node> *node = static_cast<shared_ptr<Node>*>(object->getData());
-
-   if (d == nullptr)
-   {
-      WebServiceCallResult *webSwcResult = new WebServiceCallResult();
-      _tcsncpy(webSwcResult->errorMessage, _T("Web service definition not found"), WEBSVC_ERROR_TEXT_MAX_SIZE);
-      *result = vm->createValue(vm->createObject(&g_nxslWebServiceCallResult, webSwcResult));
-      return 0;
-   }
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getName());
+}
 
-   WEB_SERVICE websvc = WEB_SERVICE(d, *node);
-   const TCHAR *requestMethod = argv[1]->getValueAsCString();
-   if (!_tcsicmp(_T("GET"), requestMethod))
-   {
-      return BaseWebServiceRequestWithoutData(&websvc, argc - 2, argv  + 2, result, vm, HttpRequestMethod::_GET);
-   }
-   else if (!_tcsicmp(_T("DELETE"), requestMethod))
-   {
-      return BaseWebServiceRequestWithoutData(&websvc, argc - 2, argv  + 2, result, vm, HttpRequestMethod::_DELETE);
-   }
-   else if (!_tcsicmp(_T("POST"), requestMethod))
-   {
-      return BaseWebServiceRequestWithData(&websvc, argc - 2, argv  + 2, result, vm, HttpRequestMethod::_POST);
-   }
-   else if (!_tcsicmp(_T("PUT"), requestMethod))
-   {
-      return BaseWebServiceRequestWithData(&websvc, argc - 2, argv  + 2, result, vm, HttpRequestMethod::_PUT);
-   }
-   else if (!_tcsicmp(_T("PATCH"), requestMethod))
-   {
-      return BaseWebServiceRequestWithData(&websvc, argc - 2, argv  + 2, result, vm, HttpRequestMethod::_PATCH);
-   }
+/**
+ * NetObj::nameOnMap attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, nameOnMap)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getNameOnMap());
+}
 
-   WebServiceCallResult *webSwcResult = new WebServiceCallResult();
-   _tcslcpy(webSwcResult->errorMessage, _T("Invalid web service request method"), WEBSVC_ERROR_TEXT_MAX_SIZE);
-   *result = vm->createValue(vm->createObject(&g_nxslWebServiceCallResult, webSwcResult));
-   return 0;
+/**
+ * NetObj::parents attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, parents)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return netobj->getParentsForNXSL(vm);
 }
 
 /**
- * enable8021x(enabled) method
+ * NetObj::postcode attribute
  */
-NXSL_METHOD_DEFINITION(Node, enable8021xStatusPolling)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, postcode)
 {
-   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_8021X_STATUS_POLL, true);
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress().getPostCode());
 }
 
 /**
- * enableAgent(enabled) method
+ * NetObj::primaryZoneProxy attribute
  */
-NXSL_METHOD_DEFINITION(Node, enableAgent)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, primaryZoneProxy)
 {
-   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_NXCP, true);
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   UINT32 id = netobj->getAssignedZoneProxyId(false);
+   if (id != 0)
+   {
+      shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
+      value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
 }
 
 /**
- * enableDiscoveryPolling(enabled) method
+ * NetObj::primaryZoneProxyId attribute
  */
-NXSL_METHOD_DEFINITION(Node, enableDiscoveryPolling)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, primaryZoneProxyId)
 {
-   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_DISCOVERY_POLL, true);
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getAssignedZoneProxyId(false));
 }
 
 /**
- * enableEtherNetIP(enabled) method
+ * NetObj::region attribute
  */
-NXSL_METHOD_DEFINITION(Node, enableEtherNetIP)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, region)
 {
-   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_ETHERNET_IP, true);
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress().getRegion());
 }
 
 /**
- * enableIcmp(enabled) method
+ * NetObj::responsibleUsers attribute
  */
-NXSL_METHOD_DEFINITION(Node, enableIcmp)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, responsibleUsers)
 {
-   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_ICMP, true);
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   NXSL_Array *array = new NXSL_Array(vm);
+   unique_ptr<StructArray<ResponsibleUser>> responsibleUsers = netobj->getAllResponsibleUsers();
+   unique_ptr<ObjectArray<UserDatabaseObject>> userDB = FindUserDBObjects(*responsibleUsers);
+   userDB->setOwner(Ownership::False);
+   for(int i = 0; i < userDB->size(); i++)
+   {
+      array->append(userDB->get(i)->createNXSLObject(vm));
+   }
+   value = vm->createValue(array);
+   return value;
 }
 
 /**
- * enablePrimaryIPPing(enabled) method
+ * NetObj::state attribute
  */
-NXSL_METHOD_DEFINITION(Node, enablePrimaryIPPing)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, state)
 {
-   return ChangeFlagMethod(object, argv[0], result, NF_PING_PRIMARY_IP, false);
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getState());
 }
 
 /**
- * enableRoutingTablePolling(enabled) method
+ * NetObj::status attribute
  */
-NXSL_METHOD_DEFINITION(Node, enableRoutingTablePolling)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, status)
 {
-   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_ROUTE_POLL, true);
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue((LONG)netobj->getStatus());
 }
 
 /**
- * enableSnmp(enabled) method
+ * NetObj::streetAddress attribute
  */
-NXSL_METHOD_DEFINITION(Node, enableSnmp)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, streetAddress)
 {
-   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_SNMP, true);
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress().getStreetAddress());
 }
 
 /**
- * enableTopologyPolling(enabled) method
+ * NetObj::type attribute
  */
-NXSL_METHOD_DEFINITION(Node, enableTopologyPolling)
+NXSL_ATTRIBUTE_DEFINITION(NetObj, type)
 {
-   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_TOPOLOGY_POLL, true);
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue((LONG)netobj->getObjectClass());
 }
 
 /**
- * Node::executeSSHCommand(command) method
+ * NXSL class NetObj: constructor
  */
-NXSL_METHOD_DEFINITION(Node, executeSSHCommand)
+NXSL_NetObjClass::NXSL_NetObjClass() : NXSL_Class()
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
+   setName(_T("NetObj"));
 
-   Node *node = static_cast<shared_ptr<Node>*>(object->getData())->get();
-   uint32_t proxyId = node->getEffectiveSshProxy();
-   if (proxyId != 0)
-   {
-      shared_ptr<Node> proxyNode = static_pointer_cast<Node>(FindObjectById(proxyId, OBJECT_NODE));
-      if (proxyNode != nullptr)
-      {
-         TCHAR ipAddr[64];
-         StringBuffer request(_T("SSH.Command("));
-         request.append(node->getIpAddress().toString(ipAddr));
-         request.append(_T(':'));
-         request.append(node->getSshPort());
-         request.append(_T(",\""));
-         request.append(EscapeStringForAgent(node->getSshLogin()).cstr());
-         request.append(_T("\",\""));
-         request.append(EscapeStringForAgent(node->getSshPassword()).cstr());
-         request.append(_T("\",\""));
-         request.append(EscapeStringForAgent(argv[0]->getValueAsCString()).cstr());
-         request.append(_T("\",,"));
-         request.append(node->getSshKeyId());
-         request.append(_T(')'));
+   NXSL_REGISTER_METHOD(NetObj, bind, 1);
+   NXSL_REGISTER_METHOD(NetObj, bindTo, 1);
+   NXSL_REGISTER_METHOD(NetObj, clearGeoLocation, 0);
+   NXSL_REGISTER_METHOD(NetObj, delete, 0);
+   NXSL_REGISTER_METHOD(NetObj, deleteCustomAttribute, 1);
+   NXSL_REGISTER_METHOD(NetObj, isDirectChild, 1);
+   NXSL_REGISTER_METHOD(NetObj, isDirectParent, 1);
+   NXSL_REGISTER_METHOD(NetObj, enterMaintenance, -1);
+   NXSL_REGISTER_METHOD(NetObj, expandString, 1);
+   NXSL_REGISTER_METHOD(NetObj, getCustomAttribute, 1);
+   NXSL_REGISTER_METHOD(NetObj, getResponsibleUsers, 1);
+   NXSL_REGISTER_METHOD(NetObj, isChild, 1);
+   NXSL_REGISTER_METHOD(NetObj, isParent, 1);
+   NXSL_REGISTER_METHOD(NetObj, leaveMaintenance, 0);
+   NXSL_REGISTER_METHOD(NetObj, manage, 0);
+   NXSL_REGISTER_METHOD(NetObj, rename, 1);
+   NXSL_REGISTER_METHOD(NetObj, setAlias, 1);
+   NXSL_REGISTER_METHOD(NetObj, setCategory, 1);
+   NXSL_REGISTER_METHOD(NetObj, setComments, 1);
+   NXSL_REGISTER_METHOD(NetObj, setCustomAttribute, -1);
+   NXSL_REGISTER_METHOD(NetObj, setGeoLocation, 1);
+   NXSL_REGISTER_METHOD(NetObj, setMapImage, 1);
+   NXSL_REGISTER_METHOD(NetObj, setNameOnMap, 1);
+   NXSL_REGISTER_METHOD(NetObj, setStatusCalculation, -1);
+   NXSL_REGISTER_METHOD(NetObj, setStatusPropagation, -1);
+   NXSL_REGISTER_METHOD(NetObj, unbind, 1);
+   NXSL_REGISTER_METHOD(NetObj, unbindFrom, 1);
+   NXSL_REGISTER_METHOD(NetObj, unmanage, 0);
 
-         StringList *list;
-         uint32_t rcc = proxyNode->getListFromAgent(request, &list);
-         *result = (rcc == DCE_SUCCESS) ? vm->createValue(new NXSL_Array(vm, list)) : vm->createValue();
-         delete list;
-      }
-      else
-      {
-         *result = vm->createValue();
-      }
-   }
-   else
-   {
-      *result = vm->createValue();
-   }
-   return 0;
+   NXSL_REGISTER_ATTRIBUTE(NetObj, alarms);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, alias);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, backupZoneProxy);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, backupZoneProxyId);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, category);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, categoryId);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, children);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, city);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, comments);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, country);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, creationTime);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, customAttributes);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, district);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, geolocation);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, guid);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, id);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, ipAddr);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, isInMaintenanceMode);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, maintenanceInitiator);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, mapImage);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, name);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, nameOnMap);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, parents);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, postcode);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, primaryZoneProxy);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, primaryZoneProxyId);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, region);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, responsibleUsers);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, state);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, status);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, streetAddress);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, type);
 }
 
 /**
- * Node::getInterface(interfaceId) method
- * Interface ID could be ifIndex, name, or MAC address
+ * Object destruction handler
  */
-NXSL_METHOD_DEFINITION(Node, getInterface)
+void NXSL_NetObjClass::onObjectDelete(NXSL_Object *object)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   shared_ptr<Interface> iface;
-   if (argv[0]->isInteger())  // Assume interface index
-   {
-      iface = static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByIndex(argv[0]->getValueAsUInt32());
-   }
-   else
-   {
-      MacAddress macAddr = MacAddress::parse(argv[0]->getValueAsCString());
-      if (macAddr.isValid() && macAddr.length() >= 6)
-         iface = static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByMAC(macAddr);
-      else
-         iface = static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByName(argv[0]->getValueAsCString());
-   }
-   *result = (iface != nullptr) ? iface->createNXSLObject(vm) : vm->createValue();
-   return 0;
+   delete static_cast<shared_ptr<NetObj>*>(object->getData());
 }
 
 /**
- * Node::getInterfaceByIndex(ifIndex) method
+ * NXSL class NetObj: get attribute
  */
-NXSL_METHOD_DEFINITION(Node, getInterfaceByIndex)
+NXSL_Value *NXSL_NetObjClass::getAttr(NXSL_Object *_object, const NXSL_Identifier& attr)
 {
-   if (!argv[0]->isInteger())
-      return NXSL_ERR_NOT_INTEGER;
+   NXSL_Value *value = NXSL_Class::getAttr(_object, attr);
+   if (value != nullptr)
+      return value;
 
-   shared_ptr<Interface> iface = static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByIndex(argv[0]->getValueAsUInt32());
-   *result = (iface != nullptr) ? iface->createNXSLObject(vm) : vm->createValue();
-   return 0;
+   auto object = SharedObjectFromData<NetObj>(_object);
+   if (object != nullptr)   // Object can be null if attribute scan is running
+   {
+#ifdef UNICODE
+      WCHAR wattr[MAX_IDENTIFIER_LENGTH];
+      utf8_to_wchar(attr.value, -1, wattr, MAX_IDENTIFIER_LENGTH);
+      wattr[MAX_IDENTIFIER_LENGTH - 1] = 0;
+      value = object->getCustomAttributeForNXSL(_object->vm(), wattr);
+#else
+      value = object->getCustomAttributeForNXSL(_object->vm(), attr.value);
+#endif
+   }
+   return value;
 }
 
+
 /**
- * Node::getInterfaceByMACAddress(macAddress) method
+ * NXSL class Zone: constructor
  */
-NXSL_METHOD_DEFINITION(Node, getInterfaceByMACAddress)
+NXSL_SubnetClass::NXSL_SubnetClass() : NXSL_NetObjClass()
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   MacAddress macAddr = MacAddress::parse(argv[0]->getValueAsCString());
-   shared_ptr<Interface> iface = macAddr.isValid() ? static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByMAC(macAddr) : shared_ptr<Interface>();
-   *result = (iface != nullptr) ? iface->createNXSLObject(vm) : vm->createValue();
-   return 0;
+   setName(_T("Subnet"));
 }
 
 /**
- * Node::getInterfaceByName(name) method
+ * NXSL class Zone: get attribute
  */
-NXSL_METHOD_DEFINITION(Node, getInterfaceByName)
+NXSL_Value *NXSL_SubnetClass::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
+   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
+   if (value != nullptr)
+      return value;
 
-   shared_ptr<Interface> iface = static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByName(argv[0]->getValueAsCString());
-   *result = (iface != nullptr) ? iface->createNXSLObject(vm) : vm->createValue();
-   return 0;
+   NXSL_VM *vm = object->vm();
+   auto subnet = SharedObjectFromData<Subnet>(object);
+   if (NXSL_COMPARE_ATTRIBUTE_NAME("ipNetMask"))
+   {
+      value = vm->createValue(subnet->getIpAddress().getMaskBits());
+   }
+   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSyntheticMask"))
+   {
+      value = vm->createValue(subnet->isSyntheticMask());
+   }
+   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zone"))
+   {
+      if (g_flags & AF_ENABLE_ZONING)
+      {
+         shared_ptr<Zone> zone = FindZoneByUIN(subnet->getZoneUIN());
+         if (zone != nullptr)
+         {
+            value = zone->createNXSLObject(vm);
+         }
+         else
+         {
+            value = vm->createValue();
+         }
+      }
+      else
+      {
+         value = vm->createValue();
+      }
+   }
+   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zoneUIN"))
+   {
+      value = vm->createValue(subnet->getZoneUIN());
+   }
+   return value;
 }
 
 /**
- * Node::getInterfaceName(ifIndex) method
+ * DataCollectionTarget::applyTemplate(object)
  */
-NXSL_METHOD_DEFINITION(Node, getInterfaceName)
+NXSL_METHOD_DEFINITION(DataCollectionTarget, applyTemplate)
 {
-   if (!argv[0]->isInteger())
-      return NXSL_ERR_NOT_INTEGER;
+   shared_ptr<DataCollectionTarget> thisObject = *static_cast<shared_ptr<DataCollectionTarget>*>(object->getData());
 
-   shared_ptr<Interface> iface = static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByIndex(argv[0]->getValueAsUInt32());
-   *result = (iface != nullptr) ? vm->createValue(iface->getName()) : vm->createValue();
+   if (!argv[0]->isObject())
+      return NXSL_ERR_NOT_OBJECT;
+
+   NXSL_Object *nxslTemplate = argv[0]->getValueAsObject();
+   if (!nxslTemplate->getClass()->instanceOf(g_nxslTemplateClass.getName()))
+      return NXSL_ERR_BAD_CLASS;
+
+   static_cast<shared_ptr<Template>*>(nxslTemplate->getData())->get()->applyToTarget(thisObject);
+
+   *result = vm->createValue();
    return 0;
 }
 
 /**
- * Node::getWebService(name) method
+ * enableConfigurationPolling(enabled) method
  */
-NXSL_METHOD_DEFINITION(Node, getWebService)
+NXSL_METHOD_DEFINITION(DataCollectionTarget, enableConfigurationPolling)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_INTEGER;
-
-   shared_ptr<Node> *node = static_cast<shared_ptr<Node>*>(object->getData());
-
-   shared_ptr<WebServiceDefinition> d = FindWebServiceDefinition(argv[0]->getValueAsCString());
-   if (d == nullptr)
-   {
-      *result = vm->createValue();
-   }
-   else
-   {
-      *result = vm->createValue(vm->createObject(&g_nxslWebService, new WEB_SERVICE(d, *node)));
-   }
-   return 0;
+   return ChangeFlagMethod(object, argv[0], result, DCF_DISABLE_CONF_POLL, true);
 }
 
 /**
- * Node::readAgentParameter(name) method
+ * enableDataCollection(enabled) method
  */
-NXSL_METHOD_DEFINITION(Node, readAgentParameter)
+NXSL_METHOD_DEFINITION(DataCollectionTarget, enableDataCollection)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   TCHAR buffer[MAX_RESULT_LENGTH];
-   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getMetricFromAgent(argv[0]->getValueAsCString(), buffer, MAX_RESULT_LENGTH);
-   *result = (rcc == DCE_SUCCESS) ? vm->createValue(buffer) : vm->createValue();
-   return 0;
+   int rc = ChangeFlagMethod(object, argv[0], result, DCF_DISABLE_DATA_COLLECT, true);
+   if (argv[0]->isTrue())
+      static_cast<shared_ptr<DataCollectionTarget>*>(object->getData())->get()->scheduleItemsForPolling(false);
+   return rc;
 }
 
 /**
- * Node::readAgentList(name) method
+ * enableStatusPolling(enabled) method
  */
-NXSL_METHOD_DEFINITION(Node, readAgentList)
+NXSL_METHOD_DEFINITION(DataCollectionTarget, enableStatusPolling)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   StringList *list;
-   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getListFromAgent(argv[0]->getValueAsCString(), &list);
-   *result = (rcc == DCE_SUCCESS) ? vm->createValue(new NXSL_Array(vm, list)) : vm->createValue();
-   delete list;
-   return 0;
+   return ChangeFlagMethod(object, argv[0], result, DCF_DISABLE_STATUS_POLL, true);
 }
 
 /**
- * Node::readAgentTable(name) method
+ * readInternalParameter(name) method
  */
-NXSL_METHOD_DEFINITION(Node, readAgentTable)
+NXSL_METHOD_DEFINITION(DataCollectionTarget, readInternalParameter)
 {
    if (!argv[0]->isString())
       return NXSL_ERR_NOT_STRING;
 
-   shared_ptr<Table> table;
-   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getTableFromAgent(argv[0]->getValueAsCString(), &table);
-   *result = (rcc == DCE_SUCCESS) ? vm->createValue(vm->createObject(&g_nxslTableClass, new shared_ptr<Table>(table))) : vm->createValue();
+   DataCollectionTarget *dct = static_cast<shared_ptr<DataCollectionTarget>*>(object->getData())->get();
+
+   TCHAR value[MAX_RESULT_LENGTH];
+   DataCollectionError rc = dct->getInternalMetric(argv[0]->getValueAsCString(), value, MAX_RESULT_LENGTH);
+   *result = (rc == DCE_SUCCESS) ? object->vm()->createValue(value) : object->vm()->createValue();
    return 0;
 }
 
 /**
- * Node::readDriverParameter(name) method
+ * DataCollectionTarget::removeTemplate(object)
  */
-NXSL_METHOD_DEFINITION(Node, readDriverParameter)
+NXSL_METHOD_DEFINITION(DataCollectionTarget, removeTemplate)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
+   shared_ptr<DataCollectionTarget> thisObject = *static_cast<shared_ptr<DataCollectionTarget>*>(object->getData());
 
-   TCHAR buffer[MAX_RESULT_LENGTH];
-   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getMetricFromDeviceDriver(argv[0]->getValueAsCString(), buffer, MAX_RESULT_LENGTH);
-   *result = (rcc == DCE_SUCCESS) ? vm->createValue(buffer) : vm->createValue();
+   if (!argv[0]->isObject())
+      return NXSL_ERR_NOT_OBJECT;
+
+   NXSL_Object *nxslTemplate = argv[0]->getValueAsObject();
+   if (!nxslTemplate->getClass()->instanceOf(g_nxslTemplateClass.getName()))
+      return NXSL_ERR_BAD_CLASS;
+
+   auto tmpl = *static_cast<shared_ptr<Template>*>(nxslTemplate->getData());
+   tmpl->deleteChild(*thisObject);
+   thisObject->deleteParent(*tmpl);
+   tmpl->queueRemoveFromTarget(thisObject->getId(), true);
+
+   *result = vm->createValue();
    return 0;
 }
 
 /**
- * Node::readInternalParameter(name) method
+ * DataCollectionTarget::templates attribute
  */
-NXSL_METHOD_DEFINITION(Node, readInternalParameter)
+NXSL_ATTRIBUTE_DEFINITION(DataCollectionTarget, templates)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   TCHAR buffer[MAX_RESULT_LENGTH];
-   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getInternalMetric(argv[0]->getValueAsCString(), buffer, MAX_RESULT_LENGTH);
-   *result = (rcc == DCE_SUCCESS) ? vm->createValue(buffer) : vm->createValue();
-   return 0;
+   DataCollectionTarget *dcTarget = SharedObjectFromData<DataCollectionTarget>(object);
+   return vm->createValue(dcTarget->getTemplatesForNXSL(vm));
 }
 
 /**
- * Node::readInternalTable(name) method
+ * NXSL class DataCollectionTarget: constructor
  */
-NXSL_METHOD_DEFINITION(Node, readInternalTable)
+NXSL_DCTargetClass::NXSL_DCTargetClass() : NXSL_NetObjClass()
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
+   setName(_T("DataCollectionTarget"));
 
-   shared_ptr<Table> table;
-   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getInternalTable(argv[0]->getValueAsCString(), &table);
-   *result = (rcc == DCE_SUCCESS) ? vm->createValue(vm->createObject(&g_nxslTableClass, new shared_ptr<Table>(table))) : vm->createValue();
-   return 0;
+   NXSL_REGISTER_METHOD(DataCollectionTarget, applyTemplate, 1);
+   NXSL_REGISTER_METHOD(DataCollectionTarget, enableConfigurationPolling, 1);
+   NXSL_REGISTER_METHOD(DataCollectionTarget, enableDataCollection, 1);
+   NXSL_REGISTER_METHOD(DataCollectionTarget, enableStatusPolling, 1);
+   NXSL_REGISTER_METHOD(DataCollectionTarget, readInternalParameter, 1);
+   NXSL_REGISTER_METHOD(DataCollectionTarget, removeTemplate, 1);
+
+   NXSL_REGISTER_ATTRIBUTE(DataCollectionTarget, templates);
 }
 
 /**
- * Node::readWebServiceParameter(name) method
+ * NXSL class Zone: constructor
  */
-NXSL_METHOD_DEFINITION(Node, readWebServiceParameter)
+NXSL_ZoneClass::NXSL_ZoneClass() : NXSL_NetObjClass()
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   TCHAR buffer[MAX_RESULT_LENGTH];
-   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getMetricFromWebService(argv[0]->getValueAsCString(), buffer, MAX_RESULT_LENGTH);
-   *result = (rcc == DCE_SUCCESS) ? vm->createValue(buffer) : vm->createValue();
-   return 0;
+   setName(_T("Zone"));
 }
 
 /**
- * Node::readWebServiceList(name) method
+ * NXSL class Zone: get attribute
  */
-NXSL_METHOD_DEFINITION(Node, readWebServiceList)
+NXSL_Value *NXSL_ZoneClass::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
+   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
+   if (value != nullptr)
+      return value;
 
-   StringList *list;
-   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getListFromWebService(argv[0]->getValueAsCString(), &list);
-   *result = (rcc == DCE_SUCCESS) ? vm->createValue(new NXSL_Array(vm, list)) : vm->createValue();
-   delete list;
-   return 0;
+   NXSL_VM *vm = object->vm();
+   auto zone = SharedObjectFromData<Zone>(object);
+   if (NXSL_COMPARE_ATTRIBUTE_NAME("proxyNodes"))
+   {
+      NXSL_Array *array = new NXSL_Array(vm);
+      IntegerArray<uint32_t> proxies = zone->getAllProxyNodes();
+      for(int i = 0; i < proxies.size(); i++)
+      {
+         shared_ptr<NetObj> node = FindObjectById(proxies.get(i), OBJECT_NODE);
+         if (node != nullptr)
+            array->append(node->createNXSLObject(vm));
+      }
+      value = vm->createValue(array);
+   }
+   else if (NXSL_COMPARE_ATTRIBUTE_NAME("proxyNodeIds"))
+   {
+      NXSL_Array *array = new NXSL_Array(vm);
+      IntegerArray<uint32_t> proxies = zone->getAllProxyNodes();
+      for(int i = 0; i < proxies.size(); i++)
+         array->append(vm->createValue(proxies.get(i)));
+      value = vm->createValue(array);
+   }
+   else if (NXSL_COMPARE_ATTRIBUTE_NAME("uin"))
+   {
+      value = vm->createValue(zone->getUIN());
+   }
+   return value;
 }
 
 /**
- * Node::setIfXTableUsageMode(mode) method
+ * Node::createSNMPTransport(port, community, context) method
  */
-NXSL_METHOD_DEFINITION(Node, setIfXTableUsageMode)
+NXSL_METHOD_DEFINITION(Node, createSNMPTransport)
 {
-   if (!argv[0]->isInteger())
+   if (argc > 3)
+      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
+
+   if ((argc > 0) && !argv[0]->isNull() && !argv[0]->isInteger())
       return NXSL_ERR_NOT_INTEGER;
 
-   int mode = argv[0]->getValueAsInt32();
-   if ((mode != IFXTABLE_DISABLED) && (mode != IFXTABLE_ENABLED))
-      mode = IFXTABLE_DEFAULT;
+   if ((argc > 1) && !argv[1]->isNull() && !argv[1]->isString())
+      return NXSL_ERR_NOT_STRING;
 
-   static_cast<shared_ptr<Node>*>(object->getData())->get()->setIfXtableUsageMode(mode);
-   *result = vm->createValue();
+   if ((argc > 2) && !argv[2]->isNull() && !argv[2]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   uint16_t port = ((argc > 0) && argv[0]->isInteger()) ? static_cast<uint16_t>(argv[0]->getValueAsInt32()) : 0;
+   const char *community = ((argc > 1) && argv[1]->isString()) ? argv[1]->getValueAsMBString() : nullptr;
+   const char *context = ((argc > 2) && argv[2]->isString()) ? argv[2]->getValueAsMBString() : nullptr;
+   SNMP_Transport *t = static_cast<shared_ptr<Node> *>(object->getData())->get()->createSnmpTransport(port, SNMP_VERSION_DEFAULT, context, community);
+   *result = (t != nullptr) ? vm->createValue(vm->createObject(&g_nxslSnmpTransportClass, t)) : vm->createValue();
    return 0;
 }
 
 /**
- * NXSL class Node: constructor
+ * Web service custom request with data
  */
-NXSL_NodeClass::NXSL_NodeClass() : NXSL_DCTargetClass()
+static int BaseWebServiceRequestWithData(WEB_SERVICE *websvc, int argc, NXSL_Value **argv,
+      NXSL_Value **result, NXSL_VM *vm, const HttpRequestMethod requestMethod)
 {
-   setName(_T("Node"));
+   if (argc < 1)
+      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
 
-   NXSL_REGISTER_METHOD(Node, callWebService, -1);
-   NXSL_REGISTER_METHOD(Node, createSNMPTransport, -1);
-   NXSL_REGISTER_METHOD(Node, enable8021xStatusPolling, 1);
-   NXSL_REGISTER_METHOD(Node, enableAgent, 1);
-   NXSL_REGISTER_METHOD(Node, enableDiscoveryPolling, 1);
-   NXSL_REGISTER_METHOD(Node, enableEtherNetIP, 1);
-   NXSL_REGISTER_METHOD(Node, enableIcmp, 1);
-   NXSL_REGISTER_METHOD(Node, enablePrimaryIPPing, 1);
-   NXSL_REGISTER_METHOD(Node, enableRoutingTablePolling, 1);
-   NXSL_REGISTER_METHOD(Node, enableSnmp, 1);
-   NXSL_REGISTER_METHOD(Node, enableTopologyPolling, 1);
-   NXSL_REGISTER_METHOD(Node, executeSSHCommand, 1);
-   NXSL_REGISTER_METHOD(Node, getInterface, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceByIndex, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceByMACAddress, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceByName, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceName, 1);
-   NXSL_REGISTER_METHOD(Node, getWebService, 1);
-   NXSL_REGISTER_METHOD(Node, readAgentList, 1);
-   NXSL_REGISTER_METHOD(Node, readAgentParameter, 1);
-   NXSL_REGISTER_METHOD(Node, readAgentTable, 1);
-   NXSL_REGISTER_METHOD(Node, readDriverParameter, 1);
-   NXSL_REGISTER_METHOD(Node, readInternalParameter, 1);
-   NXSL_REGISTER_METHOD(Node, readInternalTable, 1);
-   NXSL_REGISTER_METHOD(Node, readWebServiceList, 1);
-   NXSL_REGISTER_METHOD(Node, readWebServiceParameter, 1);
-   NXSL_REGISTER_METHOD(Node, setIfXTableUsageMode, 1);
-}
+   const TCHAR *contentType = _T("application/json");
+   if (argc > 1)
+   {
+      if (!argv[1]->isString())
+      {
+         return NXSL_ERR_NOT_STRING;
+      }
+      else
+      {
+         contentType = argv[1]->getValueAsCString();
+      }
+   }
 
-/**
- * Get ICMP statistic for object
- */
-static NXSL_Value *GetNodeIcmpStatistic(Node *node, IcmpStatFunction function, NXSL_VM *vm)
-{
-   NXSL_Value *value;
-   TCHAR buffer[MAX_RESULT_LENGTH];
-   if (node->getIcmpStatistic(nullptr, function, buffer) == DCE_SUCCESS)
+   TCHAR *data = nullptr;
+   if (argv[0]->isObject(_T("JsonObject")) || argv[0]->isObject(_T("JsonArray")))
    {
-      value = vm->createValue(buffer);
+      json_t *json = static_cast<json_t*>(argv[0]->getValueAsObject()->getData());
+      char *tmp = json_dumps(json, JSON_INDENT(3));
+#ifdef UNICODE
+      data = WideStringFromUTF8String(tmp);
+      MemFree(tmp);
+#else
+      data = tmp;
+#endif
+   }
+   else if (argv[0]->isString())
+   {
+      data = MemCopyString(argv[0]->getValueAsCString());
    }
    else
    {
-      value = vm->createValue();
+      return NXSL_ERR_NOT_STRING;
    }
-   return value;
+
+   StringList parameters;
+   for (int i = 2; i < argc; i++)
+      parameters.add(argv[i]->getValueAsCString());
+
+   WebServiceCallResult *response = websvc->first->makeCustomRequest(websvc->second, requestMethod, parameters, data, contentType);
+   *result = vm->createValue(vm->createObject(&g_nxslWebServiceCallResult, response));
+   MemFree(data);
+
+   return 0;
 }
 
 /**
- * NXSL class Node: get attribute
+ * Web service custom request with data
  */
-NXSL_Value *NXSL_NodeClass::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
+static int BaseWebServiceRequestWithoutData(WEB_SERVICE *websvc, int argc, NXSL_Value **argv,
+      NXSL_Value **result, NXSL_VM *vm, const HttpRequestMethod requestMethod)
 {
-   NXSL_Value *value = NXSL_DCTargetClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   StringList parameters;
+   for (int i = 0 ; i < argc; i++)
+      parameters.add(argv[i]->getValueAsCString());
 
-   NXSL_VM *vm = object->vm();
-   auto node = SharedObjectFromData<Node>(object);
-   if (NXSL_COMPARE_ATTRIBUTE_NAME("agentCertificateMappingData"))
-   {
-      value = vm->createValue(node->getAgentCertificateMappingData());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentCertificateMappingMethod"))
-   {
-      value = vm->createValue(static_cast<int32_t>(node->getAgentCertificateMappingMethod()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentCertificateSubject"))
-   {
-      value = vm->createValue(node->getAgentCertificateSubject());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentId"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(node->getAgentId().toString(buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentProxy"))
+   WebServiceCallResult *response = websvc->first->makeCustomRequest(websvc->second, requestMethod, parameters, nullptr, nullptr);
+   *result = vm->createValue(vm->createObject(&g_nxslWebServiceCallResult, response));
+
+   return 0;
+}
+
+/**
+ * Node::callWebService(webSwcName, requestMethod, [postData], parameters...) method
+ */
+NXSL_METHOD_DEFINITION(Node, callWebService)
+{
+   if (argc < 2)
+      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
+
+   if ((argc > 0) && !argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   if ((argc > 1) && !argv[1]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   shared_ptr<WebServiceDefinition> d = FindWebServiceDefinition(argv[0]->getValueAsCString());
+   shared_ptr<Node> *node = static_cast<shared_ptr<Node>*>(object->getData());
+
+   if (d == nullptr)
    {
-      shared_ptr<NetObj> object = FindObjectById(node->getAgentProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
+      WebServiceCallResult *webSwcResult = new WebServiceCallResult();
+      _tcsncpy(webSwcResult->errorMessage, _T("Web service definition not found"), WEBSVC_ERROR_TEXT_MAX_SIZE);
+      *result = vm->createValue(vm->createObject(&g_nxslWebServiceCallResult, webSwcResult));
+      return 0;
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentVersion"))
+
+   WEB_SERVICE websvc = WEB_SERVICE(d, *node);
+   const TCHAR *requestMethod = argv[1]->getValueAsCString();
+   if (!_tcsicmp(_T("GET"), requestMethod))
    {
-      value = vm->createValue(node->getAgentVersion());
+      return BaseWebServiceRequestWithoutData(&websvc, argc - 2, argv  + 2, result, vm, HttpRequestMethod::_GET);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("bootTime"))
+   else if (!_tcsicmp(_T("DELETE"), requestMethod))
    {
-      value = vm->createValue(static_cast<INT64>(node->getBootTime()));
+      return BaseWebServiceRequestWithoutData(&websvc, argc - 2, argv  + 2, result, vm, HttpRequestMethod::_DELETE);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("bridgeBaseAddress"))
+   else if (!_tcsicmp(_T("POST"), requestMethod))
    {
-      TCHAR buffer[64];
-      value = vm->createValue(BinToStr(node->getBridgeId(), MAC_ADDR_LENGTH, buffer));
+      return BaseWebServiceRequestWithData(&websvc, argc - 2, argv  + 2, result, vm, HttpRequestMethod::_POST);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("capabilities"))
+   else if (!_tcsicmp(_T("PUT"), requestMethod))
    {
-      value = vm->createValue(node->getCapabilities());
+      return BaseWebServiceRequestWithData(&websvc, argc - 2, argv  + 2, result, vm, HttpRequestMethod::_PUT);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipDeviceType"))
+   else if (!_tcsicmp(_T("PATCH"), requestMethod))
    {
-      value = vm->createValue(node->getCipDeviceType());
+      return BaseWebServiceRequestWithData(&websvc, argc - 2, argv  + 2, result, vm, HttpRequestMethod::_PATCH);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipDeviceTypeAsText"))
-   {
-      value = vm->createValue(CIP_DeviceTypeNameFromCode(node->getCipDeviceType()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipExtendedStatus"))
-   {
-      value = vm->createValue((node->getCipStatus() & CIP_DEVICE_STATUS_EXTENDED_STATUS_MASK) >> 4);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipExtendedStatusAsText"))
-   {
-      value = vm->createValue(CIP_DecodeExtendedDeviceStatus(node->getCipStatus()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipStatus"))
-   {
-      value = vm->createValue(node->getCipStatus());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipStatusAsText"))
-   {
-      value = vm->createValue(CIP_DecodeDeviceStatus(node->getCipStatus()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipState"))
-   {
-      value = vm->createValue(node->getCipState());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipStateAsText"))
-   {
-      value = vm->createValue(CIP_DeviceStateTextFromCode(node->getCipState()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipVendorCode"))
-   {
-      value = vm->createValue(node->getCipVendorCode());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("components"))
+
+   WebServiceCallResult *webSwcResult = new WebServiceCallResult();
+   _tcslcpy(webSwcResult->errorMessage, _T("Invalid web service request method"), WEBSVC_ERROR_TEXT_MAX_SIZE);
+   *result = vm->createValue(vm->createObject(&g_nxslWebServiceCallResult, webSwcResult));
+   return 0;
+}
+
+/**
+ * enable8021x(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Node, enable8021xStatusPolling)
+{
+   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_8021X_STATUS_POLL, true);
+}
+
+/**
+ * enableAgent(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Node, enableAgent)
+{
+   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_NXCP, true);
+}
+
+/**
+ * enableDiscoveryPolling(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Node, enableDiscoveryPolling)
+{
+   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_DISCOVERY_POLL, true);
+}
+
+/**
+ * enableEtherNetIP(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Node, enableEtherNetIP)
+{
+   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_ETHERNET_IP, true);
+}
+
+/**
+ * enableIcmp(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Node, enableIcmp)
+{
+   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_ICMP, true);
+}
+
+/**
+ * enablePrimaryIPPing(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Node, enablePrimaryIPPing)
+{
+   return ChangeFlagMethod(object, argv[0], result, NF_PING_PRIMARY_IP, false);
+}
+
+/**
+ * enableRoutingTablePolling(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Node, enableRoutingTablePolling)
+{
+   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_ROUTE_POLL, true);
+}
+
+/**
+ * enableSnmp(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Node, enableSnmp)
+{
+   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_SNMP, true);
+}
+
+/**
+ * enableTopologyPolling(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Node, enableTopologyPolling)
+{
+   return ChangeFlagMethod(object, argv[0], result, NF_DISABLE_TOPOLOGY_POLL, true);
+}
+
+/**
+ * Node::executeSSHCommand(command) method
+ */
+NXSL_METHOD_DEFINITION(Node, executeSSHCommand)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   Node *node = static_cast<shared_ptr<Node>*>(object->getData())->get();
+   uint32_t proxyId = node->getEffectiveSshProxy();
+   if (proxyId != 0)
    {
-      shared_ptr<ComponentTree> components = node->getComponents();
-      if (components != nullptr)
+      shared_ptr<Node> proxyNode = static_pointer_cast<Node>(FindObjectById(proxyId, OBJECT_NODE));
+      if (proxyNode != nullptr)
       {
-         value = ComponentTree::getRootForNXSL(vm, components);
+         TCHAR ipAddr[64];
+         StringBuffer request(_T("SSH.Command("));
+         request.append(node->getIpAddress().toString(ipAddr));
+         request.append(_T(':'));
+         request.append(node->getSshPort());
+         request.append(_T(",\""));
+         request.append(EscapeStringForAgent(node->getSshLogin()).cstr());
+         request.append(_T("\",\""));
+         request.append(EscapeStringForAgent(node->getSshPassword()).cstr());
+         request.append(_T("\",\""));
+         request.append(EscapeStringForAgent(argv[0]->getValueAsCString()).cstr());
+         request.append(_T("\",,"));
+         request.append(node->getSshKeyId());
+         request.append(_T(')'));
+
+         StringList *list;
+         uint32_t rcc = proxyNode->getListFromAgent(request, &list);
+         *result = (rcc == DCE_SUCCESS) ? vm->createValue(new NXSL_Array(vm, list)) : vm->createValue();
+         delete list;
       }
       else
       {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("dependentNodes"))
-   {
-      StructArray<DependentNode> *dependencies = GetNodeDependencies(node->getId());
-      NXSL_Array *a = new NXSL_Array(vm);
-      for(int i = 0; i < dependencies->size(); i++)
-      {
-         a->append(vm->createValue(vm->createObject(&g_nxslNodeDependencyClass, new DependentNode(*dependencies->get(i)))));
+         *result = vm->createValue();
       }
-      value = vm->createValue(a);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("driver"))
-   {
-      value = vm->createValue(node->getDriverName());
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("downSince"))
-   {
-      value = vm->createValue(static_cast<INT64>(node->getDownSince()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("effectiveAgentProxy"))
+   else
    {
-      shared_ptr<NetObj> object = FindObjectById(node->getEffectiveAgentProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
+      *result = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("effectiveIcmpProxy"))
+   return 0;
+}
+
+/**
+ * Node::getInterface(interfaceId) method
+ * Interface ID could be ifIndex, name, or MAC address
+ */
+NXSL_METHOD_DEFINITION(Node, getInterface)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   shared_ptr<Interface> iface;
+   if (argv[0]->isInteger())  // Assume interface index
    {
-      shared_ptr<NetObj> object = FindObjectById(node->getEffectiveIcmpProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
+      iface = static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByIndex(argv[0]->getValueAsUInt32());
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("effectiveSnmpProxy"))
+   else
    {
-      shared_ptr<NetObj> object = FindObjectById(node->getEffectiveSnmpProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
+      MacAddress macAddr = MacAddress::parse(argv[0]->getValueAsCString());
+      if (macAddr.isValid() && macAddr.length() >= 6)
+         iface = static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByMAC(macAddr);
       else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("flags"))
-   {
-		value = vm->createValue(node->getFlags());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasAgentIfXCounters"))
-   {
-      value = vm->createValue((node->getCapabilities() & NC_HAS_AGENT_IFXCOUNTERS) ? 1 : 0);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasEntityMIB"))
-   {
-      value = vm->createValue((node->getCapabilities() & NC_HAS_ENTITY_MIB) ? 1 : 0);
+         iface = static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByName(argv[0]->getValueAsCString());
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasIfXTable"))
+   *result = (iface != nullptr) ? iface->createNXSLObject(vm) : vm->createValue();
+   return 0;
+}
+
+/**
+ * Node::getInterfaceByIndex(ifIndex) method
+ */
+NXSL_METHOD_DEFINITION(Node, getInterfaceByIndex)
+{
+   if (!argv[0]->isInteger())
+      return NXSL_ERR_NOT_INTEGER;
+
+   shared_ptr<Interface> iface = static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByIndex(argv[0]->getValueAsUInt32());
+   *result = (iface != nullptr) ? iface->createNXSLObject(vm) : vm->createValue();
+   return 0;
+}
+
+/**
+ * Node::getInterfaceByMACAddress(macAddress) method
+ */
+NXSL_METHOD_DEFINITION(Node, getInterfaceByMACAddress)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   MacAddress macAddr = MacAddress::parse(argv[0]->getValueAsCString());
+   shared_ptr<Interface> iface = macAddr.isValid() ? static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByMAC(macAddr) : shared_ptr<Interface>();
+   *result = (iface != nullptr) ? iface->createNXSLObject(vm) : vm->createValue();
+   return 0;
+}
+
+/**
+ * Node::getInterfaceByName(name) method
+ */
+NXSL_METHOD_DEFINITION(Node, getInterfaceByName)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   shared_ptr<Interface> iface = static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByName(argv[0]->getValueAsCString());
+   *result = (iface != nullptr) ? iface->createNXSLObject(vm) : vm->createValue();
+   return 0;
+}
+
+/**
+ * Node::getInterfaceName(ifIndex) method
+ */
+NXSL_METHOD_DEFINITION(Node, getInterfaceName)
+{
+   if (!argv[0]->isInteger())
+      return NXSL_ERR_NOT_INTEGER;
+
+   shared_ptr<Interface> iface = static_cast<shared_ptr<Node>*>(object->getData())->get()->findInterfaceByIndex(argv[0]->getValueAsUInt32());
+   *result = (iface != nullptr) ? vm->createValue(iface->getName()) : vm->createValue();
+   return 0;
+}
+
+/**
+ * Node::getWebService(name) method
+ */
+NXSL_METHOD_DEFINITION(Node, getWebService)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_INTEGER;
+
+   shared_ptr<Node> *node = static_cast<shared_ptr<Node>*>(object->getData());
+
+   shared_ptr<WebServiceDefinition> d = FindWebServiceDefinition(argv[0]->getValueAsCString());
+   if (d == nullptr)
    {
-      value = vm->createValue((node->getCapabilities() & NC_HAS_IFXTABLE) ? 1 : 0);
+      *result = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasUserAgent"))
+   else
    {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_HAS_USER_AGENT) ? 1 : 0));
+      *result = vm->createValue(vm->createObject(&g_nxslWebService, new WEB_SERVICE(d, *node)));
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasVLANs"))
-   {
-      value = vm->createValue((node->getCapabilities() & NC_HAS_VLANS) ? 1 : 0);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hardwareId"))
+   return 0;
+}
+
+/**
+ * Node::readAgentParameter(name) method
+ */
+NXSL_METHOD_DEFINITION(Node, readAgentParameter)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   TCHAR buffer[MAX_RESULT_LENGTH];
+   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getMetricFromAgent(argv[0]->getValueAsCString(), buffer, MAX_RESULT_LENGTH);
+   *result = (rcc == DCE_SUCCESS) ? vm->createValue(buffer) : vm->createValue();
+   return 0;
+}
+
+/**
+ * Node::readAgentList(name) method
+ */
+NXSL_METHOD_DEFINITION(Node, readAgentList)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   StringList *list;
+   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getListFromAgent(argv[0]->getValueAsCString(), &list);
+   *result = (rcc == DCE_SUCCESS) ? vm->createValue(new NXSL_Array(vm, list)) : vm->createValue();
+   delete list;
+   return 0;
+}
+
+/**
+ * Node::readAgentTable(name) method
+ */
+NXSL_METHOD_DEFINITION(Node, readAgentTable)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   shared_ptr<Table> table;
+   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getTableFromAgent(argv[0]->getValueAsCString(), &table);
+   *result = (rcc == DCE_SUCCESS) ? vm->createValue(vm->createObject(&g_nxslTableClass, new shared_ptr<Table>(table))) : vm->createValue();
+   return 0;
+}
+
+/**
+ * Node::readDriverParameter(name) method
+ */
+NXSL_METHOD_DEFINITION(Node, readDriverParameter)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   TCHAR buffer[MAX_RESULT_LENGTH];
+   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getMetricFromDeviceDriver(argv[0]->getValueAsCString(), buffer, MAX_RESULT_LENGTH);
+   *result = (rcc == DCE_SUCCESS) ? vm->createValue(buffer) : vm->createValue();
+   return 0;
+}
+
+/**
+ * Node::readInternalParameter(name) method
+ */
+NXSL_METHOD_DEFINITION(Node, readInternalParameter)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   TCHAR buffer[MAX_RESULT_LENGTH];
+   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getInternalMetric(argv[0]->getValueAsCString(), buffer, MAX_RESULT_LENGTH);
+   *result = (rcc == DCE_SUCCESS) ? vm->createValue(buffer) : vm->createValue();
+   return 0;
+}
+
+/**
+ * Node::readInternalTable(name) method
+ */
+NXSL_METHOD_DEFINITION(Node, readInternalTable)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   shared_ptr<Table> table;
+   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getInternalTable(argv[0]->getValueAsCString(), &table);
+   *result = (rcc == DCE_SUCCESS) ? vm->createValue(vm->createObject(&g_nxslTableClass, new shared_ptr<Table>(table))) : vm->createValue();
+   return 0;
+}
+
+/**
+ * Node::readWebServiceParameter(name) method
+ */
+NXSL_METHOD_DEFINITION(Node, readWebServiceParameter)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   TCHAR buffer[MAX_RESULT_LENGTH];
+   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getMetricFromWebService(argv[0]->getValueAsCString(), buffer, MAX_RESULT_LENGTH);
+   *result = (rcc == DCE_SUCCESS) ? vm->createValue(buffer) : vm->createValue();
+   return 0;
+}
+
+/**
+ * Node::readWebServiceList(name) method
+ */
+NXSL_METHOD_DEFINITION(Node, readWebServiceList)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   StringList *list;
+   uint32_t rcc = static_cast<shared_ptr<Node>*>(object->getData())->get()->getListFromWebService(argv[0]->getValueAsCString(), &list);
+   *result = (rcc == DCE_SUCCESS) ? vm->createValue(new NXSL_Array(vm, list)) : vm->createValue();
+   delete list;
+   return 0;
+}
+
+/**
+ * Node::setIfXTableUsageMode(mode) method
+ */
+NXSL_METHOD_DEFINITION(Node, setIfXTableUsageMode)
+{
+   if (!argv[0]->isInteger())
+      return NXSL_ERR_NOT_INTEGER;
+
+   int mode = argv[0]->getValueAsInt32();
+   if ((mode != IFXTABLE_DISABLED) && (mode != IFXTABLE_ENABLED))
+      mode = IFXTABLE_DEFAULT;
+
+   static_cast<shared_ptr<Node>*>(object->getData())->get()->setIfXtableUsageMode(mode);
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Get ICMP statistic for object
+ */
+static NXSL_Value *GetNodeIcmpStatistic(Node *node, IcmpStatFunction function, NXSL_VM *vm)
+{
+   NXSL_Value *value;
+   TCHAR buffer[MAX_RESULT_LENGTH];
+   if (node->getIcmpStatistic(nullptr, function, buffer) == DCE_SUCCESS)
    {
-      TCHAR buffer[HARDWARE_ID_LENGTH * 2 + 1];
-      value = vm->createValue(BinToStr(node->getHardwareId().value(), HARDWARE_ID_LENGTH, buffer));
+      value = vm->createValue(buffer);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hardwareComponents"))
+   else
    {
-      value = node->getHardwareComponentsForNXSL(vm);
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasWinPDH"))
+   return value;
+}
+
+/**
+ * Node::agentCertificateMappingData attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentCertificateMappingData)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getAgentCertificateMappingData());
+}
+
+/**
+ * Node::agentCertificateMappingMethod attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentCertificateMappingMethod)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<int32_t>(node->getAgentCertificateMappingMethod()));
+}
+
+/**
+ * Node::agentCertificateSubject attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentCertificateSubject)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getAgentCertificateSubject());
+}
+
+/**
+ * Node::agentId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentId)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   TCHAR buffer[64];
+   value = vm->createValue(node->getAgentId().toString(buffer));
+   return value;
+}
+
+/**
+ * Node::agentProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentProxy)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getAgentProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue((node->getCapabilities() & NC_HAS_WINPDH) ? 1 : 0);
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hypervisorInfo"))
+   else
    {
-      value = vm->createValue(node->getHypervisorInfo());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hypervisorType"))
+   return value;
+}
+
+/**
+ * Node::agentVersion attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentVersion)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getAgentVersion());
+}
+
+/**
+ * Node::bootTime attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, bootTime)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<INT64>(node->getBootTime()));
+}
+
+/**
+ * Node::bridgeBaseAddress attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, bridgeBaseAddress)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   TCHAR buffer[64];
+   value = vm->createValue(BinToStr(node->getBridgeId(), MAC_ADDR_LENGTH, buffer));
+   return value;
+}
+
+/**
+ * Node::capabilities attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, capabilities)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCapabilities());
+}
+
+/**
+ * Node::cipDeviceType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipDeviceType)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipDeviceType());
+}
+
+/**
+ * Node::cipDeviceTypeAsText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipDeviceTypeAsText)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DeviceTypeNameFromCode(node->getCipDeviceType()));
+}
+
+/**
+ * Node::cipExtendedStatus attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipExtendedStatus)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCipStatus() & CIP_DEVICE_STATUS_EXTENDED_STATUS_MASK) >> 4);
+}
+
+/**
+ * Node::cipExtendedStatusAsText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipExtendedStatusAsText)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DecodeExtendedDeviceStatus(node->getCipStatus()));
+}
+
+/**
+ * Node::cipStatus attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipStatus)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipStatus());
+}
+
+/**
+ * Node::cipStatusAsText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipStatusAsText)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DecodeDeviceStatus(node->getCipStatus()));
+}
+
+/**
+ * Node::cipState attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipState)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipState());
+}
+
+/**
+ * Node::cipStateAsText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipStateAsText)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DeviceStateTextFromCode(node->getCipState()));
+}
+
+/**
+ * Node::cipVendorCode attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipVendorCode)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipVendorCode());
+}
+
+/**
+ * Node::components attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, components)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<ComponentTree> components = node->getComponents();
+   if (components != nullptr)
    {
-      value = vm->createValue(node->getHypervisorType());
+      value = ComponentTree::getRootForNXSL(vm, components);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpAverageRTT"))
+   else
    {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::AVERAGE, vm);
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpLastRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::LAST, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpMaxRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::MAX, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpMinRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::MIN, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpPacketLoss"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::LOSS, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpProxy"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(node->getIcmpProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("interfaces"))
-   {
-      value = node->getInterfacesForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isAgent"))
-   {
-      value = vm->createValue(node->isNativeAgent());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isBridge"))
-   {
-      value = vm->createValue(node->isBridge());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isCDP"))
-   {
-      value = vm->createValue((node->getCapabilities() & NC_IS_CDP) != 0);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isEtherNetIP"))
-   {
-      value = vm->createValue(node->isEthernetIPSupported());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isInMaintenanceMode"))
-   {
-      value = vm->createValue(node->isInMaintenanceMode());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isLLDP"))
-   {
-      value = vm->createValue((node->getCapabilities() & NC_IS_LLDP) != 0);
-   }
-	else if (NXSL_COMPARE_ATTRIBUTE_NAME("isLocalMgmt") || NXSL_COMPARE_ATTRIBUTE_NAME("isLocalManagement"))
-	{
-		value = vm->createValue(node->isLocalManagement());
-	}
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isModbusTCP"))
-   {
-      value = vm->createValue(node->isModbusTCPSupported());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isOSPF"))
-   {
-      value = vm->createValue((node->getCapabilities() & NC_IS_OSPF) != 0);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isPAE") || NXSL_COMPARE_ATTRIBUTE_NAME("is802_1x"))
-   {
-      value = vm->createValue((node->getCapabilities() & NC_IS_8021X) != 0);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isPrinter"))
-   {
-      value = vm->createValue((node->getCapabilities() & NC_IS_PRINTER) != 0);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isProfiNet"))
-   {
-      value = vm->createValue(node->isProfiNetSupported());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isRemotelyManaged") || NXSL_COMPARE_ATTRIBUTE_NAME("isExternalGateway"))
-   {
-      value = vm->createValue((node->getFlags() & NF_EXTERNAL_GATEWAY) != 0);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isRouter"))
-   {
-      value = vm->createValue(node->isRouter());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSMCLP"))
+   return value;
+}
+
+/**
+ * Node::dependentNodes attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, dependentNodes)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   StructArray<DependentNode> *dependencies = GetNodeDependencies(node->getId());
+   NXSL_Array *a = new NXSL_Array(vm);
+   for(int i = 0; i < dependencies->size(); i++)
    {
-      value = vm->createValue((node->getCapabilities() & NC_IS_SMCLP) != 0);
+      a->append(vm->createValue(vm->createObject(&g_nxslNodeDependencyClass, new DependentNode(*dependencies->get(i)))));
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSNMP"))
+   value = vm->createValue(a);
+   return value;
+}
+
+/**
+ * Node::driver attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, driver)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getDriverName());
+}
+
+/**
+ * Node::downSince attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, downSince)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<INT64>(node->getDownSince()));
+}
+
+/**
+ * Node::effectiveAgentProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, effectiveAgentProxy)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getEffectiveAgentProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue(node->isSNMPSupported());
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSONMP") || NXSL_COMPARE_ATTRIBUTE_NAME("isNDP"))
+   else
    {
-      value = vm->createValue((node->getCapabilities() & NC_IS_NDP) != 0);
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSTP"))
+   return value;
+}
+
+/**
+ * Node::effectiveIcmpProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, effectiveIcmpProxy)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getEffectiveIcmpProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue((node->getCapabilities() & NC_IS_STP) != 0);
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isVirtual"))
+   else
    {
-      value = vm->createValue(node->isVirtual());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isVRRP"))
+   return value;
+}
+
+/**
+ * Node::effectiveSnmpProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, effectiveSnmpProxy)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getEffectiveSnmpProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue((node->getCapabilities() & NC_IS_VRRP) != 0);
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("lastAgentCommTime"))
+   else
    {
-      value = vm->createValue(static_cast<int64_t>(node->getLastAgentCommTime()));
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("nodeSubType"))
+   return value;
+}
+
+/**
+ * Node::flags attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, flags)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getFlags());
+}
+
+/**
+ * Node::hasAgentIfXCounters attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasAgentIfXCounters)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_HAS_AGENT_IFXCOUNTERS) ? 1 : 0);
+}
+
+/**
+ * Node::hasEntityMIB attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasEntityMIB)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_HAS_ENTITY_MIB) ? 1 : 0);
+}
+
+/**
+ * Node::hasIfXTable attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasIfXTable)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_HAS_IFXTABLE) ? 1 : 0);
+}
+
+/**
+ * Node::hasUserAgent attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasUserAgent)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_HAS_USER_AGENT) ? 1 : 0));
+}
+
+/**
+ * Node::hasVLANs attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasVLANs)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_HAS_VLANS) ? 1 : 0);
+}
+
+/**
+ * Node::hardwareId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hardwareId)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   TCHAR buffer[HARDWARE_ID_LENGTH * 2 + 1];
+   value = vm->createValue(BinToStr(node->getHardwareId().value(), HARDWARE_ID_LENGTH, buffer));
+   return value;
+}
+
+/**
+ * Node::hardwareComponents attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hardwareComponents)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return node->getHardwareComponentsForNXSL(vm);
+}
+
+/**
+ * Node::hasWinPDH attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasWinPDH)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_HAS_WINPDH) ? 1 : 0);
+}
+
+/**
+ * Node::hypervisorInfo attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hypervisorInfo)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getHypervisorInfo());
+}
+
+/**
+ * Node::hypervisorType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hypervisorType)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getHypervisorType());
+}
+
+/**
+ * Node::icmpAverageRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpAverageRTT)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::AVERAGE, vm);
+}
+
+/**
+ * Node::icmpLastRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpLastRTT)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::LAST, vm);
+}
+
+/**
+ * Node::icmpMaxRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpMaxRTT)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::MAX, vm);
+}
+
+/**
+ * Node::icmpMinRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpMinRTT)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::MIN, vm);
+}
+
+/**
+ * Node::icmpPacketLoss attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpPacketLoss)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::LOSS, vm);
+}
+
+/**
+ * Node::icmpProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpProxy)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getIcmpProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue(node->getSubType());
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("nodeType"))
+   else
    {
-      value = vm->createValue((INT32)node->getType());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("physicalContainer"))
+   return value;
+}
+
+/**
+ * Node::interfaces attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, interfaces)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return node->getInterfacesForNXSL(vm);
+}
+
+/**
+ * Node::isAgent attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isAgent)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isNativeAgent());
+}
+
+/**
+ * Node::isBridge attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isBridge)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isBridge());
+}
+
+/**
+ * Node::isCDP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isCDP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_IS_CDP) != 0);
+}
+
+/**
+ * Node::isEtherNetIP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isEtherNetIP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isEthernetIPSupported());
+}
+
+/**
+ * Node::isLLDP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isLLDP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_IS_LLDP) != 0);
+}
+
+/**
+ * Node::isLocalMgmt attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isLocalMgmt)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isLocalManagement());
+}
+
+/**
+ * Node::isModbusTCP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isModbusTCP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isModbusTCPSupported());
+}
+
+/**
+ * Node::isOSPF attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isOSPF)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_IS_OSPF) != 0);
+}
+
+/**
+ * Node::isPAE attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isPAE)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_IS_8021X) != 0);
+}
+
+/**
+ * Node::isPrinter attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isPrinter)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_IS_PRINTER) != 0);
+}
+
+/**
+ * Node::isProfiNet attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isProfiNet)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isProfiNetSupported());
+}
+
+/**
+ * Node::isRemotelyManaged attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isRemotelyManaged)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getFlags() & NF_EXTERNAL_GATEWAY) != 0);
+}
+
+/**
+ * Node::isRouter attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isRouter)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isRouter());
+}
+
+/**
+ * Node::isSMCLP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSMCLP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_IS_SMCLP) != 0);
+}
+
+/**
+ * Node::isSNMP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSNMP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isSNMPSupported());
+}
+
+/**
+ * Node::isSONMP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSONMP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_IS_NDP) != 0);
+}
+
+/**
+ * Node::isSTP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSTP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_IS_STP) != 0);
+}
+
+/**
+ * Node::isVirtual attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isVirtual)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isVirtual());
+}
+
+/**
+ * Node::isVRRP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isVRRP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_IS_VRRP) != 0);
+}
+
+/**
+ * Node::lastAgentCommTime attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, lastAgentCommTime)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<int64_t>(node->getLastAgentCommTime()));
+}
+
+/**
+ * Node::nodeSubType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, nodeSubType)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSubType());
+}
+
+/**
+ * Node::nodeType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, nodeType)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((INT32)node->getType());
+}
+
+/**
+ * Node::physicalContainer attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, physicalContainer)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> container = FindObjectById(node->getPhysicalContainerId());
+   if (container != nullptr)
    {
-      shared_ptr<NetObj> object = FindObjectById(node->getPhysicalContainerId());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
+      value = container->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("physicalContainerId"))
+   else
    {
-      value = vm->createValue(node->getPhysicalContainerId());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("platformName"))
+   return value;
+}
+
+/**
+ * Node::physicalContainerId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, physicalContainerId)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getPhysicalContainerId());
+}
+
+/**
+ * Node::platformName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, platformName)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getPlatformName());
+}
+
+/**
+ * Node::primaryHostName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, primaryHostName)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getPrimaryHostName());
+}
+
+/**
+ * Node::productCode attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, productCode)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getProductCode());
+}
+
+/**
+ * Node::productName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, productName)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getProductName());
+}
+
+/**
+ * Node::productVersion attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, productVersion)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getProductVersion());
+}
+
+/**
+ * Node::rack attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rack)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> rack = FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK);
+   if (rack != nullptr)
    {
-      value = vm->createValue(node->getPlatformName());
+      value = rack->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("primaryHostName"))
+   else
    {
-      value = vm->createValue(node->getPrimaryHostName());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("productCode"))
+   return value;
+}
+
+/**
+ * Node::rackId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rackId)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   if (FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK) != nullptr)
    {
-      value = vm->createValue(node->getProductCode());
+      value = vm->createValue(node->getPhysicalContainerId());
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("productName"))
+   else
    {
-      value = vm->createValue(node->getProductName());
+      value = vm->createValue(0);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("productVersion"))
+   return value;
+}
+
+/**
+ * Node::rackHeight attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rackHeight)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getRackHeight());
+}
+
+/**
+ * Node::rackPosition attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rackPosition)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getRackPosition());
+}
+
+/**
+ * Node::runtimeFlags attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, runtimeFlags)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getRuntimeFlags());
+}
+
+/**
+ * Node::serialNumber attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, serialNumber)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSerialNumber());
+}
+
+/**
+ * Node::snmpOID attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpOID)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSNMPObjectId());
+}
+
+/**
+ * Node::snmpProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpProxy)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getSNMPProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue(node->getProductVersion());
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("rack"))
+   else
    {
-      shared_ptr<NetObj> rack = FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK);
-      if (rack != nullptr)
-      {
-         value = rack->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("rackId"))
+   return value;
+}
+
+/**
+ * Node::snmpSysContact attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpSysContact)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysContact());
+}
+
+/**
+ * Node::snmpSysLocation attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpSysLocation)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysLocation());
+}
+
+/**
+ * Node::snmpSysName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpSysName)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysName());
+}
+
+/**
+ * Node::snmpVersion attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpVersion)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)node->getSNMPVersion());
+}
+
+/**
+ * Node::softwarePackages attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, softwarePackages)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return node->getSoftwarePackagesForNXSL(vm);
+}
+
+/**
+ * Node::sysDescription attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, sysDescription)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysDescription());
+}
+
+/**
+ * Node::tunnel attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, tunnel)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<AgentTunnel> tunnel = GetTunnelForNode(node->getId());
+   if (tunnel != nullptr)
+      value = vm->createValue(vm->createObject(&g_nxslTunnelClass, new shared_ptr<AgentTunnel>(tunnel)));
+   else
+      value = vm->createValue();
+   return value;
+}
+
+/**
+ * Node::vendor attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, vendor)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getVendor());
+}
+
+/**
+ * Node::vlans attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, vlans)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<VlanList> vlans = node->getVlans();
+   if (vlans != nullptr)
    {
-      if (FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK) != nullptr)
-      {
-         value = vm->createValue(node->getPhysicalContainerId());
-      }
-      else
+      NXSL_Array *a = new NXSL_Array(vm);
+      for(int i = 0; i < vlans->size(); i++)
       {
-         value = vm->createValue(0);
+         a->append(vm->createValue(vm->createObject(&g_nxslVlanClass, new VlanInfo(vlans->get(i), node->getId()))));
       }
+      value = vm->createValue(a);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("rackHeight"))
-   {
-      value = vm->createValue(node->getRackHeight());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("rackPosition"))
-   {
-      value = vm->createValue(node->getRackPosition());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("runtimeFlags"))
-   {
-      value = vm->createValue(node->getRuntimeFlags());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("serialNumber"))
-   {
-      value = vm->createValue(node->getSerialNumber());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpOID"))
+   else
    {
-      value = vm->createValue(node->getSNMPObjectId());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpProxy"))
+   return value;
+}
+
+/**
+ * Node::zone attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zone)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   if (IsZoningEnabled())
    {
-      shared_ptr<NetObj> object = FindObjectById(node->getSNMPProxy());
-      if (object != nullptr)
+      shared_ptr<Zone> zone = FindZoneByUIN(node->getZoneUIN());
+      if (zone != nullptr)
       {
-         value = object->createNXSLObject(vm);
+         value = zone->createNXSLObject(vm);
       }
       else
       {
          value = vm->createValue();
       }
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpSysContact"))
-   {
-      value = vm->createValue(node->getSysContact());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpSysLocation"))
-   {
-      value = vm->createValue(node->getSysLocation());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpSysName"))
-   {
-      value = vm->createValue(node->getSysName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpVersion"))
-   {
-      value = vm->createValue((LONG)node->getSNMPVersion());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("softwarePackages"))
-   {
-      value = node->getSoftwarePackagesForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("sysDescription"))
-   {
-      value = vm->createValue(node->getSysDescription());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("tunnel"))
-   {
-      shared_ptr<AgentTunnel> tunnel = GetTunnelForNode(node->getId());
-      if (tunnel != nullptr)
-         value = vm->createValue(vm->createObject(&g_nxslTunnelClass, new shared_ptr<AgentTunnel>(tunnel)));
-      else
-         value = vm->createValue();
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("vendor"))
+   else
    {
-      value = vm->createValue(node->getVendor());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("vlans"))
+   return value;
+}
+
+/**
+ * Node::zoneProxyAssignments attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zoneProxyAssignments)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   if (IsZoningEnabled())
    {
-      shared_ptr<VlanList> vlans = node->getVlans();
-      if (vlans != nullptr)
+      shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
+      if (zone != nullptr)
       {
-         NXSL_Array *a = new NXSL_Array(vm);
-         for(int i = 0; i < vlans->size(); i++)
-         {
-            a->append(vm->createValue(vm->createObject(&g_nxslVlanClass, new VlanInfo(vlans->get(i), node->getId()))));
-         }
-         value = vm->createValue(a);
+         value = vm->createValue(zone->getProxyNodeAssignments(node->getId()));
       }
       else
       {
-         value = vm->createValue();
+         value = vm->createValue(0);
       }
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zone"))
-	{
-      if (IsZoningEnabled())
-      {
-         shared_ptr<Zone> zone = FindZoneByUIN(node->getZoneUIN());
-		   if (zone != nullptr)
-		   {
-			   value = zone->createNXSLObject(vm);
-		   }
-		   else
-		   {
-			   value = vm->createValue();
-		   }
-	   }
-	   else
-	   {
-		   value = vm->createValue();
-	   }
-	}
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zoneProxyAssignments"))
+   else
    {
-      if (IsZoningEnabled())
-      {
-         shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
-         if (zone != nullptr)
-         {
-            value = vm->createValue(zone->getProxyNodeAssignments(node->getId()));
-         }
-         else
-         {
-            value = vm->createValue(0);
-         }
-      }
-      else
-      {
-         value = vm->createValue(0);
-      }
+      value = vm->createValue(0);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zoneProxyStatus"))
+   return value;
+}
+
+/**
+ * Node::zoneProxyStatus attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zoneProxyStatus)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   if (IsZoningEnabled())
    {
-      if (IsZoningEnabled())
+      shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
+      if (zone != nullptr)
       {
-         shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
-         if (zone != nullptr)
-         {
-            value = vm->createValue(zone->isProxyNodeAvailable(node->getId()));
-         }
-         else
-         {
-            value = vm->createValue(0);
-         }
+         value = vm->createValue(zone->isProxyNodeAvailable(node->getId()));
       }
       else
       {
          value = vm->createValue(0);
       }
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zoneUIN"))
-	{
-      value = vm->createValue(node->getZoneUIN());
+   else
+   {
+      value = vm->createValue(0);
    }
    return value;
 }
 
+/**
+ * Node::zoneUIN attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zoneUIN)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getZoneUIN());
+}
+
+/**
+ * NXSL class Node: constructor
+ */
+NXSL_NodeClass::NXSL_NodeClass() : NXSL_DCTargetClass()
+{
+   setName(_T("Node"));
+
+   NXSL_REGISTER_METHOD(Node, callWebService, -1);
+   NXSL_REGISTER_METHOD(Node, createSNMPTransport, -1);
+   NXSL_REGISTER_METHOD(Node, enable8021xStatusPolling, 1);
+   NXSL_REGISTER_METHOD(Node, enableAgent, 1);
+   NXSL_REGISTER_METHOD(Node, enableDiscoveryPolling, 1);
+   NXSL_REGISTER_METHOD(Node, enableEtherNetIP, 1);
+   NXSL_REGISTER_METHOD(Node, enableIcmp, 1);
+   NXSL_REGISTER_METHOD(Node, enablePrimaryIPPing, 1);
+   NXSL_REGISTER_METHOD(Node, enableRoutingTablePolling, 1);
+   NXSL_REGISTER_METHOD(Node, enableSnmp, 1);
+   NXSL_REGISTER_METHOD(Node, enableTopologyPolling, 1);
+   NXSL_REGISTER_METHOD(Node, executeSSHCommand, 1);
+   NXSL_REGISTER_METHOD(Node, getInterface, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceByIndex, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceByMACAddress, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceByName, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceName, 1);
+   NXSL_REGISTER_METHOD(Node, getWebService, 1);
+   NXSL_REGISTER_METHOD(Node, readAgentList, 1);
+   NXSL_REGISTER_METHOD(Node, readAgentParameter, 1);
+   NXSL_REGISTER_METHOD(Node, readAgentTable, 1);
+   NXSL_REGISTER_METHOD(Node, readDriverParameter, 1);
+   NXSL_REGISTER_METHOD(Node, readInternalParameter, 1);
+   NXSL_REGISTER_METHOD(Node, readInternalTable, 1);
+   NXSL_REGISTER_METHOD(Node, readWebServiceList, 1);
+   NXSL_REGISTER_METHOD(Node, readWebServiceParameter, 1);
+   NXSL_REGISTER_METHOD(Node, setIfXTableUsageMode, 1);
+
+   NXSL_REGISTER_ATTRIBUTE(Node, agentCertificateMappingData);
+   NXSL_REGISTER_ATTRIBUTE(Node, agentCertificateMappingMethod);
+   NXSL_REGISTER_ATTRIBUTE(Node, agentCertificateSubject);
+   NXSL_REGISTER_ATTRIBUTE(Node, agentId);
+   NXSL_REGISTER_ATTRIBUTE(Node, agentProxy);
+   NXSL_REGISTER_ATTRIBUTE(Node, agentVersion);
+   NXSL_REGISTER_ATTRIBUTE(Node, bootTime);
+   NXSL_REGISTER_ATTRIBUTE(Node, bridgeBaseAddress);
+   NXSL_REGISTER_ATTRIBUTE(Node, capabilities);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipDeviceType);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipDeviceTypeAsText);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipExtendedStatus);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipExtendedStatusAsText);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipStatus);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipStatusAsText);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipState);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipStateAsText);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipVendorCode);
+   NXSL_REGISTER_ATTRIBUTE(Node, components);
+   NXSL_REGISTER_ATTRIBUTE(Node, dependentNodes);
+   NXSL_REGISTER_ATTRIBUTE(Node, driver);
+   NXSL_REGISTER_ATTRIBUTE(Node, downSince);
+   NXSL_REGISTER_ATTRIBUTE(Node, effectiveAgentProxy);
+   NXSL_REGISTER_ATTRIBUTE(Node, effectiveIcmpProxy);
+   NXSL_REGISTER_ATTRIBUTE(Node, effectiveSnmpProxy);
+   NXSL_REGISTER_ATTRIBUTE(Node, flags);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasAgentIfXCounters);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasEntityMIB);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasIfXTable);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasUserAgent);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasVLANs);
+   NXSL_REGISTER_ATTRIBUTE(Node, hardwareId);
+   NXSL_REGISTER_ATTRIBUTE(Node, hardwareComponents);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasWinPDH);
+   NXSL_REGISTER_ATTRIBUTE(Node, hypervisorInfo);
+   NXSL_REGISTER_ATTRIBUTE(Node, hypervisorType);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpAverageRTT);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpLastRTT);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpMaxRTT);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpMinRTT);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpPacketLoss);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpProxy);
+   NXSL_REGISTER_ATTRIBUTE(Node, interfaces);
+   NXSL_REGISTER_ATTRIBUTE(Node, isAgent);
+   NXSL_REGISTER_ATTRIBUTE(Node, isBridge);
+   NXSL_REGISTER_ATTRIBUTE(Node, isCDP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isEtherNetIP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isLLDP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isLocalMgmt);
+   NXSL_REGISTER_ATTRIBUTE_ALIAS(Node, isLocalMgmt, isLocalManagement);
+   NXSL_REGISTER_ATTRIBUTE(Node, isModbusTCP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isOSPF);
+   NXSL_REGISTER_ATTRIBUTE(Node, isPAE);
+   NXSL_REGISTER_ATTRIBUTE_ALIAS(Node, isPAE, is802_1x);
+   NXSL_REGISTER_ATTRIBUTE(Node, isPrinter);
+   NXSL_REGISTER_ATTRIBUTE(Node, isProfiNet);
+   NXSL_REGISTER_ATTRIBUTE(Node, isRemotelyManaged);
+   NXSL_REGISTER_ATTRIBUTE_ALIAS(Node, isRemotelyManaged, isExternalGateway);
+   NXSL_REGISTER_ATTRIBUTE(Node, isRouter);
+   NXSL_REGISTER_ATTRIBUTE(Node, isSMCLP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isSNMP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isSONMP);
+   NXSL_REGISTER_ATTRIBUTE_ALIAS(Node, isSONMP, isNDP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isSTP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isVirtual);
+   NXSL_REGISTER_ATTRIBUTE(Node, isVRRP);
+   NXSL_REGISTER_ATTRIBUTE(Node, lastAgentCommTime);
+   NXSL_REGISTER_ATTRIBUTE(Node, nodeSubType);
+   NXSL_REGISTER_ATTRIBUTE(Node, nodeType);
+   NXSL_REGISTER_ATTRIBUTE(Node, physicalContainer);
+   NXSL_REGISTER_ATTRIBUTE(Node, physicalContainerId);
+   NXSL_REGISTER_ATTRIBUTE(Node, platformName);
+   NXSL_REGISTER_ATTRIBUTE(Node, primaryHostName);
+   NXSL_REGISTER_ATTRIBUTE(Node, productCode);
+   NXSL_REGISTER_ATTRIBUTE(Node, productName);
+   NXSL_REGISTER_ATTRIBUTE(Node, productVersion);
+   NXSL_REGISTER_ATTRIBUTE(Node, rack);
+   NXSL_REGISTER_ATTRIBUTE(Node, rackId);
+   NXSL_REGISTER_ATTRIBUTE(Node, rackHeight);
+   NXSL_REGISTER_ATTRIBUTE(Node, rackPosition);
+   NXSL_REGISTER_ATTRIBUTE(Node, runtimeFlags);
+   NXSL_REGISTER_ATTRIBUTE(Node, serialNumber);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpOID);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpProxy);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpSysContact);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpSysLocation);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpSysName);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpVersion);
+   NXSL_REGISTER_ATTRIBUTE(Node, softwarePackages);
+   NXSL_REGISTER_ATTRIBUTE(Node, sysDescription);
+   NXSL_REGISTER_ATTRIBUTE(Node, tunnel);
+   NXSL_REGISTER_ATTRIBUTE(Node, vendor);
+   NXSL_REGISTER_ATTRIBUTE(Node, vlans);
+   NXSL_REGISTER_ATTRIBUTE(Node, zone);
+   NXSL_REGISTER_ATTRIBUTE(Node, zoneProxyAssignments);
+   NXSL_REGISTER_ATTRIBUTE(Node, zoneProxyStatus);
+   NXSL_REGISTER_ATTRIBUTE(Node, zoneUIN);
+}
+
 /**
  * Interface::enableAgentStatusPolling(enabled) method
  */
@@ -3961,6 +4749,7 @@ NXSL_METHOD_DEFINITION(DCI, forcePoll)
       if (dcObject != nullptr)
       {
          dcObject->requestForcePoll(nullptr);
+         ScheduleDCObjectPoll(dcObject, time(nullptr));
       }
    }
    *result = vm->createValue();
@@ -38,11 +38,108 @@ extern Config g_serverConfig;
  */
 TCHAR *g_pdsLoadList = nullptr;
 
+/**
+ * Queue overflow policy
+ */
+enum class PerfDataStorageOverflowPolicy
+{
+   DROP = 0,
+   BLOCK = 1,
+   SPILL = 2
+};
+
+/**
+ * Dispatcher settings
+ */
+static size_t s_queueSizeLimit = 100000;
+static int s_batchSize = 256;
+static PerfDataStorageOverflowPolicy s_overflowPolicy = PerfDataStorageOverflowPolicy::DROP;
+
+/**
+ * Element of driver's request queue
+ */
+struct PerfDataStorageQueueElement
+{
+   int64_t queueTime;
+   uint32_t ownerId;
+   uint32_t dciId;
+   time_t timestamp;
+   TCHAR *value;
+   shared_ptr<Table> table;
+
+   PerfDataStorageQueueElement(uint32_t _ownerId, uint32_t _dciId, time_t _timestamp, const TCHAR *_value) : table()
+   {
+      queueTime = GetCurrentTimeMs();
+      ownerId = _ownerId;
+      dciId = _dciId;
+      timestamp = _timestamp;
+      value = MemCopyString(_value);
+   }
+
+   PerfDataStorageQueueElement(uint32_t _ownerId, uint32_t _dciId, time_t _timestamp, const shared_ptr<Table>& _table) : table(_table)
+   {
+      queueTime = GetCurrentTimeMs();
+      ownerId = _ownerId;
+      dciId = _dciId;
+      timestamp = _timestamp;
+      value = nullptr;
+   }
+
+   ~PerfDataStorageQueueElement()
+   {
+      MemFree(value);
+   }
+};
+
+/**
+ * Asynchronous request dispatcher for single driver. Requests from data collectors are placed into bounded queue
+ * and passed to driver in batches by dedicated thread, so slow driver does not delay data collection.
+ */
+class PerfDataStorageDispatcher
+{
+private:
+   PerfDataStorageDriver *m_driver;
+   ObjectQueue<PerfDataStorageQueueElement> m_queue;
+   THREAD m_thread;
+   Condition m_spaceAvailable;
+   bool m_shutdown;
+   Mutex m_spillLock;
+   TCHAR m_spillFileName[MAX_PATH];
+   TCHAR m_replayFileName[MAX_PATH];
+   FILE *m_spillFile;
+   uint32_t m_spillFileRecords;  // Protected by m_spillLock
+   VolatileCounter64 m_droppedValues;
+   VolatileCounter64 m_spilledValues;
+   int64_t m_averageLatency;  // Exponential moving average in fixed point format
+
+   bool spill(PerfDataStorageQueueElement *e);
+   bool hasSpilledValues();
+   bool saveReplayRemainder(FILE *f, const TCHAR *fileName);
+   void replaySpilledValues();
+   void processBatch(PerfDataStorageQueueElement **elements, int count);
+   void workerThread();
+
+public:
+   PerfDataStorageDispatcher(PerfDataStorageDriver *driver);
+   ~PerfDataStorageDispatcher();
+
+   void start();
+   void stop();
+   void enqueue(PerfDataStorageQueueElement *e);
+
+   PerfDataStorageDriver *getDriver() const { return m_driver; }
+   size_t getQueueSize() const { return m_queue.size(); }
+   uint64_t getDroppedValues() const { return m_droppedValues; }
+   uint64_t getSpilledValues() const { return m_spilledValues; }
+   double getAverageLatency() const { return GetExpMovingAverageValue(m_averageLatency); }
+};
+
 /**
  * List of loaded drivers
  */
 static int s_numDrivers = 0;
 static PerfDataStorageDriver *s_drivers[MAX_PDS_DRIVERS];
+static PerfDataStorageDispatcher *s_dispatchers[MAX_PDS_DRIVERS];
 
 /**
  * Driver base class constructor
@@ -97,6 +194,22 @@ bool PerfDataStorageDriver::saveDCItemValue(DCItem *dcObject, time_t timestamp,
    return false;
 }
 
+/**
+ * Save batch of DCI values. Default implementation calls saveDCItemValue for each value.
+ * Returns true if all values were saved successfully.
+ */
+bool PerfDataStorageDriver::saveDCItemValues(const StructArray<PerfDataStorageItemValue>& values)
+{
+   bool success = true;
+   for(int i = 0; i < values.size(); i++)
+   {
+      const PerfDataStorageItemValue *v = values.get(i);
+      if (!saveDCItemValue(v->dci, v->timestamp, v->value))
+         success = false;
+   }
+   return success;
+}
+
 /**
  * Save table value
  */
@@ -113,22 +226,394 @@ DataCollectionError PerfDataStorageDriver::getInternalMetric(const TCHAR *metric
    return DCE_NOT_SUPPORTED;
 }
 
+/**
+ * Dispatcher constructor
+ */
+PerfDataStorageDispatcher::PerfDataStorageDispatcher(PerfDataStorageDriver *driver) : m_queue(4096, Ownership::True), m_spaceAvailable(true), m_spillLock(MutexType::FAST)
+{
+   m_driver = driver;
+   m_thread = INVALID_THREAD_HANDLE;
+   m_shutdown = false;
+   _sntprintf(m_spillFileName, MAX_PATH, _T("%s") FS_PATH_SEPARATOR _T("pds_%s.spill"), g_netxmsdDataDir, driver->getName());
+   _sntprintf(m_replayFileName, MAX_PATH, _T("%s") FS_PATH_SEPARATOR _T("pds_%s.replay"), g_netxmsdDataDir, driver->getName());
+   m_spillFile = nullptr;
+   m_spillFileRecords = 0;
+   m_droppedValues = 0;
+   m_spilledValues = 0;
+   m_averageLatency = 0;
+}
+
+/**
+ * Dispatcher destructor
+ */
+PerfDataStorageDispatcher::~PerfDataStorageDispatcher()
+{
+   if (m_spillFile != nullptr)
+      fclose(m_spillFile);
+}
+
+/**
+ * Start dispatcher
+ */
+void PerfDataStorageDispatcher::start()
+{
+   // Values spilled before previous shutdown will be replayed by worker thread
+   if ((_taccess(m_spillFileName, 0) == 0) || (_taccess(m_replayFileName, 0) == 0))
+   {
+      nxlog_debug_tag(DEBUG_TAG, 2, _T("Found spilled values for driver %s"), m_driver->getName());
+      m_spillFileRecords = 1;
+   }
+   m_thread = ThreadCreateEx(this, &PerfDataStorageDispatcher::workerThread);
+}
+
+/**
+ * Stop dispatcher. All queued requests are passed to driver before worker thread exits.
+ */
+void PerfDataStorageDispatcher::stop()
+{
+   m_shutdown = true;
+   m_spaceAvailable.set();
+   m_queue.put(INVALID_POINTER_VALUE);
+   ThreadJoin(m_thread);
+   m_thread = INVALID_THREAD_HANDLE;
+}
+
+/**
+ * Add request to the queue, applying overflow policy if queue is full
+ */
+void PerfDataStorageDispatcher::enqueue(PerfDataStorageQueueElement *e)
+{
+   if (m_queue.size() >= s_queueSizeLimit)
+   {
+      switch(s_overflowPolicy)
+      {
+         case PerfDataStorageOverflowPolicy::BLOCK:
+            while((m_queue.size() >= s_queueSizeLimit) && !m_shutdown)
+               m_spaceAvailable.wait(100);
+            break;
+         case PerfDataStorageOverflowPolicy::SPILL:
+            if (!spill(e))
+               InterlockedIncrement64(&m_droppedValues);   // table values cannot be spilled
+            delete e;
+            return;
+         default:
+            InterlockedIncrement64(&m_droppedValues);
+            delete e;
+            return;
+      }
+   }
+   m_queue.put(e);
+}
+
+/**
+ * Write request to spill file. Only single value requests can be spilled. Returns true on success.
+ */
+bool PerfDataStorageDispatcher::spill(PerfDataStorageQueueElement *e)
+{
+   if (e->value == nullptr)
+      return false;
+
+   StringBuffer line;
+   line.append(e->ownerId);
+   line.append(_T('\t'));
+   line.append(e->dciId);
+   line.append(_T('\t'));
+   line.append(static_cast<int64_t>(e->timestamp));
+   line.append(_T('\t'));
+   for(const TCHAR *p = e->value; *p != 0; p++)
+   {
+      switch(*p)
+      {
+         case _T('\\'):
+            line.append(_T("\\\\"));
+            break;
+         case _T('\n'):
+            line.append(_T("\\n"));
+            break;
+         case _T('\r'):
+            line.append(_T("\\r"));
+            break;
+         default:
+            line.append(*p);
+            break;
+      }
+   }
+   line.append(_T('\n'));
+   char *utf8line = line.getUTF8String();
+
+   m_spillLock.lock();
+   if (m_spillFile == nullptr)
+   {
+      m_spillFile = _tfopen(m_spillFileName, _T("a"));
+      if (m_spillFile == nullptr)
+         nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot open spill file %s (%s)"), m_spillFileName, _tcserror(errno));
+   }
+   bool success = (m_spillFile != nullptr) && (fputs(utf8line, m_spillFile) >= 0);
+   if (success)
+      m_spillFileRecords++;
+   m_spillLock.unlock();
+
+   MemFree(utf8line);
+   if (success)
+      InterlockedIncrement64(&m_spilledValues);
+   return success;
+}
+
+/**
+ * Check if there are spilled values waiting for replay
+ */
+bool PerfDataStorageDispatcher::hasSpilledValues()
+{
+   m_spillLock.lock();
+   bool result = (m_spillFileRecords > 0);
+   m_spillLock.unlock();
+   return result;
+}
+
+/**
+ * Save not yet replayed part of replay file into given file
+ */
+bool PerfDataStorageDispatcher::saveReplayRemainder(FILE *f, const TCHAR *fileName)
+{
+   FILE *out = _tfopen(fileName, _T("w"));
+   if (out == nullptr)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot create file %s (%s)"), fileName, _tcserror(errno));
+      return false;
+   }
+
+   char buffer[4096];
+   size_t bytes;
+   bool success = true;
+   while((bytes = fread(buffer, 1, sizeof(buffer), f)) > 0)
+   {
+      if (fwrite(buffer, 1, bytes, out) != bytes)
+      {
+         success = false;
+         break;
+      }
+   }
+   fclose(out);
+
+   if (!success)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot write file %s"), fileName);
+      _tremove(fileName);
+   }
+   return success;
+}
+
+/**
+ * Read values from spill file and pass them to driver
+ */
+void PerfDataStorageDispatcher::replaySpilledValues()
+{
+   m_spillLock.lock();
+   if (m_spillFile != nullptr)
+   {
+      fclose(m_spillFile);
+      m_spillFile = nullptr;
+   }
+   m_spillFileRecords = 0;
+   // Replay file could be left from interrupted replay, otherwise take current spill file
+   bool haveFile = (_taccess(m_replayFileName, 0) == 0) || (_trename(m_spillFileName, m_replayFileName) == 0);
+   m_spillLock.unlock();
+
+   if (!haveFile)
+      return;
+
+   FILE *f = _tfopen(m_replayFileName, _T("r"));
+   if (f == nullptr)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot open replay file %s (%s)"), m_replayFileName, _tcserror(errno));
+      return;
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 4, _T("Replaying spilled values for driver %s"), m_driver->getName());
+   PerfDataStorageQueueElement **batch = MemAllocArray<PerfDataStorageQueueElement*>(s_batchSize);
+   int count = 0, total = 0;
+   char line[4096];
+   while(!m_shutdown && (fgets(line, sizeof(line), f) != nullptr))
+   {
+      char *eptr;
+      uint32_t ownerId = strtoul(line, &eptr, 10);
+      if (*eptr != '\t')
+         continue;
+      uint32_t dciId = strtoul(eptr + 1, &eptr, 10);
+      if (*eptr != '\t')
+         continue;
+      time_t timestamp = static_cast<time_t>(strtoll(eptr + 1, &eptr, 10));
+      if (*eptr != '\t')
+         continue;
+
+      // Unescape value in place
+      char *src = eptr + 1, *dst = eptr + 1;
+      for(; (*src != 0) && (*src != '\n'); src++)
+      {
+         if ((*src == '\\') && (*(src + 1) != 0))
+         {
+            src++;
+            *dst++ = (*src == 'n') ? '\n' : ((*src == 'r') ? '\r' : *src);
+         }
+         else
+         {
+            *dst++ = *src;
+         }
+      }
+      *dst = 0;
+
+      TCHAR *value = TStringFromUTF8String(eptr + 1);
+      batch[count++] = new PerfDataStorageQueueElement(ownerId, dciId, timestamp, value);
+      MemFree(value);
+      if (count == s_batchSize)
+      {
+         processBatch(batch, count);
+         total += count;
+         count = 0;
+      }
+   }
+   if (count > 0)
+   {
+      processBatch(batch, count);
+      total += count;
+   }
+   MemFree(batch);
+
+   // Every line read so far was passed to driver, so only unread part should be kept
+   // for next start, otherwise already replayed values will be sent again
+   TCHAR remainderFileName[MAX_PATH];
+   _sntprintf(remainderFileName, MAX_PATH, _T("%s.tmp"), m_replayFileName);
+   bool completed = (feof(f) != 0);
+   bool remainderSaved = !completed && saveReplayRemainder(f, remainderFileName);
+   fclose(f);
+   if (completed || remainderSaved)
+      _tremove(m_replayFileName);
+   if (remainderSaved)
+      _trename(remainderFileName, m_replayFileName);
+   nxlog_debug_tag(DEBUG_TAG, 4, _T("%d spilled values replayed for driver %s"), total, m_driver->getName());
+}
+
+/**
+ * Pass batch of requests to driver and destroy queue elements
+ */
+void PerfDataStorageDispatcher::processBatch(PerfDataStorageQueueElement **elements, int count)
+{
+   StructArray<PerfDataStorageItemValue> values(count);
+   SharedObjectArray<DCObject> dcObjects(count);   // Keep DCI objects alive while driver uses them
+   int64_t totalQueueTime = 0;
+   for(int i = 0; i < count; i++)
+   {
+      PerfDataStorageQueueElement *e = elements[i];
+      totalQueueTime += e->queueTime;
+
+      shared_ptr<NetObj> object = FindObjectById(e->ownerId);
+      if ((object == nullptr) || !object->isDataCollectionTarget())
+         continue;
+
+      shared_ptr<DCObject> dci = static_cast<DataCollectionTarget&>(*object).getDCObjectById(e->dciId, 0);
+      if (dci == nullptr)
+         continue;
+
+      if (e->value != nullptr)
+      {
+         if (dci->getType() != DCO_TYPE_ITEM)
+            continue;
+         PerfDataStorageItemValue *v = values.addPlaceholder();
+         v->dci = static_cast<DCItem*>(dci.get());
+         v->timestamp = e->timestamp;
+         v->value = e->value;
+         dcObjects.add(dci);
+      }
+      else if (dci->getType() == DCO_TYPE_TABLE)
+      {
+         m_driver->saveDCTableValue(static_cast<DCTable*>(dci.get()), e->timestamp, e->table.get());
+      }
+   }
+
+   if (!values.isEmpty())
+      m_driver->saveDCItemValues(values);
+
+   // Latency is measured from placing request into queue till completion of driver call
+   int64_t latency = GetCurrentTimeMs() - totalQueueTime / count;
+   UpdateExpMovingAverage(m_averageLatency, EMA_EXP_180, latency);
+
+   for(int i = 0; i < count; i++)
+      delete elements[i];
+}
+
+/**
+ * Dispatcher worker thread
+ */
+void PerfDataStorageDispatcher::workerThread()
+{
+   ThreadSetName("PDSDispatcher");
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("Request dispatcher for driver %s started"), m_driver->getName());
+
+   PerfDataStorageQueueElement **batch = MemAllocArray<PerfDataStorageQueueElement*>(s_batchSize);
+   bool stop = false;
+   while(!stop)
+   {
+      PerfDataStorageQueueElement *e = m_queue.getOrBlock(1000);
+      if (e == nullptr)
+      {
+         // Queue is empty, good time to process spilled values
+         if (hasSpilledValues())
+            replaySpilledValues();
+         continue;
+      }
+
+      int count = 0;
+      while((e != nullptr) && (count < s_batchSize))
+      {
+         if (e == INVALID_POINTER_VALUE)
+         {
+            stop = true;
+            break;
+         }
+         batch[count++] = e;
+         if (count < s_batchSize)
+            e = m_queue.get();
+      }
+      m_spaceAvailable.pulse();
+
+      if (count > 0)
+         processBatch(batch, count);
+
+      if (!stop && (m_queue.size() < s_queueSizeLimit / 2) && hasSpilledValues())
+         replaySpilledValues();
+   }
+   MemFree(batch);
+
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("Request dispatcher for driver %s stopped"), m_driver->getName());
+}
+
 /**
  * Storage request
  */
 void PerfDataStorageRequest(DCItem *dci, time_t timestamp, const TCHAR *value)
 {
    for(int i = 0; i < s_numDrivers; i++)
-      s_drivers[i]->saveDCItemValue(dci, timestamp, value);
+      s_dispatchers[i]->enqueue(new PerfDataStorageQueueElement(dci->getOwnerId(), dci->getId(), timestamp, value));
 }
 
 /**
  * Storage request
  */
-void PerfDataStorageRequest(DCTable *dci, time_t timestamp, Table *value)
+void PerfDataStorageRequest(DCTable *dci, time_t timestamp, const shared_ptr<Table>& value)
+{
+   for(int i = 0; i < s_numDrivers; i++)
+      s_dispatchers[i]->enqueue(new PerfDataStorageQueueElement(dci->getOwnerId(), dci->getId(), timestamp, value));
+}
+
+/**
+ * Get total number of queued performance data storage requests
+ */
+int64_t GetPerfDataStorageQueueSize()
 {
+   int64_t size = 0;
    for(int i = 0; i < s_numDrivers; i++)
-      s_drivers[i]->saveDCTableValue(dci, timestamp, value);
+      size += s_dispatchers[i]->getQueueSize();
+   return size;
 }
 
 /**
@@ -226,6 +711,18 @@ static void LoadDriver(const TCHAR *file)
 void LoadPerfDataStorageDrivers()
 {
    memset(s_drivers, 0, sizeof(PerfDataStorageDriver *) * MAX_PDS_DRIVERS);
+   memset(s_dispatchers, 0, sizeof(PerfDataStorageDispatcher *) * MAX_PDS_DRIVERS);
+
+   s_queueSizeLimit = ConfigReadULong(_T("PerfDataStorage.QueueSizeLimit"), 100000);
+   if (s_queueSizeLimit < 1000)
+      s_queueSizeLimit = 1000;
+   s_batchSize = ConfigReadInt(_T("PerfDataStorage.BatchSize"), 256);
+   if (s_batchSize < 1)
+      s_batchSize = 1;
+   else if (s_batchSize > 65536)
+      s_batchSize = 65536;
+   int policy = ConfigReadInt(_T("PerfDataStorage.OverflowPolicy"), 0);
+   s_overflowPolicy = ((policy >= 0) && (policy <= 2)) ? static_cast<PerfDataStorageOverflowPolicy>(policy) : PerfDataStorageOverflowPolicy::DROP;
 
    nxlog_debug_tag(DEBUG_TAG, 1, _T("Loading performance data storage drivers"));
    for(TCHAR *curr = g_pdsLoadList, *next = nullptr; curr != nullptr; curr = next)
@@ -244,9 +741,15 @@ void LoadPerfDataStorageDrivers()
       if (s_numDrivers == MAX_PDS_DRIVERS)
          break;	// Too many drivers already loaded
    }
+   for(int i = 0; i < s_numDrivers; i++)
+   {
+      s_dispatchers[i] = new PerfDataStorageDispatcher(s_drivers[i]);
+      s_dispatchers[i]->start();
+   }
    if (s_numDrivers > 0)
       g_flags |= AF_PERFDATA_STORAGE_DRIVER_LOADED;
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("%d performance data storage drivers loaded"), s_numDrivers);
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("%d performance data storage drivers loaded (queue size limit %u, batch size %d, overflow policy %d)"),
+            s_numDrivers, static_cast<uint32_t>(s_queueSizeLimit), s_batchSize, static_cast<int>(s_overflowPolicy));
 }
 
 /**
@@ -254,6 +757,14 @@ void LoadPerfDataStorageDrivers()
  */
 void ShutdownPerfDataStorageDrivers()
 {
+   g_flags &= ~AF_PERFDATA_STORAGE_DRIVER_LOADED;
+   for(int i = 0; i < s_numDrivers; i++)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 2, _T("Stopping request dispatcher for driver %s"), s_drivers[i]->getName());
+      s_dispatchers[i]->stop();
+      delete s_dispatchers[i];
+   }
+
    for(int i = 0; i < s_numDrivers; i++)
    {
       nxlog_debug_tag(DEBUG_TAG, 2, _T("Executing shutdown handler for driver %s"), s_drivers[i]->getName());
@@ -279,3 +790,29 @@ DataCollectionError GetPerfDataStorageDriverMetric(const TCHAR *driver, const TC
    }
    return rc;
 }
+
+/**
+ * Get request queue metric for performance data storage driver
+ */
+DataCollectionError GetPerfDataStorageQueueMetric(const TCHAR *driver, const TCHAR *metric, TCHAR *value)
+{
+   for(int i = 0; i < s_numDrivers; i++)
+   {
+      if (_tcsicmp(s_drivers[i]->getName(), driver))
+         continue;
+
+      PerfDataStorageDispatcher *d = s_dispatchers[i];
+      if (!_tcsicmp(metric, _T("AverageLatency")))
+         ret_double(value, d->getAverageLatency(), 2);
+      else if (!_tcsicmp(metric, _T("DroppedValues")))
+         ret_uint64(value, d->getDroppedValues());
+      else if (!_tcsicmp(metric, _T("QueueSize")))
+         ret_uint64(value, d->getQueueSize());
+      else if (!_tcsicmp(metric, _T("SpilledValues")))
+         ret_uint64(value, d->getSpilledValues());
+      else
+         return DCE_NOT_SUPPORTED;
+      return DCE_SUCCESS;
+   }
+   return DCE_NO_SUCH_INSTANCE;
+}
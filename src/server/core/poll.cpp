@@ -304,7 +304,7 @@ void PollManager(Condition *startCondition)
    g_pollerThreadPool = ThreadPoolCreate( _T("POLLERS"),
          ConfigReadInt(_T("ThreadPool.Poller.BaseSize"), 10),
          ConfigReadInt(_T("ThreadPool.Poller.MaxSize"), 250),
-         256 * 1024);
+         256 * 1024, ConfigReadBoolean(_T("ThreadPool.Poller.WorkStealing"), false));
 
    // Start active discovery poller
    THREAD activeDiscoveryPollerThread = ThreadCreateEx(ActiveDiscoveryPoller);
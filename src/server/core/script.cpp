@@ -104,14 +104,6 @@ NXSL_VM NXCORE_EXPORTABLE *SetupServerScriptVM(NXSL_VM *vm, const shared_ptr<Net
    return vm;
 }
 
-/**
- * Server environment creator
- */
-static NXSL_Environment *CreateServerEnvironment(void *context)
-{
-   return new NXSL_ServerEnv();
-}
-
 /**
  * Server script validator
  */
@@ -125,14 +117,289 @@ static bool ScriptValidator(NXSL_LibraryScript *script, void *context)
    return true;
 }
 
+/**
+ * Script VM pool expiration time (seconds since last access). Idle VMs are destroyed and pool statistics discarded.
+ */
+#define SCRIPT_VM_POOL_EXPIRATION_TIME    600
+
+/**
+ * Idle VM timeout (seconds since last access to the pool). Pool is kept for statistics but idle VMs are destroyed.
+ */
+#define SCRIPT_VM_IDLE_TIMEOUT            60
+
+/**
+ * Interval between script VM pool sweeps (milliseconds)
+ */
+#define SCRIPT_VM_POOL_SWEEP_INTERVAL     60000
+
+/**
+ * Pool of ready to run VMs for single compiled program
+ */
+struct ScriptVMPool
+{
+   String name;
+   ObjectArray<NXSL_VM> vms;
+   uint32_t libraryVersion;
+   time_t lastAccessTime;
+   uint64_t hits;
+   uint64_t misses;
+   uint64_t runs;
+   uint64_t totalExecutionTime;  // Microseconds
+
+   ScriptVMPool(const TCHAR *_name, uint32_t _libraryVersion) : name(_name), vms(0, 8, Ownership::True)
+   {
+      libraryVersion = _libraryVersion;
+      lastAccessTime = 0;
+      hits = 0;
+      misses = 0;
+      runs = 0;
+      totalExecutionTime = 0;
+   }
+};
+
+/**
+ * VM pools (keyed by program ID)
+ */
+static HashMap<uint64_t, ScriptVMPool> s_vmPools(Ownership::True);
+static Mutex s_vmPoolLock(MutexType::FAST);
+static uint32_t s_vmPoolSize = 4;
+static uint64_t s_vmPoolHits = 0;
+static uint64_t s_vmPoolMisses = 0;
+
+/**
+ * Set maximum number of idle VMs kept for each compiled program
+ */
+void SetScriptVMPoolSize(uint32_t size)
+{
+   s_vmPoolLock.lock();
+   s_vmPoolSize = size;
+   for(ScriptVMPool *pool : s_vmPools)
+   {
+      while(pool->vms.size() > static_cast<int>(size))
+         pool->vms.remove(pool->vms.size() - 1);
+   }
+   s_vmPoolLock.unlock();
+   nxlog_debug_tag(DEBUG_TAG_BASE, 3, _T("Script VM pool size set to %u"), size);
+}
+
+/**
+ * Destroy idle VMs and remove pools that were not used recently. Pools for per-DCI programs are never accessed
+ * again after DCI script change or DCI deletion, so this is the only way to release their VMs.
+ */
+static void SweepScriptVMPools()
+{
+   ObjectArray<NXSL_VM> expiredVMs(0, 64, Ownership::True);
+   int expiredPools = 0;
+   time_t now = time(nullptr);
+
+   s_vmPoolLock.lock();
+   auto it = s_vmPools.begin();
+   while(it.hasNext())
+   {
+      ScriptVMPool *pool = it.next();
+      if (now - pool->lastAccessTime < SCRIPT_VM_IDLE_TIMEOUT)
+         continue;
+
+      // Move VMs out so they are destroyed outside the lock
+      while(!pool->vms.isEmpty())
+      {
+         int index = pool->vms.size() - 1;
+         expiredVMs.add(pool->vms.get(index));
+         pool->vms.unlink(index);
+      }
+
+      if (now - pool->lastAccessTime >= SCRIPT_VM_POOL_EXPIRATION_TIME)
+      {
+         nxlog_debug_tag(DEBUG_TAG_BASE, 6, _T("Script VM pool for %s expired"), pool->name.cstr());
+         it.remove();
+         expiredPools++;
+      }
+   }
+   s_vmPoolLock.unlock();
+
+   if (!expiredVMs.isEmpty() || (expiredPools > 0))
+      nxlog_debug_tag(DEBUG_TAG_BASE, 6, _T("Script VM pool sweep: %d idle VMs destroyed, %d pools removed"), expiredVMs.size(), expiredPools);
+
+   ThreadPoolScheduleRelative(g_mainThreadPool, SCRIPT_VM_POOL_SWEEP_INTERVAL, SweepScriptVMPools);
+}
+
+/**
+ * Get VM for given program from pool or create new one. Library scripts should be passed with library lock held.
+ * Returns nullptr if program cannot be loaded.
+ */
+static NXSL_VM *AcquireScriptVM(const NXSL_Program *program, const TCHAR *name, uint32_t libraryVersion)
+{
+   NXSL_VM *vm = nullptr;
+   time_t now = time(nullptr);
+
+   s_vmPoolLock.lock();
+   ScriptVMPool *pool = s_vmPools.get(program->getId());
+   if (pool == nullptr)
+   {
+      pool = new ScriptVMPool(name, libraryVersion);
+      s_vmPools.set(program->getId(), pool);
+   }
+   else if (pool->libraryVersion != libraryVersion)
+   {
+      // Imported modules may have been changed
+      pool->vms.clear();
+      pool->libraryVersion = libraryVersion;
+   }
+   pool->lastAccessTime = now;
+
+   if (!pool->vms.isEmpty())
+   {
+      int index = pool->vms.size() - 1;
+      vm = pool->vms.get(index);
+      pool->vms.unlink(index);
+      pool->hits++;
+      s_vmPoolHits++;
+   }
+   else
+   {
+      pool->misses++;
+      s_vmPoolMisses++;
+   }
+
+   s_vmPoolLock.unlock();
+
+   if (vm == nullptr)
+   {
+      vm = new NXSL_VM(new NXSL_ServerEnv());
+      if (!vm->load(program))
+      {
+         delete vm;
+         vm = nullptr;
+      }
+   }
+   return vm;
+}
+
+/**
+ * Return VM to the pool after use
+ */
+static void ReleaseScriptVM(NXSL_VM *vm, uint64_t programId, uint32_t libraryVersion, int64_t executionTime)
+{
+   bool reusable = vm->reset();
+
+   s_vmPoolLock.lock();
+   ScriptVMPool *pool = s_vmPools.get(programId);
+   if (pool != nullptr)
+   {
+      pool->runs++;
+      pool->totalExecutionTime += executionTime;
+      if (reusable && (pool->libraryVersion == libraryVersion) && (pool->vms.size() < static_cast<int>(s_vmPoolSize)))
+      {
+         pool->vms.add(vm);
+         vm = nullptr;
+      }
+   }
+   s_vmPoolLock.unlock();
+
+   delete vm;
+}
+
+/**
+ * Destroy VM referenced by this handle or return it to the pool
+ */
+void ScriptVMHandle::destroy()
+{
+   if (m_vm == nullptr)
+      return;
+
+   if (m_programId != 0)
+      ReleaseScriptVM(m_vm, m_programId, m_libraryVersion, GetCurrentTimeUs() - m_startTime);
+   else
+      delete m_vm;
+   m_vm = nullptr;
+}
+
+/**
+ * Get script VM pool statistics
+ */
+void GetScriptVMPoolStatistics(uint64_t *hits, uint64_t *misses, uint32_t *idleVMs)
+{
+   s_vmPoolLock.lock();
+   *hits = s_vmPoolHits;
+   *misses = s_vmPoolMisses;
+   uint32_t count = 0;
+   for(ScriptVMPool *pool : s_vmPools)
+      count += pool->vms.size();
+   *idleVMs = count;
+   s_vmPoolLock.unlock();
+}
+
+/**
+ * Get execution statistics for given script (all compiled versions of the script are counted).
+ * Returns false if script was not executed recently.
+ */
+bool GetScriptExecutionStatistics(const TCHAR *name, uint64_t *runs, uint64_t *averageExecutionTime)
+{
+   uint64_t count = 0, totalTime = 0;
+   bool found = false;
+   s_vmPoolLock.lock();
+   for(ScriptVMPool *pool : s_vmPools)
+   {
+      if (!_tcsicmp(pool->name, name))
+      {
+         count += pool->runs;
+         totalTime += pool->totalExecutionTime;
+         found = true;
+      }
+   }
+   s_vmPoolLock.unlock();
+
+   *runs = count;
+   *averageExecutionTime = (count > 0) ? totalTime / count : 0;
+   return found;
+}
+
+/**
+ * Show script VM pool statistics on server console
+ */
+void ShowScriptVMPoolStatistics(ServerConsole *console)
+{
+   s_vmPoolLock.lock();
+   uint64_t total = s_vmPoolHits + s_vmPoolMisses;
+   console->printf(_T("Pool size .....: %u\n"), s_vmPoolSize);
+   console->printf(_T("Hits ..........: ") UINT64_FMT _T("\n"), s_vmPoolHits);
+   console->printf(_T("Misses ........: ") UINT64_FMT _T("\n"), s_vmPoolMisses);
+   console->printf(_T("Hit ratio .....: %u%%\n\n"), (total > 0) ? static_cast<uint32_t>(s_vmPoolHits * 100 / total) : 0);
+   if (s_vmPools.size() > 0)
+   {
+      console->print(_T(" \x1b[1mIdle\x1b[0m | \x1b[1mHits\x1b[0m     | \x1b[1mMisses\x1b[0m   | \x1b[1mRuns\x1b[0m     | \x1b[1mAvg time\x1b[0m | \x1b[1mScript\x1b[0m\n"));
+      console->print(_T("------+----------+----------+----------+----------+--------------------------------\n"));
+      for(ScriptVMPool *pool : s_vmPools)
+      {
+         console->printf(_T(" %4d | ") UINT64_FMT_ARGS(_T("8")) _T(" | ") UINT64_FMT_ARGS(_T("8")) _T(" | ") UINT64_FMT_ARGS(_T("8")) _T(" | %6.1fus | %s\n"),
+               pool->vms.size(), pool->hits, pool->misses, pool->runs,
+               (pool->runs > 0) ? static_cast<double>(pool->totalExecutionTime) / pool->runs : 0.0, pool->name.cstr());
+      }
+      console->print(_T("\n"));
+   }
+   s_vmPoolLock.unlock();
+}
+
 /**
  * Create NXSL VM from library script. Created VM will take ownership of DCI descriptor.
  */
 ScriptVMHandle NXCORE_EXPORTABLE CreateServerScriptVM(const TCHAR *name, const shared_ptr<NetObj>& object, const shared_ptr<DCObjectInfo>& dciInfo)
 {
    ScriptVMFailureReason failureReason = ScriptVMFailureReason::SCRIPT_NOT_FOUND;
-   NXSL_VM *vm = s_scriptLibrary.createVM(name, CreateServerEnvironment, ScriptValidator, &failureReason);
-   return (vm != nullptr) ? ScriptVMHandle(SetupServerScriptVM(vm, object, dciInfo)) : ScriptVMHandle(failureReason);
+   NXSL_VM *vm = nullptr;
+   uint64_t programId = 0;
+
+   s_scriptLibrary.lock();
+   uint32_t libraryVersion = s_scriptLibrary.getChangeCounter();
+   NXSL_LibraryScript *script = s_scriptLibrary.findScript(name);
+   if ((script != nullptr) && script->isValid() && ScriptValidator(script, &failureReason))
+   {
+      programId = script->getProgram()->getId();
+      vm = AcquireScriptVM(script->getProgram(), script->getName(), libraryVersion);
+   }
+   s_scriptLibrary.unlock();
+
+   return (vm != nullptr) ? ScriptVMHandle(SetupServerScriptVM(vm, object, dciInfo), programId, libraryVersion) : ScriptVMHandle(failureReason);
 }
 
 /**
@@ -143,14 +410,18 @@ ScriptVMHandle NXCORE_EXPORTABLE CreateServerScriptVM(const NXSL_Program *script
    if (script->isEmpty())
       return ScriptVMHandle(ScriptVMFailureReason::SCRIPT_IS_EMPTY);
 
-   NXSL_VM *vm = new NXSL_VM(new NXSL_ServerEnv());
-   if (!vm->load(script))
-   {
-      delete vm;
+   TCHAR name[64];
+   if (dciInfo != nullptr)
+      _sntprintf(name, 64, _T("DCI::%u::%u"), dciInfo->getOwnerId(), dciInfo->getId());
+   else
+      _sntprintf(name, 64, _T("Program::") UINT64_FMT, script->getId());
+
+   uint32_t libraryVersion = s_scriptLibrary.getChangeCounter();
+   NXSL_VM *vm = AcquireScriptVM(script, name, libraryVersion);
+   if (vm == nullptr)
       return ScriptVMHandle(ScriptVMFailureReason::SCRIPT_LOAD_ERROR);
-   }
 
-   return ScriptVMHandle(SetupServerScriptVM(vm, object, dciInfo));
+   return ScriptVMHandle(SetupServerScriptVM(vm, object, dciInfo), script->getId(), libraryVersion);
 }
 
 /**
@@ -158,6 +429,8 @@ ScriptVMHandle NXCORE_EXPORTABLE CreateServerScriptVM(const NXSL_Program *script
  */
 void LoadScripts()
 {
+   s_vmPoolSize = ConfigReadULong(_T("NXSL.VMPoolSize"), 4);
+
    DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
    DB_RESULT hResult = DBSelect(hdb, _T("SELECT script_id,guid,script_name,script_code FROM script_library"));
    if (hResult != nullptr)
@@ -180,6 +453,8 @@ void LoadScripts()
       DBFreeResult(hResult);
    }
    DBConnectionPoolReleaseConnection(hdb);
+
+   ThreadPoolScheduleRelative(g_mainThreadPool, SCRIPT_VM_POOL_SWEEP_INTERVAL, SweepScriptVMPools);
 }
 
 /**
@@ -39,7 +39,6 @@
 /**
  * Externals
  */
-extern ObjectQueue<SyslogMessage> g_syslogProcessingQueue;
 extern ObjectQueue<SyslogMessage> g_syslogWriteQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventProcessingQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventWriterQueue;
@@ -49,6 +48,8 @@ extern ThreadPool *g_schedulerThreadPool;
 
 int64_t GetEventLogWriterQueueSize();
 int64_t GetEventProcessorQueueSize();
+int64_t GetPerfDataStorageQueueSize();
+int64_t GetSyslogProcessorQueueSize();
 
 /**
  * Internal queue statistic
@@ -144,9 +145,10 @@ void ServerStatCollector()
    AddQueueToCollector(_T("EventLogWriter"), GetEventLogWriterQueueSize);
    AddQueueToCollector(_T("EventProcessor"), GetEventProcessorQueueSize);
    AddQueueToCollector(_T("NodeDiscoveryPoller"), GetDiscoveryPollerQueueSize);
+   AddQueueToCollector(_T("PerfDataStorage"), GetPerfDataStorageQueueSize);
    AddQueueToCollector(_T("Poller"), g_pollerThreadPool);
    AddQueueToCollector(_T("Scheduler"), g_schedulerThreadPool);
-   AddQueueToCollector(_T("SyslogProcessor"), &g_syslogProcessingQueue);
+   AddQueueToCollector(_T("SyslogProcessor"), GetSyslogProcessorQueueSize);
    AddQueueToCollector(_T("SyslogWriter"), &g_syslogWriteQueue);
    AddQueueToCollector(_T("TemplateUpdater"), &g_templateUpdateQueue);
    AddQueueToCollector(_T("WindowsEventProcessor"), &g_windowsEventProcessingQueue);
@@ -2016,6 +2016,102 @@ void ClientSession::sendRawMessageAndDelete(NXCP_MESSAGE *msg)
    decRefCount();
 }
 
+/**
+ * Maximum size of message batch before it is sent to client
+ */
+#define MESSAGE_BATCH_SIZE_LIMIT 65536
+
+/**
+ * Append raw message to batch (encrypting it if needed) and send batch to client if it exceeds size limit.
+ * Message is destroyed by this method.
+ */
+void ClientSession::appendToMessageBatch(ByteStream *batch, NXCP_MESSAGE *msg)
+{
+   if ((m_flags & (CSF_TERMINATE_REQUESTED | CSF_TERMINATED)) != 0)
+   {
+      MemFree(msg);
+      return;
+   }
+
+   if (nxlog_get_debug_level_tag_object(DEBUG_TAG, m_id) >= 6)
+   {
+      TCHAR buffer[128];
+      debugPrintf(6, _T("Sending%s message %s (%d bytes)"),
+               (ntohs(msg->flags) & MF_COMPRESSED) ? _T(" compressed") : _T(""), NXCPMessageCodeName(ntohs(msg->code), buffer), ntohl(msg->size));
+      if (nxlog_get_debug_level_tag_object(DEBUG_TAG, m_id) >= 8)
+      {
+         String msgDump = NXCPMessage::dump(msg, NXCP_VERSION);
+         debugPrintf(8, _T("Message dump:\n%s"), (const TCHAR *)msgDump);
+      }
+   }
+
+   if (m_encryptionContext != nullptr)
+   {
+      NXCP_ENCRYPTED_MESSAGE *emsg = m_encryptionContext->encryptMessage(msg);
+      if (emsg != nullptr)
+      {
+         batch->write(emsg, ntohl(emsg->size));
+         MemFree(emsg);
+      }
+      else
+      {
+         // Client cannot continue with gap in message stream
+         MemFree(msg);
+         batch->clear();
+         InterlockedOr(&m_flags, CSF_TERMINATE_REQUESTED);
+         m_socketPoller->poller.cancel(m_socket);
+         return;
+      }
+   }
+   else
+   {
+      batch->write(msg, ntohl(msg->size));
+   }
+   MemFree(msg);
+
+   if (batch->size() >= MESSAGE_BATCH_SIZE_LIMIT)
+      sendMessageBatch(batch);
+}
+
+/**
+ * Send all messages accumulated in batch to client with single socket write
+ */
+bool ClientSession::sendMessageBatch(ByteStream *batch)
+{
+   if (batch->size() == 0)
+      return true;
+
+   if (isTerminated())
+   {
+      batch->clear();
+      return false;
+   }
+
+   bool result = (SendEx(m_socket, batch->buffer(), batch->size(), 0, &m_mutexSocketWrite) == static_cast<ssize_t>(batch->size()));
+   batch->clear();
+   if (!result)
+   {
+      InterlockedOr(&m_flags, CSF_TERMINATE_REQUESTED);
+      m_socketPoller->poller.cancel(m_socket);
+   }
+   return result;
+}
+
+/**
+ * Get options for object message sent to this session
+ */
+uint32_t ClientSession::getObjectMessageOptions(NetObj *object)
+{
+   uint32_t options = 0;
+   if (m_flags & CSF_SYNC_OBJECT_COMMENTS)
+      options |= OBJECT_MESSAGE_INCLUDE_COMMENTS;
+   if (m_flags & CSF_COMPRESSION_ENABLED)
+      options |= OBJECT_MESSAGE_COMPRESSED;
+   if ((object->getObjectClass() == OBJECT_NODE) && !object->checkAccessRights(m_dwUserId, OBJECT_ACCESS_MODIFY))
+      options |= OBJECT_MESSAGE_MASK_PASSWORDS;
+   return options;
+}
+
 /**
  * Send raw message in background and delete after sending
  */
@@ -2691,14 +2787,12 @@ void ClientSession::getObjects(const NXCPMessage& request)
    if (request.getFieldAsBoolean(VID_SYNC_NODE_COMPONENTS))
       syncNodeComponents = true;
 
-   // Prepare message
-   response.setCode(CMD_OBJECT);
-
-   // Send objects, one per message
+   // Send objects, one per message, coalescing messages into larger socket writes
    SessionObjectFilterData data;
    data.session = this;
    data.baseTimeStamp = request.getFieldAsTime(VID_TIMESTAMP);
 	unique_ptr<SharedObjectArray<NetObj>> objects = g_idxObjectById.getObjects(SessionObjectFilter, &data);
+   ByteStream batch(MESSAGE_BATCH_SIZE_LIMIT + 8192);
 	for(int i = 0; i < objects->size(); i++)
 	{
       NetObj *object = objects->get(i);
@@ -2708,20 +2802,9 @@ void ClientSession::getObjects(const NXCPMessage& request)
 	   {
          continue;
 	   }
-
-      object->fillMessage(&response, m_dwUserId);
-      if (m_flags & CSF_SYNC_OBJECT_COMMENTS)
-         object->commentsToMessage(&response);
-      if ((object->getObjectClass() == OBJECT_NODE) && !object->checkAccessRights(m_dwUserId, OBJECT_ACCESS_MODIFY))
-      {
-         // mask passwords
-         response.setField(VID_SHARED_SECRET, _T("********"));
-         response.setField(VID_SNMP_AUTH_PASSWORD, _T("********"));
-         response.setField(VID_SNMP_PRIV_PASSWORD, _T("********"));
-      }
-      sendMessage(&response);
-      response.deleteAllFields();
+      appendToMessageBatch(&batch, object->createClientMessage(CMD_OBJECT, request.getId(), m_dwUserId, getObjectMessageOptions(object)));
 	}
+   sendMessageBatch(&batch);
 
    // Send end of list notification
    response.setCode(CMD_OBJECT_LIST_END);
@@ -2751,10 +2834,9 @@ void ClientSession::getSelectedObjects(const NXCPMessage& request)
 	request.getFieldAsInt32Array(VID_OBJECT_LIST, &objects);
 	uint32_t options = request.getFieldAsUInt16(VID_FLAGS);
 
-   // Prepare message
-	response.setCode((options & OBJECT_SYNC_SEND_UPDATES) ? CMD_OBJECT_UPDATE : CMD_OBJECT);
-
-   // Send objects, one per message
+   // Send objects, one per message, coalescing messages into larger socket writes
+   uint16_t code = (options & OBJECT_SYNC_SEND_UPDATES) ? CMD_OBJECT_UPDATE : CMD_OBJECT;
+   ByteStream batch(MESSAGE_BATCH_SIZE_LIMIT + 8192);
    for(int i = 0; i < objects.size(); i++)
 	{
 		shared_ptr<NetObj> object = FindObjectById(objects.get(i));
@@ -2763,20 +2845,10 @@ void ClientSession::getSelectedObjects(const NXCPMessage& request)
           (object->getTimeStamp() >= timestamp) &&
           !object->isHidden() && !object->isSystem())
       {
-         object->fillMessage(&response, m_dwUserId);
-         if (m_flags & CSF_SYNC_OBJECT_COMMENTS)
-            object->commentsToMessage(&response);
-         if ((object->getObjectClass() == OBJECT_NODE) && !object->checkAccessRights(m_dwUserId, OBJECT_ACCESS_MODIFY))
-         {
-            // mask passwords
-            response.setField(VID_SHARED_SECRET, _T("********"));
-            response.setField(VID_SNMP_AUTH_PASSWORD, _T("********"));
-            response.setField(VID_SNMP_PRIV_PASSWORD, _T("********"));
-         }
-         sendMessage(&response);
-         response.deleteAllFields();
+         appendToMessageBatch(&batch, object->createClientMessage(code, request.getId(), m_dwUserId, getObjectMessageOptions(object.get())));
       }
 	}
+   sendMessageBatch(&batch);
 
    InterlockedOr(&m_flags, CSF_OBJECT_SYNC_FINISHED);
 
@@ -3277,31 +3349,23 @@ void ClientSession::sendObjectUpdates()
 
    int64_t startTime = GetCurrentTimeMs();
 
-   NXCPMessage msg(CMD_OBJECT_UPDATE, 0);
+   ByteStream batch(MESSAGE_BATCH_SIZE_LIMIT + 8192);
    for(size_t i = 0; i < count; i++)
    {
-      msg.deleteAllFields();
       shared_ptr<NetObj> object = FindObjectById(idList[i]);
       if ((object != nullptr) && !object->isDeleted())
       {
-         object->fillMessage(&msg, m_dwUserId);
-         if (m_flags & CSF_SYNC_OBJECT_COMMENTS)
-            object->commentsToMessage(&msg);
-         if ((object->getObjectClass() == OBJECT_NODE) && !object->checkAccessRights(m_dwUserId, OBJECT_ACCESS_MODIFY))
-         {
-            // mask passwords
-            msg.setField(VID_SHARED_SECRET, _T("********"));
-            msg.setField(VID_SNMP_AUTH_PASSWORD, _T("********"));
-            msg.setField(VID_SNMP_PRIV_PASSWORD, _T("********"));
-         }
+         appendToMessageBatch(&batch, object->createClientMessage(CMD_OBJECT_UPDATE, 0, m_dwUserId, getObjectMessageOptions(object.get())));
       }
       else
       {
+         NXCPMessage msg(CMD_OBJECT_UPDATE, 0);
          msg.setField(VID_OBJECT_ID, idList[i]);
          msg.setField(VID_IS_DELETED, true);
+         appendToMessageBatch(&batch, msg.serialize((m_flags & CSF_COMPRESSION_ENABLED) != 0));
       }
-      sendMessage(msg);
    }
+   sendMessageBatch(&batch);
 
    uint32_t elapsedTime = static_cast<uint32_t>(GetCurrentTimeMs() - startTime);
    if ((elapsedTime > 500) && ((m_objectNotificationBatchSize > 100) || (m_objectNotificationDelay < 1000)))
@@ -4370,6 +4434,7 @@ void ClientSession::forceDCIPoll(const NXCPMessage& request)
 				   if (dci->hasAccess(m_dwUserId))
 				   {
                   dci->requestForcePoll(this);
+                  ScheduleDCObjectPoll(dci, time(nullptr));
                   response.setField(VID_RCC, RCC_SUCCESS);
                   debugPrintf(4, _T("ForceDCIPoll: DCI %d at node %d"), dciId, object->getId());
                   writeAuditLog(AUDIT_OBJECTS, true, object->getId(), _T("Forced DCI poll initiated for DCI \"%s\" [%u]"), dci->getDescription().cstr(), dci->getId());
@@ -4670,6 +4735,33 @@ static DB_STATEMENT PrepareDataSelect(DB_HANDLE hdb, uint32_t nodeId, int dciTyp
  */
 static uint32_t s_rowSize[] = { 8, 8, 16, 16, 516, 16, 8, 8, 16 };
 
+/**
+ * Send aggregated DCI data to client. Points are expected in ascending order and sent in descending order
+ * to match ordering of data read directly from database.
+ */
+static void SendAggregatedData(ClientSession *session, uint32_t requestId, uint32_t dciId, const StructArray<AggregatedDataPoint>& points)
+{
+   size_t dataSize = s_rowSize[DCI_DT_FLOAT] * points.size() + sizeof(DCI_DATA_HEADER);
+   auto pData = static_cast<DCI_DATA_HEADER*>(MemAlloc(dataSize));
+   pData->dataType = htonl(static_cast<uint32_t>(DCI_DT_FLOAT));
+   pData->dciId = htonl(dciId);
+   pData->numRows = htonl(static_cast<uint32_t>(points.size()));
+
+   auto currRow = reinterpret_cast<DCI_DATA_ROW*>(reinterpret_cast<char*>(pData) + sizeof(DCI_DATA_HEADER));
+   for(int i = points.size() - 1; i >= 0; i--)
+   {
+      const AggregatedDataPoint *p = points.get(i);
+      currRow->timeStamp = htonl(static_cast<uint32_t>(p->timestamp));
+      currRow->value.ext.v64.real = htond(p->value);
+      currRow = reinterpret_cast<DCI_DATA_ROW*>(reinterpret_cast<char*>(currRow) + s_rowSize[DCI_DT_FLOAT]);
+   }
+
+   NXCP_MESSAGE *msg = CreateRawNXCPMessage(CMD_DCI_DATA, requestId, 0, pData, dataSize, nullptr, session->isCompressionEnabled());
+   MemFree(pData);
+   session->sendRawMessage(msg);
+   MemFree(msg);
+}
+
 /**
  * Process results from SELECT statement for DCI data
  */
@@ -4924,6 +5016,38 @@ bool ClientSession::getCollectedDataFromDB(const NXCPMessage& request, NXCPMessa
 	if ((maxRows == 0) || (maxRows > MAX_DCI_DATA_RECORDS))
 		maxRows = MAX_DCI_DATA_RECORDS;
 
+	// Server-side aggregation is only available for processed values of numeric single value DCIs
+	auto aggregationMode = static_cast<DataAggregationMode>(request.getFieldAsInt16(VID_DATA_AGGREGATION));
+	if ((aggregationMode != DAM_NONE) && (dciType == DCO_TYPE_ITEM) && (static_cast<DCItem&>(*dci).getDataType() != DCI_DT_STRING))
+	{
+	   if (historicalDataType != HDT_PROCESSED)
+	   {
+	      response->setField(VID_RCC, RCC_INCOMPATIBLE_OPERATION);
+	      return false;
+	   }
+	   if ((timeFrom == 0) || (aggregationMode > DAM_LTTB))
+	   {
+	      response->setField(VID_RCC, RCC_INVALID_ARGUMENT);
+	      return false;
+	   }
+	   if (timeTo == 0)
+	      timeTo = static_cast<uint32_t>(time(nullptr));
+
+	   debugPrintf(7, _T("getCollectedDataFromDB: reading aggregated data (mode = %d, maxRows = %u)"), aggregationMode, maxRows);
+	   StructArray<AggregatedDataPoint> points(0, 1024);
+	   if (!ReadAggregatedDCIData(dcTarget, static_cast<DCItem&>(*dci), timeFrom, timeTo, maxRows, aggregationMode, &points))
+	   {
+	      response->setField(VID_RCC, RCC_DB_FAILURE);
+	      return false;
+	   }
+
+	   response->setField(VID_RCC, RCC_SUCCESS);
+	   static_cast<DCItem&>(*dci).fillMessageWithThresholds(response, false);
+	   sendMessage(response);
+	   SendAggregatedData(this, request.getId(), dci->getId(), points);
+	   return true;
+	}
+
 	// If only last value requested, try to get it from cache first
 	if ((maxRows == 1) && (timeTo == 0) && (historicalDataType == HDT_PROCESSED))
 	{
@@ -42,10 +42,135 @@ VolatileCounter64 g_snmpTrapsReceived = 0;
  * Static data
  */
 static Mutex s_trapCfgLock;
-static ObjectArray<SNMPTrapConfiguration> m_trapCfgList(16, 4, Ownership::True);
+static SharedObjectArray<SNMPTrapConfiguration> m_trapCfgList(16, 16);
 static VolatileCounter64 s_trapId = 0; // Last used trap ID
 static uint16_t s_trapListenerPort = 162;
 
+/**
+ * Node of trap OID tree. Child nodes are kept sorted by OID element.
+ */
+class TrapOidTreeNode
+{
+private:
+   uint32_t m_element;
+   shared_ptr<SNMPTrapConfiguration> m_trapCfg;
+   ObjectArray<TrapOidTreeNode> m_children;
+
+   int findChildIndex(uint32_t element, bool *found) const
+   {
+      int low = 0, high = m_children.size() - 1;
+      while(low <= high)
+      {
+         int mid = (low + high) / 2;
+         uint32_t e = m_children.get(mid)->m_element;
+         if (e == element)
+         {
+            *found = true;
+            return mid;
+         }
+         if (e < element)
+            low = mid + 1;
+         else
+            high = mid - 1;
+      }
+      *found = false;
+      return low;
+   }
+
+public:
+   TrapOidTreeNode(uint32_t element) : m_children(0, 8, Ownership::True)
+   {
+      m_element = element;
+   }
+
+   TrapOidTreeNode *findChild(uint32_t element) const
+   {
+      bool found;
+      int index = findChildIndex(element, &found);
+      return found ? m_children.get(index) : nullptr;
+   }
+
+   TrapOidTreeNode *getOrCreateChild(uint32_t element)
+   {
+      bool found;
+      int index = findChildIndex(element, &found);
+      if (found)
+         return m_children.get(index);
+      TrapOidTreeNode *n = new TrapOidTreeNode(element);
+      m_children.insert(index, n);
+      return n;
+   }
+
+   const shared_ptr<SNMPTrapConfiguration>& getTrapCfg() const { return m_trapCfg; }
+   void setTrapCfg(const shared_ptr<SNMPTrapConfiguration>& trapCfg) { m_trapCfg = trapCfg; }
+};
+
+/**
+ * Immutable tree of configured trap OIDs. New tree is built on every configuration change and
+ * published atomically, so trap receiver can match traps without holding configuration lock.
+ */
+class TrapOidTree
+{
+private:
+   TrapOidTreeNode m_root;
+
+public:
+   TrapOidTree(const SharedObjectArray<SNMPTrapConfiguration>& trapCfgList);
+
+   shared_ptr<SNMPTrapConfiguration> findBestMatch(const SNMP_ObjectId& oid) const;
+};
+
+/**
+ * Build tree from trap configuration list. If several entries have same OID, first one in the list wins.
+ */
+TrapOidTree::TrapOidTree(const SharedObjectArray<SNMPTrapConfiguration>& trapCfgList) : m_root(0)
+{
+   for(int i = 0; i < trapCfgList.size(); i++)
+   {
+      const shared_ptr<SNMPTrapConfiguration>& trapCfg = trapCfgList.getShared(i);
+      const SNMP_ObjectId& oid = trapCfg->getOid();
+      if (oid.length() == 0)
+         continue;
+
+      TrapOidTreeNode *node = &m_root;
+      for(size_t j = 0; j < oid.length(); j++)
+         node = node->getOrCreateChild(oid.value()[j]);
+      if (node->getTrapCfg() == nullptr)
+         node->setTrapCfg(trapCfg);
+   }
+}
+
+/**
+ * Find configuration entry with longest OID that is equal to or is a prefix of given trap OID
+ */
+shared_ptr<SNMPTrapConfiguration> TrapOidTree::findBestMatch(const SNMP_ObjectId& oid) const
+{
+   const TrapOidTreeNode *match = nullptr;
+   const TrapOidTreeNode *node = &m_root;
+   for(size_t i = 0; i < oid.length(); i++)
+   {
+      node = node->findChild(oid.value()[i]);
+      if (node == nullptr)
+         break;
+      if (node->getTrapCfg() != nullptr)
+         match = node;
+   }
+   return (match != nullptr) ? match->getTrapCfg() : shared_ptr<SNMPTrapConfiguration>();
+}
+
+/**
+ * Current trap OID tree (should be accessed only via std::atomic_load/std::atomic_store)
+ */
+static shared_ptr<TrapOidTree> s_trapOidTree = make_shared<TrapOidTree>(m_trapCfgList);
+
+/**
+ * Rebuild trap OID tree. Should be called with trap configuration lock held.
+ */
+static void RebuildTrapOidTree()
+{
+   std::atomic_store(&s_trapOidTree, make_shared<TrapOidTree>(m_trapCfgList));
+}
+
 /**
  * Collects information about all SNMPTraps that are using specified event
  */
@@ -400,6 +525,10 @@ void LoadTrapCfg()
          }
          if (hStmt != nullptr)
             DBFreeStatement(hStmt);
+
+         s_trapCfgLock.lock();
+         RebuildTrapOidTree();
+         s_trapCfgLock.unlock();
       }
       DBFreeResult(hResult);
    }
@@ -441,10 +570,8 @@ void InitTraps()
 /**
  * Generate event for matched trap
  */
-static void GenerateTrapEvent(const shared_ptr<Node>& node, UINT32 dwIndex, SNMP_PDU *pdu, int sourcePort)
+static void GenerateTrapEvent(const shared_ptr<Node>& node, const SNMPTrapConfiguration *trapCfg, SNMP_PDU *pdu, int sourcePort)
 {
-   SNMPTrapConfiguration *trapCfg = m_trapCfgList.get(dwIndex);
-
    StringMap parameters;
    parameters.set(_T("oid"), pdu->getTrapId().toString());
 
@@ -571,7 +698,6 @@ void ProcessTrap(SNMP_PDU *pdu, const InetAddress& srcAddr, int32_t zoneUIN, int
    StringBuffer varbinds;
    TCHAR buffer[4096];
 	bool processedByModule = false;
-   int iResult;
 
    InterlockedIncrement64(&g_snmpTrapsReceived);
    nxlog_debug_tag(DEBUG_TAG, 4, _T("Received SNMP %s %s from %s"), isInformRq ? _T("INFORM-REQUEST") : _T("TRAP"),
@@ -659,38 +785,11 @@ void ProcessTrap(SNMP_PDU *pdu, const InetAddress& srcAddr, int32_t zoneUIN, int
                }
             }
 
-            // Find if we have this trap in our list
-            s_trapCfgLock.lock();
-
-            // Try to find closest match
-            size_t matchLen = 0;
-            int matchIndex;
-            for(int i = 0; i < m_trapCfgList.size(); i++)
-            {
-               const SNMPTrapConfiguration *trapCfg = m_trapCfgList.get(i);
-               if (trapCfg->getOid().length() > 0)
-               {
-                  iResult = pdu->getTrapId().compare(trapCfg->getOid());
-                  if (iResult == OID_EQUAL)
-                  {
-                     matchLen = trapCfg->getOid().length();
-                     matchIndex = i;
-                     break;   // Find exact match
-                  }
-                  else if (iResult == OID_LONGER)
-                  {
-                     if (trapCfg->getOid().length() > matchLen)
-                     {
-                        matchLen = trapCfg->getOid().length();
-                        matchIndex = i;
-                     }
-                  }
-               }
-            }
-
-            if (matchLen > 0)
+            // Find closest match in trap configuration (exact match or longest prefix)
+            shared_ptr<SNMPTrapConfiguration> trapCfg = std::atomic_load(&s_trapOidTree)->findBestMatch(pdu->getTrapId());
+            if (trapCfg != nullptr)
             {
-               GenerateTrapEvent(node, matchIndex, pdu, srcPort);
+               GenerateTrapEvent(node, trapCfg.get(), pdu, srcPort);
             }
             else if (!processedByModule)    // Process unmatched traps not processed by module
             {
@@ -700,7 +799,6 @@ void ProcessTrap(SNMP_PDU *pdu, const InetAddress& srcAddr, int32_t zoneUIN, int
                PostEventWithNames(EVENT_SNMP_UNMATCHED_TRAP, EventOrigin::SNMP, 0, node->getId(), "ssd", names,
                   pdu->getTrapId().toString(oidText, 1024), (const TCHAR *)varbinds, srcPort);
             }
-            s_trapCfgLock.unlock();
          }
          else
          {
@@ -1052,6 +1150,7 @@ UINT32 DeleteTrap(UINT32 id)
                if (DBExecute(hStmtCfg) && DBExecute(hStmtMap))
                {
                   m_trapCfgList.remove(i);
+                  RebuildTrapOidTree();
                   NotifyOnTrapCfgDelete(id);
                   dwResult = RCC_SUCCESS;
                   DBCommit(hdb);
@@ -1306,6 +1405,7 @@ void AddTrapCfgToList(SNMPTrapConfiguration *trapCfg)
       }
    }
    m_trapCfgList.add(trapCfg);
+   RebuildTrapOidTree();
 
    s_trapCfgLock.unlock();
 }
@@ -35,7 +35,6 @@
 /**
  * Queues
  */
-ObjectQueue<SyslogMessage> g_syslogProcessingQueue(1024, Ownership::False);
 ObjectQueue<SyslogMessage> g_syslogWriteQueue(1024, Ownership::False);
 
 /**
@@ -55,12 +54,11 @@ enum NodeMatchingPolicy
 /**
  * Static data
  */
-static uint64_t s_msgId = 1;  // Next available message ID
-static LogParser *s_parser = nullptr;
+static VolatileCounter64 s_msgId = 1;  // Next available message ID
+static LogParser *s_parser = nullptr;  // Master copy of parser (not used for matching directly)
 static Mutex s_parserLock(MutexType::FAST);
 static NodeMatchingPolicy s_nodeMatchingPolicy = SOURCE_IP_THEN_HOSTNAME;
 static THREAD s_receiverThread = INVALID_THREAD_HANDLE;
-static THREAD s_processingThread = INVALID_THREAD_HANDLE;
 static THREAD s_writerThread = INVALID_THREAD_HANDLE;
 static bool s_running = true;
 static bool s_alwaysUseServerTime = false;
@@ -357,6 +355,58 @@ static void BroadcastSyslogMessage(ClientSession *session, SyslogMessage *msg)
       session->onSyslogMessage(msg);
 }
 
+/**
+ * Bind syslog message to insert statement
+ */
+static void BindSyslogMessage(DB_STATEMENT hStmt, const SyslogMessage *msg)
+{
+   DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, msg->getId());
+   DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(msg->getTimestamp()));
+   DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, msg->getFacility());
+   DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, msg->getSeverity());
+   DBBind(hStmt, 5, DB_SQLTYPE_INTEGER, msg->getNodeId());
+   DBBind(hStmt, 6, DB_SQLTYPE_INTEGER, msg->getZoneUIN());
+#ifdef UNICODE
+   DBBind(hStmt, 7, DB_SQLTYPE_VARCHAR, WideStringFromMBString(msg->getHostName()), DB_BIND_DYNAMIC);
+   DBBind(hStmt, 8, DB_SQLTYPE_VARCHAR, WideStringFromMBString(msg->getTag()), DB_BIND_DYNAMIC);
+#else
+   DBBind(hStmt, 7, DB_SQLTYPE_VARCHAR, msg->getHostName(), DB_BIND_STATIC);
+   DBBind(hStmt, 8, DB_SQLTYPE_VARCHAR, msg->getTag(), DB_BIND_STATIC);
+#endif
+   DBBind(hStmt, 9, DB_SQLTYPE_VARCHAR, msg->getMessage(), DB_BIND_STATIC);
+}
+
+/**
+ * Execute accumulated batch of syslog messages within transaction. If batch cannot be written, transaction
+ * is rolled back and messages are written one by one, so one bad record will not cause loss of entire batch.
+ */
+static void ExecuteSyslogBatch(DB_HANDLE hdb, DB_STATEMENT hStmt, const ObjectArray<SyslogMessage>& batch)
+{
+   bool transaction = DBBegin(hdb);
+   bool success = DBExecute(hStmt);
+   if (transaction)
+   {
+      if (success)
+         success = DBCommit(hdb);
+      else
+         DBRollback(hdb);
+   }
+
+   if (!success)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("Syslog writer: batch write failed, retrying %d messages one by one"), batch.size());
+      int failed = 0;
+      for(int i = 0; i < batch.size(); i++)
+      {
+         BindSyslogMessage(hStmt, batch.get(i));
+         if (!DBExecute(hStmt))
+            failed++;
+      }
+      if (failed > 0)
+         nxlog_write_tag(NXLOG_WARNING, DEBUG_TAG, _T("Syslog writer dropped %d of %d messages because of database errors"), failed, batch.size());
+   }
+}
+
 /**
  * Syslog writer thread
  */
@@ -384,39 +434,22 @@ static void SyslogWriterThread()
          continue;
       }
 
-      int count = 0;
-      DBBegin(hdb);
+      // Messages should be kept until batch is executed because message text is bound as static
+      ObjectArray<SyslogMessage> batch(maxRecords, 64, Ownership::True);
+      DBOpenBatch(hStmt);
       while(true)
       {
-         DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, msg->getId());
-         DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(msg->getTimestamp()));
-         DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, msg->getFacility());
-         DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, msg->getSeverity());
-         DBBind(hStmt, 5, DB_SQLTYPE_INTEGER, msg->getNodeId());
-         DBBind(hStmt, 6, DB_SQLTYPE_INTEGER, msg->getZoneUIN());
-#ifdef UNICODE
-         DBBind(hStmt, 7, DB_SQLTYPE_VARCHAR, WideStringFromMBString(msg->getHostName()), DB_BIND_DYNAMIC);
-         DBBind(hStmt, 8, DB_SQLTYPE_VARCHAR, WideStringFromMBString(msg->getTag()), DB_BIND_DYNAMIC);
-#else
-         DBBind(hStmt, 7, DB_SQLTYPE_VARCHAR, msg->getHostName(), DB_BIND_STATIC);
-         DBBind(hStmt, 8, DB_SQLTYPE_VARCHAR, msg->getTag(), DB_BIND_STATIC);
-#endif
-         DBBind(hStmt, 9, DB_SQLTYPE_VARCHAR, msg->getMessage(), DB_BIND_STATIC);
+         batch.add(msg);
+         DBNextBatchRow(hStmt);
+         BindSyslogMessage(hStmt, msg);
 
-         if (!DBExecute(hStmt))
-         {
-            delete msg;
-            break;
-         }
-         delete msg;
-         count++;
-         if (count == maxRecords)
+         if (batch.size() == maxRecords)
             break;
          msg = g_syslogWriteQueue.get();
          if ((msg == nullptr) || (msg == INVALID_POINTER_VALUE))
             break;
       }
-      DBCommit(hdb);
+      ExecuteSyslogBatch(hdb, hStmt, batch);
       DBFreeStatement(hStmt);
       DBConnectionPoolReleaseConnection(hdb);
       if (msg == INVALID_POINTER_VALUE)
@@ -425,12 +458,66 @@ static void SyslogWriterThread()
    nxlog_debug_tag(DEBUG_TAG, 1, _T("Syslog writer thread stopped"));
 }
 
+/**
+ * Syslog processing thread. Each thread has own queue and own copy of syslog parser.
+ * Messages are distributed between threads by source address, so messages from same
+ * source are always processed by same thread in order of arrival.
+ */
+struct SyslogProcessingThread
+{
+   ObjectQueue<SyslogMessage> queue;
+   THREAD thread;
+   LogParser *parser;
+   Mutex parserLock;
+   uint64_t processedMessages;
+   int64_t averageWaitTime;
+   uint64_t maxWaitTime;
+   int64_t averageParseTime;
+   int64_t averageMatchTime;
+
+   SyslogProcessingThread() : queue(1024, Ownership::False), parserLock(MutexType::FAST)
+   {
+      thread = INVALID_THREAD_HANDLE;
+      parser = nullptr;
+      processedMessages = 0;
+      averageWaitTime = 0;
+      maxWaitTime = 0;
+      averageParseTime = 0;
+      averageMatchTime = 0;
+   }
+
+   ~SyslogProcessingThread()
+   {
+      delete parser;
+   }
+
+   void run(int id);
+   void processMessage(SyslogMessage *msg);
+
+   void setParser(LogParser *p)
+   {
+      parserLock.lock();
+      delete parser;
+      parser = p;
+      parserLock.unlock();
+   }
+};
+
+/**
+ * Syslog processing threads
+ */
+static SyslogProcessingThread *s_processingThreads = nullptr;
+static int s_processingThreadCount = 0;
+static RWLock s_processingThreadsLock;   // Protects processing thread array from being destroyed while in use
+
 /**
  * Process syslog message
  */
-static void ProcessSyslogMessage(SyslogMessage *msg)
+void SyslogProcessingThread::processMessage(SyslogMessage *msg)
 {
 	nxlog_debug_tag(DEBUG_TAG, 6, _T("ProcessSyslogMessage: Raw syslog message to process:\n%hs"), msg->getRawData());
+
+	int64_t startTime = GetCurrentTimeUs();
    if (msg->parse())
    {
       InterlockedIncrement64(&g_syslogMessagesReceived);
@@ -442,7 +529,7 @@ static void ProcessSyslogMessage(SyslogMessage *msg)
          return;
       }
 
-      msg->setId(s_msgId++);
+      msg->setId(InterlockedIncrement64(&s_msgId) - 1);
       const char *codepage = (s_syslogCodepage[0] != 0) ? s_syslogCodepage : nullptr;
       if (msg->getNodeId() != 0)
       {
@@ -451,24 +538,27 @@ static void ProcessSyslogMessage(SyslogMessage *msg)
             codepage = nodecp;
       }
       msg->convertRawMessage(codepage);
+      UpdateExpMovingAverage(averageParseTime, EMA_EXP_180, GetCurrentTimeUs() - startTime);
 
 		TCHAR ipAddr[64];
 		nxlog_debug_tag(DEBUG_TAG, 6, _T("Syslog message: ipAddr=%s zone=%d objectId=%d tag=\"%hs\" msg=\"%s\""),
 		            msg->getSourceAddress().toString(ipAddr), msg->getZoneUIN(), msg->getNodeId(), msg->getTag(), msg->getMessage());
 
 		bool writeToDatabase = true;
-		s_parserLock.lock();
-		if ((msg->getNodeId() != 0) && (s_parser != nullptr))
+		parserLock.lock();
+		if ((msg->getNodeId() != 0) && (parser != nullptr))
 		{
+		   startTime = GetCurrentTimeUs();
 #ifdef UNICODE
 			WCHAR wtag[MAX_SYSLOG_TAG_LEN];
 			mbcp_to_wchar(msg->getTag(), -1, wtag, MAX_SYSLOG_TAG_LEN, codepage);
-			s_parser->matchEvent(wtag, msg->getFacility(), 1 << msg->getSeverity(), msg->getMessage(), nullptr, 0, msg->getNodeId(), 0, nullptr, &writeToDatabase);
+			parser->matchEvent(wtag, msg->getFacility(), 1 << msg->getSeverity(), msg->getMessage(), nullptr, 0, msg->getNodeId(), 0, nullptr, &writeToDatabase);
 #else
-			s_parser->matchEvent(msg->getTag(), msg->getFacility(), 1 << msg->getSeverity(), msg->getMessage(), nullptr, 0, msg->getNodeId(), 0, nullptr, &writeToDatabase);
+			parser->matchEvent(msg->getTag(), msg->getFacility(), 1 << msg->getSeverity(), msg->getMessage(), nullptr, 0, msg->getNodeId(), 0, nullptr, &writeToDatabase);
 #endif
+			UpdateExpMovingAverage(averageMatchTime, EMA_EXP_180, GetCurrentTimeUs() - startTime);
 		}
-		s_parserLock.unlock();
+		parserLock.unlock();
 
       // Send message to all connected clients
       EnumerateClientSessions(BroadcastSyslogMessage, msg);
@@ -493,19 +583,51 @@ static void ProcessSyslogMessage(SyslogMessage *msg)
 }
 
 /**
- * Syslog processing thread
+ * Syslog processing thread main loop
  */
-static void SyslogProcessingThread()
+void SyslogProcessingThread::run(int id)
 {
-   ThreadSetName("SyslogProcessor");
+   char tname[32];
+   snprintf(tname, 32, "SyslogProc-%d", id);
+   ThreadSetName(tname);
+
    while(true)
    {
-      SyslogMessage *msg = g_syslogProcessingQueue.getOrBlock();
+      SyslogMessage *msg = queue.getOrBlock();
       if (msg == INVALID_POINTER_VALUE)
-         break;
+         break;   // Shutdown indicator
+
+      int64_t waitTime = GetCurrentTimeMs() - msg->getQueueTime();
+      UpdateExpMovingAverage(averageWaitTime, EMA_EXP_180, waitTime);
+      if (static_cast<uint64_t>(waitTime) > maxWaitTime)
+         maxWaitTime = static_cast<uint64_t>(waitTime);
+      processMessage(msg);
+      processedMessages++;
+   }
+}
 
-      ProcessSyslogMessage(msg);
+/**
+ * Select processing thread for given message source
+ */
+static inline SyslogProcessingThread *SelectProcessingThread(const InetAddress& addr, int32_t zoneUIN)
+{
+   if (s_processingThreadCount == 1)
+      return &s_processingThreads[0];
+
+   uint32_t hash;
+   if (addr.getFamily() == AF_INET)
+   {
+      hash = addr.getAddressV4();
    }
+   else
+   {
+      hash = 0;
+      const BYTE *a = addr.getAddressV6();
+      for(int i = 0; i < 16; i++)
+         hash = hash * 31 + a[i];
+   }
+   hash = (hash ^ static_cast<uint32_t>(zoneUIN)) * 0x9E3779B1;
+   return &s_processingThreads[(hash >> 16) % s_processingThreadCount];
 }
 
 /**
@@ -513,7 +635,10 @@ static void SyslogProcessingThread()
  */
 static void QueueSyslogMessage(char *msg, int msgLen, const InetAddress& sourceAddr)
 {
-   g_syslogProcessingQueue.put(new SyslogMessage(sourceAddr, msg, msgLen));
+   s_processingThreadsLock.readLock();
+   if (s_processingThreadCount > 0)
+      SelectProcessingThread(sourceAddr, 0)->queue.put(new SyslogMessage(sourceAddr, msg, msgLen));
+   s_processingThreadsLock.unlock();
 }
 
 /**
@@ -521,7 +646,46 @@ static void QueueSyslogMessage(char *msg, int msgLen, const InetAddress& sourceA
  */
 void QueueProxiedSyslogMessage(const InetAddress &addr, int32_t zoneUIN, uint32_t nodeId, time_t timestamp, const char *msg, int msgLen)
 {
-   g_syslogProcessingQueue.put(new SyslogMessage(addr, timestamp, zoneUIN, nodeId, msg, msgLen));
+   // Can be called from agent connection threads while syslog server is shutting down
+   s_processingThreadsLock.readLock();
+   if (s_processingThreadCount > 0)
+      SelectProcessingThread(addr, zoneUIN)->queue.put(new SyslogMessage(addr, timestamp, zoneUIN, nodeId, msg, msgLen));
+   s_processingThreadsLock.unlock();
+}
+
+/**
+ * Get total size of all syslog processing queues
+ */
+int64_t GetSyslogProcessorQueueSize()
+{
+   int64_t size = 0;
+   s_processingThreadsLock.readLock();
+   for(int i = 0; i < s_processingThreadCount; i++)
+      size += s_processingThreads[i].queue.size();
+   s_processingThreadsLock.unlock();
+   return size;
+}
+
+/**
+ * Get statistics for syslog processing threads
+ */
+StructArray<SyslogProcessingThreadStats> *GetSyslogProcessingThreadStats()
+{
+   s_processingThreadsLock.readLock();
+   auto stats = new StructArray<SyslogProcessingThreadStats>(s_processingThreadCount);
+   for(int i = 0; i < s_processingThreadCount; i++)
+   {
+      SyslogProcessingThreadStats s;
+      s.processedMessages = s_processingThreads[i].processedMessages;
+      s.averageWaitTime = static_cast<uint32_t>(s_processingThreads[i].averageWaitTime / EMA_FP_1);
+      s.maxWaitTime = static_cast<uint32_t>(s_processingThreads[i].maxWaitTime);
+      s.averageParseTime = static_cast<uint32_t>(s_processingThreads[i].averageParseTime / EMA_FP_1);
+      s.averageMatchTime = static_cast<uint32_t>(s_processingThreads[i].averageMatchTime / EMA_FP_1);
+      s.queueSize = static_cast<uint32_t>(s_processingThreads[i].queue.size());
+      stats->add(&s);
+   }
+   s_processingThreadsLock.unlock();
+   return stats;
 }
 
 /**
@@ -551,11 +715,18 @@ static void SyslogParserCallback(UINT32 eventCode, const TCHAR *eventName, const
 }
 
 /**
- * Create syslog parser from config
+ * Create syslog parser from config. Each processing thread gets own copy of
+ * newly created parser, while master copy keeps accumulated rule counters.
+ * Because parser state is per thread, rule repeat counts and parser contexts
+ * are only tracked within one processing thread - messages from sources handled
+ * by different threads will not count towards same repeat interval and contexts
+ * set by messages from one source will not be visible when matching messages
+ * from source handled by another thread.
  */
 static void CreateParserFromConfig()
 {
 	s_parserLock.lock();
+	s_processingThreadsLock.readLock();
 	LogParser *prev = s_parser;
 	s_parser = nullptr;
 #ifdef UNICODE
@@ -582,7 +753,17 @@ static void CreateParserFromConfig()
 			s_parser = parsers->get(0);
 			s_parser->setCallback(SyslogParserCallback);
 			if (prev != nullptr)
+			{
+			   for(int i = 0; i < s_processingThreadCount; i++)
+			   {
+			      SyslogProcessingThread *t = &s_processingThreads[i];
+			      t->parserLock.lock();
+			      if (t->parser != nullptr)
+			         prev->addCounters(t->parser);
+			      t->parserLock.unlock();
+			   }
 			   s_parser->restoreCounters(prev);
+			}
 			nxlog_debug_tag(DEBUG_TAG, 3, _T("Syslog parser successfully created from config"));
 		}
 		else
@@ -592,6 +773,22 @@ static void CreateParserFromConfig()
 		MemFree(xml);
 		delete parsers;
 	}
+
+	for(int i = 0; i < s_processingThreadCount; i++)
+	{
+	   LogParser *parser;
+	   if (s_parser != nullptr)
+	   {
+	      parser = new LogParser(s_parser);
+	      parser->resetCounters();
+	   }
+	   else
+	   {
+	      parser = nullptr;
+	   }
+	   s_processingThreads[i].setParser(parser);
+	}
+	s_processingThreadsLock.unlock();
 	s_parserLock.unlock();
 	delete prev;
 }
@@ -828,6 +1025,35 @@ void OnSyslogConfigurationChange(const TCHAR *name, const TCHAR *value)
    }
 }
 
+/**
+ * Get syslog rule check or match count merged from all processing threads
+ */
+static int GetSyslogRuleCounter(const TCHAR *ruleName, uint32_t objectId, bool matchCount)
+{
+   s_parserLock.lock();
+   int count = (s_parser != nullptr) ?
+            (matchCount ? s_parser->getRuleMatchCount(ruleName, objectId) : s_parser->getRuleCheckCount(ruleName, objectId)) : -1;
+   if (count != -1)
+   {
+      s_processingThreadsLock.readLock();
+      for(int i = 0; i < s_processingThreadCount; i++)
+      {
+         SyslogProcessingThread *t = &s_processingThreads[i];
+         t->parserLock.lock();
+         if (t->parser != nullptr)
+         {
+            int n = matchCount ? t->parser->getRuleMatchCount(ruleName, objectId) : t->parser->getRuleCheckCount(ruleName, objectId);
+            if (n > 0)
+               count += n;
+         }
+         t->parserLock.unlock();
+      }
+      s_processingThreadsLock.unlock();
+   }
+   s_parserLock.unlock();
+   return count;
+}
+
 /**
  * Get syslog rule check count in NXSL
  */
@@ -855,9 +1081,7 @@ int F_GetSyslogRuleCheckCount(int argc, NXSL_Value **argv, NXSL_Value **result,
       }
    }
 
-   s_parserLock.lock();
-   *result = vm->createValue((s_parser != nullptr) ? s_parser->getRuleCheckCount(argv[0]->getValueAsCString(), objectId) : -1);
-   s_parserLock.unlock();
+   *result = vm->createValue(GetSyslogRuleCounter(argv[0]->getValueAsCString(), objectId, false));
    return 0;
 }
 
@@ -885,9 +1109,7 @@ int F_GetSyslogRuleMatchCount(int argc, NXSL_Value **argv, NXSL_Value **result,
       }
    }
 
-   s_parserLock.lock();
-   *result = vm->createValue((s_parser != nullptr) ? s_parser->getRuleMatchCount(argv[0]->getValueAsCString(), objectId) : -1);
-   s_parserLock.unlock();
+   *result = vm->createValue(GetSyslogRuleCounter(argv[0]->getValueAsCString(), objectId, true));
    return 0;
 }
 
@@ -912,7 +1134,7 @@ void StartSyslogServer()
 
    // Determine first available message id
    uint64_t id = ConfigReadUInt64(_T("FirstFreeSyslogId"), s_msgId);
-   if (id > s_msgId)
+   if (id > static_cast<uint64_t>(s_msgId))
       s_msgId = id;
    DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
    DB_RESULT hResult = DBSelect(hdb, _T("SELECT max(msg_id) FROM syslog"));
@@ -920,7 +1142,7 @@ void StartSyslogServer()
    {
       if (DBGetNumRows(hResult) > 0)
       {
-         s_msgId = std::max(DBGetFieldUInt64(hResult, 0, 0) + 1, s_msgId);
+         s_msgId = std::max(DBGetFieldUInt64(hResult, 0, 0) + 1, static_cast<uint64_t>(s_msgId));
       }
       DBFreeResult(hResult);
    }
@@ -928,11 +1150,19 @@ void StartSyslogServer()
 
    InitLogParserLibrary();
 
+   int poolSize = ConfigReadInt(_T("Syslog.Processor.PoolSize"), 1);
+   if (poolSize < 1)
+      poolSize = 1;
+   s_processingThreads = new SyslogProcessingThread[poolSize];
+   s_processingThreadCount = poolSize;
+
    // Create message parser
    CreateParserFromConfig();
 
-   // Start processing thread
-   s_processingThread = ThreadCreateEx(SyslogProcessingThread);
+   // Start processing threads
+   for(int i = 0; i < poolSize; i++)
+      s_processingThreads[i].thread = ThreadCreateEx(&s_processingThreads[i], &SyslogProcessingThread::run, i + 1);
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("%d syslog processing threads started"), poolSize);
    s_writerThread = ThreadCreateEx(SyslogWriterThread);
 
    if (ConfigReadBoolean(_T("Syslog.EnableListener"), false))
@@ -947,9 +1177,23 @@ void StopSyslogServer()
    s_running = false;
    ThreadJoin(s_receiverThread);
 
-   // Stop processing thread
-   g_syslogProcessingQueue.put(INVALID_POINTER_VALUE);
-   ThreadJoin(s_processingThread);
+   // Stop accepting new messages
+   s_processingThreadsLock.writeLock();
+   int count = s_processingThreadCount;
+   s_processingThreadCount = 0;
+   s_processingThreadsLock.unlock();
+
+   // Stop processing threads
+   for(int i = 0; i < count; i++)
+   {
+      s_processingThreads[i].queue.put(INVALID_POINTER_VALUE);
+      ThreadJoin(s_processingThreads[i].thread);
+   }
+
+   s_processingThreadsLock.writeLock();
+   delete[] s_processingThreads;
+   s_processingThreads = nullptr;
+   s_processingThreadsLock.unlock();
 
    // Stop writer thread - it must be done after processing thread already finished
    g_syslogWriteQueue.put(INVALID_POINTER_VALUE);
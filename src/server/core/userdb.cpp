@@ -21,6 +21,7 @@
 **/
 
 #include "nxcore.h"
+#include <nxcore_logs.h>
 
 #define DEBUG_TAG _T("userdb")
 
@@ -711,6 +712,9 @@ static uint32_t DeleteUserDatabaseObjectInternal(uint32_t id, bool alreadyLocked
    if (!alreadyLocked)
       s_userDatabaseLock.unlock();
 
+   if (!(id & GROUP_FLAG))
+      DeleteObjectAccessConstraint(id);
+
    // Update system access rights in all connected sessions
    // Use separate thread to avoid deadlocks
    if (id & GROUP_FLAG)
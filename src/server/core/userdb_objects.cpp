@@ -228,6 +228,10 @@ void UserDatabaseObject::modifyFromMessage(const NXCPMessage& msg)
          m_flags |= flags & UF_CHANGE_PASSWORD;
 		else
 			m_flags |= flags & (UF_DISABLED | UF_CHANGE_PASSWORD | UF_CANNOT_CHANGE_PASSWORD | UF_CLOSE_OTHER_SESSIONS);
+
+		// Disabled groups do not grant object access rights
+		if (m_id & GROUP_FLAG)
+		   InvalidateAccessRightsCache();
 	}
 
 	m_flags |= UF_MODIFIED;
@@ -384,6 +388,8 @@ void UserDatabaseObject::enable()
 {
 	m_flags &= ~(UF_DISABLED);
 	m_flags |= UF_MODIFIED;
+   if (m_id & GROUP_FLAG)
+      InvalidateAccessRightsCache();
    SendUserDBUpdate(USER_DB_MODIFY, m_id, this);
 }
 
@@ -393,6 +399,8 @@ void UserDatabaseObject::enable()
 void UserDatabaseObject::disable()
 {
    m_flags |= UF_DISABLED | UF_MODIFIED;
+   if (m_id & GROUP_FLAG)
+      InvalidateAccessRightsCache();
    SendUserDBUpdate(USER_DB_MODIFY, m_id, this);
 }
 
@@ -728,6 +736,9 @@ bool User::deleteFromDatabase(DB_HANDLE hdb)
    if (success)
       success = ExecuteQueryOnObject(hdb, m_id, _T("DELETE FROM dci_access WHERE user_id=?"));
 
+   if (success)
+      success = ExecuteQueryOnObject(hdb, m_id, _T("DELETE FROM log_access_objects WHERE user_id=?"));
+
    if (success)
       DBCommit(hdb);
    else
@@ -1301,6 +1312,7 @@ void Group::addUser(uint32_t userId)
    m_members->sort(CompareUserId);
 
 	m_flags |= UF_MODIFIED;
+   InvalidateAccessRightsCache();
 
    SendUserDBUpdate(USER_DB_MODIFY, m_id, this);
 }
@@ -1317,6 +1329,7 @@ void Group::deleteUser(uint32_t userId)
    int index = (int)((char *)e - (char *)m_members->getBuffer()) / sizeof(uint32_t);
    m_members->remove(index);
    m_flags |= UF_MODIFIED;
+   InvalidateAccessRightsCache();
    SendUserDBUpdate(USER_DB_MODIFY, m_id, this);
 }
 
@@ -1377,6 +1390,7 @@ void Group::modifyFromMessage(const NXCPMessage& msg)
             SendUserDBUpdate(USER_DB_MODIFY, members->get(i));
 		}
 		delete members;
+      InvalidateAccessRightsCache();
 	}
 }
 
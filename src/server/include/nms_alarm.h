@@ -140,6 +140,276 @@ class NXCORE_EXPORTABLE Alarm
    bool checkCategoryAccess(ClientSession *session) const;
 };
 
+/**
+ * Alarm list. Alarms are kept in unordered array for fast enumeration, with
+ * hash indexes by alarm ID, alarm key, source object ID, and DCI ID. Read-only
+ * operations should lock list for reading, any alarm or list modification
+ * requires exclusive lock. Order of alarms in the list changes on removal, so
+ * lookups by non-unique attributes should use findFirst() that selects alarm
+ * with lowest ID regardless of list order. Alarm class is template parameter
+ * so that indexing can be tested without database.
+ */
+template<class A> class AlarmList
+{
+private:
+   struct Entry
+   {
+      A *alarm;
+      int position;  // Position in alarm list
+
+      Entry(A *_alarm, int _position)
+      {
+         alarm = _alarm;
+         position = _position;
+      }
+   };
+
+   RWLock m_lock;
+   ObjectArray<A> m_list;
+   HashMap<uint32_t, Entry> m_idIndex;
+   StringObjectMap<A> m_keyIndex;
+   int m_duplicateKeys;    // Number of alarms with key already indexed for another alarm
+   HashMap<uint32_t, ObjectArray<A>> m_objectIndex;
+   HashMap<uint32_t, ObjectArray<A>> m_dciIndex;
+
+   static void addToIndex(HashMap<uint32_t, ObjectArray<A>> *index, uint32_t key, A *alarm)
+   {
+      ObjectArray<A> *alarms = index->get(key);
+      if (alarms == nullptr)
+      {
+         alarms = new ObjectArray<A>(4, 16, Ownership::False);
+         index->set(key, alarms);
+      }
+      alarms->add(alarm);
+   }
+
+   static void removeFromIndex(HashMap<uint32_t, ObjectArray<A>> *index, uint32_t key, A *alarm)
+   {
+      ObjectArray<A> *alarms = index->get(key);
+      if (alarms == nullptr)
+         return;
+      alarms->remove(alarm);
+      if (alarms->isEmpty())
+         index->remove(key);
+   }
+
+   static void copyIndexEntry(const HashMap<uint32_t, ObjectArray<A>>& index, uint32_t key, ObjectArray<A> *alarms)
+   {
+      ObjectArray<A> *indexedAlarms = index.get(key);
+      if (indexedAlarms != nullptr)
+         alarms->addAll(indexedAlarms);
+   }
+
+   void addToKeyIndex(A *alarm)
+   {
+      A *indexed = m_keyIndex.get(alarm->getKey());
+      if (indexed != nullptr)
+      {
+         // Alarm with lowest ID is indexed, other alarms with same key are found by full scan when needed
+         m_duplicateKeys++;
+         if (indexed->getAlarmId() < alarm->getAlarmId())
+            return;
+      }
+      m_keyIndex.set(alarm->getKey(), alarm);
+   }
+
+   void removeFromKeyIndex(A *alarm)
+   {
+      A *indexed = m_keyIndex.get(alarm->getKey());
+      if (indexed == nullptr)
+         return;
+
+      if (indexed != alarm)
+      {
+         m_duplicateKeys--;   // Alarm was not indexed because of duplicate key
+         return;
+      }
+
+      m_keyIndex.remove(alarm->getKey());
+      if (m_duplicateKeys > 0)
+      {
+         const TCHAR *key = alarm->getKey();
+         A *replacement = findFirst([alarm, key] (A *a) -> bool { return (a != alarm) && !_tcscmp(a->getKey(), key); });
+         if (replacement != nullptr)
+         {
+            m_keyIndex.set(key, replacement);
+            m_duplicateKeys--;
+         }
+      }
+   }
+
+public:
+   AlarmList() : m_list(256, 256, Ownership::True), m_idIndex(Ownership::True), m_keyIndex(Ownership::False),
+            m_objectIndex(Ownership::True), m_dciIndex(Ownership::True)
+   {
+      m_duplicateKeys = 0;
+   }
+
+   void lock() { m_lock.writeLock(); }
+   void readLock() const { m_lock.readLock(); }
+   void unlock() const { m_lock.unlock(); }
+
+   int size() const { return m_list.size(); }
+
+   uint64_t memoryUsage() const
+   {
+      uint64_t memUsage = sizeof(AlarmList);
+      readLock();
+      for(int i = 0; i < m_list.size(); i++)
+         memUsage += m_list.get(i)->getMemoryUsage();
+      memUsage += static_cast<uint64_t>(m_idIndex.size()) * sizeof(Entry);
+      unlock();
+      return memUsage;
+   }
+
+   A *get(int index) const { return m_list.get(index); }
+
+   /**
+    * Find alarm by key. If there are multiple alarms with same key, alarm with lowest ID is returned.
+    */
+   A *find(const TCHAR *key) const { return m_keyIndex.get(key); }
+
+   /**
+    * Find alarm by ID
+    */
+   A *find(uint32_t id) const
+   {
+      Entry *entry = m_idIndex.get(id);
+      return (entry != nullptr) ? entry->alarm : nullptr;
+   }
+
+   /**
+    * Find alarm with lowest ID among alarms matching given filter
+    */
+   template<typename F> A *findFirst(F filter) const
+   {
+      A *result = nullptr;
+      for(int i = 0; i < m_list.size(); i++)
+      {
+         A *alarm = m_list.get(i);
+         if (((result == nullptr) || (alarm->getAlarmId() < result->getAlarmId())) && filter(alarm))
+            result = alarm;
+      }
+      return result;
+   }
+
+   /**
+    * Get alarms for given source object (alarm pointers are added to provided array)
+    */
+   void getObjectAlarms(uint32_t objectId, ObjectArray<A> *alarms) const
+   {
+      copyIndexEntry(m_objectIndex, objectId, alarms);
+   }
+
+   /**
+    * Get alarms for given DCI (alarm pointers are added to provided array)
+    */
+   void getDCIAlarms(uint32_t dciId, ObjectArray<A> *alarms) const
+   {
+      copyIndexEntry(m_dciIndex, dciId, alarms);
+   }
+
+   /**
+    * Check if there are any alarms for given source object
+    */
+   bool hasObjectAlarms(uint32_t objectId) const
+   {
+      return m_objectIndex.get(objectId) != nullptr;
+   }
+
+   /**
+    * Get most critical status among active alarms for given source object
+    */
+   int getMostCriticalStatus(uint32_t objectId) const
+   {
+      int status = STATUS_UNKNOWN;
+      ObjectArray<A> *alarms = m_objectIndex.get(objectId);
+      if (alarms == nullptr)
+         return status;
+      for(int i = 0; (i < alarms->size()) && (status != STATUS_CRITICAL); i++)
+      {
+         A *alarm = alarms->get(i);
+         if (((alarm->getState() & ALARM_STATE_MASK) < ALARM_STATE_RESOLVED) &&
+             ((alarm->getCurrentSeverity() > status) || (status == STATUS_UNKNOWN)))
+         {
+            status = (int)alarm->getCurrentSeverity();
+         }
+      }
+      return status;
+   }
+
+   void add(A *alarm)
+   {
+      m_idIndex.set(alarm->getAlarmId(), new Entry(alarm, m_list.size()));
+      m_list.add(alarm);
+      if (*alarm->getKey() != 0)
+         addToKeyIndex(alarm);
+      addToIndex(&m_objectIndex, alarm->getSourceObject(), alarm);
+      if (alarm->getDciId() != 0)
+         addToIndex(&m_dciIndex, alarm->getDciId(), alarm);
+   }
+
+   /**
+    * Update secondary indexes after change of alarm's source object or DCI
+    */
+   void updateIndexes(A *alarm, uint32_t oldObjectId, uint32_t oldDciId)
+   {
+      if (alarm->getSourceObject() != oldObjectId)
+      {
+         removeFromIndex(&m_objectIndex, oldObjectId, alarm);
+         addToIndex(&m_objectIndex, alarm->getSourceObject(), alarm);
+      }
+      if (alarm->getDciId() != oldDciId)
+      {
+         if (oldDciId != 0)
+            removeFromIndex(&m_dciIndex, oldDciId, alarm);
+         if (alarm->getDciId() != 0)
+            addToIndex(&m_dciIndex, alarm->getDciId(), alarm);
+      }
+   }
+
+   /**
+    * Remove alarm at given position. Last alarm in the list is moved to freed position,
+    * so callers iterating over the list should re-check element at same position.
+    */
+   void remove(int index)
+   {
+      A *alarm = m_list.get(index);
+      if (alarm->getParentAlarmId() != 0)
+      {
+         A *parent = find(alarm->getParentAlarmId());
+         if (parent != nullptr)
+            parent->removeSubordinateAlarm(alarm->getAlarmId());
+      }
+      if (*alarm->getKey() != 0)
+         removeFromKeyIndex(alarm);
+      removeFromIndex(&m_objectIndex, alarm->getSourceObject(), alarm);
+      if (alarm->getDciId() != 0)
+         removeFromIndex(&m_dciIndex, alarm->getDciId(), alarm);
+      m_idIndex.remove(alarm->getAlarmId());
+
+      int last = m_list.size() - 1;
+      if (index < last)
+      {
+         A *moved = m_list.get(last);
+         m_idIndex.get(moved->getAlarmId())->position = index;
+         m_list.unlink(last);
+         m_list.replace(index, moved);
+      }
+      else
+      {
+         m_list.remove(index);
+      }
+   }
+
+   void remove(A *alarm)
+   {
+      Entry *entry = m_idIndex.get(alarm->getAlarmId());
+      if (entry != nullptr)
+         remove(entry->position);
+   }
+};
+
 /**
  * Alarm category
  */
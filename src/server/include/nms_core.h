@@ -567,6 +567,9 @@ class NXCORE_EXPORTABLE ClientSession
 
    void postRawMessageAndDelete(NXCP_MESSAGE *msg);
    void sendRawMessageAndDelete(NXCP_MESSAGE *msg);
+   void appendToMessageBatch(ByteStream *batch, NXCP_MESSAGE *msg);
+   bool sendMessageBatch(ByteStream *batch);
+   uint32_t getObjectMessageOptions(NetObj *object);
 
    void debugPrintf(int level, const TCHAR *format, ...);
 
@@ -1225,6 +1228,7 @@ void QueueIDataInsert(time_t timestamp, uint32_t nodeId, uint32_t dciId, const T
 void QueueRawDciDataUpdate(time_t timestamp, uint32_t dciId, const TCHAR *rawValue, const TCHAR *transformedValue, time_t cacheTimestamp);
 void QueueRawDciDataDelete(uint32_t dciId);
 int64_t GetIDataWriterQueueSize();
+void GetIDataWriterPerfCounters(uint64_t *statements, uint64_t *records);
 int64_t GetRawDataWriterQueueSize();
 uint64_t GetRawDataWriterMemoryUsage();
 void StartDBWriter();
@@ -1233,7 +1237,7 @@ void OnDBWriterMaxQueueSizeChange();
 void ClearDBWriterData(ServerConsole *console, const TCHAR *component);
 
 void PerfDataStorageRequest(DCItem *dci, time_t timestamp, const TCHAR *value);
-void PerfDataStorageRequest(DCTable *dci, time_t timestamp, Table *value);
+void PerfDataStorageRequest(DCTable *dci, time_t timestamp, const shared_ptr<Table>& value);
 
 bool SnmpTestRequest(SNMP_Transport *snmp, const StringList &testOids, bool separateRequests);
 SNMP_Transport *SnmpCheckCommSettings(uint32_t snmpProxy, const InetAddress& ipAddr, SNMP_Version *version,
@@ -126,6 +126,133 @@ class NXCORE_EXPORTABLE ItemValue
    const ItemValue& operator=(uint64_t value);
 };
 
+/**
+ * Convert cached string value to numeric type
+ */
+template<typename T> inline T CachedStringToNumeric(const TCHAR *s) { return static_cast<T>(_tcstoll(s, nullptr, 0)); }
+template<> inline uint32_t CachedStringToNumeric<uint32_t>(const TCHAR *s) { return static_cast<uint32_t>(_tcstoull(s, nullptr, 0)); }
+template<> inline uint64_t CachedStringToNumeric<uint64_t>(const TCHAR *s) { return _tcstoull(s, nullptr, 0); }
+template<> inline double CachedStringToNumeric<double>(const TCHAR *s) { return _tcstod(s, nullptr); }
+
+/**
+ * Compact cache of DCI values. Values are kept in ring buffer in native representation for
+ * DCI data type - packed numeric array for numeric types and variable length strings for
+ * other types. Timestamps are stored as offsets from base timestamp. Element with index 0
+ * is the most recent one. Original string representation is kept only for the most recent
+ * numeric value.
+ */
+class NXCORE_EXPORTABLE ItemValueCache
+{
+private:
+   union
+   {
+      int32_t *i32;
+      uint32_t *u32;
+      int64_t *i64;
+      uint64_t *u64;
+      double *d;
+      TCHAR **s;
+      void *ptr;
+   } m_values;
+   int32_t *m_timestamps;
+   time_t m_baseTimestamp;
+   TCHAR *m_lastValue;
+   uint32_t m_size;
+   uint32_t m_head;
+   int m_dataType;
+
+   bool isNumeric() const { return isNumericType(m_dataType); }
+   size_t elementSize() const;
+   uint32_t position(uint32_t index) const { uint32_t p = m_head + index; return (p < m_size) ? p : p - m_size; }
+   int32_t encodeTimeStamp(time_t timestamp);
+   void store(uint32_t pos, const ItemValue& value);
+   void reallocate(uint32_t size, uint32_t skipIndex);
+   void updateLastValue();
+
+   template<typename T, typename S, typename F> void scan(const S *values, uint32_t count, bool skipPlaceholders, F& callback) const
+   {
+      for(uint32_t i = 0, p = m_head; i < count; i++)
+      {
+         if (!skipPlaceholders || (m_timestamps[p] != PLACEHOLDER))
+            callback(static_cast<T>(values[p]));
+         if (++p == m_size)
+            p = 0;
+      }
+   }
+
+   static bool isNumericType(int dataType) { return (dataType != DCI_DT_STRING) && (dataType != DCI_DT_NULL) && (dataType != DCI_DT_DEPRECATED); }
+
+public:
+   static const int32_t PLACEHOLDER = INT32_MIN;   // Timestamp offset for placeholder values inserted by cache loader
+
+   ItemValueCache(int dataType);
+   ItemValueCache(const ItemValueCache& src);
+   ~ItemValueCache();
+
+   ItemValueCache& operator=(const ItemValueCache& src) = delete;
+
+   uint32_t size() const { return m_size; }
+   int getDataType() const { return m_dataType; }
+   void setDataType(int dataType);
+
+   void clear() { reallocate(0, UINT32_MAX); }
+   void resize(uint32_t size) { if (size != m_size) reallocate(size, UINT32_MAX); }
+   void reset(uint32_t size);
+   void push(const ItemValue& value);
+   void set(uint32_t index, const ItemValue& value);
+   bool remove(time_t timestamp);
+
+   bool isPlaceholder(uint32_t index) const { return m_timestamps[position(index)] == PLACEHOLDER; }
+   time_t getTimeStamp(uint32_t index) const
+   {
+      int32_t offset = m_timestamps[position(index)];
+      return (offset == PLACEHOLDER) ? 1 : m_baseTimestamp + offset;
+   }
+   ItemValue get(uint32_t index) const;
+   const TCHAR *getLastString() const;
+   uint32_t getLastUInt32() const;
+
+   uint64_t getMemoryUsage() const;
+
+   /**
+    * Call given callback for first <count> values converted to type T, starting from most recent one
+    */
+   template<typename T, typename F> void forEach(uint32_t count, bool skipPlaceholders, F callback) const
+   {
+      if (count > m_size)
+         count = m_size;
+      switch(m_dataType)
+      {
+         case DCI_DT_INT:
+            scan<T>(m_values.i32, count, skipPlaceholders, callback);
+            break;
+         case DCI_DT_UINT:
+         case DCI_DT_COUNTER32:
+            scan<T>(m_values.u32, count, skipPlaceholders, callback);
+            break;
+         case DCI_DT_INT64:
+            scan<T>(m_values.i64, count, skipPlaceholders, callback);
+            break;
+         case DCI_DT_UINT64:
+         case DCI_DT_COUNTER64:
+            scan<T>(m_values.u64, count, skipPlaceholders, callback);
+            break;
+         case DCI_DT_FLOAT:
+            scan<T>(m_values.d, count, skipPlaceholders, callback);
+            break;
+         default:
+            for(uint32_t i = 0, p = m_head; i < count; i++)
+            {
+               if (!skipPlaceholders || (m_timestamps[p] != PLACEHOLDER))
+                  callback(CachedStringToNumeric<T>(CHECK_NULL_EX(m_values.s[p])));
+               if (++p == m_size)
+                  p = 0;
+            }
+            break;
+      }
+   }
+};
+
 
 class DCItem;
 class DataCollectionTarget;
@@ -159,10 +286,10 @@ class NXCORE_EXPORTABLE Threshold
 	time_t m_lastEventTimestamp;
 
    const ItemValue& value() const { return m_value; }
-   void calculateAverage(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateTotal(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateAbsoluteDeviation(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateMeanDeviation(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
+   void calculateAverage(ItemValue *result, const ItemValue &lastValue, const ItemValueCache& prevValues);
+   void calculateTotal(ItemValue *result, const ItemValue &lastValue, const ItemValueCache& prevValues);
+   void calculateAbsoluteDeviation(ItemValue *result, const ItemValue &lastValue, const ItemValueCache& prevValues);
+   void calculateMeanDeviation(ItemValue *result, const ItemValue &lastValue, const ItemValueCache& prevValues);
    void setScript(TCHAR *script);
 
 public:
@@ -195,7 +322,7 @@ class NXCORE_EXPORTABLE Threshold
    void setLastCheckedValue(const ItemValue &value) { m_lastCheckValue = value; }
 
    BOOL saveToDB(DB_HANDLE hdb, UINT32 dwIndex);
-   ThresholdCheckResult check(ItemValue &value, ItemValue **ppPrevValues, ItemValue &fvalue, ItemValue &tvalue, shared_ptr<NetObj> target, DCItem *dci);
+   ThresholdCheckResult check(ItemValue &value, const ItemValueCache& prevValues, ItemValue &fvalue, ItemValue &tvalue, shared_ptr<NetObj> target, DCItem *dci);
    ThresholdCheckResult checkError(UINT32 dwErrorCount);
 
    void fillMessage(NXCPMessage *msg, uint32_t baseId) const;
@@ -312,6 +439,7 @@ class NXCORE_EXPORTABLE DCObject : public SearchAttributeProvider
    time_t m_instanceGracePeriodStart;  // Start of grace period for missing instance
    int32_t m_instanceRetentionTime;      // Retention time if instance is not found
    time_t m_startTime;                 // Time to start data collection
+   time_t m_scheduledPollTime;         // Time of next readiness check in poll schedule (protected by schedule lock)
    uint32_t m_relatedObject;
 
    void lock() const { m_mutex.lock(); }
@@ -398,11 +526,15 @@ class NXCORE_EXPORTABLE DCObject : public SearchAttributeProvider
    int16_t getAgentCacheMode();
    bool hasValue();
    bool hasAccess(uint32_t userId);
+   bool hasAccessList() const { return !m_accessList.isEmpty(); }
    uint32_t getRelatedObject() const { return m_relatedObject; }
    bool isDisabledByUser() { return (m_stateFlags & DCO_STATE_DISABLED_BY_USER) ? true : false; }
 
 	bool matchClusterResource();
    bool isReadyForPolling(time_t currTime);
+   time_t getNextPollTime(time_t currTime);
+   time_t getScheduledPollTime() const { return m_scheduledPollTime; }
+   void setScheduledPollTime(time_t t) { m_scheduledPollTime = t; }
 	bool isScheduledForDeletion() const { return m_scheduledForDeletion ? true : false; }
    void setLastPollTime(time_t lastPoll) { m_lastPoll = lastPoll; }
    void setStatus(int status, bool generateEvent, bool userChange = false);
@@ -474,9 +606,8 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
    BYTE m_dataType;
 	int m_sampleCount;            // Number of samples required to calculate value
 	ObjectArray<Threshold> *m_thresholds;
-   uint32_t m_cacheSize;          // Number of items in cache
    uint32_t m_requiredCacheSize;
-   ItemValue **m_ppValueCache;
+   ItemValueCache m_cache;
    ItemValue m_prevRawValue;     // Previous raw value (used for delta calculation)
    time_t m_tPrevValueTimeStamp;
    bool m_bCacheLoaded;
@@ -545,7 +676,7 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
    virtual void fillLastValueMessage(NXCPMessage *msg) override;
    NXSL_Value *getValueForNXSL(NXSL_VM *vm, int function, int sampleCount);
    NXSL_Value *getRawValueForNXSL(NXSL_VM *vm);
-   const TCHAR *getLastValue();
+   String getLastValue();
    ItemValue *getInternalLastValue();
    TCHAR *getAggregateValue(AggregationFunction func, time_t periodStart, time_t periodEnd);
 
@@ -565,7 +696,7 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
 
 	int getThresholdCount() const { return (m_thresholds != nullptr) ? m_thresholds->size() : 0; }
 
-	void setDataType(int dataType) { m_dataType = dataType; }
+	void setDataType(int dataType);
 	void setDeltaCalculationMethod(int method) { m_deltaCalculation = method; }
 	void setAllThresholdsFlag(BOOL bFlag) { if (bFlag) m_flags |= DCF_ALL_THRESHOLDS; else m_flags &= ~DCF_ALL_THRESHOLDS; }
 	void addThreshold(Threshold *pThreshold);
@@ -909,10 +1040,169 @@ class DCObjectInfo
    uint32_t getRelatedObject() const { return m_relatedObject; }
 };
 
+/**
+ * SNMP DCIs from same node, port, and SNMP version collected together using multi-varbind requests
+ */
+struct SNMPDataCollectionBatch
+{
+   uint32_t nodeId;
+   uint16_t port;
+   SNMP_Version version;
+   int maxVarbinds;
+   SharedObjectArray<DCObject> objects;
+
+   SNMPDataCollectionBatch(uint32_t _nodeId, uint16_t _port, SNMP_Version _version, int _maxVarbinds) : objects(64, 64)
+   {
+      nodeId = _nodeId;
+      port = _port;
+      version = _version;
+      maxVarbinds = _maxVarbinds;
+   }
+};
+
+/**
+ * Agent DCIs from same node collected together using bulk parameter requests
+ */
+struct AgentDataCollectionBatch
+{
+   uint32_t nodeId;
+   int maxParameters;
+   SharedObjectArray<DCObject> objects;
+
+   AgentDataCollectionBatch(uint32_t _nodeId, int _maxParameters) : objects(64, 64)
+   {
+      nodeId = _nodeId;
+      maxParameters = _maxParameters;
+   }
+};
+
+/**
+ * Set of data collection batches built during single item poller run
+ */
+class DataCollectionBatchSet
+{
+private:
+   HashMap<uint64_t, SNMPDataCollectionBatch> m_snmpBatches;
+   HashMap<uint32_t, AgentDataCollectionBatch> m_agentBatches;
+   int m_maxVarbinds;
+   int m_maxAgentParameters;
+
+public:
+   DataCollectionBatchSet(int maxVarbinds, int maxAgentParameters) : m_snmpBatches(Ownership::False), m_agentBatches(Ownership::False)
+   {
+      m_maxVarbinds = maxVarbinds;
+      m_maxAgentParameters = maxAgentParameters;
+   }
+
+   bool add(uint32_t nodeId, const shared_ptr<DCObject>& object);
+   void dispatch();
+};
+
+/**
+ * Aggregated data point
+ */
+struct AggregatedDataPoint
+{
+   time_t timestamp;
+   double value;
+};
+
+/**
+ * Maximum number of source points kept in memory for LTTB downsampling
+ */
+#define MAX_LTTB_SOURCE_POINTS   1000000
+
+/**
+ * Aggregation bucket
+ */
+struct AggregationBucket
+{
+   double minValue;
+   double maxValue;
+   double sum;
+   uint32_t count;
+
+   void reset()
+   {
+      minValue = 0;
+      maxValue = 0;
+      sum = 0;
+      count = 0;
+   }
+
+   void add(double sampleMin, double sampleMax, double sampleSum, uint32_t sampleCount)
+   {
+      if (count == 0)
+      {
+         minValue = sampleMin;
+         maxValue = sampleMax;
+      }
+      else
+      {
+         if (sampleMin < minValue)
+            minValue = sampleMin;
+         if (sampleMax > maxValue)
+            maxValue = sampleMax;
+      }
+      sum += sampleSum;
+      count += sampleCount;
+   }
+};
+
+/**
+ * Consumer for samples read from raw data or rollup tables. Raw values are passed as samples with count 1.
+ */
+class NXCORE_EXPORTABLE SampleConsumer
+{
+public:
+   virtual ~SampleConsumer() = default;
+   virtual void addSample(time_t timestamp, double minValue, double maxValue, double sum, uint32_t count) = 0;
+};
+
+/**
+ * Aggregator for fixed size time buckets
+ */
+class NXCORE_EXPORTABLE BucketAggregator : public SampleConsumer
+{
+private:
+   time_t m_start;
+   time_t m_bucketSize;
+   int m_bucketCount;
+   AggregationBucket *m_buckets;
+
+public:
+   BucketAggregator(time_t start, time_t end, time_t bucketSize);
+   virtual ~BucketAggregator();
+
+   virtual void addSample(time_t timestamp, double minValue, double maxValue, double sum, uint32_t count) override;
+
+   void getResults(DataAggregationMode mode, StructArray<AggregatedDataPoint> *points);
+};
+
+/**
+ * Collector of source points for LTTB downsampling
+ */
+class NXCORE_EXPORTABLE PointCollector : public SampleConsumer
+{
+private:
+   StructArray<AggregatedDataPoint> m_points;
+   int m_maxPoints;
+
+public:
+   PointCollector(int maxPoints = MAX_LTTB_SOURCE_POINTS) : m_points(0, 65536) { m_maxPoints = maxPoints; }
+
+   virtual void addSample(time_t timestamp, double minValue, double maxValue, double sum, uint32_t count) override;
+
+   int size() const { return m_points.size(); }
+
+   void getResults(uint32_t threshold, StructArray<AggregatedDataPoint> *points);
+};
+
 /**
  * Functions
  */
 void InitDataCollector();
+void ScheduleDCObjectPoll(const shared_ptr<DCObject>& object, time_t pollTime, bool unscheduledOnly = false);
 void DeleteAllItemsForNode(UINT32 dwNodeId);
 void WriteFullParamListToMessage(NXCPMessage *pMsg, int origin, WORD flags);
 int GetDCObjectType(UINT32 nodeId, UINT32 dciId);
@@ -920,6 +1210,8 @@ int GetDCObjectType(UINT32 nodeId, UINT32 dciId);
 void CalculateItemValueDiff(ItemValue *result, int dataType, const ItemValue &value1, const ItemValue &value2);
 void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount);
 void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount);
+void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValueCache& cache, uint32_t sampleCount);
+void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const ItemValueCache& cache, uint32_t sampleCount);
 void CalculateItemValueTotal(ItemValue *result, int dataType, const ItemValue *const *valueList, size_t sampleCount);
 void CalculateItemValueMin(ItemValue *result, int dataType, const ItemValue *const *valueList, size_t sampleCount);
 void CalculateItemValueMax(ItemValue *result, int dataType, const ItemValue *const *valueList, size_t sampleCount);
@@ -928,6 +1220,11 @@ DataCollectionError GetQueueStatistic(const TCHAR *parameter, StatisticType type
 
 uint64_t GetDCICacheMemoryUsage();
 
+bool ReadAggregatedDCIData(const DataCollectionTarget& owner, const DCItem& dci, time_t timeFrom, time_t timeTo, uint32_t maxPoints,
+         DataAggregationMode mode, StructArray<AggregatedDataPoint> *points);
+void UpdateDCIDataRollups(DB_HANDLE hdb);
+void DeleteDCIDataRollups(uint32_t dciId);
+
 /**
  * DCI cache loader queue
  */
@@ -281,6 +281,17 @@ struct ActionExecutionConfiguration
    }
 };
 
+/**
+ * Event policy rule execution statistics
+ */
+struct EPRuleStatistics
+{
+   uint64_t evaluations;
+   uint64_t matches;
+   uint64_t totalTime;     // Total evaluation time in microseconds
+   uint32_t maxTime;       // Maximum evaluation time in microseconds
+};
+
 /**
  * Event policy rule
  */
@@ -310,12 +321,18 @@ class EPRule
 	StringMap m_pstorageSetActions;
 	StringList m_pstorageDeleteActions;
 
+   VolatileCounter64 m_evaluations;
+   VolatileCounter64 m_matches;
+   VolatileCounter64 m_totalTime;   // Total evaluation time in microseconds
+   VolatileCounter m_maxTime;       // Maximum evaluation time in microseconds
+
    bool matchSource(uint32_t objectId) const;
    bool matchEvent(uint32_t eventCode) const;
    bool matchSeverity(uint32_t severity) const;
    bool matchScript(Event *event) const;
 
    uint32_t generateAlarm(Event *event) const;
+   void updateStatistics(int64_t startTime, bool matched);
 
 public:
    EPRule(uint32_t id);
@@ -329,7 +346,7 @@ class EPRule
    void setId(uint32_t newId) { m_id = newId; }
    bool loadFromDB(DB_HANDLE hdb);
 	bool saveToDB(DB_HANDLE hdb) const;
-   bool processEvent(Event *event) const;
+   bool processEvent(Event *event);
    void createMessage(NXCPMessage *msg) const;
    void createExportRecord(StringBuffer &xml) const;
    void createOrderingExportRecord(StringBuffer &xml) const;
@@ -340,6 +357,11 @@ class EPRule
 
    bool isUsingEvent(uint32_t eventCode) const { return m_events.contains(eventCode); }
    const TCHAR* getComments() { return m_comments; }
+
+   uint32_t getFlags() const { return m_flags; }
+   bool isBoundToEventCodes() const { return !m_events.isEmpty() && !(m_flags & RF_NEGATED_EVENTS); }
+   const IntegerArray<uint32_t>& getEvents() const { return m_events; }
+   void getStatistics(EPRuleStatistics *statistics) const;
 };
 
 /**
@@ -435,6 +457,20 @@ class EventReference
    }
 };
 
+/**
+ * Event policy dispatch index for single event severity. Holds positions of enabled
+ * rules in policy order, either by event code or in wildcard list for rules that
+ * can match any event code (empty or negated event list).
+ */
+struct EPDispatchIndex
+{
+   HashMap<uint32_t, IntegerArray<int>> byEventCode;
+   IntegerArray<int> wildcard;
+   int boundEntries;
+
+   EPDispatchIndex() : byEventCode(Ownership::True), wildcard(0, 64) { boundEntries = 0; }
+};
+
 /**
  * Event policy
  */
@@ -443,11 +479,13 @@ class EventPolicy
 private:
    ObjectArray<EPRule> m_rules;
    RWLock m_rwlock;
+   EPDispatchIndex m_dispatchIndex[5];   // Indexed by event severity
 
    void readLock() const { m_rwlock.readLock(); }
    void writeLock() { m_rwlock.writeLock(); }
    void unlock() const { m_rwlock.unlock(); }
    int findRuleIndexByGuid(const uuid& guid, int shift = 0) const;
+   void rebuildDispatchIndex();
 
 public:
    EventPolicy() : m_rules(128, 128, Ownership::True) { }
@@ -467,6 +505,8 @@ class EventPolicy
    bool isCategoryInUse(uint32_t categoryId) const;
 
    void getEventReferences(uint32_t eventCode, ObjectArray<EventReference>* eventReferences) const;
+
+   void showStatistics(ServerConsole *console) const;
 };
 
 /**
@@ -124,6 +124,28 @@ struct WebServiceCallResult
    ~WebServiceCallResult();
 };
 
+/**
+ * Single metric in multi-varbind SNMP request
+ */
+struct SNMPMetricRequest
+{
+   uint32_t oid[MAX_OID_LEN];
+   size_t oidLength;
+   int interpretRawValue;
+   DataCollectionError error;
+   TCHAR *value;  // Collected value (dynamically allocated)
+};
+
+/**
+ * Single metric in bulk agent request
+ */
+struct AgentMetricRequest
+{
+   const TCHAR *name;
+   DataCollectionError error;
+   TCHAR *value;  // Collected value (dynamically allocated)
+};
+
 /**
  * Geo area
  */
@@ -253,24 +275,36 @@ struct TemplateUpdateTask
 };
 
 /**
- * Index head
+ * Index version head
  */
 struct INDEX_HEAD;
 
 /**
- * Generic index implementation
+ * Index tree node
+ */
+struct INDEX_NODE;
+
+/**
+ * Index writer state (version pool and retired memory)
+ */
+struct INDEX_WRITER_STATE;
+
+/**
+ * Generic index implementation. Index is a copy-on-write B+ tree - readers access
+ * immutable tree version without locking, writers copy only nodes on the path
+ * from root to modified leaf and publish new version. Replaced nodes and objects
+ * are reclaimed when no reader is accessing older versions anymore.
  */
 class NXCORE_EXPORTABLE AbstractIndexBase
 {
    DISABLE_COPY_CTOR(AbstractIndexBase)
 
 protected:
-   INDEX_HEAD* volatile m_primary;
-   INDEX_HEAD* volatile m_secondary;
+   INDEX_HEAD* volatile m_current;
+   INDEX_WRITER_STATE *m_writerState;
    Mutex m_writerLock;
    bool m_owner;
    bool m_startupMode;
-   bool m_dirty;
    void (*m_objectDestructor)(void*, AbstractIndexBase*);
 
    void destroyObject(void *object)
@@ -280,9 +314,18 @@ class NXCORE_EXPORTABLE AbstractIndexBase
    }
 
    INDEX_HEAD *acquireIndex() const;
-   void swapAndWait();
-
-   static ssize_t findElement(INDEX_HEAD *index, uint64_t key);
+   void releaseIndex(INDEX_HEAD *h) const;
+
+   INDEX_NODE *getWritableNode(INDEX_NODE *node);
+   INDEX_NODE *insertIntoNode(INDEX_NODE *node, uint64_t key, void *object, void **oldObject);
+   void removeFromNode(INDEX_NODE *node, uint64_t key, void **oldObject);
+   void mergeChildNodes(INDEX_NODE *parent, int index);
+   void retireNode(INDEX_NODE *node);
+   void retireTree(INDEX_NODE *node);
+   void retireObject(void *object);
+   INDEX_HEAD *findFreeVersion();
+   void publishVersion(INDEX_NODE *root, size_t size);
+   void reclaimRetiredMemory(bool wait);
 
    void findAll(Array *resultSet, bool (*comparator)(void *, void *), void *data) const;
 
@@ -1065,6 +1108,15 @@ class SearchQuery
    bool match(const SearchAttributeProvider &provider) const;
 };
 
+/**
+ * Options for client message created by NetObj::createClientMessage
+ */
+#define OBJECT_MESSAGE_MASK_PASSWORDS     0x01
+#define OBJECT_MESSAGE_INCLUDE_COMMENTS   0x02
+#define OBJECT_MESSAGE_COMPRESSED         0x04
+
+class ObjectMessageCache;
+
 /**
  * Base class for network objects
  */
@@ -1079,8 +1131,11 @@ class NXCORE_EXPORTABLE NetObj : public NObject
 private:
    typedef NObject super;
    time_t m_creationTime; //Object creation time
+   VolatileCounter m_messageVersion;   // Incremented on each modification
+   shared_ptr<ObjectMessageCache> m_messageCache;  // Serialized messages shared between client sessions
 
    static void onObjectDeleteCallback(NetObj *object, NetObj *context);
+   static void releaseExpiredMessageCache(const shared_ptr<NetObj>& object);
 
    void getFullChildListInternal(ObjectIndex *list, bool eventSourceOnly) const;
 
@@ -1168,6 +1223,7 @@ class NXCORE_EXPORTABLE NetObj : public NObject
    virtual void fillMessageInternalStage2(NXCPMessage *msg, UINT32 userId);
    virtual uint32_t modifyFromMessageInternal(const NXCPMessage& msg);
    virtual uint32_t modifyFromMessageInternalStage2(const NXCPMessage& msg);
+   virtual bool isMessageUserSpecific();
 
    bool isGeoLocationHistoryTableExists(DB_HANDLE hdb) const;
    bool createGeoLocationHistoryTable(DB_HANDLE hdb);
@@ -1260,7 +1316,7 @@ class NXCORE_EXPORTABLE NetObj : public NObject
    virtual void linkObjects();
    virtual void cleanup();
 
-   void setId(uint32_t dwId) { m_id = dwId; setModified(MODIFY_ALL); }
+   void setId(uint32_t dwId) { m_id = dwId; updateAncestorIndex(true); setModified(MODIFY_ALL); }
    void generateGuid() { m_guid = uuid::generate(); }
    void setName(const TCHAR *name) { lockProperties(); _tcslcpy(m_name, name, MAX_OBJECT_NAME); setModified(MODIFY_COMMON_PROPERTIES); unlockProperties(); }
    void resetStatus() { lockProperties(); m_status = STATUS_UNKNOWN; setModified(MODIFY_RUNTIME); unlockProperties(); }
@@ -1278,6 +1334,7 @@ class NXCORE_EXPORTABLE NetObj : public NObject
    virtual void leaveMaintenanceMode(uint32_t userId);
 
    void fillMessage(NXCPMessage *msg, UINT32 userId);
+   NXCP_MESSAGE *createClientMessage(uint16_t code, uint32_t requestId, uint32_t userId, uint32_t options);
    uint32_t modifyFromMessage(const NXCPMessage& msg);
 
    virtual void postModify();
@@ -2289,12 +2346,12 @@ class NXCORE_EXPORTABLE DataCollectionTarget : public DataCollectionOwner, publi
 
    virtual void fillMessageInternal(NXCPMessage *pMsg, UINT32 userId) override;
    virtual void fillMessageInternalStage2(NXCPMessage *pMsg, UINT32 userId) override;
+   virtual bool isMessageUserSpecific() override;
    virtual uint32_t modifyFromMessageInternal(const NXCPMessage& msg) override;
 
    virtual void onDataCollectionLoad() override;
    virtual void onDataCollectionChange() override;
    virtual void onInstanceDiscoveryChange() override;
-   virtual bool isDataCollectionDisabled();
 
    virtual int getAdditionalMostCriticalStatus() override;
 
@@ -2382,7 +2439,9 @@ class NXCORE_EXPORTABLE DataCollectionTarget : public DataCollectionOwner, publi
    void reloadDCItemCache(uint32_t dciId);
    void cleanDCIData(DB_HANDLE hdb);
    void calculateDciCutoffTimes(time_t *cutoffTimeIData, time_t *cutoffTimeTData);
-   void queueItemsForPolling();
+   bool queueItemForPolling(const shared_ptr<DCObject>& object, time_t currTime, DataCollectionBatchSet *batches = nullptr);
+   void scheduleItemsForPolling(bool unscheduledOnly);
+   virtual bool isDataCollectionDisabled();
    bool processNewDCValue(const shared_ptr<DCObject>& dco, time_t currTime, const TCHAR *itemValue, const shared_ptr<Table>& tableValue);
    void scheduleItemDataCleanup(uint32_t dciId);
    void scheduleTableDataCleanup(uint32_t dciId);
@@ -3092,6 +3151,7 @@ class NXCORE_EXPORTABLE Node : public DataCollectionTarget
    Mutex m_routingTableMutex;
    Mutex m_topologyMutex;
    shared_ptr<AgentConnectionEx> m_agentConnection;
+   atomic<bool> m_agentBulkMetricsUnsupported; // Agent does not support bulk metric requests
    ProxyAgentConnection *m_proxyConnections;
    VolatileCounter m_pendingDataConfigurationSync;
    SMCLP_Connection *m_smclpConnection;
@@ -3448,10 +3508,12 @@ class NXCORE_EXPORTABLE Node : public DataCollectionTarget
    virtual DataCollectionError getInternalTable(const TCHAR *name, shared_ptr<Table> *result) override;
 
    DataCollectionError getMetricFromSNMP(UINT16 port, SNMP_Version version, const TCHAR *name, TCHAR *buffer, size_t size, int interpretRawValue);
+   void getMetricsFromSNMP(uint16_t port, SNMP_Version version, SNMPMetricRequest *requests, int count, int maxVarbinds);
    DataCollectionError getTableFromSNMP(UINT16 port, SNMP_Version version, const TCHAR *oid, const ObjectArray<DCTableColumn> &columns, shared_ptr<Table> *table);
    DataCollectionError getListFromSNMP(UINT16 port, SNMP_Version version, const TCHAR *oid, StringList **list);
    DataCollectionError getOIDSuffixListFromSNMP(UINT16 port, SNMP_Version version, const TCHAR *oid, StringMap **values);
    DataCollectionError getMetricFromAgent(const TCHAR *name, TCHAR *buffer, size_t size);
+   void getMetricsFromAgent(AgentMetricRequest *requests, int count, int maxBatchSize);
    DataCollectionError getTableFromAgent(const TCHAR *name, shared_ptr<Table> *table);
    DataCollectionError getListFromAgent(const TCHAR *name, StringList **list);
    DataCollectionError getMetricFromSMCLP(const TCHAR *name, TCHAR *buffer, size_t size);
@@ -54,8 +54,6 @@ class NXSL_DCTargetClass : public NXSL_NetObjClass
 {
 public:
    NXSL_DCTargetClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const NXSL_Identifier& attr) override;
 };
 
 /**
@@ -65,8 +63,6 @@ class NXSL_NodeClass : public NXSL_DCTargetClass
 {
 public:
    NXSL_NodeClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const NXSL_Identifier& attr) override;
 };
 
 /**
@@ -451,10 +447,27 @@ class NXCORE_EXPORTABLE ScriptVMHandle
 private:
    NXSL_VM *m_vm;
    ScriptVMFailureReason m_failureReason;
-
-public:
-   ScriptVMHandle(NXSL_VM *vm) { m_vm = vm; m_failureReason = ScriptVMFailureReason::SUCCESS; }
-   ScriptVMHandle(ScriptVMFailureReason failureReason) { m_vm = nullptr; m_failureReason = failureReason; }
+   uint64_t m_programId;      // Non-zero if VM should be returned to VM pool
+   uint32_t m_libraryVersion;
+   int64_t m_startTime;
+
+public:
+   ScriptVMHandle(NXSL_VM *vm, uint64_t programId = 0, uint32_t libraryVersion = 0)
+   {
+      m_vm = vm;
+      m_failureReason = ScriptVMFailureReason::SUCCESS;
+      m_programId = programId;
+      m_libraryVersion = libraryVersion;
+      m_startTime = (programId != 0) ? GetCurrentTimeUs() : 0;
+   }
+   ScriptVMHandle(ScriptVMFailureReason failureReason)
+   {
+      m_vm = nullptr;
+      m_failureReason = failureReason;
+      m_programId = 0;
+      m_libraryVersion = 0;
+      m_startTime = 0;
+   }
 
    operator NXSL_VM *() { return m_vm; }
    NXSL_VM *operator->() { return m_vm; }
@@ -462,7 +475,7 @@ class NXCORE_EXPORTABLE ScriptVMHandle
    ScriptVMFailureReason failureReason() const { return m_failureReason; }
    bool isValid() const { return m_vm != nullptr; }
 
-   void destroy() { delete m_vm; }
+   void destroy();
 };
 
 /**
@@ -470,6 +483,14 @@ class NXCORE_EXPORTABLE ScriptVMHandle
  */
 NXSL_Library NXCORE_EXPORTABLE *GetServerScriptLibrary();
 
+/**
+ * Script VM pool management and statistics
+ */
+void SetScriptVMPoolSize(uint32_t size);
+void GetScriptVMPoolStatistics(uint64_t *hits, uint64_t *misses, uint32_t *idleVMs);
+bool GetScriptExecutionStatistics(const TCHAR *name, uint64_t *runs, uint64_t *averageExecutionTime);
+void ShowScriptVMPoolStatistics(ServerConsole *console);
+
 /**
  * Setup server script VM. Returns pointer to same VM for convenience.
  */
@@ -520,6 +520,16 @@ class NXCORE_EXPORTABLE AccessList
    json_t *toJson() const;
 };
 
+/**
+ * Effective access rights cache statistics
+ */
+struct AccessRightsCacheStatistics
+{
+   uint64_t hits;
+   uint64_t misses;
+   uint64_t invalidations;
+};
+
 /**
  * Functions
  */
@@ -558,6 +568,12 @@ unique_ptr<ObjectArray<UserDatabaseObject>> FindUserDBObjects(const IntegerArray
 unique_ptr<ObjectArray<UserDatabaseObject>> FindUserDBObjects(const StructArray<ResponsibleUser>& ids);
 NXSL_Value *GetUserDBObjectForNXSL(uint32_t id, NXSL_VM *vm);
 
+bool GetCachedAccessRights(uint32_t userId, uint32_t objectId, uint32_t *rights, uint32_t *version);
+void UpdateAccessRightsCache(uint32_t userId, uint32_t objectId, uint32_t rights, uint32_t version);
+void NXCORE_EXPORTABLE InvalidateAccessRightsCache();
+uint32_t GetAccessRightsCacheVersion();
+void GetAccessRightsCacheStatistics(AccessRightsCacheStatistics *stats);
+
 UserAuthenticationToken IssueAuthenticationToken(uint32_t userId, uint32_t validFor);
 void RevokeAuthenticationToken(const UserAuthenticationToken& token);
 bool ValidateAuthenticationToken(const UserAuthenticationToken& token, uint32_t *userId);
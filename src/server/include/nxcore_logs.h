@@ -211,5 +211,6 @@ int32_t OpenLog(const TCHAR *name, ClientSession *session, uint32_t *rcc);
 uint32_t CloseLog(ClientSession *session, int32_t logHandle);
 void CloseAllLogsForSession(session_id_t sessionId);
 shared_ptr<LogHandle> AcquireLogHandleObject(ClientSession *session, int32_t logHandle);
+void DeleteObjectAccessConstraint(uint32_t userId);
 
 #endif
@@ -45,6 +45,7 @@ class SyslogMessage
    InetAddress m_sourceAddress;
    char *m_rawData;
    size_t m_rawDataLen;
+   int64_t m_queueTime;
 
 public:
    SyslogMessage(const InetAddress& addr, const char *rawData, size_t rawDataLen) : m_sourceAddress(addr)
@@ -61,6 +62,7 @@ class SyslogMessage
       m_tag[0] = 0;
       m_rawMessage = nullptr;
       m_message = nullptr;
+      m_queueTime = GetCurrentTimeMs();
    }
 
    SyslogMessage(const InetAddress& addr, time_t timestamp, uint32_t zoneUIN, uint32_t nodeId, const char *rawData, int rawDataLen) : m_sourceAddress(addr)
@@ -77,6 +79,7 @@ class SyslogMessage
       m_tag[0] = 0;
       m_rawMessage = nullptr;
       m_message = nullptr;
+      m_queueTime = GetCurrentTimeMs();
    }
 
    ~SyslogMessage()
@@ -114,9 +117,29 @@ class SyslogMessage
    uint16_t getFacility() const { return m_facility; }
    uint16_t getSeverity() const { return m_severity; }
    const TCHAR *getMessage() const { return m_message; }
+   int64_t getQueueTime() const { return m_queueTime; }
    const char *getHostName() const { return m_hostName; }
    const char *getTag() const { return m_tag; }
 };
 
+/**
+ * Stats for syslog processing thread
+ */
+struct SyslogProcessingThreadStats
+{
+   uint64_t processedMessages;
+   uint32_t averageWaitTime;     // Average time in queue (milliseconds)
+   uint32_t maxWaitTime;         // Max time in queue (milliseconds)
+   uint32_t averageParseTime;    // Average parsing and node binding time (microseconds)
+   uint32_t averageMatchTime;    // Average parser rule matching time (microseconds)
+   uint32_t queueSize;
+};
+
+/**
+ * Functions
+ */
+StructArray<SyslogProcessingThreadStats> *GetSyslogProcessingThreadStats();
+int64_t GetSyslogProcessorQueueSize();
+
 #endif   /* _nxcore_syslog_h_ */
 
@@ -510,6 +510,22 @@ struct CustomAttribute
    }
 };
 
+/**
+ * Object ancestor index statistics
+ */
+struct ObjectAncestorIndexStats
+{
+   uint32_t objects;          // Number of objects with non-empty ancestor set
+   uint64_t ancestors;        // Total number of ancestor references stored in index
+   uint64_t memoryUsage;      // Estimated memory usage in bytes
+   uint64_t updates;          // Number of index updates caused by object relation changes
+   uint64_t rebuilds;         // Number of ancestor set rebuilds (single update can rebuild sets for entire subtree)
+   uint64_t totalUpdateTime;  // Total time spent on index updates (milliseconds)
+   uint32_t maxUpdateTime;    // Longest index update (milliseconds)
+};
+
+void LIBNXSRV_EXPORTABLE GetObjectAncestorIndexStats(ObjectAncestorIndexStats *stats);
+
 #ifdef _WIN32
 class NObject;
 template class LIBNXSRV_EXPORTABLE shared_ptr<NObject>;
@@ -533,6 +549,12 @@ class LIBNXSRV_EXPORTABLE NObject : public enable_shared_from_this<NObject>
    StringObjectMap<CustomAttribute> m_customAttributes;
    Mutex m_customAttributeLock;
 
+   Mutex m_ancestorIndexLock;  // Serializes rebuilds of this object's ancestor set
+   uint32_t m_indexedId;       // ID under which ancestor set is currently stored in index (0 if not indexed)
+
+   bool rebuildAncestorSet();
+   void propagateAncestorIndexUpdate();
+
    SharedString getCustomAttributeFromParent(const TCHAR *name, uint32_t id);
    std::pair<uint32_t, SharedString> getCustomAttributeFromParent(const TCHAR *name);
    bool setCustomAttributeFromMessage(const NXCPMessage& msg, uint32_t base);
@@ -584,6 +606,8 @@ class LIBNXSRV_EXPORTABLE NObject : public enable_shared_from_this<NObject>
    virtual void onCustomAttributeChange();
    virtual bool getObjectAttribute(const TCHAR *name, TCHAR **value, bool *isAllocated) const;
 
+   void updateAncestorIndex(bool forcePropagation = false);
+
 public:
    NObject();
    virtual ~NObject();
@@ -979,6 +1003,7 @@ class LIBNXSRV_EXPORTABLE AgentConnection : public enable_shared_from_this<Agent
    InterfaceList *getInterfaceList();
    RoutingTable *getRoutingTable();
    uint32_t getParameter(const TCHAR *param, TCHAR *buffer, size_t size);
+   uint32_t getParameters(const StringList& parameters, TCHAR **values, uint32_t *errors);
    uint32_t getList(const TCHAR *param, StringList **list);
    uint32_t getTable(const TCHAR *param, Table **table);
    uint32_t queryWebService(WebServiceRequestType requestType, const TCHAR *url, HttpRequestMethod httpRequestMethod, const TCHAR *requestData,
@@ -1,6 +1,6 @@
 /* 
 ** NetXMS - Network Management System
-** Copyright (C) 2003-2021 Victor Kirhenshtein
+** Copyright (C) 2003-2022 Victor Kirhenshtein
 **
 ** This program is free software; you can redistribute it and/or modify
 ** it under the terms of the GNU Lesser General Public License as published by
@@ -29,7 +29,7 @@
 /**
  *API version
  */
-#define PDSDRV_API_VERSION          1
+#define PDSDRV_API_VERSION          2
 
 /**
  * Driver header
@@ -41,6 +41,16 @@ int __EXPORT pdsdrvAPIVersion = PDSDRV_API_VERSION; \
 const TCHAR __EXPORT *pdsdrvName = name; \
 extern "C" PerfDataStorageDriver __EXPORT *pdsdrvCreateInstance() { return new implClass; }
 
+/**
+ * DCI value passed to performance data storage driver as part of a batch
+ */
+struct PerfDataStorageItemValue
+{
+   DCItem *dci;
+   time_t timestamp;
+   const TCHAR *value;
+};
+
 /**
  * Base class for performance data storage drivers
  */
@@ -57,6 +67,7 @@ class NXCORE_EXPORTABLE PerfDataStorageDriver
    virtual void shutdown();
 
    virtual bool saveDCItemValue(DCItem *dcObject, time_t timestamp, const TCHAR *value);
+   virtual bool saveDCItemValues(const StructArray<PerfDataStorageItemValue>& values);
    virtual bool saveDCTableValue(DCTable *dcObject, time_t timestamp, Table *value);
 
    virtual DataCollectionError getInternalMetric(const TCHAR *metric, TCHAR *value);
@@ -352,7 +352,17 @@ MessageReceiverResult AgentConnectionReceiver::readMessage(bool allowChannelRead
          case CMD_DCI_DATA:
             if (g_agentConnectionThreadPool != nullptr)
             {
-               ThreadPoolExecute(g_agentConnectionThreadPool, connection, &AgentConnection::processCollectedDataCallback, msg);
+               if (msg->getFieldAsBoolean(VID_BULK_RECONCILIATION))
+               {
+                  // Agent may send several bulk messages without waiting for response, process them in order
+                  TCHAR key[64];
+                  _sntprintf(key, 64, _T("BulkData_%p"), this);
+                  ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, connection, &AgentConnection::processCollectedDataCallback, msg);
+               }
+               else
+               {
+                  ThreadPoolExecute(g_agentConnectionThreadPool, connection, &AgentConnection::processCollectedDataCallback, msg);
+               }
             }
             else
             {
@@ -1053,6 +1063,64 @@ uint32_t AgentConnection::getParameter(const TCHAR *param, TCHAR *buffer, size_t
    return rcc;
 }
 
+/**
+ * Get multiple parameter values with single request. Arrays "values" and "errors" should have
+ * same size as parameter list. On success each element of "values" is either dynamically allocated
+ * string (should be freed by caller) or nullptr if corresponding element of "errors" is not ERR_SUCCESS.
+ * Agents without support for bulk requests will return ERR_UNKNOWN_COMMAND.
+ */
+uint32_t AgentConnection::getParameters(const StringList& parameters, TCHAR **values, uint32_t *errors)
+{
+   if (!m_isConnected)
+      return ERR_NOT_CONNECTED;
+
+   NXCPMessage msg(CMD_GET_PARAMETERS, generateRequestId(), m_nProtocolVersion);
+   parameters.fillMessage(&msg, VID_PARAM_LIST_BASE, VID_NUM_PARAMETERS);
+
+   // Agent evaluates up to BULK_METRIC_REQUEST_CONCURRENCY metrics in parallel, so
+   // allow one command timeout for each round of evaluation, but limit total wait time
+   // so that dead or hung agent will not block caller for too long
+   uint32_t rounds = (parameters.size() + BULK_METRIC_REQUEST_CONCURRENCY - 1) / BULK_METRIC_REQUEST_CONCURRENCY;
+   uint32_t timeout = m_commandTimeout * std::min(std::max(rounds, 1u), MAX_BULK_METRIC_TIMEOUT_MULTIPLIER);
+
+   uint32_t rcc;
+   if (sendMessage(&msg))
+   {
+      NXCPMessage *response = waitForMessage(CMD_REQUEST_COMPLETED, msg.getId(), timeout);
+      if (response != nullptr)
+      {
+         rcc = response->getFieldAsUInt32(VID_RCC);
+         if (rcc == ERR_SUCCESS)
+         {
+            if (response->getFieldAsInt32(VID_NUM_PARAMETERS) == parameters.size())
+            {
+               uint32_t fieldId = VID_ELEMENT_LIST_BASE;
+               for(int i = 0; i < parameters.size(); i++, fieldId += 2)
+               {
+                  errors[i] = response->getFieldAsUInt32(fieldId);
+                  values[i] = (errors[i] == ERR_SUCCESS) ? response->getFieldAsString(fieldId + 1) : nullptr;
+               }
+            }
+            else
+            {
+               rcc = ERR_MALFORMED_RESPONSE;
+               debugPrintf(3, _T("Malformed response to CMD_GET_PARAMETERS"));
+            }
+         }
+         delete response;
+      }
+      else
+      {
+         rcc = ERR_REQUEST_TIMEOUT;
+      }
+   }
+   else
+   {
+      rcc = ERR_CONNECTION_BROKEN;
+   }
+   return rcc;
+}
+
 /**
  * Query web service. Request type determines if parameter or list mode will be used.
  * Only first element of "pathList" will be used for list request.
@@ -1229,6 +1297,7 @@ uint32_t AgentConnection::setServerCapabilities()
    msg.setField(VID_ENABLED, true);   // Enables IPv6 on pre-2.0 agents
    msg.setField(VID_IPV6_SUPPORT, true);
    msg.setField(VID_BULK_RECONCILIATION, true);
+   msg.setField(VID_BULK_DATA_PIPELINING, true);
    msg.setField(VID_ENABLE_COMPRESSION, m_allowCompression);
    msg.setField(VID_ACCEPT_KEEPALIVE, true);
    msg.setId(requestId);
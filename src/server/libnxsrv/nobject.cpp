@@ -24,13 +24,170 @@
 #include <nxsrvapi.h>
 #include <netxms-regex.h>
 
+#define DEBUG_TAG _T("obj.relations")
+
+/**
+ * Number of shards in object ancestor index
+ */
+#define ANCESTOR_INDEX_SHARDS 64
+
+/**
+ * Sorted set of IDs of all (direct and indirect) parents of an object
+ */
+class AncestorSet
+{
+private:
+   uint32_t *m_ids;
+   int m_size;
+
+public:
+   AncestorSet(const IntegerArray<uint32_t>& ids)
+   {
+      m_size = ids.size();
+      m_ids = MemCopyArray(ids.getBuffer(), m_size);
+   }
+
+   ~AncestorSet()
+   {
+      MemFree(m_ids);
+   }
+
+   int size() const { return m_size; }
+   uint32_t get(int index) const { return m_ids[index]; }
+
+   bool contains(uint32_t id) const
+   {
+      int l = 0, r = m_size - 1;
+      while(l <= r)
+      {
+         int m = (l + r) / 2;
+         if (m_ids[m] == id)
+            return true;
+         if (m_ids[m] < id)
+            l = m + 1;
+         else
+            r = m - 1;
+      }
+      return false;
+   }
+
+   bool equals(const IntegerArray<uint32_t>& ids) const
+   {
+      return (ids.size() == m_size) && !memcmp(ids.getBuffer(), m_ids, m_size * sizeof(uint32_t));
+   }
+};
+
+/**
+ * Shard of object ancestor index
+ */
+struct AncestorIndexShard
+{
+   RWLock lock;
+   HashMap<uint32_t, AncestorSet> sets;
+
+   AncestorIndexShard() : sets(Ownership::True)
+   {
+   }
+};
+
+/**
+ * Object ancestor index (object ID -> ancestor set). Objects without parents are not present in the index.
+ */
+static AncestorIndexShard s_ancestorIndex[ANCESTOR_INDEX_SHARDS];
+
+/**
+ * Object ancestor index statistics
+ */
+static VolatileCounter64 s_ancestorIndexRebuilds = 0;
+static uint64_t s_ancestorIndexUpdates = 0;
+static uint64_t s_ancestorIndexUpdateTime = 0;
+static uint32_t s_ancestorIndexMaxUpdateTime = 0;
+static Mutex s_ancestorIndexStatsLock(MutexType::FAST);
+
+/**
+ * Get ancestor index shard for given object ID
+ */
+static inline AncestorIndexShard *GetAncestorIndexShard(uint32_t id)
+{
+   return &s_ancestorIndex[id % ANCESTOR_INDEX_SHARDS];
+}
+
+/**
+ * Remove ancestor set for given object ID from index
+ */
+static void RemoveAncestorSet(uint32_t id)
+{
+   AncestorIndexShard *shard = GetAncestorIndexShard(id);
+   shard->lock.writeLock();
+   shard->sets.remove(id);
+   shard->lock.unlock();
+}
+
+/**
+ * Add all ancestors of given object to the list
+ */
+static void AddIndexedAncestors(uint32_t id, IntegerArray<uint32_t> *ids)
+{
+   AncestorIndexShard *shard = GetAncestorIndexShard(id);
+   shard->lock.readLock();
+   AncestorSet *set = shard->sets.get(id);
+   if (set != nullptr)
+   {
+      for(int i = 0; i < set->size(); i++)
+         ids->add(set->get(i));
+   }
+   shard->lock.unlock();
+}
+
+/**
+ * Check if given object is an ancestor of another object
+ */
+static bool IsIndexedAncestor(uint32_t objectId, uint32_t ancestorId)
+{
+   AncestorIndexShard *shard = GetAncestorIndexShard(objectId);
+   shard->lock.readLock();
+   AncestorSet *set = shard->sets.get(objectId);
+   bool result = (set != nullptr) && set->contains(ancestorId);
+   shard->lock.unlock();
+   return result;
+}
+
+/**
+ * Get object ancestor index statistics
+ */
+void LIBNXSRV_EXPORTABLE GetObjectAncestorIndexStats(ObjectAncestorIndexStats *stats)
+{
+   stats->objects = 0;
+   stats->ancestors = 0;
+   stats->memoryUsage = sizeof(s_ancestorIndex);
+   for(int i = 0; i < ANCESTOR_INDEX_SHARDS; i++)
+   {
+      AncestorIndexShard *shard = &s_ancestorIndex[i];
+      shard->lock.readLock();
+      stats->objects += shard->sets.size();
+      for(AncestorSet *set : shard->sets)
+         stats->ancestors += set->size();
+      shard->lock.unlock();
+   }
+   // Hash map entry overhead is estimated as 64 bytes
+   stats->memoryUsage += static_cast<uint64_t>(stats->objects) * (sizeof(AncestorSet) + 64) + stats->ancestors * sizeof(uint32_t);
+   stats->rebuilds = s_ancestorIndexRebuilds;
+   s_ancestorIndexStatsLock.lock();
+   stats->updates = s_ancestorIndexUpdates;
+   stats->totalUpdateTime = s_ancestorIndexUpdateTime;
+   stats->maxUpdateTime = s_ancestorIndexMaxUpdateTime;
+   s_ancestorIndexStatsLock.unlock();
+}
+
 /**
  * Default constructor for the class
  */
-NObject::NObject() : m_customAttributes(Ownership::True), m_parentList(8, 8), m_childList(0, 32), m_customAttributeLock(MutexType::FAST)
+NObject::NObject() : m_customAttributes(Ownership::True), m_parentList(8, 8), m_childList(0, 32), m_customAttributeLock(MutexType::FAST),
+         m_ancestorIndexLock(MutexType::FAST)
 {
    m_id = 0;
    m_name[0] = 0;
+   m_indexedId = 0;
 }
 
 /**
@@ -38,6 +195,8 @@ NObject::NObject() : m_customAttributes(Ownership::True), m_parentList(8, 8), m_
  */
 NObject::~NObject()
 {
+   if (m_indexedId != 0)
+      RemoveAncestorSet(m_indexedId);
 }
 
 /**
@@ -47,6 +206,119 @@ NObject::~NObject()
 void NObject::clearParentList()
 {
    m_parentList.clear();
+
+   // Ancestor set rebuild cannot be started while parent list is locked,
+   // so index entry can be safely removed here
+   if (m_indexedId != 0)
+   {
+      RemoveAncestorSet(m_indexedId);
+      m_indexedId = 0;
+   }
+}
+
+/**
+ * Rebuild ancestor set of this object from ancestor sets of direct parents.
+ * Returns true if ancestor set was changed.
+ */
+bool NObject::rebuildAncestorSet()
+{
+   if (m_id == 0)
+      return false;  // Object is not registered yet
+
+   m_ancestorIndexLock.lock();
+   InterlockedIncrement64(&s_ancestorIndexRebuilds);
+
+   IntegerArray<uint32_t> ids(64, 64);
+   readLockParentList();
+   for(int i = 0; i < m_parentList.size(); i++)
+   {
+      uint32_t parentId = m_parentList.get(i)->getId();
+      ids.add(parentId);
+      AddIndexedAncestors(parentId, &ids);
+   }
+
+   // Sort and remove duplicates (shared ancestors of different parents)
+   ids.sortAscending();
+   for(int i = ids.size() - 1; i > 0; i--)
+      if (ids.get(i) == ids.get(i - 1))
+         ids.remove(i);
+
+   bool changed = false;
+   if ((m_indexedId != 0) && (m_indexedId != m_id))
+   {
+      RemoveAncestorSet(m_indexedId);
+      m_indexedId = 0;
+      changed = true;
+   }
+
+   // Index is updated while parent list is still locked to avoid race with clearParentList()
+   AncestorIndexShard *shard = GetAncestorIndexShard(m_id);
+   shard->lock.writeLock();
+   if (ids.isEmpty())
+   {
+      if (m_indexedId != 0)
+      {
+         shard->sets.remove(m_id);
+         m_indexedId = 0;
+         changed = true;
+      }
+   }
+   else
+   {
+      AncestorSet *curr = shard->sets.get(m_id);
+      if ((curr == nullptr) || !curr->equals(ids))
+      {
+         shard->sets.set(m_id, new AncestorSet(ids));
+         changed = true;
+      }
+      m_indexedId = m_id;
+   }
+   shard->lock.unlock();
+   unlockParentList();
+
+   m_ancestorIndexLock.unlock();
+   return changed;
+}
+
+/**
+ * Rebuild ancestor sets of all descendants after change of this object's ancestor set
+ */
+void NObject::propagateAncestorIndexUpdate()
+{
+   SharedObjectArray<NObject> children(m_childList.size(), 16);
+   readLockChildList();
+   for(int i = 0; i < m_childList.size(); i++)
+      children.add(m_childList.getShared(i));
+   unlockChildList();
+
+   for(int i = 0; i < children.size(); i++)
+   {
+      NObject *child = children.get(i);
+      if (child->rebuildAncestorSet())
+         child->propagateAncestorIndexUpdate();
+   }
+}
+
+/**
+ * Update ancestor index after change in object's parent list or ID. If forcePropagation
+ * is true, ancestor sets of child objects will be rebuilt even if own ancestor set is not changed.
+ */
+void NObject::updateAncestorIndex(bool forcePropagation)
+{
+   int64_t startTime = GetCurrentTimeMs();
+
+   if (rebuildAncestorSet() || forcePropagation)
+      propagateAncestorIndexUpdate();
+
+   uint32_t elapsed = static_cast<uint32_t>(GetCurrentTimeMs() - startTime);
+   s_ancestorIndexStatsLock.lock();
+   s_ancestorIndexUpdates++;
+   s_ancestorIndexUpdateTime += elapsed;
+   if (elapsed > s_ancestorIndexMaxUpdateTime)
+      s_ancestorIndexMaxUpdateTime = elapsed;
+   s_ancestorIndexStatsLock.unlock();
+   if (elapsed > 1000)
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("NObject::updateAncestorIndex: index update for object %s [%u] took %u milliseconds"), m_name, m_id, elapsed);
 }
 
 /**
@@ -100,6 +372,8 @@ void NObject::addParent(const shared_ptr<NObject>& object)
    }
    m_parentList.add(object);
    unlockParentList();
+
+   updateAncestorIndex();
 }
 
 /**
@@ -135,6 +409,8 @@ void NObject::deleteParent(uint32_t objectId)
 
    if (success)
    {
+      updateAncestorIndex();
+
       StringList removeList;
 
       lockCustomAttributes();
@@ -159,22 +435,12 @@ void NObject::deleteParent(uint32_t objectId)
  */
 bool NObject::isChild(uint32_t id) const
 {
-   bool result = isDirectChild(id);
-
-   // If given object is not in child list, check if it is indirect child
-   if (!result)
-   {
-      readLockChildList();
-      for(int i = 0; i < m_childList.size(); i++)
-         if (m_childList.get(i)->isChild(id))
-         {
-            result = true;
-            break;
-         }
-      unlockChildList();
-   }
+   // Check for our own ID (object ID should never change, so we may not lock object's data)
+   if (m_id == id)
+      return true;
 
-   return result;
+   // Given object is our child if we are in it's ancestor set
+   return IsIndexedAncestor(id, m_id);
 }
 
 /**
@@ -201,22 +467,11 @@ bool NObject::isDirectChild(uint32_t id) const
  */
 bool NObject::isParent(uint32_t id) const
 {
-   bool result = isDirectParent(id);
-
-   // If given object is not in parent list, check if it is indirect parent
-   if (!result)
-   {
-      readLockParentList();
-      for(int i = 0; i < m_parentList.size(); i++)
-         if (m_parentList.get(i)->isParent(id))
-         {
-            result = true;
-            break;
-         }
-      unlockParentList();
-   }
+   // Check for our own ID (object ID should never change, so we may not lock object's data)
+   if (m_id == id)
+      return true;
 
-   return result;
+   return IsIndexedAncestor(m_id, id);
 }
 
 /**
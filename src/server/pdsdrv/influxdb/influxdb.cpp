@@ -214,9 +214,9 @@ static bool GetTagsFromObject(const NetObj& object, StringBuffer *tags)
 }
 
 /**
- * Build and queue metric from item DCI's
+ * Build metric from item DCI value. Returns false if metric should not be sent.
  */
-bool InfluxDBStorageDriver::saveDCItemValue(DCItem *dci, time_t timestamp, const TCHAR *value)
+bool InfluxDBStorageDriver::buildMetric(DCItem *dci, time_t timestamp, const TCHAR *value, StringBuffer *data)
 {
    nxlog_debug_tag(DEBUG_TAG, 8,
             _T("Raw metric: OwnerName:%s DataSource:%i Type:%i Name:%s Description: %s Instance:%s DataType:%i DeltaCalculationMethod:%i RelatedObject:%i Value:%s timestamp:") INT64_FMT,
@@ -228,7 +228,7 @@ bool InfluxDBStorageDriver::saveDCItemValue(DCItem *dci, time_t timestamp, const
    if (*value == 0)
    {
       nxlog_debug_tag(DEBUG_TAG, 7, _T("Metric %s [%u] not sent: empty value"), dci->getName().cstr(), dci->getId());
-      return true;
+      return false;
    }
 
    const TCHAR *ds; // Data sources
@@ -342,12 +342,20 @@ bool InfluxDBStorageDriver::saveDCItemValue(DCItem *dci, time_t timestamp, const
          break;
    }
 
+   // Owner could be already deleted as values are processed asynchronously
+   shared_ptr<DataCollectionOwner> owner = dci->getOwner();
+   if (owner == nullptr)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 7, _T("Metric %s [%u] not sent: owner object deleted"), dci->getName().cstr(), dci->getId());
+      return false;
+   }
+
    // Get Host CA's
    StringBuffer tags;
-   if (GetTagsFromObject(static_cast<NetObj&>(*dci->getOwner()), &tags))
+   if (GetTagsFromObject(static_cast<NetObj&>(*owner), &tags))
    {
       nxlog_debug_tag(DEBUG_TAG, 7, _T("Metric not sent: ignore flag set on owner object"));
-      return true;
+      return false;
    }
 
    // Get RelatedObject (Interface) CA's
@@ -359,7 +367,7 @@ bool InfluxDBStorageDriver::saveDCItemValue(DCItem *dci, time_t timestamp, const
       if (GetTagsFromObject(static_cast<NetObj&>(*relatedObject), &tags))
       {
          nxlog_debug_tag(DEBUG_TAG, 7, _T("Metric not sent: ignore flag set on related object %s"), relatedObject->getName());
-         return true;
+         return false;
       }
    }
 
@@ -390,7 +398,7 @@ bool InfluxDBStorageDriver::saveDCItemValue(DCItem *dci, time_t timestamp, const
    }
 
    // Host
-   StringBuffer host(dci->getOwner()->getName());
+   StringBuffer host(owner->getName());
    host.replace(_T(" "), _T("_"));
    host.replace(_T(","), _T("_"));
    host.replace(_T(":"), _T("_"));
@@ -398,42 +406,81 @@ bool InfluxDBStorageDriver::saveDCItemValue(DCItem *dci, time_t timestamp, const
    host.toLowercase();
 
    // Build final metric structure
-   StringBuffer data(name);
-   data.append(_T(",host="));
-   data.append(host);
-   data.append(_T(",instance="));
-   data.append(instance);
-   data.append(_T(",datasource="));
-   data.append(ds);
-   data.append(_T(",dataclass=item,datatype="));
-   data.append(dt);
-   data.append(_T(",deltatype="));
-   data.append(dct);
-   data.append(_T(",relatedobjecttype="));
-   data.append((relatedObject != nullptr) ? relatedObject->getObjectClassName() : _T("none"));
-   data.append(tags);
+   data->append(name);
+   data->append(_T(",host="));
+   data->append(host);
+   data->append(_T(",instance="));
+   data->append(instance);
+   data->append(_T(",datasource="));
+   data->append(ds);
+   data->append(_T(",dataclass=item,datatype="));
+   data->append(dt);
+   data->append(_T(",deltatype="));
+   data->append(dct);
+   data->append(_T(",relatedobjecttype="));
+   data->append((relatedObject != nullptr) ? relatedObject->getObjectClassName() : _T("none"));
+   data->append(tags);
    if (dci->getDataType() == DCI_DT_STRING)
    {
-      data.append(_T(" value=\""));
-      data.append(value);
-      data.append(_T("\" "));
+      data->append(_T(" value=\""));
+      data->append(value);
+      data->append(_T("\" "));
    }
    else
    {
-      data.append(_T(" value="));
-      data.append(value);
+      data->append(_T(" value="));
+      data->append(value);
       if (isInteger)
-         data.append((isUnsigned && m_enableUnsignedType) ? _T("u ") : _T("i "));
+         data->append((isUnsigned && m_enableUnsignedType) ? _T("u ") : _T("i "));
       else
-         data.append(_T(' '));
+         data->append(_T(' '));
    }
-   data.append(static_cast<uint64_t>(timestamp));
-   data.append(_T("000000000")); // Use nanosecond precision
+   data->append(static_cast<uint64_t>(timestamp));
+   data->append(_T("000000000")); // Use nanosecond precision
+   return true;
+}
+
+/**
+ * Build and queue metric from item DCI's
+ */
+bool InfluxDBStorageDriver::saveDCItemValue(DCItem *dci, time_t timestamp, const TCHAR *value)
+{
+   StringBuffer data;
+   if (!buildMetric(dci, timestamp, value, &data))
+      return true;
 
    int senderIndex = dci->getId() % m_senders.size();
    nxlog_debug_tag(DEBUG_TAG, 7, _T("Queuing data to sender #%d: %s"), senderIndex, data.cstr());
    m_senders.get(senderIndex)->enqueue(data);
+   return true;
+}
+
+/**
+ * Build and queue metrics for batch of item DCI values. Metrics for each sender are queued at once.
+ */
+bool InfluxDBStorageDriver::saveDCItemValues(const StructArray<PerfDataStorageItemValue>& values)
+{
+   ObjectArray<StringList> batches(m_senders.size(), 16, Ownership::True);
+   for(int i = 0; i < m_senders.size(); i++)
+      batches.add(new StringList());
 
+   for(int i = 0; i < values.size(); i++)
+   {
+      const PerfDataStorageItemValue *v = values.get(i);
+      StringBuffer data;
+      if (buildMetric(v->dci, v->timestamp, v->value, &data))
+         batches.get(v->dci->getId() % m_senders.size())->add(data);
+   }
+
+   for(int i = 0; i < m_senders.size(); i++)
+   {
+      StringList *batch = batches.get(i);
+      if (!batch->isEmpty())
+      {
+         nxlog_debug_tag(DEBUG_TAG, 7, _T("Queuing %d metrics to sender #%d"), batch->size(), i);
+         m_senders.get(i)->enqueue(*batch);
+      }
+   }
    return true;
 }
 
@@ -98,6 +98,7 @@ class InfluxDBSender
    void start();
    void stop();
    void enqueue(const TCHAR *data);
+   void enqueue(const StringList& data);
 
    uint64_t getQueueSizeInBytes();
    uint32_t getQueueSizeInMessages();
@@ -189,6 +190,8 @@ class InfluxDBStorageDriver : public PerfDataStorageDriver
    ObjectArray<InfluxDBSender> m_senders;
    bool m_enableUnsignedType;
 
+   bool buildMetric(DCItem *dci, time_t timestamp, const TCHAR *value, StringBuffer *data);
+
 public:
    InfluxDBStorageDriver();
    virtual ~InfluxDBStorageDriver();
@@ -197,6 +200,7 @@ class InfluxDBStorageDriver : public PerfDataStorageDriver
    virtual bool init(Config *config) override;
    virtual void shutdown() override;
    virtual bool saveDCItemValue(DCItem *dcObject, time_t timestamp, const TCHAR *value) override;
+   virtual bool saveDCItemValues(const StructArray<PerfDataStorageItemValue>& values) override;
    virtual bool saveDCTableValue(DCTable *dcObject, time_t timestamp, Table *value) override;
    virtual DataCollectionError getInternalMetric(const TCHAR *metric, TCHAR *value) override;
 };
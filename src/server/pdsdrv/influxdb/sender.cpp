@@ -214,6 +214,39 @@ void InfluxDBSender::enqueue(const TCHAR *data)
    unlock();
 }
 
+/**
+ * Enqueue multiple data lines
+ */
+void InfluxDBSender::enqueue(const StringList& data)
+{
+   lock();
+
+   for(int i = 0; i < data.size(); i++)
+   {
+      if (m_queue.length() < m_queueSizeLimit)
+      {
+         m_queue.append(data.get(i));
+         m_queue.append(_T('\n'));
+         m_queuedMessages++;
+      }
+      else
+      {
+         m_messageDrops++;
+      }
+   }
+
+   if (m_queue.length() >= m_queueFlushThreshold)
+   {
+#ifdef _WIN32
+      WakeAllConditionVariable(&m_condition);
+#else
+      pthread_cond_broadcast(&m_condition);
+#endif
+   }
+
+   unlock();
+}
+
 /**
  * Get queue size in bytes
  */
@@ -34,6 +34,7 @@ class RRDToolStorageDriver : public PerfDataStorageDriver
    virtual const TCHAR *getName();
 
    virtual bool saveDCItemValue(DCItem *dcObject, time_t timestamp, const TCHAR *value);
+   virtual bool saveDCItemValues(const StructArray<PerfDataStorageItemValue>& values);
    virtual bool saveDCTableValue(DCTable *dcObject, time_t timestamp, Table *value);
 };
 
@@ -59,6 +60,21 @@ bool RRDToolStorageDriver::saveDCItemValue(DCItem *dcObject, time_t timestamp, c
    return true;
 }
 
+/**
+ * Save batch of DCI values
+ */
+bool RRDToolStorageDriver::saveDCItemValues(const StructArray<PerfDataStorageItemValue>& values)
+{
+   _tprintf(_T("SAVE BATCH: %d values\n"), values.size());
+   for(int i = 0; i < values.size(); i++)
+   {
+      const PerfDataStorageItemValue *v = values.get(i);
+      _tprintf(_T("   %s %s\n"), v->dci->getName().cstr(), v->value);
+   }
+   _tprintf(_T("\n"));
+   return true;
+}
+
 /**
  * Save table DCI value
  */
@@ -23,6 +23,212 @@
 #include "nxdbmgr.h"
 #include <nxevent.h>
 
+/**
+ * Upgrade from 41.20 to 41.21
+ */
+static bool H_UpgradeFromV20()
+{
+   CHK_EXEC(CreateConfigParam(_T("ThreadPool.DataCollector.WorkStealing"),
+         _T("0"),
+         _T("Enable/disable work stealing between worker threads of data collector thread pool."),
+         nullptr, 'B', true, true, false, false));
+   CHK_EXEC(CreateConfigParam(_T("ThreadPool.Poller.WorkStealing"),
+         _T("0"),
+         _T("Enable/disable work stealing between worker threads of poller thread pool"),
+         nullptr, 'B', true, true, false, false));
+
+   CHK_EXEC(SetMinorSchemaVersion(21));
+   return true;
+}
+
+/**
+ * Upgrade from 41.19 to 41.20
+ */
+static bool H_UpgradeFromV19()
+{
+   CHK_EXEC(SQLQuery(_T("CREATE TABLE dci_rollup_watermarks (")
+                     _T("   item_id integer not null,")
+                     _T("   watermark integer not null,")
+                     _T("   PRIMARY KEY(item_id))")));
+   CHK_EXEC(SQLQuery(_T("INSERT INTO dci_rollup_watermarks (item_id,watermark) SELECT item_id,max(period_start)+3600 FROM dci_data_rollup_1h GROUP BY item_id")));
+
+   CHK_EXEC(CreateConfigParam(_T("DataCollection.Rollup.LateDataWindow"),
+         _T("24"),
+         _T("Time period before last pre-aggregated period for which pre-aggregated DCI data is recalculated on each run to include DCI values received with delay."),
+         _T("hours"), 'I', true, false, false, false));
+
+   CHK_EXEC(SetMinorSchemaVersion(20));
+   return true;
+}
+
+/**
+ * Upgrade from 41.18 to 41.19
+ */
+static bool H_UpgradeFromV18()
+{
+   CHK_EXEC(CreateConfigParam(_T("PerfDataStorage.BatchSize"),
+         _T("256"),
+         _T("Maximum number of values passed to performance data storage driver in single call."),
+         nullptr, 'I', true, true, false, false));
+   CHK_EXEC(CreateConfigParam(_T("PerfDataStorage.OverflowPolicy"),
+         _T("0"),
+         _T("Action taken when performance data storage driver request queue is full: drop new values, block data collection until queue has free space, or write values to disk and send them to driver later."),
+         nullptr, 'C', true, true, false, false));
+   CHK_EXEC(CreateConfigParam(_T("PerfDataStorage.QueueSizeLimit"),
+         _T("100000"),
+         _T("Maximum number of values in request queue of each performance data storage driver."),
+         nullptr, 'I', true, true, false, false));
+
+   static const TCHAR *batch =
+      _T("INSERT INTO config_values (var_name,var_value,var_description) VALUES ('PerfDataStorage.OverflowPolicy','0','Drop')\n")
+      _T("INSERT INTO config_values (var_name,var_value,var_description) VALUES ('PerfDataStorage.OverflowPolicy','1','Block')\n")
+      _T("INSERT INTO config_values (var_name,var_value,var_description) VALUES ('PerfDataStorage.OverflowPolicy','2','Spill to disk')\n")
+      _T("<END>");
+   CHK_EXEC(SQLBatch(batch));
+
+   CHK_EXEC(SetMinorSchemaVersion(19));
+   return true;
+}
+
+/**
+ * Upgrade from 41.17 to 41.18
+ */
+static bool H_UpgradeFromV17()
+{
+   CHK_EXEC(SQLQuery(_T("CREATE TABLE dci_data_rollup_5m (")
+                     _T("   item_id integer not null,")
+                     _T("   period_start integer not null,")
+                     _T("   value_min varchar(32) null,")
+                     _T("   value_max varchar(32) null,")
+                     _T("   value_avg varchar(32) null,")
+                     _T("   sample_count integer not null,")
+                     _T("   PRIMARY KEY(item_id,period_start))")));
+
+   CHK_EXEC(SQLQuery(_T("CREATE TABLE dci_data_rollup_1h (")
+                     _T("   item_id integer not null,")
+                     _T("   period_start integer not null,")
+                     _T("   value_min varchar(32) null,")
+                     _T("   value_max varchar(32) null,")
+                     _T("   value_avg varchar(32) null,")
+                     _T("   sample_count integer not null,")
+                     _T("   PRIMARY KEY(item_id,period_start))")));
+
+   CHK_EXEC(CreateConfigParam(_T("DataCollection.Rollup.Enable"),
+         _T("0"),
+         _T("Enable/disable calculation of pre-aggregated (5 minute and 1 hour) DCI data by housekeeper. Pre-aggregated data is used for long range history requests with server-side aggregation."),
+         nullptr, 'B', true, false, false, false));
+   CHK_EXEC(CreateConfigParam(_T("DataCollection.Rollup.FiveMinuteRetentionTime"),
+         _T("90"),
+         _T("Retention time in days for 5 minute pre-aggregated DCI data."),
+         _T("days"), 'I', true, false, false, false));
+   CHK_EXEC(CreateConfigParam(_T("DataCollection.Rollup.HourlyRetentionTime"),
+         _T("730"),
+         _T("Retention time in days for 1 hour pre-aggregated DCI data."),
+         _T("days"), 'I', true, false, false, false));
+
+   CHK_EXEC(SetMinorSchemaVersion(18));
+   return true;
+}
+
+/**
+ * Upgrade from 41.16 to 41.17
+ */
+static bool H_UpgradeFromV16()
+{
+   CHK_EXEC(SQLQuery(_T("CREATE TABLE log_access_objects (")
+                     _T("   user_id integer not null,")
+                     _T("   list_type integer not null,")
+                     _T("   object_id integer not null,")
+                     _T("   PRIMARY KEY(user_id,list_type,object_id))")));
+
+   CHK_EXEC(SetMinorSchemaVersion(17));
+   return true;
+}
+
+/**
+ * Upgrade from 41.15 to 41.16
+ */
+static bool H_UpgradeFromV15()
+{
+   CHK_EXEC(CreateConfigParam(_T("Syslog.Processor.PoolSize"),
+         _T("1"),
+         _T("Number of threads for parallel syslog message processing. Messages from same source are always processed by same thread."),
+         _T("threads"), 'I', true, true, false, false));
+
+   CHK_EXEC(SetMinorSchemaVersion(16));
+   return true;
+}
+
+/**
+ * Upgrade from 41.14 to 41.15
+ */
+static bool H_UpgradeFromV14()
+{
+   CHK_EXEC(CreateConfigParam(_T("NXSL.VMPoolSize"),
+         _T("4"),
+         _T("Maximum number of idle script VMs kept ready for reuse for each compiled script. Set to 0 to disable VM reuse."),
+         nullptr, 'I', true, false, false, false));
+
+   CHK_EXEC(SetMinorSchemaVersion(15));
+   return true;
+}
+
+/**
+ * Upgrade from 41.13 to 41.14
+ */
+static bool H_UpgradeFromV13()
+{
+   CHK_EXEC(CreateConfigParam(_T("DataCollection.Agent.MaxParametersPerRequest"),
+         _T("32"),
+         _T("Maximum number of metrics requested from NetXMS agent in single bulk request when collecting data for agent DCIs. DCIs due for polling at the same time are collected together. Set to 1 to collect each DCI with separate request. Values above 32 are treated as 32. Can be overridden for specific node with custom attribute SysConfig:DataCollection.Agent.MaxParametersPerRequest."),
+         nullptr, 'I', true, false, false, false));
+
+   CHK_EXEC(SetMinorSchemaVersion(14));
+   return true;
+}
+
+/**
+ * Upgrade from 41.12 to 41.13
+ */
+static bool H_UpgradeFromV12()
+{
+   CHK_EXEC(CreateConfigParam(_T("SNMP.Walk.MaxRepetitions"),
+         _T("32"),
+         _T("Maximum number of repetitions in GETBULK requests used for walking SNMP MIB of SNMPv2c and SNMPv3 devices. Actual number of repetitions is adjusted automatically to device responses. Set to 0 to walk MIB using GETNEXT requests only."),
+         nullptr, 'I', true, true, false, false));
+
+   CHK_EXEC(SetMinorSchemaVersion(13));
+   return true;
+}
+
+/**
+ * Upgrade from 41.11 to 41.12
+ */
+static bool H_UpgradeFromV11()
+{
+   CHK_EXEC(CreateConfigParam(_T("DataCollection.SNMP.MaxVarbindsPerRequest"),
+         _T("32"),
+         _T("Maximum number of SNMP variables requested from device in single multi-varbind request when collecting data for SNMP DCIs. DCIs with same polling schedule are collected together and request is split automatically if device reports that response is too big. Set to 1 to collect each DCI with separate request. Can be overridden for specific node with custom attribute SysConfig:DataCollection.SNMP.MaxVarbindsPerRequest."),
+         nullptr, 'I', true, false, false, false));
+
+   CHK_EXEC(SetMinorSchemaVersion(12));
+   return true;
+}
+
+/**
+ * Upgrade from 41.10 to 41.11
+ */
+static bool H_UpgradeFromV10()
+{
+   CHK_EXEC(CreateConfigParam(_T("DBWriter.IDataFlushInterval"),
+         _T("500"),
+         _T("Maximum time (in milliseconds) DCI data writer will wait for more records before writing accumulated batch to database."),
+         _T("milliseconds"), 'I', true, true, false, false));
+
+   CHK_EXEC(SetMinorSchemaVersion(11));
+   return true;
+}
+
 /**
  * Upgrade from 41.9 to 41.10
  */
@@ -342,6 +548,17 @@ static struct
    int nextMinor;
    bool (*upgradeProc)();
 } s_dbUpgradeMap[] = {
+   { 20, 41, 21, H_UpgradeFromV20 },
+   { 19, 41, 20, H_UpgradeFromV19 },
+   { 18, 41, 19, H_UpgradeFromV18 },
+   { 17, 41, 18, H_UpgradeFromV17 },
+   { 16, 41, 17, H_UpgradeFromV16 },
+   { 15, 41, 16, H_UpgradeFromV15 },
+   { 14, 41, 15, H_UpgradeFromV14 },
+   { 13, 41, 14, H_UpgradeFromV13 },
+   { 12, 41, 13, H_UpgradeFromV12 },
+   { 11, 41, 12, H_UpgradeFromV11 },
+   { 10, 41, 11, H_UpgradeFromV10 },
    { 9,  41, 10, H_UpgradeFromV9  },
    { 8,  41, 9,  H_UpgradeFromV8  },
    { 7,  41, 8,  H_UpgradeFromV7  },
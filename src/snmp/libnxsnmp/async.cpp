@@ -0,0 +1,769 @@
+/*
+** NetXMS - Network Management System
+** SNMP support library
+** Copyright (C) 2003-2022 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation; either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: async.cpp
+**
+**/
+
+#include "libnxsnmp.h"
+
+/**
+ * Maximum number of datagrams read from single socket in one worker thread iteration
+ */
+#define MAX_DATAGRAMS_PER_ITERATION    256
+
+/**
+ * Receive buffer size for engine sockets
+ */
+#define SOCKET_RECEIVE_BUFFER_SIZE     (4 * 1024 * 1024)
+
+/**
+ * Pending asynchronous request
+ */
+struct SNMP_AsyncRequest
+{
+   uint32_t id;
+   InetAddress addr;
+   SockAddrBuffer peer;
+   SOCKET socket;
+   BYTE *data;       // Encoded request
+   size_t size;
+   SNMP_SecurityContext *securityContext;
+   uint32_t timeout;
+   int retries;      // Remaining retransmissions
+   int64_t deadline;
+   int timerIndex;   // Index in timer heap
+   void (*callback)(uint32_t, SNMP_PDU*, void*);
+   void *context;
+
+   ~SNMP_AsyncRequest()
+   {
+      MemFree(data);
+      delete securityContext;
+   }
+};
+
+/**
+ * Get message ID (for SNMPv3) or request ID (for SNMPv1 and SNMPv2c) from raw message without full parsing
+ */
+static bool PeekMessageId(const BYTE *data, size_t size, uint32_t *id)
+{
+   uint32_t type;
+   size_t length, idLength;
+   const BYTE *content;
+
+   if (!BER_DecodeIdentifier(data, size, &type, &length, &content, &idLength) || (type != ASN_SEQUENCE) || (length + idLength > size))
+      return false;
+   const BYTE *currPos = content;
+   size_t remaining = length;
+
+   // Version
+   uint32_t version;
+   if (!BER_DecodeIdentifier(currPos, remaining, &type, &length, &content, &idLength) || (type != ASN_INTEGER) ||
+       !BER_DecodeContent(type, content, length, reinterpret_cast<BYTE*>(&version)))
+      return false;
+   currPos = content + length;
+   remaining -= length + idLength;
+
+   if (version == SNMP_VERSION_3)
+   {
+      // Message ID is first element of global header
+      if (!BER_DecodeIdentifier(currPos, remaining, &type, &length, &content, &idLength) || (type != ASN_SEQUENCE))
+         return false;
+   }
+   else
+   {
+      // Skip community string and enter PDU
+      if (!BER_DecodeIdentifier(currPos, remaining, &type, &length, &content, &idLength) || (type != ASN_OCTET_STRING))
+         return false;
+      currPos = content + length;
+      remaining -= length + idLength;
+      if (!BER_DecodeIdentifier(currPos, remaining, &type, &length, &content, &idLength))
+         return false;
+   }
+
+   if (!BER_DecodeIdentifier(content, length, &type, &length, &content, &idLength) || (type != ASN_INTEGER))
+      return false;
+   return BER_DecodeContent(type, content, length, reinterpret_cast<BYTE*>(id));
+}
+
+/**
+ * Create UDP socket for engine
+ */
+static SOCKET CreateEngineSocket(int family)
+{
+   SOCKET s = CreateSocket(family, SOCK_DGRAM, 0);
+   if (s == INVALID_SOCKET)
+      return INVALID_SOCKET;
+
+   SockAddrBuffer localAddr;
+   memset(&localAddr, 0, sizeof(SockAddrBuffer));
+   if (family == AF_INET)
+   {
+      localAddr.sa4.sin_family = AF_INET;
+      localAddr.sa4.sin_addr.s_addr = htonl(INADDR_ANY);
+   }
+#ifdef WITH_IPV6
+   else
+   {
+      localAddr.sa6.sin6_family = AF_INET6;
+   }
+#endif
+   if (bind(s, (struct sockaddr *)&localAddr, SA_LEN((struct sockaddr *)&localAddr)) != 0)
+   {
+      closesocket(s);
+      return INVALID_SOCKET;
+   }
+
+   int bufferSize = SOCKET_RECEIVE_BUFFER_SIZE;
+   setsockopt(s, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<char*>(&bufferSize), sizeof(bufferSize));
+   SetSocketNonBlocking(s);
+   return s;
+}
+
+/**
+ * Create asynchronous SNMP engine
+ */
+SNMP_AsyncEngine::SNMP_AsyncEngine(int numSockets) : m_mutex(MutexType::FAST)
+{
+   m_numSockets = std::max(std::min(numSockets, 64), 1);
+   m_sockets = MemAllocArrayNoInit<SOCKET>(m_numSockets);
+#ifdef WITH_IPV6
+   m_sockets6 = MemAllocArrayNoInit<SOCKET>(m_numSockets);
+#endif
+   for(int i = 0; i < m_numSockets; i++)
+   {
+      m_sockets[i] = INVALID_SOCKET;
+#ifdef WITH_IPV6
+      m_sockets6[i] = INVALID_SOCKET;
+#endif
+   }
+   m_controlSockets[0] = INVALID_SOCKET;
+   m_controlSockets[1] = INVALID_SOCKET;
+   m_workerThread = INVALID_THREAD_HANDLE;
+   m_requests = new HashMap<uint32_t, SNMP_AsyncRequest>(Ownership::False);
+   m_timers = new ObjectArray<SNMP_AsyncRequest>(1024, 1024, Ownership::False);
+   m_wakeupTime = 0;
+   m_shutdown = false;
+   m_receiveBuffer = MemAllocArrayNoInit<BYTE>(SNMP_DEFAULT_MSG_MAX_SIZE);
+}
+
+/**
+ * Destroy asynchronous SNMP engine
+ */
+SNMP_AsyncEngine::~SNMP_AsyncEngine()
+{
+   shutdown();
+   for(int i = 0; i < m_numSockets; i++)
+   {
+      if (m_sockets[i] != INVALID_SOCKET)
+         closesocket(m_sockets[i]);
+#ifdef WITH_IPV6
+      if (m_sockets6[i] != INVALID_SOCKET)
+         closesocket(m_sockets6[i]);
+#endif
+   }
+   MemFree(m_sockets);
+#ifdef WITH_IPV6
+   MemFree(m_sockets6);
+#endif
+   if (m_controlSockets[0] != INVALID_SOCKET)
+      closesocket(m_controlSockets[0]);
+   if (m_controlSockets[1] != INVALID_SOCKET)
+      closesocket(m_controlSockets[1]);
+   delete m_requests;
+   delete m_timers;
+   MemFree(m_receiveBuffer);
+}
+
+/**
+ * Create sockets and start worker thread
+ */
+uint32_t SNMP_AsyncEngine::start()
+{
+   if (m_workerThread != INVALID_THREAD_HANDLE)
+      return SNMP_ERR_SUCCESS;
+
+   for(int i = 0; i < m_numSockets; i++)
+   {
+      m_sockets[i] = CreateEngineSocket(AF_INET);
+      if (m_sockets[i] == INVALID_SOCKET)
+         return SNMP_ERR_SOCKET;
+#ifdef WITH_IPV6
+      m_sockets6[i] = CreateEngineSocket(AF_INET6);  // IPv6 may not be available, it is not an error
+#endif
+   }
+
+#ifdef _WIN32
+   m_controlSockets[0] = CreateSocket(AF_INET, SOCK_DGRAM, 0);
+   m_controlSockets[1] = CreateSocket(AF_INET, SOCK_DGRAM, 0);
+   if ((m_controlSockets[0] == INVALID_SOCKET) || (m_controlSockets[1] == INVALID_SOCKET))
+      return SNMP_ERR_SOCKET;
+
+   struct sockaddr_in servAddr;
+   memset(&servAddr, 0, sizeof(struct sockaddr_in));
+   servAddr.sin_family = AF_INET;
+   servAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+   servAddr.sin_port = 0;  // Dynamic port assignment
+   if (bind(m_controlSockets[0], (struct sockaddr *)&servAddr, sizeof(struct sockaddr_in)) != 0)
+      return SNMP_ERR_SOCKET;
+   int len = sizeof(struct sockaddr_in);
+   if (getsockname(m_controlSockets[0], (struct sockaddr *)&servAddr, &len) != 0)
+      return SNMP_ERR_SOCKET;
+   connect(m_controlSockets[1], (struct sockaddr *)&servAddr, sizeof(struct sockaddr_in));
+#else
+   if (pipe(m_controlSockets) != 0)
+   {
+      m_controlSockets[0] = INVALID_SOCKET;
+      m_controlSockets[1] = INVALID_SOCKET;
+      return SNMP_ERR_SOCKET;
+   }
+#endif
+
+   m_shutdown = false;
+   m_workerThread = ThreadCreateEx(this, &SNMP_AsyncEngine::workerThread);
+   return (m_workerThread != INVALID_THREAD_HANDLE) ? SNMP_ERR_SUCCESS : SNMP_ERR_COMM;
+}
+
+/**
+ * Stop worker thread. All pending requests will be completed with SNMP_ERR_ABORTED.
+ */
+void SNMP_AsyncEngine::shutdown()
+{
+   if (m_workerThread == INVALID_THREAD_HANDLE)
+      return;
+
+   m_mutex.lock();
+   m_shutdown = true;
+   m_mutex.unlock();
+   notifyWorkerThread();
+   ThreadJoin(m_workerThread);
+   m_workerThread = INVALID_THREAD_HANDLE;
+}
+
+/**
+ * Wake up worker thread
+ */
+void SNMP_AsyncEngine::notifyWorkerThread()
+{
+   if (m_controlSockets[1] == INVALID_SOCKET)
+      return;
+
+   char command = 'W';
+#ifdef _WIN32
+   send(m_controlSockets[1], &command, 1, 0);
+#else
+   write(m_controlSockets[1], &command, 1);
+#endif
+}
+
+/**
+ * Move timer at given index to correct position in timer heap (engine lock must be held)
+ */
+void SNMP_AsyncEngine::updateTimer(int index)
+{
+   SNMP_AsyncRequest *request = m_timers->get(index);
+
+   // Sift up
+   while(index > 0)
+   {
+      int parent = (index - 1) / 2;
+      SNMP_AsyncRequest *p = m_timers->get(parent);
+      if (p->deadline <= request->deadline)
+         break;
+      m_timers->set(index, p);
+      p->timerIndex = index;
+      index = parent;
+   }
+
+   // Sift down
+   int size = m_timers->size();
+   while(true)
+   {
+      int child = index * 2 + 1;
+      if (child >= size)
+         break;
+      if ((child + 1 < size) && (m_timers->get(child + 1)->deadline < m_timers->get(child)->deadline))
+         child++;
+      SNMP_AsyncRequest *c = m_timers->get(child);
+      if (request->deadline <= c->deadline)
+         break;
+      m_timers->set(index, c);
+      c->timerIndex = index;
+      index = child;
+   }
+
+   m_timers->set(index, request);
+   request->timerIndex = index;
+}
+
+/**
+ * Add request to timer heap (engine lock must be held)
+ */
+void SNMP_AsyncEngine::addTimer(SNMP_AsyncRequest *request)
+{
+   m_timers->add(request);
+   updateTimer(m_timers->size() - 1);
+}
+
+/**
+ * Remove request from timer heap (engine lock must be held)
+ */
+void SNMP_AsyncEngine::removeTimer(SNMP_AsyncRequest *request)
+{
+   int index = request->timerIndex;
+   int last = m_timers->size() - 1;
+   if (index != last)
+   {
+      m_timers->set(index, m_timers->get(last));
+      m_timers->shrinkTo(last);
+      updateTimer(index);
+   }
+   else
+   {
+      m_timers->shrinkTo(last);
+   }
+   request->timerIndex = -1;
+}
+
+/**
+ * Send request. Request PDU is encoded immediately and can be destroyed by caller after this call.
+ * Request ID and message ID in PDU will be replaced by engine. Completion callback will be called
+ * only if this method returns SNMP_ERR_SUCCESS. Response PDU passed to callback (only if request was
+ * successful) should be destroyed by callback.
+ */
+uint32_t SNMP_AsyncEngine::sendRequest(const InetAddress& addr, uint16_t port, SNMP_PDU *request, const SNMP_SecurityContext *securityContext,
+         void (*callback)(uint32_t, SNMP_PDU*, void*), void *context, uint32_t timeout, int numRetries)
+{
+   if ((request == nullptr) || (callback == nullptr) || (numRetries <= 0))
+      return SNMP_ERR_PARAM;
+
+   if (!addr.isValid())
+      return SNMP_ERR_HOSTNAME;
+
+   if ((request->getVersion() == SNMP_VERSION_3) && ((securityContext == nullptr) || (securityContext->getAuthoritativeEngine().getIdLen() == 0)))
+      return SNMP_ERR_ENGINE_ID;
+
+   if (m_workerThread == INVALID_THREAD_HANDLE)
+      return SNMP_ERR_COMM;
+
+   uint32_t id = SnmpNewRequestId();
+   SOCKET s;
+#ifdef WITH_IPV6
+   s = (addr.getFamily() == AF_INET) ? m_sockets[id % m_numSockets] : m_sockets6[id % m_numSockets];
+#else
+   s = (addr.getFamily() == AF_INET) ? m_sockets[id % m_numSockets] : INVALID_SOCKET;
+#endif
+   if (s == INVALID_SOCKET)
+      return SNMP_ERR_SOCKET;
+
+   SNMP_AsyncRequest *r = new SNMP_AsyncRequest();
+   r->id = id;
+   r->addr = addr;
+   addr.fillSockAddr(&r->peer, port);
+   r->socket = s;
+   r->securityContext = (securityContext != nullptr) ? new SNMP_SecurityContext(securityContext) : new SNMP_SecurityContext();
+   request->setRequestId(id);
+   request->setMessageId(id);
+   r->data = nullptr;
+   r->size = request->encode(&r->data, r->securityContext);
+   if (r->size == 0)
+   {
+      delete r;
+      return SNMP_ERR_PARAM;
+   }
+   r->timeout = (timeout != 0) ? timeout : SnmpGetDefaultTimeout();
+   r->retries = numRetries - 1;
+   r->callback = callback;
+   r->context = context;
+
+   m_mutex.lock();
+   if (m_shutdown)
+   {
+      m_mutex.unlock();
+      delete r;
+      return SNMP_ERR_ABORTED;
+   }
+
+   if (sendto(s, reinterpret_cast<char*>(r->data), static_cast<int>(r->size), 0, reinterpret_cast<struct sockaddr*>(&r->peer),
+            SA_LEN(reinterpret_cast<struct sockaddr*>(&r->peer))) <= 0)
+   {
+      m_mutex.unlock();
+      delete r;
+      return SNMP_ERR_COMM;
+   }
+
+   r->deadline = GetCurrentTimeMs() + r->timeout;
+   m_requests->set(id, r);
+   addTimer(r);
+
+   // Wake up worker thread only if it will sleep past new request's deadline
+   bool notify = (r->deadline < m_wakeupTime);
+   if (notify)
+      m_wakeupTime = r->deadline;
+   m_mutex.unlock();
+
+   if (notify)
+      notifyWorkerThread();
+   return SNMP_ERR_SUCCESS;
+}
+
+/**
+ * Context for synchronous request
+ */
+struct SyncRequestContext
+{
+   Condition completed;
+   uint32_t rc;
+   SNMP_PDU *response;
+
+   SyncRequestContext() : completed(false)
+   {
+      rc = SNMP_ERR_COMM;
+      response = nullptr;
+   }
+};
+
+/**
+ * Completion callback for synchronous request
+ */
+static void SyncRequestCallback(uint32_t rc, SNMP_PDU *response, SyncRequestContext *context)
+{
+   context->rc = rc;
+   context->response = response;
+   context->completed.set();
+}
+
+/**
+ * Send request and wait for response (blocking wrapper for sendRequest)
+ */
+uint32_t SNMP_AsyncEngine::doRequest(const InetAddress& addr, uint16_t port, SNMP_PDU *request, SNMP_PDU **response,
+         const SNMP_SecurityContext *securityContext, uint32_t timeout, int numRetries)
+{
+   if (response == nullptr)
+      return SNMP_ERR_PARAM;
+
+   *response = nullptr;
+   SyncRequestContext context;
+   uint32_t rc = sendRequest(addr, port, request, securityContext, SyncRequestCallback, &context, timeout, numRetries);
+   if (rc != SNMP_ERR_SUCCESS)
+      return rc;
+
+   context.completed.wait(INFINITE);
+   *response = context.response;
+   return context.rc;
+}
+
+/**
+ * Get number of requests waiting for response
+ */
+int SNMP_AsyncEngine::getPendingRequestCount()
+{
+   m_mutex.lock();
+   int count = m_requests->size();
+   m_mutex.unlock();
+   return count;
+}
+
+/**
+ * Complete request and destroy request object
+ */
+void SNMP_AsyncEngine::complete(SNMP_AsyncRequest *request, uint32_t rc, SNMP_PDU *response)
+{
+   if (rc != SNMP_ERR_SUCCESS)
+      delete_and_null(response);
+   request->callback(rc, response, request->context);
+   delete request;
+}
+
+/**
+ * Process received message
+ */
+void SNMP_AsyncEngine::processMessage(const BYTE *data, size_t size, const InetAddress& sender)
+{
+   uint32_t id;
+   if (!PeekMessageId(data, size, &id))
+      return;
+
+   // Requests are only removed by worker thread, so request object is safe to use after unlock
+   m_mutex.lock();
+   SNMP_AsyncRequest *request = m_requests->get(id);
+   m_mutex.unlock();
+   if ((request == nullptr) || !request->addr.equals(sender))
+   {
+      nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 7, _T("SNMP_AsyncEngine: unexpected message with ID %u"), id);
+      return;
+   }
+
+   SNMP_PDU *response = new SNMP_PDU();
+   if (!response->parse(data, size, request->securityContext, false))
+   {
+      // Ignore malformed message, request still can be completed by retransmission
+      delete response;
+      return;
+   }
+
+   uint32_t rc;
+   if (response->getCommand() == SNMP_REPORT)
+      rc = SnmpErrorCodeFromReport(response);
+   else if (response->getCommand() != SNMP_RESPONSE)
+      rc = SNMP_ERR_BAD_RESPONSE;
+   else if ((response->getVersion() != SNMP_VERSION_3) && (response->getRequestId() != id))
+      rc = SNMP_ERR_BAD_RESPONSE;
+   else
+      rc = SNMP_ERR_SUCCESS;
+
+   m_mutex.lock();
+   m_requests->unlink(id);
+   removeTimer(request);
+   m_mutex.unlock();
+
+   complete(request, rc, response);
+}
+
+/**
+ * Read all available messages from socket
+ */
+void SNMP_AsyncEngine::receiveMessages(SOCKET s)
+{
+   for(int i = 0; i < MAX_DATAGRAMS_PER_ITERATION; i++)
+   {
+      SockAddrBuffer sender;
+      socklen_t addrLen = sizeof(sender);
+      int bytes = recvfrom(s, reinterpret_cast<char*>(m_receiveBuffer), static_cast<int>(SNMP_DEFAULT_MSG_MAX_SIZE), 0,
+               reinterpret_cast<struct sockaddr*>(&sender), &addrLen);
+      if (bytes <= 0)
+         break;
+      processMessage(m_receiveBuffer, bytes, InetAddress::createFromSockaddr(reinterpret_cast<struct sockaddr*>(&sender)));
+   }
+}
+
+/**
+ * Retransmit or complete timed out requests
+ */
+void SNMP_AsyncEngine::processTimeouts()
+{
+   ObjectArray<SNMP_AsyncRequest> expired(0, 64, Ownership::False);
+
+   m_mutex.lock();
+   int64_t now = GetCurrentTimeMs();
+   while((m_timers->size() > 0) && (m_timers->get(0)->deadline <= now))
+   {
+      SNMP_AsyncRequest *request = m_timers->get(0);
+      if (request->retries > 0)
+      {
+         request->retries--;
+         request->deadline = now + request->timeout;
+         updateTimer(0);
+         sendto(request->socket, reinterpret_cast<char*>(request->data), static_cast<int>(request->size), 0,
+                  reinterpret_cast<struct sockaddr*>(&request->peer), SA_LEN(reinterpret_cast<struct sockaddr*>(&request->peer)));
+      }
+      else
+      {
+         removeTimer(request);
+         m_requests->unlink(request->id);
+         expired.add(request);
+      }
+   }
+   m_mutex.unlock();
+
+   for(int i = 0; i < expired.size(); i++)
+      complete(expired.get(i), SNMP_ERR_TIMEOUT, nullptr);
+}
+
+/**
+ * Worker thread
+ */
+void SNMP_AsyncEngine::workerThread()
+{
+   SocketPoller sp;
+   while(true)
+   {
+      m_mutex.lock();
+      if (m_shutdown)
+      {
+         m_mutex.unlock();
+         break;
+      }
+      int64_t now = GetCurrentTimeMs();
+      uint32_t waitTime = (m_timers->size() > 0) ? static_cast<uint32_t>(std::max(m_timers->get(0)->deadline - now, static_cast<int64_t>(0))) : 60000;
+      m_wakeupTime = now + waitTime;
+      m_mutex.unlock();
+
+      sp.reset();
+      sp.add(m_controlSockets[0]);
+      for(int i = 0; i < m_numSockets; i++)
+      {
+         sp.add(m_sockets[i]);
+#ifdef WITH_IPV6
+         if (m_sockets6[i] != INVALID_SOCKET)
+            sp.add(m_sockets6[i]);
+#endif
+      }
+
+      if (sp.poll(waitTime) > 0)
+      {
+         if (sp.isSet(m_controlSockets[0]))
+         {
+            char data[256];
+#ifdef _WIN32
+            recv(m_controlSockets[0], data, sizeof(data), 0);
+#else
+            read(m_controlSockets[0], data, sizeof(data));
+#endif
+         }
+         for(int i = 0; i < m_numSockets; i++)
+         {
+            if (sp.isSet(m_sockets[i]))
+               receiveMessages(m_sockets[i]);
+#ifdef WITH_IPV6
+            if ((m_sockets6[i] != INVALID_SOCKET) && sp.isSet(m_sockets6[i]))
+               receiveMessages(m_sockets6[i]);
+#endif
+         }
+      }
+
+      processTimeouts();
+   }
+
+   // Abort all pending requests
+   m_mutex.lock();
+   ObjectArray<SNMP_AsyncRequest> pending(m_timers->size(), 16, Ownership::False);
+   for(int i = 0; i < m_timers->size(); i++)
+      pending.add(m_timers->get(i));
+   m_timers->clear();
+   m_requests->clear();
+   m_mutex.unlock();
+
+   for(int i = 0; i < pending.size(); i++)
+      complete(pending.get(i), SNMP_ERR_ABORTED, nullptr);
+}
+
+/**
+ * Create transport adapter for asynchronous engine
+ */
+SNMP_AsyncTransport::SNMP_AsyncTransport(SNMP_AsyncEngine *engine, const InetAddress& addr, uint16_t port) :
+         m_peerAddr(addr), m_mutex(MutexType::FAST), m_completed(true)
+{
+   m_engine = engine;
+   m_port = port;
+   m_rc = SNMP_ERR_SUCCESS;
+   m_response = nullptr;
+   m_completed.set();
+}
+
+/**
+ * Destroy transport adapter. Waits for completion of outstanding request because engine holds pointer to this object.
+ */
+SNMP_AsyncTransport::~SNMP_AsyncTransport()
+{
+   m_completed.wait(INFINITE);
+   delete m_response;
+}
+
+/**
+ * Completion callback for requests sent via transport adapter
+ */
+void SNMP_AsyncTransport::requestCompletionCallback(uint32_t rc, SNMP_PDU *response, SNMP_AsyncTransport *transport)
+{
+   transport->m_mutex.lock();
+   transport->m_rc = rc;
+   transport->m_response = response;
+   transport->m_mutex.unlock();
+   transport->m_completed.set();
+}
+
+/**
+ * Send request via engine. Engine handles timeout for this request, retransmissions are done by caller.
+ */
+int SNMP_AsyncTransport::sendMessage(SNMP_PDU *pdu, uint32_t timeout)
+{
+   // Only one request can be outstanding, previous one could be left by caller that gave up waiting
+   m_completed.wait(INFINITE);
+
+   m_mutex.lock();
+   delete_and_null(m_response);
+   m_completed.reset();
+   m_mutex.unlock();
+
+   uint32_t rc = m_engine->sendRequest(m_peerAddr, m_port, pdu, m_securityContext, requestCompletionCallback, this,
+            (timeout != INFINITE) ? timeout : 0, 1);
+   if (rc != SNMP_ERR_SUCCESS)
+   {
+      m_mutex.lock();
+      m_rc = rc;
+      m_mutex.unlock();
+      m_completed.set();
+      return -1;
+   }
+   return 1;
+}
+
+/**
+ * Read response for last sent request. Returns 0 on timeout and -1 on any other error. Engine always completes
+ * request within its timeout, so waiting here is bounded by request timeout.
+ */
+int SNMP_AsyncTransport::readMessage(SNMP_PDU **pdu, uint32_t timeout, struct sockaddr *sender, socklen_t *addrSize,
+         SNMP_SecurityContext* (*contextFinder)(struct sockaddr *, socklen_t))
+{
+   m_completed.wait(INFINITE);
+
+   m_mutex.lock();
+   *pdu = m_response;
+   m_response = nullptr;
+   uint32_t rc = m_rc;
+   m_mutex.unlock();
+
+   if (*pdu == nullptr)
+      return ((rc == SNMP_ERR_TIMEOUT) || (rc == SNMP_ERR_SUCCESS)) ? 0 : -1;
+
+   if ((sender != nullptr) && (addrSize != nullptr))
+   {
+      SockAddrBuffer peer;
+      m_peerAddr.fillSockAddr(&peer, m_port);
+      socklen_t size = SA_LEN(reinterpret_cast<struct sockaddr*>(&peer));
+      memcpy(sender, &peer, std::min(size, *addrSize));
+      *addrSize = size;
+   }
+   return 1;
+}
+
+/**
+ * Get peer IP address
+ */
+InetAddress SNMP_AsyncTransport::getPeerIpAddress()
+{
+   return m_peerAddr;
+}
+
+/**
+ * Get port number
+ */
+uint16_t SNMP_AsyncTransport::getPort()
+{
+   return m_port;
+}
+
+/**
+ * Check if this transport is a proxy transport
+ */
+bool SNMP_AsyncTransport::isProxyTransport()
+{
+   return false;
+}
@@ -140,4 +140,6 @@ bool BER_DecodeIdentifier(const BYTE *rawData, size_t rawSize, uint32_t *type, s
 bool BER_DecodeContent(uint32_t type, const BYTE *data, size_t length, BYTE *buffer);
 size_t BER_Encode(uint32_t type, const BYTE *data, size_t dataLength, BYTE *buffer, size_t bufferSize);
 
+uint32_t SnmpErrorCodeFromReport(SNMP_PDU *report);
+
 #endif   /* _libnxsnmp_h_ */
@@ -44,6 +44,24 @@ static struct
 	{ { 0 }, 0, 0 }
 };
 
+/**
+ * Get error code from SNMPv3 REPORT PDU
+ */
+uint32_t SnmpErrorCodeFromReport(SNMP_PDU *report)
+{
+   SNMP_Variable *var = report->getVariable(0);
+   if (var == nullptr)
+      return SNMP_ERR_AGENT;
+
+   const SNMP_ObjectId& oid = var->getName();
+   for(int i = 0; s_oidToErrorMap[i].oidLen != 0; i++)
+   {
+      if (oid.compare(s_oidToErrorMap[i].oid, s_oidToErrorMap[i].oidLen) == OID_EQUAL)
+         return s_oidToErrorMap[i].errorCode;
+   }
+   return SNMP_ERR_AGENT;
+}
+
 /**
  * Create new SNMP transport.
  */
@@ -186,20 +204,7 @@ uint32_t SNMP_Transport::doRequest(SNMP_PDU *request, SNMP_PDU **response, uint3
 
                   if ((*response)->getCommand() == SNMP_REPORT)
                   {
-                     rc = SNMP_ERR_AGENT;
-                     SNMP_Variable *var = (*response)->getVariable(0);
-                     if (var != nullptr)
-                     {
-                        const SNMP_ObjectId& oid = var->getName();
-                        for(int i = 0; s_oidToErrorMap[i].oidLen != 0; i++)
-                        {
-                           if (oid.compare(s_oidToErrorMap[i].oid, s_oidToErrorMap[i].oidLen) == OID_EQUAL)
-                           {
-                              rc = s_oidToErrorMap[i].errorCode;
-                              break;
-                           }
-                        }
-                     }
+                     rc = SnmpErrorCodeFromReport(*response);
 
                      // Engine ID discovery - if request contains empty engine ID,
                      // replace it with correct one and retry
@@ -56,6 +56,91 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpGetDefaultTimeout()
    return s_snmpTimeout;
 }
 
+/**
+ * Max-repetitions limit for GETBULK requests used by SnmpWalk (0 to use GETNEXT requests only)
+ */
+static uint32_t s_walkMaxRepetitions = 32;
+
+/**
+ * Set max-repetitions limit for GETBULK requests used by SnmpWalk. Setting it to 0 will
+ * disable GETBULK requests.
+ */
+void LIBNXSNMP_EXPORTABLE SnmpSetWalkMaxRepetitions(uint32_t maxRepetitions)
+{
+   s_walkMaxRepetitions = maxRepetitions;
+}
+
+/**
+ * Get max-repetitions limit for GETBULK requests used by SnmpWalk
+ */
+uint32_t LIBNXSNMP_EXPORTABLE SnmpGetWalkMaxRepetitions()
+{
+   return s_walkMaxRepetitions;
+}
+
+/**
+ * Time after which agents without GETBULK support are checked again (in seconds)
+ */
+#define BULK_UNSUPPORTED_RECHECK_INTERVAL 3600
+
+/**
+ * Key for cache of agents without GETBULK support
+ */
+struct BulkWalkPeerKey
+{
+   BYTE address[18];
+   uint16_t port;
+};
+
+/**
+ * Agents known to not support GETBULK requests (value is time when agent should be checked again)
+ */
+static HashMap<BulkWalkPeerKey, time_t> s_bulkUnsupportedPeers(Ownership::True);
+static Mutex s_bulkUnsupportedPeersLock(MutexType::FAST);
+
+/**
+ * Build cache key for given transport
+ */
+static inline BulkWalkPeerKey BulkWalkPeerKeyFromTransport(SNMP_Transport *transport)
+{
+   BulkWalkPeerKey key;
+   memset(&key, 0, sizeof(key));
+   transport->getPeerIpAddress().buildHashKey(key.address);
+   key.port = transport->getPort();
+   return key;
+}
+
+/**
+ * Check if agent behind given transport is known to not support GETBULK requests
+ */
+static bool IsBulkWalkUnsupported(SNMP_Transport *transport)
+{
+   BulkWalkPeerKey key = BulkWalkPeerKeyFromTransport(transport);
+   bool unsupported = false;
+   s_bulkUnsupportedPeersLock.lock();
+   time_t *recheckTime = s_bulkUnsupportedPeers.get(key);
+   if (recheckTime != nullptr)
+   {
+      if (*recheckTime > time(nullptr))
+         unsupported = true;
+      else
+         s_bulkUnsupportedPeers.remove(key);
+   }
+   s_bulkUnsupportedPeersLock.unlock();
+   return unsupported;
+}
+
+/**
+ * Remember that agent behind given transport does not support GETBULK requests
+ */
+static void SetBulkWalkUnsupported(SNMP_Transport *transport)
+{
+   BulkWalkPeerKey key = BulkWalkPeerKeyFromTransport(transport);
+   s_bulkUnsupportedPeersLock.lock();
+   s_bulkUnsupportedPeers.set(key, new time_t(time(nullptr) + BULK_UNSUPPORTED_RECHECK_INTERVAL));
+   s_bulkUnsupportedPeersLock.unlock();
+}
+
 /**
  * Get value for SNMP variable
  * If szOidStr is not NULL, string representation of OID is used, otherwise -
@@ -279,7 +364,135 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const TCHAR *r
 }
 
 /**
- * Enumerate multiple values by walking through MIB, starting at given root
+ * Reason for falling back from GETBULK to GETNEXT requests
+ */
+enum class BulkWalkFallback
+{
+   NONE,          // Walk completed, failed after processing some variables, or failed for reason unrelated to GETBULK support
+   UNSUPPORTED,   // Agent rejected first GETBULK request with genErr or badValue
+   NO_RESPONSE    // Agent did not respond to first GETBULK request
+};
+
+/**
+ * Walk MIB using GETBULK requests. Number of repetitions is adjusted to number of variables
+ * agent actually returns and reduced on tooBig errors. Sets fallback reason if walk should be
+ * repeated with GETNEXT requests (first GETBULK request was rejected with genErr or badValue or
+ * was not answered, and no variables were processed yet). Other errors (communication, authentication,
+ * access errors, etc.) are returned as is because they are not related to GETBULK support.
+ */
+static uint32_t BulkWalk(SNMP_Transport *transport, const uint32_t *rootOid, size_t rootOidLen,
+         uint32_t (* handler)(SNMP_Variable *, SNMP_Transport *, void *), void *context, bool failOnShutdown, BulkWalkFallback *fallback)
+{
+   uint32_t name[MAX_OID_LEN];
+   memcpy(name, rootOid, rootOidLen * sizeof(uint32_t));
+   size_t nameLength = rootOidLen;
+
+   uint32_t firstObjectName[MAX_OID_LEN];
+   size_t firstObjectNameLen = 0;
+
+   uint32_t limit = s_walkMaxRepetitions;
+   uint32_t maxRepetitions = std::min(limit, static_cast<uint32_t>(8));
+   uint32_t result = SNMP_ERR_SUCCESS;
+   bool running = true;
+   while(running)
+   {
+      if (failOnShutdown && IsShutdownInProgress())
+      {
+         result = SNMP_ERR_ABORTED;
+         break;
+      }
+
+      SNMP_PDU request(SNMP_GET_BULK_REQUEST, SnmpNewRequestId(), transport->getSnmpVersion());
+      request.setBulkParameters(0, maxRepetitions);
+      request.bindVariable(new SNMP_Variable(name, nameLength));
+      SNMP_PDU *response;
+      result = transport->doRequest(&request, &response, s_snmpTimeout, 3);
+      if (result != SNMP_ERR_SUCCESS)
+      {
+         nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 7, _T("Error %u processing SNMP GETBULK request"), result);
+         if ((firstObjectNameLen == 0) && (result == SNMP_ERR_TIMEOUT))
+            *fallback = BulkWalkFallback::NO_RESPONSE;
+         break;
+      }
+
+      if (response->getErrorCode() == SNMP_PDU_ERR_TOO_BIG)
+      {
+         delete response;
+         if (maxRepetitions > 1)
+         {
+            maxRepetitions /= 2;
+            limit = maxRepetitions;
+            continue;
+         }
+         result = SNMP_ERR_AGENT;
+         break;
+      }
+
+      if (response->getErrorCode() != SNMP_PDU_ERR_SUCCESS)
+      {
+         // Some SNMP agents sends NO_SUCH_NAME PDU error after last element in MIB
+         if (response->getErrorCode() != SNMP_PDU_ERR_NO_SUCH_NAME)
+         {
+            result = SNMP_ERR_AGENT;
+            if ((firstObjectNameLen == 0) &&
+                ((response->getErrorCode() == SNMP_PDU_ERR_GENERIC) || (response->getErrorCode() == SNMP_PDU_ERR_BAD_VALUE)))
+               *fallback = BulkWalkFallback::UNSUPPORTED;
+         }
+         delete response;
+         break;
+      }
+
+      int count = response->getNumVariables();
+      if (count == 0)
+         running = false;
+      for(int i = 0; (i < count) && running; i++)
+      {
+         SNMP_Variable *var = response->getVariable(i);
+         if ((var->getType() == ASN_NO_SUCH_OBJECT) || (var->getType() == ASN_NO_SUCH_INSTANCE) || (var->getType() == ASN_END_OF_MIBVIEW))
+         {
+            // Consider no object/no instance as end of walk signal instead of failure
+            running = false;
+            break;
+         }
+
+         // Stop walking when leaving root subtree or if agent starts returning same objects
+         if ((var->getName().length() < rootOidLen) ||
+             memcmp(rootOid, var->getName().value(), rootOidLen * sizeof(uint32_t)) ||
+             (var->getName().compare(name, nameLength) == OID_EQUAL) ||
+             (var->getName().compare(firstObjectName, firstObjectNameLen) == OID_EQUAL))
+         {
+            running = false;
+            break;
+         }
+         nameLength = var->getName().length();
+         memcpy(name, var->getName().value(), nameLength * sizeof(uint32_t));
+         if (firstObjectNameLen == 0)
+         {
+            firstObjectNameLen = nameLength;
+            memcpy(firstObjectName, name, nameLength * sizeof(uint32_t));
+         }
+
+         result = handler(var, transport, context);
+         if (result != SNMP_ERR_SUCCESS)
+            running = false;
+      }
+      delete response;
+
+      if (running)
+      {
+         // Agent may return less variables than requested to fit response into its buffer
+         if (static_cast<uint32_t>(count) < maxRepetitions)
+            maxRepetitions = count;
+         else
+            maxRepetitions = std::min(maxRepetitions * 2, limit);
+      }
+   }
+   return result;
+}
+
+/**
+ * Enumerate multiple values by walking through MIB, starting at given root.
+ * GETBULK requests are used for SNMP version 2c and 3 unless disabled or agent is known to not support them.
  */
 uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const uint32_t *rootOid, size_t rootOidLen,
          uint32_t (* handler)(SNMP_Variable *, SNMP_Transport *, void *), void *context, bool logErrors, bool failOnShutdown)
@@ -287,6 +500,30 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const uint32_t
 	if (transport == nullptr)
 		return SNMP_ERR_COMM;
 
+   if ((transport->getSnmpVersion() != SNMP_VERSION_1) && (s_walkMaxRepetitions > 0) && !IsBulkWalkUnsupported(transport))
+   {
+      BulkWalkFallback fallback = BulkWalkFallback::NONE;
+      uint32_t rc = BulkWalk(transport, rootOid, rootOidLen, handler, context, failOnShutdown, &fallback);
+      if (fallback == BulkWalkFallback::NONE)
+         return rc;
+
+      if (fallback == BulkWalkFallback::NO_RESPONSE)
+      {
+         // Agent may silently drop GETBULK requests, but most likely it is just unreachable -
+         // check with single GETNEXT request before doing full walk with all retries
+         SNMP_PDU request(SNMP_GET_NEXT_REQUEST, SnmpNewRequestId(), transport->getSnmpVersion());
+         request.bindVariable(new SNMP_Variable(rootOid, rootOidLen));
+         SNMP_PDU *response;
+         uint32_t probeResult = transport->doRequest(&request, &response, s_snmpTimeout, 1);
+         if (probeResult != SNMP_ERR_SUCCESS)
+            return rc;
+         delete response;
+      }
+
+      nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 7, _T("SnmpWalk: GETBULK request failed (error %u), falling back to GETNEXT"), rc);
+      SetBulkWalkUnsupported(transport);
+   }
+
 	// First OID to request
 	uint32_t pdwName[MAX_OID_LEN];
    memcpy(pdwName, rootOid, rootOidLen * sizeof(UINT32));
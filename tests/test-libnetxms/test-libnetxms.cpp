@@ -15,6 +15,7 @@ void TestGauge64();
 void TestMemoryPool();
 void TestObjectMemoryPool();
 void TestThreadPool();
+void TestWorkStealingThreadPool();
 void TestQueue();
 void TestSharedObjectQueue();
 void TestMsgWaitQueue();
@@ -2165,6 +2166,7 @@ int main(int argc, char *argv[])
    TestSubProcess(argv[0], debug);
    TestThreadPool();
    TestThreadCountAndMaxWaitTime();
+   TestWorkStealingThreadPool();
 
    return 0;
 }
@@ -92,3 +92,149 @@ void TestThreadCountAndMaxWaitTime()
    ThreadPoolDestroy(threadPool);
    EndTest();
 }
+
+/**
+ * Context for thread pool throughput tests
+ */
+struct ThroughputTestContext
+{
+   ThreadPool *pool;
+   VolatileCounter remaining;
+   Condition completed;
+   int fanout;
+   int lastValue[64];
+   bool orderViolation;
+
+   ThroughputTestContext(ThreadPool *p, int count) : completed(true)
+   {
+      pool = p;
+      remaining = count;
+      fanout = 0;
+      memset(lastValue, 0, sizeof(lastValue));
+      orderViolation = false;
+   }
+};
+
+static ThroughputTestContext *s_throughputTestContext;
+
+static void CountingWorkload(void *arg)
+{
+   if (InterlockedDecrement(&s_throughputTestContext->remaining) == 0)
+      s_throughputTestContext->completed.set();
+}
+
+static void FanoutWorkload(void *arg)
+{
+   for(int i = 0; i < s_throughputTestContext->fanout; i++)
+      ThreadPoolExecute(s_throughputTestContext->pool, CountingWorkload, nullptr);
+   CountingWorkload(arg);
+}
+
+static void SerializedWorkload(void *arg)
+{
+   int key = static_cast<int>(CAST_FROM_POINTER(arg, uint32_t) >> 16);
+   int value = static_cast<int>(CAST_FROM_POINTER(arg, uint32_t) & 0xFFFF);
+   if (s_throughputTestContext->lastValue[key] != value - 1)
+      s_throughputTestContext->orderViolation = true;
+   s_throughputTestContext->lastValue[key] = value;
+   CountingWorkload(arg);
+}
+
+/**
+ * Run thread pool throughput tests in given mode
+ */
+static void RunThreadPoolThroughputTests(const TCHAR *mode, bool workStealing, int64_t *results)
+{
+   TCHAR name[128];
+   ThreadPool *p = ThreadPoolCreate(_T("PERF"), 8, 8, 0, workStealing);
+
+   const int externalCount = 500000;
+   _sntprintf(name, 128, _T("Thread pool throughput (%s) - external submit"), mode);
+   StartTest(name);
+   ThroughputTestContext context1(p, externalCount);
+   s_throughputTestContext = &context1;
+   int64_t startTime = GetCurrentTimeMs();
+   for(int i = 0; i < externalCount; i++)
+      ThreadPoolExecute(p, CountingWorkload, nullptr);
+   AssertTrue(context1.completed.wait(60000));
+   results[0] = GetCurrentTimeMs() - startTime;
+   EndTest(results[0]);
+
+   const int roots = 64, fanout = 8000;
+   _sntprintf(name, 128, _T("Thread pool throughput (%s) - worker submit"), mode);
+   StartTest(name);
+   ThroughputTestContext context2(p, roots * (fanout + 1));
+   context2.fanout = fanout;
+   s_throughputTestContext = &context2;
+   startTime = GetCurrentTimeMs();
+   for(int i = 0; i < roots; i++)
+      ThreadPoolExecute(p, FanoutWorkload, nullptr);
+   AssertTrue(context2.completed.wait(60000));
+   results[1] = GetCurrentTimeMs() - startTime;
+   EndTest(results[1]);
+
+   const int keys = 64, tasksPerKey = 2000;
+   _sntprintf(name, 128, _T("Thread pool throughput (%s) - serialized"), mode);
+   StartTest(name);
+   ThroughputTestContext context3(p, keys * tasksPerKey);
+   s_throughputTestContext = &context3;
+   startTime = GetCurrentTimeMs();
+   for(int i = 1; i <= tasksPerKey; i++)
+   {
+      for(int k = 0; k < keys; k++)
+      {
+         TCHAR key[16];
+         _sntprintf(key, 16, _T("K%d"), k);
+         ThreadPoolExecuteSerialized(p, key, SerializedWorkload, CAST_TO_POINTER((k << 16) | i, void*));
+      }
+   }
+   AssertTrue(context3.completed.wait(60000));
+   results[2] = GetCurrentTimeMs() - startTime;
+   AssertFalse(context3.orderViolation);
+   EndTest(results[2]);
+
+   ThreadPoolInfo info;
+   ThreadPoolGetInfo(p, &info);
+   AssertEquals(info.totalRequests, static_cast<uint64_t>(externalCount + roots * (fanout + 1) + keys * tasksPerKey));
+   ThreadPoolDestroy(p);
+}
+
+/**
+ * Test thread pool in work stealing mode and compare its throughput with shared queue mode
+ */
+void TestWorkStealingThreadPool()
+{
+   StartTest(_T("Work stealing thread pool - create"));
+   ThreadPool *p = ThreadPoolCreate(_T("TEST-WS"), 4, 32, 0, true);
+   AssertNotNull(p);
+   ThreadPoolInfo info;
+   ThreadPoolGetInfo(p, &info);
+   AssertEquals(info.curThreads, 4);
+   AssertEquals(info.minThreads, 4);
+   AssertEquals(info.maxThreads, 32);
+   EndTest();
+
+   StartTest(_T("Work stealing thread pool - high load"));
+   for(int i = 0; i < 40; i++)
+   {
+      ThreadPoolExecute(p, SlowWorkload, NULL);
+   }
+   ThreadSleepMs(2000);
+   ThreadPoolGetInfo(p, &info);
+   AssertTrue(info.activeRequests > 0);
+   AssertEquals(info.totalRequests, 40);
+   AssertTrue(info.averageWaitTime > 0);
+   EndTest();
+
+   StartTest(_T("Work stealing thread pool - destroy"));
+   ThreadPoolDestroy(p);
+   EndTest();
+
+   int64_t sharedQueueResults[3], workStealingResults[3];
+   RunThreadPoolThroughputTests(_T("shared queue"), false, sharedQueueResults);
+   RunThreadPoolThroughputTests(_T("work stealing"), true, workStealingResults);
+   _tprintf(_T("      Speedup: external submit %0.2f, worker submit %0.2f, serialized %0.2f\n"),
+            static_cast<double>(sharedQueueResults[0]) / std::max(workStealingResults[0], static_cast<int64_t>(1)),
+            static_cast<double>(sharedQueueResults[1]) / std::max(workStealingResults[1], static_cast<int64_t>(1)),
+            static_cast<double>(sharedQueueResults[2]) / std::max(workStealingResults[2], static_cast<int64_t>(1)));
+}
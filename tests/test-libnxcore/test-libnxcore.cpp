@@ -0,0 +1,1022 @@
+#include <nms_core.h>
+#include <testtools.h>
+#include <netxms-version.h>
+
+/**
+ * Number of elements used in index tests
+ */
+#define INDEX_TEST_SIZE    20000
+
+/**
+ * Duration of concurrent index access test (milliseconds)
+ */
+#define INDEX_CONCURRENCY_TEST_TIME    2000
+
+/**
+ * Number of reader threads in concurrent index access test
+ */
+#define INDEX_READER_THREADS  4
+
+/**
+ * Number of index versions that can be pinned by readers (should match INDEX_VERSION_COUNT in index.cpp)
+ */
+#define INDEX_VERSION_COUNT   8
+
+/**
+ * Index test element
+ */
+struct IndexTestElement
+{
+   uint64_t key;
+};
+
+/**
+ * Baseline index implementation (copy-on-write sorted arrays with primary and secondary copy) used by
+ * object indexes before B+ tree implementation. Used only as reference for performance comparison.
+ */
+class BaselineIndex
+{
+private:
+   struct Element
+   {
+      uint64_t key;
+      void *object;
+   };
+
+   struct Head
+   {
+      Element *elements;
+      size_t size;
+      size_t allocated;
+      uint64_t maxKey;
+      VolatileCounter readers;
+      VolatileCounter writers;
+   };
+
+   Head* volatile m_primary;
+   Head *m_secondary;
+   Mutex m_writerLock;
+
+   static int compare(const void *e1, const void *e2)
+   {
+      return (static_cast<const Element*>(e1)->key < static_cast<const Element*>(e2)->key) ? -1 :
+               ((static_cast<const Element*>(e1)->key > static_cast<const Element*>(e2)->key) ? 1 : 0);
+   }
+
+   static ssize_t findElement(Head *index, uint64_t key)
+   {
+      if (index->size == 0)
+         return -1;
+
+      size_t first = 0;
+      size_t last = index->size - 1;
+      if ((key < index->elements[0].key) || (key > index->elements[last].key))
+         return -1;
+
+      while(first < last)
+      {
+         size_t mid = (first + last) / 2;
+         if (key == index->elements[mid].key)
+            return mid;
+         if (key < index->elements[mid].key)
+            last = mid - 1;
+         else
+            first = mid + 1;
+      }
+      return (key == index->elements[last].key) ? last : -1;
+   }
+
+   void swapAndWait()
+   {
+      m_secondary = InterlockedExchangeObjectPointer(&m_primary, m_secondary);
+      InterlockedIncrement(&m_secondary->writers);
+      while(m_secondary->readers > 0)
+         ThreadSleepMs(10);
+   }
+
+   Head *acquireIndex() const
+   {
+      Head *h;
+      while(true)
+      {
+         h = m_primary;
+         InterlockedIncrement(&h->readers);
+         if (h->writers == 0)
+            break;
+         InterlockedDecrement(&h->readers);
+      }
+      return h;
+   }
+
+public:
+   BaselineIndex() : m_writerLock(MutexType::FAST)
+   {
+      m_primary = MemAllocStruct<Head>();
+      m_secondary = MemAllocStruct<Head>();
+   }
+
+   ~BaselineIndex()
+   {
+      MemFree(m_primary->elements);
+      MemFree(m_primary);
+      MemFree(m_secondary->elements);
+      MemFree(m_secondary);
+   }
+
+   bool put(uint64_t key, IndexTestElement *object)
+   {
+      bool replace = false;
+
+      m_writerLock.lock();
+
+      ssize_t pos = findElement(m_secondary, key);
+      if (pos != -1)
+      {
+         m_secondary->elements[pos].object = object;
+         replace = true;
+      }
+      else
+      {
+         if (m_secondary->size == m_secondary->allocated)
+         {
+            m_secondary->allocated += 1024;
+            m_secondary->elements = MemReallocArray<Element>(m_secondary->elements, m_secondary->allocated);
+         }
+         m_secondary->elements[m_secondary->size].key = key;
+         m_secondary->elements[m_secondary->size].object = object;
+         m_secondary->size++;
+         if (key < m_secondary->maxKey)
+            qsort(m_secondary->elements, m_secondary->size, sizeof(Element), compare);
+         else
+            m_secondary->maxKey = key;
+      }
+
+      swapAndWait();
+
+      if (replace)
+      {
+         m_secondary->elements[pos].object = object;
+      }
+      else
+      {
+         if (m_primary->allocated > m_secondary->allocated)
+         {
+            m_secondary->allocated = m_primary->allocated;
+            m_secondary->elements = MemReallocArray<Element>(m_secondary->elements, m_secondary->allocated);
+         }
+         m_secondary->size = m_primary->size;
+         if (key < m_secondary->maxKey)
+         {
+            memcpy(m_secondary->elements, m_primary->elements, m_secondary->size * sizeof(Element));
+         }
+         else
+         {
+            m_secondary->maxKey = key;
+            m_secondary->elements[m_secondary->size - 1].key = key;
+            m_secondary->elements[m_secondary->size - 1].object = object;
+         }
+      }
+
+      InterlockedDecrement(&m_secondary->writers);
+
+      m_writerLock.unlock();
+      return replace;
+   }
+
+   void remove(uint64_t key)
+   {
+      m_writerLock.lock();
+
+      ssize_t pos = findElement(m_secondary, key);
+      if (pos != -1)
+      {
+         m_secondary->size--;
+         memmove(&m_secondary->elements[pos], &m_secondary->elements[pos + 1], sizeof(Element) * (m_secondary->size - pos));
+         if (m_secondary->maxKey == key)
+            m_secondary->maxKey = (m_secondary->size > 0) ? m_secondary->elements[m_secondary->size - 1].key : 0;
+
+         swapAndWait();
+
+         m_secondary->size--;
+         memmove(&m_secondary->elements[pos], &m_secondary->elements[pos + 1], sizeof(Element) * (m_secondary->size - pos));
+         if (m_secondary->maxKey == key)
+            m_secondary->maxKey = (m_secondary->size > 0) ? m_secondary->elements[m_secondary->size - 1].key : 0;
+
+         InterlockedDecrement(&m_secondary->writers);
+      }
+
+      m_writerLock.unlock();
+   }
+
+   IndexTestElement *get(uint64_t key) const
+   {
+      Head *index = acquireIndex();
+      ssize_t pos = findElement(index, key);
+      void *object = (pos == -1) ? nullptr : index->elements[pos].object;
+      InterlockedDecrement(&index->readers);
+      return static_cast<IndexTestElement*>(object);
+   }
+};
+
+/**
+ * Index with access to reader pinning for tests
+ */
+class PinnableIndex : public AbstractIndex<IndexTestElement>
+{
+public:
+   PinnableIndex() : AbstractIndex<IndexTestElement>(Ownership::False) { }
+
+   INDEX_HEAD *pin() const { return acquireIndex(); }
+   void unpin(INDEX_HEAD *h) const { releaseIndex(h); }
+};
+
+/**
+ * Reader context for concurrent index access test
+ */
+template<typename I> struct IndexReaderContext
+{
+   I *index;
+   volatile bool *running;
+   uint32_t seed;
+   uint64_t reads;
+   uint32_t errors;
+};
+
+/**
+ * Index reader thread for concurrent access test
+ */
+template<typename I> static void IndexReaderThread(IndexReaderContext<I> *context)
+{
+   uint32_t seed = context->seed;
+   while(*context->running)
+   {
+      seed = seed * 1103515245 + 12345;
+      uint64_t key = (seed >> 8) % INDEX_TEST_SIZE + 1;
+      IndexTestElement *e = context->index->get(key);
+      if ((e != nullptr) && (e->key != key))
+         context->errors++;
+      context->reads++;
+   }
+}
+
+/**
+ * Create shuffled array of keys 1..INDEX_TEST_SIZE
+ */
+static uint64_t *CreateShuffledKeys()
+{
+   uint64_t *keys = MemAllocArrayNoInit<uint64_t>(INDEX_TEST_SIZE);
+   for(int i = 0; i < INDEX_TEST_SIZE; i++)
+      keys[i] = i + 1;
+   uint32_t seed = 42;
+   for(int i = INDEX_TEST_SIZE - 1; i > 0; i--)
+   {
+      seed = seed * 1103515245 + 12345;
+      int j = (seed >> 8) % (i + 1);
+      std::swap(keys[i], keys[j]);
+   }
+   return keys;
+}
+
+/**
+ * Run index performance benchmark (random inserts and concurrent readers with single writer)
+ */
+template<typename I> static void BenchmarkIndex(I *index, const TCHAR *name, IndexTestElement *elements, const uint64_t *keys)
+{
+   TCHAR testName[128];
+   _sntprintf(testName, 128, _T("%s - random inserts"), name);
+   StartTest(testName);
+   int64_t startTime = GetCurrentTimeMs();
+   for(int i = 0; i < INDEX_TEST_SIZE; i++)
+      AssertFalse(index->put(keys[i], &elements[keys[i]]));
+   EndTest(GetCurrentTimeMs() - startTime);
+
+   for(int i = 0; i < INDEX_TEST_SIZE; i += 2)
+      index->remove(keys[i]);
+
+   _sntprintf(testName, 128, _T("%s - concurrent access"), name);
+   StartTest(testName);
+   volatile bool running = true;
+   IndexReaderContext<I> readerContext[INDEX_READER_THREADS];
+   THREAD readers[INDEX_READER_THREADS];
+   for(int i = 0; i < INDEX_READER_THREADS; i++)
+   {
+      readerContext[i].index = index;
+      readerContext[i].running = &running;
+      readerContext[i].seed = i * 7919 + 1;
+      readerContext[i].reads = 0;
+      readerContext[i].errors = 0;
+      readers[i] = ThreadCreateEx(IndexReaderThread<I>, &readerContext[i]);
+   }
+
+   uint64_t writes = 0;
+   uint32_t seed = 17;
+   startTime = GetCurrentTimeMs();
+   while(GetCurrentTimeMs() - startTime < INDEX_CONCURRENCY_TEST_TIME)
+   {
+      seed = seed * 1103515245 + 12345;
+      uint64_t key = (seed >> 8) % INDEX_TEST_SIZE + 1;
+      if (index->get(key) != nullptr)
+         index->remove(key);
+      else
+         index->put(key, &elements[key]);
+      writes++;
+   }
+   int64_t elapsed = GetCurrentTimeMs() - startTime;
+   running = false;
+   uint64_t reads = 0;
+   for(int i = 0; i < INDEX_READER_THREADS; i++)
+   {
+      ThreadJoin(readers[i]);
+      AssertEquals(readerContext[i].errors, 0);
+      reads += readerContext[i].reads;
+   }
+   _tprintf(_T("(") UINT64_FMT _T(" writes/sec, ") UINT64_FMT _T(" reads/sec) "),
+            writes * 1000 / static_cast<uint64_t>(elapsed), reads * 1000 / static_cast<uint64_t>(elapsed));
+   EndTest(elapsed);
+}
+
+/**
+ * Release pinned index version after delay
+ */
+static void DelayedUnpin(PinnableIndex *index, INDEX_HEAD *version)
+{
+   ThreadSleepMs(200);
+   index->unpin(version);
+}
+
+/**
+ * Test object index
+ */
+static void TestIndex()
+{
+   IndexTestElement *elements = MemAllocArrayNoInit<IndexTestElement>(INDEX_TEST_SIZE + 1);
+   for(int i = 0; i <= INDEX_TEST_SIZE; i++)
+      elements[i].key = i;
+   uint64_t *keys = CreateShuffledKeys();
+
+   AbstractIndex<IndexTestElement> index(Ownership::False);
+
+   StartTest(_T("Index - put"));
+   for(int i = 0; i < INDEX_TEST_SIZE; i++)
+      AssertFalse(index.put(keys[i], &elements[keys[i]]));
+   AssertEquals(index.size(), static_cast<size_t>(INDEX_TEST_SIZE));
+   EndTest();
+
+   StartTest(_T("Index - get"));
+   for(int i = 1; i <= INDEX_TEST_SIZE; i++)
+   {
+      IndexTestElement *e = index.get(i);
+      AssertNotNull(e);
+      AssertEquals(e->key, static_cast<uint64_t>(i));
+   }
+   AssertNull(index.get(0));
+   AssertNull(index.get(INDEX_TEST_SIZE + 1));
+   EndTest();
+
+   StartTest(_T("Index - keys"));
+   IntegerArray<uint64_t> indexKeys = index.keys();
+   AssertEquals(indexKeys.size(), INDEX_TEST_SIZE);
+   for(int i = 0; i < indexKeys.size(); i++)
+      AssertEquals(indexKeys.get(i), static_cast<uint64_t>(i + 1));
+   EndTest();
+
+   StartTest(_T("Index - replace"));
+   AssertTrue(index.put(100, &elements[100]));
+   AssertEquals(index.size(), static_cast<size_t>(INDEX_TEST_SIZE));
+   EndTest();
+
+   StartTest(_T("Index - remove"));
+   for(int i = 1; i <= INDEX_TEST_SIZE; i += 2)
+      index.remove(i);
+   AssertEquals(index.size(), static_cast<size_t>(INDEX_TEST_SIZE / 2));
+   for(int i = 1; i <= INDEX_TEST_SIZE; i++)
+   {
+      if (i % 2 == 1)
+         AssertNull(index.get(i));
+      else
+         AssertNotNull(index.get(i));
+   }
+   EndTest();
+
+   StartTest(_T("Index - clear"));
+   index.clear();
+   AssertEquals(index.size(), static_cast<size_t>(0));
+   AssertNull(index.get(2));
+   EndTest();
+
+   StartTest(_T("Index - writer blocked by pinned versions"));
+   PinnableIndex pinnable;
+   INDEX_HEAD *pinned[INDEX_VERSION_COUNT];
+   pinned[0] = pinnable.pin();
+   for(int i = 1; i < INDEX_VERSION_COUNT; i++)
+   {
+      pinnable.put(i, &elements[i]);
+      pinned[i] = pinnable.pin();
+   }
+   THREAD unpinThread = ThreadCreateEx(DelayedUnpin, &pinnable, pinned[0]);
+   int64_t startTime = GetCurrentTimeMs();
+   pinnable.put(INDEX_VERSION_COUNT, &elements[INDEX_VERSION_COUNT]);  // Should wait until first version is released
+   int64_t elapsed = GetCurrentTimeMs() - startTime;
+   ThreadJoin(unpinThread);
+   AssertTrue(elapsed >= 100);
+   AssertEquals(pinnable.size(), static_cast<size_t>(INDEX_VERSION_COUNT));
+   for(int i = 1; i < INDEX_VERSION_COUNT; i++)
+      pinnable.unpin(pinned[i]);
+   AssertNotNull(pinnable.get(INDEX_VERSION_COUNT));
+   EndTest(elapsed);
+
+   AbstractIndex<IndexTestElement> benchmarkIndex(Ownership::False);
+   BenchmarkIndex(&benchmarkIndex, _T("Index (B+ tree)"), elements, keys);
+   benchmarkIndex.clear();
+
+   BaselineIndex baselineIndex;
+   BenchmarkIndex(&baselineIndex, _T("Index (sorted array baseline)"), elements, keys);
+
+   MemFree(keys);
+   MemFree(elements);
+}
+
+/**
+ * Test bucket aggregation used for server-side aggregation of DCI data
+ */
+static void TestBucketAggregator()
+{
+   StartTest(_T("BucketAggregator"));
+
+   // 10 buckets for range 0 - 99 plus partial bucket at the end
+   BucketAggregator aggregator(0, 100, 10);
+   aggregator.addSample(-1, 1000, 1000, 1000, 1);  // before range start, should be ignored
+   for(int t = 0; t < 100; t++)
+      aggregator.addSample(t, t, t, t, 1);
+   aggregator.addSample(200, 1000, 1000, 1000, 1); // after range end, should be ignored
+
+   StructArray<AggregatedDataPoint> points;
+   aggregator.getResults(DAM_AVERAGE, &points);
+   AssertEquals(points.size(), 10);
+   AssertEquals(points.get(0)->timestamp, 5);
+   AssertEquals(points.get(0)->value, 4.5);
+   AssertEquals(points.get(9)->timestamp, 95);
+   AssertEquals(points.get(9)->value, 94.5);
+
+   points.clear();
+   aggregator.getResults(DAM_MIN, &points);
+   AssertEquals(points.size(), 10);
+   AssertEquals(points.get(3)->value, 30.0);
+
+   points.clear();
+   aggregator.getResults(DAM_MAX, &points);
+   AssertEquals(points.size(), 10);
+   AssertEquals(points.get(3)->value, 39.0);
+
+   // Two points (minimum and maximum) with same timestamp for each non-empty bucket
+   points.clear();
+   aggregator.getResults(DAM_MIN_MAX, &points);
+   AssertEquals(points.size(), 20);
+   for(int i = 0; i < 10; i++)
+   {
+      AssertEquals(points.get(i * 2)->timestamp, static_cast<time_t>(i * 10 + 5));
+      AssertEquals(points.get(i * 2 + 1)->timestamp, static_cast<time_t>(i * 10 + 5));
+      AssertEquals(points.get(i * 2)->value, static_cast<double>(i * 10));
+      AssertEquals(points.get(i * 2 + 1)->value, static_cast<double>(i * 10 + 9));
+   }
+
+   // Pre-aggregated samples (from rollup tables) and empty buckets
+   BucketAggregator rollupAggregator(0, 60, 20);
+   rollupAggregator.addSample(0, 1, 5, 12, 4);
+   rollupAggregator.addSample(10, 0, 7, 8, 4);
+   rollupAggregator.addSample(45, 3, 3, 3, 1);
+   points.clear();
+   rollupAggregator.getResults(DAM_AVERAGE, &points);
+   AssertEquals(points.size(), 2);
+   AssertEquals(points.get(0)->value, 2.5);
+   AssertEquals(points.get(1)->timestamp, 50);
+   AssertEquals(points.get(1)->value, 3.0);
+
+   points.clear();
+   rollupAggregator.getResults(DAM_MIN_MAX, &points);
+   AssertEquals(points.size(), 4);
+   AssertEquals(points.get(0)->value, 0.0);
+   AssertEquals(points.get(1)->value, 7.0);
+
+   EndTest();
+}
+
+/**
+ * Test collection and LTTB downsampling of DCI data points
+ */
+static void TestPointCollector()
+{
+   StartTest(_T("PointCollector"));
+
+   // Flat line with single spike that should survive downsampling
+   PointCollector collector;
+   for(int t = 0; t < 1000; t++)
+      collector.addSample(t, 0, 0, (t == 500) ? 100 : 0, 1);
+   AssertEquals(collector.size(), 1000);
+
+   StructArray<AggregatedDataPoint> points;
+   collector.getResults(2000, &points);
+   AssertEquals(points.size(), 1000);
+
+   points.clear();
+   collector.getResults(50, &points);
+   AssertEquals(points.size(), 50);
+   AssertEquals(points.get(0)->timestamp, 0);
+   AssertEquals(points.get(49)->timestamp, 999);
+   bool spikeFound = false;
+   for(int i = 0; i < points.size(); i++)
+   {
+      if (i > 0)
+         AssertTrue(points.get(i)->timestamp > points.get(i - 1)->timestamp);
+      if (points.get(i)->value == 100)
+         spikeFound = true;
+   }
+   AssertTrue(spikeFound);
+
+   // Threshold too small for LTTB
+   points.clear();
+   collector.getResults(0, &points);
+   AssertEquals(points.size(), 0);
+
+   points.clear();
+   collector.getResults(1, &points);
+   AssertEquals(points.size(), 1);
+   AssertEquals(points.get(0)->timestamp, 0);
+
+   points.clear();
+   collector.getResults(2, &points);
+   AssertEquals(points.size(), 2);
+   AssertEquals(points.get(0)->timestamp, 0);
+   AssertEquals(points.get(1)->timestamp, 999);
+
+   points.clear();
+   collector.getResults(3, &points);
+   AssertEquals(points.size(), 3);
+   AssertEquals(points.get(1)->value, 100.0);
+
+   // Pre-aggregated samples are collected as average values
+   PointCollector rollupCollector;
+   rollupCollector.addSample(0, 1, 5, 12, 4);
+   points.clear();
+   rollupCollector.getResults(10, &points);
+   AssertEquals(points.size(), 1);
+   AssertEquals(points.get(0)->value, 3.0);
+
+   // Collected points are halved by merging adjacent ones when limit is reached
+   PointCollector limitedCollector(100);
+   for(int t = 0; t < 250; t++)
+      limitedCollector.addSample(t, t, t, t, 1);
+   AssertEquals(limitedCollector.size(), 100);
+   points.clear();
+   limitedCollector.getResults(100, &points);
+   AssertEquals(points.size(), 100);
+   AssertEquals(points.get(0)->timestamp, 0);
+   AssertEquals(points.get(0)->value, 3.5);
+   AssertEquals(points.get(99)->timestamp, 249);
+   AssertEquals(points.get(99)->value, 249.0);
+   for(int i = 1; i < points.size(); i++)
+      AssertTrue(points.get(i)->timestamp > points.get(i - 1)->timestamp);
+
+   EndTest();
+}
+
+/**
+ * Alarm stub for alarm list tests
+ */
+class TestAlarm
+{
+public:
+   uint32_t id;
+   uint32_t parentId;
+   uint32_t sourceObject;
+   uint32_t dciId;
+   TCHAR key[64];
+   int removedSubordinates;
+
+   TestAlarm(uint32_t _id, uint32_t _sourceObject, uint32_t _dciId, const TCHAR *_key, uint32_t _parentId = 0)
+   {
+      id = _id;
+      parentId = _parentId;
+      sourceObject = _sourceObject;
+      dciId = _dciId;
+      _tcslcpy(key, _key, 64);
+      removedSubordinates = 0;
+   }
+
+   uint32_t getAlarmId() const { return id; }
+   uint32_t getParentAlarmId() const { return parentId; }
+   uint32_t getSourceObject() const { return sourceObject; }
+   uint32_t getDciId() const { return dciId; }
+   const TCHAR *getKey() const { return key; }
+   BYTE getState() const { return ALARM_STATE_OUTSTANDING; }
+   BYTE getCurrentSeverity() const { return SEVERITY_MAJOR; }
+   uint64_t getMemoryUsage() const { return sizeof(TestAlarm); }
+   void removeSubordinateAlarm(uint32_t alarmId) { removedSubordinates++; }
+};
+
+/**
+ * Check that every alarm in the list can be found by ID at its current position
+ */
+static void CheckAlarmListConsistency(const AlarmList<TestAlarm>& list)
+{
+   for(int i = 0; i < list.size(); i++)
+   {
+      TestAlarm *alarm = list.get(i);
+      AssertTrue(list.find(alarm->id) == alarm);
+      ObjectArray<TestAlarm> alarms(16, 16, Ownership::False);
+      list.getObjectAlarms(alarm->sourceObject, &alarms);
+      AssertTrue(alarms.contains(alarm));
+      if (alarm->dciId != 0)
+      {
+         alarms.clear();
+         list.getDCIAlarms(alarm->dciId, &alarms);
+         AssertTrue(alarms.contains(alarm));
+      }
+   }
+}
+
+/**
+ * Test alarm list indexes
+ */
+static void TestAlarmList()
+{
+   StartTest(_T("Alarm list indexes"));
+
+   AlarmList<TestAlarm> list;
+
+   // Create
+   TestAlarm *a1 = new TestAlarm(1, 10, 100, _T("K1"));
+   TestAlarm *a2 = new TestAlarm(2, 10, 0, _T("K2"));
+   TestAlarm *a3 = new TestAlarm(3, 20, 100, _T("K1"), 2);
+   TestAlarm *a4 = new TestAlarm(4, 30, 0, _T(""));
+   list.add(a1);
+   list.add(a2);
+   list.add(a3);
+   list.add(a4);
+   AssertEquals(list.size(), 4);
+   CheckAlarmListConsistency(list);
+   AssertTrue(list.find(_T("K1")) == a1);
+   AssertTrue(list.find(_T("K2")) == a2);
+   AssertNull(list.find(_T("K3")));
+   ObjectArray<TestAlarm> alarms(16, 16, Ownership::False);
+   list.getObjectAlarms(10, &alarms);
+   AssertEquals(alarms.size(), 2);
+   alarms.clear();
+   list.getDCIAlarms(100, &alarms);
+   AssertEquals(alarms.size(), 2);
+   AssertTrue(list.hasObjectAlarms(30));
+   AssertEquals(list.getMostCriticalStatus(30), SEVERITY_MAJOR);
+   AssertEquals(list.getMostCriticalStatus(40), STATUS_UNKNOWN);
+
+   // Update source object and DCI
+   a2->sourceObject = 20;
+   a2->dciId = 200;
+   list.updateIndexes(a2, 10, 0);
+   CheckAlarmListConsistency(list);
+   alarms.clear();
+   list.getObjectAlarms(10, &alarms);
+   AssertEquals(alarms.size(), 1);
+   AssertTrue(alarms.get(0) == a1);
+   alarms.clear();
+   list.getObjectAlarms(20, &alarms);
+   AssertEquals(alarms.size(), 2);
+   alarms.clear();
+   list.getDCIAlarms(200, &alarms);
+   AssertEquals(alarms.size(), 1);
+
+   // Terminate first alarm - last alarm is moved to its position
+   list.remove(a1);
+   AssertEquals(list.size(), 3);
+   CheckAlarmListConsistency(list);
+   AssertNull(list.find(1));
+   AssertFalse(list.hasObjectAlarms(10));
+   AssertTrue(list.find(_T("K1")) == a3);   // alarm with duplicate key takes over key index
+   alarms.clear();
+   list.getDCIAlarms(100, &alarms);
+   AssertEquals(alarms.size(), 1);
+   AssertTrue(alarms.get(0) == a3);
+
+   // Lookup by non-unique attribute should not depend on list order
+   AssertTrue(list.get(0) == a4);
+   AssertTrue(list.findFirst([] (TestAlarm *a) -> bool { return a->sourceObject != 0; }) == a2);
+   AssertTrue(list.findFirst([] (TestAlarm *a) -> bool { return a->sourceObject == 20; }) == a2);
+   AssertNull(list.findFirst([] (TestAlarm *a) -> bool { return a->sourceObject == 10; }));
+
+   // Terminate subordinate alarm
+   list.remove(a3);
+   AssertEquals(list.size(), 2);
+   CheckAlarmListConsistency(list);
+   AssertEquals(a2->removedSubordinates, 1);
+   AssertNull(list.find(_T("K1")));
+   AssertFalse(list.hasObjectAlarms(0));
+   alarms.clear();
+   list.getDCIAlarms(100, &alarms);
+   AssertEquals(alarms.size(), 0);
+
+   // Terminate remaining alarms by position
+   list.remove(1);
+   list.remove(0);
+   AssertEquals(list.size(), 0);
+   AssertNull(list.find(2));
+   AssertNull(list.find(4));
+   AssertNull(list.find(_T("K2")));
+   AssertFalse(list.hasObjectAlarms(20));
+   AssertFalse(list.hasObjectAlarms(30));
+
+   EndTest();
+}
+
+/**
+ * Object stub for ancestor index tests
+ */
+class TestObject : public NObject
+{
+public:
+   TestObject(uint32_t id) : NObject()
+   {
+      m_id = id;
+      _sntprintf(m_name, MAX_OBJECT_NAME, _T("TestObject%u"), id);
+   }
+
+   /**
+    * Check if given object is a parent of this object by walking parent lists
+    */
+   bool isParentBruteForce(uint32_t id) const
+   {
+      if (m_id == id)
+         return true;
+
+      bool found = false;
+      readLockParentList();
+      const SharedObjectArray<NObject>& parents = getParentList();
+      for(int i = 0; (i < parents.size()) && !found; i++)
+         found = static_cast<TestObject*>(parents.get(i))->isParentBruteForce(id);
+      unlockParentList();
+      return found;
+   }
+};
+
+/**
+ * Number of objects in ancestor index test
+ */
+#define ANCESTOR_TEST_SIZE 64
+
+/**
+ * Base ID for objects in ancestor index test
+ */
+#define ANCESTOR_TEST_BASE_ID 100000
+
+/**
+ * Link objects in ancestor index test
+ */
+static void LinkTestObjects(const shared_ptr<TestObject>& parent, const shared_ptr<TestObject>& child)
+{
+   parent->addChild(child);
+   child->addParent(parent);
+}
+
+/**
+ * Unlink objects in ancestor index test
+ */
+static void UnlinkTestObjects(const shared_ptr<TestObject>& parent, const shared_ptr<TestObject>& child)
+{
+   parent->deleteChild(child->getId());
+   child->deleteParent(parent->getId());
+}
+
+/**
+ * Check isParent/isChild for all object pairs against parent list walk
+ */
+static void CheckAncestorIndex(const SharedObjectArray<TestObject>& objects)
+{
+   for(int i = 0; i < objects.size(); i++)
+   {
+      TestObject *object = objects.get(i);
+      for(int j = 0; j < objects.size(); j++)
+      {
+         TestObject *other = objects.get(j);
+         bool expected = object->isParentBruteForce(other->getId());
+         AssertEquals(object->isParent(other->getId()), expected);
+         AssertEquals(other->isChild(object->getId()), expected);
+      }
+   }
+}
+
+/**
+ * Test object ancestor index
+ */
+static void TestAncestorIndex()
+{
+   SharedObjectArray<TestObject> objects(ANCESTOR_TEST_SIZE, 16);
+   for(int i = 0; i < ANCESTOR_TEST_SIZE; i++)
+      objects.add(make_shared<TestObject>(ANCESTOR_TEST_BASE_ID + i));
+   auto o = [&objects] (int index) -> shared_ptr<TestObject> { return objects.getShared(index); };
+
+   StartTest(_T("Object ancestor index - build"));
+   // Subtree is built first and attached to the root later, so index updates have to be propagated down
+   LinkTestObjects(o(4), o(5));
+   LinkTestObjects(o(5), o(6));
+   LinkTestObjects(o(5), o(8));
+   LinkTestObjects(o(2), o(4));
+   LinkTestObjects(o(3), o(4));   // Diamond 2,3 -> 4
+   LinkTestObjects(o(3), o(7));
+   LinkTestObjects(o(7), o(8));   // 8 is reachable through 5 and 7
+   LinkTestObjects(o(1), o(2));
+   LinkTestObjects(o(1), o(3));
+   AssertTrue(o(8)->isParent(o(1)->getId()));
+   AssertTrue(o(1)->isChild(o(6)->getId()));
+   AssertFalse(o(6)->isParent(o(7)->getId()));
+   AssertFalse(o(2)->isParent(o(3)->getId()));
+   CheckAncestorIndex(objects);
+   EndTest();
+
+   StartTest(_T("Object ancestor index - unlink"));
+   UnlinkTestObjects(o(2), o(4));   // 4 still reachable from root through 3
+   AssertTrue(o(6)->isParent(o(1)->getId()));
+   AssertFalse(o(6)->isParent(o(2)->getId()));
+   CheckAncestorIndex(objects);
+   UnlinkTestObjects(o(1), o(3));   // Whole subtree of 3 is detached from root
+   AssertFalse(o(8)->isParent(o(1)->getId()));
+   AssertTrue(o(8)->isParent(o(3)->getId()));
+   CheckAncestorIndex(objects);
+   EndTest();
+
+   StartTest(_T("Object ancestor index - relink"));
+   UnlinkTestObjects(o(3), o(4));
+   LinkTestObjects(o(7), o(4));   // Move subtree of 4 under 7
+   LinkTestObjects(o(1), o(3));
+   AssertTrue(o(6)->isParent(o(7)->getId()));
+   AssertTrue(o(6)->isParent(o(1)->getId()));
+   CheckAncestorIndex(objects);
+   EndTest();
+
+   StartTest(_T("Object ancestor index - random changes"));
+   // Links always go from lower to higher index, so graph stays acyclic
+   uint32_t seed = 12345;
+   auto random = [&seed] (int range) -> int { seed = seed * 1103515245 + 12345; return static_cast<int>((seed >> 16) % range); };
+   for(int round = 0; round < 20; round++)
+   {
+      for(int k = 0; k < 32; k++)
+      {
+         int p = random(ANCESTOR_TEST_SIZE - 1);
+         int c = p + 1 + random(ANCESTOR_TEST_SIZE - p - 1);
+         if (o(c)->isDirectParent(o(p)->getId()))
+            UnlinkTestObjects(o(p), o(c));
+         else
+            LinkTestObjects(o(p), o(c));
+      }
+      CheckAncestorIndex(objects);
+   }
+   EndTest();
+
+   // Break reference cycles between parents and children
+   for(int i = 0; i < objects.size(); i++)
+      for(int j = i + 1; j < objects.size(); j++)
+         if (o(j)->isDirectParent(o(i)->getId()))
+            UnlinkTestObjects(o(i), o(j));
+   for(int i = 0; i < objects.size(); i++)
+      AssertEquals(o(i)->getParentCount() + o(i)->getChildCount(), 0);
+}
+
+/**
+ * Event processing policy rule definition for dispatch tests
+ */
+struct EPPTestRule
+{
+   uint32_t flags;
+   uint32_t events[3];   // Zero-terminated list of event codes
+};
+
+#define RF_SEVERITY_ALL (RF_SEVERITY_INFO | RF_SEVERITY_WARNING | RF_SEVERITY_MINOR | RF_SEVERITY_MAJOR | RF_SEVERITY_CRITICAL)
+
+/**
+ * Rules for dispatch tests. "Any event" rules are interleaved with event specific ones.
+ */
+static EPPTestRule s_eppTestRules[] =
+{
+   { RF_SEVERITY_ALL, { 1, 0, 0 } },
+   { RF_SEVERITY_ALL, { 0, 0, 0 } },
+   { RF_SEVERITY_ALL, { 2, 1, 0 } },
+   { RF_SEVERITY_MAJOR | RF_SEVERITY_CRITICAL, { 0, 0, 0 } },
+   { RF_SEVERITY_ALL | RF_NEGATED_EVENTS, { 2, 0, 0 } },
+   { RF_SEVERITY_ALL | RF_STOP_PROCESSING, { 3, 0, 0 } },
+   { RF_SEVERITY_ALL, { 0, 0, 0 } },
+   { RF_SEVERITY_ALL | RF_DISABLED, { 1, 0, 0 } },
+   { RF_SEVERITY_WARNING | RF_STOP_PROCESSING, { 1, 4, 0 } },
+   { RF_SEVERITY_CRITICAL | RF_STOP_PROCESSING, { 0, 0, 0 } },
+   { RF_SEVERITY_ALL, { 4, 1, 1 } },
+   { RF_SEVERITY_ALL | RF_NEGATED_EVENTS, { 0, 0, 0 } },
+   { RF_SEVERITY_ALL | RF_NEGATED_EVENTS | RF_STOP_PROCESSING, { 1, 0, 0 } },
+   { RF_SEVERITY_ALL, { 0, 0, 0 } },
+   { RF_SEVERITY_ALL, { 2, 0, 0 } }
+};
+
+/**
+ * Check if rule definition matches event with given code and severity
+ */
+static bool EPPTestRuleMatch(const EPPTestRule& rule, uint32_t code, int severity)
+{
+   static uint32_t severityFlag[] = { RF_SEVERITY_INFO, RF_SEVERITY_WARNING, RF_SEVERITY_MINOR, RF_SEVERITY_MAJOR, RF_SEVERITY_CRITICAL };
+   if ((rule.flags & RF_DISABLED) || !(rule.flags & severityFlag[severity]))
+      return false;
+   if (rule.events[0] == 0)
+      return !(rule.flags & RF_NEGATED_EVENTS);
+   bool match = false;
+   for(int i = 0; (i < 3) && (rule.events[i] != 0); i++)
+      if (rule.events[i] == code)
+         match = true;
+   return (rule.flags & RF_NEGATED_EVENTS) ? !match : match;
+}
+
+/**
+ * Create event with given code and severity
+ */
+static Event *CreateTestEvent(uint32_t code, int severity)
+{
+   json_t *json = json_pack("{s:I, s:I, s:i, s:s, s:I, s:i, s:i, s:i, s:i, s:s, s:o}",
+            "id", static_cast<json_int_t>(1), "rootId", static_cast<json_int_t>(0), "code", static_cast<int>(code),
+            "name", "TEST_EVENT", "timestamp", static_cast<json_int_t>(time(nullptr)), "source", 0, "zone", 0, "dci", 0,
+            "severity", severity, "message", "", "tags", json_array());
+   Event *event = Event::createFromJson(json);
+   json_decref(json);
+   return event;
+}
+
+/**
+ * Test event processing policy dispatch index
+ */
+static void TestEventPolicyDispatch()
+{
+   StartTest(_T("Event processing policy - dispatch order"));
+
+   int ruleCount = sizeof(s_eppTestRules) / sizeof(EPPTestRule);
+   EPRule **rules = MemAllocArray<EPRule*>(ruleCount);
+   for(int i = 0; i < ruleCount; i++)
+   {
+      NXCPMessage msg;
+      msg.setField(VID_RULE_ID, i);
+      msg.setField(VID_FLAGS, s_eppTestRules[i].flags);
+      IntegerArray<uint32_t> events;
+      for(int j = 0; (j < 3) && (s_eppTestRules[i].events[j] != 0); j++)
+         events.add(s_eppTestRules[i].events[j]);
+      msg.setFieldFromInt32Array(VID_RULE_EVENTS, events);
+      rules[i] = new EPRule(msg);
+   }
+
+   EventPolicy policy;
+   policy.replacePolicy(ruleCount, rules);   // Policy takes ownership of rules
+
+   static uint32_t codes[] = { 1, 2, 3, 4, 99 };
+   for(int c = 0; c < 5; c++)
+   {
+      for(int severity = EVENT_SEVERITY_NORMAL; severity <= EVENT_SEVERITY_CRITICAL; severity++)
+      {
+         EPRuleStatistics *before = MemAllocArray<EPRuleStatistics>(ruleCount);
+         for(int i = 0; i < ruleCount; i++)
+            rules[i]->getStatistics(&before[i]);
+
+         Event *event = CreateTestEvent(codes[c], severity);
+         AssertNotNull(event);
+         policy.processEvent(event);
+         delete event;
+
+         // Linear walk over all rules gives expected set of matching rules
+         bool stopped = false;
+         for(int i = 0; i < ruleCount; i++)
+         {
+            bool expected = !stopped && EPPTestRuleMatch(s_eppTestRules[i], codes[c], severity);
+            if (expected && (s_eppTestRules[i].flags & RF_STOP_PROCESSING))
+               stopped = true;
+
+            EPRuleStatistics after;
+            rules[i]->getStatistics(&after);
+            AssertEquals(after.matches - before[i].matches, expected ? static_cast<uint64_t>(1) : static_cast<uint64_t>(0));
+
+            // Rules bound to other event codes should not be evaluated at all
+            if ((s_eppTestRules[i].events[0] != 0) && !(s_eppTestRules[i].flags & RF_NEGATED_EVENTS) && !EPPTestRuleMatch(s_eppTestRules[i], codes[c], severity))
+               AssertEquals(after.evaluations, before[i].evaluations);
+         }
+         MemFree(before);
+      }
+   }
+
+   MemFree(rules);
+   EndTest();
+}
+
+/**
+ * main()
+ */
+int main(int argc, char *argv[])
+{
+   InitNetXMSProcess(true);
+
+   TestIndex();
+   TestBucketAggregator();
+   TestPointCollector();
+   TestAlarmList();
+   TestAncestorIndex();
+   TestEventPolicyDispatch();
+
+   return 0;
+}
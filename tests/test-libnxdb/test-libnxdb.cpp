@@ -124,6 +124,35 @@ static void CommonTests(const TCHAR *prefix, const TCHAR *driver, const TCHAR *s
    AssertEquals(count, 200);
    EndTest();
 
+   /*** batch insert ***/
+   StartTest(prefix, _T("batch insert"));
+   hStmt = DBPrepareEx(session, _T("INSERT INTO nx_test (id,value1,value2_new) VALUES (?,?,?)"), true, buffer);
+   AssertNotNullEx(hStmt, buffer);
+   AssertTrue(DBBegin(session));
+   AssertTrueEx(DBOpenBatch(hStmt), _T("Call to DBOpenBatch() failed"));
+   for(int32_t i = 2001; i <= 2110; i++)
+   {
+      DBNextBatchRow(hStmt);
+      if (i == 2001)
+      {
+         DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, (int32_t)42);
+      }
+      TCHAR text[64];
+      _sntprintf(text, 64, _T("batch %d"), i);
+      DBBind(hStmt, 2, DB_SQLTYPE_VARCHAR, text, DB_BIND_TRANSIENT);
+      DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, i);
+   }
+   AssertTrueEx(DBExecuteEx(hStmt, buffer), buffer);
+   AssertTrue(DBCommit(session));
+   DBFreeStatement(hStmt);
+   hResult = DBSelectEx(session, _T("SELECT count(*),min(value2_new),max(value2_new) FROM nx_test WHERE id>2000"), buffer);
+   AssertNotNullEx(hResult, buffer);
+   AssertEquals(DBGetFieldLong(hResult, 0, 0), 110);
+   AssertEquals(DBGetFieldLong(hResult, 0, 1), 42);
+   AssertEquals(DBGetFieldLong(hResult, 0, 2), 42);
+   DBFreeResult(hResult);
+   EndTest();
+
    /*** drop test table ***/
    StartTest(prefix, _T("drop test table"));
    AssertTrue(DBQuery(session, _T("DROP TABLE nx_test")));
@@ -72,6 +72,110 @@ static void TestStop()
    EndTest();
 }
 
+/**
+ * Test performance of variable access (locals, globals, and function arguments)
+ */
+static void TestVariableAccessPerformance()
+{
+   StartTest(_T("NXSL variable access performance"));
+
+   TCHAR errorMessage[256];
+   NXSL_VM *vm = NXSLCompileAndCreateVM(
+            _T("global counter = 0;\n")
+            _T("function add(a, b) { s = a + b; counter++; return s; }\n")
+            _T("sum = 0;\n")
+            _T("for(i = 0; i < 100000; i++) sum = add(sum, i % 3);\n")
+            _T("return sum + counter;\n"),
+            errorMessage, 256, new NXSL_Environment());
+   AssertNotNull(vm);
+
+   int64_t start = GetCurrentTimeMs();
+   for(int i = 0; i < 10; i++)
+   {
+      AssertTrue(vm->run());
+      AssertNotNull(vm->getResult());
+      AssertEquals(vm->getResult()->getValueAsInt32(), 199999);
+   }
+   int64_t elapsed = GetCurrentTimeMs() - start;
+   delete vm;
+
+   EndTest(elapsed);
+}
+
+/**
+ * Test that VM reset with NXSL_VM::reset() behaves like freshly loaded one
+ */
+static void TestVMReset()
+{
+   StartTest(_T("NXSL_VM::reset"));
+
+   TCHAR errorMessage[256];
+   NXSL_Environment compileTimeEnvironment;
+   NXSL_Program *program = NXSLCompile(
+            _T("if ($x == null) return -1;\n")
+            _T("assert($x != 0);\n")
+            _T("return 100 / $x;\n"),
+            errorMessage, 256, nullptr, &compileTimeEnvironment);
+   AssertNotNull(program);
+
+   NXSL_VM *fresh = new NXSL_VM(new NXSL_Environment());
+   AssertTrue(fresh->load(program));
+   AssertTrue(fresh->run());
+   AssertNotNull(fresh->getResult());
+   int32_t expected = fresh->getResult()->getValueAsInt32();
+   AssertEquals(expected, -1);
+   delete fresh;
+
+   NXSL_VM *vm = new NXSL_VM(new NXSL_Environment());
+   AssertTrue(vm->load(program));
+
+   // Successful run with global variable and user data set
+   vm->setGlobalVariable("$x", vm->createValue(4));
+   vm->setUserData(vm);
+   AssertTrue(vm->run());
+   AssertEquals(vm->getResult()->getValueAsInt32(), 25);
+
+   AssertTrue(vm->reset());
+   AssertNull(vm->getResult());
+   AssertNull(vm->getUserData());
+   AssertNull(vm->findGlobalVariable("$x"));
+   AssertTrue(vm->run());
+   AssertNotNull(vm->getResult());
+   AssertEquals(vm->getResult()->getValueAsInt32(), expected);
+
+   // Failed run
+   AssertTrue(vm->reset());
+   vm->setGlobalVariable("$x", vm->createValue(0));
+   AssertFalse(vm->run());
+   AssertEquals(vm->getErrorCode(), NXSL_ERR_ASSERTION_FAILED);
+
+   AssertTrue(vm->reset());
+   AssertEquals(vm->getErrorCode(), NXSL_ERR_SUCCESS);
+   AssertTrue(vm->run());
+   AssertNotNull(vm->getResult());
+   AssertEquals(vm->getResult()->getValueAsInt32(), expected);
+
+   // Repeated reuse should not grow memory usage
+   AssertTrue(vm->reset());
+   uint64_t memoryUsage = vm->getMemoryUsage();
+   for(int i = 0; i < 1000; i++)
+   {
+      vm->setGlobalVariable("$x", vm->createValue(i + 1));
+      AssertTrue(vm->run());
+      AssertTrue(vm->reset());
+   }
+   AssertEquals(vm->getMemoryUsage(), memoryUsage);
+
+   // VM with additional constants cannot be reused
+   vm->addConstant("TEST", vm->createValue(1));
+   AssertFalse(vm->reset());
+
+   delete vm;
+   delete program;
+
+   EndTest();
+}
+
 /**
  * Run test NXSL script
  */
@@ -140,6 +244,8 @@ int main(int argc, char *argv[])
 
    TestCompiler();
    TestStop();
+   TestVariableAccessPerformance();
+   TestVMReset();
    RunTestScript(_T("addr.nxsl"));
    RunTestScript(_T("arrays.nxsl"));
    RunTestScript(_T("base64.nxsl"));
@@ -143,6 +143,424 @@ static void TestVariableClass()
    EndTest();
 }
 
+/**
+ * Test GETBULK request PDU encoding
+ */
+static void TestBulkRequestPDU()
+{
+   StartTest(_T("GETBULK request PDU encoding"));
+   SNMP_SecurityContext securityContext("public");
+   SNMP_PDU request(SNMP_GET_BULK_REQUEST, 42, SNMP_VERSION_2C);
+   request.setBulkParameters(0, 25);
+   request.bindVariable(new SNMP_Variable(s_oidSystem));
+   BYTE *buffer;
+   size_t size = request.encode(&buffer, &securityContext);
+   AssertTrue(size > 0);
+
+   SNMP_PDU pdu;
+   AssertTrue(pdu.parse(buffer, size, &securityContext, false));
+   AssertEquals(pdu.getCommand(), SNMP_GET_BULK_REQUEST);
+   AssertEquals(pdu.getRequestId(), 42);
+   AssertEquals(static_cast<uint32_t>(pdu.getErrorCode()), 0);
+   AssertEquals(pdu.getErrorIndex(), 25);
+   AssertEquals(pdu.getNumVariables(), 1);
+   AssertEquals(pdu.getVariable(0)->getName().compare(s_oidSystem), OID_EQUAL);
+   MemFree(buffer);
+   EndTest();
+}
+
+/**
+ * Behavior of in-process SNMP agent for walk tests
+ */
+enum class WalkTestAgentMode
+{
+   BULK_SUPPORTED,
+   BULK_REJECTED,
+   NO_ACCESS,
+   BULK_IGNORED,
+   UNREACHABLE
+};
+
+/**
+ * In-process SNMP agent for walk tests. Serves 100 objects under 1.3.6.1.4.1.57163.1 and one object
+ * outside walked subtree. GETBULK responses with more than maxResponseSize variables are rejected with tooBig error.
+ */
+class WalkTestTransport : public SNMP_Transport
+{
+private:
+   WalkTestAgentMode m_mode;
+   uint32_t m_address;
+   int m_maxResponseSize;
+   SNMP_PDU *m_response;
+   ObjectArray<SNMP_ObjectId> m_mib;
+
+   void addNextVariable(const SNMP_ObjectId& name, SNMP_PDU *response, SNMP_ObjectId *next)
+   {
+      for(int i = 0; i < m_mib.size(); i++)
+      {
+         if (m_mib.get(i)->compare(name) == OID_FOLLOWING)
+         {
+            SNMP_Variable *v = new SNMP_Variable(*m_mib.get(i));
+            v->setValueFromUInt32(ASN_INTEGER, i);
+            response->bindVariable(v);
+            *next = *m_mib.get(i);
+            return;
+         }
+      }
+      SNMP_Variable *v = new SNMP_Variable(name);
+      v->setValueFromByteArray(ASN_END_OF_MIBVIEW, nullptr, 0);
+      response->bindVariable(v);
+      *next = name;
+   }
+
+public:
+   int getRequests;
+   int bulkRequests;
+   int tooBigResponses;
+   uint32_t lastMaxRepetitions;
+
+   WalkTestTransport(WalkTestAgentMode mode, uint32_t address, int maxResponseSize = 1000) : m_mib(128, 16, Ownership::True)
+   {
+      m_mode = mode;
+      m_address = address;
+      m_maxResponseSize = maxResponseSize;
+      m_response = nullptr;
+      getRequests = 0;
+      bulkRequests = 0;
+      tooBigResponses = 0;
+      lastMaxRepetitions = 0;
+      for(uint32_t i = 1; i <= 100; i++)
+      {
+         uint32_t oid[] = { 1, 3, 6, 1, 4, 1, 57163, 1, i };
+         m_mib.add(new SNMP_ObjectId(oid, 9));
+      }
+      uint32_t oid[] = { 1, 3, 6, 1, 4, 1, 57163, 2, 0 };
+      m_mib.add(new SNMP_ObjectId(oid, 9));
+      m_snmpVersion = SNMP_VERSION_2C;
+   }
+
+   virtual ~WalkTestTransport()
+   {
+      delete m_response;
+   }
+
+   virtual int readMessage(SNMP_PDU **pdu, uint32_t timeout, struct sockaddr *sender, socklen_t *addrSize,
+            SNMP_SecurityContext* (*contextFinder)(struct sockaddr *, socklen_t)) override
+   {
+      if (m_response == nullptr)
+         return 0;   // timeout
+      *pdu = m_response;
+      m_response = nullptr;
+      return 1;
+   }
+
+   virtual int sendMessage(SNMP_PDU *request, uint32_t timeout) override
+   {
+      delete m_response;
+      m_response = nullptr;
+      if (m_mode == WalkTestAgentMode::UNREACHABLE)
+         return 1;
+
+      if (request->getCommand() == SNMP_GET_BULK_REQUEST)
+      {
+         bulkRequests++;
+         if (m_mode == WalkTestAgentMode::BULK_IGNORED)
+            return 1;
+
+         m_response = new SNMP_PDU(SNMP_RESPONSE, request->getRequestId(), request->getVersion());
+         uint32_t maxRepetitions = request->getErrorIndex();
+         lastMaxRepetitions = maxRepetitions;
+         if (m_mode == WalkTestAgentMode::BULK_REJECTED)
+         {
+            m_response->setBulkParameters(SNMP_PDU_ERR_GENERIC, 1);   // sets error status and index
+         }
+         else if (m_mode == WalkTestAgentMode::NO_ACCESS)
+         {
+            m_response->setBulkParameters(SNMP_PDU_ERR_NO_ACCESS, 1);   // sets error status and index
+         }
+         else if (maxRepetitions > static_cast<uint32_t>(m_maxResponseSize))
+         {
+            tooBigResponses++;
+            m_response->setBulkParameters(SNMP_PDU_ERR_TOO_BIG, 0);   // sets error status and index
+         }
+         else
+         {
+            SNMP_ObjectId name = request->getVariable(0)->getName();
+            for(uint32_t i = 0; i < maxRepetitions; i++)
+               addNextVariable(name, m_response, &name);
+         }
+      }
+      else if (request->getCommand() == SNMP_GET_NEXT_REQUEST)
+      {
+         getRequests++;
+         m_response = new SNMP_PDU(SNMP_RESPONSE, request->getRequestId(), request->getVersion());
+         SNMP_ObjectId next;
+         addNextVariable(request->getVariable(0)->getName(), m_response, &next);
+      }
+      return 1;
+   }
+
+   virtual InetAddress getPeerIpAddress() override { return InetAddress(m_address); }
+   virtual uint16_t getPort() override { return 161; }
+   virtual bool isProxyTransport() override { return false; }
+};
+
+/**
+ * Walk handler for walk tests - checks that objects are returned in order
+ */
+static uint32_t WalkTestHandler(SNMP_Variable *var, SNMP_Transport *transport, void *context)
+{
+   int *count = static_cast<int*>(context);
+   if (var->getName().getElement(8) != static_cast<uint32_t>(*count + 1))
+      return SNMP_ERR_BAD_RESPONSE;
+   (*count)++;
+   return SNMP_ERR_SUCCESS;
+}
+
+/**
+ * Test MIB walk with GETBULK requests and fallback to GETNEXT
+ */
+static void TestSnmpWalk()
+{
+   static uint32_t root[] = { 1, 3, 6, 1, 4, 1, 57163, 1 };
+   uint32_t timeout = SnmpGetDefaultTimeout();
+   SnmpSetDefaultTimeout(10);
+
+   StartTest(_T("SnmpWalk - GETBULK"));
+   WalkTestTransport bulkAgent(WalkTestAgentMode::BULK_SUPPORTED, 0x0A000001);
+   int count = 0;
+   AssertEquals(SnmpWalk(&bulkAgent, root, 8, WalkTestHandler, &count), SNMP_ERR_SUCCESS);
+   AssertEquals(count, 100);
+   AssertEquals(bulkAgent.getRequests, 0);
+   AssertTrue(bulkAgent.bulkRequests < 10);
+   EndTest();
+
+   StartTest(_T("SnmpWalk - GETBULK with tooBig responses"));
+   WalkTestTransport smallBufferAgent(WalkTestAgentMode::BULK_SUPPORTED, 0x0A000002, 5);
+   count = 0;
+   AssertEquals(SnmpWalk(&smallBufferAgent, root, 8, WalkTestHandler, &count), SNMP_ERR_SUCCESS);
+   AssertEquals(count, 100);
+   AssertEquals(smallBufferAgent.getRequests, 0);
+   AssertEquals(smallBufferAgent.tooBigResponses, 1);
+   AssertEquals(smallBufferAgent.lastMaxRepetitions, 4);
+   EndTest();
+
+   StartTest(_T("SnmpWalk - fallback to GETNEXT on GETBULK error"));
+   WalkTestTransport rejectingAgent(WalkTestAgentMode::BULK_REJECTED, 0x0A000003);
+   count = 0;
+   AssertEquals(SnmpWalk(&rejectingAgent, root, 8, WalkTestHandler, &count), SNMP_ERR_SUCCESS);
+   AssertEquals(count, 100);
+   AssertEquals(rejectingAgent.bulkRequests, 1);
+   count = 0;
+   AssertEquals(SnmpWalk(&rejectingAgent, root, 8, WalkTestHandler, &count), SNMP_ERR_SUCCESS);
+   AssertEquals(count, 100);
+   AssertEquals(rejectingAgent.bulkRequests, 1);   // GETBULK support should be cached
+   EndTest();
+
+   StartTest(_T("SnmpWalk - fallback to GETNEXT when GETBULK is ignored"));
+   WalkTestTransport ignoringAgent(WalkTestAgentMode::BULK_IGNORED, 0x0A000004);
+   count = 0;
+   AssertEquals(SnmpWalk(&ignoringAgent, root, 8, WalkTestHandler, &count), SNMP_ERR_SUCCESS);
+   AssertEquals(count, 100);
+   int bulkRequests = ignoringAgent.bulkRequests;
+   count = 0;
+   AssertEquals(SnmpWalk(&ignoringAgent, root, 8, WalkTestHandler, &count), SNMP_ERR_SUCCESS);
+   AssertEquals(count, 100);
+   AssertEquals(ignoringAgent.bulkRequests, bulkRequests);
+   EndTest();
+
+   StartTest(_T("SnmpWalk - access error on GETBULK"));
+   WalkTestTransport noAccessAgent(WalkTestAgentMode::NO_ACCESS, 0x0A000006);
+   count = 0;
+   AssertEquals(SnmpWalk(&noAccessAgent, root, 8, WalkTestHandler, &count), SNMP_ERR_AGENT);
+   AssertEquals(count, 0);
+   AssertEquals(noAccessAgent.bulkRequests, 1);
+   AssertEquals(noAccessAgent.getRequests, 0);
+   AssertEquals(SnmpWalk(&noAccessAgent, root, 8, WalkTestHandler, &count), SNMP_ERR_AGENT);
+   AssertEquals(noAccessAgent.bulkRequests, 2);   // access error should not be cached as missing GETBULK support
+   EndTest();
+
+   StartTest(_T("SnmpWalk - unreachable agent"));
+   WalkTestTransport unreachableAgent(WalkTestAgentMode::UNREACHABLE, 0x0A000005);
+   count = 0;
+   AssertEquals(SnmpWalk(&unreachableAgent, root, 8, WalkTestHandler, &count), SNMP_ERR_TIMEOUT);
+   AssertEquals(count, 0);
+   EndTest();
+
+   SnmpSetDefaultTimeout(timeout);
+}
+
+/**
+ * Loopback SNMP responder for asynchronous engine tests
+ */
+class TestResponder
+{
+private:
+   SOCKET m_socket;
+   THREAD m_thread;
+   bool m_stop;
+
+   void run()
+   {
+      SNMP_SecurityContext securityContext("public");
+      BYTE buffer[65536];
+      SocketPoller sp;
+      while(!m_stop)
+      {
+         sp.reset();
+         sp.add(m_socket);
+         if (sp.poll(100) <= 0)
+            continue;
+
+         SockAddrBuffer peer;
+         socklen_t addrLen = sizeof(peer);
+         int bytes = recvfrom(m_socket, reinterpret_cast<char*>(buffer), sizeof(buffer), 0, reinterpret_cast<struct sockaddr*>(&peer), &addrLen);
+         if (bytes <= 0)
+            continue;
+
+         SNMP_PDU request;
+         if (!request.parse(buffer, bytes, &securityContext, false))
+            continue;
+
+         SNMP_PDU response(SNMP_RESPONSE, request.getRequestId(), request.getVersion());
+         for(int i = 0; i < request.getNumVariables(); i++)
+         {
+            SNMP_Variable *v = new SNMP_Variable(request.getVariable(i)->getName());
+            v->setValueFromString(ASN_OCTET_STRING, _T("test"));
+            response.bindVariable(v);
+         }
+         BYTE *data;
+         size_t size = response.encode(&data, &securityContext);
+         if (size > 0)
+         {
+            sendto(m_socket, reinterpret_cast<char*>(data), static_cast<int>(size), 0, reinterpret_cast<struct sockaddr*>(&peer), addrLen);
+            MemFree(data);
+         }
+      }
+   }
+
+public:
+   TestResponder()
+   {
+      m_socket = CreateSocket(AF_INET, SOCK_DGRAM, 0);
+      struct sockaddr_in addr;
+      memset(&addr, 0, sizeof(addr));
+      addr.sin_family = AF_INET;
+      addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      bind(m_socket, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+      int bufferSize = 4 * 1024 * 1024;
+      setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<char*>(&bufferSize), sizeof(bufferSize));
+      m_stop = false;
+      m_thread = ThreadCreateEx(this, &TestResponder::run);
+   }
+
+   ~TestResponder()
+   {
+      m_stop = true;
+      ThreadJoin(m_thread);
+      closesocket(m_socket);
+   }
+
+   uint16_t getPort()
+   {
+      struct sockaddr_in addr;
+      socklen_t len = sizeof(addr);
+      getsockname(m_socket, reinterpret_cast<struct sockaddr*>(&addr), &len);
+      return ntohs(addr.sin_port);
+   }
+};
+
+/**
+ * Context for asynchronous engine test
+ */
+struct AsyncTestContext
+{
+   VolatileCounter completed;
+   VolatileCounter failed;
+   int total;
+   Condition done;
+
+   AsyncTestContext(int t) : done(true)
+   {
+      completed = 0;
+      failed = 0;
+      total = t;
+   }
+};
+
+/**
+ * Completion callback for asynchronous engine test
+ */
+static void AsyncTestCallback(uint32_t rc, SNMP_PDU *response, AsyncTestContext *context)
+{
+   if ((rc != SNMP_ERR_SUCCESS) || (response == nullptr) || (response->getNumVariables() != 1))
+      InterlockedIncrement(&context->failed);
+   delete response;
+   if (InterlockedIncrement(&context->completed) == context->total)
+      context->done.set();
+}
+
+/**
+ * Test asynchronous SNMP engine
+ */
+static void TestAsyncEngine()
+{
+   StartTest(_T("SNMP_AsyncEngine - single request"));
+   SNMP_AsyncEngine engine(2);
+   AssertEquals(engine.start(), SNMP_ERR_SUCCESS);
+   TestResponder responder;
+   InetAddress loopback = InetAddress::LOOPBACK;
+   SNMP_SecurityContext securityContext("public");
+   SNMP_PDU request(SNMP_GET_REQUEST, 0, SNMP_VERSION_2C);
+   request.bindVariable(new SNMP_Variable(s_oidSysDescription));
+   SNMP_PDU *response;
+   AssertEquals(engine.doRequest(loopback, responder.getPort(), &request, &response, &securityContext, 2000), SNMP_ERR_SUCCESS);
+   AssertNotNull(response);
+   AssertEquals(response->getNumVariables(), 1);
+   AssertEquals(response->getVariable(0)->getName().compare(s_oidSysDescription), OID_EQUAL);
+   delete response;
+   EndTest();
+
+   StartTest(_T("SNMP_AsyncEngine - 10000 concurrent requests"));
+   AsyncTestContext context(10000);
+   int64_t startTime = GetCurrentTimeMs();
+   int maxPending = 0;
+   for(int i = 0; i < context.total; i++)
+   {
+      AssertEquals(engine.sendRequest(loopback, responder.getPort(), &request, &securityContext, AsyncTestCallback, &context, 5000), SNMP_ERR_SUCCESS);
+      if ((i % 100) == 0)
+         maxPending = std::max(maxPending, engine.getPendingRequestCount());
+   }
+   AssertTrue(context.done.wait(30000));
+   AssertEquals(context.failed, 0);
+   AssertEquals(engine.getPendingRequestCount(), 0);
+   int64_t elapsed = GetCurrentTimeMs() - startTime;
+   EndTest(elapsed);
+   _tprintf(_T("      %d requests/sec, up to %d requests in flight\n"), static_cast<int>(context.total * 1000 / std::max(elapsed, static_cast<int64_t>(1))), maxPending);
+
+   StartTest(_T("SNMP_AsyncEngine - timeout"));
+   SOCKET silent = CreateSocket(AF_INET, SOCK_DGRAM, 0);
+   struct sockaddr_in addr;
+   memset(&addr, 0, sizeof(addr));
+   addr.sin_family = AF_INET;
+   addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+   bind(silent, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+   socklen_t len = sizeof(addr);
+   getsockname(silent, reinterpret_cast<struct sockaddr*>(&addr), &len);
+   AssertEquals(engine.doRequest(loopback, ntohs(addr.sin_port), &request, &response, &securityContext, 200, 2), SNMP_ERR_TIMEOUT);
+   AssertNull(response);
+   closesocket(silent);
+   EndTest();
+
+   StartTest(_T("SNMP_AsyncEngine - shutdown with pending requests"));
+   AsyncTestContext abortContext(1);
+   AssertEquals(engine.sendRequest(loopback, ntohs(addr.sin_port), &request, &securityContext, AsyncTestCallback, &abortContext, 60000), SNMP_ERR_SUCCESS);
+   engine.shutdown();
+   AssertTrue(abortContext.done.wait(0));
+   AssertEquals(abortContext.failed, 1);
+   EndTest();
+}
+
 /**
  * main()
  */
@@ -153,5 +571,8 @@ int main(int argc, char *argv[])
    TestOidConversion();
    TestOidClass();
    TestVariableClass();
+   TestBulkRequestPDU();
+   TestSnmpWalk();
+   TestAsyncEngine();
    return 0;
 }
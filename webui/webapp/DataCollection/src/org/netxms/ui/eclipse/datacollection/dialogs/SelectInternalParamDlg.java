@@ -134,6 +134,9 @@ private void fillMetricList()
 		
 		if ((object instanceof Template) || ((object instanceof AbstractNode) && ((AbstractNode)object).isManagementServer()))
 		{
+         list.add(new AgentParameter("Server.AccessRightsCache.Hits", "Access rights cache: hits", DataType.UINT64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.AccessRightsCache.Invalidations", "Access rights cache: invalidations", DataType.UINT64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.AccessRightsCache.Misses", "Access rights cache: misses", DataType.UINT64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.ActiveAlarms", "Number of active alarms in the system", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.AgentTunnels.Bound.Total", "Number of bound agent tunnels", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.AgentTunnels.Bound.AgentProxy", "Number of bound agent tunnels with enabled agent proxy", DataType.UINT32)); //$NON-NLS-1$
@@ -158,9 +161,11 @@ private void fillMetricList()
          list.add(new AgentParameter("Server.DB.Queries.NonSelect", "Non-SELECT DB queries", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.DB.Queries.Select", "SELECT DB queries", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.DB.Queries.Total", "Total DB queries", DataType.COUNTER64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.DBWriter.Records.IData", "DB writer records written (DCI data)", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.DBWriter.Requests.IData", "DB writer requests (DCI data)", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.DBWriter.Requests.Other", "DB writer requests (other queries)", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.DBWriter.Requests.RawData", "DB writer requests (raw DCI data)", DataType.COUNTER64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.DBWriter.Statements.IData", "DB writer SQL statements (DCI data)", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.EventProcessor.AverageWaitTime(*)", "Event processor {instance}: average event wait time", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.EventProcessor.Bindings(*)", "Event processor {instance}: active bindings", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.EventProcessor.ProcessedEvents(*)", "Event processor {instance}: total number of processed events", DataType.COUNTER64)); //$NON-NLS-1$
@@ -170,11 +175,16 @@ private void fillMetricList()
          list.add(new AgentParameter("Server.Heap.Mapped", "Mapped server heap memory", DataType.UINT64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.MemoryUsage.Alarms", "Server memory usage: alarms", DataType.UINT64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.MemoryUsage.DataCollectionCache", "Server memory usage: data collection cache", DataType.UINT64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.MemoryUsage.ObjectAncestorIndex", "Server memory usage: object ancestor index", DataType.UINT64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.MemoryUsage.RawDataWriter", "Server memory usage: raw data writer", DataType.UINT64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.ObjectCount.Clusters", "Objects: clusters", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.ObjectCount.Nodes", "Objects: nodes", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.ObjectCount.Sensors", "Objects: sensors", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.ObjectCount.Total", "Objects: total", DataType.UINT32)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.PDS.AverageLatency(*)", "Performance data storage driver {instance}: average request latency (milliseconds)", DataType.FLOAT)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.PDS.DroppedValues(*)", "Performance data storage driver {instance}: dropped values", DataType.COUNTER64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.PDS.QueueSize(*)", "Performance data storage driver {instance}: request queue size", DataType.UINT64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.PDS.SpilledValues(*)", "Performance data storage driver {instance}: values spilled to disk", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.QueueSize.Average(*)", "Server queue {instance}: average size", DataType.FLOAT)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.QueueSize.Current(*)", "Server queue {instance}: current size", DataType.INT64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.QueueSize.Max(*)", "Server queue {instance}: max size", DataType.INT64)); //$NON-NLS-1$
@@ -182,10 +192,20 @@ private void fillMetricList()
          list.add(new AgentParameter("Server.ReceivedSNMPTraps", "SNMP traps received since server start", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.ReceivedSyslogMessages", "Syslog messages received since server start", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.ReceivedWindowsEvents", "Windows events received since server start", DataType.COUNTER64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.Scripts.AverageExecutionTime(*)", "Script {instance}: average execution time (microseconds)", DataType.UINT64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.Scripts.Executions(*)", "Script {instance}: executions", DataType.COUNTER64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.ScriptVMPool.HitRatio", "Script VM pool: hit ratio", DataType.UINT32)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.ScriptVMPool.IdleVMs", "Script VM pool: idle VMs", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.SyncerRunTime.Average", "Syncer run time: average", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.SyncerRunTime.Last", "Syncer run time: last", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.SyncerRunTime.Max", "Syncer run time: max", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.SyncerRunTime.Min", "Syncer run time: min", DataType.UINT32)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.SyslogProcessor.AverageMatchTime(*)", "Syslog processor {instance}: average rule matching time (microseconds)", DataType.UINT32)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.SyslogProcessor.AverageParseTime(*)", "Syslog processor {instance}: average parsing time (microseconds)", DataType.UINT32)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.SyslogProcessor.AverageWaitTime(*)", "Syslog processor {instance}: average message wait time", DataType.UINT32)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.SyslogProcessor.MaxWaitTime(*)", "Syslog processor {instance}: max message wait time", DataType.UINT32)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.SyslogProcessor.ProcessedMessages(*)", "Syslog processor {instance}: total number of processed messages", DataType.COUNTER64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.SyslogProcessor.QueueSize(*)", "Syslog processor {instance}: queue size", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.ThreadPool.ActiveRequests(*)", "Thread pool {instance}: active requests", DataType.INT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.ThreadPool.AverageWaitTime(*)", "Thread pool {instance}: average wait time", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.ThreadPool.CurrSize(*)", "Thread pool {instance}: current size", DataType.INT32)); //$NON-NLS-1$